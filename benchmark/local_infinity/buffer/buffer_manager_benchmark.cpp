@@ -0,0 +1,165 @@
+// Copyright(C) 2024 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstring>
+#include <iostream>
+
+import stl;
+import third_party;
+import profiler;
+import infinity;
+import infinity_exception;
+import buffer_manager;
+import buffer_obj;
+import buffer_handle;
+import data_file_worker;
+
+using namespace infinity;
+
+// Throughput of concurrent GetBufferObject and Load on a shared set of buffer objects.
+struct BenchmarkOption {
+public:
+    void Parse(int argc, char *argv[]) {
+        app_.add_option("--data_path", data_path_, "data path of the local infinity")->required(false);
+        app_.add_option("--object_n", object_n_, "buffer objects")->required(false);
+        app_.add_option("--object_size", object_size_, "bytes of each buffer object")->required(false);
+        app_.add_option("--memory_limit", memory_limit_, "memory limit of the buffer manager, evictions start when the objects exceed it")
+            ->required(false);
+        app_.add_option("--thread_n", thread_n_, "concurrent threads")->required(false);
+        app_.add_option("--op_n", op_n_, "operations of each thread")->required(false);
+        app_.add_option("--hot_object_n", hot_object_n_, "objects accessed by the load test, 0 means all")->required(false);
+
+        try {
+            app_.parse(argc, argv);
+        } catch (const CLI::ParseError &e) {
+            UnrecoverableError(e.what());
+        }
+    }
+
+public:
+    String data_path_ = "/var/infinity/buffer_manager_benchmark";
+    SizeT object_n_ = 4096;
+    SizeT object_size_ = 8192;
+    SizeT memory_limit_ = 1024 * 1024 * 1024;
+    SizeT thread_n_ = 64;
+    SizeT op_n_ = 200000;
+    SizeT hot_object_n_ = 0;
+
+private:
+    CLI::App app_;
+};
+
+UniquePtr<DataFileWorker> MakeFileWorker(const SharedPtr<String> &data_dir, const SharedPtr<String> &temp_dir, SizeT object_id, SizeT object_size) {
+    return MakeUnique<DataFileWorker>(data_dir,
+                                      temp_dir,
+                                      MakeShared<String>(fmt::format("seg_{}", object_id % 64)),
+                                      MakeShared<String>(fmt::format("obj_{}", object_id)),
+                                      object_size,
+                                      nullptr);
+}
+
+template <typename Fn>
+void RunThreads(const String &name, const BenchmarkOption &option, Fn &&fn) {
+    BaseProfiler profiler(name);
+    profiler.Begin();
+    Vector<std::thread> threads;
+    for (SizeT thread_id = 0; thread_id < option.thread_n_; ++thread_id) {
+        threads.emplace_back([&, thread_id] { fn(thread_id); });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    profiler.End();
+    SizeT op_count = option.thread_n_ * option.op_n_;
+    std::cout << fmt::format("{}: {} ops in {}, {:.0f} ops/s",
+                             name,
+                             op_count,
+                             profiler.ElapsedToString(1000),
+                             f64(op_count) * 1e9 / std::max<i64>(profiler.Elapsed(), 1))
+              << std::endl;
+}
+
+int main(int argc, char *argv[]) {
+    BenchmarkOption option;
+    option.Parse(argc, argv);
+    std::cout << fmt::format("objects: {}, object size: {}, memory limit: {}, threads: {}, ops per thread: {}",
+                             option.object_n_,
+                             option.object_size_,
+                             option.memory_limit_,
+                             option.thread_n_,
+                             option.op_n_)
+              << std::endl;
+
+    // For the logger and the config only, the buffer manager under test is a standalone one.
+    Infinity::LocalInit(option.data_path_);
+    auto data_dir = MakeShared<String>(option.data_path_ + "/bench_data");
+    auto temp_dir = MakeShared<String>(option.data_path_ + "/bench_tmp");
+    {
+        BufferManager buffer_mgr(option.memory_limit_, data_dir, temp_dir, nullptr);
+        buffer_mgr.Start();
+
+        Vector<BufferObj *> buffer_objs;
+        buffer_objs.reserve(option.object_n_);
+        for (SizeT object_id = 0; object_id < option.object_n_; ++object_id) {
+            BufferObj *buffer_obj = buffer_mgr.AllocateBufferObject(MakeFileWorker(data_dir, temp_dir, object_id, option.object_size_));
+            {
+                BufferHandle handle = buffer_obj->Load();
+                std::memset(handle.GetDataMut(), object_id & 0xff, option.object_size_);
+            }
+            buffer_obj->Save();
+            buffer_objs.push_back(buffer_obj);
+        }
+
+        RunThreads("GetBufferObject", option, [&](SizeT thread_id) {
+            std::mt19937 rng(thread_id);
+            for (SizeT op = 0; op < option.op_n_; ++op) {
+                SizeT object_id = rng() % option.object_n_;
+                BufferObj *buffer_obj = buffer_mgr.GetBufferObject(MakeFileWorker(data_dir, temp_dir, object_id, option.object_size_));
+                if (buffer_obj != buffer_objs[object_id]) {
+                    UnrecoverableError(fmt::format("Wrong buffer object of {}", object_id));
+                }
+            }
+        });
+
+        SizeT hot_object_n = option.hot_object_n_ == 0 ? option.object_n_ : std::min(option.hot_object_n_, option.object_n_);
+        atomic_u64 checksum{0};
+        RunThreads("Load", option, [&](SizeT thread_id) {
+            std::mt19937 rng(thread_id);
+            u64 local_checksum = 0;
+            for (SizeT op = 0; op < option.op_n_; ++op) {
+                BufferHandle handle = buffer_objs[rng() % hot_object_n]->Load();
+                local_checksum += *static_cast<const u8 *>(handle.GetData());
+            }
+            checksum += local_checksum;
+        });
+
+        // Every thread keeps one handle of the same object, so most of the other pins find the buffer already loaded.
+        [[maybe_unused]] BufferHandle pinned = buffer_objs[0]->Load();
+        RunThreads("Load hot object", option, [&](SizeT) {
+            for (SizeT op = 0; op < option.op_n_; ++op) {
+                BufferHandle handle = buffer_objs[0]->Load();
+            }
+        });
+
+        std::cout << fmt::format("requests: {}, cache misses: {}, memory usage: {}, checksum: {}",
+                                 buffer_mgr.TotalRequestCount(),
+                                 buffer_mgr.CacheMissCount(),
+                                 buffer_mgr.memory_usage(),
+                                 checksum.load())
+                  << std::endl;
+    }
+
+    Infinity::LocalUnInit();
+    return 0;
+}
@@ -15,6 +15,7 @@
 #include <cassert>
 #include <csignal>
 #include <cstring>
+#include <iterator>
 #include <string>
 #include <tuple>
 #include <unistd.h>
@@ -46,6 +47,11 @@ import search_expr;
 import column_expr;
 import virtual_store;
 import insert_row_expr;
+import index_defines;
+import posting_field;
+import byte_slice_writer;
+import byte_slice_reader;
+import simd_common_tools;
 
 using namespace infinity;
 
@@ -120,6 +126,15 @@ SharedPtr<Infinity> CreateDbAndTable(const String &db_name, const String &table_
     return infinity;
 }
 
+// rows of a jsonl or csv file, one per line
+SizeT CountRows(const String &path) {
+    std::ifstream input_file(path);
+    return std::count(std::istreambuf_iterator<char>(input_file), std::istreambuf_iterator<char>(), '\n');
+}
+
+// the profiler shall be named, an unnamed one reports no elapsed time
+double DocsPerSecond(SizeT num_docs, const BaseProfiler &profiler) { return num_docs * 1e9 / std::max<i64>(profiler.Elapsed(), 1); }
+
 void BenchmarkImport(SharedPtr<Infinity> infinity, const String &db_name, const String &table_name, const String &import_from) {
     if (!VirtualStore::Exists(import_from)) {
         LOG_ERROR(fmt::format("Data file doesn't exist: {}", import_from));
@@ -153,7 +168,7 @@ void BenchmarkInsert(SharedPtr<Infinity> infinity, const String &db_name, const
         return;
     }
 
-    BaseProfiler profiler;
+    BaseProfiler profiler("insert");
 
     profiler.Begin();
     Vector<Tuple<char *, char *, char *>> batch_cache;
@@ -189,12 +204,13 @@ void BenchmarkInsert(SharedPtr<Infinity> infinity, const String &db_name, const
         num_inserted += insert_batch;
     }
     input_file.close();
-    LOG_INFO(fmt::format("Insert data {} rows cost: {}", num_rows, profiler.ElapsedToString()));
+    LOG_INFO(fmt::format("Insert data {} rows cost: {}, {:.2f} docs/s", num_rows, profiler.ElapsedToString(), DocsPerSecond(num_rows, profiler)));
     profiler.End();
 }
 
-void BenchmarkCreateIndex(SharedPtr<Infinity> infinity, const String &db_name, const String &table_name, const String &index_name) {
-    BaseProfiler profiler;
+// num_docs is the rows already in the table, the indexing throughput is reported if it's not 0
+void BenchmarkCreateIndex(SharedPtr<Infinity> infinity, const String &db_name, const String &table_name, const String &index_name, SizeT num_docs = 0) {
+    BaseProfiler profiler("create_index");
     profiler.Begin();
     auto index_info = new IndexInfo();
     index_info->index_type_ = IndexType::kFullText;
@@ -211,7 +227,11 @@ void BenchmarkCreateIndex(SharedPtr<Infinity> infinity, const String &db_name, c
     }
 
     // NOTE: ~CreateStatement() has already deleted or freed index_info, index_info->index_param_list_.
-    LOG_INFO(fmt::format("Create index cost: {}", profiler.ElapsedToString()));
+    if (num_docs > 0) {
+        LOG_INFO(fmt::format("Create index on {} rows cost: {}, {:.2f} docs/s", num_docs, profiler.ElapsedToString(), DocsPerSecond(num_docs, profiler)));
+    } else {
+        LOG_INFO(fmt::format("Create index cost: {}", profiler.ElapsedToString()));
+    }
     profiler.End();
 }
 
@@ -272,6 +292,109 @@ void BenchmarkQuery(SharedPtr<Infinity> infinity, const String &db_name, const S
     }
 }
 
+void RunMatchQuery(SharedPtr<Infinity> infinity, const String &db_name, const String &table_name, const String &match_text, const String &options_text) {
+    auto *search_expr = new SearchExpr();
+    {
+        auto exprs = new std::vector<ParsedExpr *>();
+        auto *match_expr = new MatchExpr();
+        match_expr->fields_ = "text";
+        match_expr->matching_text_ = match_text;
+        match_expr->options_text_ = options_text;
+        exprs->push_back(match_expr);
+        search_expr->SetExprs(exprs);
+    }
+    std::vector<ParsedExpr *> *output_columns = new std::vector<ParsedExpr *>();
+    {
+        auto select_rowid_expr = new FunctionExpr();
+        select_rowid_expr->func_name_ = "row_id";
+        auto select_score_expr = new FunctionExpr();
+        select_score_expr->func_name_ = "score";
+        output_columns->emplace_back(select_rowid_expr);
+        output_columns->emplace_back(select_score_expr);
+    }
+    infinity->Search(db_name, table_name, search_expr, nullptr, nullptr, nullptr, output_columns, nullptr, nullptr, nullptr, nullptr, false);
+}
+
+// Time every query shape with each early termination algorithm, the speedup is against the exhaustive scoring.
+void BenchmarkQueryShape(SharedPtr<Infinity> infinity, const String &db_name, const String &table_name, SizeT topn, int query_times) {
+    const Vector<Pair<String, String>> shapes = {
+        {"or", "harmful chemical social custom"},
+        {"or many terms", "harmful chemical social custom annual american award film music science history war"},
+        {"and", "harmful AND chemical"},
+        {"phrase", "\"social custom\""},
+        {"or term phrase", "harmful \"social custom\""},
+        {"and phrase", "harmful AND \"social custom\""},
+        {"nested", "(harmful OR chemical) AND (social OR custom)"},
+    };
+    const Vector<String> algos = {"false", "bmw", "maxscore", "auto"};
+    for (const auto &[shape_name, match_text] : shapes) {
+        Vector<i64> costs;
+        for (const auto &algo : algos) {
+            const String options_text = fmt::format("topn={};block_max={}", topn, algo);
+            BaseProfiler profiler("query_shape");
+            profiler.Begin();
+            for (int i = 0; i < query_times; i++) {
+                RunMatchQuery(infinity, db_name, table_name, match_text, options_text);
+            }
+            profiler.End();
+            costs.push_back(profiler.Elapsed());
+        }
+        String msg = fmt::format("Query shape: {}, text: {}, topn: {}, {} times.", shape_name, match_text, topn, query_times);
+        for (SizeT i = 0; i < algos.size(); i++) {
+            msg += fmt::format(" {}: {}, speedup {:.2f}x;",
+                               algos[i],
+                               BaseProfiler::ElapsedToString(NanoSeconds(costs[i])),
+                               static_cast<double>(costs[0]) / std::max<i64>(costs[i], 1));
+        }
+        LOG_INFO(msg);
+    }
+}
+
+// Encode synthetic doc id gaps with each posting codec, report the encoded size and the decode throughput.
+void BenchmarkPostingCodec(int query_times) {
+    constexpr SizeT block_num = 8192;
+    std::mt19937 rng(0);
+    // dense, medium and sparse posting lists
+    for (const double p : {0.5, 0.05, 0.001}) {
+        std::geometric_distribution<u32> gap_dist(p);
+        Vector<u32> gaps(block_num * MAX_DOC_PER_RECORD);
+        std::generate(gaps.begin(), gaps.end(), [&] { return gap_dist(rng) + 1; });
+        const Vector<Pair<String, PostingCodec>> codecs = {
+            {"bitpacking", PostingCodec::kSIMDBitPacking},
+            {"newpfor", PostingCodec::kSIMDNewPFor},
+            {"streamvbyte", PostingCodec::kStreamVByte},
+        };
+        for (const auto &[codec_name, codec] : codecs) {
+            const Int32Encoder *encoder = GetDocIDEncoder(codec);
+            ByteSliceWriter writer;
+            for (SizeT i = 0; i < block_num; i++) {
+                encoder->Encode(writer, gaps.data() + i * MAX_DOC_PER_RECORD, MAX_DOC_PER_RECORD);
+            }
+            u32 buffer[MAX_DOC_PER_RECORD];
+            u64 checksum = 0;
+            BaseProfiler profiler("posting_codec");
+            profiler.Begin();
+            for (int i = 0; i < query_times; i++) {
+                ByteSliceReader reader(writer.GetByteSliceList());
+                for (SizeT j = 0; j < block_num; j++) {
+                    encoder->Decode(buffer, MAX_DOC_PER_RECORD, reader);
+                    PrefixSumU32(buffer, MAX_DOC_PER_RECORD);
+                    checksum += buffer[MAX_DOC_PER_RECORD - 1];
+                }
+            }
+            profiler.End();
+            const double decoded_num = static_cast<double>(gaps.size()) * query_times;
+            LOG_INFO(fmt::format("Posting codec: {}, gap p: {}, size: {} bytes, {:.2f} bits per doc, decode: {:.2f} M docs/s, checksum {}",
+                                 codec_name,
+                                 p,
+                                 writer.GetSize(),
+                                 writer.GetSize() * 8.0 / gaps.size(),
+                                 decoded_num / std::max<i64>(profiler.Elapsed(), 1) * 1000.0,
+                                 checksum));
+        }
+    }
+}
+
 void SignalHandler(int signal_number, siginfo_t *, void *) {
     switch (signal_number) {
 #ifdef ENABLE_JEMALLOC_PROF
@@ -312,14 +435,24 @@ int main(int argc, char *argv[]) {
     CLI::App app{"fulltext_benchmark"};
     // https://github.com/CLIUtils/CLI11/blob/main/examples/enum.cpp
     // Using enumerations in an option
-    enum class Mode : u8 { kInsert, kImport, kMerge, kQuery };
-    Map<String, Mode> mode_map{{"insert", Mode::kInsert}, {"import", Mode::kImport}, {"merge", Mode::kMerge}, {"query", Mode::kQuery}};
+    enum class Mode : u8 { kInsert, kImport, kBuildIndex, kMerge, kQuery, kQueryShape, kCodec };
+    Map<String, Mode> mode_map{{"insert", Mode::kInsert},
+                               {"import", Mode::kImport},
+                               {"build_index", Mode::kBuildIndex},
+                               {"merge", Mode::kMerge},
+                               {"query", Mode::kQuery},
+                               {"query_shape", Mode::kQueryShape},
+                               {"codec", Mode::kCodec}};
     Mode mode(Mode::kInsert);
     SizeT insert_batch = 500;
-    app.add_option("--mode", mode, "Benchmark mode, one of insert, import, merge, query")
+    SizeT topn = 10;
+    int query_times = 10;
+    app.add_option("--mode", mode, "Benchmark mode, one of insert, import, build_index, merge, query, query_shape, codec")
         ->required()
         ->transform(CLI::CheckedTransformer(mode_map, CLI::ignore_case));
     app.add_option("--insert-batch", insert_batch, "batch size of each insert, valid only at insert and merge mode, default value 500");
+    app.add_option("--topn", topn, "topn of each query, valid only at query_shape mode, default value 10");
+    app.add_option("--query-times", query_times, "times to run each query, or to decode the posting lists at codec mode, valid only at query_shape and codec mode, default value 10");
     try {
         app.parse(argc, argv);
     } catch (const CLI::ParseError &e) {
@@ -350,6 +483,12 @@ int main(int argc, char *argv[]) {
             BenchmarkImport(infinity, db_name, table_name, srcfile);
             break;
         }
+        case Mode::kBuildIndex: {
+            // bulk build the index over the imported rows
+            BenchmarkImport(infinity, db_name, table_name, srcfile);
+            BenchmarkCreateIndex(infinity, db_name, table_name, index_name, CountRows(srcfile));
+            break;
+        }
         case Mode::kMerge: {
             BenchmarkCreateIndex(infinity, db_name, table_name, index_name);
             BenchmarkInsert(infinity, db_name, table_name, srcfile, insert_batch);
@@ -364,6 +503,18 @@ int main(int argc, char *argv[]) {
             BenchmarkMoreQuery(infinity, db_name, table_name, 1);
             break;
         }
+        case Mode::kQueryShape: {
+            BenchmarkCreateIndex(infinity, db_name, table_name, index_name);
+            BenchmarkInsert(infinity, db_name, table_name, srcfile, insert_batch);
+            BenchmarkOptimize(infinity, db_name, table_name);
+            sleep(10);
+            BenchmarkQueryShape(infinity, db_name, table_name, topn, query_times);
+            break;
+        }
+        case Mode::kCodec: {
+            BenchmarkPostingCodec(query_times);
+            break;
+        }
         default: {
             printf("Unsupported benchmark mode: %u\n", static_cast<u8>(mode));
         }
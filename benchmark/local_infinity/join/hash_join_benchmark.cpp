@@ -0,0 +1,172 @@
+// Copyright(C) 2024 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <iostream>
+
+import stl;
+import third_party;
+import profiler;
+import infinity_exception;
+import join_hash_table;
+import data_block;
+import column_vector;
+import data_type;
+import logical_type;
+import internal_types;
+import default_values;
+
+using namespace infinity;
+
+struct BenchmarkOption {
+public:
+    void Parse(int argc, char *argv[]) {
+        app_.add_option("--build_rows", build_rows_, "build side row count")->required(false);
+        app_.add_option("--probe_rows", probe_rows_, "probe side row count")->required(false);
+        app_.add_option("--key_range", key_range_, "keys are uniformly drawn from [0, key_range)")->required(false);
+        app_.add_option("--radix_bits", radix_bits_, "radix bits of the hash table")->required(false);
+        app_.add_option("--thread_n", thread_n_, "thread number used to hash the input blocks and build the hash table")->required(false);
+        app_.add_option("--test_n", test_n_, "test n")->required(false);
+
+        try {
+            app_.parse(argc, argv);
+        } catch (const CLI::ParseError &e) {
+            UnrecoverableError(e.what());
+        }
+        if (key_range_ == 0) {
+            key_range_ = build_rows_;
+        }
+    }
+
+public:
+    SizeT build_rows_ = 1 << 22;
+    SizeT probe_rows_ = 1 << 24;
+    SizeT key_range_ = 0;
+    u32 radix_bits_ = JoinHashTable::kDefaultRadixBits;
+    SizeT thread_n_ = std::thread::hardware_concurrency();
+    SizeT test_n_ = 3;
+
+private:
+    CLI::App app_;
+};
+
+// Block layout: key (bigint), payload (bigint), hash (bigint)
+Vector<UniquePtr<DataBlock>> GenerateBlocks(SizeT row_count, SizeT key_range, u32 seed) {
+    Vector<SharedPtr<DataType>> column_types{MakeShared<DataType>(LogicalType::kBigInt),
+                                             MakeShared<DataType>(LogicalType::kBigInt),
+                                             MakeShared<DataType>(LogicalType::kBigInt)};
+    std::mt19937 rng(seed);
+    Vector<UniquePtr<DataBlock>> blocks;
+    for (SizeT offset = 0; offset < row_count; offset += DEFAULT_VECTOR_SIZE) {
+        SizeT block_rows = std::min(row_count - offset, SizeT(DEFAULT_VECTOR_SIZE));
+        auto block = MakeUnique<DataBlock>();
+        block->Init(column_types);
+        for (SizeT row_id = 0; row_id < block_rows; ++row_id) {
+            i64 key = rng() % key_range;
+            i64 payload = offset + row_id;
+            i64 hash = 0;
+            block->column_vectors[0]->AppendByPtr(reinterpret_cast<const_ptr_t>(&key));
+            block->column_vectors[1]->AppendByPtr(reinterpret_cast<const_ptr_t>(&payload));
+            block->column_vectors[2]->AppendByPtr(reinterpret_cast<const_ptr_t>(&hash));
+        }
+        block->Finalize();
+        blocks.emplace_back(std::move(block));
+    }
+    return blocks;
+}
+
+// Same work split as the PhysicalHash tasks of the child fragments.
+void HashBlocks(Vector<UniquePtr<DataBlock>> &blocks, SizeT thread_n) {
+    Vector<SizeT> key_ids{0};
+    atomic_u64 next_block{0};
+    Vector<std::thread> threads;
+    for (SizeT i = 0; i < thread_n; ++i) {
+        threads.emplace_back([&] {
+            for (SizeT block_id = next_block.fetch_add(1); block_id < blocks.size(); block_id = next_block.fetch_add(1)) {
+                DataBlock &block = *blocks[block_id];
+                JoinHashTable::HashKeys(block, key_ids, reinterpret_cast<u64 *>(block.column_vectors[2]->data()));
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+}
+
+SizeT Probe(const JoinHashTable &hash_table, const Vector<UniquePtr<DataBlock>> &probe_blocks) {
+    Vector<SizeT> key_ids{0};
+    SizeT match_count = 0;
+    for (const auto &block : probe_blocks) {
+        const auto *hashes = reinterpret_cast<const u64 *>(block->column_vectors[2]->data());
+        SizeT row_count = block->row_count();
+        for (SizeT row_id = 0; row_id < row_count; ++row_id) {
+            u64 hash = hashes[row_id];
+            for (u32 entry_id = hash_table.FirstEntry(hash); entry_id != JoinHashTable::kInvalidEntry; entry_id = hash_table.NextEntry(entry_id)) {
+                if (hash_table.GetEntry(entry_id).hash_ == hash && hash_table.Match(entry_id, *block, key_ids, row_id)) {
+                    ++match_count;
+                }
+            }
+        }
+    }
+    return match_count;
+}
+
+int main(int argc, char *argv[]) {
+    BenchmarkOption option;
+    option.Parse(argc, argv);
+    std::cout << fmt::format("build rows: {}, probe rows: {}, key range: {}, radix bits: {}, threads: {}",
+                             option.build_rows_,
+                             option.probe_rows_,
+                             option.key_range_,
+                             option.radix_bits_,
+                             option.thread_n_)
+              << std::endl;
+
+    // The calling thread builds partitions too
+    ThreadPool build_thread_pool(std::max<SizeT>(option.thread_n_, 2) - 1);
+    for (SizeT i = 0; i < option.test_n_; ++i) {
+        Vector<UniquePtr<DataBlock>> build_blocks = GenerateBlocks(option.build_rows_, option.key_range_, 2 * i);
+        Vector<UniquePtr<DataBlock>> probe_blocks = GenerateBlocks(option.probe_rows_, option.key_range_, 2 * i + 1);
+
+        BaseProfiler profiler;
+        profiler.Begin();
+        HashBlocks(build_blocks, option.thread_n_);
+        HashBlocks(probe_blocks, option.thread_n_);
+        profiler.End();
+        String hash_time = profiler.ElapsedToString(1000);
+
+        profiler.Begin();
+        JoinHashTable hash_table({0}, 2, option.radix_bits_);
+        for (auto &block : build_blocks) {
+            hash_table.Append(std::move(block));
+        }
+        hash_table.Build(&build_thread_pool);
+        profiler.End();
+        String build_time = profiler.ElapsedToString(1000);
+
+        profiler.Begin();
+        SizeT match_count = Probe(hash_table, probe_blocks);
+        profiler.End();
+        String probe_time = profiler.ElapsedToString(1000);
+
+        std::cout << fmt::format("Test {} / {}, hash time: {}, build time: {}, probe time: {}, matched rows: {}",
+                                 i + 1,
+                                 option.test_n_,
+                                 hash_time,
+                                 build_time,
+                                 probe_time,
+                                 match_count)
+                  << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,253 @@
+// Copyright(C) 2024 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "hnsw_benchmark_util.h"
+#include <iostream>
+
+import stl;
+import third_party;
+import profiler;
+import infinity;
+import infinity_exception;
+import internal_types;
+import index_base;
+import index_diskann;
+import diskann_index_in_chunk;
+import hnsw_alg;
+import hnsw_common;
+import vec_store_type;
+
+using namespace infinity;
+
+// Recall, QPS and memory of a DiskAnn chunk searched from the disk, against an in-memory HNSW on the same data.
+struct BenchmarkOption {
+public:
+    void Parse(int argc, char *argv[]) {
+        app_.add_option("--data_path", data_path_, "data path of the local infinity, the DiskAnn chunk is built under it")->required(false);
+        app_.add_option("--base_fvecs", base_fvecs_, "base vectors in fvecs, random vectors are generated if empty")->required(false);
+        app_.add_option("--query_fvecs", query_fvecs_, "query vectors in fvecs, required with base_fvecs")->required(false);
+        app_.add_option("--vec_n", vec_n_, "random base vectors")->required(false);
+        app_.add_option("--query_n", query_n_, "random query vectors")->required(false);
+        app_.add_option("--dim", dim_, "dimension of the random vectors")->required(false);
+        app_.add_option("--topk", topk_, "topk")->required(false);
+        app_.add_option("--thread_n", thread_n_, "query threads")->required(false);
+        app_.add_option("--R", R_, "DiskAnn max degree")->required(false);
+        app_.add_option("--L", L_, "DiskAnn build list size")->required(false);
+        app_.add_option("--num_pq_chunks", num_pq_chunks_, "DiskAnn PQ chunks")->required(false);
+        app_.add_option("--M", M_, "HNSW M")->required(false);
+        app_.add_option("--ef_construction", ef_construction_, "HNSW ef construction")->required(false);
+
+        try {
+            app_.parse(argc, argv);
+        } catch (const CLI::ParseError &e) {
+            UnrecoverableError(e.what());
+        }
+    }
+
+public:
+    String data_path_ = "/var/infinity/diskann_benchmark";
+    String base_fvecs_;
+    String query_fvecs_;
+    SizeT vec_n_ = 100000;
+    SizeT query_n_ = 1000;
+    SizeT dim_ = 128;
+    SizeT topk_ = 10;
+    SizeT thread_n_ = 8;
+    SizeT R_ = 64;
+    SizeT L_ = 100;
+    SizeT num_pq_chunks_ = 32;
+    SizeT M_ = 16;
+    SizeT ef_construction_ = 200;
+
+private:
+    CLI::App app_;
+};
+
+using LabelT = u32;
+using Hnsw = KnnHnsw<PlainL2VecStoreType<f32>, LabelT>;
+
+Vector<HashSet<LabelT>> GroundTruth(const f32 *base, SizeT vec_n, const f32 *queries, SizeT query_n, SizeT dim, SizeT topk, SizeT thread_n) {
+    Vector<HashSet<LabelT>> ground_truth(query_n);
+    Atomic<SizeT> cur_i = 0;
+    Vector<std::thread> threads;
+    for (SizeT thread_id = 0; thread_id < thread_n; ++thread_id) {
+        threads.emplace_back([&] {
+            Vector<Pair<f32, LabelT>> distances(vec_n);
+            SizeT i;
+            while ((i = cur_i.fetch_add(1)) < query_n) {
+                const f32 *query = queries + i * dim;
+                for (SizeT j = 0; j < vec_n; ++j) {
+                    f32 distance = 0;
+                    for (SizeT k = 0; k < dim; ++k) {
+                        f32 diff = query[k] - base[j * dim + k];
+                        distance += diff * diff;
+                    }
+                    distances[j] = {distance, LabelT(j)};
+                }
+                std::partial_sort(distances.begin(), distances.begin() + topk, distances.end());
+                for (SizeT j = 0; j < topk; ++j) {
+                    ground_truth[i].insert(distances[j].second);
+                }
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    return ground_truth;
+}
+
+// search_fn(query_idx) returns the labels of the query
+template <typename SearchFn>
+void RunQueries(const String &name, const BenchmarkOption &option, SizeT query_n, const Vector<HashSet<LabelT>> &ground_truth, SearchFn &&search_fn) {
+    Vector<Vector<LabelT>> results(query_n);
+    BaseProfiler profiler(name);
+    profiler.Begin();
+    Atomic<SizeT> cur_i = 0;
+    Vector<std::thread> threads;
+    for (SizeT thread_id = 0; thread_id < option.thread_n_; ++thread_id) {
+        threads.emplace_back([&] {
+            SizeT i;
+            while ((i = cur_i.fetch_add(1)) < query_n) {
+                results[i] = search_fn(i);
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    profiler.End();
+
+    SizeT correct = 0;
+    for (SizeT i = 0; i < query_n; ++i) {
+        for (LabelT label : results[i]) {
+            correct += ground_truth[i].contains(label);
+        }
+    }
+    std::cout << fmt::format("{}: recall {:.4f}, {:.0f} QPS, {}",
+                             name,
+                             f64(correct) / (query_n * option.topk_),
+                             f64(query_n) * 1e9 / std::max<i64>(profiler.Elapsed(), 1),
+                             profiler.ElapsedToString(1000))
+              << std::endl;
+}
+
+int main(int argc, char *argv[]) {
+    BenchmarkOption option;
+    option.Parse(argc, argv);
+
+    SizeT vec_n = option.vec_n_;
+    SizeT query_n = option.query_n_;
+    SizeT dim = option.dim_;
+    UniquePtr<f32[]> base;
+    UniquePtr<f32[]> queries;
+    if (!option.base_fvecs_.empty()) {
+        i32 base_dim = 0, query_dim = 0;
+        std::tie(vec_n, base_dim, base) = benchmark::DecodeFvecsDataset<f32>(option.base_fvecs_);
+        std::tie(query_n, query_dim, queries) = benchmark::DecodeFvecsDataset<f32>(option.query_fvecs_);
+        if (base_dim != query_dim) {
+            UnrecoverableError("Dimension of the base and the query mismatch");
+        }
+        dim = base_dim;
+    } else {
+        std::mt19937 rng(0);
+        std::uniform_real_distribution<f32> dist(-1.0, 1.0);
+        base = MakeUniqueForOverwrite<f32[]>(vec_n * dim);
+        queries = MakeUniqueForOverwrite<f32[]>(query_n * dim);
+        std::generate_n(base.get(), vec_n * dim, [&] { return dist(rng); });
+        std::generate_n(queries.get(), query_n * dim, [&] { return dist(rng); });
+    }
+    std::cout << fmt::format("vectors: {}, queries: {}, dimension: {}, topk: {}", vec_n, query_n, dim, option.topk_) << std::endl;
+
+    // For the logger and the config
+    Infinity::LocalInit(option.data_path_);
+
+    auto ground_truth = GroundTruth(base.get(), vec_n, queries.get(), query_n, dim, option.topk_, option.thread_n_);
+
+    IndexDiskAnn index_diskann(MakeShared<String>("idx"),
+                               nullptr,
+                               "idx",
+                               {"col"},
+                               MetricType::kMetricL2,
+                               DiskAnnEncodeType::kPlain,
+                               option.R_,
+                               option.L_,
+                               option.num_pq_chunks_,
+                               1);
+    {
+        DiskAnnIndexInChunk diskann(&index_diskann, dim, 0, option.data_path_ + "/diskann_chunk");
+        BaseProfiler build_profiler("DiskAnn build");
+        build_profiler.Begin();
+        diskann.BuildDiskAnnIndex(base.get(), vec_n);
+        build_profiler.End();
+        std::cout << fmt::format("DiskAnn build: {}, memory: {} bytes", build_profiler.ElapsedToString(1000), diskann.MemoryUsage()) << std::endl;
+
+        auto all_pass = [](SegmentOffset) { return true; };
+        for (bool rerank : {true, false}) {
+            for (u32 beam_width : {1, 2, 4, 8}) {
+                for (u32 l_search : {50, 100, 200}) {
+                    DiskAnnSearchOption search_option{.beam_width_ = beam_width, .l_search_ = l_search, .rerank_ = rerank};
+                    RunQueries(fmt::format("DiskAnn beam_width {} l_search {} rerank {}", beam_width, l_search, rerank),
+                               option,
+                               query_n,
+                               ground_truth,
+                               [&](SizeT i) {
+                                   auto [result_n, d_ptr, offset_ptr] =
+                                       diskann.Search(queries.get() + i * dim, option.topk_, search_option, all_pass);
+                                   return Vector<LabelT>(offset_ptr.get(), offset_ptr.get() + result_n);
+                               });
+                }
+            }
+        }
+    }
+
+    {
+        auto hnsw = Hnsw::Make(8192, (vec_n + 8191) / 8192, dim, option.M_, option.ef_construction_);
+        BaseProfiler build_profiler("HNSW build");
+        build_profiler.Begin();
+        DenseVectorIter<f32, LabelT> iter(base.get(), dim, vec_n);
+        auto [start_i, end_i] = hnsw->StoreData(iter);
+        Vector<std::thread> threads;
+        SizeT bucket_size = (end_i - start_i + option.thread_n_ - 1) / option.thread_n_;
+        for (SizeT thread_id = 0; thread_id < option.thread_n_; ++thread_id) {
+            threads.emplace_back([&, thread_id] {
+                SizeT begin = start_i + thread_id * bucket_size;
+                SizeT end = std::min<SizeT>(begin + bucket_size, end_i);
+                for (SizeT j = begin; j < end; ++j) {
+                    hnsw->Build(j);
+                }
+            });
+        }
+        for (auto &thread : threads) {
+            thread.join();
+        }
+        build_profiler.End();
+        std::cout << fmt::format("HNSW build: {}, memory: {} bytes", build_profiler.ElapsedToString(1000), hnsw->mem_usage()) << std::endl;
+
+        for (SizeT ef : {50, 100, 200}) {
+            KnnSearchOption search_option{.ef_ = ef};
+            RunQueries(fmt::format("HNSW ef {}", ef), option, query_n, ground_truth, [&](SizeT i) {
+                Vector<Pair<f32, LabelT>> pairs = hnsw->KnnSearchSorted(queries.get() + i * dim, option.topk_, search_option);
+                Vector<LabelT> labels;
+                for (const auto &[_, label] : pairs) {
+                    labels.push_back(label);
+                }
+                return labels;
+            });
+        }
+    }
+
+    Infinity::LocalUnInit();
+    return 0;
+}
@@ -0,0 +1,190 @@
+// Copyright(C) 2024 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "hnsw_benchmark_util.h"
+#include <iostream>
+
+import stl;
+import third_party;
+import profiler;
+import infinity;
+import infinity_exception;
+import hnsw_alg;
+import hnsw_common;
+import vec_store_type;
+
+using namespace infinity;
+
+// QPS of the HNSW batch search by the batch size, the batch size 1 searches the queries one by one.
+struct BenchmarkOption {
+public:
+    void Parse(int argc, char *argv[]) {
+        app_.add_option("--data_path", data_path_, "data path of the local infinity")->required(false);
+        app_.add_option("--base_fvecs", base_fvecs_, "base vectors in fvecs, random vectors are generated if empty")->required(false);
+        app_.add_option("--query_fvecs", query_fvecs_, "query vectors in fvecs, required with base_fvecs")->required(false);
+        app_.add_option("--vec_n", vec_n_, "random base vectors")->required(false);
+        app_.add_option("--query_n", query_n_, "random query vectors")->required(false);
+        app_.add_option("--dim", dim_, "dimension of the random vectors")->required(false);
+        app_.add_option("--topk", topk_, "topk")->required(false);
+        app_.add_option("--ef", ef_, "ef of the search")->required(false);
+        app_.add_option("--thread_n", thread_n_, "build and query threads")->required(false);
+        app_.add_option("--M", M_, "HNSW M")->required(false);
+        app_.add_option("--ef_construction", ef_construction_, "HNSW ef construction")->required(false);
+
+        try {
+            app_.parse(argc, argv);
+        } catch (const CLI::ParseError &e) {
+            UnrecoverableError(e.what());
+        }
+    }
+
+public:
+    String data_path_ = "/var/infinity/hnsw_batch_benchmark";
+    String base_fvecs_;
+    String query_fvecs_;
+    SizeT vec_n_ = 1000000;
+    SizeT query_n_ = 10000;
+    SizeT dim_ = 128;
+    SizeT topk_ = 10;
+    SizeT ef_ = 100;
+    SizeT thread_n_ = 8;
+    SizeT M_ = 16;
+    SizeT ef_construction_ = 200;
+
+private:
+    CLI::App app_;
+};
+
+using LabelT = u32;
+
+template <typename Hnsw>
+void RunBatches(const String &name, const BenchmarkOption &option, const Hnsw &hnsw, const f32 *queries, SizeT query_n, SizeT dim) {
+    KnnSearchOption search_option{.ef_ = option.ef_};
+    Vector<const f32 *> query_ptrs(query_n);
+    for (SizeT i = 0; i < query_n; ++i) {
+        query_ptrs[i] = queries + i * dim;
+    }
+    Vector<Vector<LabelT>> baseline(query_n);
+    for (SizeT batch_size : {1, 8, 32, 64, 128, 256}) {
+        Vector<Vector<LabelT>> results(query_n);
+        BaseProfiler profiler(fmt::format("{} batch size {}", name, batch_size));
+        profiler.Begin();
+        Atomic<SizeT> cur_i = 0;
+        Vector<std::thread> threads;
+        for (SizeT thread_id = 0; thread_id < option.thread_n_; ++thread_id) {
+            threads.emplace_back([&] {
+                SizeT begin;
+                while ((begin = cur_i.fetch_add(batch_size)) < query_n) {
+                    SizeT n = std::min(batch_size, query_n - begin);
+                    if (batch_size == 1) {
+                        auto [result_n, d_ptr, l_ptr] = hnsw.KnnSearch(query_ptrs[begin], option.topk_, search_option);
+                        results[begin].assign(l_ptr.get(), l_ptr.get() + result_n);
+                        continue;
+                    }
+                    auto batch_results = hnsw.KnnSearchBatch(query_ptrs.data() + begin, n, option.topk_, search_option);
+                    for (SizeT i = 0; i < n; ++i) {
+                        const auto &[result_n, d_ptr, l_ptr] = batch_results[i];
+                        results[begin + i].assign(l_ptr.get(), l_ptr.get() + result_n);
+                    }
+                }
+            });
+        }
+        for (auto &thread : threads) {
+            thread.join();
+        }
+        profiler.End();
+
+        // the batch search walks the same graph path of each query, check it against the one by one search
+        SizeT mismatch = 0;
+        for (SizeT i = 0; i < query_n; ++i) {
+            std::sort(results[i].begin(), results[i].end());
+            if (batch_size == 1) {
+                baseline[i] = results[i];
+            } else {
+                mismatch += results[i] != baseline[i];
+            }
+        }
+        std::cout << fmt::format("{}: {:.0f} QPS, {}, mismatch {}",
+                                 profiler.name(),
+                                 f64(query_n) * 1e9 / std::max<i64>(profiler.Elapsed(), 1),
+                                 profiler.ElapsedToString(1000),
+                                 mismatch)
+                  << std::endl;
+    }
+}
+
+template <typename Hnsw>
+void BuildAndRun(const String &name, const BenchmarkOption &option, const f32 *base, SizeT vec_n, const f32 *queries, SizeT query_n, SizeT dim) {
+    auto hnsw = Hnsw::Make(8192, (vec_n + 8191) / 8192, dim, option.M_, option.ef_construction_);
+    BaseProfiler build_profiler(fmt::format("{} build", name));
+    build_profiler.Begin();
+    DenseVectorIter<f32, LabelT> iter(base, dim, vec_n);
+    auto [start_i, end_i] = hnsw->StoreData(iter);
+    Vector<std::thread> threads;
+    SizeT bucket_size = (end_i - start_i + option.thread_n_ - 1) / option.thread_n_;
+    for (SizeT thread_id = 0; thread_id < option.thread_n_; ++thread_id) {
+        threads.emplace_back([&, thread_id] {
+            SizeT begin = start_i + thread_id * bucket_size;
+            SizeT end = std::min<SizeT>(begin + bucket_size, end_i);
+            for (SizeT j = begin; j < end; ++j) {
+                hnsw->Build(j);
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    build_profiler.End();
+    std::cout << fmt::format("{}: {}", build_profiler.name(), build_profiler.ElapsedToString(1000)) << std::endl;
+
+    RunBatches(name, option, *hnsw, queries, query_n, dim);
+}
+
+int main(int argc, char *argv[]) {
+    BenchmarkOption option;
+    option.Parse(argc, argv);
+
+    SizeT vec_n = option.vec_n_;
+    SizeT query_n = option.query_n_;
+    SizeT dim = option.dim_;
+    UniquePtr<f32[]> base;
+    UniquePtr<f32[]> queries;
+    if (!option.base_fvecs_.empty()) {
+        i32 base_dim = 0, query_dim = 0;
+        std::tie(vec_n, base_dim, base) = benchmark::DecodeFvecsDataset<f32>(option.base_fvecs_);
+        std::tie(query_n, query_dim, queries) = benchmark::DecodeFvecsDataset<f32>(option.query_fvecs_);
+        if (base_dim != query_dim) {
+            UnrecoverableError("Dimension of the base and the query mismatch");
+        }
+        dim = base_dim;
+    } else {
+        std::mt19937 rng(0);
+        std::uniform_real_distribution<f32> dist(-1.0, 1.0);
+        base = MakeUniqueForOverwrite<f32[]>(vec_n * dim);
+        queries = MakeUniqueForOverwrite<f32[]>(query_n * dim);
+        std::generate_n(base.get(), vec_n * dim, [&] { return dist(rng); });
+        std::generate_n(queries.get(), query_n * dim, [&] { return dist(rng); });
+    }
+    std::cout << fmt::format("vectors: {}, queries: {}, dimension: {}, topk: {}, ef: {}", vec_n, query_n, dim, option.topk_, option.ef_)
+              << std::endl;
+
+    // For the logger and the config
+    Infinity::LocalInit(option.data_path_);
+
+    BuildAndRun<KnnHnsw<PlainL2VecStoreType<f32>, LabelT>>("HNSW plain", option, base.get(), vec_n, queries.get(), query_n, dim);
+    BuildAndRun<KnnHnsw<LVQL2VecStoreType<f32, i8>, LabelT>>("HNSW LVQ", option, base.get(), vec_n, queries.get(), query_n, dim);
+
+    Infinity::LocalUnInit();
+    return 0;
+}
@@ -63,6 +63,8 @@ enum class BuildType : i8 {
     CompressToLVQ,
     LSGBuild,
     LSGCompressToLVQ,
+    PQ,
+    RaBitQ,
 };
 
 String BuildTypeToString(BuildType build_type) {
@@ -77,6 +79,10 @@ String BuildTypeToString(BuildType build_type) {
             return "lsg";
         case BuildType::LSGCompressToLVQ:
             return "clvq_lsg";
+        case BuildType::PQ:
+            return "pq";
+        case BuildType::RaBitQ:
+            return "rabitq";
     }
 }
 
@@ -97,6 +103,8 @@ public:
             {"clvq", BuildType::CompressToLVQ},
             {"lsg", BuildType::LSGBuild},
             {"clvq_lsg", BuildType::LSGCompressToLVQ},
+            {"pq", BuildType::PQ},
+            {"rabitq", BuildType::RaBitQ},
         };
 
         app_.add_option("--mode", mode_type_, "mode")->required()->transform(CLI::CheckedTransformer(mode_map, CLI::ignore_case));
@@ -176,6 +184,8 @@ using LabelT = u32;
 using Hnsw = KnnHnsw<PlainL2VecStoreType<float>, LabelT>;
 using HnswLSG = KnnHnsw<PlainL2VecStoreType<float, true>, LabelT>;
 using HnswLVQ = KnnHnsw<LVQL2VecStoreType<float, i8>, LabelT>;
+using HnswPQ = KnnHnsw<PQVecStoreType<float, QuantMetric::kL2>, LabelT>;
+using HnswRaBitQ = KnnHnsw<RaBitQVecStoreType<float, QuantMetric::kL2>, LabelT>;
 
 // SharedPtr<String> index_name = MakeShared<String>("index_name");
 // String filename = "filename";
@@ -296,6 +306,7 @@ void Build(const BenchmarkOption &option) {
 
     profiler.End();
     std::cout << "Build time: " << profiler.ElapsedToString(1000) << std::endl;
+    std::cout << fmt::format("Memory usage: {} bytes", hnsw->mem_usage()) << std::endl;
 
     auto save = [&](auto &hnsw) {
         auto [index_file, index_status] = VirtualStore::Open(option.index_save_path_.string(), FileAccessMode::kWrite);
@@ -322,6 +333,15 @@ void Query(const BenchmarkOption &option) {
     }
 
     auto hnsw = HnswT::Load(*index_file);
+    std::cout << fmt::format("Memory usage: {} bytes", hnsw->mem_usage()) << std::endl;
+
+    // the distances of PQ and RaBitQ are estimates, the ef candidates are reranked by the raw vectors
+    constexpr bool rerank = std::is_same_v<HnswT, HnswPQ> || std::is_same_v<HnswT, HnswRaBitQ>;
+    UniquePtr<float[]> base_data;
+    if constexpr (rerank) {
+        SizeT base_num = 0, base_dim = 0;
+        std::tie(base_num, base_dim, base_data) = benchmark::DecodeFvecsDataset<float>(option.data_path_);
+    }
 
     auto [query_num, query_dim, query_data] = benchmark::DecodeFvecsDataset<float>(option.query_path_);
     auto [gt_num, topk, gt_data] = benchmark::DecodeFvecsDataset<i32>(option.groundtruth_path_);
@@ -344,7 +364,22 @@ void Query(const BenchmarkOption &option) {
                 SizeT i;
                 while ((i = cur_i.fetch_add(1)) < query_num) {
                     const float *query = query_data.get() + i * query_dim;
-                    Vector<Pair<float, LabelT>> pairs = hnsw->KnnSearchSorted(query, query_topk, search_option);
+                    Vector<Pair<float, LabelT>> pairs;
+                    if constexpr (rerank) {
+                        auto [result_n, d_ptr, l_ptr] = hnsw->KnnSearch(query, query_topk, search_option);
+                        for (SizeT j = 0; j < result_n; ++j) {
+                            const float *base = base_data.get() + l_ptr[j] * query_dim;
+                            float distance = 0;
+                            for (SizeT k = 0; k < query_dim; ++k) {
+                                float diff = query[k] - base[k];
+                                distance += diff * diff;
+                            }
+                            pairs.emplace_back(distance, l_ptr[j]);
+                        }
+                        std::sort(pairs.begin(), pairs.end());
+                    } else {
+                        pairs = hnsw->KnnSearchSorted(query, query_topk, search_option);
+                    }
                     if (pairs.size() < SizeT(query_topk)) {
                         UnrecoverableError("result_n != topk");
                     }
@@ -447,6 +482,14 @@ int main(int argc, char *argv[]) {
                     Build<HnswLSG, HnswLVQ>(option);
                     break;
                 }
+                case BuildType::PQ: {
+                    Build<HnswPQ, HnswPQ>(option);
+                    break;
+                }
+                case BuildType::RaBitQ: {
+                    Build<HnswRaBitQ, HnswRaBitQ>(option);
+                    break;
+                }
             }
             break;
         }
@@ -466,6 +509,14 @@ int main(int argc, char *argv[]) {
                     Query<HnswLSG>(option);
                     break;
                 }
+                case BuildType::PQ: {
+                    Query<HnswPQ>(option);
+                    break;
+                }
+                case BuildType::RaBitQ: {
+                    Query<HnswRaBitQ>(option);
+                    break;
+                }
             }
             break;
         }
@@ -0,0 +1,212 @@
+// Copyright(C) 2024 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "hnsw_benchmark_util.h"
+#include <iostream>
+
+import stl;
+import third_party;
+import profiler;
+import infinity;
+import infinity_exception;
+import hnsw_alg;
+import hnsw_common;
+import vec_store_type;
+
+using namespace infinity;
+
+// Time and recall of the HNSW index of a compacted segment, built with the graph merge and by a full rebuild.
+// The source segment has `vec_n` rows and every `delete_step` row of it is deleted before the compaction,
+// the other compacted segments bring `append_n` rows.
+struct BenchmarkOption {
+public:
+    void Parse(int argc, char *argv[]) {
+        app_.add_option("--data_path", data_path_, "data path of the local infinity")->required(false);
+        app_.add_option("--vec_n", vec_n_, "rows of the largest compacted segment")->required(false);
+        app_.add_option("--append_n", append_n_, "rows of the other compacted segments")->required(false);
+        app_.add_option("--query_n", query_n_, "random query vectors")->required(false);
+        app_.add_option("--dim", dim_, "dimension of the random vectors")->required(false);
+        app_.add_option("--topk", topk_, "topk")->required(false);
+        app_.add_option("--ef", ef_, "ef of the search")->required(false);
+        app_.add_option("--thread_n", thread_n_, "build and query threads")->required(false);
+        app_.add_option("--M", M_, "HNSW M")->required(false);
+        app_.add_option("--ef_construction", ef_construction_, "HNSW ef construction")->required(false);
+
+        try {
+            app_.parse(argc, argv);
+        } catch (const CLI::ParseError &e) {
+            UnrecoverableError(e.what());
+        }
+    }
+
+public:
+    String data_path_ = "/var/infinity/hnsw_merge_benchmark";
+    SizeT vec_n_ = 200000;
+    SizeT append_n_ = 50000;
+    SizeT query_n_ = 1000;
+    SizeT dim_ = 128;
+    SizeT topk_ = 10;
+    SizeT ef_ = 100;
+    SizeT thread_n_ = 8;
+    SizeT M_ = 16;
+    SizeT ef_construction_ = 200;
+
+private:
+    CLI::App app_;
+};
+
+using LabelT = u32;
+using Hnsw = KnnHnsw<PlainL2VecStoreType<f32>, LabelT>;
+
+void ParallelFor(SizeT begin, SizeT end, SizeT thread_n, const std::function<void(SizeT)> &func) {
+    Vector<std::thread> threads;
+    SizeT bucket_size = (end - begin + thread_n - 1) / thread_n;
+    for (SizeT thread_id = 0; thread_id < thread_n; ++thread_id) {
+        threads.emplace_back([&, thread_id] {
+            SizeT bucket_begin = begin + thread_id * bucket_size;
+            SizeT bucket_end = std::min<SizeT>(bucket_begin + bucket_size, end);
+            for (SizeT j = bucket_begin; j < bucket_end; ++j) {
+                func(j);
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+}
+
+// Insert rows [offset, offset + n) of `data` with the labels of their row indexes.
+void InsertRows(Hnsw &hnsw, const f32 *data, SizeT dim, SizeT offset, SizeT n, SizeT thread_n) {
+    DenseVectorIter<f32, LabelT> iter(data + offset * dim, dim, n, offset);
+    auto [start_i, end_i] = hnsw.StoreData(iter);
+    ParallelFor(start_i, end_i, thread_n, [&](SizeT j) { hnsw.Build(j); });
+}
+
+Vector<Vector<LabelT>> GroundTruth(const BenchmarkOption &option, const f32 *data, SizeT n, const f32 *queries) {
+    const SizeT dim = option.dim_;
+    Vector<Vector<LabelT>> ground_truth(option.query_n_);
+    ParallelFor(0, option.query_n_, option.thread_n_, [&](SizeT i) {
+        Vector<Pair<f32, LabelT>> dists(n);
+        for (SizeT j = 0; j < n; ++j) {
+            f32 dist = 0;
+            for (SizeT k = 0; k < dim; ++k) {
+                f32 diff = queries[i * dim + k] - data[j * dim + k];
+                dist += diff * diff;
+            }
+            dists[j] = {dist, static_cast<LabelT>(j)};
+        }
+        SizeT topk = std::min(option.topk_, n);
+        std::partial_sort(dists.begin(), dists.begin() + topk, dists.end());
+        for (SizeT j = 0; j < topk; ++j) {
+            ground_truth[i].push_back(dists[j].second);
+        }
+        std::sort(ground_truth[i].begin(), ground_truth[i].end());
+    });
+    return ground_truth;
+}
+
+f32 Recall(const BenchmarkOption &option, const Hnsw &hnsw, const f32 *queries, const Vector<Vector<LabelT>> &ground_truth) {
+    KnnSearchOption search_option{.ef_ = option.ef_};
+    Atomic<SizeT> correct = 0;
+    SizeT total = 0;
+    for (const auto &labels : ground_truth) {
+        total += labels.size();
+    }
+    ParallelFor(0, option.query_n_, option.thread_n_, [&](SizeT i) {
+        auto [result_n, d_ptr, l_ptr] = hnsw.KnnSearch(queries + i * option.dim_, option.topk_, search_option);
+        Vector<LabelT> labels(l_ptr.get(), l_ptr.get() + result_n);
+        std::sort(labels.begin(), labels.end());
+        Vector<LabelT> hit;
+        std::set_intersection(labels.begin(), labels.end(), ground_truth[i].begin(), ground_truth[i].end(), std::back_inserter(hit));
+        correct += hit.size();
+    });
+    return f32(correct) / std::max<SizeT>(total, 1);
+}
+
+void Report(const BenchmarkOption &option, BaseProfiler &profiler, const Hnsw &hnsw, const f32 *queries, const Vector<Vector<LabelT>> &ground_truth) {
+    std::cout << fmt::format("{}: {}, recall@{} {:.4f}",
+                             profiler.name(),
+                             profiler.ElapsedToString(1000),
+                             option.topk_,
+                             Recall(option, hnsw, queries, ground_truth))
+              << std::endl;
+}
+
+int main(int argc, char *argv[]) {
+    BenchmarkOption option;
+    option.Parse(argc, argv);
+    const SizeT dim = option.dim_;
+    const SizeT chunk_size = 8192;
+
+    std::mt19937 rng(0);
+    std::uniform_real_distribution<f32> dist(-1.0, 1.0);
+    auto src_data = MakeUniqueForOverwrite<f32[]>((option.vec_n_ + option.append_n_) * dim);
+    auto queries = MakeUniqueForOverwrite<f32[]>(option.query_n_ * dim);
+    std::generate_n(src_data.get(), (option.vec_n_ + option.append_n_) * dim, [&] { return dist(rng); });
+    std::generate_n(queries.get(), option.query_n_ * dim, [&] { return dist(rng); });
+    std::cout << fmt::format("source rows: {}, appended rows: {}, queries: {}, dimension: {}, topk: {}, ef: {}",
+                             option.vec_n_,
+                             option.append_n_,
+                             option.query_n_,
+                             dim,
+                             option.topk_,
+                             option.ef_)
+              << std::endl;
+
+    // For the logger and the config
+    Infinity::LocalInit(option.data_path_);
+
+    auto src_hnsw = Hnsw::Make(chunk_size, (option.vec_n_ + chunk_size - 1) / chunk_size, dim, option.M_, option.ef_construction_);
+    InsertRows(*src_hnsw, src_data.get(), dim, 0, option.vec_n_, option.thread_n_);
+
+    for (SizeT delete_step : {100, 10, 4, 2}) {
+        // the compacted rows: the kept rows of the source segment, then the appended rows
+        Vector<f32> compact_data;
+        Vector<Optional<LabelT>> label_map(option.vec_n_);
+        for (SizeT i = 0; i < option.vec_n_; ++i) {
+            if (i % delete_step == 0) {
+                continue;
+            }
+            label_map[i] = compact_data.size() / dim;
+            compact_data.insert(compact_data.end(), src_data.get() + i * dim, src_data.get() + (i + 1) * dim);
+        }
+        const SizeT kept_n = compact_data.size() / dim;
+        compact_data.insert(compact_data.end(), src_data.get() + option.vec_n_ * dim, src_data.get() + (option.vec_n_ + option.append_n_) * dim);
+        const SizeT total_n = kept_n + option.append_n_;
+        const SizeT chunk_n = (total_n + chunk_size - 1) / chunk_size;
+        auto ground_truth = GroundTruth(option, compact_data.data(), total_n, queries.get());
+        std::cout << fmt::format("delete every {} row, compacted rows: {}", delete_step, total_n) << std::endl;
+
+        auto rebuilt_hnsw = Hnsw::Make(chunk_size, chunk_n, dim, option.M_, option.ef_construction_);
+        BaseProfiler rebuild_profiler("graph merge off");
+        rebuild_profiler.Begin();
+        InsertRows(*rebuilt_hnsw, compact_data.data(), dim, 0, total_n, option.thread_n_);
+        rebuild_profiler.End();
+        Report(option, rebuild_profiler, *rebuilt_hnsw, queries.get(), ground_truth);
+
+        auto merged_hnsw = Hnsw::Make(chunk_size, chunk_n, dim, option.M_, option.ef_construction_);
+        BaseProfiler merge_profiler("graph merge on");
+        merge_profiler.Begin();
+        auto merged_n = merged_hnsw->MergeGraph(*src_hnsw, [&](LabelT label) { return label_map[label]; });
+        if (!merged_n.has_value() || *merged_n != kept_n) {
+            UnrecoverableError("Graph merge failed");
+        }
+        InsertRows(*merged_hnsw, compact_data.data(), dim, kept_n, option.append_n_, option.thread_n_);
+        merge_profiler.End();
+        Report(option, merge_profiler, *merged_hnsw, queries.get(), ground_truth);
+    }
+
+    Infinity::LocalUnInit();
+    return 0;
+}
@@ -0,0 +1,176 @@
+// Copyright(C) 2024 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <iostream>
+
+import stl;
+import third_party;
+import profiler;
+import infinity;
+import query_result;
+import infinity_exception;
+
+using namespace infinity;
+
+// Measure the latency of short point queries while long aggregate and sort queries keep all workers busy.
+struct BenchmarkOption {
+public:
+    void Parse(int argc, char *argv[]) {
+        app_.add_option("--data_path", data_path_, "data path of the local infinity")->required(false);
+        app_.add_option("--big_rows", big_rows_, "row count of the table used by the heavy queries")->required(false);
+        app_.add_option("--small_rows", small_rows_, "row count of the table used by the light queries")->required(false);
+        app_.add_option("--heavy_thread_n", heavy_thread_n_, "threads sending heavy queries")->required(false);
+        app_.add_option("--light_thread_n", light_thread_n_, "threads sending light queries")->required(false);
+        app_.add_option("--light_query_n", light_query_n_, "light queries sent by each light thread")->required(false);
+
+        try {
+            app_.parse(argc, argv);
+        } catch (const CLI::ParseError &e) {
+            UnrecoverableError(e.what());
+        }
+    }
+
+public:
+    String data_path_ = "/var/infinity/scheduler_benchmark";
+    SizeT big_rows_ = 1 << 22;
+    SizeT small_rows_ = 1 << 12;
+    SizeT heavy_thread_n_ = 4;
+    SizeT light_thread_n_ = 4;
+    SizeT light_query_n_ = 2000;
+
+private:
+    CLI::App app_;
+};
+
+void MustQuery(const SharedPtr<Infinity> &infinity, const String &sql) {
+    QueryResult result = infinity->Query(sql);
+    if (!result.IsOk()) {
+        UnrecoverableError(fmt::format("Query failed: {}, {}", sql, result.ErrorMsg()));
+    }
+}
+
+void PrepareTable(const SharedPtr<Infinity> &infinity, const String &table_name, SizeT row_count) {
+    constexpr SizeT insert_batch = 8192;
+    MustQuery(infinity, fmt::format("DROP TABLE IF EXISTS {}", table_name));
+    MustQuery(infinity, fmt::format("CREATE TABLE {} (id BIGINT, grp BIGINT, val DOUBLE)", table_name));
+    std::mt19937 rng(row_count);
+    for (SizeT offset = 0; offset < row_count; offset += insert_batch) {
+        SizeT batch_rows = std::min(insert_batch, row_count - offset);
+        String sql = fmt::format("INSERT INTO {} VALUES ", table_name);
+        for (SizeT i = 0; i < batch_rows; ++i) {
+            if (i > 0) {
+                sql += ", ";
+            }
+            sql += fmt::format("({}, {}, {})", offset + i, rng() % 1024, f64(rng() % 1000000) / 100);
+        }
+        MustQuery(infinity, sql);
+    }
+}
+
+f64 Percentile(const Vector<f64> &sorted_latencies, f64 percentile) {
+    if (sorted_latencies.empty()) {
+        return 0;
+    }
+    SizeT idx = std::min(sorted_latencies.size() - 1, SizeT(percentile * sorted_latencies.size()));
+    return sorted_latencies[idx];
+}
+
+int main(int argc, char *argv[]) {
+    BenchmarkOption option;
+    option.Parse(argc, argv);
+    std::cout << fmt::format("big rows: {}, small rows: {}, heavy threads: {}, light threads: {}, light queries per thread: {}",
+                             option.big_rows_,
+                             option.small_rows_,
+                             option.heavy_thread_n_,
+                             option.light_thread_n_,
+                             option.light_query_n_)
+              << std::endl;
+
+    Infinity::LocalInit(option.data_path_);
+    {
+        SharedPtr<Infinity> infinity = Infinity::LocalConnect();
+        PrepareTable(infinity, "big_table", option.big_rows_);
+        PrepareTable(infinity, "small_table", option.small_rows_);
+        infinity->LocalDisconnect();
+    }
+
+    atomic_bool light_done{false};
+    atomic_u64 heavy_query_count{0};
+    Vector<std::thread> heavy_threads;
+    for (SizeT i = 0; i < option.heavy_thread_n_; ++i) {
+        heavy_threads.emplace_back([&, i] {
+            SharedPtr<Infinity> infinity = Infinity::LocalConnect();
+            while (!light_done) {
+                if (i % 2 == 0) {
+                    MustQuery(infinity, "SELECT grp, SUM(val), COUNT(*) FROM big_table GROUP BY grp");
+                } else {
+                    MustQuery(infinity, "SELECT id, val FROM big_table ORDER BY val DESC LIMIT 10");
+                }
+                ++heavy_query_count;
+            }
+            infinity->LocalDisconnect();
+        });
+    }
+
+    Vector<Vector<f64>> light_latencies(option.light_thread_n_);
+    BaseProfiler total_profiler;
+    total_profiler.Begin();
+    Vector<std::thread> light_threads;
+    for (SizeT i = 0; i < option.light_thread_n_; ++i) {
+        light_threads.emplace_back([&, i] {
+            SharedPtr<Infinity> infinity = Infinity::LocalConnect();
+            std::mt19937 rng(i);
+            auto &latencies = light_latencies[i];
+            latencies.reserve(option.light_query_n_);
+            for (SizeT query_id = 0; query_id < option.light_query_n_; ++query_id) {
+                String sql = fmt::format("SELECT val FROM small_table WHERE id = {}", rng() % option.small_rows_);
+                BaseProfiler profiler("light_query");
+                profiler.Begin();
+                MustQuery(infinity, sql);
+                profiler.End();
+                latencies.push_back(f64(profiler.Elapsed()) / 1000);
+            }
+            infinity->LocalDisconnect();
+        });
+    }
+    for (auto &thread : light_threads) {
+        thread.join();
+    }
+    total_profiler.End();
+    light_done = true;
+    for (auto &thread : heavy_threads) {
+        thread.join();
+    }
+
+    Vector<f64> latencies;
+    for (const auto &thread_latencies : light_latencies) {
+        latencies.insert(latencies.end(), thread_latencies.begin(), thread_latencies.end());
+    }
+    std::sort(latencies.begin(), latencies.end());
+    std::cout << fmt::format("Total time: {}, heavy queries: {}, light queries: {}",
+                             total_profiler.ElapsedToString(1000),
+                             heavy_query_count.load(),
+                             latencies.size())
+              << std::endl;
+    std::cout << fmt::format("Light query latency (us), p50: {:.1f}, p99: {:.1f}, p99.9: {:.1f}, max: {:.1f}",
+                             Percentile(latencies, 0.5),
+                             Percentile(latencies, 0.99),
+                             Percentile(latencies, 0.999),
+                             latencies.empty() ? 0 : latencies.back())
+              << std::endl;
+
+    Infinity::LocalUnInit();
+    return 0;
+}
@@ -0,0 +1,167 @@
+// Copyright(C) 2024 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <fstream>
+#include <iostream>
+
+import stl;
+import third_party;
+import profiler;
+import infinity;
+import query_result;
+import infinity_exception;
+import virtual_store;
+
+using namespace infinity;
+
+// Commit throughput of small insert transactions under one WAL flush mode. Run it once for each mode,
+// the data of the previous run is removed at start.
+struct BenchmarkOption {
+public:
+    void Parse(int argc, char *argv[]) {
+        app_.add_option("--data_path", data_path_, "data path of the local infinity")->required(false);
+        app_.add_option("--wal_flush", wal_flush_, "flush_at_once, flush_per_second or only_write")->required(false);
+        app_.add_option("--thread_n", thread_n_, "threads committing transactions")->required(false);
+        app_.add_option("--txn_n", txn_n_, "transactions committed by each thread")->required(false);
+        app_.add_option("--rows_per_txn", rows_per_txn_, "rows inserted by each transaction")->required(false);
+
+        try {
+            app_.parse(argc, argv);
+        } catch (const CLI::ParseError &e) {
+            UnrecoverableError(e.what());
+        }
+    }
+
+public:
+    String data_path_ = "/var/infinity/wal_commit_benchmark";
+    String wal_flush_ = "flush_at_once";
+    SizeT thread_n_ = 16;
+    SizeT txn_n_ = 2000;
+    SizeT rows_per_txn_ = 1;
+
+private:
+    CLI::App app_;
+};
+
+String WriteConfig(const BenchmarkOption &option) {
+    String config_path = fmt::format("{}/wal_commit_benchmark.toml", option.data_path_);
+    std::ofstream config_file(config_path);
+    config_file << fmt::format(R"([general]
+version                  = "0.6.0"
+time_zone                = "utc-8"
+
+[log]
+log_dir                  = "{0}/log"
+log_to_stdout            = false
+log_level                = "info"
+
+[storage]
+data_dir                 = "{0}/data"
+persistence_dir          = "{0}/persistence"
+
+[buffer]
+temp_dir                 = "{0}/tmp"
+
+[wal]
+wal_dir                  = "{0}/wal"
+wal_flush                = "{1}"
+
+[resource]
+resource_dir             = "{0}/resource"
+)",
+                               option.data_path_,
+                               option.wal_flush_);
+    return config_path;
+}
+
+void MustQuery(const SharedPtr<Infinity> &infinity, const String &sql) {
+    QueryResult result = infinity->Query(sql);
+    if (!result.IsOk()) {
+        UnrecoverableError(fmt::format("Query failed: {}, {}", sql, result.ErrorMsg()));
+    }
+}
+
+int main(int argc, char *argv[]) {
+    BenchmarkOption option;
+    option.Parse(argc, argv);
+    std::cout << fmt::format("wal flush: {}, threads: {}, transactions per thread: {}, rows per transaction: {}",
+                             option.wal_flush_,
+                             option.thread_n_,
+                             option.txn_n_,
+                             option.rows_per_txn_)
+              << std::endl;
+
+    if (VirtualStore::Exists(option.data_path_)) {
+        VirtualStore::RemoveDirectory(option.data_path_);
+    }
+    VirtualStore::MakeDirectory(option.data_path_);
+    Infinity::LocalInit(option.data_path_, WriteConfig(option));
+    {
+        SharedPtr<Infinity> infinity = Infinity::LocalConnect();
+        MustQuery(infinity, "CREATE TABLE wal_commit (id BIGINT, val VARCHAR)");
+        infinity->LocalDisconnect();
+    }
+
+    Vector<Vector<f64>> thread_latencies(option.thread_n_);
+    BaseProfiler profiler("commit");
+    profiler.Begin();
+    Vector<std::thread> threads;
+    for (SizeT i = 0; i < option.thread_n_; ++i) {
+        threads.emplace_back([&, i] {
+            SharedPtr<Infinity> infinity = Infinity::LocalConnect();
+            auto &latencies = thread_latencies[i];
+            latencies.reserve(option.txn_n_);
+            for (SizeT txn_id = 0; txn_id < option.txn_n_; ++txn_id) {
+                String sql = "INSERT INTO wal_commit VALUES ";
+                for (SizeT row_id = 0; row_id < option.rows_per_txn_; ++row_id) {
+                    if (row_id > 0) {
+                        sql += ", ";
+                    }
+                    sql += fmt::format("({}, 'thread_{}_txn_{}')", (i * option.txn_n_ + txn_id) * option.rows_per_txn_ + row_id, i, txn_id);
+                }
+                BaseProfiler txn_profiler("txn");
+                txn_profiler.Begin();
+                MustQuery(infinity, sql);
+                txn_profiler.End();
+                latencies.push_back(f64(txn_profiler.Elapsed()) / 1000);
+            }
+            infinity->LocalDisconnect();
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    profiler.End();
+
+    Vector<f64> latencies;
+    for (const auto &latency : thread_latencies) {
+        latencies.insert(latencies.end(), latency.begin(), latency.end());
+    }
+    std::sort(latencies.begin(), latencies.end());
+    f64 seconds = f64(profiler.Elapsed()) / 1'000'000'000;
+    std::cout << fmt::format("Total time: {}, commits: {}, throughput: {:.0f} txn/s",
+                             profiler.ElapsedToString(1000),
+                             latencies.size(),
+                             latencies.size() / seconds)
+              << std::endl;
+    std::cout << fmt::format("Commit latency (us), p50: {:.1f}, p99: {:.1f}, max: {:.1f}",
+                             latencies[latencies.size() / 2],
+                             latencies[std::min(latencies.size() - 1, latencies.size() * 99 / 100)],
+                             latencies.back())
+              << std::endl;
+
+    Infinity::LocalUnInit();
+    return 0;
+}
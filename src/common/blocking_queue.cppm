@@ -135,6 +135,20 @@ public:
         full_cv_.notify_one();
     }
 
+    // Same as DequeueBulk, but return false if the queue is still empty after `timeout`.
+    bool DequeueBulkFor(Deque<T> &output_array, std::chrono::milliseconds timeout) {
+        {
+            std::unique_lock<std::mutex> lock(queue_mutex_);
+            if (!empty_cv_.wait_for(lock, timeout, [this] { return !queue_.empty(); })) {
+                return false;
+            }
+            output_array.swap(queue_);
+            queue_.clear();
+        }
+        full_cv_.notify_one();
+        return true;
+    }
+
     bool TryDequeue(T &task) {
         {
             std::unique_lock<std::mutex> lock(queue_mutex_);
@@ -73,6 +73,16 @@ export {
     constexpr SizeT BG_GROUND_TASK_QUEUE_SIZE = 65536;
     constexpr SizeT EXECUTOR_TASK_QUEUE_SIZE = 1024;
     constexpr SizeT DEFAULT_BLOCKING_QUEUE_SIZE = 1024;
+    constexpr SizeT DEFAULT_WORKER_RUN_QUEUE_SIZE = 1024;
+    // Scheduling weight of the interactive, batch and background tasks, default of the *_task_weight configs
+    constexpr i64 DEFAULT_INTERACTIVE_TASK_WEIGHT = 16;
+    constexpr i64 DEFAULT_BATCH_TASK_WEIGHT = 4;
+    constexpr i64 DEFAULT_BACKGROUND_TASK_WEIGHT = 1;
+    constexpr i64 MAX_TASK_WEIGHT = 1024;
+    // Percentage of the workers which could run the tasks of the class at the same time, default of the *_task_worker_percent configs
+    constexpr i64 DEFAULT_INTERACTIVE_TASK_WORKER_PERCENT = 100;
+    constexpr i64 DEFAULT_BATCH_TASK_WORKER_PERCENT = 75;
+    constexpr i64 DEFAULT_BACKGROUND_TASK_WORKER_PERCENT = 50;
 
     // transaction related constants
     constexpr u64 MAX_TXN_ID = std::numeric_limits<u64>::max();
@@ -90,6 +100,9 @@ export {
     constexpr SizeT DEFAULT_OUTLINE_FILE_MAX_SIZE = 16 * 1024 * 1024;
 
     constexpr SizeT DEFAULT_CHUNK_SIZE = 10 * 1024 * 1024;
+
+    // A sort task spills its sorted run once the buffered input exceeds this size.
+    constexpr SizeT DEFAULT_SORT_MEMORY_LIMIT = 256 * MB;
     constexpr SizeT DEFAULT_ALIGN_SIZE = sizeof(char *);
 
     constexpr SizeT MIN_CLEANUP_INTERVAL_SEC = 0; // 0 means disable the function
@@ -131,6 +144,12 @@ export {
     constexpr std::string_view DELTA_CHECKPOINT_INTERVAL_WAL_BYTES_STR = "64MB"; // 64 MB
     constexpr i64 MAX_CHECKPOINT_INTERVAL_WAL_BYTES = 1024l * 1024l * 1024l;     // 1GB
 
+    constexpr SizeT DEFAULT_WAL_WRITE_BUFFER_SIZE = 1024l * 1024l; // 1MB, grows for larger entries
+    constexpr SizeT WAL_WRITE_BUFFER_ALIGNMENT = 4096;
+    constexpr i64 WAL_SYNC_INTERVAL_MS = 1000; // FlushPerSecond
+    constexpr i64 DEFAULT_WAL_REPLAY_THREAD_NUM = 16; // tables replayed in parallel at startup
+    constexpr i64 MAX_WAL_REPLAY_THREAD_NUM = 256;
+
     constexpr std::string_view WAL_FILE_TEMP_FILE = "wal.log";
     constexpr std::string_view WAL_FILE_PREFIX = "wal.log";
     constexpr std::string_view CATALOG_FILE_DIR = "catalog";
@@ -166,14 +185,37 @@ export {
     constexpr SizeT DISKANN_MAX_GRAPH_DEGREE = 512;   // SSD index max degree
     constexpr SizeT DISKANN_SECTOR_LEN = 4096u;       // SSD index sector size
     constexpr SizeT DISKANN_MAX_N_SECTOR_READS = 128; // SSD index max sector reads
+    constexpr u32 DISKANN_BEAM_WIDTH = 4;             // default sectors read in one hop of search
+    constexpr u32 DISKANN_L_SEARCH = 100;             // default candidates list length of search
+    constexpr u32 DISKANN_NUM_SEARCH_SCRATCH = 8;     // concurrent searches of one index chunk
 
     // default hnsw parameter
     constexpr SizeT HNSW_M = 16;
     constexpr SizeT HNSW_EF_CONSTRUCTION = 200;
     constexpr SizeT HNSW_BLOCK_SIZE = 8192;
+    constexpr i64 DEFAULT_HNSW_REBUILD_DELETE_PERCENT = 30;
+    constexpr SizeT HNSW_REPAIR_DELETE_PERCENT = 5;
+
+    // filtered knn search on the hnsw index of a segment
+    constexpr SizeT KNN_BRUTE_FORCE_FILTER_ROWS = 4096;  // the matching rows are scanned exactly when there are at most so many
+    constexpr SizeT KNN_BRUTE_FORCE_FILTER_PERCENT = 1;  // or when at most so many percent of rows match
+    constexpr SizeT KNN_POST_FILTER_PERCENT = 90;        // the graph is searched without filter when at least so many percent of rows match
+    constexpr SizeT KNN_FILTER_MAX_EXPANSION = 10;       // ef and topk grow with the inverse selectivity at most so many times
+    constexpr SizeT KNN_FILTER_ESTIMATE_ROWS = DEFAULT_BLOCK_CAPACITY; // explain evaluates the leftover filter on so many rows of a segment
 
     constexpr SizeT BMP_BLOCK_SIZE = 16;
 
+    // ivf search
+    constexpr u32 IVF_SEARCH_BLOCK_SIZE = 32;             // codes scanned together in a probed list
+    constexpr SizeT IVF_PARALLEL_PROBE_MIN_ROWS = 16384;  // rows probed by each task of a parallel search
+
+    // fulltext search
+    constexpr SizeT MATCH_PARALLEL_SEARCH_MIN_ROWS = 65536; // rows searched by each task of a parallel match
+    constexpr SizeT MATCH_MAX_TERM_EXPANSIONS = 50;         // terms a prefix, wildcard or fuzzy term expands to
+
+    // hash join
+    constexpr SizeT JOIN_PARALLEL_BUILD_MIN_ROWS = 65536; // build rows chained by each task of a parallel hash table build
+
     // default distance compute blas parameter
     constexpr SizeT DISTANCE_COMPUTE_BLAS_QUERY_BS = 4096;
     constexpr SizeT DISTANCE_COMPUTE_BLAS_DATABASE_BS = 1024;
@@ -189,6 +231,8 @@ export {
 
     constexpr SizeT DEFAULT_BUFFER_MANAGER_SIZE = 8 * 1024lu * 1024lu * 1024lu; // 8Gib
     constexpr SizeT DEFAULT_BUFFER_MANAGER_LRU_COUNT = 7;
+    constexpr SizeT DEFAULT_BUFFER_MANAGER_MAP_SHARD_COUNT = 64;
+    constexpr SizeT BUFFER_MANAGER_REQUEST_COUNTER_STRIPES = 16;
     constexpr std::string_view DEFAULT_BUFFER_MANAGER_SIZE_STR = "8GB"; // 8Gib
 
     constexpr SizeT DEFAULT_MEMINDEX_MEMORY_QUOTA = 4 * 1024lu * 1024lu * 1024lu; // 4GB
@@ -285,6 +329,7 @@ export {
     constexpr std::string_view DENSE_INDEX_BUILDING_WORKER_OPTION_NAME = "dense_index_building_worker";
     constexpr std::string_view SPARSE_INDEX_BUILDING_WORKER_OPTION_NAME = "sparse_index_building_worker";
     constexpr std::string_view FULLTEXT_INDEX_BUILDING_WORKER_OPTION_NAME = "fulltext_index_building_worker";
+    constexpr std::string_view HNSW_REBUILD_DELETE_PERCENT_OPTION_NAME = "hnsw_rebuild_delete_percent";
 
     constexpr std::string_view WAL_DIR_OPTION_NAME = "wal_dir";
     constexpr std::string_view WAL_COMPACT_THRESHOLD_OPTION_NAME = "wal_compact_threshold";
@@ -293,9 +338,16 @@ export {
     constexpr std::string_view DELTA_CHECKPOINT_INTERVAL_OPTION_NAME = "delta_checkpoint_interval";
     constexpr std::string_view DELTA_CHECKPOINT_THRESHOLD_OPTION_NAME = "delta_checkpoint_threshold";
     constexpr std::string_view WAL_FLUSH_OPTION_NAME = "wal_flush";
+    constexpr std::string_view WAL_REPLAY_THREAD_NUM_OPTION_NAME = "wal_replay_thread_num";
     constexpr std::string_view RESOURCE_DIR_OPTION_NAME = "resource_dir";
 
     constexpr std::string_view RECORD_RUNNING_QUERY_OPTION_NAME = "record_running_query";
+    constexpr std::string_view INTERACTIVE_TASK_WEIGHT_OPTION_NAME = "interactive_task_weight";
+    constexpr std::string_view BATCH_TASK_WEIGHT_OPTION_NAME = "batch_task_weight";
+    constexpr std::string_view BACKGROUND_TASK_WEIGHT_OPTION_NAME = "background_task_weight";
+    constexpr std::string_view INTERACTIVE_TASK_WORKER_PERCENT_OPTION_NAME = "interactive_task_worker_percent";
+    constexpr std::string_view BATCH_TASK_WORKER_PERCENT_OPTION_NAME = "batch_task_worker_percent";
+    constexpr std::string_view BACKGROUND_TASK_WORKER_PERCENT_OPTION_NAME = "background_task_worker_percent";
 
     constexpr std::string_view SNAPSHOT_DIR_OPTION_NAME = "snapshot_dir";
     // Variable name
@@ -326,6 +378,10 @@ export {
     constexpr std::string_view MEMORY_CACHE_MISS_VAR_NAME = "memory_cache_miss";             // global
     constexpr std::string_view DISK_CACHE_MISS_VAR_NAME = "disk_cache_miss";                 // global
     constexpr std::string_view ENABLE_PROFILE_VAR_NAME = "profile";                          // global
+    constexpr std::string_view QUERY_PRIORITY_VAR_NAME = "query_priority";                   // session
+    constexpr std::string_view INTERACTIVE_TASK_METRICS_VAR_NAME = "interactive_task_metrics"; // global
+    constexpr std::string_view BATCH_TASK_METRICS_VAR_NAME = "batch_task_metrics";             // global
+    constexpr std::string_view BACKGROUND_TASK_METRICS_VAR_NAME = "background_task_metrics";   // global
 
     // IO related
     constexpr SizeT DEFAULT_READ_BUFFER_SIZE = 4096;
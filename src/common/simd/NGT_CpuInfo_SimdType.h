@@ -42,6 +42,8 @@ public:
         SimdTypeAVX512VPOPCNTDQ,
         SimdTypeAVX512VBMI2,
         SimdTypeAVX512VNNI,
+        SimdTypeAVX512BF16,
+        SimdTypePOPCNT,
     };
     static bool is(SimdType type) {
 #if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
@@ -136,6 +138,16 @@ public:
             case SimdTypeAVX512VNNI:
                 return __builtin_cpu_supports("avx512vnni") > 0;
                 break;
+#endif
+#if defined(__AVX512BF16__)
+            case SimdTypeAVX512BF16:
+                return __builtin_cpu_supports("avx512bf16") > 0;
+                break;
+#endif
+#if defined(__POPCNT__)
+            case SimdTypePOPCNT:
+                return __builtin_cpu_supports("popcnt") > 0;
+                break;
 #endif
             default:
                 break;
@@ -160,6 +172,9 @@ public:
     static bool isAVX2() { return is(SimdTypeAVX2); }
     static bool isAVX512() { return is(SimdTypeAVX512F); }
     static bool isAVX512BW() { return is(SimdTypeAVX512BW); }
+    static bool isAVX512BF16() { return is(SimdTypeAVX512BF16); }
+    static bool isAVX512VPOPCNTDQ() { return is(SimdTypeAVX512VPOPCNTDQ); }
+    static bool isPOPCNT() { return is(SimdTypePOPCNT); }
     static std::vector<char const *> getSupportedSimdTypes() {
         static constexpr char const *simdTypes[] = {"f16c",
                                                     "sse2",
@@ -178,9 +193,11 @@ public:
                                                     "avx5124fmaps",
                                                     "avx512vpopcntdq",
                                                     "avx512vbmi2",
-                                                    "avx512vnni"};
+                                                    "avx512vnni",
+                                                    "avx512bf16",
+                                                    "popcnt"};
         static constexpr int size = std::size(simdTypes);
-        static_assert(size == SimdType::SimdTypeAVX512VNNI + 1, "The number of SIMD types is not correct.");
+        static_assert(size == SimdType::SimdTypePOPCNT + 1, "The number of SIMD types is not correct.");
         std::vector<char const *> types;
         for (int i = 0; i < size; ++i) {
             if (is(static_cast<SimdType>(i))) {
@@ -16,6 +16,7 @@ module;
 
 #include "simd_common_intrin_include.h"
 #include <cmath>
+#include <cstring>
 
 /*
 #if defined(__x86_64__) && (defined(__clang_major__) && (__clang_major__ > 10))
@@ -127,6 +128,44 @@ f32 HammingDistance_sse2(const u8 *x, const u8 *y, SizeT d) {
 
 #endif // defined (__SSE2__)
 
+#if defined(__POPCNT__)
+
+// 64 bits per popcnt, the tail bytes go to the common version
+f32 HammingDistance_popcnt(const u8 *x, const u8 *y, SizeT d) {
+    u64 result = 0;
+    SizeT pos = 0;
+    for (; pos + 8 <= d; pos += 8) {
+        u64 x_word, y_word;
+        std::memcpy(&x_word, x + pos, sizeof(u64));
+        std::memcpy(&y_word, y + pos, sizeof(u64));
+        result += _mm_popcnt_u64(x_word ^ y_word);
+    }
+    f32 tail = pos < d ? HammingDistance_common(x + pos, y + pos, d - pos) : 0;
+    return static_cast<f32>(result) + tail;
+}
+
+#endif // defined (__POPCNT__)
+
+#if defined(__AVX512VPOPCNTDQ__) && defined(__AVX512BW__)
+
+f32 HammingDistance_avx512vpopcntdq(const u8 *x, const u8 *y, SizeT d) {
+    __m512i sum = _mm512_setzero_si512();
+    SizeT pos = 0;
+    // 8 * 64 = 512
+    for (; pos + 64 <= d; pos += 64) {
+        __m512i xor_result = _mm512_xor_si512(_mm512_loadu_si512(x + pos), _mm512_loadu_si512(y + pos));
+        sum = _mm512_add_epi64(sum, _mm512_popcnt_epi64(xor_result));
+    }
+    if (pos < d) {
+        const __mmask64 mask = (1ULL << (d - pos)) - 1;
+        __m512i xor_result = _mm512_xor_si512(_mm512_maskz_loadu_epi8(mask, x + pos), _mm512_maskz_loadu_epi8(mask, y + pos));
+        sum = _mm512_add_epi64(sum, _mm512_popcnt_epi64(xor_result));
+    }
+    return static_cast<f32>(_mm512_reduce_add_epi64(sum));
+}
+
+#endif // defined (__AVX512VPOPCNTDQ__) && defined(__AVX512BW__)
+
 #if defined(__AVX2__)
 inline f32 L2Distance_avx2_128(const f32 *vector1, const f32 *vector2, SizeT) {
     __m256 diff_1 = _mm256_sub_ps(_mm256_loadu_ps(vector1), _mm256_loadu_ps(vector2));
@@ -42,4 +42,12 @@ export f32 HammingDistance_avx2(const u8 *vector1, const u8 *vector2, SizeT dime
 export f32 HammingDistance_sse2(const u8 *vector1, const u8 *vector2, SizeT dimesion);
 #endif
 
+#if defined(__POPCNT__)
+export f32 HammingDistance_popcnt(const u8 *vector1, const u8 *vector2, SizeT dimension);
+#endif
+
+#if defined(__AVX512VPOPCNTDQ__) && defined(__AVX512BW__)
+export f32 HammingDistance_avx512vpopcntdq(const u8 *vector1, const u8 *vector2, SizeT dimension);
+#endif
+
 } // namespace infinity
@@ -0,0 +1,319 @@
+// Copyright(C) 2023 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+module;
+
+#include "simd_common_intrin_include.h"
+#include <cmath>
+
+export module half_float_simd_funcs;
+
+import stl;
+import simd_common_tools;
+import internal_types;
+
+namespace infinity {
+
+// Distance and conversion kernels of Float16T and BFloat16T vectors.
+// The elements are widened to f32 and accumulated in f32, so the precision matches the f32 kernels.
+
+template <typename T>
+f32 HalfL2BF(const T *pv1, const T *pv2, SizeT dim) {
+    f32 res = 0;
+    for (SizeT i = 0; i < dim; ++i) {
+        f32 t = f32(pv1[i]) - f32(pv2[i]);
+        res += t * t;
+    }
+    return res;
+}
+
+template <typename T>
+f32 HalfIPBF(const T *pv1, const T *pv2, SizeT dim) {
+    f32 res = 0;
+    for (SizeT i = 0; i < dim; ++i) {
+        res += f32(pv1[i]) * f32(pv2[i]);
+    }
+    return res;
+}
+
+template <typename T>
+f32 HalfCosBF(const T *pv1, const T *pv2, SizeT dim) {
+    f32 dot_product = 0;
+    f32 norm1 = 0;
+    f32 norm2 = 0;
+    for (SizeT i = 0; i < dim; ++i) {
+        f32 v1 = pv1[i];
+        f32 v2 = pv2[i];
+        dot_product += v1 * v2;
+        norm1 += v1 * v1;
+        norm2 += v2 * v2;
+    }
+    return dot_product ? dot_product / std::sqrt(norm1 * norm2) : 0.0f;
+}
+
+template <typename T>
+void HalfToF32BF(const T *src, f32 *dst, SizeT n) {
+    for (SizeT i = 0; i < n; ++i) {
+        dst[i] = f32(src[i]);
+    }
+}
+
+export f32 F16L2BF(const Float16T *pv1, const Float16T *pv2, SizeT dim) { return HalfL2BF(pv1, pv2, dim); }
+export f32 F16IPBF(const Float16T *pv1, const Float16T *pv2, SizeT dim) { return HalfIPBF(pv1, pv2, dim); }
+export f32 F16CosBF(const Float16T *pv1, const Float16T *pv2, SizeT dim) { return HalfCosBF(pv1, pv2, dim); }
+export void F16ToF32BF(const Float16T *src, f32 *dst, SizeT n) { HalfToF32BF(src, dst, n); }
+
+export f32 BF16L2BF(const BFloat16T *pv1, const BFloat16T *pv2, SizeT dim) { return HalfL2BF(pv1, pv2, dim); }
+export f32 BF16IPBF(const BFloat16T *pv1, const BFloat16T *pv2, SizeT dim) { return HalfIPBF(pv1, pv2, dim); }
+export f32 BF16CosBF(const BFloat16T *pv1, const BFloat16T *pv2, SizeT dim) { return HalfCosBF(pv1, pv2, dim); }
+export void BF16ToF32BF(const BFloat16T *src, f32 *dst, SizeT n) { HalfToF32BF(src, dst, n); }
+
+#if defined(__AVX2__)
+
+// 8 elements widened to f32
+template <typename T>
+inline __m256 LoadHalf8AVX2(const T *p) {
+    if constexpr (std::is_same_v<T, Float16T>) {
+        return _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i *>(p)));
+    } else {
+        // bfloat16 is the high half of f32
+        __m256i v = _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(p)));
+        return _mm256_castsi256_ps(_mm256_slli_epi32(v, 16));
+    }
+}
+
+template <typename T>
+f32 HalfL2AVX2(const T *pv1, const T *pv2, SizeT dim) {
+    __m256 sum = _mm256_setzero_ps();
+    SizeT i = 0;
+    for (; i + 8 <= dim; i += 8) {
+        __m256 diff = _mm256_sub_ps(LoadHalf8AVX2(pv1 + i), LoadHalf8AVX2(pv2 + i));
+        sum = _mm256_add_ps(sum, _mm256_mul_ps(diff, diff));
+    }
+    f32 res = hsum256_ps_avx(sum);
+    for (; i < dim; ++i) {
+        f32 t = f32(pv1[i]) - f32(pv2[i]);
+        res += t * t;
+    }
+    return res;
+}
+
+template <typename T>
+f32 HalfIPAVX2(const T *pv1, const T *pv2, SizeT dim) {
+    __m256 sum = _mm256_setzero_ps();
+    SizeT i = 0;
+    for (; i + 8 <= dim; i += 8) {
+        sum = _mm256_add_ps(sum, _mm256_mul_ps(LoadHalf8AVX2(pv1 + i), LoadHalf8AVX2(pv2 + i)));
+    }
+    f32 res = hsum256_ps_avx(sum);
+    for (; i < dim; ++i) {
+        res += f32(pv1[i]) * f32(pv2[i]);
+    }
+    return res;
+}
+
+template <typename T>
+f32 HalfCosAVX2(const T *pv1, const T *pv2, SizeT dim) {
+    __m256 mul = _mm256_setzero_ps();
+    __m256 norm_v1 = _mm256_setzero_ps();
+    __m256 norm_v2 = _mm256_setzero_ps();
+    SizeT i = 0;
+    for (; i + 8 <= dim; i += 8) {
+        __m256 v1 = LoadHalf8AVX2(pv1 + i);
+        __m256 v2 = LoadHalf8AVX2(pv2 + i);
+        mul = _mm256_add_ps(mul, _mm256_mul_ps(v1, v2));
+        norm_v1 = _mm256_add_ps(norm_v1, _mm256_mul_ps(v1, v1));
+        norm_v2 = _mm256_add_ps(norm_v2, _mm256_mul_ps(v2, v2));
+    }
+    f32 mul_res = hsum256_ps_avx(mul);
+    f32 v1_res = hsum256_ps_avx(norm_v1);
+    f32 v2_res = hsum256_ps_avx(norm_v2);
+    for (; i < dim; ++i) {
+        f32 v1 = pv1[i];
+        f32 v2 = pv2[i];
+        mul_res += v1 * v2;
+        v1_res += v1 * v1;
+        v2_res += v2 * v2;
+    }
+    return mul_res != 0 ? mul_res / std::sqrt(v1_res * v2_res) : 0;
+}
+
+template <typename T>
+void HalfToF32AVX2(const T *src, f32 *dst, SizeT n) {
+    SizeT i = 0;
+    for (; i + 8 <= n; i += 8) {
+        _mm256_storeu_ps(dst + i, LoadHalf8AVX2(src + i));
+    }
+    for (; i < n; ++i) {
+        dst[i] = f32(src[i]);
+    }
+}
+
+#if defined(__F16C__)
+
+export f32 F16L2AVX2(const Float16T *pv1, const Float16T *pv2, SizeT dim) { return HalfL2AVX2(pv1, pv2, dim); }
+export f32 F16IPAVX2(const Float16T *pv1, const Float16T *pv2, SizeT dim) { return HalfIPAVX2(pv1, pv2, dim); }
+export f32 F16CosAVX2(const Float16T *pv1, const Float16T *pv2, SizeT dim) { return HalfCosAVX2(pv1, pv2, dim); }
+export void F16ToF32AVX2(const Float16T *src, f32 *dst, SizeT n) { HalfToF32AVX2(src, dst, n); }
+
+#endif
+
+export f32 BF16L2AVX2(const BFloat16T *pv1, const BFloat16T *pv2, SizeT dim) { return HalfL2AVX2(pv1, pv2, dim); }
+export f32 BF16IPAVX2(const BFloat16T *pv1, const BFloat16T *pv2, SizeT dim) { return HalfIPAVX2(pv1, pv2, dim); }
+export f32 BF16CosAVX2(const BFloat16T *pv1, const BFloat16T *pv2, SizeT dim) { return HalfCosAVX2(pv1, pv2, dim); }
+export void BF16ToF32AVX2(const BFloat16T *src, f32 *dst, SizeT n) { HalfToF32AVX2(src, dst, n); }
+
+#endif
+
+#if defined(__AVX512F__)
+
+// 16 elements widened to f32
+template <typename T>
+inline __m512 LoadHalf16AVX512(const T *p) {
+    if constexpr (std::is_same_v<T, Float16T>) {
+        return _mm512_cvtph_ps(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(p)));
+    } else {
+        __m512i v = _mm512_cvtepu16_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(p)));
+        return _mm512_castsi512_ps(_mm512_slli_epi32(v, 16));
+    }
+}
+
+template <typename T>
+f32 HalfL2AVX512(const T *pv1, const T *pv2, SizeT dim) {
+    __m512 sum = _mm512_setzero_ps();
+    SizeT i = 0;
+    for (; i + 16 <= dim; i += 16) {
+        __m512 diff = _mm512_sub_ps(LoadHalf16AVX512(pv1 + i), LoadHalf16AVX512(pv2 + i));
+        sum = _mm512_fmadd_ps(diff, diff, sum);
+    }
+    f32 res = _mm512_reduce_add_ps(sum);
+    for (; i < dim; ++i) {
+        f32 t = f32(pv1[i]) - f32(pv2[i]);
+        res += t * t;
+    }
+    return res;
+}
+
+template <typename T>
+f32 HalfIPAVX512(const T *pv1, const T *pv2, SizeT dim) {
+    __m512 sum = _mm512_setzero_ps();
+    SizeT i = 0;
+    for (; i + 16 <= dim; i += 16) {
+        sum = _mm512_fmadd_ps(LoadHalf16AVX512(pv1 + i), LoadHalf16AVX512(pv2 + i), sum);
+    }
+    f32 res = _mm512_reduce_add_ps(sum);
+    for (; i < dim; ++i) {
+        res += f32(pv1[i]) * f32(pv2[i]);
+    }
+    return res;
+}
+
+template <typename T>
+f32 HalfCosAVX512(const T *pv1, const T *pv2, SizeT dim) {
+    __m512 mul = _mm512_setzero_ps();
+    __m512 norm_v1 = _mm512_setzero_ps();
+    __m512 norm_v2 = _mm512_setzero_ps();
+    SizeT i = 0;
+    for (; i + 16 <= dim; i += 16) {
+        __m512 v1 = LoadHalf16AVX512(pv1 + i);
+        __m512 v2 = LoadHalf16AVX512(pv2 + i);
+        mul = _mm512_fmadd_ps(v1, v2, mul);
+        norm_v1 = _mm512_fmadd_ps(v1, v1, norm_v1);
+        norm_v2 = _mm512_fmadd_ps(v2, v2, norm_v2);
+    }
+    f32 mul_res = _mm512_reduce_add_ps(mul);
+    f32 v1_res = _mm512_reduce_add_ps(norm_v1);
+    f32 v2_res = _mm512_reduce_add_ps(norm_v2);
+    for (; i < dim; ++i) {
+        f32 v1 = pv1[i];
+        f32 v2 = pv2[i];
+        mul_res += v1 * v2;
+        v1_res += v1 * v1;
+        v2_res += v2 * v2;
+    }
+    return mul_res != 0 ? mul_res / std::sqrt(v1_res * v2_res) : 0;
+}
+
+template <typename T>
+void HalfToF32AVX512(const T *src, f32 *dst, SizeT n) {
+    SizeT i = 0;
+    for (; i + 16 <= n; i += 16) {
+        _mm512_storeu_ps(dst + i, LoadHalf16AVX512(src + i));
+    }
+    for (; i < n; ++i) {
+        dst[i] = f32(src[i]);
+    }
+}
+
+export f32 F16L2AVX512(const Float16T *pv1, const Float16T *pv2, SizeT dim) { return HalfL2AVX512(pv1, pv2, dim); }
+export f32 F16IPAVX512(const Float16T *pv1, const Float16T *pv2, SizeT dim) { return HalfIPAVX512(pv1, pv2, dim); }
+export f32 F16CosAVX512(const Float16T *pv1, const Float16T *pv2, SizeT dim) { return HalfCosAVX512(pv1, pv2, dim); }
+export void F16ToF32AVX512(const Float16T *src, f32 *dst, SizeT n) { HalfToF32AVX512(src, dst, n); }
+
+export f32 BF16L2AVX512(const BFloat16T *pv1, const BFloat16T *pv2, SizeT dim) { return HalfL2AVX512(pv1, pv2, dim); }
+export f32 BF16IPAVX512(const BFloat16T *pv1, const BFloat16T *pv2, SizeT dim) { return HalfIPAVX512(pv1, pv2, dim); }
+export f32 BF16CosAVX512(const BFloat16T *pv1, const BFloat16T *pv2, SizeT dim) { return HalfCosAVX512(pv1, pv2, dim); }
+export void BF16ToF32AVX512(const BFloat16T *src, f32 *dst, SizeT n) { HalfToF32AVX512(src, dst, n); }
+
+#endif
+
+#if defined(__AVX512BF16__)
+
+// vdpbf16ps multiplies 32 pairs of bfloat16 and accumulates them into 16 f32 lanes.
+// The products of bfloat16 are exact in f32, so there is no widening step.
+// L2 is left to the widening kernel, for the difference of close vectors cancels in |a|^2 + |b|^2 - 2ab.
+
+inline __m512bh LoadBF16x32(const BFloat16T *p) { return (__m512bh)_mm512_loadu_si512(p); }
+
+export f32 BF16IPAVX512BF16(const BFloat16T *pv1, const BFloat16T *pv2, SizeT dim) {
+    __m512 sum = _mm512_setzero_ps();
+    SizeT i = 0;
+    for (; i + 32 <= dim; i += 32) {
+        sum = _mm512_dpbf16_ps(sum, LoadBF16x32(pv1 + i), LoadBF16x32(pv2 + i));
+    }
+    f32 res = _mm512_reduce_add_ps(sum);
+    for (; i < dim; ++i) {
+        res += f32(pv1[i]) * f32(pv2[i]);
+    }
+    return res;
+}
+
+export f32 BF16CosAVX512BF16(const BFloat16T *pv1, const BFloat16T *pv2, SizeT dim) {
+    __m512 mul = _mm512_setzero_ps();
+    __m512 norm_v1 = _mm512_setzero_ps();
+    __m512 norm_v2 = _mm512_setzero_ps();
+    SizeT i = 0;
+    for (; i + 32 <= dim; i += 32) {
+        __m512bh v1 = LoadBF16x32(pv1 + i);
+        __m512bh v2 = LoadBF16x32(pv2 + i);
+        mul = _mm512_dpbf16_ps(mul, v1, v2);
+        norm_v1 = _mm512_dpbf16_ps(norm_v1, v1, v1);
+        norm_v2 = _mm512_dpbf16_ps(norm_v2, v2, v2);
+    }
+    f32 mul_res = _mm512_reduce_add_ps(mul);
+    f32 v1_res = _mm512_reduce_add_ps(norm_v1);
+    f32 v2_res = _mm512_reduce_add_ps(norm_v2);
+    for (; i < dim; ++i) {
+        f32 v1 = pv1[i];
+        f32 v2 = pv2[i];
+        mul_res += v1 * v2;
+        v1_res += v1 * v1;
+        v2_res += v2 * v2;
+    }
+    return mul_res != 0 ? mul_res / std::sqrt(v1_res * v2_res) : 0;
+}
+
+#endif
+
+} // namespace infinity
@@ -0,0 +1,107 @@
+// Copyright(C) 2023 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+module;
+
+#include "simd_common_intrin_include.h"
+
+export module quantization_simd_funcs;
+
+import stl;
+import simd_common_tools;
+
+namespace infinity {
+
+// Kernels of the quantized HNSW encodings.
+// PQ: the asymmetric distance is the sum of the query table entries selected by the codes, the table is [subspace_num][256].
+// Binary: the 4 bit planes of the quantized query are weighted by the popcounts of their AND with the code.
+
+export f32 PQADCBF(const f32 *table, const u8 *code, SizeT subspace_num) {
+    f32 res = 0;
+    for (SizeT m = 0; m < subspace_num; ++m) {
+        res += table[m * 256 + code[m]];
+    }
+    return res;
+}
+
+export u32 BinaryPlaneIPBF(const u64 *code, const u64 *planes, SizeT word_n) {
+    u32 res = 0;
+    for (SizeT j = 0; j < 4; ++j) {
+        const u64 *plane = planes + j * word_n;
+        u32 cnt = 0;
+        for (SizeT i = 0; i < word_n; ++i) {
+            cnt += __builtin_popcountll(code[i] & plane[i]);
+        }
+        res += cnt << j;
+    }
+    return res;
+}
+
+#if defined(__AVX2__)
+export f32 PQADCAVX2(const f32 *table, const u8 *code, SizeT subspace_num) {
+    const __m256i offset = _mm256_setr_epi32(0, 256, 512, 768, 1024, 1280, 1536, 1792);
+    __m256 sum = _mm256_setzero_ps();
+    SizeT m = 0;
+    for (; m + 8 <= subspace_num; m += 8) {
+        __m256i idx = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(code + m)));
+        idx = _mm256_add_epi32(idx, offset);
+        sum = _mm256_add_ps(sum, _mm256_i32gather_ps(table + m * 256, idx, 4));
+    }
+    f32 res = hsum256_ps_avx(sum);
+    for (; m < subspace_num; ++m) {
+        res += table[m * 256 + code[m]];
+    }
+    return res;
+}
+
+export u32 BinaryPlaneIPAVX2(const u64 *code, const u64 *planes, SizeT word_n) {
+    u32 res = 0;
+    for (SizeT j = 0; j < 4; ++j) {
+        const u64 *plane = planes + j * word_n;
+        u32 cnt = 0;
+        SizeT i = 0;
+        for (; i + 4 <= word_n; i += 4) {
+            __m256i c = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(code + i));
+            __m256i p = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(plane + i));
+            cnt += popcount_avx2(_mm256_and_si256(c, p));
+        }
+        for (; i < word_n; ++i) {
+            cnt += __builtin_popcountll(code[i] & plane[i]);
+        }
+        res += cnt << j;
+    }
+    return res;
+}
+#endif
+
+#if defined(__AVX512F__)
+export f32 PQADCAVX512(const f32 *table, const u8 *code, SizeT subspace_num) {
+    const __m512i offset = _mm512_setr_epi32(0, 256, 512, 768, 1024, 1280, 1536, 1792, 2048, 2304, 2560, 2816, 3072, 3328, 3584, 3840);
+    __m512 sum = _mm512_setzero_ps();
+    SizeT m = 0;
+    for (; m + 16 <= subspace_num; m += 16) {
+        __m512i idx = _mm512_cvtepu8_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(code + m)));
+        idx = _mm512_add_epi32(idx, offset);
+        sum = _mm512_add_ps(sum, _mm512_i32gather_ps(idx, table + m * 256, 4));
+    }
+    f32 res = _mm512_reduce_add_ps(sum);
+    for (; m < subspace_num; ++m) {
+        res += table[m * 256 + code[m]];
+    }
+    return res;
+}
+#endif
+
+} // namespace infinity
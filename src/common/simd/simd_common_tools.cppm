@@ -150,6 +150,26 @@ export inline __m512i abs_sub_epu8_avx512(const __m512i a, const __m512i b) {
 }
 #endif
 
+// inclusive prefix sum in place, e.g. turns the d-gaps of a posting block into offsets
+export inline void PrefixSumU32(u32 *data, const SizeT n) {
+    SizeT i = 0;
+#if defined(__SSE2__)
+    __m128i carry = _mm_setzero_si128();
+    for (; i + 4 <= n; i += 4) {
+        __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i));
+        x = _mm_add_epi32(x, _mm_slli_si128(x, 4));
+        x = _mm_add_epi32(x, _mm_slli_si128(x, 8));
+        x = _mm_add_epi32(x, carry);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(data + i), x);
+        carry = _mm_shuffle_epi32(x, _MM_SHUFFLE(3, 3, 3, 3));
+    }
+#endif
+    for (u32 sum = i ? data[i - 1] : 0; i < n; ++i) {
+        sum += data[i];
+        data[i] = sum;
+    }
+}
+
 // https://github.com/WojciechMula/sse-popcount/blob/master/popcnt-avx2-harley-seal.cpp
 #if defined(__AVX2__)
 export inline int popcount_avx2(const __m256i v) {
@@ -57,6 +57,24 @@ export struct SIMD_FUNCTIONS {
     U8DistanceFuncType HNSW_U8IP_64_ptr_ = Get_HNSW_U8IP_64_ptr();
     U8CosDistanceFuncType HNSW_U8Cos_ptr_ = Get_HNSW_U8Cos_ptr();
 
+    // HNSW F16
+    F16DistanceFuncType HNSW_F16L2_ptr_ = Get_HNSW_F16L2_ptr();
+    F16DistanceFuncType HNSW_F16IP_ptr_ = Get_HNSW_F16IP_ptr();
+    F16DistanceFuncType HNSW_F16Cos_ptr_ = Get_HNSW_F16Cos_ptr();
+
+    // HNSW BF16
+    BF16DistanceFuncType HNSW_BF16L2_ptr_ = Get_HNSW_BF16L2_ptr();
+    BF16DistanceFuncType HNSW_BF16IP_ptr_ = Get_HNSW_BF16IP_ptr();
+    BF16DistanceFuncType HNSW_BF16Cos_ptr_ = Get_HNSW_BF16Cos_ptr();
+
+    // F16 and BF16 to F32
+    F16ToF32FuncType F16ToF32_func_ptr_ = GetF16ToF32FuncPtr();
+    BF16ToF32FuncType BF16ToF32_func_ptr_ = GetBF16ToF32FuncPtr();
+
+    // HNSW PQ and binary encodings
+    PQADCFuncType PQADC_func_ptr_ = GetPQADCFuncPtr();
+    BinaryPlaneIPFuncType BinaryPlaneIP_func_ptr_ = GetBinaryPlaneIPFuncPtr();
+
     // MaxSim IP
     MaxSimF32BitIPFuncType MaxSimF32BitIP_func_ptr_ = GetMaxSimF32BitIPFuncPtr();
     MaxSimI32BitIPFuncType MaxSimI32BitIP_func_ptr_ = GetMaxSimI32BitIPFuncPtr();
@@ -22,6 +22,9 @@ import maxsim_simd_funcs;
 import emvb_simd_funcs;
 import search_top_1_sgemm;
 import batch_bm25_simd_funcs;
+import half_float_simd_funcs;
+import quantization_simd_funcs;
+import internal_types;
 
 namespace infinity {
 
@@ -68,11 +71,25 @@ F32DistanceFuncType GetCosineDistanceFuncPtr() {
 }
 
 U8HammingDistanceFuncType GetHammingDistanceFuncPtr() {
+#if defined(__AVX512VPOPCNTDQ__) && defined(__AVX512BW__)
+    if (IsAVX512VPOPCNTDQSupported() && IsAVX512BWSupported()) {
+        return &HammingDistance_avx512vpopcntdq;
+    }
+#endif
+#ifdef __POPCNT__
+    if (IsPOPCNTSupported()) {
+        return &HammingDistance_popcnt;
+    }
+#endif
 #ifdef __AVX2__
-    return &HammingDistance_avx2;
+    if (IsAVX2Supported()) {
+        return &HammingDistance_avx2;
+    }
 #endif
 #ifdef __SSE2__
-    return &HammingDistance_sse2;
+    if (IsSSE2Supported()) {
+        return &HammingDistance_sse2;
+    }
 #endif
     return &HammingDistance_common;
 }
@@ -533,6 +550,151 @@ U8CosDistanceFuncType Get_HNSW_U8Cos_ptr() {
     return &U8CosBF;
 }
 
+F16DistanceFuncType Get_HNSW_F16L2_ptr() {
+#if defined(__AVX512F__)
+    if (IsAVX512Supported()) {
+        return &F16L2AVX512;
+    }
+#endif
+#if defined(__AVX2__) && defined(__F16C__)
+    if (IsAVX2Supported() && IsF16CSupported()) {
+        return &F16L2AVX2;
+    }
+#endif
+    return &F16L2BF;
+}
+
+F16DistanceFuncType Get_HNSW_F16IP_ptr() {
+#if defined(__AVX512F__)
+    if (IsAVX512Supported()) {
+        return &F16IPAVX512;
+    }
+#endif
+#if defined(__AVX2__) && defined(__F16C__)
+    if (IsAVX2Supported() && IsF16CSupported()) {
+        return &F16IPAVX2;
+    }
+#endif
+    return &F16IPBF;
+}
+
+F16DistanceFuncType Get_HNSW_F16Cos_ptr() {
+#if defined(__AVX512F__)
+    if (IsAVX512Supported()) {
+        return &F16CosAVX512;
+    }
+#endif
+#if defined(__AVX2__) && defined(__F16C__)
+    if (IsAVX2Supported() && IsF16CSupported()) {
+        return &F16CosAVX2;
+    }
+#endif
+    return &F16CosBF;
+}
+
+BF16DistanceFuncType Get_HNSW_BF16L2_ptr() {
+#if defined(__AVX512F__)
+    if (IsAVX512Supported()) {
+        return &BF16L2AVX512;
+    }
+#endif
+#if defined(__AVX2__)
+    if (IsAVX2Supported()) {
+        return &BF16L2AVX2;
+    }
+#endif
+    return &BF16L2BF;
+}
+
+BF16DistanceFuncType Get_HNSW_BF16IP_ptr() {
+#if defined(__AVX512BF16__)
+    if (IsAVX512BF16Supported()) {
+        return &BF16IPAVX512BF16;
+    }
+#endif
+#if defined(__AVX512F__)
+    if (IsAVX512Supported()) {
+        return &BF16IPAVX512;
+    }
+#endif
+#if defined(__AVX2__)
+    if (IsAVX2Supported()) {
+        return &BF16IPAVX2;
+    }
+#endif
+    return &BF16IPBF;
+}
+
+BF16DistanceFuncType Get_HNSW_BF16Cos_ptr() {
+#if defined(__AVX512BF16__)
+    if (IsAVX512BF16Supported()) {
+        return &BF16CosAVX512BF16;
+    }
+#endif
+#if defined(__AVX512F__)
+    if (IsAVX512Supported()) {
+        return &BF16CosAVX512;
+    }
+#endif
+#if defined(__AVX2__)
+    if (IsAVX2Supported()) {
+        return &BF16CosAVX2;
+    }
+#endif
+    return &BF16CosBF;
+}
+
+F16ToF32FuncType GetF16ToF32FuncPtr() {
+#if defined(__AVX512F__)
+    if (IsAVX512Supported()) {
+        return &F16ToF32AVX512;
+    }
+#endif
+#if defined(__AVX2__) && defined(__F16C__)
+    if (IsAVX2Supported() && IsF16CSupported()) {
+        return &F16ToF32AVX2;
+    }
+#endif
+    return &F16ToF32BF;
+}
+
+BF16ToF32FuncType GetBF16ToF32FuncPtr() {
+#if defined(__AVX512F__)
+    if (IsAVX512Supported()) {
+        return &BF16ToF32AVX512;
+    }
+#endif
+#if defined(__AVX2__)
+    if (IsAVX2Supported()) {
+        return &BF16ToF32AVX2;
+    }
+#endif
+    return &BF16ToF32BF;
+}
+
+PQADCFuncType GetPQADCFuncPtr() {
+#if defined(__AVX512F__)
+    if (IsAVX512Supported()) {
+        return &PQADCAVX512;
+    }
+#endif
+#if defined(__AVX2__)
+    if (IsAVX2Supported()) {
+        return &PQADCAVX2;
+    }
+#endif
+    return &PQADCBF;
+}
+
+BinaryPlaneIPFuncType GetBinaryPlaneIPFuncPtr() {
+#if defined(__AVX2__)
+    if (IsAVX2Supported()) {
+        return &BinaryPlaneIPAVX2;
+    }
+#endif
+    return &BinaryPlaneIPBF;
+}
+
 MaxSimF32BitIPFuncType GetMaxSimF32BitIPFuncPtr() {
 #if defined(__AVX512F__)
     if (IsAVX512Supported()) {
@@ -17,6 +17,7 @@ module;
 #include "simd_init_h.h"
 export module simd_init;
 import stl;
+import internal_types;
 
 namespace infinity {
 
@@ -26,6 +27,9 @@ export using infinity::IsSSE2Supported;
 export using infinity::IsAVX2Supported;
 export using infinity::IsAVX512Supported;
 export using infinity::IsAVX512BWSupported;
+export using infinity::IsAVX512BF16Supported;
+export using infinity::IsAVX512VPOPCNTDQSupported;
+export using infinity::IsPOPCNTSupported;
 
 export using F32DistanceFuncType = f32 (*)(const f32 *, const f32 *, SizeT);
 export using I8DistanceFuncType = i32 (*)(const i8 *, const i8 *, SizeT);
@@ -34,6 +38,14 @@ export using U8DistanceFuncType = i32 (*)(const u8 *, const u8 *, SizeT);
 // dimension in hamming distance is in bytes
 export using U8HammingDistanceFuncType = f32 (*)(const u8 *, const u8 *, SizeT);
 export using U8CosDistanceFuncType = f32 (*)(const u8 *, const u8 *, SizeT);
+export using F16DistanceFuncType = f32 (*)(const Float16T *, const Float16T *, SizeT);
+export using BF16DistanceFuncType = f32 (*)(const BFloat16T *, const BFloat16T *, SizeT);
+export using F16ToF32FuncType = void (*)(const Float16T *, f32 *, SizeT);
+export using BF16ToF32FuncType = void (*)(const BFloat16T *, f32 *, SizeT);
+// PQ table, codes, subspace num
+export using PQADCFuncType = f32 (*)(const f32 *, const u8 *, SizeT);
+// binary code, 4 query bit planes, words of a plane
+export using BinaryPlaneIPFuncType = u32 (*)(const u64 *, const u64 *, SizeT);
 export using MaxSimF32BitIPFuncType = f32 (*)(const f32 *, const u8 *, SizeT);
 export using MaxSimI32BitIPFuncType = i32 (*)(const i32 *, const u8 *, SizeT);
 export using MaxSimI64BitIPFuncType = i64 (*)(const i64 *, const u8 *, SizeT);
@@ -76,6 +88,20 @@ export U8DistanceFuncType Get_HNSW_U8IP_16_ptr();
 export U8DistanceFuncType Get_HNSW_U8IP_32_ptr();
 export U8DistanceFuncType Get_HNSW_U8IP_64_ptr();
 export U8CosDistanceFuncType Get_HNSW_U8Cos_ptr();
+// HNSW F16
+export F16DistanceFuncType Get_HNSW_F16L2_ptr();
+export F16DistanceFuncType Get_HNSW_F16IP_ptr();
+export F16DistanceFuncType Get_HNSW_F16Cos_ptr();
+// HNSW BF16
+export BF16DistanceFuncType Get_HNSW_BF16L2_ptr();
+export BF16DistanceFuncType Get_HNSW_BF16IP_ptr();
+export BF16DistanceFuncType Get_HNSW_BF16Cos_ptr();
+// F16 and BF16 to F32
+export F16ToF32FuncType GetF16ToF32FuncPtr();
+export BF16ToF32FuncType GetBF16ToF32FuncPtr();
+// HNSW quantized encodings
+export PQADCFuncType GetPQADCFuncPtr();
+export BinaryPlaneIPFuncType GetBinaryPlaneIPFuncPtr();
 // MaxSim IP
 export MaxSimF32BitIPFuncType GetMaxSimF32BitIPFuncPtr();
 export MaxSimI32BitIPFuncType GetMaxSimI32BitIPFuncPtr();
@@ -14,6 +14,9 @@
 
 module;
 
+#include <cctype>
+#include <filesystem>
+#include <string>
 #include <thread>
 #ifdef __APPLE__
 #include <mach/mach_init.h>
@@ -97,4 +100,24 @@ bool ThreadUtil::pin(Thread &thread, const u16 cpu_id) {
 #endif
 }
 
+u32 ThreadUtil::numa_node(const u16 cpu_id) {
+#if defined(__APPLE__)
+    return 0;
+#else
+    // The cpu directory contains a "node<N>" link to the NUMA node it belongs to.
+    std::error_code error_code;
+    std::filesystem::directory_iterator iter("/sys/devices/system/cpu/cpu" + std::to_string(cpu_id), error_code);
+    if (error_code) {
+        return 0;
+    }
+    for (const auto &entry : iter) {
+        const std::string file_name = entry.path().filename().string();
+        if (file_name.size() > 4 && file_name.compare(0, 4, "node") == 0 && std::isdigit(file_name[4])) {
+            return std::stoul(file_name.substr(4));
+        }
+    }
+    return 0;
+#endif
+}
+
 } // namespace infinity
@@ -0,0 +1,81 @@
+// Copyright(C) 2024 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+module;
+
+export module work_stealing_queue;
+
+import stl;
+
+namespace infinity {
+
+// Bounded lock-free run queue of one worker thread, T must be a pointer type.
+// Only the owner pushes, at the tail. The owner and the thieves all take from the head with a CAS,
+// so the owner runs its tasks in FIFO order and a thief always steals the oldest task.
+export template <typename T>
+class WorkStealingQueue {
+public:
+    explicit WorkStealingQueue(SizeT capacity) {
+        SizeT real_capacity = 1;
+        while (real_capacity < capacity) {
+            real_capacity <<= 1;
+        }
+        mask_ = real_capacity - 1;
+        slots_ = MakeUnique<Atomic<T>[]>(real_capacity);
+    }
+
+    // Owner only. Return false if the queue is full.
+    bool Push(T item) {
+        u64 tail = tail_.load(std::memory_order_relaxed);
+        u64 head = head_.load(std::memory_order_acquire);
+        if (tail - head > mask_) {
+            return false;
+        }
+        slots_[tail & mask_].store(item, std::memory_order_relaxed);
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Take the oldest item, nullptr if the queue is empty. Could be called by any thread.
+    T Pop() {
+        u64 head = head_.load(std::memory_order_acquire);
+        while (true) {
+            u64 tail = tail_.load(std::memory_order_acquire);
+            if (head >= tail) {
+                return nullptr;
+            }
+            // The slot could be overwritten by the owner once the head moves on, then the CAS below fails.
+            T item = slots_[head & mask_].load(std::memory_order_relaxed);
+            if (head_.compare_exchange_weak(head, head + 1, std::memory_order_acq_rel, std::memory_order_acquire)) {
+                return item;
+            }
+        }
+    }
+
+    [[nodiscard]] SizeT Size() const {
+        u64 head = head_.load(std::memory_order_acquire);
+        u64 tail = tail_.load(std::memory_order_acquire);
+        return tail > head ? tail - head : 0;
+    }
+
+    [[nodiscard]] SizeT Capacity() const { return mask_ + 1; }
+
+private:
+    alignas(64) Atomic<u64> head_{0};
+    alignas(64) Atomic<u64> tail_{0};
+    u64 mask_{};
+    UniquePtr<Atomic<T>[]> slots_{};
+};
+
+} // namespace infinity
@@ -61,6 +61,7 @@ import physical_merge_parallel_aggregate;
 import physical_intersect;
 import physical_except;
 import physical_hash;
+import join_reference;
 import physical_merge_hash;
 import physical_merge_limit;
 import physical_merge_top;
@@ -267,6 +268,7 @@ void ExplainPhysicalPlan::Explain(const PhysicalOperator *op, SharedPtr<Vector<S
             break;
         }
         case PhysicalOperatorType::kHash: {
+            Explain((PhysicalHash *)op, result, intent_size);
             break;
         }
         case PhysicalOperatorType::kMergeHash: {
@@ -868,6 +870,19 @@ void ExplainPhysicalPlan::Explain(const PhysicalKnnScan *knn_scan_node, SharedPt
         result->emplace_back(MakeShared<String>(filter_str));
     }
 
+    // filter strategy of the segments searched by the hnsw index, estimated without building the filter
+    if (const auto filter_plans = knn_scan_node->EstimateFilterPlans(); !filter_plans.empty()) {
+        result->emplace_back(MakeShared<String>(String(intent_size, ' ') + " - filter strategy (estimated):"));
+        for (const auto &[segment_id, filter_plan] : filter_plans) {
+            result->emplace_back(MakeShared<String>(fmt::format("{} - segment {}: {}, {} of {} rows match",
+                                                                String(intent_size + 2, ' '),
+                                                                segment_id,
+                                                                KnnFilterStrategyToString(filter_plan.strategy_),
+                                                                filter_plan.match_n_,
+                                                                filter_plan.row_count_)));
+        }
+    }
+
     // Output columns
     String output_columns = String(intent_size, ' ') + " - output columns: [";
     SizeT column_count = knn_scan_node->GetOutputNames()->size();
@@ -1914,9 +1929,52 @@ void ExplainPhysicalPlan::Explain(const PhysicalDummyScan *, SharedPtr<Vector<Sh
     RecoverableError(status);
 }
 
-void ExplainPhysicalPlan::Explain(const PhysicalHashJoin *, SharedPtr<Vector<SharedPtr<String>>> &, i64) {
-    Status status = Status::NotSupport("Not implemented");
-    RecoverableError(status);
+void ExplainPhysicalPlan::Explain(const PhysicalHashJoin *join_node, SharedPtr<Vector<SharedPtr<String>>> &result, i64 intent_size) {
+    String join_header;
+    if (intent_size != 0) {
+        join_header = String(intent_size - 2, ' ') + "-> HASH JOIN ";
+    } else {
+        join_header = "HASH JOIN ";
+    }
+
+    join_header += "(" + std::to_string(join_node->node_id()) + ")";
+    result->emplace_back(MakeShared<String>(join_header));
+
+    {
+        String join_type_str = String(intent_size, ' ') + " - type: " + JoinReference::ToString(join_node->join_type());
+        result->emplace_back(MakeShared<String>(join_type_str));
+    }
+
+    // Conditions
+    {
+        String condition_str = String(intent_size, ' ') + " - filters: [";
+
+        SizeT conditions_count = join_node->conditions().size();
+        if (conditions_count == 0) {
+            String error_message = "JOIN without any condition.";
+            UnrecoverableError(error_message);
+        }
+
+        for (SizeT idx = 0; idx < conditions_count - 1; ++idx) {
+            ExplainLogicalPlan::Explain(join_node->conditions()[idx].get(), condition_str);
+            condition_str += ", ";
+        }
+        ExplainLogicalPlan::Explain(join_node->conditions().back().get(), condition_str);
+        condition_str += "]";
+        result->emplace_back(MakeShared<String>(condition_str));
+    }
+
+    // Output column
+    {
+        String output_columns_str = String(intent_size, ' ') + " - output columns: [";
+        SharedPtr<Vector<String>> output_columns = join_node->GetOutputNames();
+        SizeT column_count = output_columns->size();
+        for (SizeT idx = 0; idx < column_count - 1; ++idx) {
+            output_columns_str += output_columns->at(idx) + ", ";
+        }
+        output_columns_str += output_columns->back() + "]";
+        result->emplace_back(MakeShared<String>(output_columns_str));
+    }
 }
 
 void ExplainPhysicalPlan::Explain(const PhysicalSortMergeJoin *, SharedPtr<Vector<SharedPtr<String>>> &, i64) {
@@ -2273,6 +2331,37 @@ void ExplainPhysicalPlan::Explain(const PhysicalParallelAggregate *parallel_aggr
     }
     explain_header_str += "(" + std::to_string(parallel_aggregate_node->node_id()) + ")";
     result->emplace_back(MakeShared<String>(explain_header_str));
+
+    // Aggregate expressions
+    {
+        String aggregate_expression_str = String(intent_size, ' ') + " - aggregate: [";
+        SizeT aggregates_count = parallel_aggregate_node->aggregates_.size();
+        for (SizeT idx = 0; idx < aggregates_count; ++idx) {
+            if (idx != 0) {
+                aggregate_expression_str += ", ";
+            }
+            ExplainLogicalPlan::Explain(parallel_aggregate_node->aggregates_[idx].get(), aggregate_expression_str);
+        }
+        aggregate_expression_str += "]";
+        result->emplace_back(MakeShared<String>(aggregate_expression_str));
+    }
+
+    // Group by expressions
+    {
+        String group_by_expression_str = String(intent_size, ' ') + " - group by: [";
+        SizeT groups_count = parallel_aggregate_node->groups_.size();
+        for (SizeT idx = 0; idx < groups_count; ++idx) {
+            if (idx != 0) {
+                group_by_expression_str += ", ";
+            }
+            ExplainLogicalPlan::Explain(parallel_aggregate_node->groups_[idx].get(), group_by_expression_str);
+        }
+        group_by_expression_str += "]";
+        result->emplace_back(MakeShared<String>(group_by_expression_str));
+    }
+
+    String partition_str = String(intent_size, ' ') + " - partitions: " + std::to_string(parallel_aggregate_node->partition_count());
+    result->emplace_back(MakeShared<String>(partition_str));
 }
 
 void ExplainPhysicalPlan::Explain(const PhysicalMergeParallelAggregate *merge_parallel_aggregate_node,
@@ -2287,6 +2376,21 @@ void ExplainPhysicalPlan::Explain(const PhysicalMergeParallelAggregate *merge_pa
     }
     explain_header_str += "(" + std::to_string(merge_parallel_aggregate_node->node_id()) + ")";
     result->emplace_back(MakeShared<String>(explain_header_str));
+
+    // Output column
+    {
+        String output_columns_str = String(intent_size, ' ') + " - output columns: [";
+        SharedPtr<Vector<String>> output_columns = merge_parallel_aggregate_node->GetOutputNames();
+        SizeT column_count = output_columns->size();
+        for (SizeT idx = 0; idx < column_count; ++idx) {
+            if (idx != 0) {
+                output_columns_str += ", ";
+            }
+            output_columns_str += output_columns->at(idx);
+        }
+        output_columns_str += "]";
+        result->emplace_back(MakeShared<String>(output_columns_str));
+    }
 }
 
 void ExplainPhysicalPlan::Explain(const PhysicalIntersect *intersect_node,
@@ -2326,6 +2430,20 @@ void ExplainPhysicalPlan::Explain(const PhysicalHash *hash_node, SharedPtr<Vecto
     }
     explain_header_str += "(" + std::to_string(hash_node->node_id()) + ")";
     result->emplace_back(MakeShared<String>(explain_header_str));
+
+    {
+        String keys_str = String(intent_size, ' ') + " - keys: [";
+        SharedPtr<Vector<String>> input_columns = hash_node->left()->GetOutputNames();
+        const Vector<SizeT> &key_column_ids = hash_node->key_column_ids();
+        for (SizeT idx = 0; idx < key_column_ids.size(); ++idx) {
+            if (idx != 0) {
+                keys_str += ", ";
+            }
+            keys_str += input_columns->at(key_column_ids[idx]);
+        }
+        keys_str += "]";
+        result->emplace_back(MakeShared<String>(keys_str));
+    }
 }
 
 void ExplainPhysicalPlan::Explain(const PhysicalMergeHash *merge_hash_node,
@@ -2451,6 +2569,36 @@ void ExplainPhysicalPlan::Explain(const PhysicalMergeSort *merge_sort_node,
     }
     explain_header_str += "(" + std::to_string(merge_sort_node->node_id()) + ")";
     result->emplace_back(MakeShared<String>(explain_header_str));
+
+    {
+        String sort_expression_str = String(intent_size, ' ') + " - expressions: [";
+        auto &sort_expressions = merge_sort_node->GetSortExpressions();
+        SizeT order_by_count = sort_expressions.size();
+        if (order_by_count == 0) {
+            String error_message = "MERGE SORT without any sort expression.";
+            UnrecoverableError(error_message);
+        }
+        auto &order_by_types = merge_sort_node->GetOrderbyTypes();
+        for (SizeT idx = 0; idx < order_by_count - 1; ++idx) {
+            ExplainLogicalPlan::Explain(sort_expressions[idx].get(), sort_expression_str);
+            sort_expression_str += " " + SelectStatement::ToString(order_by_types[idx]) + ", ";
+        }
+        ExplainLogicalPlan::Explain(sort_expressions.back().get(), sort_expression_str);
+        sort_expression_str += " " + SelectStatement::ToString(order_by_types.back()) + "]";
+        result->emplace_back(MakeShared<String>(sort_expression_str));
+    }
+
+    // Output column
+    {
+        String output_columns_str = String(intent_size, ' ') + " - output columns: [";
+        SharedPtr<Vector<String>> output_columns = merge_sort_node->GetOutputNames();
+        SizeT column_count = output_columns->size();
+        for (SizeT idx = 0; idx < column_count - 1; ++idx) {
+            output_columns_str += output_columns->at(idx) + ", ";
+        }
+        output_columns_str += output_columns->back() + "]";
+        result->emplace_back(MakeShared<String>(output_columns_str));
+    }
 }
 
 void ExplainPhysicalPlan::Explain(const PhysicalMergeKnn *merge_knn_node,
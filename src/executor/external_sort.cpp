@@ -0,0 +1,573 @@
+// Copyright(C) 2024 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+module;
+
+#include <functional>
+#include <string_view>
+#include <type_traits>
+
+module external_sort;
+
+import stl;
+import logical_type;
+import column_vector;
+import vector_buffer;
+import data_block;
+import data_type;
+import internal_types;
+import base_expression;
+import expression_type;
+import expression_state;
+import expression_evaluator;
+import select_statement;
+import buffer_manager;
+import buffer_obj;
+import buffer_handle;
+import raw_file_worker;
+import loser_tree;
+import status;
+import infinity_exception;
+import third_party;
+
+namespace infinity {
+
+namespace {
+
+template <typename U>
+inline void StoreBigEndian(U value, char *dst) {
+    for (SizeT i = 0; i < sizeof(U); ++i) {
+        dst[i] = static_cast<char>(value >> ((sizeof(U) - 1 - i) * 8));
+    }
+}
+
+template <typename I>
+inline std::make_unsigned_t<I> FlipSign(I value) {
+    using U = std::make_unsigned_t<I>;
+    return static_cast<U>(value) ^ (U(1) << (sizeof(U) * 8 - 1));
+}
+
+// Negative floats have all bits inverted and positive ones have the sign bit set, -0.0 is folded into 0.0.
+inline u32 OrderedBits(float value) {
+    if (value == 0.0f) {
+        value = 0.0f;
+    }
+    u32 bits = std::bit_cast<u32>(value);
+    return (bits & 0x80000000u) ? ~bits : bits | 0x80000000u;
+}
+
+inline u64 OrderedBits(double value) {
+    if (value == 0.0) {
+        value = 0.0;
+    }
+    u64 bits = std::bit_cast<u64>(value);
+    return (bits & 0x8000000000000000ull) ? ~bits : bits | 0x8000000000000000ull;
+}
+
+inline void EncodeValue(TinyIntT value, char *dst) { StoreBigEndian(FlipSign(value), dst); }
+inline void EncodeValue(SmallIntT value, char *dst) { StoreBigEndian(FlipSign(value), dst); }
+inline void EncodeValue(IntegerT value, char *dst) { StoreBigEndian(FlipSign(value), dst); }
+inline void EncodeValue(BigIntT value, char *dst) { StoreBigEndian(FlipSign(value), dst); }
+inline void EncodeValue(const HugeIntT &value, char *dst) {
+    StoreBigEndian(FlipSign(value.upper), dst);
+    StoreBigEndian(static_cast<u64>(value.lower), dst + sizeof(u64));
+}
+inline void EncodeValue(const Float16T &value, char *dst) { StoreBigEndian(OrderedBits(static_cast<float>(value)), dst); }
+inline void EncodeValue(const BFloat16T &value, char *dst) { StoreBigEndian(OrderedBits(static_cast<float>(value)), dst); }
+inline void EncodeValue(FloatT value, char *dst) { StoreBigEndian(OrderedBits(value), dst); }
+inline void EncodeValue(DoubleT value, char *dst) { StoreBigEndian(OrderedBits(value), dst); }
+inline void EncodeValue(const DateT &value, char *dst) { StoreBigEndian(FlipSign(value.value), dst); }
+inline void EncodeValue(const TimeT &value, char *dst) { StoreBigEndian(FlipSign(value.value), dst); }
+inline void EncodeValue(const DateTimeT &value, char *dst) {
+    StoreBigEndian(FlipSign(value.date.value), dst);
+    StoreBigEndian(FlipSign(value.time.value), dst + sizeof(i32));
+}
+inline void EncodeValue(const RowID &value, char *dst) {
+    StoreBigEndian(value.segment_id_, dst);
+    StoreBigEndian(value.segment_offset_, dst + sizeof(u32));
+}
+
+// Width of the encoded value, 0 for varchar.
+SizeT EncodedWidth(LogicalType type) {
+    switch (type) {
+        case LogicalType::kBoolean:
+        case LogicalType::kTinyInt:
+            return 1;
+        case LogicalType::kSmallInt:
+            return 2;
+        case LogicalType::kInteger:
+        case LogicalType::kFloat16:
+        case LogicalType::kBFloat16:
+        case LogicalType::kFloat:
+        case LogicalType::kDate:
+        case LogicalType::kTime:
+            return 4;
+        case LogicalType::kBigInt:
+        case LogicalType::kDouble:
+        case LogicalType::kDateTime:
+        case LogicalType::kTimestamp:
+        case LogicalType::kRowID:
+            return 8;
+        case LogicalType::kHugeInt:
+            return 16;
+        default:
+            return 0;
+    }
+}
+
+inline SizeT EscapedSize(Span<const char> text) {
+    SizeT size = text.size() + 2;
+    for (char c : text) {
+        size += (c == '\0');
+    }
+    return size;
+}
+
+inline char *EncodeVarchar(Span<const char> text, char *dst) {
+    for (char c : text) {
+        *dst++ = c;
+        if (c == '\0') {
+            *dst++ = '\1';
+        }
+    }
+    *dst++ = '\0';
+    *dst++ = '\0';
+    return dst;
+}
+
+template <typename T>
+void EncodeFixedColumn(const ColumnVector &column, SizeT row_count, bool all_valid, char *data, Vector<SizeT> &cursors) {
+    const bool is_constant = column.vector_type() == ColumnVectorType::kConstant;
+    const SizeT width = EncodedWidth(column.data_type()->type());
+    const auto *values = reinterpret_cast<const T *>(column.data());
+    for (SizeT row_id = 0; row_id < row_count; ++row_id) {
+        SizeT value_row = is_constant ? 0 : row_id;
+        char *dst = data + cursors[row_id];
+        if (!all_valid && !column.nulls_ptr_->IsTrue(value_row)) {
+            *dst = 0;
+            cursors[row_id] += 1;
+            continue;
+        }
+        *dst = 1;
+        EncodeValue(values[value_row], dst + 1);
+        cursors[row_id] += 1 + width;
+    }
+}
+
+// Buffer the consecutive rows of the same input block, and copy them to the output at once.
+class SortedOutput {
+public:
+    explicit SortedOutput(Vector<UniquePtr<DataBlock>> &output_blocks) : output_blocks_(output_blocks) {}
+
+    void Append(const DataBlock *block, SizeT row_id) {
+        if (block == pending_block_ && row_id == pending_begin_ + pending_count_) {
+            ++pending_count_;
+            return;
+        }
+        Flush();
+        pending_block_ = block;
+        pending_begin_ = row_id;
+        pending_count_ = 1;
+    }
+
+    // Must be called before the pending block is released.
+    void Flush() {
+        while (pending_count_ > 0) {
+            if (current_.get() == nullptr || current_->available_capacity() == 0) {
+                NewBlock(pending_block_);
+            }
+            SizeT count = std::min(pending_count_, current_->available_capacity());
+            current_->AppendWith(pending_block_, pending_begin_, count);
+            pending_begin_ += count;
+            pending_count_ -= count;
+        }
+        pending_block_ = nullptr;
+    }
+
+    void Finish() {
+        Flush();
+        if (current_.get() != nullptr) {
+            current_->Finalize();
+            output_blocks_.push_back(std::move(current_));
+        }
+    }
+
+private:
+    void NewBlock(const DataBlock *input_block) {
+        if (current_.get() != nullptr) {
+            current_->Finalize();
+            output_blocks_.push_back(std::move(current_));
+        }
+        current_ = DataBlock::MakeUniquePtr();
+        current_->Init(input_block->types());
+    }
+
+    Vector<UniquePtr<DataBlock>> &output_blocks_;
+    UniquePtr<DataBlock> current_{};
+
+    const DataBlock *pending_block_{};
+    SizeT pending_begin_{};
+    SizeT pending_count_{};
+};
+
+struct RunCursor {
+    SortedRun *run_{};
+    SizeT next_block_{};
+    SharedPtr<DataBlock> block_{};
+    SortKeys keys_{};
+    SizeT row_id_{};
+
+    // Move to the next non-empty block of the run, return false if the run is exhausted.
+    bool NextBlock(const SortKeyEncoder &encoder, Vector<SharedPtr<ExpressionState>> &expr_states) {
+        block_.reset();
+        while (next_block_ < run_->block_count()) {
+            block_ = run_->TakeBlock(next_block_++);
+            if (block_->row_count() == 0) {
+                continue;
+            }
+            keys_ = SortKeys();
+            encoder.Encode(block_.get(), expr_states, keys_);
+            row_id_ = 0;
+            return true;
+        }
+        block_.reset();
+        return false;
+    }
+};
+
+} // namespace
+
+SortKeyEncoder::SortKeyEncoder(Vector<SharedPtr<BaseExpression>> expressions, Vector<OrderType> order_types)
+    : expressions_(std::move(expressions)), order_types_(std::move(order_types)) {
+    if (expressions_.size() != order_types_.size()) {
+        String error_message = "order_by_types_.size() != expressions_.size()";
+        UnrecoverableError(error_message);
+    }
+    for (const auto &expr : expressions_) {
+        if (!SupportKeyType(expr->Type())) {
+            Status status = Status::NotSupport(fmt::format("Order by {} type isn't supported", expr->Type().ToString()));
+            RecoverableError(status);
+        }
+    }
+}
+
+bool SortKeyEncoder::SupportKeyType(const DataType &data_type) {
+    return data_type.type() == LogicalType::kVarchar || EncodedWidth(data_type.type()) != 0;
+}
+
+void SortKeyEncoder::Encode(const DataBlock *block, Vector<SharedPtr<ExpressionState>> &expr_states, SortKeys &keys) const {
+    Vector<SharedPtr<ColumnVector>> key_columns;
+    key_columns.reserve(expressions_.size());
+    ExpressionEvaluator expr_evaluator;
+    expr_evaluator.Init(block);
+    for (SizeT expr_id = 0; expr_id < expressions_.size(); ++expr_id) {
+        auto &expr = expressions_[expr_id];
+        SharedPtr<ColumnVector> result_vector;
+        if (expr->type() != ExpressionType::kReference) {
+            // need to initialize the result vector
+            result_vector = MakeShared<ColumnVector>(MakeShared<DataType>(expr->Type()));
+            result_vector->Initialize();
+        }
+        expr_evaluator.Execute(expr, expr_states[expr_id], result_vector);
+        key_columns.push_back(std::move(result_vector));
+    }
+    EncodeColumns(key_columns, order_types_, block->row_count(), keys);
+}
+
+void SortKeyEncoder::EncodeColumns(const Vector<SharedPtr<ColumnVector>> &key_columns,
+                                   const Vector<OrderType> &order_types,
+                                   SizeT row_count,
+                                   SortKeys &keys) {
+    // First pass: the size of each key, so that the keys of the block can be laid out before encoding column by column.
+    Vector<SizeT> cursors(row_count, 0);
+    for (const auto &column_ptr : key_columns) {
+        const ColumnVector &column = *column_ptr;
+        const bool is_constant = column.vector_type() == ColumnVectorType::kConstant;
+        const bool all_valid = column.nulls_ptr_->IsAllTrue();
+        if (column.data_type()->type() == LogicalType::kVarchar) {
+            for (SizeT row_id = 0; row_id < row_count; ++row_id) {
+                SizeT value_row = is_constant ? 0 : row_id;
+                if (all_valid || column.nulls_ptr_->IsTrue(value_row)) {
+                    cursors[row_id] += 1 + EscapedSize(column.GetVarchar(value_row));
+                } else {
+                    cursors[row_id] += 1;
+                }
+            }
+        } else {
+            SizeT width = EncodedWidth(column.data_type()->type());
+            for (SizeT row_id = 0; row_id < row_count; ++row_id) {
+                SizeT value_row = is_constant ? 0 : row_id;
+                cursors[row_id] += (all_valid || column.nulls_ptr_->IsTrue(value_row)) ? 1 + width : 1;
+            }
+        }
+    }
+    SizeT offset = keys.data_.size();
+    keys.offsets_.reserve(keys.offsets_.size() + row_count);
+    for (SizeT row_id = 0; row_id < row_count; ++row_id) {
+        SizeT key_size = cursors[row_id];
+        cursors[row_id] = offset;
+        offset += key_size;
+        keys.offsets_.push_back(offset);
+    }
+    keys.data_.resize(offset);
+
+    // Second pass: encode column by column.
+    char *data = keys.data_.data();
+    Vector<SizeT> column_begins;
+    for (SizeT column_id = 0; column_id < key_columns.size(); ++column_id) {
+        const ColumnVector &column = *key_columns[column_id];
+        const bool desc = order_types[column_id] == OrderType::kDesc;
+        if (desc) {
+            column_begins = cursors;
+        }
+        const bool all_valid = column.nulls_ptr_->IsAllTrue();
+        switch (column.data_type()->type()) {
+            case LogicalType::kBoolean: {
+                const bool is_constant = column.vector_type() == ColumnVectorType::kConstant;
+                for (SizeT row_id = 0; row_id < row_count; ++row_id) {
+                    SizeT value_row = is_constant ? 0 : row_id;
+                    char *dst = data + cursors[row_id];
+                    if (!all_valid && !column.nulls_ptr_->IsTrue(value_row)) {
+                        *dst = 0;
+                        cursors[row_id] += 1;
+                        continue;
+                    }
+                    dst[0] = 1;
+                    dst[1] = column.buffer_->GetCompactBit(value_row) ? 1 : 0;
+                    cursors[row_id] += 2;
+                }
+                break;
+            }
+            case LogicalType::kVarchar: {
+                const bool is_constant = column.vector_type() == ColumnVectorType::kConstant;
+                for (SizeT row_id = 0; row_id < row_count; ++row_id) {
+                    SizeT value_row = is_constant ? 0 : row_id;
+                    char *dst = data + cursors[row_id];
+                    if (!all_valid && !column.nulls_ptr_->IsTrue(value_row)) {
+                        *dst = 0;
+                        cursors[row_id] += 1;
+                        continue;
+                    }
+                    *dst = 1;
+                    char *end = EncodeVarchar(column.GetVarchar(value_row), dst + 1);
+                    cursors[row_id] = end - data;
+                }
+                break;
+            }
+            case LogicalType::kTinyInt: {
+                EncodeFixedColumn<TinyIntT>(column, row_count, all_valid, data, cursors);
+                break;
+            }
+            case LogicalType::kSmallInt: {
+                EncodeFixedColumn<SmallIntT>(column, row_count, all_valid, data, cursors);
+                break;
+            }
+            case LogicalType::kInteger: {
+                EncodeFixedColumn<IntegerT>(column, row_count, all_valid, data, cursors);
+                break;
+            }
+            case LogicalType::kBigInt: {
+                EncodeFixedColumn<BigIntT>(column, row_count, all_valid, data, cursors);
+                break;
+            }
+            case LogicalType::kHugeInt: {
+                EncodeFixedColumn<HugeIntT>(column, row_count, all_valid, data, cursors);
+                break;
+            }
+            case LogicalType::kFloat16: {
+                EncodeFixedColumn<Float16T>(column, row_count, all_valid, data, cursors);
+                break;
+            }
+            case LogicalType::kBFloat16: {
+                EncodeFixedColumn<BFloat16T>(column, row_count, all_valid, data, cursors);
+                break;
+            }
+            case LogicalType::kFloat: {
+                EncodeFixedColumn<FloatT>(column, row_count, all_valid, data, cursors);
+                break;
+            }
+            case LogicalType::kDouble: {
+                EncodeFixedColumn<DoubleT>(column, row_count, all_valid, data, cursors);
+                break;
+            }
+            case LogicalType::kDate: {
+                EncodeFixedColumn<DateT>(column, row_count, all_valid, data, cursors);
+                break;
+            }
+            case LogicalType::kTime: {
+                EncodeFixedColumn<TimeT>(column, row_count, all_valid, data, cursors);
+                break;
+            }
+            case LogicalType::kDateTime: {
+                EncodeFixedColumn<DateTimeT>(column, row_count, all_valid, data, cursors);
+                break;
+            }
+            case LogicalType::kTimestamp: {
+                EncodeFixedColumn<TimestampT>(column, row_count, all_valid, data, cursors);
+                break;
+            }
+            case LogicalType::kRowID: {
+                EncodeFixedColumn<RowID>(column, row_count, all_valid, data, cursors);
+                break;
+            }
+            default: {
+                Status status = Status::NotSupport(fmt::format("Order by {} type isn't supported", column.data_type()->ToString()));
+                RecoverableError(status);
+            }
+        }
+        if (desc) {
+            for (SizeT row_id = 0; row_id < row_count; ++row_id) {
+                for (SizeT pos = column_begins[row_id]; pos < cursors[row_id]; ++pos) {
+                    data[pos] = ~data[pos];
+                }
+            }
+        }
+    }
+}
+
+SortedRun::~SortedRun() {
+    for (auto *buffer_obj : spilled_blocks_) {
+        if (buffer_obj != nullptr) {
+            buffer_obj->PickForCleanup();
+        }
+    }
+}
+
+void SortedRun::Append(UniquePtr<DataBlock> block) {
+    blocks_.push_back(std::move(block));
+    spilled_blocks_.push_back(nullptr);
+    spilled_sizes_.push_back(0);
+}
+
+void SortedRun::Spill(BufferManager *buffer_mgr) {
+    static atomic_u64 spill_file_id{0};
+    auto file_dir = MakeShared<String>("sort");
+    for (SizeT idx = 0; idx < blocks_.size(); ++idx) {
+        if (blocks_[idx].get() == nullptr) {
+            continue;
+        }
+        SizeT block_size = blocks_[idx]->GetSizeInBytes();
+        auto file_worker = MakeUnique<RawFileWorker>(buffer_mgr->GetFullDataDir(),
+                                                     buffer_mgr->GetTempDir(),
+                                                     file_dir,
+                                                     MakeShared<String>(fmt::format("sort_run_{}", spill_file_id.fetch_add(1))),
+                                                     block_size,
+                                                     nullptr);
+        BufferObj *buffer_obj = buffer_mgr->AllocateBufferObject(std::move(file_worker));
+        buffer_obj->AddObjRc();
+        {
+            BufferHandle buffer_handle = buffer_obj->Load();
+            char *ptr = static_cast<char *>(buffer_handle.GetDataMut());
+            blocks_[idx]->WriteAdv(ptr);
+        }
+        blocks_[idx].reset();
+        spilled_blocks_[idx] = buffer_obj;
+        spilled_sizes_[idx] = block_size;
+    }
+}
+
+SharedPtr<DataBlock> SortedRun::TakeBlock(SizeT idx) {
+    if (BufferObj *buffer_obj = spilled_blocks_[idx]; buffer_obj != nullptr) {
+        SharedPtr<DataBlock> block;
+        {
+            BufferHandle buffer_handle = buffer_obj->Load();
+            const char *ptr = static_cast<const char *>(buffer_handle.GetData());
+            block = DataBlock::ReadAdv(ptr, spilled_sizes_[idx]);
+        }
+        buffer_obj->PickForCleanup();
+        spilled_blocks_[idx] = nullptr;
+        return block;
+    }
+    if (blocks_[idx].get() == nullptr) {
+        String error_message = fmt::format("Block {} of the sorted run is already taken", idx);
+        UnrecoverableError(error_message);
+    }
+    return SharedPtr<DataBlock>(std::move(blocks_[idx]));
+}
+
+void SortBlocks(const Vector<UniquePtr<DataBlock>> &input_blocks, const Vector<SortKeys> &keys, Vector<UniquePtr<DataBlock>> &output_blocks) {
+    struct SortEntry {
+        std::string_view key_;
+        u32 block_id_;
+        u32 offset_;
+    };
+    Vector<SortEntry> entries;
+    SizeT row_count = 0;
+    for (const auto &block : input_blocks) {
+        row_count += block->row_count();
+    }
+    entries.reserve(row_count);
+    for (u32 block_id = 0; block_id < input_blocks.size(); ++block_id) {
+        for (u32 offset = 0; offset < input_blocks[block_id]->row_count(); ++offset) {
+            entries.push_back(SortEntry{keys[block_id].Get(offset), block_id, offset});
+        }
+    }
+    std::sort(entries.begin(), entries.end(), [](const SortEntry &left, const SortEntry &right) { return left.key_ < right.key_; });
+
+    SortedOutput output(output_blocks);
+    for (const auto &entry : entries) {
+        output.Append(input_blocks[entry.block_id_].get(), entry.offset_);
+    }
+    output.Finish();
+}
+
+void MergeSortedRuns(Vector<UniquePtr<SortedRun>> &runs,
+                     const SortKeyEncoder &encoder,
+                     Vector<SharedPtr<ExpressionState>> &expr_states,
+                     Vector<UniquePtr<DataBlock>> &output_blocks) {
+    if (runs.empty()) {
+        return;
+    }
+    using MergeTree = LoserTree<std::string_view, std::less<std::string_view>>;
+    SizeT run_count = runs.size();
+    Vector<RunCursor> cursors(run_count);
+    MergeTree merge_tree(run_count);
+    SizeT active_run_count = 0;
+    for (SizeT run_id = 0; run_id < run_count; ++run_id) {
+        auto &cursor = cursors[run_id];
+        cursor.run_ = runs[run_id].get();
+        if (cursor.NextBlock(encoder, expr_states)) {
+            std::string_view key = cursor.keys_.Get(0);
+            merge_tree.InsertStart(&key, static_cast<MergeTree::Source>(run_id), false);
+            ++active_run_count;
+        } else {
+            merge_tree.InsertStart(nullptr, static_cast<MergeTree::Source>(run_id), true);
+        }
+    }
+    merge_tree.Init();
+
+    SortedOutput output(output_blocks);
+    while (active_run_count > 0) {
+        auto &cursor = cursors[merge_tree.TopSource()];
+        output.Append(cursor.block_.get(), cursor.row_id_);
+        if (++cursor.row_id_ < cursor.block_->row_count()) {
+            std::string_view key = cursor.keys_.Get(cursor.row_id_);
+            merge_tree.DeleteTopInsert(&key, false);
+            continue;
+        }
+        // The key of the top is replaced below, so the keys of the finished block are no longer referenced by the tree.
+        output.Flush();
+        if (cursor.NextBlock(encoder, expr_states)) {
+            std::string_view key = cursor.keys_.Get(0);
+            merge_tree.DeleteTopInsert(&key, false);
+        } else {
+            merge_tree.DeleteTopInsert(nullptr, true);
+            --active_run_count;
+        }
+    }
+    output.Finish();
+    runs.clear();
+}
+
+} // namespace infinity
@@ -0,0 +1,105 @@
+// Copyright(C) 2024 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+module;
+
+export module external_sort;
+
+import stl;
+import column_vector;
+import data_block;
+import data_type;
+import internal_types;
+import base_expression;
+import expression_state;
+import select_statement;
+import buffer_manager;
+import buffer_obj;
+
+namespace infinity {
+
+// Normalized sort keys of consecutive rows, stored back to back in one buffer.
+export struct SortKeys {
+    Vector<char> data_{};
+    Vector<SizeT> offsets_{0};
+
+    inline SizeT size() const { return offsets_.size() - 1; }
+
+    inline std::string_view Get(SizeT idx) const { return std::string_view(data_.data() + offsets_[idx], offsets_[idx + 1] - offsets_[idx]); }
+
+    inline SizeT SizeInBytes() const { return data_.size() + offsets_.size() * sizeof(SizeT); }
+};
+
+// Encode the sort expressions of a row to a byte string, so that rows compare by memcmp of their keys:
+//  - every key column starts with a validity byte, NULL is smaller than any value.
+//  - integers are stored big-endian with the sign bit flipped, floats are mapped to the order of their integer bits.
+//  - varchar is escaped ('\0' -> "\0\1") and terminated with "\0\0", so a prefix sorts before the longer string.
+//  - all bytes of a DESC column are inverted.
+export class SortKeyEncoder {
+public:
+    SortKeyEncoder() = default;
+
+    SortKeyEncoder(Vector<SharedPtr<BaseExpression>> expressions, Vector<OrderType> order_types);
+
+    static bool SupportKeyType(const DataType &data_type);
+
+    // Evaluate the sort expressions on the block and append the key of each row to `keys`.
+    void Encode(const DataBlock *block, Vector<SharedPtr<ExpressionState>> &expr_states, SortKeys &keys) const;
+
+    // Append the key of each row of already evaluated key columns to `keys`.
+    static void EncodeColumns(const Vector<SharedPtr<ColumnVector>> &key_columns, const Vector<OrderType> &order_types, SizeT row_count, SortKeys &keys);
+
+private:
+    Vector<SharedPtr<BaseExpression>> expressions_{};
+    Vector<OrderType> order_types_{};
+};
+
+// A sequence of sorted blocks. Spill() hands the blocks over to the buffer manager as ephemeral buffer objects,
+// which are written to the temp dir when the buffer manager runs out of memory, and read back one at a time by TakeBlock().
+export class SortedRun {
+public:
+    SortedRun() = default;
+
+    ~SortedRun();
+
+    SortedRun(const SortedRun &) = delete;
+
+    SortedRun &operator=(const SortedRun &) = delete;
+
+    void Append(UniquePtr<DataBlock> block);
+
+    void Spill(BufferManager *buffer_mgr);
+
+    // Take the ownership of the idx-th block. Each block can be taken only once.
+    SharedPtr<DataBlock> TakeBlock(SizeT idx);
+
+    inline SizeT block_count() const { return blocks_.size(); }
+
+private:
+    Vector<UniquePtr<DataBlock>> blocks_{};
+    // Aligned with blocks_, nullptr if the block is still in memory.
+    Vector<BufferObj *> spilled_blocks_{};
+    Vector<SizeT> spilled_sizes_{};
+};
+
+// Sort the rows of the blocks by their keys, keys[i] must be the keys of input_blocks[i].
+export void SortBlocks(const Vector<UniquePtr<DataBlock>> &input_blocks, const Vector<SortKeys> &keys, Vector<UniquePtr<DataBlock>> &output_blocks);
+
+// K-way merge the sorted runs with a loser tree over the normalized keys. Only one block of each run is kept in memory.
+export void MergeSortedRuns(Vector<UniquePtr<SortedRun>> &runs,
+                            const SortKeyEncoder &encoder,
+                            Vector<SharedPtr<ExpressionState>> &expr_states,
+                            Vector<UniquePtr<DataBlock>> &output_blocks);
+
+} // namespace infinity
@@ -27,6 +27,7 @@ import physical_source;
 import physical_explain;
 import physical_knn_scan;
 import physical_fusion;
+import physical_hash_join;
 import status;
 import infinity_exception;
 
@@ -100,6 +101,13 @@ void FragmentBuilder::BuildExplain(PhysicalOperator *phys_op, PlanFragment *curr
     }
 }
 
+bool FragmentBuilder::HasSerialSource(PlanFragment *fragment_ptr) {
+    // The first operator of the fragment is the last one added. A join consumes its inputs from queues in a single task,
+    // the operators above it in the same fragment must not turn the fragment into a parallel one.
+    auto &operators = fragment_ptr->GetOperators();
+    return !operators.empty() && operators.back()->operator_type() == PhysicalOperatorType::kJoinHash;
+}
+
 void FragmentBuilder::BuildFragments(PhysicalOperator *phys_op, PlanFragment *current_fragment_ptr) {
     switch (phys_op->operator_type()) {
         case PhysicalOperatorType::kInvalid: {
@@ -146,7 +154,9 @@ void FragmentBuilder::BuildFragments(PhysicalOperator *phys_op, PlanFragment *cu
                 UnrecoverableError(error_message);
             } else {
                 BuildFragments(phys_op->left(), current_fragment_ptr);
-                current_fragment_ptr->SetFragmentType(FragmentType::kParallelMaterialize);
+                if (!HasSerialSource(current_fragment_ptr)) {
+                    current_fragment_ptr->SetFragmentType(FragmentType::kParallelMaterialize);
+                }
             }
             return;
         }
@@ -172,12 +182,28 @@ void FragmentBuilder::BuildFragments(PhysicalOperator *phys_op, PlanFragment *cu
             }
             current_fragment_ptr->AddOperator(phys_op);
             BuildFragments(phys_op->left(), current_fragment_ptr);
-            current_fragment_ptr->SetFragmentType(FragmentType::kParallelMaterialize);
+            if (!HasSerialSource(current_fragment_ptr)) {
+                current_fragment_ptr->SetFragmentType(FragmentType::kParallelMaterialize);
+            }
             break;
         }
-        case PhysicalOperatorType::kUpdate:
-        case PhysicalOperatorType::kDelete:
         case PhysicalOperatorType::kSort: {
+            if (phys_op->left() == nullptr) {
+                String error_message = fmt::format("No input node of {}", phys_op->GetName());
+                UnrecoverableError(error_message);
+            }
+            current_fragment_ptr->AddOperator(phys_op);
+            BuildFragments(phys_op->left(), current_fragment_ptr);
+            // Each task sorts its own input, the sorted runs are merged by the MergeSort above.
+            if (phys_op->TaskletCount() > 1 && !HasSerialSource(current_fragment_ptr)) {
+                current_fragment_ptr->SetFragmentType(FragmentType::kParallelMaterialize);
+            } else {
+                current_fragment_ptr->SetFragmentType(FragmentType::kSerialMaterialize);
+            }
+            break;
+        }
+        case PhysicalOperatorType::kUpdate:
+        case PhysicalOperatorType::kDelete: {
             if (phys_op->left() == nullptr) {
                 String error_message = fmt::format("No input node of {}", phys_op->GetName());
                 UnrecoverableError(error_message);
@@ -250,11 +276,58 @@ void FragmentBuilder::BuildFragments(PhysicalOperator *phys_op, PlanFragment *cu
             }
             return;
         }
+        case PhysicalOperatorType::kMergeParallelAggregate: {
+            if (phys_op->left() == nullptr) {
+                String error_message = fmt::format("No input node of {}", phys_op->GetName());
+                UnrecoverableError(error_message);
+            }
+            // Each task of this fragment merges its own radix partitions of the partial aggregate.
+            current_fragment_ptr->AddOperator(phys_op);
+            current_fragment_ptr->SetSourceNode(query_context_ptr_, SourceType::kLocalQueue, phys_op->GetOutputNames(), phys_op->GetOutputTypes());
+            current_fragment_ptr->SetFragmentType(FragmentType::kParallelMaterialize);
+
+            auto next_plan_fragment = MakeUnique<PlanFragment>(GetFragmentId());
+            next_plan_fragment->SetSinkNode(query_context_ptr_,
+                                            SinkType::kLocalQueue,
+                                            phys_op->left()->GetOutputNames(),
+                                            phys_op->left()->GetOutputTypes());
+            BuildFragments(phys_op->left(), next_plan_fragment.get());
+            current_fragment_ptr->AddChild(std::move(next_plan_fragment));
+            return;
+        }
+        case PhysicalOperatorType::kJoinHash: {
+            if (phys_op->left() == nullptr || phys_op->right() == nullptr) {
+                String error_message = fmt::format("Invalid input node of {}", phys_op->GetName());
+                UnrecoverableError(error_message);
+            }
+            // Probe and build side are produced by their own parallel fragments, the join itself runs in a serial fragment.
+            // Its hash table is partitioned while the build side arrives and the partitions are chained in parallel tasks.
+            current_fragment_ptr->AddOperator(phys_op);
+            current_fragment_ptr->SetSourceNode(query_context_ptr_, SourceType::kLocalQueue, phys_op->GetOutputNames(), phys_op->GetOutputTypes());
+            current_fragment_ptr->SetFragmentType(FragmentType::kSerialMaterialize);
+
+            auto probe_plan_fragment = MakeUnique<PlanFragment>(GetFragmentId());
+            probe_plan_fragment->SetSinkNode(query_context_ptr_,
+                                             SinkType::kLocalQueue,
+                                             phys_op->left()->GetOutputNames(),
+                                             phys_op->left()->GetOutputTypes());
+            BuildFragments(phys_op->left(), probe_plan_fragment.get());
+            current_fragment_ptr->AddChild(std::move(probe_plan_fragment));
+
+            auto build_plan_fragment = MakeUnique<PlanFragment>(GetFragmentId());
+            static_cast<PhysicalHashJoin *>(phys_op)->SetBuildFragmentId(build_plan_fragment->FragmentID());
+            build_plan_fragment->SetSinkNode(query_context_ptr_,
+                                             SinkType::kLocalQueue,
+                                             phys_op->right()->GetOutputNames(),
+                                             phys_op->right()->GetOutputTypes());
+            BuildFragments(phys_op->right(), build_plan_fragment.get());
+            current_fragment_ptr->AddChild(std::move(build_plan_fragment));
+            return;
+        }
         case PhysicalOperatorType::kUnionAll:
         case PhysicalOperatorType::kIntersect:
         case PhysicalOperatorType::kExcept:
         case PhysicalOperatorType::kDummyScan:
-        case PhysicalOperatorType::kJoinHash:
         case PhysicalOperatorType::kJoinNestedLoop:
         case PhysicalOperatorType::kJoinMerge:
         case PhysicalOperatorType::kJoinIndex:
@@ -45,6 +45,8 @@ private:
 
     void BuildExplain(PhysicalOperator *phys_op, PlanFragment *current_fragment_ptr);
 
+    static bool HasSerialSource(PlanFragment *fragment_ptr);
+
     idx_t GetFragmentId() { return fragment_id_++; }
 
 private:
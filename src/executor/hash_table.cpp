@@ -18,21 +18,94 @@ module;
 import stl;
 import logical_type;
 import column_vector;
+import vector_buffer;
 import status;
 import infinity_exception;
 import third_party;
 import internal_types;
+import data_type;
 
 module hash_table;
 
 namespace infinity {
 
+u64 HashBytes(const char *data, SizeT length) {
+    u64 hash = MixHash(length);
+    SizeT offset = 0;
+    for (; offset + sizeof(u64) <= length; offset += sizeof(u64)) {
+        u64 word;
+        std::memcpy(&word, data + offset, sizeof(u64));
+        hash = CombineHash(hash, MixHash(word));
+    }
+    if (offset < length) {
+        u64 word = 0;
+        std::memcpy(&word, data + offset, length - offset);
+        hash = CombineHash(hash, MixHash(word));
+    }
+    return hash;
+}
 
-void HashTableBase::Init(Vector<SharedPtr<DataType>> types) {
+namespace {
+
+template <SizeT KeyWidth>
+inline u64 HashFixedKey(const char *key, SizeT key_width) {
+    if constexpr (KeyWidth == sizeof(u64)) {
+        u64 word;
+        std::memcpy(&word, key, sizeof(u64));
+        return MixHash(word);
+    } else if constexpr (KeyWidth == 2 * sizeof(u64)) {
+        u64 words[2];
+        std::memcpy(words, key, sizeof(words));
+        return CombineHash(MixHash(words[0]), MixHash(words[1]));
+    } else {
+        return HashBytes(key, key_width);
+    }
+}
+
+template <SizeT KeyWidth>
+inline bool FixedKeyEqual(const char *left, const char *right, SizeT key_width) {
+    if constexpr (KeyWidth == sizeof(u64) || KeyWidth == 2 * sizeof(u64)) {
+        return std::memcmp(left, right, KeyWidth) == 0;
+    } else {
+        return std::memcmp(left, right, key_width) == 0;
+    }
+}
+
+// +0.0 and -0.0 belong to the same group.
+template <typename T>
+inline void NormalizeZero(char *value) {
+    T v;
+    std::memcpy(&v, value, sizeof(T));
+    if (v == 0) {
+        v = 0;
+        std::memcpy(value, &v, sizeof(T));
+    }
+}
+
+inline bool IsValid(const ColumnVector &column, SizeT row_id) {
+    return column.nulls_ptr_->IsAllTrue() || column.nulls_ptr_->IsTrue(column.vector_type() == ColumnVectorType::kConstant ? 0 : row_id);
+}
+
+void AppendNullValue(ColumnVector &column) {
+    if (column.data_type()->type() == LogicalType::kVarchar) {
+        column.AppendVarchar(Span<const char>());
+    } else {
+        Vector<char> zero_value(column.data_type()->Size(), 0);
+        column.AppendByPtr(zero_value.data());
+    }
+    column.nulls_ptr_->SetFalse(column.Size() - 1);
+}
+
+} // namespace
+
+void GroupByHashTable::Init(Vector<SharedPtr<DataType>> types, SizeT payload_size) {
     types_ = std::move(types);
-    SizeT key_size = 0;
-    SizeT type_count = types_.size();
-    for (SizeT idx = 0; idx < type_count; ++idx) {
+    SizeT column_count = types_.size();
+    value_offsets_.clear();
+    SizeT key_width = column_count;
+    // Every column is checked before the layout is chosen, a varchar column switches the whole key to the varlen layout.
+    bool varlen = false;
+    for (SizeT idx = 0; idx < column_count; ++idx) {
         const DataType &data_type = *types_[idx];
         switch (data_type.type()) {
             case LogicalType::kBoolean:
@@ -46,97 +119,295 @@ void HashTableBase::Init(Vector<SharedPtr<DataType>> types) {
             case LogicalType::kTime:
             case LogicalType::kDateTime:
             case LogicalType::kTimestamp: {
-                SizeT type_size = data_type.Size();
-                key_size += type_size;
-                break; // All these type can be hashed.
+                value_offsets_.push_back(key_width);
+                key_width += data_type.type() == LogicalType::kBoolean ? sizeof(BooleanT) : data_type.Size();
+                break;
             }
             case LogicalType::kVarchar: {
-                key_size = 0;
-                break; // Varchar can be hashed.
+                value_offsets_.push_back(0);
+                varlen = true;
+                break;
             }
             default: {
                 RecoverableError(Status::NotSupport(fmt::format("Attempt to construct hash key for type: {}", data_type.ToString())));
             }
         }
-        if (key_size == 0) {
-            break;
-        }
     }
 
-    if (key_size) {
-        // Key layout: col1\0col2\0col3\0.
-        key_size += type_count;
+    if (!varlen) {
+        // Pad to whole words, so the common layouts are compared and hashed as one or two u64.
+        key_width_ = (key_width + sizeof(u64) - 1) / sizeof(u64) * sizeof(u64);
+    } else {
+        key_width_ = 0;
+        value_offsets_.clear();
+    }
+    payload_size_ = payload_size;
+    payload_offset_ = key_width_;
+    row_width_ = (payload_offset_ + payload_size_ + sizeof(u64) - 1) / sizeof(u64) * sizeof(u64);
+    if (row_width_ == 0) {
+        row_width_ = sizeof(u64);
+    }
+
+    slots_.assign(1024, Slot());
+    slot_mask_ = slots_.size() - 1;
+    group_count_ = 0;
+    group_pages_.clear();
+    group_hashes_.clear();
+    varlen_keys_.clear();
+}
+
+void GroupByHashTable::FindOrCreateGroups(const Vector<SharedPtr<ColumnVector>> &columns, SizeT row_count, Vector<u32> &group_ids) {
+    if (columns.size() != types_.size()) {
+        String error_message = fmt::format("Group by key column count mismatch: {} vs {}", columns.size(), types_.size());
+        UnrecoverableError(error_message);
+    }
+    group_ids.resize(row_count);
+    if (key_width_ == 0) {
+        EncodeVarlenKeys(columns, row_count);
+        FindOrCreateVarlenGroups(row_count, group_ids);
+        return;
+    }
+    EncodeFixedKeys(columns, row_count);
+    switch (key_width_) {
+        case sizeof(u64): {
+            FindOrCreateFixedGroups<sizeof(u64)>(row_count, group_ids);
+            break;
+        }
+        case 2 * sizeof(u64): {
+            FindOrCreateFixedGroups<2 * sizeof(u64)>(row_count, group_ids);
+            break;
+        }
+        default: {
+            FindOrCreateFixedGroups<0>(row_count, group_ids);
+            break;
+        }
     }
-    key_size_ = key_size;
 }
 
-void HashTableBase::GetHashKey(const Vector<SharedPtr<ColumnVector>> &columns, SizeT row_id, String &hash_key) const {
+void GroupByHashTable::EncodeFixedKeys(const Vector<SharedPtr<ColumnVector>> &columns, SizeT row_count) {
+    key_buffer_.assign(row_count * key_width_, 0);
+    char *keys = key_buffer_.data();
     SizeT column_count = columns.size();
-    hash_key.clear();
-    bool has_null = false;
     for (SizeT column_id = 0; column_id < column_count; ++column_id) {
-        if (!columns[column_id]->nulls_ptr_->IsTrue(row_id)) {
-            hash_key += "\0\0";
-            has_null = true;
+        const ColumnVector &column = *columns[column_id];
+        LogicalType type = types_[column_id]->type();
+        bool is_constant = column.vector_type() == ColumnVectorType::kConstant;
+        SizeT value_offset = value_offsets_[column_id];
+        if (type == LogicalType::kBoolean) {
+            for (SizeT row_id = 0; row_id < row_count; ++row_id) {
+                char *key = keys + row_id * key_width_;
+                if (!IsValid(column, row_id)) {
+                    continue;
+                }
+                key[column_id] = 1;
+                key[value_offset] = column.buffer_->GetCompactBit(is_constant ? 0 : row_id);
+            }
             continue;
         }
-
-        const DataType &data_type = *types_[column_id];
-
-        if (data_type.type() == LogicalType::kVarchar) {
-            Span<const char> text = columns[column_id]->GetVarchar(row_id);
-            hash_key.append(text.begin(), text.end());
-        } else {
-            SizeT type_size = types_[column_id]->Size();
-            Span<const char> binary(reinterpret_cast<const char *>(columns[column_id]->data() + type_size * row_id), type_size);
-            hash_key.append(binary.begin(), binary.end());
+        SizeT type_size = types_[column_id]->Size();
+        const char *data = reinterpret_cast<const char *>(column.data());
+        for (SizeT row_id = 0; row_id < row_count; ++row_id) {
+            char *key = keys + row_id * key_width_;
+            if (!IsValid(column, row_id)) {
+                continue;
+            }
+            key[column_id] = 1;
+            std::memcpy(key + value_offset, data + (is_constant ? 0 : row_id) * type_size, type_size);
+            if (type == LogicalType::kFloat) {
+                NormalizeZero<FloatT>(key + value_offset);
+            } else if (type == LogicalType::kDouble) {
+                NormalizeZero<DoubleT>(key + value_offset);
+            }
         }
-        hash_key += '\0';
     }
-    if (!has_null && key_size_ && hash_key.size() != key_size_) {
-        UnrecoverableError(fmt::format("Hash key size mismatch: {} vs {}", hash_key.size(), key_size_));
+}
+
+void GroupByHashTable::EncodeVarlenKeys(const Vector<SharedPtr<ColumnVector>> &columns, SizeT row_count) {
+    // Key layout of each column: validity byte, then the value. Varchar value is prefixed by its length.
+    varlen_key_buffer_.resize(row_count);
+    SizeT column_count = columns.size();
+    for (SizeT row_id = 0; row_id < row_count; ++row_id) {
+        String &key = varlen_key_buffer_[row_id];
+        key.clear();
+        for (SizeT column_id = 0; column_id < column_count; ++column_id) {
+            const ColumnVector &column = *columns[column_id];
+            if (!IsValid(column, row_id)) {
+                key += '\0';
+                continue;
+            }
+            key += '\1';
+            SizeT value_row = column.vector_type() == ColumnVectorType::kConstant ? 0 : row_id;
+            switch (types_[column_id]->type()) {
+                case LogicalType::kBoolean: {
+                    key += static_cast<char>(column.buffer_->GetCompactBit(value_row));
+                    break;
+                }
+                case LogicalType::kVarchar: {
+                    Span<const char> text = column.GetVarchar(value_row);
+                    u32 length = text.size();
+                    key.append(reinterpret_cast<const char *>(&length), sizeof(length));
+                    key.append(text.begin(), text.end());
+                    break;
+                }
+                default: {
+                    SizeT type_size = types_[column_id]->Size();
+                    SizeT value_offset = key.size();
+                    key.append(reinterpret_cast<const char *>(column.data()) + value_row * type_size, type_size);
+                    if (types_[column_id]->type() == LogicalType::kFloat) {
+                        NormalizeZero<FloatT>(key.data() + value_offset);
+                    } else if (types_[column_id]->type() == LogicalType::kDouble) {
+                        NormalizeZero<DoubleT>(key.data() + value_offset);
+                    }
+                    break;
+                }
+            }
+        }
     }
 }
 
-void HashTable::Append(const Vector<SharedPtr<ColumnVector>> &columns, SizeT block_id, SizeT row_count) {
-    String hash_key;
-    if (key_size_) {
-        hash_key.reserve(key_size_);
+template <SizeT KeyWidth>
+void GroupByHashTable::FindOrCreateFixedGroups(SizeT row_count, Vector<u32> &group_ids) {
+    const char *keys = key_buffer_.data();
+    for (SizeT row_id = 0; row_id < row_count; ++row_id) {
+        if ((group_count_ + 1) * 2 > slots_.size()) {
+            Grow();
+        }
+        const char *key = keys + row_id * key_width_;
+        u64 hash = HashFixedKey<KeyWidth>(key, key_width_);
+        for (u64 slot_id = hash & slot_mask_;; slot_id = (slot_id + 1) & slot_mask_) {
+            Slot &slot = slots_[slot_id];
+            if (slot.group_id_ == kInvalidGroup) {
+                u32 group_id = CreateGroup(hash);
+                std::memcpy(GroupRow(group_id), key, key_width_);
+                slot.hash_ = hash;
+                slot.group_id_ = group_id;
+                group_ids[row_id] = group_id;
+                break;
+            }
+            if (slot.hash_ == hash && FixedKeyEqual<KeyWidth>(GroupRow(slot.group_id_), key, key_width_)) {
+                group_ids[row_id] = slot.group_id_;
+                break;
+            }
+        }
     }
+}
+
+void GroupByHashTable::FindOrCreateVarlenGroups(SizeT row_count, Vector<u32> &group_ids) {
     for (SizeT row_id = 0; row_id < row_count; ++row_id) {
-        GetHashKey(columns, row_id, hash_key);
-        hash_table_[std::move(hash_key)][block_id].emplace_back(row_id);
+        if ((group_count_ + 1) * 2 > slots_.size()) {
+            Grow();
+        }
+        String &key = varlen_key_buffer_[row_id];
+        u64 hash = HashBytes(key.data(), key.size());
+        for (u64 slot_id = hash & slot_mask_;; slot_id = (slot_id + 1) & slot_mask_) {
+            Slot &slot = slots_[slot_id];
+            if (slot.group_id_ == kInvalidGroup) {
+                u32 group_id = CreateGroup(hash);
+                varlen_keys_.emplace_back(std::move(key));
+                slot.hash_ = hash;
+                slot.group_id_ = group_id;
+                group_ids[row_id] = group_id;
+                break;
+            }
+            if (slot.hash_ == hash && varlen_keys_[slot.group_id_] == key) {
+                group_ids[row_id] = slot.group_id_;
+                break;
+            }
+        }
     }
 }
 
-void MergeHashTable::Append(const Vector<SharedPtr<ColumnVector>> &columns, SizeT block_id, SizeT row_count) {
-    String hash_key;
-    if (key_size_) {
-        hash_key.reserve(key_size_);
+u32 GroupByHashTable::CreateGroup(u64 hash) {
+    if (group_count_ == kInvalidGroup) {
+        String error_message = "Too many groups in group by hash table";
+        UnrecoverableError(error_message);
     }
-    for (SizeT row_id = 0; row_id < row_count; ++row_id) {
-        GetHashKey(columns, row_id, hash_key);
-        if (auto iter = hash_table_.find(hash_key); iter != hash_table_.end()) {
-            UnrecoverableError("Duplicate key in merge hash table");
-        } else {
-            hash_table_.emplace_hint(iter, std::move(hash_key), Pair<SizeT, SizeT>(block_id, row_id));
+    if (group_count_ % kGroupsPerPage == 0) {
+        // Zero initialized
+        group_pages_.emplace_back(MakeUnique<char[]>(kGroupsPerPage * row_width_));
+    }
+    group_hashes_.push_back(hash);
+    return group_count_++;
+}
+
+void GroupByHashTable::Grow() {
+    Vector<Slot> old_slots = std::move(slots_);
+    slots_.assign(old_slots.size() * 2, Slot());
+    slot_mask_ = slots_.size() - 1;
+    for (const Slot &old_slot : old_slots) {
+        if (old_slot.group_id_ == kInvalidGroup) {
+            continue;
+        }
+        u64 slot_id = old_slot.hash_ & slot_mask_;
+        while (slots_[slot_id].group_id_ != kInvalidGroup) {
+            slot_id = (slot_id + 1) & slot_mask_;
         }
+        slots_[slot_id] = old_slot;
+    }
+}
+
+void GroupByHashTable::AppendKeys(const Vector<SharedPtr<ColumnVector>> &columns, u32 group_begin, u32 group_end) const {
+    for (u32 group_id = group_begin; group_id < group_end; ++group_id) {
+        AppendKey(columns, group_id);
     }
 }
 
-bool MergeHashTable::GetOrInsert(const Vector<SharedPtr<ColumnVector>> &columns, SizeT row_id, Pair<SizeT, SizeT> &block_row_id) {
-    String hash_key;
-    if (key_size_) {
-        hash_key.reserve(key_size_);
+void GroupByHashTable::AppendKeys(const Vector<SharedPtr<ColumnVector>> &columns, const u32 *group_ids, SizeT count) const {
+    for (SizeT idx = 0; idx < count; ++idx) {
+        AppendKey(columns, group_ids[idx]);
+    }
+}
+
+void GroupByHashTable::AppendKey(const Vector<SharedPtr<ColumnVector>> &columns, u32 group_id) const {
+    SizeT column_count = types_.size();
+    if (key_width_ != 0) {
+        const char *key = GroupRow(group_id);
+        for (SizeT column_id = 0; column_id < column_count; ++column_id) {
+            if (key[column_id] == 0) {
+                AppendNullValue(*columns[column_id]);
+                continue;
+            }
+            // Values are packed without alignment, copy out before appending.
+            u64 value[2];
+            SizeT value_size = types_[column_id]->type() == LogicalType::kBoolean ? sizeof(BooleanT) : types_[column_id]->Size();
+            std::memcpy(value, key + value_offsets_[column_id], value_size);
+            columns[column_id]->AppendByPtr(reinterpret_cast<const_ptr_t>(value));
+        }
+        return;
     }
-    GetHashKey(columns, row_id, hash_key);
-    auto iter = hash_table_.find(hash_key);
-    if (iter == hash_table_.end()) {
-        hash_table_.emplace_hint(iter, std::move(hash_key), block_row_id);
-        return false;
+
+    const String &key = varlen_keys_[group_id];
+    SizeT offset = 0;
+    for (SizeT column_id = 0; column_id < column_count; ++column_id) {
+        ColumnVector &column = *columns[column_id];
+        if (key[offset++] == 0) {
+            AppendNullValue(column);
+            continue;
+        }
+        switch (types_[column_id]->type()) {
+            case LogicalType::kBoolean: {
+                BooleanT value = key[offset++] != 0;
+                column.AppendByPtr(reinterpret_cast<const_ptr_t>(&value));
+                break;
+            }
+            case LogicalType::kVarchar: {
+                u32 length;
+                std::memcpy(&length, key.data() + offset, sizeof(length));
+                offset += sizeof(length);
+                column.AppendVarchar(Span<const char>(key.data() + offset, length));
+                offset += length;
+                break;
+            }
+            default: {
+                u64 value[2];
+                SizeT type_size = types_[column_id]->Size();
+                std::memcpy(value, key.data() + offset, type_size);
+                column.AppendByPtr(reinterpret_cast<const_ptr_t>(value));
+                offset += type_size;
+                break;
+            }
+        }
     }
-    block_row_id = iter->second;
-    return true;
 }
 
-} // namespace infinity
\ No newline at end of file
+} // namespace infinity
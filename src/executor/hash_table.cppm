@@ -23,37 +23,96 @@ import data_type;
 
 namespace infinity {
 
-class HashTableBase {
+// Finalizer of MurmurHash3, good enough to spread the bits of integer keys over the whole u64.
+export inline u64 MixHash(u64 key) {
+    key ^= key >> 33;
+    key *= 0xff51afd7ed558ccdULL;
+    key ^= key >> 33;
+    key *= 0xc4ceb9fe1a85ec53ULL;
+    key ^= key >> 33;
+    return key;
+}
+
+export inline u64 CombineHash(u64 seed, u64 hash) { return MixHash(seed ^ (hash + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2))); }
+
+export u64 HashBytes(const char *data, SizeT length);
+
+// Open addressing hash table used by group by. Each group owns a fixed size row:
+//  - the encoded group key, if all the key columns are fixed width.
+//  - `payload_size` bytes owned by the caller, e.g. the aggregate states of the group.
+// Key with varchar column falls back to an encoded string stored aside the row.
+// Rows never move after they are created, so the payload pointer of a group keeps valid until the table is destroyed.
+export class GroupByHashTable {
 public:
+    static constexpr u32 kInvalidGroup = std::numeric_limits<u32>::max();
+
     bool Initialized() const { return !types_.empty(); }
 
-    void Init(Vector<SharedPtr<DataType>> types);
+    void Init(Vector<SharedPtr<DataType>> types, SizeT payload_size);
 
-    void GetHashKey(const Vector<SharedPtr<ColumnVector>> &columns, SizeT row_id, String &hash_key) const;
+    // Find the group of each row and write its id to `group_ids`, the missing groups are created.
+    // Group ids are dense, the created groups get the ids starting from the previous group_count().
+    void FindOrCreateGroups(const Vector<SharedPtr<ColumnVector>> &columns, SizeT row_count, Vector<u32> &group_ids);
 
-public:
-    Vector<SharedPtr<DataType>> types_{};
-    SizeT key_size_{};
-};
+    // Append the key of groups in [group_begin, group_end) to the output columns.
+    void AppendKeys(const Vector<SharedPtr<ColumnVector>> &columns, u32 group_begin, u32 group_end) const;
 
-export class HashTable : public HashTableBase {
-public:
-    void Append(const Vector<SharedPtr<ColumnVector>> &columns, SizeT block_id, SizeT row_count);
+    // Append the key of the listed groups to the output columns.
+    void AppendKeys(const Vector<SharedPtr<ColumnVector>> &columns, const u32 *group_ids, SizeT count) const;
 
-public:
-    // Key -> (block id -> row array)
-    HashMap<String, HashMap<SizeT, Vector<SizeT>>> hash_table_{};
-};
+    inline ptr_t GetPayload(u32 group_id) const { return GroupRow(group_id) + payload_offset_; }
 
-export class MergeHashTable : public HashTableBase {
-public:
-    void Append(const Vector<SharedPtr<ColumnVector>> &columns, SizeT block_id, SizeT row_count);
+    // Hash of the group key, e.g. to radix partition the groups.
+    inline u64 GetHash(u32 group_id) const { return group_hashes_[group_id]; }
 
-    bool GetOrInsert(const Vector<SharedPtr<ColumnVector>> &columns, SizeT row_id, Pair<SizeT, SizeT> &block_row_id);
+    inline SizeT group_count() const { return group_count_; }
 
-public:
-    // Key -> (block id, row id)
-    HashMap<String, Pair<SizeT, SizeT>> hash_table_{};
+    inline SizeT payload_size() const { return payload_size_; }
+
+private:
+    struct Slot {
+        u64 hash_{};
+        u32 group_id_{kInvalidGroup};
+    };
+
+    static constexpr SizeT kGroupsPerPage = 4096;
+
+    inline ptr_t GroupRow(u32 group_id) const { return group_pages_[group_id / kGroupsPerPage].get() + (group_id % kGroupsPerPage) * row_width_; }
+
+    void AppendKey(const Vector<SharedPtr<ColumnVector>> &columns, u32 group_id) const;
+
+    void EncodeFixedKeys(const Vector<SharedPtr<ColumnVector>> &columns, SizeT row_count);
+
+    void EncodeVarlenKeys(const Vector<SharedPtr<ColumnVector>> &columns, SizeT row_count);
+
+    template <SizeT KeyWidth>
+    void FindOrCreateFixedGroups(SizeT row_count, Vector<u32> &group_ids);
+
+    void FindOrCreateVarlenGroups(SizeT row_count, Vector<u32> &group_ids);
+
+    u32 CreateGroup(u64 hash);
+
+    void Grow();
+
+    Vector<SharedPtr<DataType>> types_{};
+    // Fixed key layout: one validity byte per column, followed by the column values. 0 means the varchar fallback.
+    SizeT key_width_{};
+    Vector<SizeT> value_offsets_{};
+
+    SizeT payload_size_{};
+    SizeT payload_offset_{};
+    SizeT row_width_{};
+
+    Vector<Slot> slots_{};
+    u64 slot_mask_{};
+    SizeT group_count_{};
+    Vector<UniquePtr<char[]>> group_pages_{};
+    Vector<u64> group_hashes_{};
+    Vector<String> varlen_keys_{};
+
+    // Scratch space of the current input block
+    Vector<char> key_buffer_{};
+    Vector<String> varlen_key_buffer_{};
 };
 
 } // namespace infinity
@@ -0,0 +1,353 @@
+// Copyright(C) 2024 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+module;
+
+#include <exception>
+#include <future>
+
+module join_hash_table;
+
+import stl;
+import logical_type;
+import column_vector;
+import vector_buffer;
+import data_block;
+import status;
+import infinity_exception;
+import third_party;
+import internal_types;
+import data_type;
+import utility;
+import hash_table;
+import default_values;
+
+namespace infinity {
+
+namespace {
+
+template <typename T>
+inline u64 HashValue(T value) {
+    if constexpr (std::is_floating_point_v<T>) {
+        // +0.0 and -0.0 are equal, they must have the same hash.
+        if (value == 0) {
+            value = 0;
+        }
+    }
+    u64 word = 0;
+    std::memcpy(&word, &value, sizeof(T));
+    return MixHash(word);
+}
+
+template <typename T>
+void HashFixedColumn(const ColumnVector &column, SizeT row_count, bool first, u64 *hashes) {
+    const auto *data = reinterpret_cast<const T *>(column.data());
+    if (column.vector_type() == ColumnVectorType::kConstant) {
+        u64 hash = HashValue<T>(data[0]);
+        for (SizeT row_id = 0; row_id < row_count; ++row_id) {
+            hashes[row_id] = first ? hash : CombineHash(hashes[row_id], hash);
+        }
+        return;
+    }
+    if (first) {
+        for (SizeT row_id = 0; row_id < row_count; ++row_id) {
+            hashes[row_id] = HashValue<T>(data[row_id]);
+        }
+    } else {
+        for (SizeT row_id = 0; row_id < row_count; ++row_id) {
+            hashes[row_id] = CombineHash(hashes[row_id], HashValue<T>(data[row_id]));
+        }
+    }
+}
+
+void HashBooleanColumn(const ColumnVector &column, SizeT row_count, bool first, u64 *hashes) {
+    bool is_constant = column.vector_type() == ColumnVectorType::kConstant;
+    for (SizeT row_id = 0; row_id < row_count; ++row_id) {
+        u64 hash = MixHash(column.buffer_->GetCompactBit(is_constant ? 0 : row_id) ? 1 : 0);
+        hashes[row_id] = first ? hash : CombineHash(hashes[row_id], hash);
+    }
+}
+
+void HashVarcharColumn(const ColumnVector &column, SizeT row_count, bool first, u64 *hashes) {
+    bool is_constant = column.vector_type() == ColumnVectorType::kConstant;
+    for (SizeT row_id = 0; row_id < row_count; ++row_id) {
+        Span<const char> text = column.GetVarchar(is_constant ? 0 : row_id);
+        u64 hash = HashBytes(text.data(), text.size());
+        hashes[row_id] = first ? hash : CombineHash(hashes[row_id], hash);
+    }
+}
+
+template <typename T>
+inline bool FixedEqual(const ColumnVector &left, SizeT left_row, const ColumnVector &right, SizeT right_row) {
+    return reinterpret_cast<const T *>(left.data())[left_row] == reinterpret_cast<const T *>(right.data())[right_row];
+}
+
+} // namespace
+
+JoinHashTable::JoinHashTable(Vector<SizeT> build_key_ids, SizeT build_hash_column_id, u32 radix_bits)
+    : build_key_ids_(std::move(build_key_ids)), build_hash_column_id_(build_hash_column_id), radix_bits_(radix_bits) {
+    if (radix_bits_ >= 16) {
+        String error_message = fmt::format("Too many hash join partitions: 2^{}", radix_bits_);
+        UnrecoverableError(error_message);
+    }
+    partition_entries_.resize(1ULL << radix_bits_);
+}
+
+bool JoinHashTable::SupportKeyType(const DataType &data_type) {
+    switch (data_type.type()) {
+        case LogicalType::kBoolean:
+        case LogicalType::kTinyInt:
+        case LogicalType::kSmallInt:
+        case LogicalType::kInteger:
+        case LogicalType::kBigInt:
+        case LogicalType::kFloat:
+        case LogicalType::kDouble:
+        case LogicalType::kDate:
+        case LogicalType::kTime:
+        case LogicalType::kDateTime:
+        case LogicalType::kTimestamp:
+        case LogicalType::kVarchar: {
+            return true;
+        }
+        default: {
+            return false;
+        }
+    }
+}
+
+void JoinHashTable::HashKeys(const DataBlock &block, const Vector<SizeT> &key_ids, u64 *hashes) {
+    SizeT row_count = block.row_count();
+    for (SizeT key_idx = 0; key_idx < key_ids.size(); ++key_idx) {
+        const ColumnVector &column = *block.column_vectors[key_ids[key_idx]];
+        bool first = key_idx == 0;
+        switch (column.data_type()->type()) {
+            case LogicalType::kBoolean: {
+                HashBooleanColumn(column, row_count, first, hashes);
+                break;
+            }
+            case LogicalType::kTinyInt: {
+                HashFixedColumn<TinyIntT>(column, row_count, first, hashes);
+                break;
+            }
+            case LogicalType::kSmallInt: {
+                HashFixedColumn<SmallIntT>(column, row_count, first, hashes);
+                break;
+            }
+            case LogicalType::kInteger: {
+                HashFixedColumn<IntegerT>(column, row_count, first, hashes);
+                break;
+            }
+            case LogicalType::kBigInt: {
+                HashFixedColumn<BigIntT>(column, row_count, first, hashes);
+                break;
+            }
+            case LogicalType::kFloat: {
+                HashFixedColumn<FloatT>(column, row_count, first, hashes);
+                break;
+            }
+            case LogicalType::kDouble: {
+                HashFixedColumn<DoubleT>(column, row_count, first, hashes);
+                break;
+            }
+            case LogicalType::kDate: {
+                HashFixedColumn<i32>(column, row_count, first, hashes);
+                break;
+            }
+            case LogicalType::kTime: {
+                HashFixedColumn<i32>(column, row_count, first, hashes);
+                break;
+            }
+            case LogicalType::kDateTime:
+            case LogicalType::kTimestamp: {
+                HashFixedColumn<i64>(column, row_count, first, hashes);
+                break;
+            }
+            case LogicalType::kVarchar: {
+                HashVarcharColumn(column, row_count, first, hashes);
+                break;
+            }
+            default: {
+                RecoverableError(Status::NotSupport(fmt::format("Attempt to hash join on type: {}", column.data_type()->ToString())));
+            }
+        }
+    }
+}
+
+bool JoinHashTable::KeysNotNull(const DataBlock &block, const Vector<SizeT> &key_ids, SizeT row_id) {
+    for (SizeT key_id : key_ids) {
+        const ColumnVector &column = *block.column_vectors[key_id];
+        SizeT null_row = column.vector_type() == ColumnVectorType::kConstant ? 0 : row_id;
+        if (!column.nulls_ptr_->IsAllTrue() && !column.nulls_ptr_->IsTrue(null_row)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool JoinHashTable::KeyEqual(const ColumnVector &left, SizeT left_row, const ColumnVector &right, SizeT right_row) {
+    if (left.vector_type() == ColumnVectorType::kConstant) {
+        left_row = 0;
+    }
+    if (right.vector_type() == ColumnVectorType::kConstant) {
+        right_row = 0;
+    }
+    switch (left.data_type()->type()) {
+        case LogicalType::kBoolean: {
+            return left.buffer_->GetCompactBit(left_row) == right.buffer_->GetCompactBit(right_row);
+        }
+        case LogicalType::kTinyInt: {
+            return FixedEqual<TinyIntT>(left, left_row, right, right_row);
+        }
+        case LogicalType::kSmallInt: {
+            return FixedEqual<SmallIntT>(left, left_row, right, right_row);
+        }
+        case LogicalType::kInteger:
+        case LogicalType::kDate:
+        case LogicalType::kTime: {
+            return FixedEqual<i32>(left, left_row, right, right_row);
+        }
+        case LogicalType::kBigInt:
+        case LogicalType::kDateTime:
+        case LogicalType::kTimestamp: {
+            return FixedEqual<i64>(left, left_row, right, right_row);
+        }
+        case LogicalType::kFloat: {
+            return FixedEqual<FloatT>(left, left_row, right, right_row);
+        }
+        case LogicalType::kDouble: {
+            return FixedEqual<DoubleT>(left, left_row, right, right_row);
+        }
+        case LogicalType::kVarchar: {
+            Span<const char> left_text = left.GetVarchar(left_row);
+            Span<const char> right_text = right.GetVarchar(right_row);
+            return left_text.size() == right_text.size() && std::memcmp(left_text.data(), right_text.data(), left_text.size()) == 0;
+        }
+        default: {
+            RecoverableError(Status::NotSupport(fmt::format("Attempt to hash join on type: {}", left.data_type()->ToString())));
+        }
+    }
+    return false;
+}
+
+void JoinHashTable::Append(UniquePtr<DataBlock> block) {
+    if (built_) {
+        String error_message = "Append to a hash join table which is already built";
+        UnrecoverableError(error_message);
+    }
+    SizeT row_count = block->row_count();
+    if (row_count == 0) {
+        return;
+    }
+    u32 block_id = blocks_.size();
+    const auto *hashes = reinterpret_cast<const u64 *>(block->column_vectors[build_hash_column_id_]->data());
+    for (SizeT row_id = 0; row_id < row_count; ++row_id) {
+        if (!KeysNotNull(*block, build_key_ids_, row_id)) {
+            null_key_entries_.push_back(JoinHashEntry{0, block_id, static_cast<u32>(row_id)});
+            continue;
+        }
+        u64 hash = hashes[row_id];
+        partition_entries_[PartitionId(hash)].push_back(JoinHashEntry{hash, block_id, static_cast<u32>(row_id)});
+    }
+    blocks_.emplace_back(std::move(block));
+}
+
+void JoinHashTable::Build(ThreadPool *thread_pool) {
+    if (built_) {
+        return;
+    }
+    SizeT partition_count = partition_entries_.size();
+
+    // Entries of each partition become contiguous, in partition order.
+    Vector<SizeT> partition_offsets(partition_count + 1, 0);
+    for (SizeT partition_id = 0; partition_id < partition_count; ++partition_id) {
+        partition_offsets[partition_id + 1] = partition_offsets[partition_id] + partition_entries_[partition_id].size();
+    }
+    key_row_count_ = partition_offsets[partition_count];
+    entries_.resize(key_row_count_);
+    next_.assign(key_row_count_, kInvalidEntry);
+    partitions_.resize(partition_count);
+
+    // The partitions are about the same size, task i builds partition i, i + task_n, ...
+    SizeT task_n = 1;
+    if (thread_pool != nullptr) {
+        task_n = std::min<SizeT>({static_cast<SizeT>(thread_pool->size()) + 1, partition_count, key_row_count_ / JOIN_PARALLEL_BUILD_MIN_ROWS});
+        task_n = std::max<SizeT>(task_n, 1);
+    }
+    auto build_task = [&](SizeT task_id) {
+        for (SizeT partition_id = task_id; partition_id < partition_count; partition_id += task_n) {
+            BuildPartition(partition_id, partition_offsets[partition_id]);
+        }
+    };
+    Vector<std::future<void>> futs;
+    futs.reserve(task_n - 1);
+    for (SizeT task_id = 1; task_id < task_n; ++task_id) {
+        futs.emplace_back(thread_pool->push([&build_task, task_id](int) { build_task(task_id); }));
+    }
+    std::exception_ptr build_exception;
+    try {
+        build_task(0);
+    } catch (...) {
+        build_exception = std::current_exception();
+    }
+    for (auto &fut : futs) {
+        fut.wait();
+    }
+    if (build_exception) {
+        std::rethrow_exception(build_exception);
+    }
+    for (auto &fut : futs) {
+        fut.get();
+    }
+
+    // Rows having NULL key are out of any chain.
+    entries_.insert(entries_.end(), null_key_entries_.begin(), null_key_entries_.end());
+    next_.resize(entries_.size(), kInvalidEntry);
+    null_key_entries_.clear();
+    built_ = true;
+}
+
+void JoinHashTable::BuildPartition(SizeT partition_id, SizeT entry_begin) {
+    Vector<JoinHashEntry> &partition_entries = partition_entries_[partition_id];
+    SizeT row_count = partition_entries.size();
+    std::copy(partition_entries.begin(), partition_entries.end(), entries_.begin() + entry_begin);
+    Vector<JoinHashEntry>().swap(partition_entries);
+
+    Partition &partition = partitions_[partition_id];
+    SizeT bucket_count = Utility::NextPowerOfTwo(std::max<SizeT>(row_count * 2, 1));
+    partition.buckets_.assign(bucket_count, kInvalidEntry);
+    partition.bucket_mask_ = bucket_count - 1;
+    // Insert in reverse order so that the chain keeps the build order.
+    for (SizeT entry_id = entry_begin + row_count; entry_id > entry_begin; --entry_id) {
+        u32 current = entry_id - 1;
+        u32 &head = partition.buckets_[entries_[current].hash_ & partition.bucket_mask_];
+        next_[current] = head;
+        head = current;
+    }
+}
+
+bool JoinHashTable::Match(u32 entry_id, const DataBlock &probe_block, const Vector<SizeT> &probe_key_ids, SizeT probe_row) const {
+    const JoinHashEntry &entry = entries_[entry_id];
+    const DataBlock &build_block = *blocks_[entry.block_id_];
+    for (SizeT key_idx = 0; key_idx < probe_key_ids.size(); ++key_idx) {
+        if (!KeyEqual(*probe_block.column_vectors[probe_key_ids[key_idx]],
+                      probe_row,
+                      *build_block.column_vectors[build_key_ids_[key_idx]],
+                      entry.block_offset_)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace infinity
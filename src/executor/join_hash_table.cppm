@@ -0,0 +1,114 @@
+// Copyright(C) 2024 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+module;
+
+export module join_hash_table;
+
+import stl;
+import column_vector;
+import data_block;
+import internal_types;
+import data_type;
+
+namespace infinity {
+
+// Location of one row on the build side of a hash join.
+export struct JoinHashEntry {
+    u64 hash_{};
+    u32 block_id_{};
+    u32 block_offset_{};
+};
+
+// Radix partitioned, chained hash table used by PhysicalHashJoin.
+// Build rows are appended block by block together with their precomputed hashes (computed in parallel by PhysicalHash),
+// each row goes to one of 2^radix_bits partitions as it is appended. Each partition owns a power-of-two bucket directory and
+// the entries of a partition are contiguous, so the directory and chains of one partition stay cache resident during probing.
+// The partitions share nothing, so Build chains them in parallel tasks.
+export class JoinHashTable {
+public:
+    static constexpr u32 kInvalidEntry = std::numeric_limits<u32>::max();
+    static constexpr u32 kDefaultRadixBits = 4;
+
+    explicit JoinHashTable(Vector<SizeT> build_key_ids, SizeT build_hash_column_id, u32 radix_bits = kDefaultRadixBits);
+
+    // Only fixed width scalar types and varchar could be used as hash join key.
+    static bool SupportKeyType(const DataType &data_type);
+
+    // Hash the key columns of each row of the block. `hashes` must have room for block.row_count() values.
+    static void HashKeys(const DataBlock &block, const Vector<SizeT> &key_ids, u64 *hashes);
+
+    // NULL never equals to anything, rows having NULL key are never matched. They are still kept for RIGHT / FULL join.
+    static bool KeysNotNull(const DataBlock &block, const Vector<SizeT> &key_ids, SizeT row_id);
+
+    static bool KeyEqual(const ColumnVector &left, SizeT left_row, const ColumnVector &right, SizeT right_row);
+
+    // Take the ownership of a build side block. The hash of each row must be in the column `build_hash_column_id`.
+    void Append(UniquePtr<DataBlock> block);
+
+    // Link the bucket chains of each partition, in parallel on `thread_pool` if given and the table is large enough.
+    // No Append is allowed after Build. Rows having NULL key get the entry ids after all the chained entries.
+    void Build(ThreadPool *thread_pool = nullptr);
+
+    // First entry having the same bucket with `hash`, return kInvalidEntry if the bucket is empty. Only valid after Build.
+    inline u32 FirstEntry(u64 hash) const {
+        const Partition &partition = partitions_[PartitionId(hash)];
+        return partition.buckets_[hash & partition.bucket_mask_];
+    }
+
+    inline u32 NextEntry(u32 entry_id) const { return next_[entry_id]; }
+
+    inline const JoinHashEntry &GetEntry(u32 entry_id) const { return entries_[entry_id]; }
+
+    // Check the build row referenced by entry has the same key with row `probe_row` of the probe block.
+    bool Match(u32 entry_id, const DataBlock &probe_block, const Vector<SizeT> &probe_key_ids, SizeT probe_row) const;
+
+    inline const DataBlock *GetBlock(u32 block_id) const { return blocks_[block_id].get(); }
+
+    // Rows having non-NULL key. Only valid after Build.
+    inline SizeT row_count() const { return key_row_count_; }
+
+    // All the build rows, including the ones having NULL key. Only valid after Build.
+    inline SizeT entry_count() const { return entries_.size(); }
+
+    inline bool built() const { return built_; }
+
+private:
+    struct Partition {
+        Vector<u32> buckets_{};
+        u64 bucket_mask_{0};
+    };
+
+    inline SizeT PartitionId(u64 hash) const { return radix_bits_ == 0 ? 0 : hash >> (64 - radix_bits_); }
+
+    // Move the entries of the partition to [entry_begin, entry_begin + its row count) and chain them into its bucket directory.
+    void BuildPartition(SizeT partition_id, SizeT entry_begin);
+
+    Vector<SizeT> build_key_ids_{};
+    SizeT build_hash_column_id_{};
+    u32 radix_bits_{};
+
+    Vector<UniquePtr<DataBlock>> blocks_{};
+    // Entries of each partition in append order, moved into entries_ by Build.
+    Vector<Vector<JoinHashEntry>> partition_entries_{};
+    // Entries grouped by partition, only filled by Build.
+    Vector<JoinHashEntry> entries_{};
+    Vector<JoinHashEntry> null_key_entries_{};
+    SizeT key_row_count_{};
+    Vector<u32> next_{};
+    Vector<Partition> partitions_{};
+    bool built_{false};
+};
+
+} // namespace infinity
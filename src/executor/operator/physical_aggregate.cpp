@@ -23,12 +23,10 @@ module physical_aggregate;
 import stl;
 import txn;
 import query_context;
-import table_def;
-import data_table;
 
 import operator_state;
 import data_block;
-import utility;
+import hash_table;
 import logger;
 import column_vector;
 import third_party;
@@ -68,234 +66,143 @@ bool PhysicalAggregate::Execute(QueryContext *query_context, OperatorState *oper
         return result;
     }
 
-    // 1. Execute group-by expressions to generate unique key.
-    Vector<SharedPtr<ColumnDef>> groupby_columns;
-    groupby_columns.reserve(group_count);
-
-    Vector<SharedPtr<DataType>> groupby_types;
-    groupby_types.reserve(group_count);
-
-    for (i64 idx = 0; auto &expr : groups_) {
-        SharedPtr<ColumnDef> col_def = MakeShared<ColumnDef>(idx, MakeShared<DataType>(expr->Type()), expr->Name(), std::set<ConstraintType>());
-        groupby_columns.emplace_back(col_def);
-        groupby_types.emplace_back(MakeShared<DataType>(expr->Type()));
-        ++idx;
+    GroupByHashTable &hash_table = aggregate_operator_state->hash_table_;
+    Vector<SizeT> &state_offsets = aggregate_operator_state->state_offsets_;
+    if (!hash_table.Initialized()) {
+        InitGroupByHashTable(groups_, aggregates_, hash_table, state_offsets);
     }
+    GroupByUpdate(groups_, aggregates_, prev_op_state->data_block_array_, hash_table, state_offsets);
+    prev_op_state->data_block_array_.clear();
 
-    SharedPtr<TableDef> groupby_tabledef =
-        TableDef::Make(MakeShared<String>("default_db"), MakeShared<String>("groupby"), MakeShared<String>(""), groupby_columns);
-    SharedPtr<DataTable> groupby_table = DataTable::Make(groupby_tabledef, TableType::kIntermediate);
-
-    // Prepare the expression states
-    Vector<SharedPtr<ExpressionState>> expr_states;
-    expr_states.reserve(group_count);
-    for (const auto &expr : groups_) {
-        // expression state
-        expr_states.emplace_back(ExpressionState::CreateState(expr));
+    if (!task_completed) {
+        return false;
     }
 
-    SizeT input_block_count = prev_op_state->data_block_array_.size();
-    for (SizeT block_idx = 0; block_idx < input_block_count; ++block_idx) {
-        DataBlock *input_data_block = prev_op_state->data_block_array_[block_idx].get();
-
-        groupby_table->data_blocks_.emplace_back(DataBlock::MakeUniquePtr());
-        DataBlock *output_data_block = groupby_table->data_blocks_.back().get();
-        output_data_block->Init(groupby_types);
-
-        ExpressionEvaluator groupby_executor;
-        groupby_executor.Init(input_data_block);
+    // All input is consumed, generate one row for each group.
+    GroupByFinalize(aggregates_, hash_table, state_offsets, *GetOutputTypes(), aggregate_operator_state->data_block_array_);
+    aggregate_operator_state->SetComplete();
+    return true;
+}
 
-        for (SizeT expr_idx = 0; expr_idx < group_count; ++expr_idx) {
-            groupby_executor.Execute(groups_[expr_idx], expr_states[expr_idx], output_data_block->column_vectors[expr_idx]);
-        }
-        output_data_block->Finalize();
+void PhysicalAggregate::InitGroupByHashTable(const Vector<SharedPtr<BaseExpression>> &groups,
+                                             const Vector<SharedPtr<BaseExpression>> &aggregates,
+                                             GroupByHashTable &hash_table,
+                                             Vector<SizeT> &state_offsets) {
+    Vector<SharedPtr<DataType>> groupby_types;
+    groupby_types.reserve(groups.size());
+    for (const auto &expr : groups) {
+        groupby_types.emplace_back(MakeShared<DataType>(expr->Type()));
     }
-
-    // 2. Use the unique key to get the row list of the same key.
-    HashTable &hash_table = aggregate_operator_state->hash_table_;
-    if (!hash_table.Initialized()) {
-        hash_table.Init(groupby_types);
+    // States of all aggregates are kept inline with the group key, each state is 8 bytes aligned.
+    SizeT payload_size = 0;
+    state_offsets.clear();
+    state_offsets.reserve(aggregates.size());
+    for (const auto &expr : aggregates) {
+        const auto *agg_expr = static_cast<const AggregateExpression *>(expr.get());
+        state_offsets.emplace_back(payload_size);
+        payload_size += (agg_expr->aggregate_function_.state_size_ + sizeof(u64) - 1) / sizeof(u64) * sizeof(u64);
     }
+    hash_table.Init(std::move(groupby_types), payload_size);
+}
 
-    SizeT block_count = groupby_table->DataBlockCount();
-    for (SizeT block_id = 0; block_id < block_count; ++block_id) {
-        const SharedPtr<DataBlock> &block_ptr = groupby_table->GetDataBlockById(block_id);
-        hash_table.Append(block_ptr->column_vectors, block_id, block_ptr->row_count());
-    }
+void PhysicalAggregate::GroupByUpdate(const Vector<SharedPtr<BaseExpression>> &groups,
+                                      const Vector<SharedPtr<BaseExpression>> &aggregates,
+                                      const Vector<UniquePtr<DataBlock>> &input_blocks,
+                                      GroupByHashTable &hash_table,
+                                      const Vector<SizeT> &state_offsets) {
+    SizeT group_count = groups.size();
+    SizeT aggregates_count = aggregates.size();
 
-    // 3. forlop each aggregates function on each group by bucket, to calculate the result according to the row list
-    SharedPtr<DataTable> output_groupby_table = DataTable::Make(groupby_tabledef, TableType::kIntermediate);
-    GenerateGroupByResult(groupby_table, output_groupby_table, hash_table);
+    // Prepare the expression states
+    Vector<SharedPtr<DataType>> groupby_types;
+    Vector<SharedPtr<ExpressionState>> groupby_states;
+    groupby_types.reserve(group_count);
+    groupby_states.reserve(group_count);
+    for (const auto &expr : groups) {
+        groupby_types.emplace_back(MakeShared<DataType>(expr->Type()));
+        groupby_states.emplace_back(ExpressionState::CreateState(expr));
+    }
+    Vector<SharedPtr<DataType>> argument_types;
+    Vector<SharedPtr<ExpressionState>> argument_states;
+    argument_types.reserve(aggregates_count);
+    argument_states.reserve(aggregates_count);
+    for (const auto &expr : aggregates) {
+        const SharedPtr<BaseExpression> &argument = expr->arguments()[0];
+        argument_types.emplace_back(MakeShared<DataType>(argument->Type()));
+        argument_states.emplace_back(ExpressionState::CreateState(argument));
+    }
 
-    // input table after group by, each block belong to one group. This is the prerequisites to execute aggregate function.
-    Vector<UniquePtr<DataBlock>> grouped_input_datablocks;
-    GroupByInputTable(prev_op_state->data_block_array_, grouped_input_datablocks, hash_table);
+    // Evaluate the group by keys and the aggregate arguments block by block, and update the states of the groups in place.
+    Vector<u32> group_ids;
+    Vector<ptr_t> group_states;
+    for (const auto &input_block : input_blocks) {
+        SizeT row_count = input_block->row_count();
+        if (row_count == 0) {
+            continue;
+        }
+        ExpressionEvaluator evaluator;
+        evaluator.Init(input_block.get());
 
-    // generate output aggregate table
-    SizeT aggregates_count = aggregates_.size();
-    if (aggregates_count > 0) {
-        SharedPtr<DataTable> output_aggregate_table{};
-
-        // Prepare the output table columns
-        Vector<SharedPtr<ColumnDef>> aggregate_columns;
-        aggregate_columns.reserve(aggregates_count);
-
-        // Prepare the expression states
-        Vector<SharedPtr<ExpressionState>> expr_states;
-        expr_states.reserve(aggregates_.size());
-
-        // Prepare the output block
-        Vector<SharedPtr<DataType>> output_types;
-        output_types.reserve(aggregates_count);
-        auto &agg_states = aggregate_operator_state->states_;
-
-        AggregateFlag flag = aggregate_operator_state->data_block_array_.empty()
-                                 ? (!task_completed ? AggregateFlag::kUninitialized : AggregateFlag::kRunAndFinish)
-                                 : (!task_completed ? AggregateFlag::kRunning : AggregateFlag::kFinish);
-        for (i64 idx = 0; auto &expr : aggregates_) {
-            // expression state
-            expr_states.emplace_back(ExpressionState::CreateState(std::static_pointer_cast<AggregateExpression>(expr), agg_states[idx].get(), flag));
-            SharedPtr<DataType> data_type = MakeShared<DataType>(expr->Type());
-
-            // column definition
-            SharedPtr<ColumnDef> col_def = MakeShared<ColumnDef>(idx, data_type, expr->Name(), std::set<ConstraintType>());
-            aggregate_columns.emplace_back(col_def);
-
-            // for output block
-            output_types.emplace_back(data_type);
-
-            ++idx;
+        DataBlock groupby_block;
+        groupby_block.Init(groupby_types, input_block->capacity());
+        for (SizeT expr_idx = 0; expr_idx < group_count; ++expr_idx) {
+            evaluator.Execute(groups[expr_idx], groupby_states[expr_idx], groupby_block.column_vectors[expr_idx]);
         }
 
-        // output aggregate table definition
-        SharedPtr<TableDef> aggregate_tabledef =
-            TableDef::Make(MakeShared<String>("default_db"), MakeShared<String>("aggregate"), MakeShared<String>(""), aggregate_columns);
-        output_aggregate_table = DataTable::Make(aggregate_tabledef, TableType::kAggregate);
-
-        // Loop blocks
-        SizeT input_data_block_count = grouped_input_datablocks.size();
-        for (SizeT block_idx = 0; block_idx < input_data_block_count; ++block_idx) {
-            SharedPtr<DataBlock> output_data_block = DataBlock::Make();
-            output_data_block->Init(output_types, 1);
-            DataBlock *input_block = grouped_input_datablocks[block_idx].get();
-            // Loop aggregate expression
-            ExpressionEvaluator evaluator;
-            evaluator.Init(input_block);
+        SizeT old_group_count = hash_table.group_count();
+        hash_table.FindOrCreateGroups(groupby_block.column_vectors, row_count, group_ids);
+        for (SizeT group_id = old_group_count; group_id < hash_table.group_count(); ++group_id) {
+            ptr_t payload = hash_table.GetPayload(group_id);
             for (SizeT expr_idx = 0; expr_idx < aggregates_count; ++expr_idx) {
-                SharedPtr<ColumnVector> blocks_column = output_data_block->column_vectors[expr_idx];
-                evaluator.Execute(aggregates_[expr_idx], expr_states[expr_idx], blocks_column);
-                if (blocks_column.get() != output_data_block->column_vectors[expr_idx].get()) {
-                    // column vector in blocks column might be changed to the column vector from column reference.
-                    // This check and assignment is to make sure the right column vector are assign to output_data_block
-                    output_data_block->column_vectors[expr_idx] = blocks_column;
-                }
+                const auto *agg_expr = static_cast<const AggregateExpression *>(aggregates[expr_idx].get());
+                agg_expr->aggregate_function_.init_func_(payload + state_offsets[expr_idx]);
             }
-
-            output_data_block->Finalize();
-            output_aggregate_table->Append(output_data_block);
         }
 
-        // Union output group by table with aggregate table
-        output_groupby_table->UnionWith(output_aggregate_table);
-    }
-
-    // 4. generate the result to output
-    output_groupby_table->ShrinkBlocks();
-    for (SizeT block_idx = 0; block_idx < output_groupby_table->DataBlockCount(); ++block_idx) {
-        SharedPtr<DataBlock> output_data_block = output_groupby_table->GetDataBlockById(block_idx);
-        aggregate_operator_state->data_block_array_.push_back(MakeUnique<DataBlock>(std::move(*output_data_block)));
-    }
-
-    prev_op_state->data_block_array_.clear();
-    if (prev_op_state->Complete()) {
-        aggregate_operator_state->SetComplete();
-    }
-    return true;
-}
-
-void PhysicalAggregate::GroupByInputTable(const Vector<UniquePtr<DataBlock>> &input_datablocks,
-                                          Vector<UniquePtr<DataBlock>> &output_datablocks,
-                                          HashTable &hash_table) {
-    // 1. Get output table column types.
-    Vector<SharedPtr<DataType>> types = input_datablocks.front()->types();
-    SizeT column_count = input_datablocks.front()->column_count();
-
-    // 2. Generate data blocks and append it into output table according to the group by hash table.
-    // const Vector<SharedPtr<DataBlock>> &input_datablocks = input_table->data_blocks_;
-    for (const auto &item : hash_table.hash_table_) {
-
-        // 2.1 Each hash bucket will be insert in to one data block
-        UniquePtr<DataBlock> output_datablock = DataBlock::MakeUniquePtr();
-        SizeT datablock_size = 0;
-        for (const auto &vec_pair : item.second) {
-            datablock_size += vec_pair.second.size();
+        if (aggregates_count == 0) {
+            continue;
         }
-        SizeT datablock_capacity = Utility::NextPowerOfTwo(datablock_size);
-        output_datablock->Init(types, datablock_capacity);
-
-        // Loop each block
-        SizeT output_data_num = 0;
-        for (const auto &vec_pair : item.second) {
-            SizeT input_block_id = vec_pair.first;
-
-            // Forloop each column
-            for (SizeT column_id = 0; column_id < column_count; ++column_id) {
-                // Loop each row of same block
-                for (const auto input_offset : vec_pair.second) {
-
-                    output_datablock->column_vectors[column_id]->AppendWith(*input_datablocks[input_block_id]->column_vectors[column_id],
-                                                                            input_offset,
-                                                                            1);
-                    ++output_data_num;
-                }
+        DataBlock argument_block;
+        argument_block.Init(argument_types, input_block->capacity());
+        group_states.resize(row_count);
+        for (SizeT expr_idx = 0; expr_idx < aggregates_count; ++expr_idx) {
+            auto *agg_expr = static_cast<AggregateExpression *>(aggregates[expr_idx].get());
+            evaluator.Execute(agg_expr->arguments()[0], argument_states[expr_idx], argument_block.column_vectors[expr_idx]);
+            for (SizeT row_id = 0; row_id < row_count; ++row_id) {
+                group_states[row_id] = hash_table.GetPayload(group_ids[row_id]) + state_offsets[expr_idx];
             }
+            agg_expr->aggregate_function_.scatter_update_func_(group_states.data(), argument_block.column_vectors[expr_idx], row_count);
         }
-
-        if (output_data_num != datablock_size * column_count) {
-            String error_message =
-                fmt::format("Expected block size: {}, but only copied data size: {}", datablock_size * column_count, output_data_num);
-            UnrecoverableError(error_message);
-            break;
-        }
-
-        output_datablock->Finalize();
-        output_datablocks.push_back(std::move(output_datablock));
     }
 }
 
-void PhysicalAggregate::GenerateGroupByResult(const SharedPtr<DataTable> &input_table, SharedPtr<DataTable> &output_table, HashTable &hash_table) {
-
-    SizeT column_count = input_table->ColumnCount();
-    Vector<SharedPtr<DataType>> types;
-    types.reserve(column_count);
-    for (SizeT column_id = 0; column_id < column_count; ++column_id) {
-        SharedPtr<DataType> input_type = input_table->GetColumnTypeById(column_id);
-        SharedPtr<DataType> output_type = output_table->GetColumnTypeById(column_id);
-        if (*input_type != *output_type) {
-            Status status = Status::DataTypeMismatch(input_type->ToString(), output_type->ToString());
-            RecoverableError(status);
-        }
-        types.emplace_back(input_type);
-    }
-
-    SharedPtr<DataBlock> output_datablock = nullptr;
-    const Vector<SharedPtr<DataBlock>> &input_datablocks = input_table->data_blocks_;
-    for (const auto &item : hash_table.hash_table_) {
-        // Each hash bucket will generate one data block.
-        output_datablock = DataBlock::Make();
-        output_datablock->Init(types, 1);
-
-        // Only get the first row(block id and row offset of the block) of the bucket
-        SizeT input_block_id = item.second.begin()->first;
-        SizeT input_offset = item.second.begin()->second.front();
-
-        // Only the first position of the column vector has value.
-        for (SizeT column_id = 0; column_id < column_count; ++column_id) {
-            output_datablock->column_vectors[column_id]->AppendWith(*input_datablocks[input_block_id]->column_vectors[column_id], input_offset, 1);
+void PhysicalAggregate::GroupByFinalize(const Vector<SharedPtr<BaseExpression>> &aggregates,
+                                        const GroupByHashTable &hash_table,
+                                        const Vector<SizeT> &state_offsets,
+                                        const Vector<SharedPtr<DataType>> &output_types,
+                                        Vector<UniquePtr<DataBlock>> &output_blocks) {
+    // Output layout: group by keys, then the aggregate results.
+    SizeT aggregates_count = aggregates.size();
+    SizeT key_count = output_types.size() - aggregates_count;
+    SizeT result_count = hash_table.group_count();
+    for (SizeT group_begin = 0; group_begin < result_count; group_begin += DEFAULT_VECTOR_SIZE) {
+        SizeT group_end = std::min(group_begin + DEFAULT_VECTOR_SIZE, result_count);
+        UniquePtr<DataBlock> output_data_block = DataBlock::MakeUniquePtr();
+        output_data_block->Init(output_types);
+
+        Vector<SharedPtr<ColumnVector>> key_columns(output_data_block->column_vectors.begin(), output_data_block->column_vectors.begin() + key_count);
+        hash_table.AppendKeys(key_columns, group_begin, group_end);
+        for (SizeT expr_idx = 0; expr_idx < aggregates_count; ++expr_idx) {
+            const auto *agg_expr = static_cast<const AggregateExpression *>(aggregates[expr_idx].get());
+            ColumnVector &output_column = *output_data_block->column_vectors[key_count + expr_idx];
+            for (SizeT group_id = group_begin; group_id < group_end; ++group_id) {
+                ptr_t result_ptr = agg_expr->aggregate_function_.finalize_func_(hash_table.GetPayload(group_id) + state_offsets[expr_idx]);
+                output_column.AppendByPtr(result_ptr);
+            }
         }
 
-        output_datablock->Finalize();
-        output_table->Append(output_datablock);
+        output_data_block->Finalize();
+        output_blocks.emplace_back(std::move(output_data_block));
     }
 }
 
@@ -22,14 +22,13 @@ import query_context;
 import operator_state;
 import physical_operator;
 import physical_operator_type;
-import data_table;
-import hash_table;
 import base_expression;
 import load_meta;
 import infinity_exception;
 import data_block;
 import internal_types;
 import data_type;
+import hash_table;
 import logger;
 
 namespace infinity {
@@ -57,10 +56,6 @@ public:
 
     bool Execute(QueryContext *query_context, OperatorState *operator_state) final;
 
-    void GroupByInputTable(const Vector<UniquePtr<DataBlock>> &input_blocks, Vector<UniquePtr<DataBlock>> &output_blocks, HashTable &hash_table);
-
-    void GenerateGroupByResult(const SharedPtr<DataTable> &input_table, SharedPtr<DataTable> &output_table, HashTable &hash_table);
-
     Vector<SharedPtr<BaseExpression>> groups_{};
     Vector<SharedPtr<BaseExpression>> aggregates_{};
 
@@ -69,6 +64,24 @@ public:
                                 Vector<UniquePtr<char[]>> &states,
                                 bool task_completed);
 
+    // Group by building blocks, shared with the two phase parallel aggregate.
+    static void InitGroupByHashTable(const Vector<SharedPtr<BaseExpression>> &groups,
+                                     const Vector<SharedPtr<BaseExpression>> &aggregates,
+                                     GroupByHashTable &hash_table,
+                                     Vector<SizeT> &state_offsets);
+
+    static void GroupByUpdate(const Vector<SharedPtr<BaseExpression>> &groups,
+                              const Vector<SharedPtr<BaseExpression>> &aggregates,
+                              const Vector<UniquePtr<DataBlock>> &input_blocks,
+                              GroupByHashTable &hash_table,
+                              const Vector<SizeT> &state_offsets);
+
+    static void GroupByFinalize(const Vector<SharedPtr<BaseExpression>> &aggregates,
+                                const GroupByHashTable &hash_table,
+                                const Vector<SizeT> &state_offsets,
+                                const Vector<SharedPtr<DataType>> &output_types,
+                                Vector<UniquePtr<DataBlock>> &output_blocks);
+
     inline u64 GroupTableIndex() const { return groupby_index_; }
 
     inline u64 AggregateTableIndex() const { return aggregate_index_; }
@@ -50,6 +50,8 @@ import bg_task;
 import wal_manager;
 import result_cache_manager;
 import snapshot;
+import task_priority;
+import session;
 
 namespace infinity {
 
@@ -69,6 +71,23 @@ bool PhysicalCommand::Execute(QueryContext *query_context, OperatorState *operat
                 case SetScope::kSession: {
                     SessionVariable session_var = VarUtil::GetSessionVarByName(set_command->var_name());
                     switch (session_var) {
+                        case SessionVariable::kQueryPriority: {
+                            if (set_command->value_type() != SetVarType::kString) {
+                                Status status = Status::DataTypeMismatch("String", set_command->value_type_str());
+                                RecoverableError(status);
+                            }
+                            const String &priority_str = set_command->value_str();
+                            TaskPriority priority = TaskPriority::kInvalid;
+                            if (priority_str != "default") {
+                                priority = String2TaskPriority(priority_str);
+                                if (priority == TaskPriority::kInvalid) {
+                                    Status status = Status::SetInvalidVarValue("query priority", "interactive, batch, background, default");
+                                    RecoverableError(status);
+                                }
+                            }
+                            query_context->current_session()->set_query_priority(priority);
+                            return true;
+                        }
                         case SessionVariable::kInvalid: {
                             Status status = Status::InvalidCommand(fmt::format("Unknown session variable: {}", set_command->var_name()));
                             RecoverableError(status);
@@ -67,7 +67,7 @@ bool PhysicalCompactIndexPrepare::Execute(QueryContext *query_context, OperatorS
     }
 
     Txn *txn = query_context->GetTxn();
-    auto [segment_index_entries, status] = txn->CreateIndexPrepare(table_index_entry, new_table_ref, prepare_, false);
+    auto [segment_index_entries, status] = txn->CreateIndexPrepare(table_index_entry, new_table_ref, prepare_, false, compact_state_data);
     if (!status.ok()) {
         operator_state->status_ = status;
         return true;
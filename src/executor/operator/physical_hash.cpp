@@ -14,15 +14,55 @@
 
 module;
 
+module physical_hash;
+
+import stl;
 import query_context;
 import operator_state;
-
-module physical_hash;
+import physical_operator;
+import physical_operator_type;
+import data_block;
+import column_vector;
+import join_hash_table;
+import logical_type;
+import internal_types;
+import data_type;
+import load_meta;
 
 namespace infinity {
 
-void PhysicalHash::Init(QueryContext* query_context) {}
+PhysicalHash::PhysicalHash(u64 id, UniquePtr<PhysicalOperator> left, Vector<SizeT> key_column_ids, SharedPtr<Vector<LoadMeta>> load_metas)
+    : PhysicalOperator(PhysicalOperatorType::kHash, std::move(left), nullptr, id, load_metas), key_column_ids_(std::move(key_column_ids)) {
+    output_names_ = MakeShared<Vector<String>>(*left_->GetOutputNames());
+    output_names_->emplace_back("__hash");
+    output_types_ = MakeShared<Vector<SharedPtr<DataType>>>(*left_->GetOutputTypes());
+    output_types_->emplace_back(MakeShared<DataType>(LogicalType::kBigInt));
+}
+
+void PhysicalHash::Init(QueryContext *) {}
+
+bool PhysicalHash::Execute(QueryContext *, OperatorState *operator_state) {
+    auto *prev_op_state = operator_state->prev_op_state_;
+
+    for (auto &input_block : prev_op_state->data_block_array_) {
+        SizeT row_count = input_block->row_count();
+        auto hash_column = ColumnVector::Make(output_types_->back());
+        hash_column->Initialize(ColumnVectorType::kFlat, std::max<SizeT>(row_count, input_block->capacity()));
+        JoinHashTable::HashKeys(*input_block, key_column_ids_, reinterpret_cast<u64 *>(hash_column->data()));
+        hash_column->Finalize(row_count);
+
+        Vector<SharedPtr<ColumnVector>> column_vectors = input_block->column_vectors;
+        column_vectors.emplace_back(std::move(hash_column));
+        auto output_block = DataBlock::MakeUniquePtr();
+        output_block->Init(column_vectors);
+        operator_state->data_block_array_.emplace_back(std::move(output_block));
+    }
 
-bool PhysicalHash::Execute(QueryContext *, OperatorState *) { return true; }
+    prev_op_state->data_block_array_.clear();
+    if (prev_op_state->Complete()) {
+        operator_state->SetComplete();
+    }
+    return true;
+}
 
 } // namespace infinity
@@ -30,14 +30,11 @@ import logger;
 
 namespace infinity {
 
+// Compute the hash of the join keys for each input row, the hash is appended as the last output column.
+// Run in the child fragments of PhysicalHashJoin, so both build and probe side are hashed by all the workers in parallel.
 export class PhysicalHash final : public PhysicalOperator {
 public:
-    explicit PhysicalHash(SharedPtr<Vector<String>> output_names,
-                          SharedPtr<Vector<SharedPtr<DataType>>> output_types,
-                          u64 id,
-                          SharedPtr<Vector<LoadMeta>> load_metas)
-        : PhysicalOperator(PhysicalOperatorType::kHash, nullptr, nullptr, id, load_metas), output_names_(std::move(output_names)),
-          output_types_(std::move(output_types)) {}
+    explicit PhysicalHash(u64 id, UniquePtr<PhysicalOperator> left, Vector<SizeT> key_column_ids, SharedPtr<Vector<LoadMeta>> load_metas);
 
     ~PhysicalHash() override = default;
 
@@ -49,7 +46,15 @@ public:
 
     inline SharedPtr<Vector<SharedPtr<DataType>>> GetOutputTypes() const final { return output_types_; }
 
+    SizeT TaskletCount() override { return left_->TaskletCount(); }
+
+    inline const Vector<SizeT> &key_column_ids() const { return key_column_ids_; }
+
+    // The hash column is always the last output column
+    inline SizeT hash_column_id() const { return output_types_->size() - 1; }
+
 private:
+    Vector<SizeT> key_column_ids_{};
     SharedPtr<Vector<String>> output_names_{};
     SharedPtr<Vector<SharedPtr<DataType>>> output_types_{};
 };
@@ -15,50 +15,437 @@
 module;
 
 #include <string>
-import query_context;
-import operator_state;
-import stl;
 
 module physical_hash_join;
 
+import stl;
+import query_context;
+import operator_state;
+import physical_operator;
+import physical_operator_type;
+import base_expression;
+import expression_type;
+import function_expression;
+import reference_expression;
+import expression_state;
+import expression_selector;
+import expression_evaluator;
+import selection;
+import data_block;
+import column_vector;
+import join_hash_table;
+import logical_type;
+import default_values;
+import status;
+import infinity_exception;
+import third_party;
+import internal_types;
+import join_reference;
+import data_type;
+import logger;
+import load_meta;
+import infinity_context;
+
 namespace infinity {
 
-void PhysicalHashJoin::Init(QueryContext* query_context) {}
+namespace {
+
+// Append `count` rows of `source` starting from `from` to `target`, including the null flags.
+void AppendRows(ColumnVector &target, const ColumnVector &source, SizeT from, SizeT count) {
+    if (source.vector_type() == ColumnVectorType::kConstant) {
+        for (SizeT idx = 0; idx < count; ++idx) {
+            target.AppendWith(source, 0, 1);
+        }
+        if (!source.nulls_ptr_->IsAllTrue() && !source.nulls_ptr_->IsTrue(0)) {
+            target.nulls_ptr_->SetFalseRange(target.Size() - count, target.Size());
+        }
+        return;
+    }
+    SizeT target_start = target.Size();
+    target.AppendWith(source, from, count);
+    if (!source.nulls_ptr_->IsAllTrue()) {
+        for (SizeT idx = 0; idx < count; ++idx) {
+            if (!source.nulls_ptr_->IsTrue(from + idx)) {
+                target.nulls_ptr_->SetFalse(target_start + idx);
+            }
+        }
+    }
+}
+
+// Append the rows of `source` in `rows` to `target`, consecutive rows are copied as one range.
+void GatherRows(ColumnVector &target, const ColumnVector &source, const Vector<u32> &rows) {
+    SizeT row_count = rows.size();
+    SizeT idx = 0;
+    while (idx < row_count) {
+        SizeT run_length = 1;
+        while (idx + run_length < row_count && rows[idx + run_length] == rows[idx] + run_length) {
+            ++run_length;
+        }
+        AppendRows(target, source, rows[idx], run_length);
+        idx += run_length;
+    }
+}
+
+void AppendNull(ColumnVector &target) {
+    switch (target.data_type()->type()) {
+        case LogicalType::kVarchar: {
+            target.AppendVarchar(Span<const char>());
+            break;
+        }
+        case LogicalType::kArray:
+        case LogicalType::kMultiVector:
+        case LogicalType::kTensor:
+        case LogicalType::kTensorArray:
+        case LogicalType::kSparse: {
+            RecoverableError(Status::NotSupport(fmt::format("Pad NULL value of type {} in hash join", target.data_type()->ToString())));
+            break;
+        }
+        default: {
+            Vector<char> zero_value(target.data_type()->Size(), 0);
+            target.AppendByPtr(zero_value.data());
+            break;
+        }
+    }
+    target.nulls_ptr_->SetFalse(target.Size() - 1);
+}
+
+} // namespace
+
+PhysicalHashJoin::PhysicalHashJoin(u64 id,
+                                   JoinType join_type,
+                                   Vector<SharedPtr<BaseExpression>> conditions,
+                                   Vector<SizeT> probe_key_ids,
+                                   Vector<SizeT> build_key_ids,
+                                   Vector<SharedPtr<BaseExpression>> residual_conditions,
+                                   UniquePtr<PhysicalOperator> left,
+                                   UniquePtr<PhysicalOperator> right,
+                                   SharedPtr<Vector<String>> output_names,
+                                   SharedPtr<Vector<SharedPtr<DataType>>> output_types,
+                                   SharedPtr<Vector<LoadMeta>> load_metas)
+    : PhysicalOperator(PhysicalOperatorType::kJoinHash, std::move(left), std::move(right), id, load_metas), join_type_(join_type),
+      conditions_(std::move(conditions)), probe_key_ids_(std::move(probe_key_ids)), build_key_ids_(std::move(build_key_ids)),
+      residual_conditions_(std::move(residual_conditions)), output_names_(std::move(output_names)), output_types_(std::move(output_types)) {
+    // The last column of each input is the hash column produced by PhysicalHash
+    const auto &left_types = *left_->GetOutputTypes();
+    const auto &right_types = *right_->GetOutputTypes();
+    left_column_count_ = left_types.size() - 1;
+    right_column_count_ = right_types.size() - 1;
+    joined_types_.insert(joined_types_.end(), left_types.begin(), left_types.begin() + left_column_count_);
+    joined_types_.insert(joined_types_.end(), right_types.begin(), right_types.begin() + right_column_count_);
+    if ((OutputLeftOnly() ? left_column_count_ : joined_types_.size()) != output_types_->size()) {
+        String error_message = "Hash join output columns mismatch with its inputs";
+        UnrecoverableError(error_message);
+    }
+}
+
+void PhysicalHashJoin::Init(QueryContext *) {}
+
+bool PhysicalHashJoin::SupportJoinType(JoinType join_type) {
+    switch (join_type) {
+        case JoinType::kInner:
+        case JoinType::kLeft:
+        case JoinType::kRight:
+        case JoinType::kFull:
+        case JoinType::kSemi:
+        case JoinType::kAnti: {
+            return true;
+        }
+        default: {
+            return false;
+        }
+    }
+}
+
+void PhysicalHashJoin::ExtractEquiKeys(const Vector<SharedPtr<BaseExpression>> &conditions,
+                                       const Vector<SharedPtr<DataType>> &left_types,
+                                       const Vector<SharedPtr<DataType>> &right_types,
+                                       Vector<SizeT> &probe_key_ids,
+                                       Vector<SizeT> &build_key_ids,
+                                       Vector<SharedPtr<BaseExpression>> &residual_conditions) {
+    SizeT left_column_count = left_types.size();
+    for (const auto &condition : conditions) {
+        bool is_equi_key = false;
+        if (condition->type() == ExpressionType::kFunction) {
+            auto *function_expr = static_cast<FunctionExpression *>(condition.get());
+            auto &arguments = function_expr->arguments();
+            if (function_expr->ScalarFunctionName() == "=" && arguments.size() == 2 && arguments[0]->type() == ExpressionType::kReference &&
+                arguments[1]->type() == ExpressionType::kReference) {
+                SizeT first_idx = static_cast<ReferenceExpression *>(arguments[0].get())->column_index();
+                SizeT second_idx = static_cast<ReferenceExpression *>(arguments[1].get())->column_index();
+                if (first_idx >= left_column_count) {
+                    std::swap(first_idx, second_idx);
+                }
+                if (first_idx < left_column_count && second_idx >= left_column_count && second_idx - left_column_count < right_types.size()) {
+                    const DataType &left_type = *left_types[first_idx];
+                    const DataType &right_type = *right_types[second_idx - left_column_count];
+                    if (left_type == right_type && JoinHashTable::SupportKeyType(left_type)) {
+                        probe_key_ids.emplace_back(first_idx);
+                        build_key_ids.emplace_back(second_idx - left_column_count);
+                        is_equi_key = true;
+                    }
+                }
+            }
+        }
+        if (!is_equi_key) {
+            residual_conditions.emplace_back(condition);
+        }
+    }
+}
+
+bool PhysicalHashJoin::Execute(QueryContext *, OperatorState *operator_state) {
+    auto *join_state = static_cast<HashJoinOperatorState *>(operator_state);
 
-bool PhysicalHashJoin::Execute(QueryContext *, OperatorState *) { return true; }
+    if (join_state->hash_table_.get() == nullptr) {
+        join_state->hash_table_ = MakeUnique<JoinHashTable>(build_key_ids_, right_column_count_);
+    }
+    JoinHashTable *hash_table = join_state->hash_table_.get();
 
-SharedPtr<Vector<String>> PhysicalHashJoin::GetOutputNames() const {
-    SharedPtr<Vector<String>> result = MakeShared<Vector<String>>();
-    SharedPtr<Vector<String>> left_output_names = left_->GetOutputNames();
-    SharedPtr<Vector<String>> right_output_names = right_->GetOutputNames();
+    // Build side blocks are partitioned as soon as they arrive, the bucket chains of the partitions are linked in parallel on the
+    // search thread pool once the build side is drained.
+    for (auto &build_block : join_state->build_data_blocks_) {
+        hash_table->Append(std::move(build_block));
+    }
+    join_state->build_data_blocks_.clear();
+    if (!join_state->build_complete_) {
+        return false;
+    }
+    if (!hash_table->built()) {
+        hash_table->Build(&InfinityContext::instance().GetSearchThreadPool());
+        if (EmitUnmatchedBuildRows()) {
+            join_state->build_matched_.assign(hash_table->entry_count(), false);
+        }
+        LOG_TRACE(fmt::format("Hash join {} built with {} rows", node_id(), hash_table->row_count()));
+    }
+
+    for (auto &probe_block : join_state->probe_data_blocks_) {
+        ProbeBlock(join_state, *probe_block);
+    }
+    join_state->probe_data_blocks_.clear();
 
-    result->reserve(left_output_names->size() + right_output_names->size());
-    for (auto &name_str : *left_output_names) {
-        result->emplace_back(name_str);
+    if (join_state->input_complete_) {
+        if (EmitUnmatchedBuildRows()) {
+            // All probe rows are seen, the build rows never matched are padded with NULL left columns.
+            Vector<u32> build_entries;
+            build_entries.reserve(DEFAULT_VECTOR_SIZE);
+            for (u32 entry_id = 0; entry_id < hash_table->entry_count(); ++entry_id) {
+                if (join_state->build_matched_[entry_id]) {
+                    continue;
+                }
+                build_entries.emplace_back(entry_id);
+                if (build_entries.size() >= DEFAULT_VECTOR_SIZE) {
+                    join_state->data_block_array_.emplace_back(MakeOutputBlock(join_state, nullptr, {}, build_entries));
+                    build_entries.clear();
+                }
+            }
+            if (!build_entries.empty()) {
+                join_state->data_block_array_.emplace_back(MakeOutputBlock(join_state, nullptr, {}, build_entries));
+            }
+        }
+        if (join_state->data_block_array_.empty()) {
+            // Next operators need at least one block to go on
+            auto empty_block = DataBlock::MakeUniquePtr();
+            empty_block->Init(*output_types_);
+            empty_block->Finalize();
+            join_state->data_block_array_.emplace_back(std::move(empty_block));
+        }
+        join_state->SetComplete();
+        return true;
     }
+    return !join_state->data_block_array_.empty();
+}
+
+bool PhysicalHashJoin::EmitUnmatchedBuildRows() const { return join_type_ == JoinType::kRight || join_type_ == JoinType::kFull; }
+
+bool PhysicalHashJoin::OutputLeftOnly() const { return join_type_ == JoinType::kSemi || join_type_ == JoinType::kAnti; }
+
+void PhysicalHashJoin::ProbeBlock(HashJoinOperatorState *join_state, const DataBlock &probe_block) const {
+    const JoinHashTable &hash_table = *join_state->hash_table_;
+    SizeT row_count = probe_block.row_count();
+    const auto *hashes = reinterpret_cast<const u64 *>(probe_block.column_vectors[left_column_count_]->data());
 
-    for (auto &name_str : *right_output_names) {
-        result->emplace_back(name_str);
+    // A probe row is matched once one of the build rows having the same key passes the residual conditions.
+    Vector<bool> probe_matched(row_count, false);
+    Vector<u32> probe_rows;
+    Vector<u32> build_entries;
+    probe_rows.reserve(DEFAULT_VECTOR_SIZE);
+    build_entries.reserve(DEFAULT_VECTOR_SIZE);
+
+    // Without residual conditions, SEMI / ANTI join only need to know whether the first key match exists.
+    bool first_match_only = residual_conditions_.empty() && OutputLeftOnly();
+    for (SizeT row_id = 0; row_id < row_count; ++row_id) {
+        if (!JoinHashTable::KeysNotNull(probe_block, probe_key_ids_, row_id)) {
+            continue;
+        }
+        u64 hash = hashes[row_id];
+        for (u32 entry_id = hash_table.FirstEntry(hash); entry_id != JoinHashTable::kInvalidEntry; entry_id = hash_table.NextEntry(entry_id)) {
+            if (hash_table.GetEntry(entry_id).hash_ != hash || !hash_table.Match(entry_id, probe_block, probe_key_ids_, row_id)) {
+                continue;
+            }
+            if (first_match_only) {
+                probe_matched[row_id] = true;
+                break;
+            }
+            probe_rows.emplace_back(row_id);
+            build_entries.emplace_back(entry_id);
+            if (probe_rows.size() >= DEFAULT_VECTOR_SIZE) {
+                EmitMatchedRows(join_state, probe_block, probe_rows, build_entries, probe_matched);
+                probe_rows.clear();
+                build_entries.clear();
+            }
+        }
+    }
+    if (!probe_rows.empty()) {
+        EmitMatchedRows(join_state, probe_block, probe_rows, build_entries, probe_matched);
+        probe_rows.clear();
+        build_entries.clear();
     }
 
-    return result;
+    // Probe rows emitted without a build row
+    bool emit_matched_probe_rows = false;
+    switch (join_type_) {
+        case JoinType::kLeft:
+        case JoinType::kFull:
+        case JoinType::kAnti: {
+            break;
+        }
+        case JoinType::kSemi: {
+            emit_matched_probe_rows = true;
+            break;
+        }
+        default: {
+            return;
+        }
+    }
+    auto emit_probe_rows = [&] {
+        if (OutputLeftOnly()) {
+            join_state->data_block_array_.emplace_back(MakeProbeOutputBlock(probe_block, probe_rows));
+        } else {
+            join_state->data_block_array_.emplace_back(MakeOutputBlock(join_state, &probe_block, probe_rows, build_entries));
+        }
+        probe_rows.clear();
+        build_entries.clear();
+    };
+    for (SizeT row_id = 0; row_id < row_count; ++row_id) {
+        if (probe_matched[row_id] != emit_matched_probe_rows) {
+            continue;
+        }
+        probe_rows.emplace_back(row_id);
+        build_entries.emplace_back(JoinHashTable::kInvalidEntry);
+        if (probe_rows.size() >= DEFAULT_VECTOR_SIZE) {
+            emit_probe_rows();
+        }
+    }
+    if (!probe_rows.empty()) {
+        emit_probe_rows();
+    }
 }
 
-SharedPtr<Vector<SharedPtr<DataType>>> PhysicalHashJoin::GetOutputTypes() const {
-    SharedPtr<Vector<SharedPtr<DataType>>> result = MakeShared<Vector<SharedPtr<DataType>>>();
-    SharedPtr<Vector<SharedPtr<DataType>>> left_output_types = left_->GetOutputTypes();
-    SharedPtr<Vector<SharedPtr<DataType>>> right_output_types = right_->GetOutputTypes();
+void PhysicalHashJoin::EmitMatchedRows(HashJoinOperatorState *join_state,
+                                       const DataBlock &probe_block,
+                                       const Vector<u32> &probe_rows,
+                                       const Vector<u32> &build_entries,
+                                       Vector<bool> &probe_matched) const {
+    UniquePtr<DataBlock> output_block = MakeOutputBlock(join_state, &probe_block, probe_rows, build_entries);
+    SizeT row_count = output_block->row_count();
+
+    // Rows of the joined block which satisfy all the residual conditions
+    SharedPtr<Selection> passed_rows = nullptr;
+    for (SizeT condition_id = 0; condition_id < residual_conditions_.size(); ++condition_id) {
+        const auto &condition = residual_conditions_[condition_id];
+        SharedPtr<ExpressionState> &condition_state = join_state->residual_states_[condition_id];
+        SharedPtr<ColumnVector> bool_column = MakeShared<ColumnVector>(MakeShared<DataType>(LogicalType::kBoolean));
+        bool_column->Initialize(ColumnVectorType::kCompactBit);
+        ExpressionEvaluator evaluator;
+        evaluator.Init(output_block.get());
+        evaluator.Execute(condition, condition_state, bool_column);
+
+        auto true_rows = MakeShared<Selection>();
+        true_rows->Initialize(row_count);
+        ExpressionSelector::Select(bool_column, row_count, true_rows, true);
+        if (passed_rows.get() == nullptr) {
+            passed_rows = std::move(true_rows);
+            continue;
+        }
+        // Keep the rows passed both the previous conditions and this one, both selections are in ascending order.
+        auto intersection = MakeShared<Selection>();
+        intersection->Initialize(row_count);
+        SizeT true_idx = 0;
+        for (SizeT passed_idx = 0; passed_idx < passed_rows->Size(); ++passed_idx) {
+            SizeT row_id = passed_rows->Get(passed_idx);
+            while (true_idx < true_rows->Size() && true_rows->Get(true_idx) < row_id) {
+                ++true_idx;
+            }
+            if (true_idx < true_rows->Size() && true_rows->Get(true_idx) == row_id) {
+                intersection->Append(row_id);
+            }
+        }
+        passed_rows = std::move(intersection);
+    }
+
+    SizeT passed_count = passed_rows.get() == nullptr ? row_count : passed_rows->Size();
+    for (SizeT idx = 0; idx < passed_count; ++idx) {
+        SizeT row_id = passed_rows.get() == nullptr ? idx : passed_rows->Get(idx);
+        probe_matched[probe_rows[row_id]] = true;
+        if (EmitUnmatchedBuildRows()) {
+            join_state->build_matched_[build_entries[row_id]] = true;
+        }
+    }
 
-    result->reserve(left_output_types->size() + right_output_types->size());
-    for (auto &left_type : *left_output_types) {
-        result->emplace_back(left_type);
+    // SEMI / ANTI join only need the match flags, the left rows are emitted once after the whole block is probed.
+    if (OutputLeftOnly() || passed_count == 0) {
+        return;
     }
+    if (passed_count < row_count) {
+        auto filtered_block = DataBlock::MakeUniquePtr();
+        filtered_block->Init(output_block.get(), passed_rows);
+        output_block = std::move(filtered_block);
+    }
+    join_state->data_block_array_.emplace_back(std::move(output_block));
+}
+
+UniquePtr<DataBlock> PhysicalHashJoin::MakeOutputBlock(HashJoinOperatorState *join_state,
+                                                       const DataBlock *probe_block,
+                                                       const Vector<u32> &probe_rows,
+                                                       const Vector<u32> &build_entries) const {
+    const JoinHashTable &hash_table = *join_state->hash_table_;
+    SizeT row_count = build_entries.size();
+
+    auto output_block = DataBlock::MakeUniquePtr();
+    output_block->Init(joined_types_, std::max<SizeT>(row_count, DEFAULT_VECTOR_SIZE));
 
-    for (auto &right_type : *right_output_types) {
-        result->emplace_back(right_type);
+    for (SizeT column_id = 0; column_id < left_column_count_; ++column_id) {
+        ColumnVector &target = *output_block->column_vectors[column_id];
+        if (probe_block == nullptr) {
+            for (SizeT idx = 0; idx < row_count; ++idx) {
+                AppendNull(target);
+            }
+            continue;
+        }
+        GatherRows(target, *probe_block->column_vectors[column_id], probe_rows);
     }
+    for (SizeT column_id = 0; column_id < right_column_count_; ++column_id) {
+        ColumnVector &target = *output_block->column_vectors[left_column_count_ + column_id];
+        for (u32 entry_id : build_entries) {
+            if (entry_id == JoinHashTable::kInvalidEntry) {
+                AppendNull(target);
+                continue;
+            }
+            const JoinHashEntry &entry = hash_table.GetEntry(entry_id);
+            AppendRows(target, *hash_table.GetBlock(entry.block_id_)->column_vectors[column_id], entry.block_offset_, 1);
+        }
+    }
+    output_block->Finalize();
+    return output_block;
+}
 
-    return result;
+UniquePtr<DataBlock> PhysicalHashJoin::MakeProbeOutputBlock(const DataBlock &probe_block, const Vector<u32> &probe_rows) const {
+    auto output_block = DataBlock::MakeUniquePtr();
+    output_block->Init(*output_types_, std::max<SizeT>(probe_rows.size(), DEFAULT_VECTOR_SIZE));
+    for (SizeT column_id = 0; column_id < left_column_count_; ++column_id) {
+        GatherRows(*output_block->column_vectors[column_id], *probe_block.column_vectors[column_id], probe_rows);
+    }
+    output_block->Finalize();
+    return output_block;
 }
 
 } // namespace infinity
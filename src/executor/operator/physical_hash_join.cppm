@@ -22,18 +22,41 @@ import query_context;
 import operator_state;
 import physical_operator;
 import physical_operator_type;
+import base_expression;
+import data_block;
 import load_meta;
 import infinity_exception;
 import internal_types;
+import join_reference;
 import data_type;
 import logger;
 
 namespace infinity {
 
+// Equi join: the right child is the build side, the left child is the probe side.
+// Both children are PhysicalHash operators, so each input block carries the hash of its join keys as the last column.
+// Output columns are the left columns followed by the right columns, the hash columns are dropped.
+// A pair of rows matches when the keys are equal and the residual (non-equi) conditions hold.
+// For LEFT / FULL join the right columns of unmatched left rows are NULL, for RIGHT / FULL join the left columns of unmatched right rows
+// are NULL and these rows are emitted after the whole probe side is consumed. SEMI / ANTI join only output the left columns, each
+// qualified left row is emitted once.
 export class PhysicalHashJoin : public PhysicalOperator {
 public:
     explicit PhysicalHashJoin(u64 id, SharedPtr<Vector<LoadMeta>> load_metas)
-        : PhysicalOperator(PhysicalOperatorType::kJoinHash, nullptr, nullptr, id, load_metas) {}
+        : PhysicalOperator(PhysicalOperatorType::kJoinHash, nullptr, nullptr, id, load_metas), output_names_(MakeShared<Vector<String>>()),
+          output_types_(MakeShared<Vector<SharedPtr<DataType>>>()) {}
+
+    explicit PhysicalHashJoin(u64 id,
+                              JoinType join_type,
+                              Vector<SharedPtr<BaseExpression>> conditions,
+                              Vector<SizeT> probe_key_ids,
+                              Vector<SizeT> build_key_ids,
+                              Vector<SharedPtr<BaseExpression>> residual_conditions,
+                              UniquePtr<PhysicalOperator> left,
+                              UniquePtr<PhysicalOperator> right,
+                              SharedPtr<Vector<String>> output_names,
+                              SharedPtr<Vector<SharedPtr<DataType>>> output_types,
+                              SharedPtr<Vector<LoadMeta>> load_metas);
 
     ~PhysicalHashJoin() override = default;
 
@@ -41,9 +64,75 @@ public:
 
     bool Execute(QueryContext *query_context, OperatorState *operator_state) final;
 
-    SharedPtr<Vector<String>> GetOutputNames() const final;
+    SharedPtr<Vector<String>> GetOutputNames() const final { return output_names_; }
+
+    SharedPtr<Vector<SharedPtr<DataType>>> GetOutputTypes() const final { return output_types_; }
+
+    static bool SupportJoinType(JoinType join_type);
+
+    // Split the join conditions into equi key pairs (left column = right column) and residual conditions.
+    // Column indexes of the conditions are in the joined (left columns + right columns) layout,
+    // the returned build key ids are relative to the right input.
+    static void ExtractEquiKeys(const Vector<SharedPtr<BaseExpression>> &conditions,
+                                const Vector<SharedPtr<DataType>> &left_types,
+                                const Vector<SharedPtr<DataType>> &right_types,
+                                Vector<SizeT> &probe_key_ids,
+                                Vector<SizeT> &build_key_ids,
+                                Vector<SharedPtr<BaseExpression>> &residual_conditions);
+
+    inline JoinType join_type() const { return join_type_; }
+
+    inline const Vector<SharedPtr<BaseExpression>> &conditions() const { return conditions_; }
+
+    inline const Vector<SizeT> &probe_key_ids() const { return probe_key_ids_; }
+
+    inline const Vector<SizeT> &build_key_ids() const { return build_key_ids_; }
+
+    inline const Vector<SharedPtr<BaseExpression>> &residual_conditions() const { return residual_conditions_; }
+
+    inline void SetBuildFragmentId(u64 fragment_id) { build_fragment_id_ = fragment_id; }
+
+    inline u64 build_fragment_id() const { return build_fragment_id_; }
+
+private:
+    bool EmitUnmatchedBuildRows() const;
+
+    // SEMI / ANTI join output the left columns only.
+    bool OutputLeftOnly() const;
+
+    void ProbeBlock(HashJoinOperatorState *join_state, const DataBlock &probe_block) const;
+
+    // Check the residual conditions on the key matched pairs, mark the matched rows and emit the matched pairs.
+    void EmitMatchedRows(HashJoinOperatorState *join_state,
+                         const DataBlock &probe_block,
+                         const Vector<u32> &probe_rows,
+                         const Vector<u32> &build_entries,
+                         Vector<bool> &probe_matched) const;
+
+    // Join the probe rows with the build entries, a NULL probe block or kInvalidEntry stands for the NULL padded side.
+    // The block has the left columns followed by the right columns, which is the layout the residual conditions are evaluated on.
+    UniquePtr<DataBlock> MakeOutputBlock(HashJoinOperatorState *join_state,
+                                         const DataBlock *probe_block,
+                                         const Vector<u32> &probe_rows,
+                                         const Vector<u32> &build_entries) const;
+
+    // The left columns of the probe rows, the output of SEMI / ANTI join.
+    UniquePtr<DataBlock> MakeProbeOutputBlock(const DataBlock &probe_block, const Vector<u32> &probe_rows) const;
+
+    JoinType join_type_{JoinType::kInner};
+    Vector<SharedPtr<BaseExpression>> conditions_{};
+    Vector<SizeT> probe_key_ids_{};
+    Vector<SizeT> build_key_ids_{};
+    Vector<SharedPtr<BaseExpression>> residual_conditions_{};
+
+    SizeT left_column_count_{};
+    SizeT right_column_count_{};
+    // Types of the left columns followed by the right columns
+    Vector<SharedPtr<DataType>> joined_types_{};
+    u64 build_fragment_id_{};
 
-    SharedPtr<Vector<SharedPtr<DataType>>> GetOutputTypes() const final;
+    SharedPtr<Vector<String>> output_names_{};
+    SharedPtr<Vector<SharedPtr<DataType>>> output_types_{};
 };
 
 } // namespace infinity
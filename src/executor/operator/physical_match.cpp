@@ -14,8 +14,12 @@
 
 module;
 
+#include <algorithm>
 #include <cassert>
 #include <chrono>
+#include <cmath>
+#include <exception>
+#include <future>
 #include <iostream>
 #include <memory>
 #include <string>
@@ -71,6 +75,7 @@ import result_cache_manager;
 import cached_match;
 import filter_iterator;
 import score_threshold_iterator;
+import infinity_context;
 
 namespace infinity {
 
@@ -92,7 +97,8 @@ QueryIterators CreateQueryIterators(QueryBuilder &query_builder,
             case EarlyTermAlgo::kAuto:
             case EarlyTermAlgo::kNaive:
             case EarlyTermAlgo::kBatch:
-            case EarlyTermAlgo::kBMW: {
+            case EarlyTermAlgo::kBMW:
+            case EarlyTermAlgo::kMaxScore: {
                 // ok
                 break;
             }
@@ -118,7 +124,8 @@ QueryIterators CreateQueryIterators(QueryBuilder &query_builder,
         case EarlyTermAlgo::kAuto:
         case EarlyTermAlgo::kNaive:
         case EarlyTermAlgo::kBatch:
-        case EarlyTermAlgo::kBMW: {
+        case EarlyTermAlgo::kBMW:
+        case EarlyTermAlgo::kMaxScore: {
             query_iterators.query_iter = get_iter(early_term_algo);
             break;
         }
@@ -141,7 +148,17 @@ void ASSERT_FLOAT_EQ(const float bar, const u32 i, const float a, const float b)
     }
 }
 
-u32 ExecuteFTSearch(DocIterator *iter, FullTextScoreResultHeap &result_heap) {
+// Publish the heap threshold of a parallel search task and return the best threshold of all tasks, which is a lower bound
+// of the final one. A doc scoring the same as a threshold of another task may still win the tie by its row id, so that
+// threshold is lowered by one ulp.
+float ShareScoreThreshold(Atomic<float> &shared_threshold, const float threshold) {
+    float shared = shared_threshold.load(std::memory_order_relaxed);
+    while (threshold > shared && !shared_threshold.compare_exchange_weak(shared, threshold, std::memory_order_relaxed)) {
+    }
+    return std::max(threshold, std::nextafter(shared, std::numeric_limits<float>::lowest()));
+}
+
+u32 ExecuteFTSearch(DocIterator *iter, FullTextScoreResultHeap &result_heap, Atomic<float> *shared_threshold = nullptr) {
     u32 loop_cnt = 0;
     // iter is nullptr if fulltext index is present but there's no data
     if (!iter) {
@@ -155,18 +172,26 @@ u32 ExecuteFTSearch(DocIterator *iter, FullTextScoreResultHeap &result_heap) {
         }
         if (result_heap.AddResult(iter->Score(), iter->DocID())) {
             // update threshold
-            iter->UpdateScoreThreshold(result_heap.GetScoreThreshold());
+            if (shared_threshold == nullptr) {
+                iter->UpdateScoreThreshold(result_heap.GetScoreThreshold());
+            } else {
+                iter->UpdateScoreThreshold(ShareScoreThreshold(*shared_threshold, result_heap.GetScoreThreshold()));
+            }
+        } else if (shared_threshold != nullptr && loop_cnt % 1024 == 0) {
+            // catch up with the other tasks
+            iter->UpdateScoreThreshold(ShareScoreThreshold(*shared_threshold, result_heap.GetScoreThreshold()));
         }
     }
     return loop_cnt;
 }
 
-auto ExecuteFTSearch(const QueryIterators &query_iterators, const u32 topn) {
-    struct FTSearchResultType {
-        u32 result_count{};
-        UniquePtr<float[]> score_result{};
-        UniquePtr<RowID[]> row_id_result{};
-    };
+struct FTSearchResultType {
+    u32 result_count{};
+    UniquePtr<float[]> score_result{};
+    UniquePtr<RowID[]> row_id_result{};
+};
+
+FTSearchResultType ExecuteFTSearch(const QueryIterators &query_iterators, const u32 topn) {
     auto GetFTSearchResult = [topn](const UniquePtr<DocIterator> &iter) {
         FTSearchResultType result;
         result.score_result = MakeUniqueForOverwrite<float[]>(topn);
@@ -231,18 +256,104 @@ auto ExecuteFTSearch(const QueryIterators &query_iterators, const u32 topn) {
     return bmw_result;
 }
 
+// Assign the segments to the tasks of a parallel search, the largest first, each to the task with the fewest rows.
+// Return the task count, 1 if the table is too small to search in parallel.
+u32 PlanParallelFTSearch(const BlockIndex *block_index, Map<SegmentID, u32> &segment_task) {
+    SizeT row_n = 0;
+    Vector<Pair<SizeT, SegmentID>> segment_rows;
+    for (const auto &[segment_id, segment_snapshot] : block_index->segment_block_index_) {
+        row_n += segment_snapshot.segment_offset_;
+        segment_rows.emplace_back(segment_snapshot.segment_offset_, segment_id);
+    }
+    auto &thread_pool = InfinityContext::instance().GetSearchThreadPool();
+    const SizeT task_n = std::min<SizeT>({static_cast<SizeT>(thread_pool.size()) + 1, segment_rows.size(), row_n / MATCH_PARALLEL_SEARCH_MIN_ROWS});
+    if (task_n <= 1) {
+        return 1;
+    }
+    std::sort(segment_rows.begin(), segment_rows.end(), std::greater<>());
+    Vector<SizeT> task_row_n(task_n, 0);
+    for (const auto &[segment_row_n, segment_id] : segment_rows) {
+        const u32 task_id = std::min_element(task_row_n.begin(), task_row_n.end()) - task_row_n.begin();
+        segment_task[segment_id] = task_id;
+        task_row_n[task_id] += segment_row_n;
+    }
+    return task_n;
+}
+
+// Search each part of the segments with its own iterator into its own heap, then merge the heaps.
+FTSearchResultType ExecuteParallelFTSearch(const Vector<UniquePtr<DocIterator>> &task_iters, const u32 topn) {
+    const SizeT task_n = task_iters.size();
+    Vector<FTSearchResultType> task_results(task_n);
+    Atomic<float> shared_threshold{0.0f};
+    auto search_task = [&](const SizeT task_id) {
+        auto &result = task_results[task_id];
+        result.score_result = MakeUniqueForOverwrite<float[]>(topn);
+        result.row_id_result = MakeUniqueForOverwrite<RowID[]>(topn);
+        FullTextScoreResultHeap result_heap(topn, result.score_result.get(), result.row_id_result.get());
+        ExecuteFTSearch(task_iters[task_id].get(), result_heap, &shared_threshold);
+        result.result_count = result_heap.GetResultSize();
+    };
+    auto &thread_pool = InfinityContext::instance().GetSearchThreadPool();
+    Vector<std::future<void>> futs;
+    futs.reserve(task_n - 1);
+    for (SizeT task_id = 1; task_id < task_n; ++task_id) {
+        futs.emplace_back(thread_pool.push([&search_task, task_id](int) { search_task(task_id); }));
+    }
+    std::exception_ptr search_exception;
+    try {
+        search_task(0);
+    } catch (...) {
+        search_exception = std::current_exception();
+    }
+    for (auto &fut : futs) {
+        fut.wait();
+    }
+    if (search_exception) {
+        std::rethrow_exception(search_exception);
+    }
+    for (auto &fut : futs) {
+        fut.get();
+    }
+
+    FTSearchResultType result;
+    result.score_result = MakeUniqueForOverwrite<float[]>(topn);
+    result.row_id_result = MakeUniqueForOverwrite<RowID[]>(topn);
+    FullTextScoreResultHeap result_heap(topn, result.score_result.get(), result.row_id_result.get());
+    for (const auto &task_result : task_results) {
+        for (u32 i = 0; i < task_result.result_count; ++i) {
+            result_heap.AddResult(task_result.score_result[i], task_result.row_id_result[i]);
+        }
+    }
+    result_heap.Sort();
+    result.result_count = result_heap.GetResultSize();
+    return result;
+}
+
 bool PhysicalMatch::ExecuteInner(QueryContext *query_context, OperatorState *operator_state) {
     if (!common_query_filter_) {
         UnrecoverableError(fmt::format("{}: common_query_filter_ is nullptr", __func__));
     }
     using TimeDurationType = std::chrono::duration<float, std::milli>;
     const auto execute_start_time = std::chrono::high_resolution_clock::now();
-    // 1. build QueryNode tree
-    QueryBuilder query_builder(base_table_ref_->table_info_);
-    query_builder.Init(index_reader_);
+    // 1. build QueryNode tree, one for each task if the segments are searched in parallel
+    Map<SegmentID, u32> segment_task;
+    const u32 task_n = early_term_algo_ == EarlyTermAlgo::kCompare ? 1 : PlanParallelFTSearch(base_table_ref_->block_index_.get(), segment_task);
+    Vector<SharedPtr<IndexReader>> task_index_readers;
+    if (task_n > 1) {
+        task_index_readers = index_reader_->SplitBySegment(segment_task, task_n);
+    } else {
+        task_index_readers.push_back(index_reader_);
+    }
+    Vector<QueryBuilder> query_builders;
+    query_builders.reserve(task_n);
+    for (auto &task_index_reader : task_index_readers) {
+        query_builders.emplace_back(base_table_ref_->table_info_);
+        query_builders.back().Init(task_index_reader);
+    }
     const auto finish_init_query_builder_time = std::chrono::high_resolution_clock::now();
-    LOG_DEBUG(fmt::format("PhysicalMatch 1: Init QueryBuilder time: {} ms",
-                          static_cast<TimeDurationType>(finish_init_query_builder_time - execute_start_time).count()));
+    LOG_DEBUG(fmt::format("PhysicalMatch 1: Init QueryBuilder time: {} ms, search tasks: {}",
+                          static_cast<TimeDurationType>(finish_init_query_builder_time - execute_start_time).count(),
+                          task_n));
 
     // 2 build query iterator
     FullTextQueryContext full_text_query_context(ft_similarity_,
@@ -252,13 +363,27 @@ bool PhysicalMatch::ExecuteInner(QueryContext *query_context, OperatorState *ope
                                                  top_n_,
                                                  match_expr_->index_names_);
     full_text_query_context.query_tree_ = MakeUnique<FilterQueryNode>(common_query_filter_.get(), std::move(query_tree_));
-    const auto query_iterators = CreateQueryIterators(query_builder, full_text_query_context, early_term_algo_, begin_threshold_, score_threshold_);
+    Vector<QueryIterators> query_iterators;
+    query_iterators.reserve(task_n);
+    for (auto &query_builder : query_builders) {
+        query_iterators.push_back(CreateQueryIterators(query_builder, full_text_query_context, early_term_algo_, begin_threshold_, score_threshold_));
+    }
     const auto finish_query_builder_time = std::chrono::high_resolution_clock::now();
     LOG_DEBUG(fmt::format("PhysicalMatch Part 2: Build Query iterator time: {} ms",
                           static_cast<TimeDurationType>(finish_query_builder_time - finish_init_query_builder_time).count()));
 
     // 3 full text search
-    const auto [result_count, score_result, row_id_result] = ExecuteFTSearch(query_iterators, top_n_);
+    FTSearchResultType search_result;
+    if (task_n > 1) {
+        Vector<UniquePtr<DocIterator>> task_iters;
+        for (auto &task_query_iterators : query_iterators) {
+            task_iters.push_back(std::move(task_query_iterators.query_iter));
+        }
+        search_result = ExecuteParallelFTSearch(task_iters, top_n_);
+    } else {
+        search_result = ExecuteFTSearch(query_iterators[0], top_n_);
+    }
+    const auto &[result_count, score_result, row_id_result] = search_result;
     auto finish_query_time = std::chrono::high_resolution_clock::now();
     LOG_DEBUG(fmt::format("PhysicalMatch Part 3: Full text search time: {} ms",
                           static_cast<TimeDurationType>(finish_query_time - finish_query_builder_time).count()));
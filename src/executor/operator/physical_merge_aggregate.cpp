@@ -67,42 +67,44 @@ bool PhysicalMergeAggregate::Execute(QueryContext *query_context, OperatorState
 void PhysicalMergeAggregate::GroupByMergeAggregateExecute(MergeAggregateOperatorState *op_state) {
     auto *agg_op = static_cast<PhysicalAggregate *>(this->left());
     SizeT group_count = agg_op->groups_.size();
-    MergeHashTable &hash_table = op_state->hash_table_;
+    GroupByHashTable &hash_table = op_state->hash_table_;
 
     auto &input_block = op_state->input_data_block_;
+    if (input_block.get() == nullptr) {
+        // The aggregate task produced no group.
+        return;
+    }
     if (!hash_table.Initialized()) {
         Vector<SharedPtr<DataType>> groupby_types;
         groupby_types.reserve(group_count);
-        for (i64 idx = 0; auto &expr : agg_op->groups_) {
-            SharedPtr<ColumnDef> col_def = MakeShared<ColumnDef>(idx, MakeShared<DataType>(expr->Type()), expr->Name(), std::set<ConstraintType>());
+        for (auto &expr : agg_op->groups_) {
             groupby_types.emplace_back(MakeShared<DataType>(expr->Type()));
-            ++idx;
         }
 
-        hash_table.Init(groupby_types);
+        // Payload of a group: (block id, row id) of the group in the output blocks.
+        hash_table.Init(groupby_types, sizeof(Pair<SizeT, SizeT>));
     }
     Vector<SharedPtr<ColumnVector>> input_groupby_columns(input_block->column_vectors.begin(), input_block->column_vectors.begin() + group_count);
-    if (op_state->data_block_array_.empty()) {
-        hash_table.Append(input_groupby_columns, 0, input_block->row_count());
-        op_state->data_block_array_.emplace_back(std::move(input_block));
-        LOG_TRACE("Physical MergeAggregate execute first block");
-        return;
-    }
-
-    DataBlock *last_data_block = op_state->data_block_array_.back().get();
-    for (SizeT row_id = 0; row_id < input_block->row_count(); ++row_id) {
-        if (last_data_block->available_capacity() == 0) {
-            Vector<SharedPtr<DataType>> types = last_data_block->types();
-            op_state->data_block_array_.emplace_back(DataBlock::MakeUniquePtr());
-            last_data_block = op_state->data_block_array_.back().get();
-            last_data_block->Init(std::move(types), input_block->capacity());
-        }
-        Pair<SizeT, SizeT> block_row_id = {op_state->data_block_array_.size() - 1, last_data_block->row_count()};
-        bool found = hash_table.GetOrInsert(input_groupby_columns, row_id, block_row_id);
-        if (!found) {
+    SizeT row_count = input_block->row_count();
+    Vector<u32> group_ids;
+    SizeT new_group_id = hash_table.group_count();
+    hash_table.FindOrCreateGroups(input_groupby_columns, row_count, group_ids);
+
+    for (SizeT row_id = 0; row_id < row_count; ++row_id) {
+        auto *block_row_id_ptr = reinterpret_cast<Pair<SizeT, SizeT> *>(hash_table.GetPayload(group_ids[row_id]));
+        if (group_ids[row_id] == new_group_id) {
+            // First row of a group, copy it to the output.
+            ++new_group_id;
+            if (op_state->data_block_array_.empty() || op_state->data_block_array_.back()->available_capacity() == 0) {
+                op_state->data_block_array_.emplace_back(DataBlock::MakeUniquePtr());
+                op_state->data_block_array_.back()->Init(input_block->types(), input_block->capacity());
+            }
+            DataBlock *last_data_block = op_state->data_block_array_.back().get();
+            *block_row_id_ptr = {op_state->data_block_array_.size() - 1, last_data_block->capacity() - last_data_block->available_capacity()};
             last_data_block->AppendWith(input_block.get(), row_id, 1);
             continue;
         }
+        const Pair<SizeT, SizeT> block_row_id = *block_row_id_ptr;
         SizeT agg_count = agg_op->aggregates_.size();
         Pair<SizeT, SizeT> input_block_row_id = {0, row_id};
         for (SizeT col_idx = group_count; col_idx < group_count + agg_count; ++col_idx) {
@@ -145,6 +147,7 @@ void PhysicalMergeAggregate::GroupByMergeAggregateExecute(MergeAggregateOperator
             }
         }
     }
+    input_block.reset();
 }
 
 void PhysicalMergeAggregate::SimpleMergeAggregateExecute(MergeAggregateOperatorState *op_state) {
@@ -12,17 +12,76 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+
 module;
 
+module physical_merge_parallel_aggregate;
+
+import stl;
 import query_context;
 import operator_state;
-
-module physical_merge_parallel_aggregate;
+import physical_aggregate;
+import physical_parallel_aggregate;
+import aggregate_expression;
+import hash_table;
+import data_block;
+import column_vector;
 
 namespace infinity {
 
-void PhysicalMergeParallelAggregate::Init(QueryContext* query_context) {}
+void PhysicalMergeParallelAggregate::Init(QueryContext *) {}
+
+SizeT PhysicalMergeParallelAggregate::TaskletCount() { return static_cast<PhysicalParallelAggregate *>(left_.get())->partition_count(); }
+
+bool PhysicalMergeParallelAggregate::Execute(QueryContext *, OperatorState *operator_state) {
+    auto *merge_state = static_cast<MergeParallelAggregateOperatorState *>(operator_state);
+    auto *parallel_aggregate = static_cast<PhysicalParallelAggregate *>(left_.get());
+
+    GroupByHashTable &hash_table = merge_state->hash_table_;
+    Vector<SizeT> &state_offsets = merge_state->state_offsets_;
+    if (!hash_table.Initialized()) {
+        PhysicalAggregate::InitGroupByHashTable(parallel_aggregate->groups_, aggregates_, hash_table, state_offsets);
+    }
+
+    // Input layout: group by keys, then the partial state of each aggregate.
+    SizeT key_count = parallel_aggregate->groups_.size();
+    SizeT aggregates_count = aggregates_.size();
+    Vector<u32> group_ids;
+    for (const auto &input_block : merge_state->input_data_blocks_) {
+        SizeT row_count = input_block->row_count();
+        if (row_count == 0) {
+            continue;
+        }
+        Vector<SharedPtr<ColumnVector>> key_columns(input_block->column_vectors.begin(), input_block->column_vectors.begin() + key_count);
+        SizeT old_group_count = hash_table.group_count();
+        hash_table.FindOrCreateGroups(key_columns, row_count, group_ids);
+        for (SizeT group_id = old_group_count; group_id < hash_table.group_count(); ++group_id) {
+            ptr_t payload = hash_table.GetPayload(group_id);
+            for (SizeT expr_idx = 0; expr_idx < aggregates_count; ++expr_idx) {
+                const auto *agg_expr = static_cast<const AggregateExpression *>(aggregates_[expr_idx].get());
+                agg_expr->aggregate_function_.init_func_(payload + state_offsets[expr_idx]);
+            }
+        }
+        for (SizeT expr_idx = 0; expr_idx < aggregates_count; ++expr_idx) {
+            const auto *agg_expr = static_cast<const AggregateExpression *>(aggregates_[expr_idx].get());
+            const ColumnVector &state_column = *input_block->column_vectors[key_count + expr_idx];
+            SizeT state_size = agg_expr->aggregate_function_.state_size_;
+            const_ptr_t states = reinterpret_cast<const_ptr_t>(state_column.data());
+            for (SizeT row_id = 0; row_id < row_count; ++row_id) {
+                agg_expr->aggregate_function_.combine_func_(hash_table.GetPayload(group_ids[row_id]) + state_offsets[expr_idx],
+                                                            states + row_id * state_size);
+            }
+        }
+    }
+    merge_state->input_data_blocks_.clear();
+
+    if (!merge_state->input_complete_) {
+        return false;
+    }
 
-bool PhysicalMergeParallelAggregate::Execute(QueryContext *, OperatorState *) { return true; }
+    PhysicalAggregate::GroupByFinalize(aggregates_, hash_table, state_offsets, *output_types_, merge_state->data_block_array_);
+    merge_state->SetComplete();
+    return true;
+}
 
 } // namespace infinity
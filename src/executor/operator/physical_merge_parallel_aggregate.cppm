@@ -12,6 +12,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+
 module;
 
 export module physical_merge_parallel_aggregate;
@@ -22,6 +23,7 @@ import query_context;
 import operator_state;
 import physical_operator;
 import physical_operator_type;
+import base_expression;
 import load_meta;
 import infinity_exception;
 import internal_types;
@@ -30,18 +32,22 @@ import logger;
 
 namespace infinity {
 
+// Second phase of the two phase group by aggregate. Each task owns a disjoint subset of the radix partitions produced by
+// PhysicalParallelAggregate, combines the partial states of the same group and finalizes the result.
 export class PhysicalMergeParallelAggregate final : public PhysicalOperator {
 public:
-    explicit PhysicalMergeParallelAggregate(SharedPtr<Vector<String>> output_names,
+    explicit PhysicalMergeParallelAggregate(u64 id,
+                                            UniquePtr<PhysicalOperator> left,
+                                            Vector<SharedPtr<BaseExpression>> aggregates,
+                                            SharedPtr<Vector<String>> output_names,
                                             SharedPtr<Vector<SharedPtr<DataType>>> output_types,
-                                            u64 id,
                                             SharedPtr<Vector<LoadMeta>> load_metas)
-        : PhysicalOperator(PhysicalOperatorType::kMergeParallelAggregate, nullptr, nullptr, id, load_metas), output_names_(std::move(output_names)),
-          output_types_(std::move(output_types)) {}
+        : PhysicalOperator(PhysicalOperatorType::kMergeParallelAggregate, std::move(left), nullptr, id, load_metas),
+          aggregates_(std::move(aggregates)), output_names_(std::move(output_names)), output_types_(std::move(output_types)) {}
 
     ~PhysicalMergeParallelAggregate() override = default;
 
-    void Init(QueryContext* query_context) override;
+    void Init(QueryContext *query_context) override;
 
     bool Execute(QueryContext *query_context, OperatorState *operator_state) final;
 
@@ -49,6 +55,11 @@ public:
 
     inline SharedPtr<Vector<SharedPtr<DataType>>> GetOutputTypes() const final { return output_types_; }
 
+    // One task for each partition at most
+    SizeT TaskletCount() override;
+
+    Vector<SharedPtr<BaseExpression>> aggregates_{};
+
 private:
     SharedPtr<Vector<String>> output_names_{};
     SharedPtr<Vector<SharedPtr<DataType>>> output_types_{};
@@ -14,15 +14,36 @@
 
 module;
 
+module physical_merge_sort;
+
+import stl;
 import query_context;
 import operator_state;
-
-module physical_merge_sort;
+import data_block;
+import external_sort;
+import logger;
+import third_party;
 
 namespace infinity {
 
-void PhysicalMergeSort::Init(QueryContext* query_context) {}
+void PhysicalMergeSort::Init(QueryContext *query_context) { key_encoder_ = SortKeyEncoder(expressions_, order_by_types_); }
 
-bool PhysicalMergeSort::Execute(QueryContext *query_context, OperatorState *operator_state) { return true; }
+bool PhysicalMergeSort::Execute(QueryContext *query_context, OperatorState *operator_state) {
+    auto *merge_sort_op_state = static_cast<MergeSortOperatorState *>(operator_state);
+    if (!merge_sort_op_state->input_complete_) {
+        return false;
+    }
+    // Every sort task has produced a sorted run, k-way merge them.
+    Vector<UniquePtr<SortedRun>> sorted_runs;
+    sorted_runs.reserve(merge_sort_op_state->input_runs_.size());
+    for (auto &[task_id, input_run] : merge_sort_op_state->input_runs_) {
+        sorted_runs.push_back(std::move(input_run));
+    }
+    merge_sort_op_state->input_runs_.clear();
+    LOG_TRACE(fmt::format("Merge sort merges {} sorted runs", sorted_runs.size()));
+    MergeSortedRuns(sorted_runs, key_encoder_, merge_sort_op_state->expr_states_, operator_state->data_block_array_);
+    operator_state->SetComplete();
+    return true;
+}
 
 } // namespace infinity
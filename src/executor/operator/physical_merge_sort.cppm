@@ -27,17 +27,21 @@ import infinity_exception;
 import internal_types;
 import data_type;
 import logger;
+import base_expression;
+import select_statement;
+import external_sort;
 
 namespace infinity {
 
 export class PhysicalMergeSort final : public PhysicalOperator {
 public:
-    explicit PhysicalMergeSort(SharedPtr<Vector<String>> output_names,
-                               SharedPtr<Vector<SharedPtr<DataType>>> output_types,
-                               u64 id,
+    explicit PhysicalMergeSort(u64 id,
+                               UniquePtr<PhysicalOperator> left,
+                               Vector<SharedPtr<BaseExpression>> expressions,
+                               Vector<OrderType> order_by_types,
                                SharedPtr<Vector<LoadMeta>> load_metas)
-        : PhysicalOperator(PhysicalOperatorType::kMergeSort, nullptr, nullptr, id, load_metas), output_names_(std::move(output_names)),
-          output_types_(std::move(output_types)) {}
+        : PhysicalOperator(PhysicalOperatorType::kMergeSort, std::move(left), nullptr, id, load_metas), expressions_(std::move(expressions)),
+          order_by_types_(std::move(order_by_types)) {}
 
     ~PhysicalMergeSort() override = default;
 
@@ -45,13 +49,19 @@ public:
 
     bool Execute(QueryContext *query_context, OperatorState *operator_state) final;
 
-    inline SharedPtr<Vector<String>> GetOutputNames() const final { return output_names_; }
+    inline SharedPtr<Vector<String>> GetOutputNames() const final { return left_->GetOutputNames(); }
 
-    inline SharedPtr<Vector<SharedPtr<DataType>>> GetOutputTypes() const final { return output_types_; }
+    inline SharedPtr<Vector<SharedPtr<DataType>>> GetOutputTypes() const final { return left_->GetOutputTypes(); }
+
+    // for OperatorState
+    inline auto const &GetSortExpressions() const { return expressions_; }
+
+    inline auto const &GetOrderbyTypes() const { return order_by_types_; }
 
 private:
-    SharedPtr<Vector<String>> output_names_{};
-    SharedPtr<Vector<SharedPtr<DataType>>> output_types_{};
+    Vector<SharedPtr<BaseExpression>> expressions_;
+    Vector<OrderType> order_by_types_{};
+    SortKeyEncoder key_encoder_{};
 };
 
 } // namespace infinity
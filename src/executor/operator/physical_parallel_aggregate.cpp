@@ -12,17 +12,112 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+
 module;
 
+module physical_parallel_aggregate;
+
+import stl;
 import query_context;
 import operator_state;
-
-module physical_parallel_aggregate;
+import physical_aggregate;
+import aggregate_expression;
+import hash_table;
+import data_block;
+import column_vector;
+import default_values;
+import embedding_info;
+import logical_type;
+import third_party;
 
 namespace infinity {
 
-void PhysicalParallelAggregate::Init(QueryContext* query_context) {}
+PhysicalParallelAggregate::PhysicalParallelAggregate(u64 id,
+                                                     UniquePtr<PhysicalOperator> left,
+                                                     Vector<SharedPtr<BaseExpression>> groups,
+                                                     Vector<SharedPtr<BaseExpression>> aggregates,
+                                                     SizeT partition_count,
+                                                     SharedPtr<Vector<LoadMeta>> load_metas)
+    : PhysicalOperator(PhysicalOperatorType::kParallelAggregate, std::move(left), nullptr, id, load_metas), groups_(std::move(groups)),
+      aggregates_(std::move(aggregates)), partition_count_(partition_count) {
+    if (partition_count_ == 0 || (partition_count_ & (partition_count_ - 1)) != 0) {
+        String error_message = fmt::format("Partition count of parallel aggregate should be power of 2, but got {}", partition_count_);
+        UnrecoverableError(error_message);
+    }
+    while ((SizeT(1) << partition_bits_) < partition_count_) {
+        ++partition_bits_;
+    }
+
+    output_names_ = MakeShared<Vector<String>>();
+    output_types_ = MakeShared<Vector<SharedPtr<DataType>>>();
+    output_names_->reserve(groups_.size() + aggregates_.size());
+    output_types_->reserve(groups_.size() + aggregates_.size());
+    for (const auto &expr : groups_) {
+        output_names_->emplace_back(expr->Name());
+        output_types_->emplace_back(MakeShared<DataType>(expr->Type()));
+    }
+    for (const auto &expr : aggregates_) {
+        const auto *agg_expr = static_cast<const AggregateExpression *>(expr.get());
+        output_names_->emplace_back(fmt::format("{}_state", expr->Name()));
+        output_types_->emplace_back(StateType(agg_expr->aggregate_function_.state_size_));
+    }
+}
+
+void PhysicalParallelAggregate::Init(QueryContext *) {}
+
+SharedPtr<DataType> PhysicalParallelAggregate::StateType(SizeT state_size) {
+    return MakeShared<DataType>(LogicalType::kEmbedding, EmbeddingInfo::Make(EmbeddingDataType::kElemInt8, state_size));
+}
+
+bool PhysicalParallelAggregate::Execute(QueryContext *, OperatorState *operator_state) {
+    OperatorState *prev_op_state = operator_state->prev_op_state_;
+    auto *parallel_aggregate_state = static_cast<ParallelAggregateOperatorState *>(operator_state);
+
+    GroupByHashTable &hash_table = parallel_aggregate_state->hash_table_;
+    Vector<SizeT> &state_offsets = parallel_aggregate_state->state_offsets_;
+    if (!hash_table.Initialized()) {
+        PhysicalAggregate::InitGroupByHashTable(groups_, aggregates_, hash_table, state_offsets);
+    }
+    PhysicalAggregate::GroupByUpdate(groups_, aggregates_, prev_op_state->data_block_array_, hash_table, state_offsets);
+    prev_op_state->data_block_array_.clear();
+
+    if (!prev_op_state->Complete()) {
+        return false;
+    }
+
+    // Scatter the groups to the radix partitions, each partition is merged by one task of the next fragment.
+    Vector<Vector<u32>> partition_groups(partition_count_);
+    for (u32 group_id = 0; group_id < hash_table.group_count(); ++group_id) {
+        partition_groups[PartitionOf(hash_table.GetHash(group_id))].push_back(group_id);
+    }
+
+    SizeT key_count = groups_.size();
+    SizeT aggregates_count = aggregates_.size();
+    for (SizeT partition_id = 0; partition_id < partition_count_; ++partition_id) {
+        const Vector<u32> &group_ids = partition_groups[partition_id];
+        for (SizeT begin = 0; begin < group_ids.size(); begin += DEFAULT_VECTOR_SIZE) {
+            SizeT count = std::min<SizeT>(DEFAULT_VECTOR_SIZE, group_ids.size() - begin);
+            UniquePtr<DataBlock> output_data_block = DataBlock::MakeUniquePtr();
+            output_data_block->Init(*output_types_);
+
+            Vector<SharedPtr<ColumnVector>> key_columns(output_data_block->column_vectors.begin(),
+                                                        output_data_block->column_vectors.begin() + key_count);
+            hash_table.AppendKeys(key_columns, group_ids.data() + begin, count);
+            for (SizeT expr_idx = 0; expr_idx < aggregates_count; ++expr_idx) {
+                ColumnVector &state_column = *output_data_block->column_vectors[key_count + expr_idx];
+                for (SizeT idx = begin; idx < begin + count; ++idx) {
+                    state_column.AppendByPtr(hash_table.GetPayload(group_ids[idx]) + state_offsets[expr_idx]);
+                }
+            }
+
+            output_data_block->Finalize();
+            parallel_aggregate_state->data_block_array_.emplace_back(std::move(output_data_block));
+            parallel_aggregate_state->partition_ids_.emplace_back(partition_id);
+        }
+    }
 
-bool PhysicalParallelAggregate::Execute(QueryContext *, OperatorState *) { return true; }
+    parallel_aggregate_state->SetComplete();
+    return true;
+}
 
 } // namespace infinity
@@ -12,6 +12,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+
 module;
 
 export module physical_parallel_aggregate;
@@ -31,18 +32,21 @@ import logger;
 
 namespace infinity {
 
+// First phase of the two phase group by aggregate. Each task pre-aggregates its input into a local hash table, then the groups are
+// radix partitioned by the high bits of the key hash. The output of each group is its key columns followed by the raw partial state
+// of each aggregate, which is combined by PhysicalMergeParallelAggregate.
 export class PhysicalParallelAggregate final : public PhysicalOperator {
 public:
-    explicit PhysicalParallelAggregate(SharedPtr<Vector<String>> output_names,
-                                       SharedPtr<Vector<SharedPtr<DataType>>> output_types,
-                                       u64 id,
-                                       SharedPtr<Vector<LoadMeta>> load_metas)
-        : PhysicalOperator(PhysicalOperatorType::kParallelAggregate, nullptr, nullptr, id, load_metas), output_names_(std::move(output_names)),
-          output_types_(std::move(output_types)) {}
+    explicit PhysicalParallelAggregate(u64 id,
+                                       UniquePtr<PhysicalOperator> left,
+                                       Vector<SharedPtr<BaseExpression>> groups,
+                                       Vector<SharedPtr<BaseExpression>> aggregates,
+                                       SizeT partition_count,
+                                       SharedPtr<Vector<LoadMeta>> load_metas);
 
     ~PhysicalParallelAggregate() override = default;
 
-    void Init(QueryContext* query_context) override;
+    void Init(QueryContext *query_context) override;
 
     bool Execute(QueryContext *query_context, OperatorState *operator_state) final;
 
@@ -50,7 +54,19 @@ public:
 
     inline SharedPtr<Vector<SharedPtr<DataType>>> GetOutputTypes() const final { return output_types_; }
 
+    inline SizeT partition_count() const { return partition_count_; }
+
+    inline SizeT PartitionOf(u64 hash) const { return partition_bits_ == 0 ? 0 : hash >> (64 - partition_bits_); }
+
+    // Partial state of an aggregate is shipped as a fixed width opaque column.
+    static SharedPtr<DataType> StateType(SizeT state_size);
+
+    Vector<SharedPtr<BaseExpression>> groups_{};
+    Vector<SharedPtr<BaseExpression>> aggregates_{};
+
 private:
+    SizeT partition_count_{};
+    SizeT partition_bits_{};
     SharedPtr<Vector<String>> output_names_{};
     SharedPtr<Vector<SharedPtr<DataType>>> output_types_{};
 };
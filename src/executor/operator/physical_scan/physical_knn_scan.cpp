@@ -64,6 +64,8 @@ import hnsw_alg;
 import ivf_index_data_in_mem;
 import ivf_index_data;
 import ivf_index_search;
+import diskann_index_in_chunk;
+import simd_functions;
 
 namespace infinity {
 
@@ -397,10 +399,14 @@ void PhysicalKnnScan::PlanWithIndex(QueryContext *query_context) { // TODO: retu
                 }
                 // check index type
                 if (auto index_type = table_index_entry->index_base()->index_type_;
-                    index_type != IndexType::kIVF and index_type != IndexType::kHnsw) {
+                    index_type != IndexType::kIVF and index_type != IndexType::kHnsw and index_type != IndexType::kDiskAnn) {
                     LOG_TRACE(fmt::format("KnnScan: PlanWithIndex(): Skipping non-knn index."));
                     continue;
                 }
+                if (!DiskAnnIndexApplicable(table_index_entry)) {
+                    LOG_TRACE(fmt::format("KnnScan: PlanWithIndex(): Skipping DiskAnn index for the query."));
+                    continue;
+                }
 
                 // Fill the segment with index
                 {
@@ -433,11 +439,16 @@ void PhysicalKnnScan::PlanWithIndex(QueryContext *query_context) { // TODO: retu
                 RecoverableError(std::move(error_status));
             }
             // check index type
-            if (auto index_type = table_index_entry->index_base()->index_type_; index_type != IndexType::kIVF and index_type != IndexType::kHnsw) {
+            if (auto index_type = table_index_entry->index_base()->index_type_;
+                index_type != IndexType::kIVF and index_type != IndexType::kHnsw and index_type != IndexType::kDiskAnn) {
                 LOG_ERROR("Invalid index type");
                 Status error_status = Status::InvalidIndexType("invalid index");
                 RecoverableError(std::move(error_status));
             }
+            if (!DiskAnnIndexApplicable(table_index_entry)) {
+                Status error_status = Status::NotSupport("DiskAnn index only supports l2 distance");
+                RecoverableError(std::move(error_status));
+            }
 
             // Fill the segment with index
             {
@@ -465,11 +476,94 @@ void PhysicalKnnScan::PlanWithIndex(QueryContext *query_context) { // TODO: retu
     LOG_TRACE(fmt::format("KnnScan: brute force task: {}, index task: {}", block_column_entries_size_, index_entries_size_));
 }
 
+bool PhysicalKnnScan::DiskAnnIndexApplicable(const TableIndexEntry *table_index_entry) const {
+    if (table_index_entry->index_base()->index_type_ != IndexType::kDiskAnn) {
+        return true;
+    }
+    // the chunks are built with l2 metric, the f32 column is checked when the index is created
+    return knn_expression_->distance_type_ == KnnDistanceType::kL2;
+}
+
 SizeT PhysicalKnnScan::BlockEntryCount() const { return base_table_ref_->block_index_->BlockCount(); }
 
+String KnnFilterStrategyToString(KnnFilterStrategy strategy) {
+    switch (strategy) {
+        case KnnFilterStrategy::kNone:
+            return "graph search";
+        case KnnFilterStrategy::kBruteForce:
+            return "brute force";
+        case KnnFilterStrategy::kFilteredGraph:
+            return "filtered graph search";
+        case KnnFilterStrategy::kPostFilter:
+            return "graph search with post filter";
+    }
+    return "invalid";
+}
+
+KnnFilterStrategy PhysicalKnnScan::ChooseFilterStrategy(SizeT match_n, SizeT row_count) {
+    if (match_n >= row_count) {
+        return KnnFilterStrategy::kNone;
+    }
+    if (match_n <= KNN_BRUTE_FORCE_FILTER_ROWS || match_n * 100 <= row_count * KNN_BRUTE_FORCE_FILTER_PERCENT) {
+        return KnnFilterStrategy::kBruteForce;
+    }
+    if (match_n * 100 >= row_count * KNN_POST_FILTER_PERCENT) {
+        return KnnFilterStrategy::kPostFilter;
+    }
+    return KnnFilterStrategy::kFilteredGraph;
+}
+
+SizeT PhysicalKnnScan::ExpandByFilter(SizeT n, SizeT match_n, SizeT row_count) {
+    if (match_n == 0) {
+        return n * KNN_FILTER_MAX_EXPANSION;
+    }
+    return std::min((n * row_count + match_n - 1) / match_n, n * KNN_FILTER_MAX_EXPANSION);
+}
+
+KnnSegmentFilterPlan PhysicalKnnScan::PlanSegmentFilter(SizeT row_count, const Bitmask *bitmask) {
+    if (bitmask == nullptr) {
+        return {row_count, row_count, KnnFilterStrategy::kNone};
+    }
+    const SizeT match_n = bitmask->CountTrue();
+    return {match_n, row_count, ChooseFilterStrategy(match_n, row_count)};
+}
+
+Vector<Pair<SegmentID, KnnSegmentFilterPlan>> PhysicalKnnScan::EstimateFilterPlans() const {
+    Vector<Pair<SegmentID, KnnSegmentFilterPlan>> filter_plans;
+    if (index_entries_.get() == nullptr || index_entries_->empty() || common_query_filter_->AlwaysTrue() ||
+        index_entries_->front()->table_index_entry()->index_base()->index_type_ != IndexType::kHnsw) {
+        return filter_plans;
+    }
+    const BlockIndex *block_index = base_table_ref_->block_index_.get();
+    for (const SegmentIndexEntry *segment_index_entry : *index_entries_) {
+        const SegmentID segment_id = segment_index_entry->segment_id();
+        const SizeT row_count = block_index->GetSegmentOffset(segment_id);
+        const SizeT match_n = common_query_filter_->EstimateMatchCount(segment_id, KNN_FILTER_ESTIMATE_ROWS);
+        if (match_n == 0) {
+            continue;
+        }
+        filter_plans.emplace_back(segment_id, KnnSegmentFilterPlan{match_n, row_count, ChooseFilterStrategy(match_n, row_count)});
+    }
+    return filter_plans;
+}
+
 template <LogicalType t, typename ColumnDataType, typename QueryDataType, template <typename, typename> typename C, typename DistanceDataType>
 struct BruteForceBlockScan;
 
+// widen the column elements to the query type, f16 and bf16 by the SIMD kernels
+template <typename ColumnDataType, typename QueryDataType>
+void CastEmbedding(const ColumnDataType *src, QueryDataType *dst, SizeT elem_n) {
+    if constexpr (std::is_same_v<ColumnDataType, Float16T> && std::is_same_v<QueryDataType, f32>) {
+        GetSIMD_FUNCTIONS().F16ToF32_func_ptr_(src, dst, elem_n);
+    } else if constexpr (std::is_same_v<ColumnDataType, BFloat16T> && std::is_same_v<QueryDataType, f32>) {
+        GetSIMD_FUNCTIONS().BF16ToF32_func_ptr_(src, dst, elem_n);
+    } else {
+        for (SizeT i = 0; i < elem_n; ++i) {
+            dst[i] = static_cast<QueryDataType>(src[i]);
+        }
+    }
+}
+
 template <typename ColumnDataType, typename QueryDataType, template <typename, typename> typename C, typename DistanceDataType>
 void MultiVectorSearchOneLine(MergeKnn<QueryDataType, C, DistanceDataType> *merge_heap,
                               KnnDistance1<QueryDataType, DistanceDataType> *dist_func,
@@ -617,13 +711,51 @@ void PhysicalKnnScan::ExecuteInternalByColumnDataTypeAndQueryDataType(QueryConte
                     break;
                 }
                 case IndexType::kHnsw: {
-                    if constexpr (!(IsAnyOf<ColumnDataType, u8, i8, f32> && std::is_same_v<ColumnDataType, QueryDataType>)) {
+                    if constexpr (!((IsAnyOf<ColumnDataType, u8, i8, f32> && std::is_same_v<ColumnDataType, QueryDataType>) ||
+                                    (IsAnyOf<ColumnDataType, Float16T, BFloat16T> && std::is_same_v<QueryDataType, f32>))) {
                         UnrecoverableError("Invalid data type");
                     } else {
+                        // the selectivity of the filter decides how the index is searched
+                        const KnnSegmentFilterPlan filter_plan = PlanSegmentFilter(segment_row_count, use_bitmask ? &bitmask : nullptr);
+                        const SizeT match_n = filter_plan.match_n_;
+                        const KnnFilterStrategy filter_strategy = filter_plan.strategy_;
+                        LOG_TRACE(fmt::format("KnnScan: segment {} {} matching rows of {}, {}",
+                                              segment_id,
+                                              match_n,
+                                              segment_row_count,
+                                              KnnFilterStrategyToString(filter_strategy)));
+                        if (filter_strategy == KnnFilterStrategy::kBruteForce) {
+                            const BlockID block_n = (segment_row_count + DEFAULT_BLOCK_CAPACITY - 1) / DEFAULT_BLOCK_CAPACITY;
+                            for (BlockID block_id = 0; block_id < block_n; ++block_id) {
+                                const BlockOffset row_count =
+                                    std::min<SegmentOffset>(DEFAULT_BLOCK_CAPACITY, segment_row_count - block_id * DEFAULT_BLOCK_CAPACITY);
+                                Bitmask block_bitmask;
+                                if (!this->CalculateFilterBitmask(segment_id, block_id, row_count, block_bitmask) || block_bitmask.CountTrue() == 0) {
+                                    continue;
+                                }
+                                BlockEntry *block_entry = block_index->GetBlockEntry(segment_id, block_id);
+                                ColumnVector column_vector = block_entry->GetConstColumnVector(buffer_mgr, knn_column_id);
+                                BruteForceBlockScan<t, ColumnDataType, QueryDataType, C, DistanceDataType>::Execute(merge_heap,
+                                                                                                                    dist_func,
+                                                                                                                    knn_query_ptr,
+                                                                                                                    embedding_dim,
+                                                                                                                    buffer_ptr_for_cast,
+                                                                                                                    column_vector,
+                                                                                                                    segment_id,
+                                                                                                                    block_id,
+                                                                                                                    row_count,
+                                                                                                                    block_bitmask);
+                            }
+                            break;
+                        }
+                        const bool graph_filter = filter_strategy == KnnFilterStrategy::kFilteredGraph;
+                        const bool post_filter = filter_strategy == KnnFilterStrategy::kPostFilter;
+
                         auto hnsw_search = [&](auto *hnsw_index, bool with_lock) {
                             bool rerank = false;
                             KnnSearchOption search_option;
                             search_option.column_logical_type_ = t;
+                            search_option.begin_ts_ = begin_ts;
                             for (const auto &opt_param : knn_scan_shared_data->opt_params_) {
                                 if (opt_param.param_name_ == "ef") {
                                     u64 ef = std::stoull(opt_param.param_value_);
@@ -632,46 +764,118 @@ void PhysicalKnnScan::ExecuteInternalByColumnDataTypeAndQueryDataType(QueryConte
                                     rerank = true;
                                 }
                             }
+                            // the filtered walk collects fewer rows, the post filter drops some of the results, both look further
+                            SizeT topk = knn_scan_shared_data->topk_;
+                            if (graph_filter || post_filter) {
+                                const SizeT ef = std::max<SizeT>(search_option.ef_, topk);
+                                search_option.ef_ = ExpandByFilter(ef, match_n, segment_row_count);
+                                if (post_filter) {
+                                    topk = std::min<SizeT>(ExpandByFilter(topk, match_n, segment_row_count), search_option.ef_);
+                                }
+                            }
+                            // the distances of the quantized encodings are estimates, the candidates are always reranked by the raw vectors
+                            const auto *index_hnsw = static_cast<const IndexHnsw *>(segment_index_entry->table_index_entry()->index_base());
+                            if (index_hnsw->encode_type_ == HnswEncodeType::kPQ || index_hnsw->encode_type_ == HnswEncodeType::kRaBitQ) {
+                                rerank = true;
+                            }
+
+                            // the bits of a bit embedding are packed, one vector takes dimension / 8 bytes
+                            const SizeT vec_elem_n = knn_scan_shared_data->query_elem_type_ == EmbeddingDataType::kElemBit
+                                                         ? knn_scan_shared_data->dimension_ / 8
+                                                         : knn_scan_shared_data->dimension_;
+
+                            // the index of a f16 or bf16 column is searched by the f32 query narrowed to the column type
+                            using HnswDataType = typename std::remove_pointer_t<decltype(hnsw_index)>::DataType;
+                            const auto *query_embedding = static_cast<const QueryDataType *>(knn_scan_shared_data->query_embedding_);
+                            const HnswDataType *hnsw_query_embedding = nullptr;
+                            Vector<HnswDataType> query_embedding_cast;
+                            if constexpr (std::is_same_v<HnswDataType, QueryDataType>) {
+                                hnsw_query_embedding = query_embedding;
+                            } else {
+                                const SizeT elem_n = knn_scan_shared_data->query_count_ * vec_elem_n;
+                                query_embedding_cast.assign(query_embedding, query_embedding + elem_n);
+                                hnsw_query_embedding = query_embedding_cast.data();
+                            }
+
+                            // the graph walks of multiple query embeddings are interleaved by the batch search
+                            decltype(hnsw_index->template KnnSearchBatch<false>(nullptr, 0, 0, search_option)) batch_results;
+                            if constexpr (t == LogicalType::kEmbedding) {
+                                if (knn_scan_shared_data->query_count_ > 1) {
+                                    Vector<const HnswDataType *> queries(knn_scan_shared_data->query_count_);
+                                    for (u64 query_idx = 0; query_idx < knn_scan_shared_data->query_count_; ++query_idx) {
+                                        queries[query_idx] = hnsw_query_embedding + query_idx * vec_elem_n;
+                                    }
+                                    if (graph_filter) {
+                                        BitmaskFilter<SegmentOffset> filter(bitmask);
+                                        if (with_lock) {
+                                            batch_results = hnsw_index->template KnnSearchBatch<BitmaskFilter<SegmentOffset>, true>(queries.data(),
+                                                                                                                                queries.size(),
+                                                                                                                                topk,
+                                                                                                                                filter,
+                                                                                                                                search_option);
+                                        } else {
+                                            batch_results = hnsw_index->template KnnSearchBatch<BitmaskFilter<SegmentOffset>, false>(queries.data(),
+                                                                                                                                 queries.size(),
+                                                                                                                                 topk,
+                                                                                                                                 filter,
+                                                                                                                                 search_option);
+                                        }
+                                    } else if (!with_lock) {
+                                        batch_results = hnsw_index->template KnnSearchBatch<false>(queries.data(), queries.size(), topk, search_option);
+                                    } else {
+                                        AppendFilter filter(block_index->GetSegmentOffset(segment_id));
+                                        batch_results = hnsw_index->template KnnSearchBatch<AppendFilter, true>(queries.data(),
+                                                                                                                queries.size(),
+                                                                                                                topk,
+                                                                                                                filter,
+                                                                                                                search_option);
+                                    }
+                                }
+                            }
 
                             i64 result_n = -1;
                             for (u64 query_idx = 0; query_idx < knn_scan_shared_data->query_count_; ++query_idx) {
-                                const auto *query = static_cast<const QueryDataType *>(knn_scan_shared_data->query_embedding_) +
-                                                    query_idx * knn_scan_shared_data->dimension_;
+                                const auto *query = query_embedding + query_idx * vec_elem_n;
+                                const auto *hnsw_query = hnsw_query_embedding + query_idx * vec_elem_n;
 
                                 SizeT result_n1 = 0;
                                 UniquePtr<DistanceDataType[]> d_ptr = nullptr;
                                 UniquePtr<SegmentOffset[]> l_ptr = nullptr;
-                                if (use_bitmask) {
+                                if (!batch_results.empty()) {
+                                    std::tie(result_n1, d_ptr, l_ptr) = std::move(batch_results[query_idx]);
+                                } else if (graph_filter) {
                                     BitmaskFilter<SegmentOffset> filter(bitmask);
                                     if (with_lock) {
                                         std::tie(result_n1, d_ptr, l_ptr) =
-                                            hnsw_index->template KnnSearch<BitmaskFilter<SegmentOffset>, true>(query,
-                                                                                                               knn_scan_shared_data->topk_,
-                                                                                                               filter,
-                                                                                                               search_option);
+                                            hnsw_index->template KnnSearch<BitmaskFilter<SegmentOffset>, true>(hnsw_query, topk, filter, search_option);
                                     } else {
                                         std::tie(result_n1, d_ptr, l_ptr) =
-                                            hnsw_index->template KnnSearch<BitmaskFilter<SegmentOffset>, false>(query,
-                                                                                                                knn_scan_shared_data->topk_,
-                                                                                                                filter,
-                                                                                                                search_option);
+                                            hnsw_index->template KnnSearch<BitmaskFilter<SegmentOffset>, false>(hnsw_query, topk, filter, search_option);
                                     }
                                 } else {
                                     SegmentOffset max_segment_offset = block_index->GetSegmentOffset(segment_id);
                                     if (!with_lock) {
-                                        std::tie(result_n1, d_ptr, l_ptr) =
-                                            hnsw_index->template KnnSearch<false>(query, knn_scan_shared_data->topk_, search_option);
+                                        std::tie(result_n1, d_ptr, l_ptr) = hnsw_index->template KnnSearch<false>(hnsw_query, topk, search_option);
                                     } else {
                                         AppendFilter filter(max_segment_offset);
                                         std::tie(result_n1, d_ptr, l_ptr) =
-                                            hnsw_index->template KnnSearch<AppendFilter, true>(query,
-                                                                                               knn_scan_shared_data->topk_,
-                                                                                               filter,
-                                                                                               search_option);
+                                            hnsw_index->template KnnSearch<AppendFilter, true>(hnsw_query, topk, filter, search_option);
+                                    }
+                                }
+                                if (post_filter) {
+                                    SizeT kept_n = 0;
+                                    for (SizeT i = 0; i < result_n1; ++i) {
+                                        if (l_ptr[i] < bitmask.count() && bitmask.IsTrue(l_ptr[i])) {
+                                            d_ptr[kept_n] = d_ptr[i];
+                                            l_ptr[kept_n] = l_ptr[i];
+                                            ++kept_n;
+                                        }
                                     }
+                                    result_n1 = kept_n;
                                 }
 
-                                if (result_n < 0) {
+                                // the post filter keeps different numbers of results for the queries
+                                if (result_n < 0 || post_filter) {
                                     result_n = result_n1;
                                 } else if (result_n != (i64)result_n1) {
                                     String error_message = "KnnScan: result_n mismatch";
@@ -696,11 +900,21 @@ void PhysicalKnnScan::ExecuteInternalByColumnDataTypeAndQueryDataType(QueryConte
                                             column_vector = block_entry->GetConstColumnVector(buffer_mgr, knn_column_id);
                                         }
                                         if constexpr (t == LogicalType::kEmbedding) {
-                                            const auto *data = reinterpret_cast<const ColumnDataType *>(column_vector.data());
-                                            data += block_offset * knn_scan_shared_data->dimension_;
+                                            const auto *column_data = reinterpret_cast<const ColumnDataType *>(column_vector.data());
+                                            column_data += block_offset * vec_elem_n;
+                                            const QueryDataType *data = nullptr;
+                                            if constexpr (std::is_same_v<ColumnDataType, QueryDataType>) {
+                                                data = column_data;
+                                            } else {
+                                                if (!buffer_ptr_for_cast) {
+                                                    buffer_ptr_for_cast = MakeUniqueForOverwrite<QueryDataType[]>(vec_elem_n);
+                                                }
+                                                CastEmbedding(column_data, buffer_ptr_for_cast.get(), vec_elem_n);
+                                                data = buffer_ptr_for_cast.get();
+                                            }
                                             merge_heap->Search(query,
                                                                data,
-                                                               knn_scan_shared_data->dimension_,
+                                                               vec_elem_n,
                                                                dist_func->dist_func_,
                                                                segment_id,
                                                                segment_offset);
@@ -743,7 +957,7 @@ void PhysicalKnnScan::ExecuteInternalByColumnDataTypeAndQueryDataType(QueryConte
                                         row_ids[i] = RowID{segment_id, l_ptr[i]};
                                     }
 
-                                    merge_heap->Search(0, d_ptr.get(), row_ids.get(), result_n);
+                                    merge_heap->Search(query_idx, d_ptr.get(), row_ids.get(), result_n);
                                 }
                             }
                         };
@@ -777,6 +991,76 @@ void PhysicalKnnScan::ExecuteInternalByColumnDataTypeAndQueryDataType(QueryConte
                     }
                     break;
                 }
+                case IndexType::kDiskAnn: {
+                    if constexpr (!(t == LogicalType::kEmbedding && std::is_same_v<ColumnDataType, f32> && std::is_same_v<QueryDataType, f32>)) {
+                        UnrecoverableError("Invalid data type");
+                    } else {
+                        DiskAnnSearchOption search_option;
+                        for (const auto &opt_param : knn_scan_shared_data->opt_params_) {
+                            if (opt_param.param_name_ == "beam_width") {
+                                search_option.beam_width_ = std::stoul(opt_param.param_value_);
+                            } else if (opt_param.param_name_ == "l_search") {
+                                search_option.l_search_ = std::stoul(opt_param.param_value_);
+                            } else if (opt_param.param_name_ == "rerank") {
+                                search_option.rerank_ = opt_param.param_value_ != "false" && opt_param.param_value_ != "0";
+                            }
+                        }
+                        const SegmentOffset max_segment_offset = block_index->GetSegmentOffset(segment_id);
+                        auto filter = [&](SegmentOffset segment_offset) {
+                            return segment_offset < max_segment_offset && (!use_bitmask || bitmask.IsTrue(segment_offset));
+                        };
+
+                        // rows [0, covered_row_count) are searched in the chunks
+                        u32 covered_row_count = 0;
+                        Vector<SharedPtr<ChunkIndexEntry>> chunk_index_entries = segment_index_entry->GetDiskAnnIndexSnapshot();
+                        for (auto &chunk_index_entry : chunk_index_entries) {
+                            if (!chunk_index_entry->CheckVisible(txn)) {
+                                continue;
+                            }
+                            covered_row_count =
+                                std::max<u32>(covered_row_count, chunk_index_entry->base_rowid_.segment_offset_ + chunk_index_entry->row_count_);
+                            BufferHandle index_handle = chunk_index_entry->GetIndex();
+                            const auto *diskann_chunk = static_cast<const DiskAnnIndexInChunk *>(index_handle.GetData());
+                            for (u64 query_idx = 0; query_idx < knn_scan_shared_data->query_count_; ++query_idx) {
+                                const QueryDataType *query = knn_query_ptr + query_idx * embedding_dim;
+                                auto [result_n, d_ptr, offset_ptr] = diskann_chunk->Search(query, knn_scan_shared_data->topk_, search_option, filter);
+                                auto row_ids = MakeUniqueForOverwrite<RowID[]>(result_n);
+                                for (u32 i = 0; i < result_n; ++i) {
+                                    row_ids[i] = RowID{segment_id, offset_ptr[i]};
+                                }
+                                merge_heap->Search(query_idx, d_ptr.get(), row_ids.get(), result_n);
+                            }
+                        }
+
+                        // the rows appended after the last chunk is built
+                        for (BlockID block_id = covered_row_count / DEFAULT_BLOCK_CAPACITY; block_id * DEFAULT_BLOCK_CAPACITY < max_segment_offset;
+                             ++block_id) {
+                            const u32 block_start_offset = block_id * DEFAULT_BLOCK_CAPACITY;
+                            const BlockEntry *block_entry = block_index->GetBlockEntry(segment_id, block_id);
+                            const auto row_count = std::min<BlockOffset>(block_entry->row_count(), max_segment_offset - block_start_offset);
+                            Bitmask block_bitmask;
+                            if (!this->CalculateFilterBitmask(segment_id, block_id, row_count, block_bitmask)) {
+                                continue;
+                            }
+                            block_entry->SetDeleteBitmask(begin_ts, block_bitmask);
+                            if (covered_row_count > block_start_offset) {
+                                block_bitmask.SetFalseRange(0, covered_row_count - block_start_offset);
+                            }
+                            ColumnVector column_vector = block_entry->GetConstColumnVector(buffer_mgr, knn_column_id);
+                            BruteForceBlockScan<t, ColumnDataType, QueryDataType, C, DistanceDataType>::Execute(merge_heap,
+                                                                                                                dist_func,
+                                                                                                                knn_query_ptr,
+                                                                                                                embedding_dim,
+                                                                                                                buffer_ptr_for_cast,
+                                                                                                                column_vector,
+                                                                                                                segment_id,
+                                                                                                                block_id,
+                                                                                                                row_count,
+                                                                                                                block_bitmask);
+                        }
+                    }
+                    break;
+                }
                 default: {
                     RecoverableError(Status::NotSupport("Not implemented index type"));
                 }
@@ -823,10 +1107,7 @@ struct BruteForceBlockScan<LogicalType::kEmbedding, ColumnDataType, QueryDataTyp
             if (!buffer_ptr_for_cast) {
                 buffer_ptr_for_cast = MakeUniqueForOverwrite<QueryDataType[]>(DEFAULT_BLOCK_CAPACITY * embedding_dim);
             }
-            const SizeT total_elem_num = row_count * embedding_dim;
-            for (SizeT i = 0; i < total_elem_num; ++i) {
-                buffer_ptr_for_cast[i] = static_cast<QueryDataType>(data[i]);
-            }
+            CastEmbedding(data, buffer_ptr_for_cast.get(), row_count * embedding_dim);
             target_ptr = buffer_ptr_for_cast.get();
         }
         auto embedding_info = static_cast<EmbeddingInfo *>(column_vector.data_type()->type_info().get());
@@ -890,9 +1171,7 @@ void MultiVectorSearchOneLine(MergeKnn<QueryDataType, C, DistanceDataType> *merg
     auto raw_data_ptr = reinterpret_cast<const ColumnDataType *>(data_span.data());
     for (u32 i = 0; i < embedding_num; ++i) {
         if constexpr (!std::is_same_v<ColumnDataType, QueryDataType>) {
-            for (u32 j = 0; j < embedding_dim; ++j) {
-                buffer_ptr_for_cast[j] = static_cast<QueryDataType>(raw_data_ptr[j]);
-            }
+            CastEmbedding(raw_data_ptr, buffer_ptr_for_cast.get(), embedding_dim);
         } else {
             target_ptr = raw_data_ptr;
         }
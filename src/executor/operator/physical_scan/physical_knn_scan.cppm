@@ -31,9 +31,28 @@ import logical_type;
 import internal_types;
 import common_query_filter;
 import physical_filter_scan_base;
+import roaring_bitmap;
 
 namespace infinity {
 
+struct TableIndexEntry;
+
+// How the hnsw index of a segment is searched under the filter, chosen by the fraction of rows passing it.
+export enum class KnnFilterStrategy : i8 {
+    kNone,          // no row is filtered out
+    kBruteForce,    // few rows match, their distances are computed exactly
+    kFilteredGraph, // the graph walk only collects the matching rows, with ef expanded by the inverse selectivity
+    kPostFilter,    // most rows match, the graph is searched for the expanded topk and the unmatched results are dropped
+};
+
+export String KnnFilterStrategyToString(KnnFilterStrategy strategy);
+
+export struct KnnSegmentFilterPlan {
+    SizeT match_n_;
+    SizeT row_count_;
+    KnnFilterStrategy strategy_;
+};
+
 export class PhysicalKnnScan final : public PhysicalFilterScanBase {
 public:
     explicit PhysicalKnnScan(u64 id,
@@ -80,9 +99,26 @@ public:
 
     inline bool IsKnnMinHeap() const { return knn_expression_->IsKnnMinHeap(); }
 
+    // `match_n` of the `row_count` rows of a segment pass the filter
+    static KnnFilterStrategy ChooseFilterStrategy(SizeT match_n, SizeT row_count);
+
+    // grow `n` by the inverse selectivity of the filter, at most KNN_FILTER_MAX_EXPANSION times
+    static SizeT ExpandByFilter(SizeT n, SizeT match_n, SizeT row_count);
+
+    // Plan the search of a segment by its filter result, which has the deleted rows removed already.
+    // `bitmask` is nullptr if every row passes the filter.
+    static KnnSegmentFilterPlan PlanSegmentFilter(SizeT row_count, const Bitmask *bitmask);
+
+    // Estimate the filter plan of each segment searched by the hnsw index, for explain.
+    // The segments the filter rules out are left out, the others are planned again by the built filter at execution.
+    Vector<Pair<SegmentID, KnnSegmentFilterPlan>> EstimateFilterPlans() const;
+
 private:
     SizeT GetColumnID() const;
 
+    // DiskAnn index could only serve the l2 distance, other indexes always apply
+    bool DiskAnnIndexApplicable(const TableIndexEntry *table_index_entry) const;
+
 public:
     SharedPtr<KnnExpression> knn_expression_{};
     SharedPtr<void> real_knn_query_embedding_holder_{};
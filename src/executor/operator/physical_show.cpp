@@ -87,6 +87,8 @@ import txn_context;
 import txn_state;
 import snapshot_brief;
 import command_statement;
+import task_scheduler;
+import task_priority;
 
 namespace infinity {
 
@@ -1223,6 +1225,22 @@ void PhysicalShow::ExecuteShowIndex(QueryContext *query_context, ShowOperatorSta
         }
     }
 
+    {
+        SizeT column_id = 0;
+        {
+            Value value = Value::MakeVarchar("training_progress");
+            ValueExpression value_expr(value);
+            value_expr.AppendToChunk(output_block_ptr->column_vectors[column_id]);
+        }
+
+        ++column_id;
+        {
+            Value value = Value::MakeVarchar(*table_index_info->training_progress_);
+            ValueExpression value_expr(value);
+            value_expr.AppendToChunk(output_block_ptr->column_vectors[column_id]);
+        }
+    }
+
     output_block_ptr->Finalize();
     show_operator_state->output_.emplace_back(std::move(output_block_ptr));
 }
@@ -1394,7 +1412,10 @@ void PhysicalShow::ExecuteShowIndexChunk(QueryContext *query_context, ShowOperat
             chunk_indexes = chunk_index_entries;
             break;
         }
-        case IndexType::kDiskAnn:
+        case IndexType::kDiskAnn: {
+            chunk_indexes = segment_index_entry->GetDiskAnnIndexSnapshot();
+            break;
+        }
         case IndexType::kInvalid: {
             Status status3 = Status::InvalidIndexName(index_type_name);
             RecoverableError(status3);
@@ -3732,6 +3753,27 @@ void PhysicalShow::ExecuteShowSessionVariable(QueryContext *query_context, ShowO
             value_expr.AppendToChunk(output_block_ptr->column_vectors[0]);
             break;
         }
+        case SessionVariable::kQueryPriority: {
+            Vector<SharedPtr<ColumnDef>> output_column_defs = {
+                MakeShared<ColumnDef>(0, varchar_type, "value", std::set<ConstraintType>()),
+            };
+
+            SharedPtr<TableDef> table_def =
+                TableDef::Make(MakeShared<String>("default_db"), MakeShared<String>("variables"), nullptr, output_column_defs);
+            output_ = MakeShared<DataTable>(table_def, TableType::kResult);
+
+            Vector<SharedPtr<DataType>> output_column_types{
+                varchar_type,
+            };
+
+            output_block_ptr->Init(output_column_types);
+
+            TaskPriority priority = session_ptr->query_priority();
+            Value value = Value::MakeVarchar(priority == TaskPriority::kInvalid ? "default" : TaskPriority2String(priority));
+            ValueExpression value_expr(value);
+            value_expr.AppendToChunk(output_block_ptr->column_vectors[0]);
+            break;
+        }
         default: {
             operator_state->status_ = Status::NoSysVar(*object_name_);
             RecoverableError(operator_state->status_);
@@ -3846,6 +3888,28 @@ void PhysicalShow::ExecuteShowSessionVariables(QueryContext *query_context, Show
                 }
                 break;
             }
+            case SessionVariable::kQueryPriority: {
+                {
+                    // option name
+                    Value value = Value::MakeVarchar(var_name);
+                    ValueExpression value_expr(value);
+                    value_expr.AppendToChunk(output_block_ptr->column_vectors[0]);
+                }
+                {
+                    // option value
+                    TaskPriority priority = session_ptr->query_priority();
+                    Value value = Value::MakeVarchar(priority == TaskPriority::kInvalid ? "default" : TaskPriority2String(priority));
+                    ValueExpression value_expr(value);
+                    value_expr.AppendToChunk(output_block_ptr->column_vectors[1]);
+                }
+                {
+                    // option description
+                    Value value = Value::MakeVarchar("Scheduling priority of the queries in this session, default: decided by the statement type");
+                    ValueExpression value_expr(value);
+                    value_expr.AppendToChunk(output_block_ptr->column_vectors[2]);
+                }
+                break;
+            }
             default: {
                 operator_state->status_ = Status::NoSysVar(var_name);
                 RecoverableError(operator_state->status_);
@@ -4342,6 +4406,34 @@ void PhysicalShow::ExecuteShowGlobalVariable(QueryContext *query_context, ShowOp
             value_expr.AppendToChunk(output_block_ptr->column_vectors[0]);
             break;
         }
+        case GlobalVariable::kInteractiveTaskMetrics:
+        case GlobalVariable::kBatchTaskMetrics:
+        case GlobalVariable::kBackgroundTaskMetrics: {
+            Vector<SharedPtr<ColumnDef>> output_column_defs = {
+                MakeShared<ColumnDef>(0, varchar_type, "value", std::set<ConstraintType>()),
+            };
+
+            SharedPtr<TableDef> table_def =
+                TableDef::Make(MakeShared<String>("default_db"), MakeShared<String>("variables"), nullptr, output_column_defs);
+            output_ = MakeShared<DataTable>(table_def, TableType::kResult);
+
+            Vector<SharedPtr<DataType>> output_column_types{
+                varchar_type,
+            };
+
+            output_block_ptr->Init(output_column_types);
+
+            TaskPriority priority = TaskPriority::kBackground;
+            if (global_var == GlobalVariable::kInteractiveTaskMetrics) {
+                priority = TaskPriority::kInteractive;
+            } else if (global_var == GlobalVariable::kBatchTaskMetrics) {
+                priority = TaskPriority::kBatch;
+            }
+            Value value = Value::MakeVarchar(query_context->scheduler()->GetTaskQueueMetrics(priority).ToString());
+            ValueExpression value_expr(value);
+            value_expr.AppendToChunk(output_block_ptr->column_vectors[0]);
+            break;
+        }
         case GlobalVariable::kSystemMemoryUsage: {
             Vector<SharedPtr<ColumnDef>> output_column_defs = {
                 MakeShared<ColumnDef>(0, integer_type, "value", std::set<ConstraintType>()),
@@ -5008,6 +5100,35 @@ void PhysicalShow::ExecuteShowGlobalVariables(QueryContext *query_context, ShowO
                 }
                 break;
             }
+            case GlobalVariable::kInteractiveTaskMetrics:
+            case GlobalVariable::kBatchTaskMetrics:
+            case GlobalVariable::kBackgroundTaskMetrics: {
+                TaskPriority priority = TaskPriority::kBackground;
+                if (global_var_enum == GlobalVariable::kInteractiveTaskMetrics) {
+                    priority = TaskPriority::kInteractive;
+                } else if (global_var_enum == GlobalVariable::kBatchTaskMetrics) {
+                    priority = TaskPriority::kBatch;
+                }
+                {
+                    // option name
+                    Value value = Value::MakeVarchar(var_name);
+                    ValueExpression value_expr(value);
+                    value_expr.AppendToChunk(output_block_ptr->column_vectors[0]);
+                }
+                {
+                    // option value
+                    Value value = Value::MakeVarchar(query_context->scheduler()->GetTaskQueueMetrics(priority).ToString());
+                    ValueExpression value_expr(value);
+                    value_expr.AppendToChunk(output_block_ptr->column_vectors[1]);
+                }
+                {
+                    // option description
+                    Value value = Value::MakeVarchar(fmt::format("Queue time and concurrency of the {} tasks", TaskPriority2String(priority)));
+                    ValueExpression value_expr(value);
+                    value_expr.AppendToChunk(output_block_ptr->column_vectors[2]);
+                }
+                break;
+            }
             case GlobalVariable::kSystemMemoryUsage: {
                 {
                     // option name
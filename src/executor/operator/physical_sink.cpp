@@ -486,6 +486,10 @@ void PhysicalSink::FillSinkStateFromLastOperatorState(FragmentContext *fragment_
         LOG_TRACE("Task not completed");
         return;
     }
+    if (task_operator_state->operator_type_ == PhysicalOperatorType::kParallelAggregate) {
+        FillSinkStateFromParallelAggregate(queue_sink_state, task_operator_state);
+        return;
+    }
     SizeT output_data_block_count = task_operator_state->data_block_array_.size();
     if (output_data_block_count == 0) {
         auto fragment_data = MakeShared<FragmentData>(queue_sink_state->fragment_id_,
@@ -534,4 +538,40 @@ void PhysicalSink::FillSinkStateFromLastOperatorState(FragmentContext *fragment_
     task_operator_state->data_block_array_.clear();
 }
 
+void PhysicalSink::FillSinkStateFromParallelAggregate(QueueSinkState *queue_sink_state, OperatorState *task_operator_state) {
+    // Unlike other operators, the blocks are not broadcast. Each radix partition goes to exactly one task of the next fragment,
+    // so the same group is always merged by the same task.
+    auto *parallel_aggregate_state = static_cast<ParallelAggregateOperatorState *>(task_operator_state);
+    const auto &queues = queue_sink_state->fragment_data_queues_;
+    SizeT queue_count = queues.size();
+    Vector<Vector<SizeT>> queue_blocks(queue_count);
+    for (SizeT idx = 0; idx < parallel_aggregate_state->data_block_array_.size(); ++idx) {
+        queue_blocks[parallel_aggregate_state->partition_ids_[idx] % queue_count].push_back(idx);
+    }
+
+    for (SizeT queue_id = 0; queue_id < queue_count; ++queue_id) {
+        const Vector<SizeT> &block_ids = queue_blocks[queue_id];
+        if (block_ids.empty()) {
+            // Still tell the merge task that this producer is finished
+            auto fragment_data = MakeShared<FragmentData>(queue_sink_state->fragment_id_, nullptr, queue_sink_state->task_id_, 0, 1, true, false, 0);
+            queues[queue_id]->Enqueue(fragment_data);
+            continue;
+        }
+        queue_sink_state->sent_data_ = true;
+        for (SizeT idx = 0; idx < block_ids.size(); ++idx) {
+            auto fragment_data = MakeShared<FragmentData>(queue_sink_state->fragment_id_,
+                                                          std::move(parallel_aggregate_state->data_block_array_[block_ids[idx]]),
+                                                          queue_sink_state->task_id_,
+                                                          idx,
+                                                          block_ids.size(),
+                                                          true,
+                                                          false,
+                                                          0);
+            queues[queue_id]->Enqueue(fragment_data);
+        }
+    }
+    parallel_aggregate_state->data_block_array_.clear();
+    parallel_aggregate_state->partition_ids_.clear();
+}
+
 } // namespace infinity
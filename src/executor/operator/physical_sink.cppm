@@ -76,6 +76,8 @@ private:
 
     void FillSinkStateFromLastOperatorState(FragmentContext *fragment_context, QueueSinkState *queue_sink_state, OperatorState *task_operator_state);
 
+    void FillSinkStateFromParallelAggregate(QueueSinkState *queue_sink_state, OperatorState *task_operator_state);
+
 private:
     SharedPtr<Vector<String>> output_names_{};
     SharedPtr<Vector<SharedPtr<DataType>>> output_types_{};
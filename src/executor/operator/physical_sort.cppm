@@ -28,10 +28,10 @@ import data_table;
 import data_block;
 import load_meta;
 import infinity_exception;
-import physical_top;
 import internal_types;
 import select_statement;
 import data_type;
+import external_sort;
 
 namespace infinity {
 
@@ -64,8 +64,11 @@ public:
     Vector<OrderType> order_by_types_{};
 
 private:
+    // Sort the buffered input blocks into a new sorted run.
+    UniquePtr<SortedRun> SortInputBlocks(SortOperatorState *sort_operator_state) const;
+
     u64 input_table_index_{};
-    CompareTwoRowAndPreferLeft prefer_left_function_; // compare function
+    SortKeyEncoder key_encoder_{};
 };
 
 } // namespace infinity
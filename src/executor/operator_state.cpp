@@ -159,6 +159,22 @@ bool QueueSourceState::GetData() {
             }
             break;
         }
+        case PhysicalOperatorType::kJoinHash: {
+            auto *hash_join_op_state = static_cast<HashJoinOperatorState *>(next_op_state);
+            if (fragment_data_base->type_ == FragmentDataType::kData) {
+                auto *fragment_data = static_cast<FragmentData *>(fragment_data_base.get());
+                if (fragment_data->data_block_) {
+                    if (fragment_data->fragment_id_ == hash_join_op_state->build_fragment_id_) {
+                        hash_join_op_state->build_data_blocks_.push_back(std::move(fragment_data->data_block_));
+                    } else {
+                        hash_join_op_state->probe_data_blocks_.push_back(std::move(fragment_data->data_block_));
+                    }
+                }
+            }
+            hash_join_op_state->build_complete_ = !num_tasks_.contains(hash_join_op_state->build_fragment_id_);
+            hash_join_op_state->input_complete_ = completed;
+            break;
+        }
         case PhysicalOperatorType::kMergeAggregate: {
             auto *fragment_data = static_cast<FragmentData *>(fragment_data_base.get());
             MergeAggregateOperatorState *merge_aggregate_op_state = (MergeAggregateOperatorState *)next_op_state;
@@ -187,6 +203,33 @@ bool QueueSourceState::GetData() {
             merge_aggregate_op_state->input_complete_ = completed;
             break;
         }
+        case PhysicalOperatorType::kMergeSort: {
+            auto *merge_sort_op_state = static_cast<MergeSortOperatorState *>(next_op_state);
+            if (fragment_data_base->type_ == FragmentDataType::kData) {
+                auto *fragment_data = static_cast<FragmentData *>(fragment_data_base.get());
+                // Blocks of one task arrive in order, each task forms a sorted run.
+                auto &input_run = merge_sort_op_state->input_runs_[fragment_data->task_id_];
+                if (input_run.get() == nullptr) {
+                    input_run = MakeUnique<SortedRun>();
+                }
+                if (fragment_data->data_block_) {
+                    input_run->Append(std::move(fragment_data->data_block_));
+                }
+            }
+            merge_sort_op_state->input_complete_ = completed;
+            break;
+        }
+        case PhysicalOperatorType::kMergeParallelAggregate: {
+            auto *merge_parallel_aggregate_op_state = static_cast<MergeParallelAggregateOperatorState *>(next_op_state);
+            if (fragment_data_base->type_ == FragmentDataType::kData) {
+                auto *fragment_data = static_cast<FragmentData *>(fragment_data_base.get());
+                if (fragment_data->data_block_) {
+                    merge_parallel_aggregate_op_state->input_data_blocks_.push_back(std::move(fragment_data->data_block_));
+                }
+            }
+            merge_parallel_aggregate_op_state->input_complete_ = completed;
+            break;
+        }
         default: {
             String error_message = "Not support operator type";
             UnrecoverableError(error_message);
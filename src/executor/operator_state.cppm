@@ -38,6 +38,8 @@ import column_def;
 import data_type;
 import segment_entry;
 import hash_table;
+import join_hash_table;
+import external_sort;
 
 namespace infinity {
 
@@ -75,7 +77,9 @@ export struct AggregateOperatorState : public OperatorState {
         : OperatorState(PhysicalOperatorType::kAggregate), states_(std::move(states)) {}
 
     Vector<UniquePtr<char[]>> states_;
-    HashTable hash_table_;
+    GroupByHashTable hash_table_;
+    // Offset of each aggregate state in the payload of a group
+    Vector<SizeT> state_offsets_;
 };
 
 // Merge Aggregate
@@ -85,18 +89,29 @@ export struct MergeAggregateOperatorState : public OperatorState {
     /// Since merge agg is the first op, no previous operator state. This ptr is to get input data.
     // Vector<UniquePtr<DataBlock>> input_data_blocks_{nullptr};
     UniquePtr<DataBlock> input_data_block_{nullptr};
-    MergeHashTable hash_table_;
+    GroupByHashTable hash_table_;
     bool input_complete_{false};
 };
 
 // Merge Parallel Aggregate
 export struct MergeParallelAggregateOperatorState : public OperatorState {
     inline explicit MergeParallelAggregateOperatorState() : OperatorState(PhysicalOperatorType::kMergeParallelAggregate) {}
+
+    // Partial aggregate blocks of the partitions assigned to this task
+    Vector<UniquePtr<DataBlock>> input_data_blocks_{};
+    bool input_complete_{false};
+    GroupByHashTable hash_table_;
+    Vector<SizeT> state_offsets_;
 };
 
 // Parallel Aggregate
 export struct ParallelAggregateOperatorState : public OperatorState {
     inline explicit ParallelAggregateOperatorState() : OperatorState(PhysicalOperatorType::kParallelAggregate) {}
+
+    GroupByHashTable hash_table_;
+    Vector<SizeT> state_offsets_;
+    // Radix partition of each block in data_block_array_
+    Vector<SizeT> partition_ids_;
 };
 
 // UnionAll
@@ -186,7 +201,19 @@ export struct MergeHashOperatorState : public OperatorState {
 
 // Hash Join
 export struct HashJoinOperatorState : public OperatorState {
-    inline explicit HashJoinOperatorState() : OperatorState(PhysicalOperatorType::kJoinHash) {}
+    inline explicit HashJoinOperatorState(u64 build_fragment_id)
+        : OperatorState(PhysicalOperatorType::kJoinHash), build_fragment_id_(build_fragment_id) {}
+
+    // Hash join is the first op, no previous operator state. The queue source dispatches the input blocks by fragment id.
+    u64 build_fragment_id_{};
+    Vector<UniquePtr<DataBlock>> build_data_blocks_{};
+    Vector<UniquePtr<DataBlock>> probe_data_blocks_{};
+    bool build_complete_{false};
+    bool input_complete_{false};
+    UniquePtr<JoinHashTable> hash_table_{};
+    // RIGHT / FULL join only: whether each build entry has been matched by a probe row
+    Vector<bool> build_matched_{};
+    Vector<SharedPtr<ExpressionState>> residual_states_{}; // states of the residual conditions
 };
 
 // Nested Loop
@@ -247,12 +274,20 @@ export struct ProjectionOperatorState : public OperatorState {
 export struct SortOperatorState : public OperatorState {
     inline explicit SortOperatorState() : OperatorState(PhysicalOperatorType::kSort) {}
     Vector<SharedPtr<ExpressionState>> expr_states_; // expression states
-    Vector<UniquePtr<DataBlock>> unmerge_sorted_blocks_{};
+    // Input blocks buffered since the last spill, and their sort keys
+    Vector<UniquePtr<DataBlock>> input_blocks_{};
+    Vector<SortKeys> input_keys_{};
+    SizeT input_size_{};
+    Vector<UniquePtr<SortedRun>> sorted_runs_{};
 };
 
 // Merge Sort
 export struct MergeSortOperatorState : public OperatorState {
     inline explicit MergeSortOperatorState() : OperatorState(PhysicalOperatorType::kMergeSort) {}
+    Vector<SharedPtr<ExpressionState>> expr_states_; // expression states
+    // Sorted output of each sort task, keyed by the task id
+    Map<i64, UniquePtr<SortedRun>> input_runs_{};
+    bool input_complete_{false};
 };
 
 // Delete
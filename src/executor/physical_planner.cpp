@@ -59,7 +59,6 @@ import physical_merge_top;
 import physical_merge_match_tensor;
 import physical_merge_match_sparse;
 import physical_merge_match_sparse;
-import physical_nested_loop_join;
 import physical_parallel_aggregate;
 import physical_prepared_plan;
 import physical_project;
@@ -136,6 +135,7 @@ import logical_unnest;
 import logical_unnest_aggregate;
 
 import value;
+import base_expression;
 import value_expression;
 import match_tensor_expression;
 import match_sparse_expression;
@@ -148,8 +148,11 @@ import command_statement;
 import explain_statement;
 import alter_statement;
 import load_meta;
+import join_reference;
 import block_index;
 import logger;
+import utility;
+import logical_type;
 
 namespace infinity {
 
@@ -630,6 +633,23 @@ UniquePtr<PhysicalOperator> PhysicalPlanner::BuildAlter(const SharedPtr<LogicalN
     return {};
 }
 
+namespace {
+
+bool UseParallelAggregate(const LogicalAggregate &logical_aggregate, u64 cpu_number_limit) {
+    if (logical_aggregate.groups_.empty() || cpu_number_limit <= 1) {
+        return false;
+    }
+    // Partial states are shipped between the tasks by value, varchar state may refer to the memory of the input block.
+    for (const auto &expr : logical_aggregate.aggregates_) {
+        if (expr->arguments().empty() || expr->arguments()[0]->Type().type() == LogicalType::kVarchar) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
 UniquePtr<PhysicalOperator> PhysicalPlanner::BuildAggregate(const SharedPtr<LogicalNode> &logical_operator) const {
     auto input_logical_node = logical_operator->left_node();
     if (logical_operator->right_node().get() != nullptr) {
@@ -644,6 +664,23 @@ UniquePtr<PhysicalOperator> PhysicalPlanner::BuildAggregate(const SharedPtr<Logi
 
     SizeT tasklet_count = input_physical_operator->TaskletCount();
 
+    if (tasklet_count > 1 && UseParallelAggregate(*logical_aggregate, query_context_ptr_->cpu_number_limit())) {
+        // Two phase aggregate: partial aggregate in the scan tasks, then merge the radix partitions in parallel.
+        SizeT partition_count = Utility::NextPowerOfTwo(query_context_ptr_->cpu_number_limit());
+        auto parallel_agg_op = MakeUnique<PhysicalParallelAggregate>(logical_aggregate->node_id(),
+                                                                     std::move(input_physical_operator),
+                                                                     logical_aggregate->groups_,
+                                                                     logical_aggregate->aggregates_,
+                                                                     partition_count,
+                                                                     logical_operator->load_metas());
+        return MakeUnique<PhysicalMergeParallelAggregate>(query_context_ptr_->GetNextNodeID(),
+                                                          std::move(parallel_agg_op),
+                                                          logical_aggregate->aggregates_,
+                                                          logical_aggregate->GetOutputNames(),
+                                                          logical_aggregate->GetOutputTypes(),
+                                                          MakeShared<Vector<LoadMeta>>());
+    }
+
     auto physical_agg_op = MakeUnique<PhysicalAggregate>(logical_aggregate->node_id(),
                                                          std::move(input_physical_operator),
                                                          logical_aggregate->groups_,
@@ -686,12 +723,46 @@ UniquePtr<PhysicalOperator> PhysicalPlanner::BuildJoin(const SharedPtr<LogicalNo
     left_physical_operator = BuildPhysicalOperator(left_node);
     right_physical_operator = BuildPhysicalOperator(right_node);
 
-    return MakeUnique<PhysicalNestedLoopJoin>(logical_operator->node_id(),
-                                              logical_join->join_type_,
-                                              logical_join->conditions_,
-                                              std::move(left_physical_operator),
-                                              std::move(right_physical_operator),
-                                              logical_operator->load_metas());
+    if (!PhysicalHashJoin::SupportJoinType(logical_join->join_type_)) {
+        Status status = Status::NotSupport(JoinReference::ToString(logical_join->join_type_));
+        RecoverableError(status);
+    }
+    Vector<SizeT> probe_key_ids;
+    Vector<SizeT> build_key_ids;
+    Vector<SharedPtr<BaseExpression>> residual_conditions;
+    PhysicalHashJoin::ExtractEquiKeys(logical_join->conditions_,
+                                      *left_physical_operator->GetOutputTypes(),
+                                      *right_physical_operator->GetOutputTypes(),
+                                      probe_key_ids,
+                                      build_key_ids,
+                                      residual_conditions);
+    if (probe_key_ids.empty()) {
+        // The nested loop join isn't executable, a join without any equi key is rejected here instead of returning nothing.
+        Status status = Status::NotSupport(fmt::format("{} without equal condition on columns of the same type",
+                                                       JoinReference::ToString(logical_join->join_type_)));
+        RecoverableError(status);
+    }
+
+    // Right side is the build side. Keys of both sides are hashed in the child fragments.
+    auto probe_hash = MakeUnique<PhysicalHash>(query_context_ptr_->GetNextNodeID(),
+                                               std::move(left_physical_operator),
+                                               probe_key_ids,
+                                               MakeShared<Vector<LoadMeta>>());
+    auto build_hash = MakeUnique<PhysicalHash>(query_context_ptr_->GetNextNodeID(),
+                                               std::move(right_physical_operator),
+                                               build_key_ids,
+                                               MakeShared<Vector<LoadMeta>>());
+    return MakeUnique<PhysicalHashJoin>(logical_operator->node_id(),
+                                        logical_join->join_type_,
+                                        logical_join->conditions_,
+                                        std::move(probe_key_ids),
+                                        std::move(build_key_ids),
+                                        std::move(residual_conditions),
+                                        std::move(probe_hash),
+                                        std::move(build_hash),
+                                        logical_join->GetOutputNames(),
+                                        logical_join->GetOutputTypes(),
+                                        logical_operator->load_metas());
 }
 
 UniquePtr<PhysicalOperator> PhysicalPlanner::BuildCrossProduct(const SharedPtr<LogicalNode> &logical_operator) const {
@@ -738,11 +809,24 @@ UniquePtr<PhysicalOperator> PhysicalPlanner::BuildSort(const SharedPtr<LogicalNo
 
     SharedPtr<LogicalSort> logical_sort = static_pointer_cast<LogicalSort>(logical_operator);
 
-    return MakeUnique<PhysicalSort>(logical_operator->node_id(),
-                                    std::move(input_physical_operator),
-                                    logical_sort->expressions_,
-                                    logical_sort->order_by_types_,
-                                    logical_operator->load_metas());
+    if (input_physical_operator->TaskletCount() <= 1) {
+        return MakeUnique<PhysicalSort>(logical_operator->node_id(),
+                                        std::move(input_physical_operator),
+                                        logical_sort->expressions_,
+                                        logical_sort->order_by_types_,
+                                        logical_operator->load_metas());
+    }
+    // Each task sorts its part of the input, then MergeSort merges the sorted runs.
+    auto child_sort_op = MakeUnique<PhysicalSort>(logical_operator->node_id(),
+                                                  std::move(input_physical_operator),
+                                                  logical_sort->expressions_,
+                                                  logical_sort->order_by_types_,
+                                                  logical_operator->load_metas());
+    return MakeUnique<PhysicalMergeSort>(query_context_ptr_->GetNextNodeID(),
+                                         std::move(child_sort_op),
+                                         logical_sort->expressions_,
+                                         logical_sort->order_by_types_,
+                                         MakeShared<Vector<LoadMeta>>());
 }
 
 UniquePtr<PhysicalOperator> PhysicalPlanner::BuildLimit(const SharedPtr<LogicalNode> &logical_operator) const {
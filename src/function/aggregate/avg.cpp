@@ -54,6 +54,11 @@ public:
         RecoverableError(status);
     }
 
+    inline void Combine(const AvgState &) {
+        Status status = Status::NotSupport("Combine average state.");
+        RecoverableError(status);
+    }
+
     inline static SizeT Size(const DataType &data_type) {
         Status status = Status::NotSupport(fmt::format("Average state type size: {}", data_type.ToString()));
         RecoverableError(status);
@@ -91,6 +96,11 @@ public:
         return (ptr_t)&result_;
     }
 
+    inline void Combine(const AvgState &other) {
+        this->count_ += other.count_;
+        value_ += other.value_;
+    }
+
     inline static SizeT Size(const DataType &) { return sizeof(value_) + sizeof(count_) + sizeof(result_); }
 };
 
@@ -126,6 +136,11 @@ public:
         return (ptr_t)&result_;
     }
 
+    inline void Combine(const AvgState &other) {
+        this->count_ += other.count_;
+        value_ += other.value_;
+    }
+
     inline static SizeT Size(const DataType &) { return sizeof(value_) + sizeof(count_) + sizeof(result_); }
 };
 
@@ -161,6 +176,11 @@ public:
         return (ptr_t)&result_;
     }
 
+    inline void Combine(const AvgState &other) {
+        this->count_ += other.count_;
+        value_ += other.value_;
+    }
+
     inline static SizeT Size(const DataType &) { return sizeof(value_) + sizeof(count_) + sizeof(result_); }
 };
 
@@ -196,6 +216,11 @@ public:
         return (ptr_t)&result_;
     }
 
+    inline void Combine(const AvgState &other) {
+        this->count_ += other.count_;
+        value_ += other.value_;
+    }
+
     inline static SizeT Size(const DataType &) { return sizeof(value_) + sizeof(count_) + sizeof(result_); }
 };
 
@@ -231,6 +256,11 @@ public:
         return (ptr_t)&result_;
     }
 
+    inline void Combine(const AvgState &other) {
+        this->count_ += other.count_;
+        value_ += other.value_;
+    }
+
     inline static SizeT Size(const DataType &) { return sizeof(value_) + sizeof(count_) + sizeof(result_); }
 };
 
@@ -266,6 +296,11 @@ public:
         return (ptr_t)&result_;
     }
 
+    inline void Combine(const AvgState &other) {
+        this->count_ += other.count_;
+        value_ += other.value_;
+    }
+
     inline static SizeT Size(const DataType &) { return sizeof(value_) + sizeof(count_) + sizeof(result_); }
 };
 
@@ -301,6 +336,11 @@ public:
         return (ptr_t)&result_;
     }
 
+    inline void Combine(const AvgState &other) {
+        this->count_ += other.count_;
+        value_ += other.value_;
+    }
+
     inline static SizeT Size(const DataType &) { return sizeof(value_) + sizeof(count_) + sizeof(result_); }
 };
 
@@ -336,6 +376,11 @@ public:
         return (ptr_t)&result_;
     }
 
+    inline void Combine(const AvgState &other) {
+        this->count_ += other.count_;
+        value_ += other.value_;
+    }
+
     inline static SizeT Size(const DataType &) { return sizeof(value_) + sizeof(count_) + sizeof(result_); }
 };
 
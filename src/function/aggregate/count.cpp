@@ -42,6 +42,8 @@ public:
 
     inline ptr_t Finalize() { return (ptr_t)&count_; }
 
+    inline void Combine(const CountState &other) { count_ += other.count_; }
+
     inline static SizeT Size(const DataType &) { return sizeof(i64); }
 };
 
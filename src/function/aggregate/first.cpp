@@ -55,6 +55,14 @@ public:
 
     [[nodiscard]] inline ptr_t Finalize() const { return (ptr_t)&value_; }
 
+    inline void Combine(const FirstState &other) {
+        if (is_set_ || !other.is_set_)
+            return;
+
+        is_set_ = true;
+        value_ = other.value_;
+    }
+
     inline static SizeT Size(const DataType &) { return sizeof(FirstState<ValueType, ResultType>); }
 };
 
@@ -86,6 +94,14 @@ public:
 
     inline ptr_t Finalize() { return (ptr_t)&value_; }
 
+    inline void Combine(const FirstState &other) {
+        if (is_set_ || !other.is_set_)
+            return;
+
+        is_set_ = true;
+        value_ = other.value_;
+    }
+
     inline static SizeT Size(const DataType &) { return sizeof(FirstState<VarcharT, VarcharT>); }
 };
 //
@@ -56,6 +56,11 @@ public:
         UnrecoverableError(error_message);
     }
 
+    inline void Combine(const MaxState &) {
+        String error_message = "Not implement: MaxState::Combine";
+        UnrecoverableError(error_message);
+    }
+
     inline static SizeT Size(const DataType &) {
         String error_message = "Not implement: Max::Size";
         UnrecoverableError(error_message);
@@ -75,6 +80,8 @@ public:
 
     inline ptr_t Finalize() { return (ptr_t)&value_; }
 
+    inline void Combine(const MaxState &other) { value_ = other.value_ > value_ ? other.value_ : value_; }
+
     inline static SizeT Size(const DataType &) { return sizeof(BooleanT); }
 };
 
@@ -91,6 +98,8 @@ public:
 
     inline ptr_t Finalize() { return (ptr_t)&value_; }
 
+    inline void Combine(const MaxState &other) { value_ = other.value_ > value_ ? other.value_ : value_; }
+
     inline static SizeT Size(const DataType &) { return sizeof(TinyIntT); }
 };
 
@@ -107,6 +116,8 @@ public:
 
     inline ptr_t Finalize() { return (ptr_t)&value_; }
 
+    inline void Combine(const MaxState &other) { value_ = other.value_ > value_ ? other.value_ : value_; }
+
     inline static SizeT Size(const DataType &) { return sizeof(SmallIntT); }
 };
 
@@ -123,6 +134,8 @@ public:
 
     inline ptr_t Finalize() { return (ptr_t)&value_; }
 
+    inline void Combine(const MaxState &other) { value_ = other.value_ > value_ ? other.value_ : value_; }
+
     inline static SizeT Size(const DataType &) { return sizeof(IntegerT); }
 };
 
@@ -139,6 +152,8 @@ public:
 
     inline ptr_t Finalize() { return (ptr_t)&value_; }
 
+    inline void Combine(const MaxState &other) { value_ = other.value_ > value_ ? other.value_ : value_; }
+
     inline static SizeT Size(const DataType &) { return sizeof(BigIntT); }
 };
 
@@ -158,6 +173,8 @@ public:
 
     inline ptr_t Finalize() { return (ptr_t)&value_; }
 
+    inline void Combine(const MaxState &other) { value_ = other.value_ > value_ ? other.value_ : value_; }
+
     inline static SizeT Size(const DataType &) { return sizeof(HugeIntT); }
 };
 
@@ -174,6 +191,8 @@ public:
 
     inline ptr_t Finalize() { return (ptr_t)&value_; }
 
+    inline void Combine(const MaxState &other) { value_ = other.value_ > value_ ? other.value_ : value_; }
+
     inline static SizeT Size(const DataType &) { return sizeof(Float16T); }
 };
 
@@ -190,6 +209,8 @@ public:
 
     inline ptr_t Finalize() { return (ptr_t)&value_; }
 
+    inline void Combine(const MaxState &other) { value_ = other.value_ > value_ ? other.value_ : value_; }
+
     inline static SizeT Size(const DataType &) { return sizeof(BFloat16T); }
 };
 
@@ -206,6 +227,8 @@ public:
 
     inline ptr_t Finalize() { return (ptr_t)&value_; }
 
+    inline void Combine(const MaxState &other) { value_ = other.value_ > value_ ? other.value_ : value_; }
+
     inline static SizeT Size(const DataType &) { return sizeof(FloatT); }
 };
 
@@ -222,6 +245,8 @@ public:
 
     inline ptr_t Finalize() { return (ptr_t)&value_; }
 
+    inline void Combine(const MaxState &other) { value_ = other.value_ > value_ ? other.value_ : value_; }
+
     inline static SizeT Size(const DataType &) { return sizeof(DoubleT); }
 };
 
@@ -54,6 +54,11 @@ public:
         RecoverableError(status);
     }
 
+    inline void Combine(const SumState &) {
+        String error_message = "Not implement: SumState::Combine";
+        UnrecoverableError(error_message);
+    }
+
     inline static SizeT Size(const DataType &) {
         Status status = Status::NotSupport("Not implemented");
         RecoverableError(status);
@@ -73,6 +78,8 @@ public:
 
     inline ptr_t Finalize() { return (ptr_t)&sum_; }
 
+    inline void Combine(const SumState &other) { sum_ += other.sum_; }
+
     inline static SizeT Size(const DataType &) { return sizeof(i64); }
 };
 
@@ -89,6 +96,8 @@ public:
 
     inline ptr_t Finalize() { return (ptr_t)&sum_; }
 
+    inline void Combine(const SumState &other) { sum_ += other.sum_; }
+
     inline static SizeT Size(const DataType &) { return sizeof(i64); }
 };
 
@@ -105,6 +114,8 @@ public:
 
     inline ptr_t Finalize() { return (ptr_t)&sum_; }
 
+    inline void Combine(const SumState &other) { sum_ += other.sum_; }
+
     inline static SizeT Size(const DataType &) { return sizeof(i64); }
 };
 
@@ -121,6 +132,8 @@ public:
 
     inline ptr_t Finalize() { return (ptr_t)&sum_; }
 
+    inline void Combine(const SumState &other) { sum_ += other.sum_; }
+
     inline static SizeT Size(const DataType &) { return sizeof(i64); }
 };
 
@@ -137,6 +150,8 @@ public:
 
     inline ptr_t Finalize() { return (ptr_t)&sum_; }
 
+    inline void Combine(const SumState &other) { sum_ += other.sum_; }
+
     inline static SizeT Size(const DataType &) { return sizeof(DoubleT); }
 };
 
@@ -153,6 +168,8 @@ public:
 
     inline ptr_t Finalize() { return (ptr_t)&sum_; }
 
+    inline void Combine(const SumState &other) { sum_ += other.sum_; }
+
     inline static SizeT Size(const DataType &) { return sizeof(DoubleT); }
 };
 
@@ -169,6 +186,8 @@ public:
 
     inline ptr_t Finalize() { return (ptr_t)&sum_; }
 
+    inline void Combine(const SumState &other) { sum_ += other.sum_; }
+
     inline static SizeT Size(const DataType &) { return sizeof(DoubleT); }
 };
 
@@ -185,6 +204,8 @@ public:
 
     inline ptr_t Finalize() { return (ptr_t)&sum_; }
 
+    inline void Combine(const SumState &other) { sum_ += other.sum_; }
+
     inline static SizeT Size(const DataType &) { return sizeof(DoubleT); }
 };
 
@@ -34,6 +34,10 @@ namespace infinity {
 
 using AggregateInitializeFuncType = std::function<void(ptr_t)>;
 using AggregateUpdateFuncType = std::function<void(ptr_t, const SharedPtr<ColumnVector> &)>;
+// Update the state of each row: row i of the input column goes to states[i].
+using AggregateScatterUpdateFuncType = std::function<void(const ptr_t *, const SharedPtr<ColumnVector> &, SizeT)>;
+// Merge the partial state `source` into `target`, used by the two phase aggregate.
+using AggregateCombineFuncType = std::function<void(ptr_t, const_ptr_t)>;
 using AggregateFinalizeFuncType = std::function<ptr_t(ptr_t)>;
 
 class AggregateOperation {
@@ -98,6 +102,61 @@ public:
         }
     }
 
+    template <typename AggregateState, typename InputType>
+    static inline void StateScatterUpdate(const ptr_t *states, const SharedPtr<ColumnVector> &input_column_vector, SizeT row_count) {
+        switch (input_column_vector->vector_type()) {
+            case ColumnVectorType::kCompactBit: {
+                if constexpr (!std::is_same_v<InputType, BooleanT>) {
+                    String error_message = "kCompactBit column vector only support Boolean type";
+                    UnrecoverableError(error_message);
+                } else {
+                    BooleanT value;
+                    const VectorBuffer *buffer = input_column_vector->buffer_.get();
+                    for (SizeT idx = 0; idx < row_count; ++idx) {
+                        value = buffer->GetCompactBit(idx);
+                        ((AggregateState *)states[idx])->Update(&value, 0);
+                    }
+                }
+                break;
+            }
+            case ColumnVectorType::kFlat: {
+                auto *input_ptr = (InputType *)(input_column_vector->data());
+                for (SizeT idx = 0; idx < row_count; ++idx) {
+                    ((AggregateState *)states[idx])->Update(input_ptr, idx);
+                }
+                break;
+            }
+            case ColumnVectorType::kConstant: {
+                if (input_column_vector->data_type()->type() == LogicalType::kBoolean) {
+                    if constexpr (!std::is_same_v<InputType, BooleanT>) {
+                        String error_message = "types do not match";
+                        UnrecoverableError(error_message);
+                    } else {
+                        BooleanT value = input_column_vector->buffer_->GetCompactBit(0);
+                        for (SizeT idx = 0; idx < row_count; ++idx) {
+                            ((AggregateState *)states[idx])->Update(&value, 0);
+                        }
+                    }
+                    break;
+                }
+                auto *input_ptr = (InputType *)(input_column_vector->data());
+                for (SizeT idx = 0; idx < row_count; ++idx) {
+                    ((AggregateState *)states[idx])->Update(input_ptr, 0);
+                }
+                break;
+            }
+            default: {
+                String error_message = "Not implement: Other type";
+                UnrecoverableError(error_message);
+            }
+        }
+    }
+
+    template <typename AggregateState>
+    static inline void StateCombine(const ptr_t target, const_ptr_t source) {
+        ((AggregateState *)target)->Combine(*(const AggregateState *)source);
+    }
+
     template <typename AggregateState, typename ResultType>
     static inline ptr_t StateFinalize(const ptr_t state) {
         // Loop execute state update according to the input column vector
@@ -114,9 +173,11 @@ public:
                                SizeT state_size,
                                AggregateInitializeFuncType init_func,
                                AggregateUpdateFuncType update_func,
+                               AggregateScatterUpdateFuncType scatter_update_func,
+                               AggregateCombineFuncType combine_func,
                                AggregateFinalizeFuncType finalize_func)
         : Function(std::move(name), FunctionType::kAggregate), init_func_(std::move(init_func)), update_func_(std::move(update_func)),
-          finalize_func_(std::move(finalize_func)), argument_type_(std::move(argument_type)), return_type_(std::move(return_type)),
+          scatter_update_func_(std::move(scatter_update_func)), combine_func_(std::move(combine_func)), finalize_func_(std::move(finalize_func)), argument_type_(std::move(argument_type)), return_type_(std::move(return_type)),
           state_size_(state_size) {}
 
     void CastArgumentTypes(BaseExpression &input_argument);
@@ -132,6 +193,8 @@ public:
 public:
     AggregateInitializeFuncType init_func_;
     AggregateUpdateFuncType update_func_;
+    AggregateScatterUpdateFuncType scatter_update_func_;
+    AggregateCombineFuncType combine_func_;
     AggregateFinalizeFuncType finalize_func_;
 
     DataType argument_type_;
@@ -148,6 +211,8 @@ inline AggregateFunction UnaryAggregate(const String &name, const DataType &inpu
                              AggregateState::Size(input_type),
                              AggregateOperation::StateInitialize<AggregateState>,
                              AggregateOperation::StateUpdate<AggregateState, InputType>,
+                             AggregateOperation::StateScatterUpdate<AggregateState, InputType>,
+                             AggregateOperation::StateCombine<AggregateState>,
                              AggregateOperation::StateFinalize<AggregateState, ResultType>);
 }
 
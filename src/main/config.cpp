@@ -200,6 +200,60 @@ Status Config::Init(const SharedPtr<String> &config_path, DefaultConfig *default
             UnrecoverableError(status.message());
         }
 
+        // Interactive task weight
+        UniquePtr<IntegerOption> interactive_task_weight_option =
+            MakeUnique<IntegerOption>(INTERACTIVE_TASK_WEIGHT_OPTION_NAME, DEFAULT_INTERACTIVE_TASK_WEIGHT, MAX_TASK_WEIGHT, 1);
+        status = global_options_.AddOption(std::move(interactive_task_weight_option));
+        if (!status.ok()) {
+            fmt::print("Fatal: {}", status.message());
+            UnrecoverableError(status.message());
+        }
+
+        // Batch task weight
+        UniquePtr<IntegerOption> batch_task_weight_option =
+            MakeUnique<IntegerOption>(BATCH_TASK_WEIGHT_OPTION_NAME, DEFAULT_BATCH_TASK_WEIGHT, MAX_TASK_WEIGHT, 1);
+        status = global_options_.AddOption(std::move(batch_task_weight_option));
+        if (!status.ok()) {
+            fmt::print("Fatal: {}", status.message());
+            UnrecoverableError(status.message());
+        }
+
+        // Background task weight
+        UniquePtr<IntegerOption> background_task_weight_option =
+            MakeUnique<IntegerOption>(BACKGROUND_TASK_WEIGHT_OPTION_NAME, DEFAULT_BACKGROUND_TASK_WEIGHT, MAX_TASK_WEIGHT, 1);
+        status = global_options_.AddOption(std::move(background_task_weight_option));
+        if (!status.ok()) {
+            fmt::print("Fatal: {}", status.message());
+            UnrecoverableError(status.message());
+        }
+
+        // Interactive task worker percent
+        UniquePtr<IntegerOption> interactive_task_worker_percent_option =
+            MakeUnique<IntegerOption>(INTERACTIVE_TASK_WORKER_PERCENT_OPTION_NAME, DEFAULT_INTERACTIVE_TASK_WORKER_PERCENT, 100, 1);
+        status = global_options_.AddOption(std::move(interactive_task_worker_percent_option));
+        if (!status.ok()) {
+            fmt::print("Fatal: {}", status.message());
+            UnrecoverableError(status.message());
+        }
+
+        // Batch task worker percent
+        UniquePtr<IntegerOption> batch_task_worker_percent_option =
+            MakeUnique<IntegerOption>(BATCH_TASK_WORKER_PERCENT_OPTION_NAME, DEFAULT_BATCH_TASK_WORKER_PERCENT, 100, 1);
+        status = global_options_.AddOption(std::move(batch_task_worker_percent_option));
+        if (!status.ok()) {
+            fmt::print("Fatal: {}", status.message());
+            UnrecoverableError(status.message());
+        }
+
+        // Background task worker percent
+        UniquePtr<IntegerOption> background_task_worker_percent_option =
+            MakeUnique<IntegerOption>(BACKGROUND_TASK_WORKER_PERCENT_OPTION_NAME, DEFAULT_BACKGROUND_TASK_WORKER_PERCENT, 100, 1);
+        status = global_options_.AddOption(std::move(background_task_worker_percent_option));
+        if (!status.ok()) {
+            fmt::print("Fatal: {}", status.message());
+            UnrecoverableError(status.message());
+        }
+
         // Server address
         String server_address_str = "0.0.0.0";
         UniquePtr<StringOption> server_address_option = MakeUnique<StringOption>(SERVER_ADDRESS_OPTION_NAME, server_address_str);
@@ -533,6 +587,16 @@ Status Config::Init(const SharedPtr<String> &config_path, DefaultConfig *default
             UnrecoverableError(status.message());
         }
 
+        // Hnsw rebuild delete percent
+        i64 hnsw_rebuild_delete_percent = DEFAULT_HNSW_REBUILD_DELETE_PERCENT;
+        UniquePtr<IntegerOption> hnsw_rebuild_delete_percent_option =
+            MakeUnique<IntegerOption>(HNSW_REBUILD_DELETE_PERCENT_OPTION_NAME, hnsw_rebuild_delete_percent, 100, 0);
+        status = global_options_.AddOption(std::move(hnsw_rebuild_delete_percent_option));
+        if (!status.ok()) {
+            fmt::print("Fatal: {}", status.message());
+            UnrecoverableError(status.message());
+        }
+
         // Result Cache
         String result_cache(DEFAULT_RESULT_CACHE);
         auto result_cache_option = MakeUnique<StringOption>(RESULT_CACHE_OPTION_NAME, result_cache);
@@ -630,6 +694,15 @@ Status Config::Init(const SharedPtr<String> &config_path, DefaultConfig *default
             UnrecoverableError(status.message());
         }
 
+        // WAL Replay Thread Num
+        i64 wal_replay_thread_num = DEFAULT_WAL_REPLAY_THREAD_NUM;
+        UniquePtr<IntegerOption> wal_replay_thread_num_option =
+            MakeUnique<IntegerOption>(WAL_REPLAY_THREAD_NUM_OPTION_NAME, wal_replay_thread_num, MAX_WAL_REPLAY_THREAD_NUM, 1);
+        status = global_options_.AddOption(std::move(wal_replay_thread_num_option));
+        if (!status.ok()) {
+            UnrecoverableError(status.message());
+        }
+
         // Resource Dir
         String resource_dir = "/var/infinity/resource";
         if (default_config != nullptr) {
@@ -794,6 +867,129 @@ Status Config::Init(const SharedPtr<String> &config_path, DefaultConfig *default
                             }
                             break;
                         }
+                        case GlobalOptionIndex::kInteractiveTaskWeight: {
+                            // Interactive task weight
+                            i64 interactive_task_weight = DEFAULT_INTERACTIVE_TASK_WEIGHT;
+                            if (elem.second.is_integer()) {
+                                interactive_task_weight = elem.second.value_or(interactive_task_weight);
+                            } else {
+                                return Status::InvalidConfig("'interactive_task_weight' field isn't integer.");
+                            }
+                            UniquePtr<IntegerOption> interactive_task_weight_option =
+                                MakeUnique<IntegerOption>(INTERACTIVE_TASK_WEIGHT_OPTION_NAME, interactive_task_weight, MAX_TASK_WEIGHT, 1);
+                            if (!interactive_task_weight_option->Validate()) {
+                                return Status::InvalidConfig(fmt::format("Invalid interactive task weight: {}", interactive_task_weight));
+                            }
+                            Status status = global_options_.AddOption(std::move(interactive_task_weight_option));
+                            if (!status.ok()) {
+                                UnrecoverableError(status.message());
+                            }
+                            break;
+                        }
+                        case GlobalOptionIndex::kBatchTaskWeight: {
+                            // Batch task weight
+                            i64 batch_task_weight = DEFAULT_BATCH_TASK_WEIGHT;
+                            if (elem.second.is_integer()) {
+                                batch_task_weight = elem.second.value_or(batch_task_weight);
+                            } else {
+                                return Status::InvalidConfig("'batch_task_weight' field isn't integer.");
+                            }
+                            UniquePtr<IntegerOption> batch_task_weight_option =
+                                MakeUnique<IntegerOption>(BATCH_TASK_WEIGHT_OPTION_NAME, batch_task_weight, MAX_TASK_WEIGHT, 1);
+                            if (!batch_task_weight_option->Validate()) {
+                                return Status::InvalidConfig(fmt::format("Invalid batch task weight: {}", batch_task_weight));
+                            }
+                            Status status = global_options_.AddOption(std::move(batch_task_weight_option));
+                            if (!status.ok()) {
+                                UnrecoverableError(status.message());
+                            }
+                            break;
+                        }
+                        case GlobalOptionIndex::kBackgroundTaskWeight: {
+                            // Background task weight
+                            i64 background_task_weight = DEFAULT_BACKGROUND_TASK_WEIGHT;
+                            if (elem.second.is_integer()) {
+                                background_task_weight = elem.second.value_or(background_task_weight);
+                            } else {
+                                return Status::InvalidConfig("'background_task_weight' field isn't integer.");
+                            }
+                            UniquePtr<IntegerOption> background_task_weight_option =
+                                MakeUnique<IntegerOption>(BACKGROUND_TASK_WEIGHT_OPTION_NAME, background_task_weight, MAX_TASK_WEIGHT, 1);
+                            if (!background_task_weight_option->Validate()) {
+                                return Status::InvalidConfig(fmt::format("Invalid background task weight: {}", background_task_weight));
+                            }
+                            Status status = global_options_.AddOption(std::move(background_task_weight_option));
+                            if (!status.ok()) {
+                                UnrecoverableError(status.message());
+                            }
+                            break;
+                        }
+                        case GlobalOptionIndex::kInteractiveTaskWorkerPercent: {
+                            // Interactive task worker percent
+                            i64 interactive_task_worker_percent = DEFAULT_INTERACTIVE_TASK_WORKER_PERCENT;
+                            if (elem.second.is_integer()) {
+                                interactive_task_worker_percent = elem.second.value_or(interactive_task_worker_percent);
+                            } else {
+                                return Status::InvalidConfig("'interactive_task_worker_percent' field isn't integer.");
+                            }
+                            UniquePtr<IntegerOption> interactive_task_worker_percent_option =
+                                MakeUnique<IntegerOption>(INTERACTIVE_TASK_WORKER_PERCENT_OPTION_NAME,
+                                                          interactive_task_worker_percent,
+                                                          100,
+                                                          1);
+                            if (!interactive_task_worker_percent_option->Validate()) {
+                                return Status::InvalidConfig(fmt::format("Invalid interactive task worker percent: {}",
+                                                                         interactive_task_worker_percent));
+                            }
+                            Status status = global_options_.AddOption(std::move(interactive_task_worker_percent_option));
+                            if (!status.ok()) {
+                                UnrecoverableError(status.message());
+                            }
+                            break;
+                        }
+                        case GlobalOptionIndex::kBatchTaskWorkerPercent: {
+                            // Batch task worker percent
+                            i64 batch_task_worker_percent = DEFAULT_BATCH_TASK_WORKER_PERCENT;
+                            if (elem.second.is_integer()) {
+                                batch_task_worker_percent = elem.second.value_or(batch_task_worker_percent);
+                            } else {
+                                return Status::InvalidConfig("'batch_task_worker_percent' field isn't integer.");
+                            }
+                            UniquePtr<IntegerOption> batch_task_worker_percent_option =
+                                MakeUnique<IntegerOption>(BATCH_TASK_WORKER_PERCENT_OPTION_NAME, batch_task_worker_percent, 100, 1);
+                            if (!batch_task_worker_percent_option->Validate()) {
+                                return Status::InvalidConfig(fmt::format("Invalid batch task worker percent: {}",
+                                                                         batch_task_worker_percent));
+                            }
+                            Status status = global_options_.AddOption(std::move(batch_task_worker_percent_option));
+                            if (!status.ok()) {
+                                UnrecoverableError(status.message());
+                            }
+                            break;
+                        }
+                        case GlobalOptionIndex::kBackgroundTaskWorkerPercent: {
+                            // Background task worker percent
+                            i64 background_task_worker_percent = DEFAULT_BACKGROUND_TASK_WORKER_PERCENT;
+                            if (elem.second.is_integer()) {
+                                background_task_worker_percent = elem.second.value_or(background_task_worker_percent);
+                            } else {
+                                return Status::InvalidConfig("'background_task_worker_percent' field isn't integer.");
+                            }
+                            UniquePtr<IntegerOption> background_task_worker_percent_option =
+                                MakeUnique<IntegerOption>(BACKGROUND_TASK_WORKER_PERCENT_OPTION_NAME,
+                                                          background_task_worker_percent,
+                                                          100,
+                                                          1);
+                            if (!background_task_worker_percent_option->Validate()) {
+                                return Status::InvalidConfig(fmt::format("Invalid background task worker percent: {}",
+                                                                         background_task_worker_percent));
+                            }
+                            Status status = global_options_.AddOption(std::move(background_task_worker_percent_option));
+                            if (!status.ok()) {
+                                UnrecoverableError(status.message());
+                            }
+                            break;
+                        }
                         default: {
                             return Status::InvalidConfig(fmt::format("Unrecognized config parameter: {} in 'general' field", var_name));
                         }
@@ -852,6 +1048,72 @@ Status Config::Init(const SharedPtr<String> &config_path, DefaultConfig *default
                         UnrecoverableError(status.message());
                     }
                 }
+
+                if (global_options_.GetOptionByIndex(GlobalOptionIndex::kInteractiveTaskWeight) == nullptr) {
+                    // Interactive task weight
+                    UniquePtr<IntegerOption> interactive_task_weight_option =
+                        MakeUnique<IntegerOption>(INTERACTIVE_TASK_WEIGHT_OPTION_NAME, DEFAULT_INTERACTIVE_TASK_WEIGHT, MAX_TASK_WEIGHT, 1);
+                    Status status = global_options_.AddOption(std::move(interactive_task_weight_option));
+                    if (!status.ok()) {
+                        UnrecoverableError(status.message());
+                    }
+                }
+
+                if (global_options_.GetOptionByIndex(GlobalOptionIndex::kBatchTaskWeight) == nullptr) {
+                    // Batch task weight
+                    UniquePtr<IntegerOption> batch_task_weight_option =
+                        MakeUnique<IntegerOption>(BATCH_TASK_WEIGHT_OPTION_NAME, DEFAULT_BATCH_TASK_WEIGHT, MAX_TASK_WEIGHT, 1);
+                    Status status = global_options_.AddOption(std::move(batch_task_weight_option));
+                    if (!status.ok()) {
+                        UnrecoverableError(status.message());
+                    }
+                }
+
+                if (global_options_.GetOptionByIndex(GlobalOptionIndex::kBackgroundTaskWeight) == nullptr) {
+                    // Background task weight
+                    UniquePtr<IntegerOption> background_task_weight_option =
+                        MakeUnique<IntegerOption>(BACKGROUND_TASK_WEIGHT_OPTION_NAME, DEFAULT_BACKGROUND_TASK_WEIGHT, MAX_TASK_WEIGHT, 1);
+                    Status status = global_options_.AddOption(std::move(background_task_weight_option));
+                    if (!status.ok()) {
+                        UnrecoverableError(status.message());
+                    }
+                }
+
+                if (global_options_.GetOptionByIndex(GlobalOptionIndex::kInteractiveTaskWorkerPercent) == nullptr) {
+                    // Interactive task worker percent
+                    UniquePtr<IntegerOption> interactive_task_worker_percent_option =
+                        MakeUnique<IntegerOption>(INTERACTIVE_TASK_WORKER_PERCENT_OPTION_NAME,
+                                                  DEFAULT_INTERACTIVE_TASK_WORKER_PERCENT,
+                                                  100,
+                                                  1);
+                    Status status = global_options_.AddOption(std::move(interactive_task_worker_percent_option));
+                    if (!status.ok()) {
+                        UnrecoverableError(status.message());
+                    }
+                }
+
+                if (global_options_.GetOptionByIndex(GlobalOptionIndex::kBatchTaskWorkerPercent) == nullptr) {
+                    // Batch task worker percent
+                    UniquePtr<IntegerOption> batch_task_worker_percent_option =
+                        MakeUnique<IntegerOption>(BATCH_TASK_WORKER_PERCENT_OPTION_NAME, DEFAULT_BATCH_TASK_WORKER_PERCENT, 100, 1);
+                    Status status = global_options_.AddOption(std::move(batch_task_worker_percent_option));
+                    if (!status.ok()) {
+                        UnrecoverableError(status.message());
+                    }
+                }
+
+                if (global_options_.GetOptionByIndex(GlobalOptionIndex::kBackgroundTaskWorkerPercent) == nullptr) {
+                    // Background task worker percent
+                    UniquePtr<IntegerOption> background_task_worker_percent_option =
+                        MakeUnique<IntegerOption>(BACKGROUND_TASK_WORKER_PERCENT_OPTION_NAME,
+                                                  DEFAULT_BACKGROUND_TASK_WORKER_PERCENT,
+                                                  100,
+                                                  1);
+                    Status status = global_options_.AddOption(std::move(background_task_worker_percent_option));
+                    if (!status.ok()) {
+                        UnrecoverableError(status.message());
+                    }
+                }
             }
         }
 
@@ -1865,6 +2127,21 @@ Status Config::Init(const SharedPtr<String> &config_path, DefaultConfig *default
                             global_options_.AddOption(std::move(fulltext_index_building_worker_option));
                             break;
                         }
+                        case GlobalOptionIndex::kHnswRebuildDeletePercent: {
+                            i64 hnsw_rebuild_delete_percent = DEFAULT_HNSW_REBUILD_DELETE_PERCENT;
+                            if (elem.second.is_integer()) {
+                                hnsw_rebuild_delete_percent = elem.second.value_or(hnsw_rebuild_delete_percent);
+                            } else {
+                                return Status::InvalidConfig("'hnsw_rebuild_delete_percent' field isn't integer.");
+                            }
+                            UniquePtr<IntegerOption> hnsw_rebuild_delete_percent_option =
+                                MakeUnique<IntegerOption>(HNSW_REBUILD_DELETE_PERCENT_OPTION_NAME, hnsw_rebuild_delete_percent, 100, 0);
+                            if (!hnsw_rebuild_delete_percent_option->Validate()) {
+                                return Status::InvalidConfig(fmt::format("Invalid hnsw rebuild delete percent: {}", hnsw_rebuild_delete_percent));
+                            }
+                            global_options_.AddOption(std::move(hnsw_rebuild_delete_percent_option));
+                            break;
+                        }
                         default: {
                             return Status::InvalidConfig(fmt::format("Unrecognized config parameter: {} in 'storage' field", var_name));
                         }
@@ -2003,6 +2280,16 @@ Status Config::Init(const SharedPtr<String> &config_path, DefaultConfig *default
                         UnrecoverableError(status.message());
                     }
                 }
+                if (global_options_.GetOptionByIndex(GlobalOptionIndex::kHnswRebuildDeletePercent) == nullptr) {
+                    // hnsw rebuild delete percent
+                    i64 hnsw_rebuild_delete_percent = DEFAULT_HNSW_REBUILD_DELETE_PERCENT;
+                    UniquePtr<IntegerOption> hnsw_rebuild_delete_percent_option =
+                        MakeUnique<IntegerOption>(HNSW_REBUILD_DELETE_PERCENT_OPTION_NAME, hnsw_rebuild_delete_percent, 100, 0);
+                    Status status = global_options_.AddOption(std::move(hnsw_rebuild_delete_percent_option));
+                    if (!status.ok()) {
+                        UnrecoverableError(status.message());
+                    }
+                }
             } else {
                 return Status::InvalidConfig("No 'storage' section in configure file.");
             }
@@ -2329,9 +2616,9 @@ Status Config::Init(const SharedPtr<String> &config_path, DefaultConfig *default
                                 if (IsEqual(flush_option_str, "flush_at_once")) {
                                     flush_option_type = FlushOptionType::kFlushAtOnce;
                                 } else if (IsEqual(flush_option_str, "only_write")) {
-                                    flush_option_type = FlushOptionType::kFlushAtOnce;
+                                    flush_option_type = FlushOptionType::kOnlyWrite;
                                 } else if (IsEqual(flush_option_str, "flush_per_second")) {
-                                    flush_option_type = FlushOptionType::kFlushAtOnce;
+                                    flush_option_type = FlushOptionType::kFlushPerSecond;
                                 } else {
                                     return Status::InvalidConfig(fmt::format("Unsupported flush option: {}", flush_option_str));
                                 }
@@ -2346,6 +2633,27 @@ Status Config::Init(const SharedPtr<String> &config_path, DefaultConfig *default
                             }
                             break;
                         }
+                        case GlobalOptionIndex::kWALReplayThreadNum: {
+                            // WAL Replay Thread Num
+                            i64 wal_replay_thread_num = DEFAULT_WAL_REPLAY_THREAD_NUM;
+                            if (elem.second.is_integer()) {
+                                wal_replay_thread_num = elem.second.value_or(wal_replay_thread_num);
+                            } else {
+                                return Status::InvalidConfig("'wal_replay_thread_num' field isn't integer.");
+                            }
+                            UniquePtr<IntegerOption> wal_replay_thread_num_option = MakeUnique<IntegerOption>(WAL_REPLAY_THREAD_NUM_OPTION_NAME,
+                                                                                                              wal_replay_thread_num,
+                                                                                                              MAX_WAL_REPLAY_THREAD_NUM,
+                                                                                                              1);
+                            if (!wal_replay_thread_num_option->Validate()) {
+                                return Status::InvalidConfig(fmt::format("Invalid wal replay thread num: {}", wal_replay_thread_num));
+                            }
+                            Status status = global_options_.AddOption(std::move(wal_replay_thread_num_option));
+                            if (!status.ok()) {
+                                return status;
+                            }
+                            break;
+                        }
                         default: {
                             return Status::InvalidConfig(fmt::format("Unrecognized config parameter: {} in 'wal' field", var_name));
                         }
@@ -2423,6 +2731,17 @@ Status Config::Init(const SharedPtr<String> &config_path, DefaultConfig *default
                         UnrecoverableError(status.message());
                     }
                 }
+
+                if (global_options_.GetOptionByIndex(GlobalOptionIndex::kWALReplayThreadNum) == nullptr) {
+                    // WAL Replay Thread Num
+                    i64 wal_replay_thread_num = DEFAULT_WAL_REPLAY_THREAD_NUM;
+                    UniquePtr<IntegerOption> wal_replay_thread_num_option =
+                        MakeUnique<IntegerOption>(WAL_REPLAY_THREAD_NUM_OPTION_NAME, wal_replay_thread_num, MAX_WAL_REPLAY_THREAD_NUM, 1);
+                    Status status = global_options_.AddOption(std::move(wal_replay_thread_num_option));
+                    if (!status.ok()) {
+                        UnrecoverableError(status.message());
+                    }
+                }
             } else {
                 return Status::InvalidConfig("No 'wal' section in configure file.");
             }
@@ -2510,6 +2829,36 @@ i64 Config::CPULimit() {
     return global_options_.GetIntegerValue(GlobalOptionIndex::kWorkerCPULimit);
 }
 
+i64 Config::InteractiveTaskWeight() {
+    std::lock_guard<std::mutex> guard(mutex_);
+    return global_options_.GetIntegerValue(GlobalOptionIndex::kInteractiveTaskWeight);
+}
+
+i64 Config::BatchTaskWeight() {
+    std::lock_guard<std::mutex> guard(mutex_);
+    return global_options_.GetIntegerValue(GlobalOptionIndex::kBatchTaskWeight);
+}
+
+i64 Config::BackgroundTaskWeight() {
+    std::lock_guard<std::mutex> guard(mutex_);
+    return global_options_.GetIntegerValue(GlobalOptionIndex::kBackgroundTaskWeight);
+}
+
+i64 Config::InteractiveTaskWorkerPercent() {
+    std::lock_guard<std::mutex> guard(mutex_);
+    return global_options_.GetIntegerValue(GlobalOptionIndex::kInteractiveTaskWorkerPercent);
+}
+
+i64 Config::BatchTaskWorkerPercent() {
+    std::lock_guard<std::mutex> guard(mutex_);
+    return global_options_.GetIntegerValue(GlobalOptionIndex::kBatchTaskWorkerPercent);
+}
+
+i64 Config::BackgroundTaskWorkerPercent() {
+    std::lock_guard<std::mutex> guard(mutex_);
+    return global_options_.GetIntegerValue(GlobalOptionIndex::kBackgroundTaskWorkerPercent);
+}
+
 void Config::SetRecordRunningQuery(bool flag) {
     std::lock_guard<std::mutex> guard(mutex_);
     BaseOption *base_option = global_options_.GetOptionByIndex(GlobalOptionIndex::kRecordRunningQuery);
@@ -2736,6 +3085,11 @@ i64 Config::FulltextIndexBuildingWorker() {
     return global_options_.GetIntegerValue(GlobalOptionIndex::kFulltextIndexBuildingWorker);
 }
 
+i64 Config::HnswRebuildDeletePercent() {
+    std::lock_guard<std::mutex> guard(mutex_);
+    return global_options_.GetIntegerValue(GlobalOptionIndex::kHnswRebuildDeletePercent);
+}
+
 StorageType Config::StorageType() {
     std::lock_guard<std::mutex> guard(mutex_);
     String storage_type_str = global_options_.GetStringValue(GlobalOptionIndex::kStorageType);
@@ -2881,6 +3235,11 @@ FlushOptionType Config::FlushMethodAtCommit() {
     return flush_option->value_;
 }
 
+i64 Config::WALReplayThreadNum() {
+    std::lock_guard<std::mutex> guard(mutex_);
+    return global_options_.GetIntegerValue(GlobalOptionIndex::kWALReplayThreadNum);
+}
+
 // Resource
 String Config::ResourcePath() {
     std::lock_guard<std::mutex> guard(mutex_);
@@ -2933,6 +3292,12 @@ void Config::PrintAll() {
     fmt::print(" - version: {}\n", Version());
     fmt::print(" - timezone: {}{}\n", TimeZone(), TimeZoneBias());
     fmt::print(" - cpu_limit: {}\n", CPULimit());
+    fmt::print(" - interactive_task_weight: {}\n", InteractiveTaskWeight());
+    fmt::print(" - batch_task_weight: {}\n", BatchTaskWeight());
+    fmt::print(" - background_task_weight: {}\n", BackgroundTaskWeight());
+    fmt::print(" - interactive_task_worker_percent: {}\n", InteractiveTaskWorkerPercent());
+    fmt::print(" - batch_task_worker_percent: {}\n", BatchTaskWorkerPercent());
+    fmt::print(" - background_task_worker_percent: {}\n", BackgroundTaskWorkerPercent());
     fmt::print(" - server mode: {}\n", ServerMode());
 
     //    // Profiler
@@ -2969,6 +3334,7 @@ void Config::PrintAll() {
     fmt::print(" - dense_index_building_worker: {}\n", DenseIndexBuildingWorker());
     fmt::print(" - sparse_index_building_worker: {}\n", SparseIndexBuildingWorker());
     fmt::print(" - fulltext_index_building_worker: {}\n", FulltextIndexBuildingWorker());
+    fmt::print(" - hnsw_rebuild_delete_percent: {}\n", HnswRebuildDeletePercent());
     fmt::print(" - storage_type: {}\n", ToString(StorageType()));
     switch (StorageType()) {
         case StorageType::kLocal: {
@@ -3000,6 +3366,7 @@ void Config::PrintAll() {
     fmt::print(" - delta_checkpoint_interval: {}\n", Utility::FormatTimeInfo(DeltaCheckpointInterval()));
     fmt::print(" - delta_checkpoint_threshold: {}\n", Utility::FormatByteSize(DeltaCheckpointThreshold()));
     fmt::print(" - flush_method_at_commit: {}\n", FlushOptionTypeToString(FlushMethodAtCommit()));
+    fmt::print(" - wal_replay_thread_num: {}\n", WALReplayThreadNum());
 
     // Resource dir
     fmt::print(" - resource_dir: {}\n", ResourcePath());
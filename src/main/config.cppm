@@ -59,6 +59,12 @@ public:
 
     void SetCPULimit(i64 new_cpu_limit);
     i64 CPULimit();
+    i64 InteractiveTaskWeight();
+    i64 BatchTaskWeight();
+    i64 BackgroundTaskWeight();
+    i64 InteractiveTaskWorkerPercent();
+    i64 BatchTaskWorkerPercent();
+    i64 BackgroundTaskWorkerPercent();
     inline bool RecordRunningQuery() { return record_running_query_; }
     void SetRecordRunningQuery(bool flag);
 
@@ -109,6 +115,7 @@ public:
     i64 DenseIndexBuildingWorker();
     i64 SparseIndexBuildingWorker();
     i64 FulltextIndexBuildingWorker();
+    i64 HnswRebuildDeletePercent();
 
     StorageType StorageType();
     String ObjectStorageUrl();
@@ -147,6 +154,8 @@ public:
 
     FlushOptionType FlushMethodAtCommit();
 
+    i64 WALReplayThreadNum();
+
     // Resource
     String ResourcePath();
 
@@ -496,7 +496,8 @@ void InfinityContext::UnInit() {
 
     //    inverting_thread_pool_.stop(true);
     //    commiting_thread_pool_.stop(true);
-    //    hnsw_build_thread_pool_.stop(true);
+    //    vector_index_build_thread_pool_.stop(true);
+    //    search_thread_pool_.stop(true);
 
     session_mgr_.reset();
     resource_manager_.reset();
@@ -508,14 +509,16 @@ void InfinityContext::SetIndexThreadPool() {
     LOG_TRACE("Set index thread pool.");
     inverting_thread_pool_.resize(config_->DenseIndexBuildingWorker());
     commiting_thread_pool_.resize(config_->SparseIndexBuildingWorker());
-    hnsw_build_thread_pool_.resize(config_->FulltextIndexBuildingWorker());
+    vector_index_build_thread_pool_.resize(config_->FulltextIndexBuildingWorker());
+    search_thread_pool_.resize(config_->CPULimit());
 }
 
 void InfinityContext::RestoreIndexThreadPoolToDefault() {
     LOG_TRACE("Restore index thread pool size to default.");
     inverting_thread_pool_.resize(config_->DenseIndexBuildingWorker());
     commiting_thread_pool_.resize(config_->SparseIndexBuildingWorker());
-    hnsw_build_thread_pool_.resize(config_->FulltextIndexBuildingWorker());
+    vector_index_build_thread_pool_.resize(config_->FulltextIndexBuildingWorker());
+    search_thread_pool_.resize(config_->CPULimit());
 }
 
 void InfinityContext::AddThriftServerFn(std::function<void()> start_func, std::function<void()> stop_func) {
@@ -50,7 +50,8 @@ public:
 
     [[nodiscard]] inline ThreadPool &GetFulltextInvertingThreadPool() { return inverting_thread_pool_; }
     [[nodiscard]] inline ThreadPool &GetFulltextCommitingThreadPool() { return commiting_thread_pool_; }
-    [[nodiscard]] inline ThreadPool &GetHnswBuildThreadPool() { return hnsw_build_thread_pool_; }
+    [[nodiscard]] inline ThreadPool &GetVectorIndexBuildThreadPool() { return vector_index_build_thread_pool_; }
+    [[nodiscard]] inline ThreadPool &GetSearchThreadPool() { return search_thread_pool_; }
 
     NodeRole GetServerRole() const;
 
@@ -93,8 +94,11 @@ private:
     ThreadPool inverting_thread_pool_{2};
     ThreadPool commiting_thread_pool_{2};
 
-    // For hnsw index
-    ThreadPool hnsw_build_thread_pool_{2};
+    // For vector index: hnsw graph build, ivf and emvb k-means training
+    ThreadPool vector_index_build_thread_pool_{2};
+
+    // For intra-query parallel search
+    ThreadPool search_thread_pool_{2};
 
     mutable std::mutex mutex_;
 
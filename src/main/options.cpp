@@ -81,6 +81,7 @@ GlobalOptions::GlobalOptions() {
     name2index_[String(DENSE_INDEX_BUILDING_WORKER_OPTION_NAME)] = GlobalOptionIndex::kDenseIndexBuildingWorker;
     name2index_[String(SPARSE_INDEX_BUILDING_WORKER_OPTION_NAME)] = GlobalOptionIndex::kSparseIndexBuildingWorker;
     name2index_[String(FULLTEXT_INDEX_BUILDING_WORKER_OPTION_NAME)] = GlobalOptionIndex::kFulltextIndexBuildingWorker;
+    name2index_[String(HNSW_REBUILD_DELETE_PERCENT_OPTION_NAME)] = GlobalOptionIndex::kHnswRebuildDeletePercent;
 
     name2index_[String(RESULT_CACHE_OPTION_NAME)] = GlobalOptionIndex::kResultCache;
     name2index_[String(CACHE_RESULT_CAPACITY_OPTION_NAME)] = GlobalOptionIndex::kCacheResultCapacity;
@@ -92,10 +93,17 @@ GlobalOptions::GlobalOptions() {
     name2index_[String(DELTA_CHECKPOINT_INTERVAL_OPTION_NAME)] = GlobalOptionIndex::kDeltaCheckpointInterval;
     name2index_[String(DELTA_CHECKPOINT_THRESHOLD_OPTION_NAME)] = GlobalOptionIndex::kDeltaCheckpointThreshold;
     name2index_[String(WAL_FLUSH_OPTION_NAME)] = GlobalOptionIndex::kFlushMethodAtCommit;
+    name2index_[String(WAL_REPLAY_THREAD_NUM_OPTION_NAME)] = GlobalOptionIndex::kWALReplayThreadNum;
     name2index_[String(RESOURCE_DIR_OPTION_NAME)] = GlobalOptionIndex::kResourcePath;
     name2index_[String(SNAPSHOT_DIR_OPTION_NAME)] = GlobalOptionIndex::kSnapshotDir;
 
     name2index_[String(RECORD_RUNNING_QUERY_OPTION_NAME)] = GlobalOptionIndex::kRecordRunningQuery;
+    name2index_[String(INTERACTIVE_TASK_WEIGHT_OPTION_NAME)] = GlobalOptionIndex::kInteractiveTaskWeight;
+    name2index_[String(BATCH_TASK_WEIGHT_OPTION_NAME)] = GlobalOptionIndex::kBatchTaskWeight;
+    name2index_[String(BACKGROUND_TASK_WEIGHT_OPTION_NAME)] = GlobalOptionIndex::kBackgroundTaskWeight;
+    name2index_[String(INTERACTIVE_TASK_WORKER_PERCENT_OPTION_NAME)] = GlobalOptionIndex::kInteractiveTaskWorkerPercent;
+    name2index_[String(BATCH_TASK_WORKER_PERCENT_OPTION_NAME)] = GlobalOptionIndex::kBatchTaskWorkerPercent;
+    name2index_[String(BACKGROUND_TASK_WORKER_PERCENT_OPTION_NAME)] = GlobalOptionIndex::kBackgroundTaskWorkerPercent;
 }
 
 Status GlobalOptions::AddOption(UniquePtr<BaseOption> option) {
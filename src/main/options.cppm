@@ -172,7 +172,15 @@ export enum class GlobalOptionIndex : i8 {
     kSparseIndexBuildingWorker = 54,
     kFulltextIndexBuildingWorker = 55,
     kSnapshotDir = 56,
-    kInvalid = 57,
+    kHnswRebuildDeletePercent = 57,
+    kWALReplayThreadNum = 58,
+    kInteractiveTaskWeight = 59,
+    kBatchTaskWeight = 60,
+    kBackgroundTaskWeight = 61,
+    kInteractiveTaskWorkerPercent = 62,
+    kBatchTaskWorkerPercent = 63,
+    kBackgroundTaskWorkerPercent = 64,
+    kInvalid = 65,
 };
 
 export struct GlobalOptions {
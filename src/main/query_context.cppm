@@ -31,6 +31,7 @@ import status;
 import query_result;
 import base_statement;
 import admin_statement;
+import task_priority;
 
 export module query_context;
 
@@ -126,6 +127,10 @@ public:
 
     [[nodiscard]] BaseSession *current_session() const { return session_ptr_; }
 
+    [[nodiscard]] inline TaskPriority task_priority() const { return task_priority_; }
+
+    inline void set_task_priority(TaskPriority task_priority) { task_priority_ = task_priority; }
+
     void FlushProfiler(TaskProfiler &&profiler) {
         if (query_profiler_) {
             query_profiler_->Flush(std::move(profiler));
@@ -172,6 +177,9 @@ private:
     u64 user_id_{0};
     u64 current_max_node_id_{0};
 
+    // Priority of the tasks of the current statement
+    TaskPriority task_priority_{TaskPriority::kInteractive};
+
     u64 cpu_number_limit_{};
     u64 memory_size_limit_{};
 
@@ -23,6 +23,7 @@ import options;
 import profiler;
 import catalog;
 import global_resource_usage;
+import task_priority;
 
 namespace infinity {
 
@@ -58,6 +59,11 @@ public:
 
     String ConnectedTimeToStr() const { return std::asctime(std::localtime(&connected_time_)); }
 
+    // kInvalid: the priority is decided by the statement type.
+    [[nodiscard]] TaskPriority query_priority() const { return query_priority_; }
+
+    void set_query_priority(TaskPriority query_priority) { query_priority_ = query_priority; }
+
 protected:
     std::time_t connected_time_;
 
@@ -75,6 +81,8 @@ protected:
 
     u64 committed_txn_count_{0};
     u64 rollbacked_txn_count_{0};
+
+    TaskPriority query_priority_{TaskPriority::kInvalid};
 };
 
 export class LocalSession : public BaseSession {
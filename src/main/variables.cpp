@@ -51,11 +51,15 @@ void VarUtil::InitVariablesMap() {
     global_name_map_[MEMORY_CACHE_MISS_VAR_NAME.data()] = GlobalVariable::kMemoryCacheMiss;
     global_name_map_[DISK_CACHE_MISS_VAR_NAME.data()] = GlobalVariable::kDiskCacheMiss;
     global_name_map_[ENABLE_PROFILE_VAR_NAME.data()] = GlobalVariable::kEnableProfile;
+    global_name_map_[INTERACTIVE_TASK_METRICS_VAR_NAME.data()] = GlobalVariable::kInteractiveTaskMetrics;
+    global_name_map_[BATCH_TASK_METRICS_VAR_NAME.data()] = GlobalVariable::kBatchTaskMetrics;
+    global_name_map_[BACKGROUND_TASK_METRICS_VAR_NAME.data()] = GlobalVariable::kBackgroundTaskMetrics;
 
     session_name_map_[QUERY_COUNT_VAR_NAME.data()] = SessionVariable::kQueryCount;
     session_name_map_[TOTAL_COMMIT_COUNT_VAR_NAME.data()] = SessionVariable::kTotalCommitCount;
     session_name_map_[TOTAL_ROLLBACK_COUNT_VAR_NAME.data()] = SessionVariable::kTotalRollbackCount;
     session_name_map_[CONNECTED_TS_VAR_NAME.data()] = SessionVariable::kConnectedTime;
+    session_name_map_[QUERY_PRIORITY_VAR_NAME.data()] = SessionVariable::kQueryPriority;
 }
 
 HashMap<String, GlobalVariable> VarUtil::global_name_map_;
@@ -52,6 +52,9 @@ export enum class GlobalVariable {
     kMemoryCacheMiss,         // global
     kDiskCacheMiss,           // global
     kEnableProfile,           // global
+    kInteractiveTaskMetrics,  // global
+    kBatchTaskMetrics,        // global
+    kBackgroundTaskMetrics,   // global
     kInvalid,
 };
 
@@ -60,6 +63,7 @@ export enum class SessionVariable {
     kTotalCommitCount,   // session
     kTotalRollbackCount, // session
     kConnectedTime,      // session
+    kQueryPriority,      // session
 
     kInvalid,
 };
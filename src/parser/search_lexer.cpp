@@ -464,20 +464,20 @@ static const YY_CHAR yy_ec[256] =
 
 static const YY_CHAR yy_meta[26] =
     {   0,
-        1,    1,    2,    3,    4,    5,    2,    2,    2,    3,
-        3,    2,    3,    3,    3,    3,    3,    3,    6,    2,
+        1,    1,    2,    3,    4,    5,    2,    2,    6,    3,
+        3,    2,    3,    3,    3,    3,    3,    3,    7,    2,
         2,    1,    3,    3,    3
     } ;
 
 static const flex_int16_t yy_base[64] =
     {   0,
-        0,    0,   20,   21,   23,   24,  116,  117,   28,   25,
-      117,  117,  117,  117,  117,   36,   17,   19,    0,   27,
-      104,   92,   91,   90,    0,  117,    0,    0,  117,    0,
-       43,   96,    0,   88,   87,   86,   38,   39,   92,   95,
-       52,   87,   59,   56,    0,  117,    0,  117,   62,   43,
-       45,   36,   19,   24,  117,   63,   69,   73,   78,   84,
-       88,   94,   99
+        0,    0,   20,   21,   23,   24,  124,  125,   28,   25,
+      125,  125,  125,  125,  125,   36,   17,   19,    0,   27,
+      112,  100,   99,   98,    0,  125,    0,    0,  125,    0,
+       43,  104,    0,   96,   95,   94,   38,   39,  100,   94,
+       52,   82,   62,   58,    0,  125,    0,  125,   64,   43,
+       45,   36,   19,   24,  125,   63,   70,   75,   81,   88,
+       94,  101,  107
     } ;
 
 static const flex_int16_t yy_def[64] =
@@ -491,27 +491,27 @@ static const flex_int16_t yy_def[64] =
        55,   55,   55
     } ;
 
-static const flex_int16_t yy_nxt[143] =
+static const flex_int16_t yy_nxt[151] =
     {   0,
-        8,    9,    9,   10,   11,   12,   13,   14,    8,   10,
+        8,    9,    9,   10,   11,   12,   13,   14,   10,   10,
        10,   15,   16,   10,   17,   18,   10,   10,   19,   20,
        21,    8,   22,   23,   24,   26,   26,   29,   29,   31,
        31,   32,   38,   32,   54,   39,   40,   41,   27,   27,
        32,   30,   30,   33,   31,   31,   54,   34,   35,   36,
        37,   49,   32,   32,   33,   51,   50,   32,   34,   35,
-       36,   52,   41,   25,   25,   25,   25,   25,   25,   28,
-       28,   28,   28,   28,   28,   32,   32,   53,   32,   32,
-       32,   32,   32,   32,   45,   45,   45,   45,   46,   46,
-       46,   46,   46,   46,   47,   47,   47,   42,   47,   48,
-
-       48,   48,   48,   48,   48,   51,   32,   44,   43,   32,
-       32,   44,   43,   32,   42,   55,    7,   55,   55,   55,
-       55,   55,   55,   55,   55,   55,   55,   55,   55,   55,
+       36,   52,   41,   25,   25,   25,   25,   25,   25,   25,
+       28,   28,   28,   28,   28,   28,   28,   32,   32,   53,
+       32,   32,   32,   32,   32,   32,   32,   32,   45,   45,
+       45,   45,   42,   45,   46,   46,   46,   46,   46,   46,
+
+       46,   47,   47,   47,   51,   47,   47,   48,   48,   48,
+       48,   48,   48,   48,   32,   44,   43,   32,   32,   44,
+       43,   32,   42,   55,    7,   55,   55,   55,   55,   55,
        55,   55,   55,   55,   55,   55,   55,   55,   55,   55,
-       55,   55
+       55,   55,   55,   55,   55,   55,   55,   55,   55,   55
     } ;
 
-static const flex_int16_t yy_chk[143] =
+static const flex_int16_t yy_chk[151] =
     {   0,
         1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
         1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
@@ -519,16 +519,16 @@ static const flex_int16_t yy_chk[143] =
         9,   17,   17,   18,   54,   18,   20,   20,    3,    4,
        53,    5,    6,   10,   31,   31,   52,   10,   10,   10,
        16,   37,   37,   38,   16,   51,   38,   50,   16,   16,
-       16,   41,   41,   56,   56,   56,   56,   56,   56,   57,
-       57,   57,   57,   57,   57,   58,   49,   44,   58,   59,
-       43,   59,   59,   59,   60,   60,   60,   60,   61,   61,
-       61,   61,   61,   61,   62,   62,   62,   42,   62,   63,
-
-       63,   63,   63,   63,   63,   40,   39,   36,   35,   34,
-       32,   24,   23,   22,   21,    7,   55,   55,   55,   55,
-       55,   55,   55,   55,   55,   55,   55,   55,   55,   55,
+       16,   41,   41,   56,   56,   56,   56,   56,   56,   56,
+       57,   57,   57,   57,   57,   57,   57,   58,   49,   44,
+       58,   58,   59,   43,   59,   59,   59,   59,   60,   60,
+       60,   60,   42,   60,   61,   61,   61,   61,   61,   61,
+
+       61,   62,   62,   62,   40,   62,   62,   63,   63,   63,
+       63,   63,   63,   63,   39,   36,   35,   34,   32,   24,
+       23,   22,   21,    7,   55,   55,   55,   55,   55,   55,
        55,   55,   55,   55,   55,   55,   55,   55,   55,   55,
-       55,   55
+       55,   55,   55,   55,   55,   55,   55,   55,   55,   55
     } ;
 
 static const flex_int16_t yy_rule_linenum[20] =
@@ -776,7 +776,7 @@ YY_DECL
 #line 60 "search_lexer.l"
             yylval = lval;
 
-            /* Note: special characters in pattern shall be double-quoted or escaped with backslash: ' ()^"~*?:\\' */
+            /* Note: special characters in pattern shall be double-quoted or escaped with backslash: ' ()^"~*?:\\', unescaped '*' and '?' are wildcards kept in STRING */
 
 
 #line 783 "search_lexer.cpp"
@@ -926,24 +926,32 @@ namespace infinity {
         error(yystack_[0].location, "default_field is empty");
         YYERROR;
     }
-    std::string text = SearchDriver::Unescape(yystack_[0].value.as < InfString > ().text_);
-    yylhs.value.as < std::unique_ptr<QueryNode> > () = driver.AnalyzeAndBuildQueryNode(field, text, yystack_[0].value.as < InfString > ().from_quoted_);
+    if (!yystack_[0].value.as < InfString > ().from_quoted_ && SearchDriver::HasWildcard(yystack_[0].value.as < InfString > ().text_)) {
+        yylhs.value.as < std::unique_ptr<QueryNode> > () = driver.BuildWildcardQueryNode(field, yystack_[0].value.as < InfString > ().text_);
+    } else {
+        std::string text = SearchDriver::Unescape(yystack_[0].value.as < InfString > ().text_);
+        yylhs.value.as < std::unique_ptr<QueryNode> > () = driver.AnalyzeAndBuildQueryNode(field, text, yystack_[0].value.as < InfString > ().from_quoted_);
+    }
 }
-#line 933 "search_parser.cpp"
+#line 937 "search_parser.cpp"
     break;
 
   case 15: // basic_filter: STRING OP_COLON STRING
-#line 172 "search_parser.y"
+#line 176 "search_parser.y"
                          {
     std::string field = SearchDriver::Unescape(yystack_[2].value.as < InfString > ().text_);
-    std::string text = SearchDriver::Unescape(yystack_[0].value.as < InfString > ().text_);
-    yylhs.value.as < std::unique_ptr<QueryNode> > () = driver.AnalyzeAndBuildQueryNode(field, text, yystack_[0].value.as < InfString > ().from_quoted_);
+    if (!yystack_[0].value.as < InfString > ().from_quoted_ && SearchDriver::HasWildcard(yystack_[0].value.as < InfString > ().text_)) {
+        yylhs.value.as < std::unique_ptr<QueryNode> > () = driver.BuildWildcardQueryNode(field, yystack_[0].value.as < InfString > ().text_);
+    } else {
+        std::string text = SearchDriver::Unescape(yystack_[0].value.as < InfString > ().text_);
+        yylhs.value.as < std::unique_ptr<QueryNode> > () = driver.AnalyzeAndBuildQueryNode(field, text, yystack_[0].value.as < InfString > ().from_quoted_);
+    }
 }
-#line 943 "search_parser.cpp"
+#line 951 "search_parser.cpp"
     break;
 
   case 16: // basic_filter: STRING TILDE
-#line 177 "search_parser.y"
+#line 185 "search_parser.y"
                {
     const std::string &field = default_field;
     if(field.empty()){
@@ -951,23 +959,31 @@ namespace infinity {
         YYERROR;
     }
     std::string text = SearchDriver::Unescape(yystack_[1].value.as < InfString > ().text_);
-    yylhs.value.as < std::unique_ptr<QueryNode> > () = driver.AnalyzeAndBuildQueryNode(field, text, yystack_[1].value.as < InfString > ().from_quoted_, yystack_[0].value.as < unsigned long > ());
+    if (yystack_[1].value.as < InfString > ().from_quoted_) {
+        yylhs.value.as < std::unique_ptr<QueryNode> > () = driver.AnalyzeAndBuildQueryNode(field, text, true, yystack_[0].value.as < unsigned long > ());
+    } else {
+        yylhs.value.as < std::unique_ptr<QueryNode> > () = driver.AnalyzeAndBuildFuzzyQueryNode(field, text, yystack_[0].value.as < unsigned long > ());
+    }
 }
-#line 957 "search_parser.cpp"
+#line 969 "search_parser.cpp"
     break;
 
   case 17: // basic_filter: STRING OP_COLON STRING TILDE
-#line 186 "search_parser.y"
+#line 198 "search_parser.y"
                                {
     std::string field = SearchDriver::Unescape(yystack_[3].value.as < InfString > ().text_);
     std::string text = SearchDriver::Unescape(yystack_[1].value.as < InfString > ().text_);
-    yylhs.value.as < std::unique_ptr<QueryNode> > () = driver.AnalyzeAndBuildQueryNode(field, text, yystack_[1].value.as < InfString > ().from_quoted_, yystack_[0].value.as < unsigned long > ());
+    if (yystack_[1].value.as < InfString > ().from_quoted_) {
+        yylhs.value.as < std::unique_ptr<QueryNode> > () = driver.AnalyzeAndBuildQueryNode(field, text, true, yystack_[0].value.as < unsigned long > ());
+    } else {
+        yylhs.value.as < std::unique_ptr<QueryNode> > () = driver.AnalyzeAndBuildFuzzyQueryNode(field, text, yystack_[0].value.as < unsigned long > ());
+    }
 }
-#line 967 "search_parser.cpp"
+#line 983 "search_parser.cpp"
     break;
 
 
-#line 971 "search_parser.cpp"
+#line 987 "search_parser.cpp"
 
             default:
               break;
@@ -1409,7 +1425,7 @@ namespace infinity {
   SearchParser::yyrline_[] =
   {
        0,    85,    85,    90,    91,   104,   118,   119,   133,   134,
-     143,   144,   152,   155,   163,   172,   177,   186
+     143,   144,   152,   155,   163,   176,   185,   198
   };
 
   void
@@ -1447,9 +1463,9 @@ namespace infinity {
 
 #line 10 "search_parser.y"
 } // infinity
-#line 1451 "search_parser.cpp"
+#line 1467 "search_parser.cpp"
 
-#line 192 "search_parser.y"
+#line 208 "search_parser.y"
 
 
 namespace infinity{
@@ -166,13 +166,21 @@ basic_filter
         error(@1, "default_field is empty");
         YYERROR;
     }
-    std::string text = SearchDriver::Unescape($1.text_);
-    $$ = driver.AnalyzeAndBuildQueryNode(field, text, $1.from_quoted_);
+    if (!$1.from_quoted_ && SearchDriver::HasWildcard($1.text_)) {
+        $$ = driver.BuildWildcardQueryNode(field, $1.text_);
+    } else {
+        std::string text = SearchDriver::Unescape($1.text_);
+        $$ = driver.AnalyzeAndBuildQueryNode(field, text, $1.from_quoted_);
+    }
 }
 | STRING OP_COLON STRING {
     std::string field = SearchDriver::Unescape($1.text_);
-    std::string text = SearchDriver::Unescape($3.text_);
-    $$ = driver.AnalyzeAndBuildQueryNode(field, text, $3.from_quoted_);
+    if (!$3.from_quoted_ && SearchDriver::HasWildcard($3.text_)) {
+        $$ = driver.BuildWildcardQueryNode(field, $3.text_);
+    } else {
+        std::string text = SearchDriver::Unescape($3.text_);
+        $$ = driver.AnalyzeAndBuildQueryNode(field, text, $3.from_quoted_);
+    }
 };
 | STRING TILDE {
     const std::string &field = default_field;
@@ -181,12 +189,20 @@ basic_filter
         YYERROR;
     }
     std::string text = SearchDriver::Unescape($1.text_);
-    $$ = driver.AnalyzeAndBuildQueryNode(field, text, $1.from_quoted_, $2);
+    if ($1.from_quoted_) {
+        $$ = driver.AnalyzeAndBuildQueryNode(field, text, true, $2);
+    } else {
+        $$ = driver.AnalyzeAndBuildFuzzyQueryNode(field, text, $2);
+    }
 }
 | STRING OP_COLON STRING TILDE {
     std::string field = SearchDriver::Unescape($1.text_);
     std::string text = SearchDriver::Unescape($3.text_);
-    $$ = driver.AnalyzeAndBuildQueryNode(field, text, $3.from_quoted_, $4);
+    if ($3.from_quoted_) {
+        $$ = driver.AnalyzeAndBuildQueryNode(field, text, true, $4);
+    } else {
+        $$ = driver.AnalyzeAndBuildFuzzyQueryNode(field, text, $4);
+    }
 };
 
 %%
@@ -238,6 +238,8 @@ SharedPtr<LogicalNode> BoundSelectStatement::BuildPlan(QueryContext *query_conte
                         match_node->early_term_algo_ = EarlyTermAlgo::kAuto;
                     } else if (iter->second == "true" || iter->second == "bmw") {
                         match_node->early_term_algo_ = EarlyTermAlgo::kBMW;
+                    } else if (iter->second == "maxscore") {
+                        match_node->early_term_algo_ = EarlyTermAlgo::kMaxScore;
                     } else if (iter->second == "batch") {
                         match_node->early_term_algo_ = EarlyTermAlgo::kBatch;
                     } else if (iter->second == "false") {
@@ -245,7 +247,7 @@ SharedPtr<LogicalNode> BoundSelectStatement::BuildPlan(QueryContext *query_conte
                     } else if (iter->second == "compare") {
                         match_node->early_term_algo_ = EarlyTermAlgo::kCompare;
                     } else {
-                        RecoverableError(Status::SyntaxError("block_max option must be empty, auto, bmw, true, batch, false, or compare"));
+                        RecoverableError(Status::SyntaxError("block_max option must be empty, auto, bmw, true, maxscore, batch, false, or compare"));
                     }
 
                     // option: top n
@@ -45,8 +45,11 @@ Vector<ColumnBinding> LogicalJoin::GetColumnBindings() const {
         result_binding.emplace_back(mark_index_, 0);
     }
     Vector<ColumnBinding> left_binding = this->left_node_->GetColumnBindings();
-    Vector<ColumnBinding> right_binding = this->right_node_->GetColumnBindings();
     result_binding.insert(result_binding.end(), left_binding.begin(), left_binding.end());
+    if (OutputLeftOnly()) {
+        return result_binding;
+    }
+    Vector<ColumnBinding> right_binding = this->right_node_->GetColumnBindings();
     result_binding.insert(result_binding.end(), right_binding.begin(), right_binding.end());
     return result_binding;
 }
@@ -59,6 +62,9 @@ SharedPtr<Vector<String>> LogicalJoin::GetOutputNames() const {
     for (auto &name_str : *left_output_names) {
         result->emplace_back(name_str);
     }
+    if (OutputLeftOnly()) {
+        return result;
+    }
 
     for (auto &name_str : *right_output_names) {
         result->emplace_back(name_str);
@@ -75,6 +81,9 @@ SharedPtr<Vector<SharedPtr<DataType>>> LogicalJoin::GetOutputTypes() const {
     for (auto &name_str : *left_output_names) {
         result->emplace_back(name_str);
     }
+    if (OutputLeftOnly()) {
+        return result;
+    }
 
     for (auto &name_str : *right_output_names) {
         result->emplace_back(name_str);
@@ -46,6 +46,9 @@ public:
 
     inline String name() final { return "LogicalJoin"; }
 
+    // SEMI / ANTI join output the left columns only.
+    inline bool OutputLeftOnly() const { return join_type_ == JoinType::kSemi || join_type_ == JoinType::kAnti; }
+
     String alias_{};
 
     u64 mark_index_{}; // Only for mark join
@@ -16,6 +16,7 @@ module;
 
 import logical_node;
 import logical_node_type;
+import logical_join;
 import stl;
 import base_expression;
 import column_expression;
@@ -61,7 +62,25 @@ void BindingRemapper::VisitNode(LogicalNode &op) {
             // skip
             return;
         }
-        case LogicalNodeType::kJoin:
+        case LogicalNodeType::kJoin: {
+            VisitNodeChildren(op);
+            if (static_cast<LogicalJoin &>(op).OutputLeftOnly()) {
+                // The conditions of SEMI / ANTI join see the columns of both sides, while the output only has the left ones.
+                bindings_ = op.left_node()->GetColumnBindings();
+                Vector<ColumnBinding> right_bindings = op.right_node()->GetColumnBindings();
+                bindings_.insert(bindings_.end(), right_bindings.begin(), right_bindings.end());
+                VisitNodeExpression(op);
+                bindings_ = op.GetColumnBindings();
+                output_types_ = op.GetOutputTypes();
+                load_func();
+                break;
+            }
+            bindings_ = op.GetColumnBindings();
+            output_types_ = op.GetOutputTypes();
+            load_func();
+            VisitNodeExpression(op);
+            break;
+        }
         case LogicalNodeType::kMatch:
         case LogicalNodeType::kMatchSparseScan:
         case LogicalNodeType::kMatchTensorScan:
@@ -495,10 +495,12 @@ private:
                         early_term_algo = EarlyTermAlgo::kNaive;
                     } else if (iter->second == "true" || iter->second == "bmw") {
                         early_term_algo = EarlyTermAlgo::kBMW;
+                    } else if (iter->second == "maxscore") {
+                        early_term_algo = EarlyTermAlgo::kMaxScore;
                     } else if (iter->second == "compare") {
                         early_term_algo = EarlyTermAlgo::kCompare;
                     } else {
-                        RecoverableError(Status::SyntaxError("block_max option must be empty, auto, batch, false, true, bmw, or compare"));
+                        RecoverableError(Status::SyntaxError("block_max option must be empty, auto, batch, false, true, bmw, maxscore, or compare"));
                     }
 
                     // option: top n
@@ -39,6 +39,7 @@ import physical_explain;
 import physical_create_index_prepare;
 import physical_create_index_do;
 import physical_sort;
+import physical_merge_sort;
 import physical_top;
 import physical_merge_top;
 import physical_match_tensor_scan;
@@ -59,6 +60,7 @@ import physical_sink;
 import data_table;
 import data_block;
 import physical_merge_knn;
+import physical_hash_join;
 import merge_knn_data;
 import create_index_data;
 import compact_state_data;
@@ -269,6 +271,17 @@ UniquePtr<OperatorState> MakeSortState(PhysicalOperator *physical_op) {
     return operator_state;
 }
 
+UniquePtr<OperatorState> MakeMergeSortState(PhysicalOperator *physical_op) {
+    auto operator_state = MakeUnique<MergeSortOperatorState>();
+    auto &expr_states = operator_state->expr_states_;
+    auto &sort_expressions = (static_cast<PhysicalMergeSort *>(physical_op))->GetSortExpressions();
+    expr_states.reserve(sort_expressions.size());
+    for (auto &expr : sort_expressions) {
+        expr_states.emplace_back(ExpressionState::CreateState(expr));
+    }
+    return operator_state;
+}
+
 UniquePtr<OperatorState> MakeTopState(PhysicalOperator *physical_op) {
     auto operator_state = MakeUnique<TopOperatorState>();
     auto &expr_states = operator_state->expr_states_;
@@ -291,6 +304,18 @@ UniquePtr<OperatorState> MakeMergeTopState(PhysicalOperator *physical_op) {
     return operator_state;
 }
 
+UniquePtr<OperatorState> MakeHashJoinState(PhysicalOperator *physical_op) {
+    auto *physical_hash_join = static_cast<PhysicalHashJoin *>(physical_op);
+    auto operator_state = MakeUnique<HashJoinOperatorState>(physical_hash_join->build_fragment_id());
+    auto &residual_states = operator_state->residual_states_;
+    auto &residual_conditions = physical_hash_join->residual_conditions();
+    residual_states.reserve(residual_conditions.size());
+    for (auto &condition : residual_conditions) {
+        residual_states.emplace_back(ExpressionState::CreateState(condition));
+    }
+    return operator_state;
+}
+
 UniquePtr<OperatorState>
 MakeTaskState(SizeT operator_id, const Vector<PhysicalOperator *> &physical_ops, FragmentTask *task, FragmentContext *fragment_ctx) {
     switch (physical_ops[operator_id]->operator_type()) {
@@ -361,6 +386,9 @@ MakeTaskState(SizeT operator_id, const Vector<PhysicalOperator *> &physical_ops,
         case PhysicalOperatorType::kMergeHash: {
             return MakeTaskStateTemplate<MergeHashOperatorState>(physical_ops[operator_id]);
         }
+        case PhysicalOperatorType::kJoinHash: {
+            return MakeHashJoinState(physical_ops[operator_id]);
+        }
         case PhysicalOperatorType::kLimit: {
             return MakeTaskStateTemplate<LimitOperatorState>(physical_ops[operator_id]);
         }
@@ -394,7 +422,7 @@ MakeTaskState(SizeT operator_id, const Vector<PhysicalOperator *> &physical_ops,
             return MakeSortState(physical_ops[operator_id]);
         }
         case PhysicalOperatorType::kMergeSort: {
-            return MakeTaskStateTemplate<MergeSortOperatorState>(physical_ops[operator_id]);
+            return MakeMergeSortState(physical_ops[operator_id]);
         }
         case PhysicalOperatorType::kDelete: {
             return MakeTaskStateTemplate<DeleteOperatorState>(physical_ops[operator_id]);
@@ -885,6 +913,22 @@ void FragmentContext::MakeSourceState(i64 parallel_count) {
                 fmt::format("{} shouldn't be the first operator of the fragment", PhysicalOperatorToString(first_operator->operator_type())));
             break;
         }
+        case PhysicalOperatorType::kMergeParallelAggregate: {
+            if (fragment_type_ != FragmentType::kParallelMaterialize && fragment_type_ != FragmentType::kSerialMaterialize) {
+                UnrecoverableError(
+                    fmt::format("{} should be materialized fragment", PhysicalOperatorToString(first_operator->operator_type())));
+            }
+
+            if ((i64)tasks_.size() != parallel_count) {
+                String error_message = fmt::format("{} task count isn't correct.", PhysicalOperatorToString(first_operator->operator_type()));
+                UnrecoverableError(error_message);
+            }
+
+            for (i64 task_id = 0; task_id < parallel_count; ++task_id) {
+                tasks_[task_id]->source_state_ = MakeUnique<QueueSourceState>();
+            }
+            break;
+        }
         case PhysicalOperatorType::kMergeAggregate:
         case PhysicalOperatorType::kMergeHash:
         case PhysicalOperatorType::kMergeLimit:
@@ -893,6 +937,7 @@ void FragmentContext::MakeSourceState(i64 parallel_count) {
         case PhysicalOperatorType::kMergeKnn:
         case PhysicalOperatorType::kMergeMatchTensor:
         case PhysicalOperatorType::kMergeMatchSparse:
+        case PhysicalOperatorType::kJoinHash:
         case PhysicalOperatorType::kFusion: {
             if (fragment_type_ != FragmentType::kSerialMaterialize) {
                 UnrecoverableError(
@@ -934,7 +979,6 @@ void FragmentContext::MakeSourceState(i64 parallel_count) {
         case PhysicalOperatorType::kIntersect:
         case PhysicalOperatorType::kExcept:
         case PhysicalOperatorType::kDummyScan:
-        case PhysicalOperatorType::kJoinHash:
         case PhysicalOperatorType::kJoinNestedLoop:
         case PhysicalOperatorType::kJoinMerge:
         case PhysicalOperatorType::kJoinIndex:
@@ -1074,7 +1118,7 @@ void FragmentContext::MakeSinkState(i64 parallel_count) {
             UnrecoverableError(error_message);
         }
         case PhysicalOperatorType::kAggregate: {
-            if (fragment_type_ != FragmentType::kParallelMaterialize) {
+            if (fragment_type_ != FragmentType::kParallelMaterialize && first_operator->operator_type() != PhysicalOperatorType::kJoinHash) {
                 String error_message = fmt::format("{} should in parallel stream fragment", PhysicalOperatorToString(last_operator->operator_type()));
                 UnrecoverableError(error_message);
             }
@@ -1091,10 +1135,22 @@ void FragmentContext::MakeSinkState(i64 parallel_count) {
             }
             break;
         }
-        case PhysicalOperatorType::kParallelAggregate:
         case PhysicalOperatorType::kHash: {
-            if (fragment_type_ != FragmentType::kParallelStream) {
-                String error_message = fmt::format("{} should in parallel stream fragment", PhysicalOperatorToString(last_operator->operator_type()));
+            // Hashed blocks are always sent to the hash join fragment
+            if ((i64)tasks_.size() != parallel_count) {
+                String error_message = fmt::format("{} task count isn't correct.", PhysicalOperatorToString(last_operator->operator_type()));
+                UnrecoverableError(error_message);
+            }
+
+            for (u64 task_id = 0; (i64)task_id < parallel_count; ++task_id) {
+                tasks_[task_id]->sink_state_ = MakeUnique<QueueSinkState>(plan_fragment_ptr_->FragmentID(), task_id);
+            }
+            break;
+        }
+        case PhysicalOperatorType::kParallelAggregate: {
+            // Partial aggregate of each partition is sent to the merge parallel aggregate fragment
+            if (fragment_type_ != FragmentType::kParallelMaterialize) {
+                String error_message = fmt::format("{} should in parallel materialized fragment", PhysicalOperatorToString(last_operator->operator_type()));
                 UnrecoverableError(error_message);
             }
 
@@ -1104,11 +1160,18 @@ void FragmentContext::MakeSinkState(i64 parallel_count) {
             }
 
             for (u64 task_id = 0; (i64)task_id < parallel_count; ++task_id) {
-                auto sink_state = MakeUnique<MaterializeSinkState>(plan_fragment_ptr_->FragmentID(), task_id);
-                sink_state->column_types_ = last_operator->GetOutputTypes();
-                sink_state->column_names_ = last_operator->GetOutputNames();
+                tasks_[task_id]->sink_state_ = MakeUnique<QueueSinkState>(plan_fragment_ptr_->FragmentID(), task_id);
+            }
+            break;
+        }
+        case PhysicalOperatorType::kMergeParallelAggregate: {
+            if ((i64)tasks_.size() != parallel_count) {
+                String error_message = fmt::format("{} task count isn't correct.", PhysicalOperatorToString(last_operator->operator_type()));
+                UnrecoverableError(error_message);
+            }
 
-                tasks_[task_id]->sink_state_ = std::move(sink_state);
+            for (u64 task_id = 0; (i64)task_id < parallel_count; ++task_id) {
+                tasks_[task_id]->sink_state_ = MakeUnique<QueueSinkState>(plan_fragment_ptr_->FragmentID(), task_id);
             }
             break;
         }
@@ -1130,7 +1193,6 @@ void FragmentContext::MakeSinkState(i64 parallel_count) {
             }
             break;
         }
-        case PhysicalOperatorType::kMergeParallelAggregate:
         case PhysicalOperatorType::kMergeAggregate:
         case PhysicalOperatorType::kMergeHash:
         case PhysicalOperatorType::kMergeLimit:
@@ -1138,6 +1200,7 @@ void FragmentContext::MakeSinkState(i64 parallel_count) {
         case PhysicalOperatorType::kMergeSort:
         case PhysicalOperatorType::kMergeMatchTensor:
         case PhysicalOperatorType::kMergeMatchSparse:
+        case PhysicalOperatorType::kJoinHash:
         case PhysicalOperatorType::kMergeKnn: {
             if (fragment_type_ != FragmentType::kSerialMaterialize) {
                 UnrecoverableError(
@@ -1250,7 +1313,6 @@ void FragmentContext::MakeSinkState(i64 parallel_count) {
         case PhysicalOperatorType::kIntersect:
         case PhysicalOperatorType::kExcept:
         case PhysicalOperatorType::kDummyScan:
-        case PhysicalOperatorType::kJoinHash:
         case PhysicalOperatorType::kJoinNestedLoop:
         case PhysicalOperatorType::kJoinMerge:
         case PhysicalOperatorType::kJoinIndex:
@@ -1361,6 +1423,14 @@ void FragmentContext::CreateTasks(i64 cpu_count, i64 operator_count, FragmentCon
             }
             break;
         }
+        case PhysicalOperatorType::kMergeParallelAggregate: {
+            // Each task merges a disjoint subset of the radix partitions
+            parallel_count = std::min(parallel_count, (i64)(first_operator->TaskletCount()));
+            if (parallel_count == 0) {
+                parallel_count = 1;
+            }
+            break;
+        }
         case PhysicalOperatorType::kReadCache:
         case PhysicalOperatorType::kMatch:
         case PhysicalOperatorType::kMergeKnn:
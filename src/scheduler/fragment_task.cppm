@@ -77,6 +77,11 @@ public:
 
     [[nodiscard]] inline i64 LastWorkerID() const { return last_worker_id_; }
 
+    // Steady clock time in nanoseconds when the task is put into a scheduler queue.
+    inline void SetEnqueueTime(i64 enqueue_time) { enqueue_time_ = enqueue_time; }
+
+    [[nodiscard]] inline i64 EnqueueTime() const { return enqueue_time_; }
+
     u64 FragmentId() const;
 
     [[nodiscard]] inline i64 TaskID() const { return task_id_; }
@@ -114,6 +119,7 @@ private:
     void *fragment_context_{};
     bool is_terminator_{false};
     i64 last_worker_id_{-1};
+    i64 enqueue_time_{0};
     i64 task_id_{-1};
     i64 operator_count_{0};
 };
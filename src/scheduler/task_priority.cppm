@@ -0,0 +1,61 @@
+// Copyright(C) 2023 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+module;
+
+export module task_priority;
+
+import stl;
+
+namespace infinity {
+
+// Priority class of the tasks of a query. The scheduler shares the workers among the classes by weight,
+// and limits how many workers each class could occupy at the same time.
+export enum class TaskPriority : u8 {
+    kInteractive, // select, explain
+    kBatch,       // delete, update
+    kBackground,  // create index, compact
+    kInvalid,
+};
+
+export constexpr SizeT TASK_PRIORITY_COUNT = static_cast<SizeT>(TaskPriority::kInvalid);
+
+export String TaskPriority2String(TaskPriority priority) {
+    switch (priority) {
+        case TaskPriority::kInteractive:
+            return String("interactive");
+        case TaskPriority::kBatch:
+            return String("batch");
+        case TaskPriority::kBackground:
+            return String("background");
+        case TaskPriority::kInvalid:
+            return String("invalid");
+    }
+}
+
+export TaskPriority String2TaskPriority(const String &priority_str) {
+    if (priority_str == "interactive") {
+        return TaskPriority::kInteractive;
+    }
+    if (priority_str == "batch") {
+        return TaskPriority::kBatch;
+    }
+    if (priority_str == "background") {
+        return TaskPriority::kBackground;
+    }
+    return TaskPriority::kInvalid;
+}
+
+} // namespace infinity
@@ -14,6 +14,8 @@
 
 module;
 
+#include <bit>
+#include <chrono>
 #include <list>
 #include <sched.h>
 
@@ -39,13 +41,68 @@ import extra_ddl_info;
 import create_statement;
 import command_statement;
 import global_resource_usage;
+import task_priority;
+import session;
 
 namespace infinity {
 
-Worker::Worker(u64 cpu_id, UniquePtr<FragmentTaskBlockQueue> queue, UniquePtr<Thread> thread)
-    : cpu_id_(cpu_id), queue_(std::move(queue)), thread_(std::move(thread)) {}
+namespace {
+
+// A task keeps running on its last worker unless that worker has this many more tasks than the least loaded one.
+constexpr u64 kAffinityWorkloadSlack = 2;
+
+// Idle workers wake up periodically to look for a task to steal, in case of a missed notification.
+constexpr auto kIdleWaitTime = std::chrono::milliseconds(10);
+
+// The pass of a priority class advances by kStrideBase / weight each time a task of the class runs.
+constexpr u64 kStrideBase = 1 << 16;
+
+i64 NowInNanoseconds() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+SizeT TaskClassID(FragmentTask *task) { return static_cast<SizeT>(task->fragment_context()->query_context()->task_priority()); }
+
+TaskPriority StatementTaskPriority(const BaseStatement *base_statement) {
+    switch (base_statement->Type()) {
+        case StatementType::kDelete:
+        case StatementType::kUpdate: {
+            return TaskPriority::kBatch;
+        }
+        case StatementType::kCreate: {
+            // only an index build is long running, creating a table or a database is not
+            const auto *create_statement = static_cast<const CreateStatement *>(base_statement);
+            return create_statement->ddl_type() == DDLType::kIndex ? TaskPriority::kBackground : TaskPriority::kInteractive;
+        }
+        case StatementType::kCompact: {
+            return TaskPriority::kBackground;
+        }
+        default: {
+            return TaskPriority::kInteractive;
+        }
+    }
+}
+
+} // namespace
+
+String TaskQueueMetrics::ToString() const {
+    return fmt::format("pending: {}, running: {}/{}, executed: {}, avg queue time: {}us, p99 queue time: {}us, max queue time: {}us",
+                       pending_task_count_,
+                       running_task_count_,
+                       worker_limit_,
+                       executed_task_count_,
+                       avg_queue_time_us_,
+                       p99_queue_time_us_,
+                       max_queue_time_us_);
+}
+
+Worker::Worker(u64 cpu_id, u32 numa_node) : cpu_id_(cpu_id), numa_node_(numa_node) {
+    for (SizeT class_id = 0; class_id < TASK_PRIORITY_COUNT; ++class_id) {
+        inboxes_[class_id] = MakeUnique<FragmentTaskBlockQueue>("TaskScheduler");
+        run_queues_[class_id] = MakeUnique<FragmentTaskRunQueue>(DEFAULT_WORKER_RUN_QUEUE_SIZE);
+    }
+}
 
-// Non-static memory methods
 TaskScheduler::TaskScheduler(Config *config_ptr) {
     Init(config_ptr);
 #ifdef INFINITY_DEBUG
@@ -79,12 +136,7 @@ void TaskScheduler::Init(Config *config_ptr) {
 
     for (u64 worker_id = 0; worker_id < worker_count_; ++worker_id) {
         const u64 cpu_id = cpu_id_vec[worker_id];
-        UniquePtr<FragmentTaskBlockQueue> worker_queue = MakeUnique<FragmentTaskBlockQueue>("TaskScheduler");
-        UniquePtr<Thread> worker_thread = MakeUnique<Thread>(&TaskScheduler::WorkerLoop, this, worker_queue.get(), worker_id);
-        // Pin the thread to specific cpu
-        ThreadUtil::pin(*worker_thread, cpu_id);
-
-        worker_array_.emplace_back(cpu_id, std::move(worker_queue), std::move(worker_thread));
+        worker_array_.emplace_back(cpu_id, ThreadUtil::numa_node(cpu_id));
         worker_workloads_[worker_id] = 0;
     }
 
@@ -93,30 +145,60 @@ void TaskScheduler::Init(Config *config_ptr) {
         UnrecoverableError(error_message);
     }
 
+    const Array<u64, TASK_PRIORITY_COUNT> weights{u64(config_ptr->InteractiveTaskWeight()),
+                                                  u64(config_ptr->BatchTaskWeight()),
+                                                  u64(config_ptr->BackgroundTaskWeight())};
+    const Array<u64, TASK_PRIORITY_COUNT> worker_percents{u64(config_ptr->InteractiveTaskWorkerPercent()),
+                                                          u64(config_ptr->BatchTaskWorkerPercent()),
+                                                          u64(config_ptr->BackgroundTaskWorkerPercent())};
+    for (SizeT class_id = 0; class_id < TASK_PRIORITY_COUNT; ++class_id) {
+        priority_classes_[class_id].stride_ = kStrideBase / weights[class_id];
+        priority_classes_[class_id].worker_limit_ = std::max(u64(1), worker_count_ * worker_percents[class_id] / 100);
+    }
+
+    // Steal from the workers of the same NUMA node first, starting from the next worker so that the thieves spread out.
+    for (u64 worker_id = 0; worker_id < worker_count_; ++worker_id) {
+        auto &victims = worker_array_[worker_id].victims_;
+        for (bool same_node : {true, false}) {
+            for (u64 i = 1; i < worker_count_; ++i) {
+                u64 victim_id = (worker_id + i) % worker_count_;
+                if ((worker_array_[victim_id].numa_node_ == worker_array_[worker_id].numa_node_) == same_node) {
+                    victims.push_back(victim_id);
+                }
+            }
+        }
+    }
+
+    stop_ = false;
+    for (u64 worker_id = 0; worker_id < worker_count_; ++worker_id) {
+        auto &worker = worker_array_[worker_id];
+        worker.thread_ = MakeUnique<Thread>(&TaskScheduler::WorkerLoop, this, worker_id);
+        // Pin the thread to specific cpu
+        ThreadUtil::pin(*worker.thread_, worker.cpu_id_);
+    }
+
     initialized_ = true;
 }
 
 void TaskScheduler::UnInit() {
     initialized_ = false;
-    UniquePtr<FragmentTask> terminate_task = MakeUnique<FragmentTask>(true);
+    {
+        std::lock_guard<std::mutex> lock(idle_mutex_);
+        stop_ = true;
+    }
+    idle_cv_.notify_all();
 
     for (const auto &worker : worker_array_) {
-        worker.queue_->Enqueue(terminate_task.get());
         worker.thread_->join();
     }
 }
 
+// Power of two choices: compare the workload of two workers instead of scanning all of them.
 u64 TaskScheduler::FindLeastWorkloadWorker() {
-    u64 min_workload = worker_workloads_[0];
-    u64 min_workload_worker_id = 0;
-    for (u64 worker_id = 1; worker_id < worker_count_ && min_workload; ++worker_id) {
-        u64 current_worker_load = worker_workloads_[worker_id];
-        if (current_worker_load < min_workload) {
-            min_workload = current_worker_load;
-            min_workload_worker_id = worker_id;
-        }
-    }
-    return min_workload_worker_id;
+    u64 count = schedule_count_.fetch_add(1);
+    u64 first_worker_id = count % worker_count_;
+    u64 second_worker_id = (count * 0x9E3779B1ull >> 7) % worker_count_;
+    return worker_workloads_[second_worker_id] < worker_workloads_[first_worker_id] ? second_worker_id : first_worker_id;
 }
 
 void TaskScheduler::Schedule(PlanFragment *plan_fragment, const BaseStatement *base_statement) {
@@ -164,6 +246,13 @@ void TaskScheduler::Schedule(PlanFragment *plan_fragment, const BaseStatement *b
         }
     }
 
+    QueryContext *query_context = plan_fragment->GetContext()->query_context();
+    TaskPriority priority = StatementTaskPriority(base_statement);
+    if (BaseSession *session = query_context->current_session(); session != nullptr && session->query_priority() != TaskPriority::kInvalid) {
+        priority = session->query_priority();
+    }
+    query_context->set_task_priority(priority);
+
     Vector<PlanFragment *> start_fragments;
     SizeT task_n = plan_fragment->GetStartFragments(start_fragments);
     plan_fragment->GetContext()->notifier()->SetTaskN(task_n);
@@ -210,44 +299,201 @@ void TaskScheduler::ScheduleFragment(PlanFragment *plan_fragment) {
         }
     }
     for (auto *task_ptr : task_ptrs) {
-        if (task_ptr->LastWorkerID() == -1) {
-            u64 worker_id = FindLeastWorkloadWorker();
-            ScheduleTask(task_ptr, worker_id);
-        } else {
-            ScheduleTask(task_ptr, task_ptr->LastWorkerID());
+        u64 worker_id = FindLeastWorkloadWorker();
+        // The last worker is only a hint, a busy one gives the task away.
+        if (i64 last_worker_id = task_ptr->LastWorkerID(); last_worker_id != -1) {
+            if (worker_workloads_[last_worker_id] <= worker_workloads_[worker_id] + kAffinityWorkloadSlack) {
+                worker_id = last_worker_id;
+            }
         }
+        ScheduleTask(task_ptr, worker_id);
     }
 }
 
 void TaskScheduler::ScheduleTask(FragmentTask *task, u64 worker_id) {
+    SizeT class_id = TaskClassID(task);
+    task->SetEnqueueTime(NowInNanoseconds());
     ++worker_workloads_[worker_id];
-    worker_array_[worker_id].queue_->Enqueue(task);
+    ++priority_classes_[class_id].pending_task_count_;
+    worker_array_[worker_id].inboxes_[class_id]->Enqueue(task);
+    WakeIdleWorker();
 }
 
-void TaskScheduler::WorkerLoop(FragmentTaskBlockQueue *task_queue, i64 worker_id) {
-    List<FragmentTask *> task_lists;
-    auto iter = task_lists.end();
-    auto last_iter = task_lists.end();
-    while (true) {
-        if (iter == last_iter) {
-            Vector<FragmentTask *> dequeue_output;
-            if (task_lists.empty()) {
-                task_queue->DequeueBulk(dequeue_output);
-            } else {
-                task_queue->TryDequeueBulk(dequeue_output);
+FragmentTask *TaskScheduler::NextTask(u64 worker_id, TaskPriority &priority) {
+    auto &worker = worker_array_[worker_id];
+    // Move the newly placed tasks to the run queues, where they can be stolen.
+    for (SizeT class_id = 0; class_id < TASK_PRIORITY_COUNT; ++class_id) {
+        auto &run_queue = worker.run_queues_[class_id];
+        while (run_queue->Size() < run_queue->Capacity()) {
+            FragmentTask *task = nullptr;
+            if (!worker.inboxes_[class_id]->TryDequeue(task)) {
+                break;
             }
-            if (!dequeue_output.empty()) {
-                task_lists.insert(task_lists.end(), dequeue_output.begin(), dequeue_output.end());
-            }
-            last_iter = task_lists.end();
+            run_queue->Push(task);
+        }
+    }
+
+    // Weighted fair queueing: try the classes from the smallest pass. On a tie the higher priority wins.
+    Array<SizeT, TASK_PRIORITY_COUNT> class_order{};
+    for (SizeT class_id = 0; class_id < TASK_PRIORITY_COUNT; ++class_id) {
+        class_order[class_id] = class_id;
+    }
+    std::stable_sort(class_order.begin(), class_order.end(), [&](SizeT left, SizeT right) { return worker.passes_[left] < worker.passes_[right]; });
+    for (SizeT i = 0; i < TASK_PRIORITY_COUNT; ++i) {
+        SizeT class_id = class_order[i];
+        if (!AcquireWorkerSlot(class_id)) {
+            continue;
+        }
+        FragmentTask *task = TakeTask(worker_id, class_id);
+        if (task == nullptr) {
+            ReleaseWorkerSlot(class_id);
+            continue;
         }
-        if (iter == task_lists.end()) {
-            iter = task_lists.begin();
+        worker.passes_[class_id] += priority_classes_[class_id].stride_;
+        // The classes which couldn't run don't save up their share for later.
+        for (SizeT j = 0; j < i; ++j) {
+            worker.passes_[class_order[j]] = std::max(worker.passes_[class_order[j]], worker.passes_[class_id]);
         }
-        auto *fragment_task = *iter;
-        if (fragment_task->IsTerminator()) {
+        priority = static_cast<TaskPriority>(class_id);
+        return task;
+    }
+    return nullptr;
+}
+
+FragmentTask *TaskScheduler::TakeTask(u64 worker_id, SizeT class_id) {
+    auto &worker = worker_array_[worker_id];
+    FragmentTask *task = worker.run_queues_[class_id]->Pop();
+    if (task == nullptr) {
+        worker.inboxes_[class_id]->TryDequeue(task);
+    }
+    for (SizeT i = 0; task == nullptr && i < worker.victims_.size(); ++i) {
+        u64 victim_id = worker.victims_[i];
+        auto &victim = worker_array_[victim_id];
+        task = victim.run_queues_[class_id]->Pop();
+        if (task == nullptr && !victim.inboxes_[class_id]->TryDequeue(task)) {
+            continue;
+        }
+        --worker_workloads_[victim_id];
+        ++worker_workloads_[worker_id];
+    }
+    if (task != nullptr) {
+        --priority_classes_[class_id].pending_task_count_;
+        RecordQueueTime(class_id, task);
+    }
+    return task;
+}
+
+void TaskScheduler::RequeueTask(FragmentTask *task, TaskPriority priority, u64 worker_id) {
+    auto &worker = worker_array_[worker_id];
+    SizeT class_id = static_cast<SizeT>(priority);
+    task->SetEnqueueTime(NowInNanoseconds());
+    ++priority_classes_[class_id].pending_task_count_;
+    if (!worker.run_queues_[class_id]->Push(task)) {
+        worker.inboxes_[class_id]->Enqueue(task);
+    }
+    // Other tasks are waiting behind this one, let an idle worker take them.
+    if (worker.run_queues_[class_id]->Size() > 1) {
+        WakeIdleWorker();
+    }
+}
+
+bool TaskScheduler::AcquireWorkerSlot(SizeT class_id) {
+    auto &priority_class = priority_classes_[class_id];
+    u64 running_count = priority_class.running_task_count_.load();
+    while (running_count < priority_class.worker_limit_) {
+        if (priority_class.running_task_count_.compare_exchange_weak(running_count, running_count + 1)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void TaskScheduler::ReleaseWorkerSlot(SizeT class_id) {
+    auto &priority_class = priority_classes_[class_id];
+    u64 running_count = priority_class.running_task_count_.fetch_sub(1);
+    // The class was at its limit, a waiting task of it could run now.
+    if (running_count == priority_class.worker_limit_ && priority_class.pending_task_count_ > 0) {
+        WakeIdleWorker();
+    }
+}
+
+void TaskScheduler::RecordQueueTime(SizeT class_id, FragmentTask *task) {
+    auto &priority_class = priority_classes_[class_id];
+    u64 queue_time = std::max(i64(0), NowInNanoseconds() - task->EnqueueTime());
+    ++priority_class.executed_task_count_;
+    priority_class.total_queue_time_ns_ += queue_time;
+    u64 max_queue_time = priority_class.max_queue_time_ns_.load();
+    while (queue_time > max_queue_time && !priority_class.max_queue_time_ns_.compare_exchange_weak(max_queue_time, queue_time)) {
+    }
+    SizeT bucket = 63 - std::countl_zero(queue_time | 1);
+    ++priority_class.queue_time_histogram_[bucket];
+}
+
+TaskQueueMetrics TaskScheduler::GetTaskQueueMetrics(TaskPriority priority) const {
+    const auto &priority_class = priority_classes_[static_cast<SizeT>(priority)];
+    TaskQueueMetrics metrics;
+    metrics.pending_task_count_ = priority_class.pending_task_count_;
+    metrics.running_task_count_ = priority_class.running_task_count_;
+    metrics.worker_limit_ = priority_class.worker_limit_;
+    metrics.executed_task_count_ = priority_class.executed_task_count_;
+    if (metrics.executed_task_count_ > 0) {
+        metrics.avg_queue_time_us_ = priority_class.total_queue_time_ns_ / metrics.executed_task_count_ / 1000;
+    }
+    metrics.max_queue_time_us_ = priority_class.max_queue_time_ns_ / 1000;
+
+    Array<u64, 64> histogram{};
+    u64 total_count = 0;
+    for (SizeT bucket = 0; bucket < histogram.size(); ++bucket) {
+        histogram[bucket] = priority_class.queue_time_histogram_[bucket];
+        total_count += histogram[bucket];
+    }
+    // Upper bound of the bucket which the 99th percentile falls in
+    u64 count = 0;
+    for (SizeT bucket = 0; bucket < histogram.size() && total_count > 0; ++bucket) {
+        count += histogram[bucket];
+        if (count * 100 >= total_count * 99) {
+            metrics.p99_queue_time_us_ = std::min((u64(2) << bucket) / 1000, metrics.max_queue_time_us_);
             break;
         }
+    }
+    return metrics;
+}
+
+bool TaskScheduler::HasRunnableTask() const {
+    for (const auto &priority_class : priority_classes_) {
+        if (priority_class.pending_task_count_ > 0 && priority_class.running_task_count_ < priority_class.worker_limit_) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void TaskScheduler::WaitForTask() {
+    std::unique_lock<std::mutex> lock(idle_mutex_);
+    ++idle_worker_count_;
+    idle_cv_.wait_for(lock, kIdleWaitTime, [this] { return stop_ || HasRunnableTask(); });
+    --idle_worker_count_;
+}
+
+void TaskScheduler::WakeIdleWorker() {
+    if (idle_worker_count_ == 0) {
+        return;
+    }
+    {
+        // Pairs with the predicate check of WaitForTask, so that the notification isn't lost.
+        std::lock_guard<std::mutex> lock(idle_mutex_);
+    }
+    idle_cv_.notify_one();
+}
+
+void TaskScheduler::WorkerLoop(i64 worker_id) {
+    while (!stop_) {
+        TaskPriority priority = TaskPriority::kInvalid;
+        FragmentTask *fragment_task = NextTask(worker_id, priority);
+        if (fragment_task == nullptr) {
+            WaitForTask();
+            continue;
+        }
         auto *fragment_ctx = fragment_task->fragment_context();
 
         bool error = false;
@@ -261,23 +507,21 @@ void TaskScheduler::WorkerLoop(FragmentTaskBlockQueue *task_queue, i64 worker_id
                 error = true;
             }
         }
+        ReleaseWorkerSlot(static_cast<SizeT>(priority));
         if (!error) {
             if (fragment_task->IsComplete()) {
                 --worker_workloads_[worker_id];
                 fragment_task->CompleteTask();
-                iter = task_lists.erase(iter);
                 finish = true;
             } else if (fragment_task->QuitFromWorkerLoop()) {
                 --worker_workloads_[worker_id];
-                iter = task_lists.erase(iter);
             } else {
-                ++iter;
+                RequeueTask(fragment_task, priority, worker_id);
             }
         } else {
             --worker_workloads_[worker_id];
             fragment_ctx->notifier()->SetError(fragment_ctx);
             fragment_task->CompleteTask();
-            iter = task_lists.erase(iter);
         }
         if (finish || error) {
             fragment_ctx->notifier()->FinishTask();
@@ -20,7 +20,9 @@ import config;
 import stl;
 import fragment_task;
 import blocking_queue;
+import work_stealing_queue;
 import base_statement;
+import task_priority;
 
 namespace infinity {
 
@@ -28,14 +30,40 @@ class QueryContext;
 class PlanFragment;
 
 using FragmentTaskBlockQueue = BlockingQueue<FragmentTask *>;
+using FragmentTaskRunQueue = WorkStealingQueue<FragmentTask *>;
 
 struct Worker {
-    Worker(u64 cpu_id, UniquePtr<FragmentTaskBlockQueue> queue, UniquePtr<Thread> thread);
+    Worker(u64 cpu_id, u32 numa_node);
     u64 cpu_id_{0};
-    UniquePtr<FragmentTaskBlockQueue> queue_{};
+    u32 numa_node_{0};
+    // Tasks placed on this worker by the other threads, one queue for each priority class
+    Array<UniquePtr<FragmentTaskBlockQueue>, TASK_PRIORITY_COUNT> inboxes_{};
+    // Tasks owned by this worker, the idle workers steal from them
+    Array<UniquePtr<FragmentTaskRunQueue>, TASK_PRIORITY_COUNT> run_queues_{};
+    // Virtual time of each priority class on this worker, the class with the smallest pass runs next
+    Array<u64, TASK_PRIORITY_COUNT> passes_{};
+    // Workers to steal from, the ones on the same NUMA node come first
+    Vector<u64> victims_{};
     UniquePtr<Thread> thread_{};
 };
 
+export struct TaskQueueMetrics {
+    u64 pending_task_count_{0};
+    u64 running_task_count_{0};
+    u64 worker_limit_{0};
+    // Each OnExecute of a task counts once
+    u64 executed_task_count_{0};
+    u64 avg_queue_time_us_{0};
+    u64 p99_queue_time_us_{0};
+    u64 max_queue_time_us_{0};
+
+    String ToString() const;
+};
+
+// Each worker runs the tasks of its run queues round-robin, one OnExecute at a time. A worker without runnable task
+// steals from the others, so a long running KNN or full-text task doesn't hold back the tasks queued behind it.
+// The tasks are divided into priority classes, see TaskPriority. A worker picks the class by weighted fair queueing,
+// and each class could only occupy part of the workers, so that index building doesn't increase the search latency much.
 export class TaskScheduler {
 public:
     explicit TaskScheduler(Config *config_ptr);
@@ -54,22 +82,69 @@ public:
 
     void DumpPlanFragment(PlanFragment *plan_fragment);
 
+    TaskQueueMetrics GetTaskQueueMetrics(TaskPriority priority) const;
+
 private:
+    struct PriorityClass {
+        u64 stride_{0};
+        u64 worker_limit_{0};
+
+        // Tasks waiting in the inboxes and run queues
+        Atomic<u64> pending_task_count_{0};
+        Atomic<u64> running_task_count_{0};
+        Atomic<u64> executed_task_count_{0};
+        Atomic<u64> total_queue_time_ns_{0};
+        Atomic<u64> max_queue_time_ns_{0};
+        // Bucket i counts the queue times in [2^i, 2^(i+1)) ns
+        Array<Atomic<u64>, 64> queue_time_histogram_{};
+    };
+
     u64 FindLeastWorkloadWorker();
 
     void ScheduleTask(FragmentTask *task, u64 worker_id);
 
     void RunTask(FragmentTask *task);
 
-    void WorkerLoop(FragmentTaskBlockQueue *task_queue, i64 worker_id);
+    void WorkerLoop(i64 worker_id);
+
+    // Next task to run on the worker, and its priority class.
+    FragmentTask *NextTask(u64 worker_id, TaskPriority &priority);
+
+    // Take a task of the class from the worker's own queues first, then steal from the victims.
+    FragmentTask *TakeTask(u64 worker_id, SizeT class_id);
+
+    // Put back a task which isn't finished yet.
+    void RequeueTask(FragmentTask *task, TaskPriority priority, u64 worker_id);
+
+    // Take a worker slot of the class, false if the class already occupies as many workers as it could.
+    bool AcquireWorkerSlot(SizeT class_id);
+
+    void ReleaseWorkerSlot(SizeT class_id);
+
+    void RecordQueueTime(SizeT class_id, FragmentTask *task);
+
+    bool HasRunnableTask() const;
+
+    void WaitForTask();
+
+    void WakeIdleWorker();
 
 private:
     bool initialized_{false};
 
     Vector<Worker> worker_array_{};
+    // Tasks placed on each worker and not finished yet.
     Deque<Atomic<u64>> worker_workloads_{};
 
     u64 worker_count_{0};
+
+    Array<PriorityClass, TASK_PRIORITY_COUNT> priority_classes_{};
+
+    Atomic<u64> idle_worker_count_{0};
+    Atomic<u64> schedule_count_{0};
+    atomic_bool stop_{false};
+    std::mutex idle_mutex_{};
+    std::condition_variable idle_cv_{};
 };
 
 } // namespace infinity
@@ -14,6 +14,7 @@
 
 module;
 
+#include <thread>
 #include <vector>
 
 module buffer_manager;
@@ -30,70 +31,123 @@ import var_file_worker;
 import persistence_manager;
 import virtual_store;
 import global_resource_usage;
+import default_values;
 
 namespace infinity {
 
-void LRUCache::RemoveClean(const Vector<BufferObj *> &buffer_obj) {
+void ClockCache::RemoveClean(const Vector<BufferObj *> &buffer_obj) {
     std::unique_lock lock(locker_);
     for (auto *buffer_obj : buffer_obj) {
-        if (auto iter = gc_map_.find(buffer_obj); iter != gc_map_.end()) {
-            gc_list_.erase(iter->second);
-            gc_map_.erase(iter);
+        if (auto iter = slot_map_.find(buffer_obj); iter != slot_map_.end()) {
+            RemoveSlot(iter->second);
         }
     }
 }
 
-SizeT LRUCache::WaitingGCObjectCount() {
+SizeT ClockCache::WaitingGCObjectCount() {
     std::unique_lock lock(locker_);
-    return gc_map_.size();
+    return slot_map_.size() - loaded_count_;
 }
 
-SizeT LRUCache::RequestSpace(SizeT need_space) {
+SizeT ClockCache::RequestSpace(SizeT need_space) {
     SizeT free_space = 0;
     std::unique_lock lock(locker_);
-    auto iter = gc_list_.begin();
-    while (free_space < need_space && iter != gc_list_.end()) {
-        auto *buffer_obj = *iter;
+    // Two rounds at most: the first one may only clear the reference bits.
+    SizeT step_count = slots_.size() * 2;
+    for (SizeT step = 0; step < step_count && free_space < need_space && !slot_map_.empty(); ++step) {
+        SizeT slot_idx = hand_;
+        hand_ = (hand_ + 1) % slots_.size();
+        Slot &slot = slots_[slot_idx];
+        if (slot.buffer_obj_ == nullptr || slot.loaded_) {
+            continue;
+        }
+        if (slot.referenced_) {
+            slot.referenced_ = false;
+            continue;
+        }
+        auto *buffer_obj = slot.buffer_obj_;
         // Free return false when the buffer is freed by cleanup
         // will not dead lock because caller is in kNew or kFree state, and `buffer_obj` is in kUnloaded or state
         if (buffer_obj->Free()) {
             free_space += buffer_obj->GetBufferSize();
-            iter = gc_list_.erase(iter);
-            gc_map_.erase(buffer_obj);
-        } else {
-            ++iter;
+            RemoveSlot(slot_idx);
         }
     }
     return free_space;
 }
 
-void LRUCache::PushGCQueue(BufferObj *buffer_obj) {
+void ClockCache::PushGCQueue(BufferObj *buffer_obj) {
+    std::unique_lock lock(locker_);
+    if (auto iter = slot_map_.find(buffer_obj); iter != slot_map_.end()) {
+        Slot &slot = slots_[iter->second];
+        slot.referenced_ = true;
+        if (slot.loaded_) {
+            slot.loaded_ = false;
+            --loaded_count_;
+        }
+        return;
+    }
+    SizeT slot_idx = 0;
+    if (free_slots_.empty()) {
+        slot_idx = slots_.size();
+        slots_.emplace_back();
+    } else {
+        slot_idx = free_slots_.back();
+        free_slots_.pop_back();
+    }
+    slots_[slot_idx] = Slot{buffer_obj, true};
+    slot_map_.emplace(buffer_obj, slot_idx);
+}
+
+bool ClockCache::MarkLoaded(BufferObj *buffer_obj) {
     std::unique_lock lock(locker_);
-    auto iter = gc_map_.find(buffer_obj);
-    if (iter != gc_map_.end()) {
-        gc_list_.erase(iter->second);
+    auto iter = slot_map_.find(buffer_obj);
+    if (iter == slot_map_.end()) {
+        return false;
+    }
+    Slot &slot = slots_[iter->second];
+    slot.referenced_ = true;
+    if (!slot.loaded_) {
+        slot.loaded_ = true;
+        ++loaded_count_;
     }
-    gc_list_.push_back(buffer_obj);
-    gc_map_[buffer_obj] = --gc_list_.end();
+    return true;
 }
 
-bool LRUCache::RemoveFromGCQueue(BufferObj *buffer_obj) {
+bool ClockCache::RemoveFromGCQueue(BufferObj *buffer_obj) {
     std::unique_lock lock(locker_);
-    if (auto iter = gc_map_.find(buffer_obj); iter != gc_map_.end()) {
-        gc_list_.erase(iter->second);
-        gc_map_.erase(iter);
+    if (auto iter = slot_map_.find(buffer_obj); iter != slot_map_.end()) {
+        RemoveSlot(iter->second);
         return true;
     }
     return false;
 }
 
+void ClockCache::RemoveSlot(SizeT slot_idx) {
+    Slot &slot = slots_[slot_idx];
+    slot_map_.erase(slot.buffer_obj_);
+    if (slot.loaded_) {
+        --loaded_count_;
+    }
+    slot = Slot{};
+    if (slot_map_.empty()) {
+        // Shrink the clock when it runs empty, so that the holes left by removed objects do not pile up.
+        slots_.clear();
+        free_slots_.clear();
+        hand_ = 0;
+    } else {
+        free_slots_.push_back(slot_idx);
+    }
+}
+
 BufferManager::BufferManager(u64 memory_limit,
                              SharedPtr<String> data_dir,
                              SharedPtr<String> temp_dir,
                              PersistenceManager *persistence_manager,
-                             SizeT lru_count)
+                             SizeT lru_count,
+                             SizeT map_shard_count)
     : data_dir_(std::move(data_dir)), temp_dir_(std::move(temp_dir)), memory_limit_(memory_limit), persistence_manager_(persistence_manager),
-      current_memory_size_(0), lru_caches_(lru_count) {
+      current_memory_size_(0), buffer_map_shards_(map_shard_count), gc_clocks_(lru_count) {
 #ifdef INFINITY_DEBUG
     GlobalResourceUsage::IncrObjectCount("BufferManager");
 #endif
@@ -121,12 +175,13 @@ BufferObj *BufferManager::AllocateBufferObject(UniquePtr<FileWorker> file_worker
 
     BufferObj *res = buffer_obj.get();
     {
-        std::unique_lock lock(w_locker_);
-        if (auto iter = buffer_map_.find(file_path); iter != buffer_map_.end()) {
+        BufferMapShard &shard = GetBufferMapShard(file_path);
+        std::unique_lock lock(shard.locker_);
+        if (auto iter = shard.buffer_map_.find(file_path); iter != shard.buffer_map_.end()) {
             String error_message = fmt::format("BufferManager::Allocate: file {} already exists.", file_path.c_str());
             UnrecoverableError(error_message);
         }
-        buffer_map_.emplace(file_path, std::move(buffer_obj));
+        shard.buffer_map_.emplace(file_path, std::move(buffer_obj));
     }
 
     return res;
@@ -136,8 +191,9 @@ BufferObj *BufferManager::GetBufferObject(UniquePtr<FileWorker> file_worker, boo
     String file_path = file_worker->GetFilePath();
     // LOG_TRACE(fmt::format("Get buffer object: {}", file_path));
 
-    std::unique_lock lock(w_locker_);
-    if (auto iter1 = buffer_map_.find(file_path); iter1 != buffer_map_.end()) {
+    BufferMapShard &shard = GetBufferMapShard(file_path);
+    std::unique_lock lock(shard.locker_);
+    if (auto iter1 = shard.buffer_map_.find(file_path); iter1 != shard.buffer_map_.end()) {
         BufferObj *buffer_obj = iter1->second.get();
         if (restart) {
             buffer_obj->UpdateFileWorkerInfo(std::move(file_worker));
@@ -148,22 +204,26 @@ BufferObj *BufferManager::GetBufferObject(UniquePtr<FileWorker> file_worker, boo
     auto buffer_obj = MakeBufferObj(std::move(file_worker), false);
 
     BufferObj *res = buffer_obj.get();
-    buffer_map_.emplace(std::move(file_path), std::move(buffer_obj));
+    shard.buffer_map_.emplace(std::move(file_path), std::move(buffer_obj));
 
     return res;
 }
 
 Vector<SizeT> BufferManager::WaitingGCObjectCount() {
-    Vector<SizeT> size_list(lru_caches_.size());
-    for (SizeT i = 0; i < lru_caches_.size(); ++i) {
-        size_list[i] = lru_caches_[i].WaitingGCObjectCount();
+    Vector<SizeT> size_list(gc_clocks_.size());
+    for (SizeT i = 0; i < gc_clocks_.size(); ++i) {
+        size_list[i] = gc_clocks_[i].WaitingGCObjectCount();
     }
     return size_list;
 }
 
 SizeT BufferManager::BufferedObjectCount() {
-    std::unique_lock lock(w_locker_);
-    return buffer_map_.size();
+    SizeT count = 0;
+    for (auto &shard : buffer_map_shards_) {
+        std::unique_lock lock(shard.locker_);
+        count += shard.buffer_map_.size();
+    }
+    return count;
 }
 
 void BufferManager::RemoveClean() {
@@ -185,29 +245,26 @@ void BufferManager::RemoveClean() {
         buffer_obj->CleanupTempFile();
     }
 
-    for (auto &lru_cache : lru_caches_) {
-        lru_cache.RemoveClean(clean_list);
+    for (auto &gc_clock : gc_clocks_) {
+        gc_clock.RemoveClean(clean_list);
     }
-    {
-        std::unique_lock lock(w_locker_);
-        for (auto *buffer_obj : clean_list) {
-            auto file_path = buffer_obj->GetFilename();
-            size_t remove_n = buffer_map_.erase(file_path);
-            if (remove_n != 1) {
-                String error_message = fmt::format("BufferManager::RemoveClean: file {} not found.", file_path.c_str());
-                UnrecoverableError(error_message);
-            }
+    for (auto *buffer_obj : clean_list) {
+        auto file_path = buffer_obj->GetFilename();
+        BufferMapShard &shard = GetBufferMapShard(file_path);
+        std::unique_lock lock(shard.locker_);
+        size_t remove_n = shard.buffer_map_.erase(file_path);
+        if (remove_n != 1) {
+            String error_message = fmt::format("BufferManager::RemoveClean: file {} not found.", file_path.c_str());
+            UnrecoverableError(error_message);
         }
-        buffer_map_.rehash(buffer_map_.size());
     }
 }
 
 Vector<BufferObjectInfo> BufferManager::GetBufferObjectsInfo() {
     Vector<BufferObjectInfo> result;
-    {
-        std::unique_lock lock(w_locker_);
-        result.reserve(buffer_map_.size());
-        for (const auto &buffer_pair : buffer_map_) {
+    for (auto &shard : buffer_map_shards_) {
+        std::unique_lock lock(shard.locker_);
+        for (const auto &buffer_pair : shard.buffer_map_) {
             BufferObjectInfo buffer_object_info;
             buffer_object_info.object_path_ = buffer_pair.first;
             BufferObj *buffer_object_ptr = buffer_pair.second.get();
@@ -221,6 +278,19 @@ Vector<BufferObjectInfo> BufferManager::GetBufferObjectsInfo() {
     return result;
 }
 
+void BufferManager::AddRequestCount() {
+    thread_local SizeT stripe = std::hash<std::thread::id>{}(std::this_thread::get_id()) % BUFFER_MANAGER_REQUEST_COUNTER_STRIPES;
+    request_counters_[stripe].count_.fetch_add(1, std::memory_order_relaxed);
+}
+
+u64 BufferManager::TotalRequestCount() {
+    u64 total_request_count = 0;
+    for (const auto &request_counter : request_counters_) {
+        total_request_count += request_counter.count_.load(std::memory_order_relaxed);
+    }
+    return total_request_count;
+}
+
 bool BufferManager::RequestSpace(SizeT need_size) {
     std::unique_lock lock(gc_locker_);
     SizeT freed_space = 0;
@@ -231,8 +301,8 @@ bool BufferManager::RequestSpace(SizeT need_size) {
     }
     SizeT round_robin = round_robin_;
     do {
-        freed_space += lru_caches_[round_robin_].RequestSpace(need_size);
-        round_robin_ = (round_robin_ + 1) % lru_caches_.size();
+        freed_space += gc_clocks_[round_robin_].RequestSpace(need_size);
+        round_robin_ = (round_robin_ + 1) % gc_clocks_.size();
     } while (freed_space + free_space < need_size && round_robin_ != round_robin);
     bool free_success = freed_space + free_space >= need_size;
     [[maybe_unused]] auto cur_mem_size = current_memory_size_.fetch_add(need_size - freed_space); // It's ok to add minus value
@@ -240,8 +310,8 @@ bool BufferManager::RequestSpace(SizeT need_size) {
 }
 
 void BufferManager::PushGCQueue(BufferObj *buffer_obj) {
-    SizeT idx = LRUIdx(buffer_obj);
-    lru_caches_[idx].PushGCQueue(buffer_obj);
+    SizeT idx = GCClockIdx(buffer_obj);
+    gc_clocks_[idx].PushGCQueue(buffer_obj);
 
     if (auto mem_usage = memory_usage(); mem_usage > memory_limit_) {
         SizeT need_size = mem_usage - memory_limit_;
@@ -250,9 +320,14 @@ void BufferManager::PushGCQueue(BufferObj *buffer_obj) {
     }
 }
 
+bool BufferManager::MarkLoaded(BufferObj *buffer_obj) {
+    SizeT idx = GCClockIdx(buffer_obj);
+    return gc_clocks_[idx].MarkLoaded(buffer_obj);
+}
+
 bool BufferManager::RemoveFromGCQueue(BufferObj *buffer_obj) {
-    SizeT idx = LRUIdx(buffer_obj);
-    return lru_caches_[idx].RemoveFromGCQueue(buffer_obj);
+    SizeT idx = GCClockIdx(buffer_obj);
+    return gc_clocks_[idx].RemoveFromGCQueue(buffer_obj);
 }
 
 void BufferManager::AddToCleanList(BufferObj *buffer_obj, bool do_free) {
@@ -314,9 +389,13 @@ void BufferManager::MoveTemp(BufferObj *buffer_obj) {
     }
 }
 
-SizeT BufferManager::LRUIdx(BufferObj *buffer_obj) const {
+SizeT BufferManager::GCClockIdx(BufferObj *buffer_obj) const {
     auto id = buffer_obj->id();
-    return id % lru_caches_.size();
+    return id % gc_clocks_.size();
+}
+
+BufferManager::BufferMapShard &BufferManager::GetBufferMapShard(const String &file_path) {
+    return buffer_map_shards_[std::hash<String>{}(file_path) % buffer_map_shards_.size()];
 }
 
 UniquePtr<BufferObj> BufferManager::MakeBufferObj(UniquePtr<FileWorker> file_worker, bool is_ephemeral) {
@@ -27,7 +27,10 @@ namespace infinity {
 class BufferObj;
 class BufferObjectInfo;
 
-class LRUCache {
+// Second chance (CLOCK) replacement over the unloaded buffer objects of one shard. An object loaded again keeps its slot
+// with the reference bit set and is skipped by the sweep until it is unloaded, instead of moving a list node as a LRU
+// list does.
+class ClockCache {
 public:
     void RemoveClean(const Vector<BufferObj *> &buffer_obj);
 
@@ -37,13 +40,27 @@ public:
 
     void PushGCQueue(BufferObj *buffer_obj);
 
+    // Return false if the object is not in the clock.
+    bool MarkLoaded(BufferObj *buffer_obj);
+
     bool RemoveFromGCQueue(BufferObj *buffer_obj);
 
 private:
+    // Called with locker_ held.
+    void RemoveSlot(SizeT slot_idx);
+
+    struct Slot {
+        BufferObj *buffer_obj_{};
+        bool referenced_{};
+        bool loaded_{};
+    };
+
     std::mutex locker_{};
-    using GCListIter = List<BufferObj *>::iterator;
-    HashMap<BufferObj *, GCListIter> gc_map_{};
-    List<BufferObj *> gc_list_{};
+    Vector<Slot> slots_{};
+    Vector<SizeT> free_slots_{};
+    HashMap<BufferObj *, SizeT> slot_map_{};
+    SizeT hand_{};
+    SizeT loaded_count_{};
 };
 
 export class BufferManager {
@@ -52,7 +69,8 @@ public:
                            SharedPtr<String> data_dir,
                            SharedPtr<String> temp_dir,
                            PersistenceManager *persistence_manager,
-                           SizeT lru_count = DEFAULT_BUFFER_MANAGER_LRU_COUNT);
+                           SizeT lru_count = DEFAULT_BUFFER_MANAGER_LRU_COUNT,
+                           SizeT map_shard_count = DEFAULT_BUFFER_MANAGER_MAP_SHARD_COUNT);
 
     ~BufferManager();
 
@@ -87,9 +105,9 @@ public:
 
     inline PersistenceManager *persistence_manager() const { return persistence_manager_; }
 
-    inline void AddRequestCount() { ++total_request_count_; }
+    void AddRequestCount();
     inline void AddCacheMissCount() { ++cache_miss_count_; }
-    inline u64 TotalRequestCount() { return total_request_count_; }
+    u64 TotalRequestCount();
     inline u64 CacheMissCount() { return cache_miss_count_; }
 
 private:
@@ -102,6 +120,9 @@ private:
     // BufferHandle calls it, after unload.
     void PushGCQueue(BufferObj *buffer_obj);
 
+    // BufferHandle calls it, when an unloaded buffer is loaded again.
+    bool MarkLoaded(BufferObj *buffer_obj);
+
     bool RemoveFromGCQueue(BufferObj *buffer_obj);
 
     void AddToCleanList(BufferObj *buffer_obj, bool do_free);
@@ -114,7 +135,11 @@ private:
 
     void MoveTemp(BufferObj *buffer_obj);
 
-    SizeT LRUIdx(BufferObj *buffer_obj) const;
+    SizeT GCClockIdx(BufferObj *buffer_obj) const;
+
+    struct BufferMapShard;
+
+    BufferMapShard &GetBufferMapShard(const String &file_path);
 
     UniquePtr<BufferObj> MakeBufferObj(UniquePtr<FileWorker> file_worker, bool is_ephemeral);
 
@@ -125,12 +150,16 @@ private:
     PersistenceManager *persistence_manager_;
     Atomic<u64> current_memory_size_{};
 
-    std::mutex w_locker_{};
-    HashMap<String, UniquePtr<BufferObj>> buffer_map_{};
+    // The buffer objects are sharded by the hash of the file path, so that concurrent lookups rarely wait for each other.
+    struct alignas(64) BufferMapShard {
+        std::mutex locker_{};
+        HashMap<String, UniquePtr<BufferObj>> buffer_map_{};
+    };
+    Vector<BufferMapShard> buffer_map_shards_;
     Atomic<u32> buffer_id_{};
 
     std::mutex gc_locker_{};
-    Vector<LRUCache> lru_caches_{};
+    Vector<ClockCache> gc_clocks_{};
     SizeT round_robin_{};
 
     std::mutex clean_locker_{};
@@ -140,7 +169,11 @@ private:
     HashSet<BufferObj *> temp_set_;
     HashSet<BufferObj *> clean_temp_set_;
 
-    Atomic<u64> total_request_count_{0};
+    // Striped by thread, every pin adds to it and one shared counter would bounce between all the scanning threads.
+    struct alignas(64) RequestCounter {
+        Atomic<u64> count_{0};
+    };
+    Array<RequestCounter, BUFFER_MANAGER_REQUEST_COUNTER_STRIPES> request_counters_{};
     Atomic<u64> cache_miss_count_{0};
 };
 
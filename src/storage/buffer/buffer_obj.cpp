@@ -69,6 +69,14 @@ void BufferObj::UpdateFileWorkerInfo(UniquePtr<FileWorker> new_file_worker) {
 
 BufferHandle BufferObj::Load() {
     buffer_mgr_->AddRequestCount();
+    u64 rc = rc_.load(std::memory_order_acquire);
+    while (rc > 0) {
+        if (rc_.compare_exchange_weak(rc, rc + 1, std::memory_order_acq_rel, std::memory_order_acquire)) {
+            void *data = type_ == BufferType::kMmap ? file_worker_->GetMmapData() : file_worker_->GetData();
+            return BufferHandle(this, data);
+        }
+    }
+
     std::unique_lock<std::mutex> locker(w_locker_);
     if (type_ == BufferType::kMmap) {
         switch (status_) {
@@ -96,7 +104,7 @@ BufferHandle BufferObj::Load() {
             break;
         }
         case BufferStatus::kUnloaded: {
-            if (!buffer_mgr_->RemoveFromGCQueue(this)) {
+            if (!buffer_mgr_->MarkLoaded(this)) {
                 String error_message = fmt::format("attempt to buffer: {} status is UNLOADED, but not in GC queue", GetFilename());
                 UnrecoverableError(error_message);
             }
@@ -309,12 +317,11 @@ void BufferObj::ToMmap() {
 }
 
 void BufferObj::LoadInner() {
-    std::unique_lock<std::mutex> locker(w_locker_);
-    if (status_ != BufferStatus::kLoaded) {
-        String error_message = fmt::format("Invalid status: {}", BufferStatusToString(status_));
+    // The copied handle holds a reference, so the buffer is loaded and stays loaded.
+    if (rc_.fetch_add(1, std::memory_order_acq_rel) == 0) {
+        String error_message = fmt::format("Copy a handle of unloaded buffer: {}", GetFilename());
         UnrecoverableError(error_message);
     }
-    ++rc_;
 }
 
 void *BufferObj::GetMutPointer() {
@@ -334,14 +341,22 @@ void *BufferObj::GetMutPointer() {
 }
 
 void BufferObj::UnloadInner() {
+    u64 rc = rc_.load(std::memory_order_acquire);
+    while (rc > 1) {
+        if (rc_.compare_exchange_weak(rc, rc - 1, std::memory_order_acq_rel, std::memory_order_acquire)) {
+            return;
+        }
+    }
+
     std::unique_lock<std::mutex> locker(w_locker_);
-    if (status_ != BufferStatus::kLoaded) {
+    if (status_ != BufferStatus::kLoaded || rc_ == 0) {
         String error_message = fmt::format("Invalid status: {}", BufferStatusToString(status_));
         UnrecoverableError(error_message);
     }
-    --rc_;
-    if (rc_ == 0) {
+    if (--rc_ == 0) {
         if (type_ == BufferType::kToMmap) {
+            // it may still have the slot it kept when it was loaded again
+            buffer_mgr_->RemoveFromGCQueue(this);
             file_worker_->FreeInMemory();
             buffer_mgr_->FreeUnloadBuffer(this);
             status_ = BufferStatus::kFreed;
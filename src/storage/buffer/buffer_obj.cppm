@@ -157,8 +157,11 @@ protected:
     BufferManager *buffer_mgr_;
 
     BufferStatus status_{BufferStatus::kNew};
-    BufferType type_{BufferType::kTemp};
-    u64 rc_{0};
+    // Read without w_locker_ by the fast path of Load
+    Atomic<BufferType> type_{BufferType::kTemp};
+    // The buffer is kLoaded while rc_ > 0. Pins and unpins that keep rc_ above 0 skip w_locker_,
+    // the ones moving rc_ from or to 0 change the status under w_locker_.
+    Atomic<u64> rc_{0};
     UniquePtr<FileWorker> file_worker_;
 
 private:
@@ -0,0 +1,110 @@
+// Copyright(C) 2023 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+module;
+
+module diskann_index_file_worker;
+
+import stl;
+import index_file_worker;
+import file_worker;
+import index_base;
+import index_diskann;
+import diskann_index_in_chunk;
+import embedding_info;
+import column_def;
+import infinity_exception;
+import logical_type;
+import logger;
+import third_party;
+import persistence_manager;
+import utility;
+
+namespace infinity {
+
+DiskAnnIndexFileWorker::~DiskAnnIndexFileWorker() {
+    if (data_ != nullptr) {
+        FreeInMemory();
+        data_ = nullptr;
+    }
+}
+
+void DiskAnnIndexFileWorker::AllocateInMemory() {
+    if (data_) [[unlikely]] {
+        UnrecoverableError("AllocateInMemory: Already allocated.");
+    }
+    if (index_base_->index_type_ != IndexType::kDiskAnn) {
+        UnrecoverableError("Index type is mismatched");
+    }
+    const auto *index_diskann = static_cast<const IndexDiskAnn *>(index_base_.get());
+    data_ = static_cast<void *>(new DiskAnnIndexInChunk(index_diskann, Dimension(), start_segment_offset_, BuildDir()));
+}
+
+void DiskAnnIndexFileWorker::FreeInMemory() {
+    if (data_) [[likely]] {
+        auto *index = static_cast<DiskAnnIndexInChunk *>(data_);
+        delete index;
+        data_ = nullptr;
+        LOG_TRACE("Finished FreeInMemory(), deleted data_ ptr.");
+    } else {
+        UnrecoverableError("FreeInMemory: Data is not allocated.");
+    }
+}
+
+SizeT DiskAnnIndexFileWorker::GetMemoryCost() const {
+    const auto *index_diskann = static_cast<const IndexDiskAnn *>(index_base_.get());
+    return DiskAnnIndexInChunk::EstimateMemoryCost(index_diskann, Dimension(), row_count_);
+}
+
+bool DiskAnnIndexFileWorker::WriteToFileImpl(bool to_spill, bool &prepare_success, const FileWorkerSaveCtx &ctx) {
+    if (data_) [[likely]] {
+        auto *index = static_cast<DiskAnnIndexInChunk *>(data_);
+        index->SaveIndexInner(*file_handle_);
+        prepare_success = true;
+        LOG_TRACE("Finished WriteToFileImpl(bool &prepare_success).");
+    } else {
+        UnrecoverableError("WriteToFileImpl: data_ is nullptr");
+    }
+    return true;
+}
+
+void DiskAnnIndexFileWorker::ReadFromFileImpl(SizeT file_size, bool from_spill) {
+    if (data_) [[unlikely]] {
+        UnrecoverableError("ReadFromFileImpl: data_ is not nullptr");
+    }
+    const auto *index_diskann = static_cast<const IndexDiskAnn *>(index_base_.get());
+    auto *index = new DiskAnnIndexInChunk(index_diskann, Dimension(), start_segment_offset_, BuildDir());
+    data_ = static_cast<void *>(index);
+    // the object file of the persistence manager could be evicted from the local cache, so keep a private copy of the graph
+    const bool use_object_cache = !from_spill && persistence_manager_ != nullptr;
+    const u64 base_offset = use_object_cache ? obj_addr_.part_offset_ : 0;
+    index->ReadIndexInner(*file_handle_, base_offset, use_object_cache);
+    LOG_TRACE("Finished ReadFromFileImpl().");
+}
+
+String DiskAnnIndexFileWorker::BuildDir() const {
+    String file_path = Path(*file_dir_) / *file_name_;
+    return Path(*temp_dir_) / fmt::format("{}.diskann", StringTransform(file_path, "/", "_"));
+}
+
+u32 DiskAnnIndexFileWorker::Dimension() const {
+    const auto *embedding_info = static_cast<const EmbeddingInfo *>(column_def_->type()->type_info().get());
+    if (embedding_info->Type() != EmbeddingDataType::kElemFloat) {
+        UnrecoverableError("DiskAnn index should be created on float embedding column now.");
+    }
+    return embedding_info->Dimension();
+}
+
+} // namespace infinity
@@ -45,9 +45,13 @@ struct FastPForWrapper<FastPForCodec::SIMDFastPFor>::Impl {
 
 template <>
 struct FastPForWrapper<FastPForCodec::SIMDNewPFor>::Impl {
-    FastPForLib::CompositeCodec<FastPForLib::SIMDNewPFor<4, FastPForLib::Simple16<false>>, FastPForLib::VariableByte> codec;
+    // SIMDNewPFor keeps its exception buffers in the codec, one instance per thread as the posting encoders are shared
+    static thread_local FastPForLib::CompositeCodec<FastPForLib::SIMDNewPFor<4, FastPForLib::Simple16<false>>, FastPForLib::VariableByte> codec;
 };
 
+thread_local FastPForLib::CompositeCodec<FastPForLib::SIMDNewPFor<4, FastPForLib::Simple16<false>>, FastPForLib::VariableByte>
+    FastPForWrapper<FastPForCodec::SIMDNewPFor>::Impl::codec;
+
 template <>
 struct FastPForWrapper<FastPForCodec::StreamVByte>::Impl {
     FastPForLib::StreamVByte codec;
@@ -91,5 +95,7 @@ void FastPForWrapper<Codec>::RevertDelta(u32 *src, SizeT count) {
 
 // template struct FastPForWrapper<FastPForCodec::FastPFor>;
 template struct FastPForWrapper<FastPForCodec::SIMDBitPacking>;
+template struct FastPForWrapper<FastPForCodec::SIMDNewPFor>;
+template struct FastPForWrapper<FastPForCodec::StreamVByte>;
 
 } // namespace infinity
\ No newline at end of file
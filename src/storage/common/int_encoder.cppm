@@ -60,22 +60,34 @@ inline u32 IntEncoder<T, Compressor>::Decode(T *dest, u32 dest_len, ByteSliceRea
     return (u32)compressor_.Decompress(dest, dest_len, (const u32 *)buf_ptr, comp_len);
 }
 
+// u32 encoders of different codecs are chosen per index
+export class Int32EncoderBase {
+public:
+    virtual ~Int32EncoderBase() {}
+
+    // src_len: number of elements in src. Return number of bytes after compression
+    virtual u32 Encode(ByteSliceWriter &slice_writer, const u32 *src, u32 src_len) const = 0;
+
+    // return number of elements
+    virtual u32 Decode(u32 *dest, u32 dest_len, ByteSliceReader &slice_reader) const = 0;
+};
+
 export template <FastPForCodec Codec>
-class IntEncoder<u32, FastPForWrapper<Codec>> {
+class IntEncoder<u32, FastPForWrapper<Codec>> final : public Int32EncoderBase {
 public:
     const static size_t ENCODER_BUFFER_SIZE = 1024;
     const static size_t ENCODER_BUFFER_BYTE_SIZE = ENCODER_BUFFER_SIZE * sizeof(u32);
 
 public:
     IntEncoder() {}
-    virtual ~IntEncoder() {}
+    ~IntEncoder() override {}
 
 public:
     // src_len: number of elements in src. Return number of bytes after compression
-    inline u32 Encode(ByteSliceWriter &slice_writer, const u32 *src, u32 src_len) const;
+    u32 Encode(ByteSliceWriter &slice_writer, const u32 *src, u32 src_len) const override;
 
     // return number of elements
-    inline u32 Decode(u32 *dest, u32 dest_len, ByteSliceReader &slice_reader) const;
+    u32 Decode(u32 *dest, u32 dest_len, ByteSliceReader &slice_reader) const override;
 
 private:
     FastPForWrapper<Codec> compressor_{};
@@ -64,6 +64,7 @@ export struct TableIndexInfo {
     SharedPtr<String> index_other_params_{};
     SharedPtr<String> index_column_ids_{};
     SharedPtr<String> index_column_names_{};
+    SharedPtr<String> training_progress_{};
 };
 
 export struct SegmentInfo {
@@ -51,6 +51,9 @@ String MetricTypeToString(MetricType metric_type) {
         case MetricType::kMetricL2: {
             return "l2";
         }
+        case MetricType::kMetricHamming: {
+            return "hamming";
+        }
         case MetricType::kInvalid: {
             return "Invalid";
         }
@@ -64,6 +67,8 @@ MetricType StringToMetricType(const String &str) {
         return MetricType::kMetricInnerProduct;
     } else if (str == "l2") {
         return MetricType::kMetricL2;
+    } else if (str == "hamming") {
+        return MetricType::kMetricHamming;
     } else {
         return MetricType::kInvalid;
     }
@@ -288,7 +293,11 @@ SharedPtr<IndexBase> IndexBase::Deserialize(const nlohmann::json &index_def_json
         }
         case IndexType::kFullText: {
             String analyzer = index_def_json["analyzer"];
-            res = MakeShared<IndexFullText>(index_name, index_comment, file_name, std::move(column_names), analyzer);
+            optionflag_t flag = OPTION_FLAG_ALL;
+            if (index_def_json.contains("flag")) {
+                flag = index_def_json["flag"];
+            }
+            res = MakeShared<IndexFullText>(index_name, index_comment, file_name, std::move(column_names), analyzer, flag);
             break;
         }
         case IndexType::kSecondary: {
@@ -28,6 +28,7 @@ export enum class MetricType {
     kMetricCosine,
     kMetricInnerProduct,
     kMetricL2,
+    kMetricHamming,
     kInvalid,
 };
 
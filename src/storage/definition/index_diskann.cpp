@@ -31,6 +31,8 @@ import index_base;
 import logical_type;
 import statement_common;
 import logger;
+import type_info;
+import embedding_info;
 
 namespace infinity {
 
@@ -87,6 +89,10 @@ SharedPtr<IndexBase> IndexDiskAnn::Make(SharedPtr<String> index_name,
         Status status = Status::InvalidIndexParam("Metric type");
         RecoverableError(status);
     }
+    if (metric_type != MetricType::kMetricL2) {
+        Status status = Status::NotSupport(fmt::format("DiskAnn index with metric: {}", MetricTypeToString(metric_type)));
+        RecoverableError(status);
+    }
 
     if (encode_type == DiskAnnEncodeType::kInvalid) {
         Status status = Status::InvalidIndexParam("Encode type");
@@ -164,6 +170,13 @@ void IndexDiskAnn::ValidateColumnDataType(const SharedPtr<BaseTableRef> &base_ta
         Status status = Status::InvalidIndexDefinition(
             fmt::format("Attempt to create DsikAnn index on column: {}, data type: {}.", column_name, data_type->ToString()));
         RecoverableError(status);
+    } else if (const auto embedding_info = static_cast<EmbeddingInfo *>(data_type->type_info().get());
+               embedding_info->Type() != EmbeddingDataType::kElemFloat) {
+        Status status = Status::InvalidIndexDefinition(fmt::format("Attempt to create DiskAnn index on column: {}, data type: {}, embedding info: {}.",
+                                                                   column_name,
+                                                                   data_type->ToString(),
+                                                                   embedding_info->ToString()));
+        RecoverableError(status);
     }
 }
 
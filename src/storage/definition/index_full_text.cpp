@@ -38,6 +38,22 @@ namespace infinity {
 
 void ToLowerString(String &lower) { std::transform(lower.begin(), lower.end(), lower.begin(), ::tolower); }
 
+namespace {
+
+String PostingCodecToString(const PostingCodec codec) {
+    switch (codec) {
+        case PostingCodec::kSIMDBitPacking:
+            return "bitpacking";
+        case PostingCodec::kSIMDNewPFor:
+            return "newpfor";
+        case PostingCodec::kStreamVByte:
+            return "streamvbyte";
+    }
+    return "unknown";
+}
+
+} // namespace
+
 SharedPtr<IndexBase> IndexFullText::Make(SharedPtr<String> index_name,
                                          SharedPtr<String> index_comment,
                                          const String &file_name,
@@ -45,6 +61,8 @@ SharedPtr<IndexBase> IndexFullText::Make(SharedPtr<String> index_name,
                                          const Vector<InitParameter *> &index_param_list) {
     String analyzer_name{};
     optionflag_t flag = OPTION_FLAG_ALL;
+    bool realtime = false;
+    PostingCodec codec = PostingCodec::kSIMDBitPacking;
     SizeT param_count = index_param_list.size();
     for (SizeT param_idx = 0; param_idx < param_count; ++param_idx) {
         InitParameter *parameter = index_param_list[param_idx];
@@ -53,12 +71,26 @@ SharedPtr<IndexBase> IndexFullText::Make(SharedPtr<String> index_name,
         if (para_name == "analyzer") {
             analyzer_name = parameter->param_value_;
         } else if (para_name == "flag") {
-            flag = std::strtoul(parameter->param_value_.c_str(), nullptr, 10);
+            // the codec bits are set only by the codec parameter
+            flag = std::strtoul(parameter->param_value_.c_str(), nullptr, 10) & ~POSTING_CODEC_MASK;
+        } else if (para_name == "codec") {
+            String codec_str = parameter->param_value_;
+            ToLowerString(codec_str);
+            if (codec_str == "bitpacking") {
+                codec = PostingCodec::kSIMDBitPacking;
+            } else if (codec_str == "newpfor") {
+                codec = PostingCodec::kSIMDNewPFor;
+            } else if (codec_str == "streamvbyte") {
+                codec = PostingCodec::kStreamVByte;
+            } else {
+                Status status = Status::InvalidIndexParam("Codec");
+                RecoverableError(status);
+            }
         } else if (para_name == "realtime") {
             String realtime_str = parameter->param_value_;
             ToLowerString(realtime_str);
             if (realtime_str == "true") {
-                FlagAddRealtime(flag);
+                realtime = true;
             } else if (realtime_str != "false") {
                 LOG_WARN(fmt::format("Unknown parameter value: {}, {}", para_name, parameter->param_value_));
             }
@@ -66,6 +98,11 @@ SharedPtr<IndexBase> IndexFullText::Make(SharedPtr<String> index_name,
             LOG_WARN(fmt::format("Unknown parameter: {}", para_name));
         }
     }
+    // applied after the flag parameter, whatever the order of the parameters
+    FlagSetCodec(flag, codec);
+    if (realtime) {
+        FlagAddRealtime(flag);
+    }
     if (analyzer_name.empty()) {
         analyzer_name = "standard";
     }
@@ -110,12 +147,16 @@ String IndexFullText::ToString() const {
 String IndexFullText::BuildOtherParamsString() const {
     std::stringstream ss;
     ss << "analyzer = " << analyzer_;
+    if (const auto codec = FlagGetCodec(flag_); codec != PostingCodec::kSIMDBitPacking) {
+        ss << ", codec = " << PostingCodecToString(codec);
+    }
     return ss.str();
 }
 
 nlohmann::json IndexFullText::Serialize() const {
     nlohmann::json res = IndexBase::Serialize();
     res["analyzer"] = analyzer_;
+    res["flag"] = flag_;
     return res;
 }
 
@@ -43,6 +43,10 @@ HnswEncodeType StringToHnswEncodeType(const String &str) {
         return HnswEncodeType::kPlain;
     } else if (str == "lvq") {
         return HnswEncodeType::kLVQ;
+    } else if (str == "pq") {
+        return HnswEncodeType::kPQ;
+    } else if (str == "rabitq") {
+        return HnswEncodeType::kRaBitQ;
     } else {
         return HnswEncodeType::kInvalid;
     }
@@ -54,6 +58,10 @@ String HnswEncodeTypeToString(HnswEncodeType encode_type) {
             return "plain";
         case HnswEncodeType::kLVQ:
             return "lvq";
+        case HnswEncodeType::kPQ:
+            return "pq";
+        case HnswEncodeType::kRaBitQ:
+            return "rabitq";
         default:
             return "invalid";
     }
@@ -302,17 +310,43 @@ void IndexHnsw::ValidateColumnDataType(const SharedPtr<BaseTableRef> &base_table
     const auto embedding_info = dynamic_cast<const EmbeddingInfo *>(data_type_ptr->type_info().get());
     const EmbeddingDataType embedding_data_type = embedding_info->Type();
     for (const auto *param : index_param_list) {
-        if (param->param_name_ == "encode" && StringToHnswEncodeType(param->param_value_) == HnswEncodeType::kLVQ) {
+        if (param->param_name_ != "metric") {
+            continue;
+        }
+        // bit embeddings are only indexed by hamming distance, which only applies to bit embeddings
+        const bool hamming = StringToMetricType(param->param_value_) == MetricType::kMetricHamming;
+        const bool bit_embedding = embedding_data_type == EmbeddingDataType::kElemBit && data_type_ptr->type() == LogicalType::kEmbedding;
+        if (hamming != bit_embedding) {
+            RecoverableError(Status::InvalidIndexDefinition(fmt::format("Attempt to create HNSW index with {} metric on column: {}, data type: {}.",
+                                                                        param->param_value_,
+                                                                        column_name,
+                                                                        data_type_ptr->ToString())));
+        }
+    }
+    for (const auto *param : index_param_list) {
+        if (param->param_name_ != "encode") {
+            continue;
+        }
+        HnswEncodeType encode_type = StringToHnswEncodeType(param->param_value_);
+        if (encode_type == HnswEncodeType::kLVQ || encode_type == HnswEncodeType::kPQ || encode_type == HnswEncodeType::kRaBitQ) {
             // TODO: now only support float?
             if (embedding_data_type != EmbeddingDataType::kElemFloat) {
                 RecoverableError(Status::InvalidIndexDefinition(
-                    fmt::format("Attempt to create HNSW index with LVQ encoding on column: {}, data type: {}. now only support float element type.",
+                    fmt::format("Attempt to create HNSW index with {} encoding on column: {}, data type: {}. now only support float element type.",
+                                HnswEncodeTypeToString(encode_type),
                                 column_name,
                                 data_type_ptr->ToString())));
             }
         }
+        if (encode_type == HnswEncodeType::kPQ || encode_type == HnswEncodeType::kRaBitQ) {
+            for (const auto *build_param : index_param_list) {
+                if (build_param->param_name_ == "build_type" && StringToHnswBuildType(build_param->param_value_) == HnswBuildType::kLSG) {
+                    RecoverableError(Status::InvalidIndexDefinition(
+                        fmt::format("Attempt to create HNSW index with {} encoding and LSG build on column: {}.", param->param_value_, column_name)));
+                }
+            }
+        }
     }
-    // TODO: now only support float, int8, uint8?
     switch (embedding_data_type) {
         case EmbeddingDataType::kElemFloat:
         case EmbeddingDataType::kElemInt8:
@@ -320,9 +354,22 @@ void IndexHnsw::ValidateColumnDataType(const SharedPtr<BaseTableRef> &base_table
             // supported
             break;
         }
+        case EmbeddingDataType::kElemFloat16:
+        case EmbeddingDataType::kElemBFloat16:
+        case EmbeddingDataType::kElemBit: {
+            for (const auto *param : index_param_list) {
+                if (param->param_name_ == "build_type" && StringToHnswBuildType(param->param_value_) == HnswBuildType::kLSG) {
+                    RecoverableError(Status::InvalidIndexDefinition(
+                        fmt::format("Attempt to create HNSW index with LSG build on column: {}, data type: {}. now only support float element type.",
+                                    column_name,
+                                    data_type_ptr->ToString())));
+                }
+            }
+            break;
+        }
         default: {
             RecoverableError(Status::InvalidIndexDefinition(
-                fmt::format("Attempt to create HNSW index on column: {}, data type: {}. now only support float, int8, uint8 element type.",
+                fmt::format("Attempt to create HNSW index on column: {}, data type: {}. now only support float, float16, bfloat16, int8, uint8, bit element type.",
                             column_name,
                             data_type_ptr->ToString())));
         }
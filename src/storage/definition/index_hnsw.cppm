@@ -30,6 +30,8 @@ namespace infinity {
 export enum class HnswEncodeType {
     kPlain,
     kLVQ,
+    kPQ,
+    kRaBitQ,
     kInvalid,
 };
 
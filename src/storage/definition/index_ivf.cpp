@@ -116,6 +116,9 @@ SharedPtr<IndexIVF> IndexIVF::Make(SharedPtr<String> index_name,
         if (const auto nh = params_map.extract("max_points_per_centroid"); nh) {
             ivf_option.centroid_option_.max_points_per_centroid_ = GetIntegerFromNodeHandler<u32>(nh);
         }
+        if (const auto nh = params_map.extract("kmeans_mini_batch"); nh) {
+            ivf_option.centroid_option_.kmeans_mini_batch_ = GetIntegerFromNodeHandler<u32>(nh);
+        }
     }
     {
         // IndexIVFStorageOption
@@ -176,7 +179,8 @@ void CheckIndexIVFStorageOption(IndexIVFStorageOption &storage_option, const Dat
             // check plain_storage_data_type_
             switch (storage_option.plain_storage_data_type_) {
                 case EmbeddingDataType::kElemInt8:
-                case EmbeddingDataType::kElemUInt8: {
+                case EmbeddingDataType::kElemUInt8:
+                case EmbeddingDataType::kElemBit: {
                     if (storage_option.plain_storage_data_type_ != embedding_data_type) {
                         RecoverableError(
                             Status::InvalidIndexDefinition(std::format("Invalid plain storage type: {} on Embedding column: {}",
@@ -211,21 +215,21 @@ void CheckIndexIVFStorageOption(IndexIVFStorageOption &storage_option, const Dat
                     break;
                 }
                 case EmbeddingDataType::kElemDouble:
-                case EmbeddingDataType::kElemBit:
                 case EmbeddingDataType::kElemInt16:
                 case EmbeddingDataType::kElemInt32:
                 case EmbeddingDataType::kElemInt64: {
                     RecoverableError(Status::InvalidIndexDefinition(
                         std::format("Invalid plain storage type: {}.",
                                     EmbeddingT::EmbeddingDataType2String(storage_option.plain_storage_data_type_)) +
-                        " Can only choose: int8 for int8, uint8 for uint8, float, float16 or bfloat16 for floating type"));
+                        " Can only choose: int8 for int8, uint8 for uint8, bit for bit, float, float16 or bfloat16 for floating type"));
                     break;
                 }
                 case EmbeddingDataType::kElemInvalid: {
-                    // i8 -> i8, u8 -> u8, floating -> f32
+                    // i8 -> i8, u8 -> u8, bit -> bit, floating -> f32
                     switch (embedding_data_type) {
                         case EmbeddingDataType::kElemUInt8:
-                        case EmbeddingDataType::kElemInt8: {
+                        case EmbeddingDataType::kElemInt8:
+                        case EmbeddingDataType::kElemBit: {
                             storage_option.plain_storage_data_type_ = embedding_data_type;
                             break;
                         }
@@ -236,7 +240,6 @@ void CheckIndexIVFStorageOption(IndexIVFStorageOption &storage_option, const Dat
                             storage_option.plain_storage_data_type_ = EmbeddingDataType::kElemFloat;
                             break;
                         }
-                        case EmbeddingDataType::kElemBit:
                         case EmbeddingDataType::kElemInt16:
                         case EmbeddingDataType::kElemInt32:
                         case EmbeddingDataType::kElemInt64:
@@ -333,12 +336,27 @@ void IndexIVF::ValidateColumnDataType(const SharedPtr<BaseTableRef> &base_table_
         if (ivf_option_.metric_ == MetricType::kInvalid) {
             RecoverableError(Status::InvalidIndexDefinition("Invalid metric type"));
         }
+        // hamming metric is for bit embedding only, and bit embedding only supports hamming
+        const auto embedding_data_type = static_cast<const EmbeddingInfo *>(data_type->type_info().get())->Type();
+        const bool is_bit_embedding = data_type->type() == LogicalType::kEmbedding && embedding_data_type == EmbeddingDataType::kElemBit;
+        if ((ivf_option_.metric_ == MetricType::kMetricHamming) != is_bit_embedding ||
+            (data_type->type() == LogicalType::kMultiVector && embedding_data_type == EmbeddingDataType::kElemBit)) {
+            RecoverableError(Status::InvalidIndexDefinition(std::format("Attempt to create IVF index with {} metric on column: {}, data type: {}.",
+                                                                        MetricTypeToString(ivf_option_.metric_),
+                                                                        column_name,
+                                                                        data_type->ToString())));
+        }
         CheckIndexIVFCentroidOption(ivf_option_.centroid_option_);
         CheckIndexIVFStorageOption(ivf_option_.storage_option_, data_type.get());
     }
 }
 
-NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(IndexIVFCentroidOption, centroids_num_ratio_, min_points_per_centroid_, max_points_per_centroid_);
+// kmeans_mini_batch_ is missing in the indexes created by older versions
+NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE_WITH_DEFAULT(IndexIVFCentroidOption,
+                                                centroids_num_ratio_,
+                                                min_points_per_centroid_,
+                                                max_points_per_centroid_,
+                                                kmeans_mini_batch_);
 NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(IndexIVFStorageOption,
                                    type_,
                                    plain_storage_data_type_,
@@ -358,10 +376,12 @@ IndexIVFOption IndexIVF::DeserializeIndexIVFOption(const nlohmann::json &ivf_opt
 String BuildIndexIVFStorageOptionStr();
 
 String IndexIVFCentroidOption::ToString() const {
-    return std::format("IndexIVFCentroidOption: [centroids_num_ratio: {}, min_points_per_centroid: {}, max_points_per_centroid: {}]",
-                       centroids_num_ratio_,
-                       min_points_per_centroid_,
-                       max_points_per_centroid_);
+    return std::format(
+        "IndexIVFCentroidOption: [centroids_num_ratio: {}, min_points_per_centroid: {}, max_points_per_centroid: {}, kmeans_mini_batch: {}]",
+        centroids_num_ratio_,
+        min_points_per_centroid_,
+        max_points_per_centroid_,
+        kmeans_mini_batch_);
 }
 
 String IndexIVFStorageOption::ToString() const {
@@ -30,6 +30,7 @@ export struct IndexIVFCentroidOption {
     float centroids_num_ratio_ = 1.0f;  // centroid_num = ratio * sqrt(embedding_num)
     u32 min_points_per_centroid_ = 32;  // for training centroids
     u32 max_points_per_centroid_ = 256; // for training centroids
+    u32 kmeans_mini_batch_ = 0;         // vectors per mini-batch k-means iteration, 0 for full batch training
     bool operator==(const IndexIVFCentroidOption &other) const = default;
     String ToString() const;
 };
@@ -42,6 +42,7 @@ import third_party;
 import term_doc_iterator;
 import default_values;
 import logger;
+import fst;
 
 namespace infinity {
 void ColumnIndexReader::Open(optionflag_t flag, String &&index_dir, Map<SegmentID, SharedPtr<SegmentIndexEntry>> &&index_by_segment, Txn *txn) {
@@ -92,9 +93,114 @@ UniquePtr<PostingIterator> ColumnIndexReader::Lookup(const String &term, bool fe
     auto iter = MakeUnique<PostingIterator>(flag_);
     u32 state_pool_size = 0; // TODO
     iter->Init(std::move(seg_postings), state_pool_size);
+    if (whole_column_doc_freq_) {
+        // the idf comes from the doc freq of the whole column
+        std::lock_guard lock(whole_column_doc_freq_->mutex_);
+        auto [it, inserted] = whole_column_doc_freq_->term_doc_freq_.try_emplace(term, 0);
+        if (inserted) {
+            it->second = whole_column_doc_freq_->whole_reader_->GetTermDocFreq(term);
+        }
+        iter->SetDocFreq(it->second);
+    }
     return iter;
 }
 
+u32 ColumnIndexReader::GetTermDocFreq(const String &term) const {
+    u32 doc_freq = 0;
+    for (const auto &segment_reader : segment_readers_) {
+        SegmentPosting seg_posting;
+        if (segment_reader->GetSegmentPosting(term, seg_posting, false)) {
+            doc_freq += seg_posting.GetTermMeta().GetDocFreq();
+        }
+    }
+    return doc_freq;
+}
+
+Vector<String> ColumnIndexReader::ExpandTerms(FstAutomaton &aut, SizeT max_terms) const {
+    if (whole_column_doc_freq_) {
+        // all the parts search the same terms
+        return whole_column_doc_freq_->whole_reader_->ExpandTerms(aut, max_terms);
+    }
+    Vector<String> terms;
+    for (const auto &segment_reader : segment_readers_) {
+        segment_reader->ExpandTerms(aut, max_terms, terms);
+    }
+    std::sort(terms.begin(), terms.end());
+    terms.erase(std::unique(terms.begin(), terms.end()), terms.end());
+    if (terms.size() > max_terms) {
+        terms.resize(max_terms);
+    }
+    return terms;
+}
+
+Vector<SharedPtr<ColumnIndexReader>> ColumnIndexReader::SplitBySegment(const Map<SegmentID, u32> &segment_part, const u32 part_n) {
+    const auto [total_df, avg_column_length] = GetTotalDfAndAvgColumnLength();
+    auto whole_column_doc_freq = MakeShared<WholeColumnDocFreq>();
+    whole_column_doc_freq->whole_reader_ = this;
+    Vector<SharedPtr<ColumnIndexReader>> parts(part_n);
+    for (auto &part : parts) {
+        part = MakeShared<ColumnIndexReader>();
+        part->flag_ = flag_;
+        part->total_df_ = total_df;
+        part->avg_column_length_ = avg_column_length;
+        part->whole_column_doc_freq_ = whole_column_doc_freq;
+        part->column_name_ = column_name_;
+        part->analyzer_ = analyzer_;
+        part->index_dir_ = index_dir_;
+    }
+    auto get_part = [&](const SegmentID segment_id) -> ColumnIndexReader * {
+        const auto it = segment_part.find(segment_id);
+        return it == segment_part.end() ? nullptr : parts[it->second].get();
+    };
+    // the readers of a part keep their ascending order
+    for (const auto &segment_reader : segment_readers_) {
+        if (auto *part = get_part(segment_reader->segment_id()); part != nullptr) {
+            part->segment_readers_.push_back(segment_reader);
+        }
+    }
+    for (const auto &[segment_id, segment_index_entry] : index_by_segment_) {
+        if (auto *part = get_part(segment_id); part != nullptr) {
+            part->index_by_segment_.emplace(segment_id, segment_index_entry);
+        }
+    }
+    for (const auto &chunk_index_entry : chunk_index_entries_) {
+        if (auto *part = get_part(chunk_index_entry->segment_index_entry_->segment_id()); part != nullptr) {
+            part->chunk_index_entries_.push_back(chunk_index_entry);
+        }
+    }
+    if (memory_indexer_) {
+        for (const auto &segment_reader : segment_readers_) {
+            if (dynamic_cast<const InMemIndexSegmentReader *>(segment_reader.get()) != nullptr) {
+                if (auto *part = get_part(segment_reader->segment_id()); part != nullptr) {
+                    part->memory_indexer_ = memory_indexer_;
+                }
+            }
+        }
+    }
+    return parts;
+}
+
+Vector<SharedPtr<IndexReader>> IndexReader::SplitBySegment(const Map<SegmentID, u32> &segment_part, const u32 part_n) const {
+    using ColumnReaderMap = FlatHashMap<u64, SharedPtr<Map<String, SharedPtr<ColumnIndexReader>>>, detail::Hash<u64>>;
+    Vector<SharedPtr<IndexReader>> parts(part_n);
+    for (auto &part : parts) {
+        part = MakeShared<IndexReader>();
+        part->column_index_readers_ = MakeShared<ColumnReaderMap>();
+    }
+    for (const auto &[column_id, index_map] : *column_index_readers_) {
+        for (auto &part : parts) {
+            (*part->column_index_readers_)[column_id] = MakeShared<Map<String, SharedPtr<ColumnIndexReader>>>();
+        }
+        for (const auto &[index_name, column_index_reader] : *index_map) {
+            auto column_parts = column_index_reader->SplitBySegment(segment_part, part_n);
+            for (u32 i = 0; i < part_n; ++i) {
+                (*parts[i]->column_index_readers_)[column_id]->emplace(index_name, std::move(column_parts[i]));
+            }
+        }
+    }
+    return parts;
+}
+
 Pair<u64, float> ColumnIndexReader::GetTotalDfAndAvgColumnLength() {
     std::lock_guard lock(mutex_);
     if (total_df_ == 0) {
@@ -27,12 +27,20 @@ import internal_types;
 import segment_index_entry;
 import chunk_index_entry;
 import logger;
+import fst;
 
 namespace infinity {
 struct TableEntry;
 class TermDocIterator;
 class Txn;
 class MemoryIndexer;
+class ColumnIndexReader;
+
+struct WholeColumnDocFreq {
+    ColumnIndexReader *whole_reader_ = nullptr;
+    std::mutex mutex_;
+    HashMap<String, u32> term_doc_freq_;
+};
 
 export class ColumnIndexReader {
 public:
@@ -42,6 +50,13 @@ public:
 
     Pair<u64, float> GetTotalDfAndAvgColumnLength();
 
+    // The first max_terms terms of the column matched by the automaton, in lexicographical order.
+    Vector<String> ExpandTerms(FstAutomaton &aut, SizeT max_terms) const;
+
+    // Readers over the segments with segment_part[segment_id] == i, for searching the parts in parallel.
+    // They keep the doc freqs and the column length statistics of the whole column, so the scores do not change.
+    Vector<SharedPtr<ColumnIndexReader>> SplitBySegment(const Map<SegmentID, u32> &segment_part, u32 part_n);
+
     optionflag_t GetOptionFlag() const { return flag_; }
 
     void InvalidateSegment(SegmentID segment_id);
@@ -61,6 +76,11 @@ private:
     u64 total_df_ = 0;
     float avg_column_length_ = 0.0f;
 
+    // shared by the readers made by one SplitBySegment call
+    SharedPtr<WholeColumnDocFreq> whole_column_doc_freq_{};
+
+    u32 GetTermDocFreq(const String &term) const;
+
 public:
     String column_name_;
     String analyzer_;
@@ -109,6 +129,9 @@ export struct IndexReader {
         return rst;
     }
 
+    // Index readers over the parts of the segments, see ColumnIndexReader::SplitBySegment.
+    Vector<SharedPtr<IndexReader>> SplitBySegment(const Map<SegmentID, u32> &segment_part, u32 part_n) const;
+
     // column_id -> [index_name -> column_index_reader]
     SharedPtr<FlatHashMap<u64, SharedPtr<Map<String, SharedPtr<ColumnIndexReader>>>, detail::Hash<u64>>> column_index_readers_;
 };
@@ -211,7 +211,7 @@ void ColumnInverter::Sort() {
                                                                                        16);
 }
 
-MemUsageChange ColumnInverter::GeneratePosting() {
+MemUsageChange ColumnInverter::GeneratePosting(SizeT pos_begin, SizeT pos_end) {
     u32 last_term_num = std::numeric_limits<u32>::max();
     u32 last_doc_id = INVALID_DOCID;
     u16 last_doc_payload = 0;
@@ -220,7 +220,9 @@ MemUsageChange ColumnInverter::GeneratePosting() {
     MemUsageChange ret{true, 0};
     Map<StringRef, PostingWriter *> modified_writers;
     // printf("GeneratePosting() begin begin_doc_id_ %u, doc_count_ %u, merged_ %u", begin_doc_id_, doc_count_, merged_);
-    for (auto &i : positions_) {
+    assert(pos_begin == 0 || pos_begin == positions_.size() || positions_[pos_begin - 1].term_num_ != positions_[pos_begin].term_num_);
+    for (SizeT pos = pos_begin; pos < pos_end; ++pos) {
+        const PosInfo &i = positions_[pos];
         if (last_term_num != i.term_num_) {
             if (last_doc_id != INVALID_DOCID) {
                 assert(posting.get() != nullptr);
@@ -265,6 +267,50 @@ MemUsageChange ColumnInverter::GeneratePosting() {
     return ret;
 }
 
+Vector<SizeT> ColumnInverter::SplitPositions(SizeT part_num) const {
+    const SizeT n = positions_.size();
+    Vector<SizeT> boundaries{0};
+    for (SizeT i = 1; i < part_num; ++i) {
+        SizeT boundary = std::max(n * i / part_num, boundaries.back());
+        // move forward to the first position of the next term
+        while (boundary > 0 && boundary < n && positions_[boundary - 1].term_num_ == positions_[boundary].term_num_) {
+            ++boundary;
+        }
+        if (boundary > boundaries.back() && boundary < n) {
+            boundaries.push_back(boundary);
+        }
+    }
+    boundaries.push_back(n);
+    return boundaries;
+}
+
+Vector<String> ColumnInverter::SampleSplitters(SizeT range_num) const {
+    Vector<String> splitters;
+    for (SizeT boundary : SplitPositions(range_num)) {
+        if (boundary > 0 && boundary < positions_.size()) {
+            splitters.emplace_back(GetTermFromNum(positions_[boundary].term_num_));
+        }
+    }
+    return splitters;
+}
+
+Vector<SizeT> ColumnInverter::PartitionPositions(const Vector<String> &splitters) const {
+    Vector<SizeT> boundaries{0};
+    for (const String &splitter : splitters) {
+        // term_refs_ holds the sorted distinct terms, indexed by the term number
+        const auto term_it = std::lower_bound(term_refs_.begin(), term_refs_.end(), splitter, [this](const u32 term_ref, const String &term) {
+            return std::strcmp(GetTermFromRef(term_ref), term.c_str()) < 0;
+        });
+        const u32 term_num = term_it - term_refs_.begin();
+        const auto pos_it = std::lower_bound(positions_.begin() + boundaries.back(), positions_.end(), term_num, [](const PosInfo &p, const u32 num) {
+            return p.term_num_ < num;
+        });
+        boundaries.push_back(pos_it - positions_.begin());
+    }
+    boundaries.push_back(positions_.size());
+    return boundaries;
+}
+
 void ColumnInverter::SortForOfflineDump() {
     MergePrepare();
     Sort();
@@ -279,7 +325,7 @@ void ColumnInverter::SortForOfflineDump() {
 //                   ----------------------------------------------------------------------------------------------------------------------------+
 //                                                            Data within each group
 
-void ColumnInverter::SpillSortResults(FILE *spill_file, u64 &tuple_count, UniquePtr<BufWriter> &buf_writer) {
+void ColumnInverter::SpillSortResults(FILE *spill_file, u64 &tuple_count, UniquePtr<BufWriter> &buf_writer, SizeT pos_begin, SizeT pos_end) {
     // spill sort results for external merge sort
     // if (positions_.empty()) {
     //    return;
@@ -292,7 +338,7 @@ void ColumnInverter::SpillSortResults(FILE *spill_file, u64 &tuple_count, Unique
     spill_file_tell += sizeof(u32);
 
     // number of tuples
-    u32 num_of_tuples = positions_.size();
+    u32 num_of_tuples = pos_end - pos_begin;
     tuple_count += num_of_tuples;
     buf_writer->Write((const char *)&num_of_tuples, sizeof(u32));
     spill_file_tell += sizeof(u32);
@@ -309,7 +355,8 @@ void ColumnInverter::SpillSortResults(FILE *spill_file, u64 &tuple_count, Unique
     StringRef term;
     u32 record_length = 0;
     char str_null = '\0';
-    for (auto &i : positions_) {
+    for (SizeT pos = pos_begin; pos < pos_end; ++pos) {
+        const PosInfo &i = positions_[pos];
         if (last_term_num != i.term_num_) {
             last_term_num = i.term_num_;
             term = GetTermFromNum(last_term_num);
@@ -53,7 +53,23 @@ public:
 
     void Sort();
 
-    MemUsageChange GeneratePosting();
+    MemUsageChange GeneratePosting() { return GeneratePosting(0, positions_.size()); }
+
+    // Generate posting for the sorted positions within [pos_begin, pos_end), which shall start and end at term boundaries.
+    // Calls on disjoint ranges touch disjoint posting writers, so they are allowed to run concurrently.
+    MemUsageChange GeneratePosting(SizeT pos_begin, SizeT pos_end);
+
+    // Split the sorted positions into at most part_num ranges of similar sizes at term boundaries.
+    // Returns the boundaries of the ranges, from 0 to the number of positions.
+    Vector<SizeT> SplitPositions(SizeT part_num) const;
+
+    // Pick at most range_num - 1 increasing terms splitting the sorted positions into ranges of similar sizes.
+    Vector<String> SampleSplitters(SizeT range_num) const;
+
+    // Returns the boundaries of the sorted positions partitioned by the splitters, from 0 to the number of positions.
+    Vector<SizeT> PartitionPositions(const Vector<String> &splitters) const;
+
+    SizeT GetPositionCount() const { return positions_.size(); }
 
     u32 GetDocCount() { return doc_count_; }
 
@@ -76,7 +92,8 @@ public:
         }
     };
 
-    void SpillSortResults(FILE *spill_file, u64 &tuple_count, UniquePtr<BufWriter> &buf_writer);
+    // Spill the sorted positions within [pos_begin, pos_end) as a run.
+    void SpillSortResults(FILE *spill_file, u64 &tuple_count, UniquePtr<BufWriter> &buf_writer, SizeT pos_begin, SizeT pos_end);
 
     void AddSema(std::binary_semaphore *sema) { semas_.push_back(sema); }
 
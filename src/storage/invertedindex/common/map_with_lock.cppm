@@ -73,6 +73,18 @@ public:
         }
     }
 
+    // Get the first key not less than key_min.
+    // Returns false if there's no such key.
+    bool LowerBound(const KeyType &key_min, KeyType &key) {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        auto it = map_.lower_bound(key_min);
+        if (it == map_.end()) {
+            return false;
+        }
+        key = it->first;
+        return true;
+    }
+
     // WARN: Caller shall ensure there's no concurrent write access
     Map<KeyType, ValueType>::iterator UnsafeBegin() { return map_.begin(); }
 
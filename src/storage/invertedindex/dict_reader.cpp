@@ -86,4 +86,13 @@ bool DictionaryReader::Next(String &term, TermMeta &term_meta) {
     return true;
 }
 
+void DictionaryReader::Search(FstAutomaton &aut, SizeT max_terms, Vector<String> &terms) {
+    FstAutomatonStream s(*fst_, aut);
+    Vector<u8> key;
+    u64 val;
+    for (SizeT n = 0; n < max_terms && s.Next(key, val); ++n) {
+        terms.emplace_back((char *)key.data(), key.size());
+    }
+}
+
 } // namespace infinity
\ No newline at end of file
@@ -43,5 +43,8 @@ public:
     void InitIterator(const String &prefix);
 
     bool Next(String &term, TermMeta &term_meta);
+
+    /// Appends the terms matched by the automaton in lexicographical order, at most max_terms of them.
+    void Search(FstAutomaton &aut, SizeT max_terms, Vector<String> &terms);
 };
 } // namespace infinity
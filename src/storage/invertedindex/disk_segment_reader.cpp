@@ -38,6 +38,7 @@ import persistence_manager;
 import infinity_context;
 import persist_result_handler;
 import virtual_store;
+import fst;
 
 namespace infinity {
 
@@ -124,4 +125,11 @@ bool DiskIndexSegmentReader::GetSegmentPosting(const String &term, SegmentPostin
     return true;
 }
 
+void DiskIndexSegmentReader::ExpandTerms(FstAutomaton &aut, SizeT max_terms, Vector<String> &terms) const {
+    if (!dict_reader_.get()) {
+        return;
+    }
+    dict_reader_->Search(aut, max_terms, terms);
+}
+
 } // namespace infinity
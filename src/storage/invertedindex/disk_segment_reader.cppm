@@ -24,6 +24,7 @@ import dict_reader;
 import file_reader;
 import posting_list_format;
 import internal_types;
+import fst;
 import term_meta;
 
 namespace infinity {
@@ -40,6 +41,8 @@ public:
 
     bool GetSegmentPosting(const String &term, SegmentPosting &seg_posting, bool fetch_position = true) const override;
 
+    void ExpandTerms(FstAutomaton &aut, SizeT max_terms, Vector<String> &terms) const override;
+
 private:
     RowID base_row_id_{INVALID_ROWID};
     SharedPtr<DictionaryReader> dict_reader_;
@@ -40,6 +40,7 @@ public:
         }
         short_list_vbyte_compress_ = 0;
         has_block_max_ = (option_flag & of_block_max) ? 1 : 0;
+        codec_ = static_cast<u8>(FlagGetCodec(option_flag));
         unused_ = 0;
         // when has_block_max_ is set, has_tf_list_ must also be set
         if (has_block_max_ and !has_tf_list_) {
@@ -51,9 +52,10 @@ public:
     bool HasTfList() const { return has_tf_list_ == 1; }
     bool HasDocPayload() const { return has_doc_payload_ == 1; }
     bool HasBlockMax() const { return has_block_max_ == 1; }
+    PostingCodec GetCodec() const { return static_cast<PostingCodec>(codec_); }
     bool operator==(const DocListFormatOption &right) const {
         return has_tf_ == right.has_tf_ && has_tf_list_ == right.has_tf_list_ && has_doc_payload_ == right.has_doc_payload_ &&
-               short_list_vbyte_compress_ == right.short_list_vbyte_compress_ && has_block_max_ == right.has_block_max_;
+               short_list_vbyte_compress_ == right.short_list_vbyte_compress_ && has_block_max_ == right.has_block_max_ && codec_ == right.codec_;
     }
     bool IsShortListVbyteCompress() const { return short_list_vbyte_compress_ == 1; }
     void SetShortListVbyteCompress(bool flag) { short_list_vbyte_compress_ = flag ? 1 : 0; }
@@ -64,7 +66,8 @@ private:
     u8 has_doc_payload_ : 1;
     u8 short_list_vbyte_compress_ : 1;
     u8 has_block_max_ : 1;
-    u8 unused_ : 3;
+    u8 codec_ : 2;
+    u8 unused_ : 1;
 };
 
 export class DocSkipListFormat : public PostingFields {
@@ -151,7 +154,7 @@ private:
             TypedPostingField<u32> *doc_id_field = new TypedPostingField<u32>;
             doc_id_field->location_ = row_count++;
             doc_id_field->offset_ = offset;
-            doc_id_field->encoder_ = GetDocIDEncoder();
+            doc_id_field->encoder_ = GetDocIDEncoder(option.GetCodec());
             values_.push_back(doc_id_field);
             offset += sizeof(u32);
         }
@@ -159,7 +162,7 @@ private:
             TypedPostingField<u32> *tf_field = new TypedPostingField<u32>;
             tf_field->location_ = row_count++;
             tf_field->offset_ = offset;
-            tf_field->encoder_ = GetTFEncoder();
+            tf_field->encoder_ = GetTFEncoder(option.GetCodec());
             values_.push_back(tf_field);
             offset += sizeof(u32);
         }
@@ -52,8 +52,8 @@ class SkipIndexDecoder : public IndexDecoder {
 public:
     SkipIndexDecoder(ByteSliceReader *doc_list_reader, u32 doc_list_begin, const DocListFormatOption &doc_list_format_option)
         : IndexDecoder(doc_list_format_option), skiplist_reader_(nullptr), doc_list_reader_(doc_list_reader), doc_list_begin_pos_(doc_list_begin) {
-        doc_id_encoder_ = GetDocIDEncoder();
-        tf_list_encoder_ = GetTFEncoder();
+        doc_id_encoder_ = GetDocIDEncoder(doc_list_format_option.GetCodec());
+        tf_list_encoder_ = GetTFEncoder(doc_list_format_option.GetCodec());
         doc_payload_encoder_ = GetDocPayloadEncoder();
     }
 
@@ -4,13 +4,19 @@ import stl;
 import int_encoder;
 import no_compress_encoder;
 import vbyte_compress_encoder;
+import fastpfor;
+import index_defines;
+import infinity_exception;
+import status;
 
 module posting_field;
 
 namespace infinity {
 
 struct EncoderProvider {
-    UniquePtr<Int32Encoder> int32_encoder_ = MakeUnique<Int32Encoder>();
+    UniquePtr<Int32Encoder> int32_encoder_ = MakeUnique<IntEncoder<u32, SIMDBitPacking>>();
+    UniquePtr<Int32Encoder> int32_new_pfor_encoder_ = MakeUnique<IntEncoder<u32, SIMDNewPFor>>();
+    UniquePtr<Int32Encoder> int32_stream_vbyte_encoder_ = MakeUnique<IntEncoder<u32, StreamVByte>>();
     UniquePtr<Int16Encoder> int16_encoder_ = MakeUnique<Int16Encoder>();
     UniquePtr<NoCompressEncoder> no_compress_encoder_ = MakeUnique<NoCompressEncoder>();
     UniquePtr<VByteCompressEncoder> vbyte_compress_encoder_ = MakeUnique<VByteCompressEncoder>();
@@ -22,6 +28,20 @@ struct EncoderProvider {
 
     Int32Encoder *GetInt32Encoder() { return int32_encoder_.get(); }
 
+    Int32Encoder *GetInt32Encoder(PostingCodec codec) {
+        switch (codec) {
+            case PostingCodec::kSIMDBitPacking:
+                return int32_encoder_.get();
+            case PostingCodec::kSIMDNewPFor:
+                return int32_new_pfor_encoder_.get();
+            case PostingCodec::kStreamVByte:
+                return int32_stream_vbyte_encoder_.get();
+        }
+        // IndexFullText::Make only sets the known codecs
+        RecoverableError(Status::InvalidIndexParam("Codec"));
+        return nullptr;
+    }
+
     Int16Encoder *GetInt16Encoder() { return int16_encoder_.get(); }
 
     NoCompressEncoder *GetNoCompressEncoder() { return no_compress_encoder_.get(); }
@@ -29,9 +49,9 @@ struct EncoderProvider {
     VByteCompressEncoder *GetVByteCompressEncoder() { return vbyte_compress_encoder_.get(); }
 };
 
-const Int32Encoder *GetDocIDEncoder() { return EncoderProvider::GetInstance()->GetInt32Encoder(); }
+const Int32Encoder *GetDocIDEncoder(PostingCodec codec) { return EncoderProvider::GetInstance()->GetInt32Encoder(codec); }
 
-const Int32Encoder *GetTFEncoder() { return EncoderProvider::GetInstance()->GetInt32Encoder(); }
+const Int32Encoder *GetTFEncoder(PostingCodec codec) { return EncoderProvider::GetInstance()->GetInt32Encoder(codec); }
 
 const Int16Encoder *GetDocPayloadEncoder() { return EncoderProvider::GetInstance()->GetInt16Encoder(); }
 
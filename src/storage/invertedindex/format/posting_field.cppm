@@ -7,6 +7,7 @@ import byte_slice_reader;
 import byte_slice_writer;
 import no_compress_encoder;
 import vbyte_compress_encoder;
+import index_defines;
 
 export module posting_field;
 
@@ -44,7 +45,7 @@ struct ValueTypeTraits<u32> {
 };
 
 // export typedef IntEncoder<u32, NewPForDeltaCompressor> Int32Encoder;
-export typedef IntEncoder<u32, SIMDBitPacking> Int32Encoder;
+export typedef Int32EncoderBase Int32Encoder;
 export typedef IntEncoder<u16, NewPForDeltaCompressor> Int16Encoder;
 export typedef NoCompressIntEncoder<u32> NoCompressEncoder;
 export typedef VByteIntEncoder<u32> VByteCompressEncoder;
@@ -61,12 +62,12 @@ struct EncoderTypeTraits<u16> {
 template <>
 struct EncoderTypeTraits<u32> {
     // typedef IntEncoder<u32, NewPForDeltaCompressor> Encoder;
-    typedef IntEncoder<u32, SIMDBitPacking> Encoder;
+    typedef Int32Encoder Encoder;
 };
 
-export const Int32Encoder *GetDocIDEncoder();
+export const Int32Encoder *GetDocIDEncoder(PostingCodec codec = PostingCodec::kSIMDBitPacking);
 
-export const Int32Encoder *GetTFEncoder();
+export const Int32Encoder *GetTFEncoder(PostingCodec codec = PostingCodec::kSIMDBitPacking);
 
 export const Int16Encoder *GetDocPayloadEncoder();
 
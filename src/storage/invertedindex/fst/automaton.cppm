@@ -0,0 +1,338 @@
+// Copyright(C) 2024 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+module;
+
+export module fst:automaton;
+import stl;
+
+namespace infinity {
+
+/// A deterministic automaton over bytes, intersected with an fst by `FstAutomatonStream`.
+///
+/// The states are identified by ids, an automaton may build them lazily while
+/// it is being searched, so one automaton shall not be shared by concurrent searches.
+export class FstAutomaton {
+public:
+    virtual ~FstAutomaton() = default;
+
+    /// Returns the start state.
+    virtual u32 Start() = 0;
+
+    /// Returns true if and only if the state is a match state.
+    virtual bool IsMatch(u32 state) const = 0;
+
+    /// Returns true if and only if some input read from the state can lead to a match state.
+    ///
+    /// The search does not descend into the keys with a prefix that leads to a state that can not match.
+    virtual bool CanMatch(u32 state) const = 0;
+
+    /// Returns the state after reading the byte from the given state.
+    virtual u32 Accept(u32 state, u8 byte) = 0;
+};
+
+/// Matches the keys starting with a prefix.
+export class PrefixAutomaton final : public FstAutomaton {
+public:
+    explicit PrefixAutomaton(String prefix) : prefix_(std::move(prefix)) {}
+
+    // state i < prefix length: the first i bytes of the prefix are read
+    u32 Start() override { return 0; }
+
+    bool IsMatch(u32 state) const override { return state == prefix_.size(); }
+
+    bool CanMatch(u32 state) const override { return state != DeadState(); }
+
+    u32 Accept(u32 state, u8 byte) override {
+        if (state == prefix_.size() || state == DeadState()) {
+            return state;
+        }
+        return static_cast<u8>(prefix_[state]) == byte ? state + 1 : DeadState();
+    }
+
+private:
+    u32 DeadState() const { return prefix_.size() + 1; }
+
+    String prefix_;
+};
+
+/// Determinizes an automaton lazily, each state is a vector of u32 defined by the derived class.
+///
+/// The states and the transitions are added when they are first reached, so only
+/// the part of the automaton visited by the search is built.
+class LazyDfaAutomaton : public FstAutomaton {
+public:
+    u32 Start() override {
+        if (states_.empty()) {
+            AddState(StartKey());
+        }
+        return 0;
+    }
+
+    bool IsMatch(u32 state) const override { return is_match_[state]; }
+
+    bool CanMatch(u32 state) const override { return can_match_[state]; }
+
+    u32 Accept(u32 state, u8 byte) override {
+        u32 &next = transitions_[state][byte];
+        if (next == NOT_COMPUTED) {
+            const u32 next_state = AddState(Step(states_[state], byte));
+            // AddState may reallocate transitions_
+            transitions_[state][byte] = next_state;
+            return next_state;
+        }
+        return next;
+    }
+
+protected:
+    virtual Vector<u32> StartKey() const = 0;
+
+    virtual Vector<u32> Step(const Vector<u32> &key, u8 byte) const = 0;
+
+    virtual bool IsMatchKey(const Vector<u32> &key) const = 0;
+
+    virtual bool CanMatchKey(const Vector<u32> &key) const = 0;
+
+private:
+    static constexpr u32 NOT_COMPUTED = std::numeric_limits<u32>::max();
+
+    u32 AddState(Vector<u32> &&key) {
+        const auto [it, inserted] = state_ids_.try_emplace(std::move(key), states_.size());
+        if (inserted) {
+            states_.push_back(it->first);
+            is_match_.push_back(IsMatchKey(it->first));
+            can_match_.push_back(CanMatchKey(it->first));
+            transitions_.emplace_back();
+            transitions_.back().fill(NOT_COMPUTED);
+        }
+        return it->second;
+    }
+
+    Map<Vector<u32>, u32> state_ids_;
+    Vector<Vector<u32>> states_;
+    Vector<bool> is_match_;
+    Vector<bool> can_match_;
+    Vector<Array<u32, 256>> transitions_;
+};
+
+/// Matches the keys against a wildcard pattern: '*' matches any sequence of characters,
+/// '?' matches one UTF-8 character, and a backslash escapes the following byte.
+export class WildcardAutomaton final : public LazyDfaAutomaton {
+public:
+    explicit WildcardAutomaton(const String &pattern) {
+        for (SizeT i = 0; i < pattern.size(); ++i) {
+            const char c = pattern[i];
+            if (c == '\\' && i + 1 < pattern.size()) {
+                tokens_.push_back(static_cast<u8>(pattern[++i]));
+            } else if (c == '*') {
+                tokens_.push_back(ANY_SEQUENCE);
+            } else if (c == '?') {
+                tokens_.push_back(ANY_CHAR);
+            } else {
+                tokens_.push_back(static_cast<u8>(c));
+            }
+        }
+    }
+
+protected:
+    // The key is the sorted set of the pattern positions the input may be at, each encoded as
+    // position * 4 + pending, with pending the continuation bytes of the character read by a '?'.
+    Vector<u32> StartKey() const override {
+        Vector<u32> key;
+        AddPosition(0, key);
+        return Normalize(std::move(key));
+    }
+
+    Vector<u32> Step(const Vector<u32> &key, const u8 byte) const override {
+        Vector<u32> next;
+        const bool continuation = (byte & 0xC0) == 0x80;
+        for (const u32 item : key) {
+            const u32 pos = item >> 2;
+            const u32 pending = item & 3;
+            if (pending > 0) {
+                if (continuation) {
+                    pending == 1 ? AddPosition(pos + 1, next) : next.push_back(item - 1);
+                }
+                continue;
+            }
+            if (pos == tokens_.size()) {
+                continue;
+            }
+            switch (const u32 token = tokens_[pos]; token) {
+                case ANY_SEQUENCE: {
+                    // the keys are valid UTF-8, so '*' may read any byte
+                    AddPosition(pos, next);
+                    break;
+                }
+                case ANY_CHAR: {
+                    if (const u32 char_len = UTF8CharLen(byte); char_len == 1) {
+                        AddPosition(pos + 1, next);
+                    } else if (char_len > 1) {
+                        next.push_back((pos << 2) | (char_len - 1));
+                    }
+                    break;
+                }
+                default: {
+                    if (token == byte) {
+                        AddPosition(pos + 1, next);
+                    }
+                    break;
+                }
+            }
+        }
+        return Normalize(std::move(next));
+    }
+
+    bool IsMatchKey(const Vector<u32> &key) const override { return std::binary_search(key.begin(), key.end(), tokens_.size() << 2); }
+
+    bool CanMatchKey(const Vector<u32> &key) const override { return !key.empty(); }
+
+private:
+    static constexpr u32 ANY_SEQUENCE = 256;
+    static constexpr u32 ANY_CHAR = 257;
+
+    // returns 0 for a continuation byte or an invalid lead byte
+    static u32 UTF8CharLen(const u8 byte) {
+        if (byte < 0x80) {
+            return 1;
+        }
+        if ((byte & 0xE0) == 0xC0) {
+            return 2;
+        }
+        if ((byte & 0xF0) == 0xE0) {
+            return 3;
+        }
+        if ((byte & 0xF8) == 0xF0) {
+            return 4;
+        }
+        return 0;
+    }
+
+    // a '*' may also match nothing
+    void AddPosition(u32 pos, Vector<u32> &key) const {
+        key.push_back(pos << 2);
+        while (pos < tokens_.size() && tokens_[pos] == ANY_SEQUENCE) {
+            key.push_back(++pos << 2);
+        }
+    }
+
+    static Vector<u32> Normalize(Vector<u32> &&key) {
+        std::sort(key.begin(), key.end());
+        key.erase(std::unique(key.begin(), key.end()), key.end());
+        return std::move(key);
+    }
+
+    // bytes of the pattern, or ANY_SEQUENCE and ANY_CHAR
+    Vector<u32> tokens_;
+};
+
+/// Matches the keys within a Levenshtein distance of a term, the distance counts UTF-8 characters.
+export class LevenshteinAutomaton final : public LazyDfaAutomaton {
+public:
+    LevenshteinAutomaton(const String &term, const u32 max_distance) : max_distance_(max_distance) {
+        for (SizeT i = 0; i < term.size();) {
+            u32 char_len = 1;
+            u32 code_point = static_cast<u8>(term[i]);
+            if (code_point >= 0xF0) {
+                char_len = 4;
+                code_point &= 0x07;
+            } else if (code_point >= 0xE0) {
+                char_len = 3;
+                code_point &= 0x0F;
+            } else if (code_point >= 0xC0) {
+                char_len = 2;
+                code_point &= 0x1F;
+            }
+            for (u32 j = 1; j < char_len && i + j < term.size(); ++j) {
+                code_point = (code_point << 6) | (static_cast<u8>(term[i + j]) & 0x3F);
+            }
+            code_points_.push_back(code_point);
+            i += char_len;
+        }
+    }
+
+protected:
+    // The key is the row of the edit distances from the input to each prefix of the term, capped at
+    // max distance + 1, then the continuation bytes left and the bits read of a partial character.
+    Vector<u32> StartKey() const override {
+        Vector<u32> key(code_points_.size() + 3, 0);
+        for (SizeT j = 0; j <= code_points_.size(); ++j) {
+            key[j] = std::min<u32>(j, max_distance_ + 1);
+        }
+        return key;
+    }
+
+    Vector<u32> Step(const Vector<u32> &key, const u8 byte) const override {
+        const SizeT n = code_points_.size();
+        Vector<u32> next = key;
+        u32 &pending = next[n + 1];
+        u32 &code_point = next[n + 2];
+        if (pending > 0) {
+            if ((byte & 0xC0) != 0x80) {
+                return DeadKey();
+            }
+            code_point = (code_point << 6) | (byte & 0x3F);
+            if (--pending > 0) {
+                return next;
+            }
+        } else if (byte < 0x80) {
+            code_point = byte;
+        } else if ((byte & 0xE0) == 0xC0) {
+            pending = 1;
+            code_point = byte & 0x1F;
+            return next;
+        } else if ((byte & 0xF0) == 0xE0) {
+            pending = 2;
+            code_point = byte & 0x0F;
+            return next;
+        } else if ((byte & 0xF8) == 0xF0) {
+            pending = 3;
+            code_point = byte & 0x07;
+            return next;
+        } else {
+            return DeadKey();
+        }
+        // one more character of the input
+        const u32 cap = max_distance_ + 1;
+        next[0] = std::min(key[0] + 1, cap);
+        for (SizeT j = 1; j <= n; ++j) {
+            const u32 substitute = key[j - 1] + (code_points_[j - 1] != code_point);
+            next[j] = std::min({substitute, key[j] + 1, next[j - 1] + 1, cap});
+        }
+        code_point = 0;
+        return next;
+    }
+
+    bool IsMatchKey(const Vector<u32> &key) const override {
+        const SizeT n = code_points_.size();
+        return key[n + 1] == 0 && key[n] <= max_distance_;
+    }
+
+    bool CanMatchKey(const Vector<u32> &key) const override {
+        const SizeT n = code_points_.size();
+        return *std::min_element(key.begin(), key.begin() + n + 1) <= max_distance_;
+    }
+
+private:
+    Vector<u32> DeadKey() const {
+        Vector<u32> key(code_points_.size() + 3, 0);
+        std::fill_n(key.begin(), code_points_.size() + 1, max_distance_ + 1);
+        return key;
+    }
+
+    Vector<u32> code_points_;
+    u32 max_distance_;
+};
+
+} // namespace infinity
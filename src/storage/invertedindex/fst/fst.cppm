@@ -20,6 +20,7 @@ import stl;
 import crc;
 import :bytes;
 import :node;
+import :automaton;
 
 /// An acyclic deterministic finite state transducer.
 ///
@@ -48,6 +49,7 @@ private:
     SizeT data_len_;
 
     friend class FstStream;
+    friend class FstAutomatonStream;
 
 public:
     /// Creates a transducer from its representation as a raw byte sequence.
@@ -367,4 +369,66 @@ private:
     }
 };
 
+struct AutomatonStreamState {
+    Node node_;
+    SizeT trans_;
+    Output out_;
+    u32 aut_state_;
+    AutomatonStreamState(const Node &node, SizeT trans, Output out, u32 aut_state) : node_(node), trans_(trans), out_(out), aut_state_(aut_state) {}
+};
+
+/// A lexicographically ordered stream of the key-value pairs from an fst whose keys are matched by an automaton.
+///
+/// The subtrees of the fst are skipped as soon as the automaton can not match their prefix,
+/// so the search only visits the part of the fst the automaton may accept.
+export class FstAutomatonStream {
+private:
+    Fst &fst_;
+    FstAutomaton &aut_;
+    Vector<u8> inp_;
+    Vector<AutomatonStreamState> stack_;
+
+public:
+    FstAutomatonStream(Fst &fst, FstAutomaton &aut) : fst_(fst), aut_(aut) {
+        const u32 start = aut_.Start();
+        if (aut_.CanMatch(start)) {
+            stack_.emplace_back(fst_.Root(), 0, Output(), start);
+        }
+    }
+
+    /// @brief Get next key-value pair matched by the automaton per lexicographical order
+    /// @param key Stores the key of the pair when found
+    /// @param val Stores the value of the pair when found
+    /// @return true if found next pair, false if not
+    bool Next(Vector<u8> &key, u64 &val) {
+        while (!stack_.empty()) {
+            AutomatonStreamState &state = stack_.back();
+            if (state.trans_ >= state.node_.Len()) {
+                if (stack_.size() > 1) {
+                    inp_.pop_back();
+                }
+                stack_.pop_back();
+                continue;
+            }
+            Transition trans = state.node_.TransAt(state.trans_++);
+            const u32 next_aut_state = aut_.Accept(state.aut_state_, trans.inp_);
+            if (!aut_.CanMatch(next_aut_state)) {
+                continue;
+            }
+            Output out = state.out_.Cat(trans.out_);
+            Node next_node = fst_.NodeAt(trans.addr_);
+            inp_.push_back(trans.inp_);
+            bool is_match = next_node.IsFinal() && aut_.IsMatch(next_aut_state);
+            if (is_match) {
+                key = inp_;
+                val = out.Cat(next_node.FinalOutput()).Value();
+            }
+            stack_.emplace_back(next_node, 0, out, next_aut_state);
+            if (is_match)
+                return true;
+        }
+        return false;
+    }
+};
+
 } // namespace infinity
\ No newline at end of file
@@ -19,3 +19,4 @@ export import :fst;
 export import :bytes;
 export import :writer;
 export import :registry;
+export import :automaton;
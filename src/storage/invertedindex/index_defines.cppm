@@ -40,6 +40,20 @@ export {
     void FlagAddRealtime(optionflag_t &flag) { flag |= of_realtime; }
     bool FlagIsRealtime(const optionflag_t &flag) { return flag & of_realtime; }
 
+    // codec of the doc id and term frequency lists, kept in the two highest bits of the option flag
+    enum class PostingCodec : u8 {
+        kSIMDBitPacking = 0,
+        kSIMDNewPFor = 1,
+        kStreamVByte = 2,
+    };
+    constexpr u32 POSTING_CODEC_SHIFT = 6;
+    constexpr optionflag_t POSTING_CODEC_MASK = 0xC0;
+
+    PostingCodec FlagGetCodec(const optionflag_t &flag) { return static_cast<PostingCodec>((flag & POSTING_CODEC_MASK) >> POSTING_CODEC_SHIFT); }
+    void FlagSetCodec(optionflag_t &flag, PostingCodec codec) {
+        flag = (flag & ~POSTING_CODEC_MASK) | (static_cast<optionflag_t>(codec) << POSTING_CODEC_SHIFT);
+    }
+
     constexpr docid_t INVALID_DOCID = u32(-1);
     constexpr RowID INVALID_ROWID = u64(-1);
     constexpr pos_t INVALID_POSITION = u32(-1);
@@ -18,6 +18,7 @@ import stl;
 
 import segment_posting;
 import index_defines;
+import fst;
 export module index_segment_reader;
 
 namespace infinity {
@@ -29,6 +30,9 @@ public:
     // fetch_position is only valid in DiskIndexSegmentReader
     virtual bool GetSegmentPosting(const String &term, SegmentPosting &seg_posting, bool fetch_position = true) const = 0;
 
+    // Appends the terms matched by the automaton in lexicographical order, at most max_terms of them
+    virtual void ExpandTerms(FstAutomaton &aut, SizeT max_terms, Vector<String> &terms) const = 0;
+
     SegmentID segment_id() const { return segment_id_; }
 
     ChunkID chunk_id() const { return chunk_id_; }
@@ -24,6 +24,7 @@ import index_defines;
 import posting_writer;
 import memory_indexer;
 import third_party;
+import fst;
 
 namespace infinity {
 InMemIndexSegmentReader::InMemIndexSegmentReader(SegmentID segment_id, MemoryIndexer *memory_indexer)
@@ -32,7 +33,7 @@ InMemIndexSegmentReader::InMemIndexSegmentReader(SegmentID segment_id, MemoryInd
 
 bool InMemIndexSegmentReader::GetSegmentPosting(const String &term, SegmentPosting &seg_posting, bool fetch_position) const {
     SharedPtr<PostingWriter> writer;
-    bool found = posting_table_->store_.Get(term, writer);
+    bool found = posting_table_->Get(term, writer);
     if (found) {
         seg_posting.Init(base_row_id_, writer);
         return true;
@@ -40,4 +41,60 @@ bool InMemIndexSegmentReader::GetSegmentPosting(const String &term, SegmentPosti
     return false;
 }
 
+void InMemIndexSegmentReader::ExpandTerms(FstAutomaton &aut, SizeT max_terms, Vector<String> &terms) const {
+    // Seek the sorted terms of each shard with the automaton: a term the automaton rejects at its i-th byte
+    // rejects all the terms sharing its first i bytes, so the next seek skips over them.
+    const u32 start = aut.Start();
+    if (!aut.CanMatch(start)) {
+        return;
+    }
+    Vector<String> matched_terms;
+    for (auto &shard : posting_table_->shards_) {
+        ExpandShardTerms(shard, aut, start, max_terms, matched_terms);
+    }
+    // the smallest terms of all shards
+    std::sort(matched_terms.begin(), matched_terms.end());
+    matched_terms.resize(std::min(matched_terms.size(), max_terms));
+    std::move(matched_terms.begin(), matched_terms.end(), std::back_inserter(terms));
+}
+
+void InMemIndexSegmentReader::ExpandShardTerms(MemoryIndexer::PostingTableStore &shard,
+                                               FstAutomaton &aut,
+                                               const u32 start,
+                                               SizeT max_terms,
+                                               Vector<String> &terms) {
+    String seek;
+    String term;
+    SizeT n = 0;
+    while (n < max_terms && shard.LowerBound(seek, term)) {
+        u32 state = start;
+        SizeT i = 0;
+        for (; i < term.size(); ++i) {
+            state = aut.Accept(state, static_cast<u8>(term[i]));
+            if (!aut.CanMatch(state)) {
+                break;
+            }
+        }
+        if (i == term.size()) {
+            if (aut.IsMatch(state)) {
+                terms.push_back(term);
+                ++n;
+            }
+            // the smallest term greater than this one
+            seek = std::move(term);
+            seek.push_back('\0');
+            continue;
+        }
+        // the smallest term not starting with term[0..i]
+        seek.assign(term, 0, i + 1);
+        while (!seek.empty() && static_cast<u8>(seek.back()) == 0xFF) {
+            seek.pop_back();
+        }
+        if (seek.empty()) {
+            break;
+        }
+        seek.back() = static_cast<char>(static_cast<u8>(seek.back()) + 1);
+    }
+}
+
 } // namespace infinity
\ No newline at end of file
@@ -24,6 +24,7 @@ import index_defines;
 import posting_writer;
 import memory_indexer;
 import internal_types;
+import fst;
 
 namespace infinity {
 export class InMemIndexSegmentReader : public IndexSegmentReader {
@@ -33,7 +34,11 @@ public:
 
     bool GetSegmentPosting(const String &term, SegmentPosting &seg_posting, bool fetch_position = true) const override;
 
+    void ExpandTerms(FstAutomaton &aut, SizeT max_terms, Vector<String> &terms) const override;
+
 private:
+    static void ExpandShardTerms(MemoryIndexer::PostingTableStore &shard, FstAutomaton &aut, u32 start, SizeT max_terms, Vector<String> &terms);
+
     SharedPtr<MemoryIndexer::PostingTable> posting_table_;
     RowID base_row_id_{INVALID_ROWID};
 };
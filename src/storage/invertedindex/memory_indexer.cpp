@@ -70,6 +70,41 @@ import mem_usage_change;
 
 namespace infinity {
 constexpr int MAX_TUPLE_LENGTH = 1024; // we assume that analyzed term, together with docid/offset info, will never exceed such length
+constexpr SizeT MIN_POSITIONS_PER_GENERATE_TASK = 16384;
+constexpr SizeT MAX_SPILL_RANGE_NUM = 8;
+
+// Run func(part) for each part in [0, part_num) on the thread pool and the calling thread. The calling thread takes the
+// parts no task has taken yet, so it never waits for a task queued behind itself when it runs on the same pool.
+template <typename Func>
+static void ParallelRun(ThreadPool &thread_pool, SizeT part_num, Func &&func) {
+    struct State {
+        Atomic<SizeT> next_part_{0};
+        SizeT done_num_{0};
+        std::mutex mutex_;
+        std::condition_variable cv_;
+    };
+    auto state = MakeShared<State>();
+    // a task starting after all parts are taken returns at once without touching func
+    auto run_parts = [state, part_num, &func] {
+        SizeT done_num = 0;
+        for (SizeT part = state->next_part_++; part < part_num; part = state->next_part_++) {
+            func(part);
+            ++done_num;
+        }
+        if (done_num > 0) {
+            std::unique_lock<std::mutex> lock(state->mutex_);
+            state->done_num_ += done_num;
+            state->cv_.notify_all();
+        }
+    };
+    for (SizeT i = 1; i < part_num; ++i) {
+        thread_pool.push([run_parts](int) { run_parts(); });
+    }
+    run_parts();
+    std::unique_lock<std::mutex> lock(state->mutex_);
+    state->cv_.wait(lock, [&] { return state->done_num_ == part_num; });
+}
+
 bool MemoryIndexer::KeyComp::operator()(const String &lhs, const String &rhs) const {
     int ret = strcmp(lhs.c_str(), rhs.c_str());
     return ret < 0;
@@ -77,6 +112,34 @@ bool MemoryIndexer::KeyComp::operator()(const String &lhs, const String &rhs) co
 
 MemoryIndexer::PostingTable::PostingTable() {}
 
+void MemoryIndexer::PostingTable::Clear() {
+    for (auto &shard : shards_) {
+        shard.Clear();
+    }
+}
+
+Vector<Pair<const String *, MemoryIndexer::PostingPtr>> MemoryIndexer::PostingTable::UnsafeSorted() {
+    Vector<Pair<const String *, PostingPtr>> terms;
+    Vector<SizeT> bounds{0};
+    for (auto &shard : shards_) {
+        for (auto it = shard.UnsafeBegin(); it != shard.UnsafeEnd(); ++it) {
+            terms.emplace_back(&it->first, it->second);
+        }
+        bounds.push_back(terms.size());
+    }
+    // each shard is sorted, merge them pairwise
+    auto comp = [](const Pair<const String *, PostingPtr> &lhs, const Pair<const String *, PostingPtr> &rhs) { return *lhs.first < *rhs.first; };
+    for (SizeT width = 1; width < SHARD_NUM; width *= 2) {
+        for (SizeT i = 0; i + width < SHARD_NUM; i += 2 * width) {
+            std::inplace_merge(terms.begin() + bounds[i],
+                               terms.begin() + bounds[i + width],
+                               terms.begin() + bounds[std::min(i + 2 * width, SHARD_NUM)],
+                               comp);
+        }
+    }
+    return terms;
+}
+
 MemoryIndexer::MemoryIndexer(const String &index_dir,
                              const String &base_name,
                              RowID base_row_id,
@@ -89,7 +152,6 @@ MemoryIndexer::MemoryIndexer(const String &index_dir,
       segment_index_entry_(segment_index_entry) {
     assert(std::filesystem::path(index_dir).is_absolute());
     posting_table_ = MakeShared<PostingTable>();
-    prepared_posting_ = MakeShared<PostingWriter>(posting_format_, column_lengths_);
     spill_full_path_ = Path(index_dir) / (base_name + ".tmp.merge");
     spill_full_path_ = Path(InfinityContext::instance().config()->TempDir()) / StringTransform(spill_full_path_, "/", "_");
 }
@@ -238,13 +300,23 @@ SizeT MemoryIndexer::CommitOffline(SizeT wait_if_empty_ms) {
         return num;
     }
 
-    if (nullptr == spill_file_handle_) {
-        PrepareSpillFile();
-    }
-
     for (auto &inverter : inverters) {
-        inverter->SpillSortResults(this->spill_file_handle_, this->tuple_count_, buf_writer_);
-        num_runs_++;
+        if (inverter->GetPositionCount() == 0) {
+            continue;
+        }
+        if (spill_ranges_.empty()) {
+            PrepareSpillFile(*inverter);
+        }
+        // each term range of the inverter is a run of the spill file of the range
+        const Vector<SizeT> boundaries = inverter->PartitionPositions(spill_splitters_);
+        for (SizeT i = 0; i < spill_ranges_.size(); ++i) {
+            if (boundaries[i] == boundaries[i + 1]) {
+                continue;
+            }
+            SpillRange &range = spill_ranges_[i];
+            inverter->SpillSortResults(range.file_handle_, range.tuple_count_, range.buf_writer_, boundaries[i], boundaries[i + 1]);
+            range.num_runs_++;
+        }
     }
 
     std::unique_lock<std::mutex> task_lock(mutex_);
@@ -282,7 +354,18 @@ SizeT MemoryIndexer::CommitSync(SizeT wait_if_empty_ms) {
             break;
         }
         for (auto &inverter : inverters) {
-            mem_usage_change.Add(inverter->GeneratePosting());
+            // The terms of a batch are split into ranges generating posting in parallel, while the batches are still
+            // generated one by one to keep the doc ids of each posting in order.
+            const SizeT part_num = std::min(static_cast<SizeT>(commiting_thread_pool_.size()) + 1,
+                                            inverter->GetPositionCount() / MIN_POSITIONS_PER_GENERATE_TASK + 1);
+            const Vector<SizeT> boundaries = inverter->SplitPositions(part_num);
+            Vector<MemUsageChange> part_changes(boundaries.size() - 1);
+            ParallelRun(commiting_thread_pool_, part_changes.size(), [&](SizeT part) {
+                part_changes[part] = inverter->GeneratePosting(boundaries[part], boundaries[part + 1]);
+            });
+            for (const MemUsageChange &part_change : part_changes) {
+                mem_usage_change.Add(part_change);
+            }
             num_generated += inverter->GetMerged();
 
             if (const auto &semas = inverter->semas(); !semas.empty()) {
@@ -363,15 +446,12 @@ void MemoryIndexer::Dump(bool offline, bool spill) {
         posting_file_writer->WriteVInt(i32(doc_count_));
     }
     if (posting_table_.get() != nullptr) {
-        MemoryIndexer::PostingTableStore &posting_store = posting_table_->store_;
-        for (auto it = posting_store.UnsafeBegin(); it != posting_store.UnsafeEnd(); ++it) {
-            const MemoryIndexer::PostingPtr posting_writer = it->second;
+        for (const auto &[term, posting_writer] : posting_table_->UnsafeSorted()) {
             TermMeta term_meta(posting_writer->GetDF(), posting_writer->GetTotalTF());
             posting_writer->Dump(posting_file_writer, term_meta, spill);
             SizeT term_meta_offset = dict_file_writer->TotalWrittenBytes();
             term_meta_dumpler.Dump(dict_file_writer, term_meta);
-            const String &term = it->first;
-            fst_builder.Insert((u8 *)term.c_str(), term.length(), term_meta_offset);
+            fst_builder.Insert((u8 *)term->c_str(), term->length(), term_meta_offset);
         }
         posting_file_writer->Sync();
         dict_file_writer->Sync();
@@ -443,20 +523,23 @@ void MemoryIndexer::Load() {
 
 SharedPtr<PostingWriter> MemoryIndexer::GetOrAddPosting(const String &term) {
     assert(posting_table_.get() != nullptr);
-    MemoryIndexer::PostingTableStore &posting_store = posting_table_->store_;
+    MemoryIndexer::PostingTableStore &posting_store = posting_table_->Shard(term);
     PostingPtr posting;
-    bool found = posting_store.GetOrAdd(term, posting, prepared_posting_);
+    // most terms are found, look them up with the shared lock first
+    if (posting_store.Get(term, posting)) {
+        return posting;
+    }
+    bool found = posting_store.GetOrAdd(term, posting, MakeShared<PostingWriter>(posting_format_, column_lengths_));
     if (!found) {
         // mem trace : add term's size
         IncreaseMemoryUsage(term.size());
-        prepared_posting_ = MakeShared<PostingWriter>(posting_format_, column_lengths_);
     }
     return posting;
 }
 
 void MemoryIndexer::Reset() {
     if (posting_table_.get()) {
-        posting_table_->store_.Clear();
+        posting_table_->Clear();
     }
     column_lengths_.Clear();
     DecreaseMemoryUsage(mem_used_);
@@ -495,34 +578,22 @@ void MemoryIndexer::DecreaseMemoryUsage(SizeT mem) {
     BaseMemIndex::DecreaseMemoryUsageBase(mem);
 }
 
-void MemoryIndexer::TupleListToIndexFile(UniquePtr<SortMergerTermTuple<TermTuple, u32>> &merger) {
+void MemoryIndexer::TupleListToIndexFile(UniquePtr<SortMergerTermTuple<TermTuple, u32>> &merger, SpillRange &range) {
     auto &count = merger->Count();
     auto &term_tuple_list_queue = merger->TermTupleListQueue();
-    Path path = Path(index_dir_) / base_name_;
-    String index_prefix = path.string();
-
-    PersistenceManager *pm = InfinityContext::instance().persistence_manager();
-    bool use_object_cache = pm != nullptr;
-    String posting_file = index_prefix + POSTING_SUFFIX;
-    String dict_file = index_prefix + DICT_SUFFIX;
-    String column_length_file = index_prefix + LENGTH_SUFFIX;
-    String tmp_posting_file(posting_file);
-    String tmp_dict_file(dict_file);
-    String tmp_column_length_file(column_length_file);
 
-    if (use_object_cache) {
-        Path tmp_dir = Path(InfinityContext::instance().config()->TempDir());
-        tmp_posting_file = tmp_dir / StringTransform(tmp_posting_file, "/", "_");
-        tmp_dict_file = tmp_dir / StringTransform(tmp_dict_file, "/", "_");
-        tmp_column_length_file = tmp_dir / StringTransform(tmp_column_length_file, "/", "_");
-    }
-    SharedPtr<FileWriter> posting_file_writer = MakeShared<FileWriter>(tmp_posting_file, 128000);
-    SharedPtr<FileWriter> dict_file_writer = MakeShared<FileWriter>(tmp_dict_file, 128000);
+    // the offsets of the term meta are within the posting file of the range, RangesToIndexFile shifts them
+    SharedPtr<FileWriter> posting_file_writer = MakeShared<FileWriter>(range.posting_path_, 128000);
+    SharedPtr<FileWriter> term_file_writer = MakeShared<FileWriter>(range.term_path_, 128000);
     TermMetaDumper term_meta_dumpler((PostingFormatOption(flag_)));
-    String tmp_fst_file = tmp_dict_file + ".fst";
-    std::ofstream ofs(tmp_fst_file.c_str(), std::ios::binary | std::ios::trunc);
-    OstreamWriter wtr(ofs);
-    FstBuilder fst_builder(wtr);
+    auto dump_term = [&](std::string_view term, UniquePtr<PostingWriter> &posting) {
+        TermMeta term_meta(posting->GetDF(), posting->GetTotalTF());
+        posting->Dump(posting_file_writer, term_meta);
+        term_file_writer->WriteVInt(term.size());
+        term_file_writer->Write(term.data(), term.size());
+        term_meta_dumpler.Dump(term_file_writer, term_meta);
+        range.term_count_++;
+    };
 
     u32 term_length = 0;
     u32 doc_pos_list_size = 0;
@@ -560,11 +631,7 @@ void MemoryIndexer::TupleListToIndexFile(UniquePtr<SortMergerTermTuple<TermTuple
                     posting->EndDocument(last_doc_id, last_doc_payload);
                 }
                 if (posting.get()) {
-                    TermMeta term_meta(posting->GetDF(), posting->GetTotalTF());
-                    posting->Dump(posting_file_writer, term_meta);
-                    SizeT term_meta_offset = dict_file_writer->TotalWrittenBytes();
-                    term_meta_dumpler.Dump(dict_file_writer, term_meta);
-                    fst_builder.Insert((u8 *)last_term.data(), last_term.length(), term_meta_offset);
+                    dump_term(last_term, posting);
                 }
                 posting = MakeUnique<PostingWriter>(posting_format_, column_lengths_);
                 last_term_str = String(term);
@@ -590,13 +657,69 @@ void MemoryIndexer::TupleListToIndexFile(UniquePtr<SortMergerTermTuple<TermTuple
     }
     if (last_doc_id != INVALID_DOCID) {
         posting->EndDocument(last_doc_id, last_doc_payload);
-        TermMeta term_meta(posting->GetDF(), posting->GetTotalTF());
-        posting->Dump(posting_file_writer, term_meta);
-        SizeT term_meta_offset = dict_file_writer->TotalWrittenBytes();
-        term_meta_dumpler.Dump(dict_file_writer, term_meta);
-        fst_builder.Insert((u8 *)last_term.data(), last_term.length(), term_meta_offset);
+        dump_term(last_term, posting);
+    }
+    posting_file_writer->Sync();
+    term_file_writer->Sync();
+    range.posting_size_ = posting_file_writer->TotalWrittenBytes();
+}
+
+void MemoryIndexer::RangesToIndexFile() {
+    Path path = Path(index_dir_) / base_name_;
+    String index_prefix = path.string();
+
+    PersistenceManager *pm = InfinityContext::instance().persistence_manager();
+    bool use_object_cache = pm != nullptr;
+    String posting_file = index_prefix + POSTING_SUFFIX;
+    String dict_file = index_prefix + DICT_SUFFIX;
+    String column_length_file = index_prefix + LENGTH_SUFFIX;
+    String tmp_posting_file(posting_file);
+    String tmp_dict_file(dict_file);
+    String tmp_column_length_file(column_length_file);
+
+    if (use_object_cache) {
+        Path tmp_dir = Path(InfinityContext::instance().config()->TempDir());
+        tmp_posting_file = tmp_dir / StringTransform(tmp_posting_file, "/", "_");
+        tmp_dict_file = tmp_dir / StringTransform(tmp_dict_file, "/", "_");
+        tmp_column_length_file = tmp_dir / StringTransform(tmp_column_length_file, "/", "_");
     }
+    SharedPtr<FileWriter> posting_file_writer = MakeShared<FileWriter>(tmp_posting_file, 128000);
     posting_file_writer->Sync();
+    SharedPtr<FileWriter> dict_file_writer = MakeShared<FileWriter>(tmp_dict_file, 128000);
+    TermMetaDumper term_meta_dumpler((PostingFormatOption(flag_)));
+    TermMetaLoader term_meta_loader((PostingFormatOption(flag_)));
+    String tmp_fst_file = tmp_dict_file + ".fst";
+    std::ofstream ofs(tmp_fst_file.c_str(), std::ios::binary | std::ios::trunc);
+    OstreamWriter wtr(ofs);
+    FstBuilder fst_builder(wtr);
+
+    // the ranges are in term order, so are their terms
+    u64 posting_base = 0;
+    for (SpillRange &range : spill_ranges_) {
+        if (range.num_runs_ == 0) {
+            continue;
+        }
+        SharedPtr<FileReader> term_file_reader = MakeShared<FileReader>(range.term_path_, 128000);
+        String term;
+        TermMeta term_meta;
+        for (SizeT i = 0; i < range.term_count_; ++i) {
+            term.resize(term_file_reader->ReadVInt());
+            term_file_reader->Read(term.data(), term.size());
+            term_meta_loader.Load(term_file_reader, term_meta);
+            term_meta.doc_start_ += posting_base;
+            if (term_meta.pos_end_ > 0) {
+                term_meta.pos_start_ += posting_base;
+                term_meta.pos_end_ += posting_base;
+            }
+            SizeT term_meta_offset = dict_file_writer->TotalWrittenBytes();
+            term_meta_dumpler.Dump(dict_file_writer, term_meta);
+            fst_builder.Insert((u8 *)term.data(), term.size(), term_meta_offset);
+        }
+        posting_base += range.posting_size_;
+        VirtualStore::Merge(tmp_posting_file, range.posting_path_);
+        VirtualStore::DeleteFile(range.posting_path_);
+        VirtualStore::DeleteFile(range.term_path_);
+    }
     dict_file_writer->Sync();
     fst_builder.Finish();
 
@@ -626,39 +749,65 @@ void MemoryIndexer::TupleListToIndexFile(UniquePtr<SortMergerTermTuple<TermTuple
 
 void MemoryIndexer::OfflineDump() {
     // Steps of offline dump:
-    // 1. External sort merge
-    // 2. Generate posting
-    // 3. Dump disk segment data
-    // LOG_INFO(fmt::format("MemoryIndexer::OfflineDump begin, num_runs_ {}\n", num_runs_));
-    FinalSpillFile();
+    // 1. External sort merge of each term range, the ranges are merged in parallel
+    // 2. Generate posting of each term range
+    // 3. Dump disk segment data, in the order of the term ranges
+    // LOG_INFO(fmt::format("MemoryIndexer::OfflineDump begin, {} ranges\n", spill_ranges_.size()));
+    // the memory of the runs is shared by the ranges
     constexpr u32 buffer_size_of_each_run = 2 * 1024 * 1024;
-    UniquePtr<SortMergerTermTuple<TermTuple, u32>> merger =
-        MakeUnique<SortMergerTermTuple<TermTuple, u32>>(spill_full_path_.c_str(), num_runs_, buffer_size_of_each_run * num_runs_, 2);
-    Vector<UniquePtr<Thread>> threads;
-    merger->Run(threads);
-    UniquePtr<Thread> output_thread = MakeUnique<Thread>(std::bind(&MemoryIndexer::TupleListToIndexFile, this, std::ref(merger)));
-    threads.emplace_back(std::move(output_thread));
-
-    merger->JoinThreads(threads);
-    merger->UnInitRunFile();
-
-    std::filesystem::remove(spill_full_path_);
-    num_runs_ = 0;
+    constexpr u32 min_buffer_size_of_each_run = 256 * 1024;
+    const u32 buffer_size_of_range_run = std::max<u32>(buffer_size_of_each_run / std::max<SizeT>(spill_ranges_.size(), 1), min_buffer_size_of_each_run);
+    Vector<UniquePtr<SortMergerTermTuple<TermTuple, u32>>> mergers(spill_ranges_.size());
+    Vector<Vector<UniquePtr<Thread>>> range_threads(spill_ranges_.size());
+    for (SizeT i = 0; i < spill_ranges_.size(); ++i) {
+        SpillRange &range = spill_ranges_[i];
+        FinalSpillFile(range);
+        range.posting_path_ = range.path_ + POSTING_SUFFIX;
+        range.term_path_ = range.path_ + DICT_SUFFIX;
+        if (range.num_runs_ == 0) {
+            continue;
+        }
+        mergers[i] =
+            MakeUnique<SortMergerTermTuple<TermTuple, u32>>(range.path_.c_str(), range.num_runs_, buffer_size_of_range_run * range.num_runs_, 2);
+        mergers[i]->Run(range_threads[i]);
+        UniquePtr<Thread> output_thread =
+            MakeUnique<Thread>(std::bind(&MemoryIndexer::TupleListToIndexFile, this, std::ref(mergers[i]), std::ref(range)));
+        range_threads[i].emplace_back(std::move(output_thread));
+    }
+    for (SizeT i = 0; i < spill_ranges_.size(); ++i) {
+        if (mergers[i].get() != nullptr) {
+            mergers[i]->JoinThreads(range_threads[i]);
+            mergers[i]->UnInitRunFile();
+        }
+        std::filesystem::remove(spill_ranges_[i].path_);
+    }
+
+    RangesToIndexFile();
+    spill_splitters_.clear();
+    spill_ranges_.clear();
 }
 
-void MemoryIndexer::FinalSpillFile() {
-    fseek(spill_file_handle_, 0, SEEK_SET);
-    fwrite(&tuple_count_, sizeof(u64), 1, spill_file_handle_);
-    fclose(spill_file_handle_);
-    tuple_count_ = 0;
-    spill_file_handle_ = nullptr;
+void MemoryIndexer::FinalSpillFile(SpillRange &range) {
+    fseek(range.file_handle_, 0, SEEK_SET);
+    fwrite(&range.tuple_count_, sizeof(u64), 1, range.file_handle_);
+    fclose(range.file_handle_);
+    range.tuple_count_ = 0;
+    range.file_handle_ = nullptr;
+    range.buf_writer_.reset();
 }
 
-void MemoryIndexer::PrepareSpillFile() {
-    spill_file_handle_ = fopen(spill_full_path_.c_str(), "w");
-    fwrite(&tuple_count_, sizeof(u64), 1, spill_file_handle_);
+void MemoryIndexer::PrepareSpillFile(const ColumnInverter &sample) {
+    const SizeT range_num = std::clamp<SizeT>(commiting_thread_pool_.size(), 1, MAX_SPILL_RANGE_NUM);
+    spill_splitters_ = sample.SampleSplitters(range_num);
+    spill_ranges_.resize(spill_splitters_.size() + 1);
     const SizeT write_buf_size = 128000;
-    buf_writer_ = MakeUnique<BufWriter>(spill_file_handle_, write_buf_size);
+    for (SizeT i = 0; i < spill_ranges_.size(); ++i) {
+        SpillRange &range = spill_ranges_[i];
+        range.path_ = fmt::format("{}.{}", spill_full_path_, i);
+        range.file_handle_ = fopen(range.path_.c_str(), "w");
+        fwrite(&range.tuple_count_, sizeof(u64), 1, range.file_handle_);
+        range.buf_writer_ = MakeUnique<BufWriter>(range.file_handle_, write_buf_size);
+    }
 }
 
 } // namespace infinity
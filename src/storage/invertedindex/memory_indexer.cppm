@@ -54,9 +54,23 @@ public:
     // using PostingTableStore = SkipList<String, PostingPtr, KeyComp>;
     using PostingTableStore = MapWithLock<String, PostingPtr>;
 
+    // The terms are sharded by hash, so that concurrent posting generation does not contend on one lock.
     struct PostingTable {
+        static constexpr SizeT SHARD_NUM = 16;
+
         PostingTable();
-        PostingTableStore store_;
+
+        PostingTableStore &Shard(const String &term) { return shards_[std::hash<String>{}(term) % SHARD_NUM]; }
+
+        bool Get(const String &term, PostingPtr &posting) { return Shard(term).Get(term, posting); }
+
+        void Clear();
+
+        // Returns the terms of all shards in sorted order.
+        // WARN: Caller shall ensure there's no concurrent write access
+        Vector<Pair<const String *, PostingPtr>> UnsafeSorted();
+
+        Array<PostingTableStore, SHARD_NUM> shards_;
     };
 
     MemoryIndexer(const String &index_dir,
@@ -136,17 +150,36 @@ private:
     // CommitOffline is for offline case. It spill a batch of ColumnInverter. Returns the size of the batch.
     SizeT CommitOffline(SizeT wait_if_empty_ms = 0);
 
+    // Spill file of the terms within [lower splitter, upper splitter) for offline index building
+    struct SpillRange {
+        String path_;
+        FILE *file_handle_{nullptr};
+        UniquePtr<BufWriter> buf_writer_;
+        u32 num_runs_{0};
+        u64 tuple_count_{0};
+        // outputs of merging the range: the posting file, and the terms with their term meta
+        String posting_path_;
+        String term_path_;
+        SizeT posting_size_{0};
+        SizeT term_count_{0};
+    };
+
     void OfflineDump();
 
-    void FinalSpillFile();
+    void FinalSpillFile(SpillRange &range);
 
-    void PrepareSpillFile();
+    // Pick the splitters of the term ranges from the first spilled inverter, and create a spill file per range.
+    void PrepareSpillFile(const ColumnInverter &sample);
 
     u32 ReadU32LE(const u8 *ptr) { return *(u32 *)ptr; }
 
     u64 ReadU64LE(const u8 *ptr) { return *(u64 *)ptr; }
 
-    void TupleListToIndexFile(UniquePtr<SortMergerTermTuple<TermTuple, u32>> &merger);
+    // Generate the posting of a term range merged from its spill file.
+    void TupleListToIndexFile(UniquePtr<SortMergerTermTuple<TermTuple, u32>> &merger, SpillRange &range);
+
+    // Concatenate the posting of the term ranges, and write the dictionary and the column length.
+    void RangesToIndexFile();
 
 private:
     String index_dir_;
@@ -159,7 +192,6 @@ private:
     ThreadPool &commiting_thread_pool_;
     u32 doc_count_{0};
     SharedPtr<PostingTable> posting_table_;
-    PostingPtr prepared_posting_{nullptr};
     Ring<SharedPtr<ColumnInverter>> ring_inverted_;
     Ring<SharedPtr<ColumnInverter>> ring_sorted_;
     u64 seq_inserted_{0};
@@ -169,10 +201,9 @@ private:
     std::mutex mutex_commit_;
     std::shared_mutex mutex_commit_sync_share_;
 
-    u32 num_runs_{0};                  // For offline index building
-    FILE *spill_file_handle_{nullptr}; // Temp file for offline external merge sort
-    String spill_full_path_;           // Path of spill file
-    u64 tuple_count_{0};               // Number of tuples for external merge sort
+    String spill_full_path_;         // Path prefix of spill files for offline external merge sort
+    Vector<String> spill_splitters_; // Lower bounds of the term ranges except the first one
+    Vector<SpillRange> spill_ranges_;
 
     bool is_spilled_{false};
 
@@ -180,11 +211,6 @@ private:
     VectorWithLock<u32> column_lengths_;
     Atomic<u32> column_length_sum_{0};
 
-    // spill file write buf
-    UniquePtr<char_t[]> spill_buffer_{};
-    SizeT spill_buffer_size_{0};
-    UniquePtr<BufWriter> buf_writer_;
-
     SegmentIndexEntry *segment_index_entry_{nullptr};
     Atomic<SizeT> mem_used_{0};
 };
@@ -15,6 +15,7 @@ import segment_posting;
 import in_doc_pos_state;
 import index_defines;
 import internal_types;
+import simd_common_tools;
 
 module posting_iterator;
 
@@ -79,14 +80,13 @@ RowID PostingIterator::SeekDoc(RowID row_id) {
         return INVALID_ROWID;
     }
     if (!finish_decode_docid_) {
-        posting_decoder_->DecodeCurrentDocIDBuffer(doc_buffer_);
-        current_row_id = last_doc_id_in_prev_block_ + doc_buffer_[0];
-        doc_buffer_cursor_ = doc_buffer_ + 1;
-        finish_decode_docid_ = true;
+        DecodeDocIDBuffer();
+        current_row_id = current_row_id_;
     }
+    const RowID block_base = last_doc_id_in_prev_block_;
     docid_t *cursor = doc_buffer_cursor_;
     while (current_row_id < row_id) {
-        current_row_id += *(cursor++);
+        current_row_id = block_base + *(cursor++);
     }
     current_row_id_ = current_row_id;
     doc_buffer_cursor_ = cursor;
@@ -96,15 +96,13 @@ RowID PostingIterator::SeekDoc(RowID row_id) {
 
 Pair<bool, RowID> PostingIterator::PeekInBlockRange(RowID doc_id, RowID doc_id_no_beyond) {
     if (!finish_decode_docid_) {
-        posting_decoder_->DecodeCurrentDocIDBuffer(doc_buffer_);
-        current_row_id_ = last_doc_id_in_prev_block_ + doc_buffer_[0];
-        doc_buffer_cursor_ = doc_buffer_ + 1;
-        finish_decode_docid_ = true;
+        DecodeDocIDBuffer();
     }
     RowID current_row_id = current_row_id_;
+    const RowID block_base = last_doc_id_in_prev_block_;
     docid_t *cursor = doc_buffer_cursor_;
     while (current_row_id < doc_id) {
-        current_row_id += *(cursor++);
+        current_row_id = block_base + *(cursor++);
     }
     if (current_row_id <= doc_id_no_beyond) {
         return {true, current_row_id};
@@ -112,6 +110,15 @@ Pair<bool, RowID> PostingIterator::PeekInBlockRange(RowID doc_id, RowID doc_id_n
     return {false, INVALID_ROWID};
 }
 
+void PostingIterator::DecodeDocIDBuffer() {
+    posting_decoder_->DecodeCurrentDocIDBuffer(doc_buffer_);
+    // d-gaps to the offsets from the last doc of the previous block
+    PrefixSumU32(doc_buffer_, MAX_DOC_PER_RECORD);
+    current_row_id_ = last_doc_id_in_prev_block_ + doc_buffer_[0];
+    doc_buffer_cursor_ = doc_buffer_ + 1;
+    finish_decode_docid_ = true;
+}
+
 void PostingIterator::MoveToCurrentDoc(bool fetch_position) {
     need_move_to_current_doc_ = false;
     in_doc_pos_iter_inited_ = false;
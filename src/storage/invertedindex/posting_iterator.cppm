@@ -29,6 +29,9 @@ public:
 
     u32 GetDocFreq() const { return doc_freq_; }
 
+    // the doc freq of the term in the whole column, when the iterator covers only a part of its segments
+    void SetDocFreq(const u32 doc_freq) { doc_freq_ = doc_freq; }
+
     bool SkipTo(RowID doc_id);
 
     RowID PrevBlockLastDocID() const { return last_doc_id_in_prev_block_; }
@@ -109,6 +112,8 @@ private:
         }
     }
 
+    void DecodeDocIDBuffer();
+
     void MoveToCurrentDoc(bool fetch_position);
 
 private:
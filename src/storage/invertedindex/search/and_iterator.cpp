@@ -23,6 +23,7 @@ import doc_iterator;
 import multi_doc_iterator;
 import internal_types;
 import infinity_exception;
+import blockmax_leaf_iterator;
 
 namespace infinity {
 
@@ -41,10 +42,12 @@ AndIterator::AndIterator(Vector<UniquePtr<DocIterator>> iterators) : MultiDocIte
             case DocIteratorType::kTermDocIterator:
             case DocIteratorType::kPhraseIterator: {
                 ++fixed_match_count_;
+                block_max_children_.push_back(static_cast<BlockMaxLeafIterator *>(it.get()));
                 break;
             }
             default: {
                 dyn_match_ids_.push_back(i);
+                not_block_max_score_upper_bound_ += it->BM25ScoreUpperBound();
                 break;
             }
         }
@@ -57,6 +60,13 @@ bool AndIterator::Next(const RowID doc_id) {
         return true;
     RowID target_doc_id = doc_id;
     while (true) {
+        if (threshold_ > 0.0f && !block_max_children_.empty()) {
+            target_doc_id = NextBlockMaxCandidate(target_doc_id);
+            if (target_doc_id == INVALID_ROWID) {
+                doc_id_ = INVALID_ROWID;
+                return false;
+            }
+        }
         for (SizeT i = 0; i < children_.size(); i++) {
             const auto &it = children_[i];
             bool ok = it->Next(target_doc_id);
@@ -91,6 +101,27 @@ bool AndIterator::Next(const RowID doc_id) {
     }
 }
 
+RowID AndIterator::NextBlockMaxCandidate(RowID doc_id) {
+    while (true) {
+        float sum_score_bm = not_block_max_score_upper_bound_;
+        RowID block_last_doc_id = INVALID_ROWID;
+        for (auto *it : block_max_children_) {
+            if (!it->NextShallow(doc_id)) {
+                return INVALID_ROWID;
+            }
+            sum_score_bm += it->BlockMaxBM25Score();
+            block_last_doc_id = std::min(block_last_doc_id, it->BlockLastDocID());
+        }
+        if (sum_score_bm > threshold_) {
+            return doc_id;
+        }
+        if (block_last_doc_id == INVALID_ROWID) {
+            return INVALID_ROWID;
+        }
+        doc_id = block_last_doc_id + 1;
+    }
+}
+
 float AndIterator::Score() {
     if (score_cache_docid_ == doc_id_) {
         return score_cache_;
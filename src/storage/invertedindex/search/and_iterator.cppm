@@ -21,6 +21,7 @@ import index_defines;
 import doc_iterator;
 import multi_doc_iterator;
 import internal_types;
+import blockmax_leaf_iterator;
 
 namespace infinity {
 
@@ -42,12 +43,19 @@ public:
     u32 MatchCount() const override;
 
 private:
+    // Block-max AND: move the leaf children to the first block range whose summed block max scores exceed the threshold.
+    // Returns INVALID_ROWID if there is no such range.
+    RowID NextBlockMaxCandidate(RowID doc_id);
+
     // score cache
     RowID score_cache_docid_ = INVALID_ROWID;
     float score_cache_ = 0.0f;
     // for minimum_should_match
     u32 fixed_match_count_ = 0;
     Vector<u32> dyn_match_ids_{};
+    // for block-max AND
+    Vector<BlockMaxLeafIterator *> block_max_children_{};
+    float not_block_max_score_upper_bound_ = 0.0f;
 };
 
 } // namespace infinity
\ No newline at end of file
@@ -0,0 +1,189 @@
+// Copyright(C) 2023 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+module;
+
+#include <cassert>
+
+module blockmax_maxscore_iterator;
+import stl;
+import third_party;
+import index_defines;
+import blockmax_leaf_iterator;
+import multi_doc_iterator;
+import internal_types;
+import logger;
+import infinity_exception;
+
+namespace infinity {
+
+BlockMaxMaxScoreIterator::BlockMaxMaxScoreIterator(Vector<UniquePtr<DocIterator>> &&iterators) : MultiDocIterator(std::move(iterators)) {
+    bm25_score_upper_bound_ = 0.0f;
+    estimate_iterate_cost_ = {};
+    for (const auto &child : children_) {
+        auto *leaf = dynamic_cast<BlockMaxLeafIterator *>(child.get());
+        if (leaf == nullptr) {
+            UnrecoverableError("BlockMaxMaxScore only supports BlockMaxLeafIterator");
+        }
+        bm25_score_upper_bound_ += leaf->BM25ScoreUpperBound();
+        estimate_iterate_cost_ += leaf->GetEstimateIterateCost();
+        sorted_iterators_.push_back(leaf);
+    }
+    std::sort(sorted_iterators_.begin(), sorted_iterators_.end(), [](const auto &a, const auto &b) {
+        return a->BM25ScoreUpperBound() < b->BM25ScoreUpperBound();
+    });
+    prefix_upper_bounds_.resize(sorted_iterators_.size() + 1, 0.0f);
+    for (SizeT i = 0; i < sorted_iterators_.size(); ++i) {
+        prefix_upper_bounds_[i + 1] = prefix_upper_bounds_[i] + sorted_iterators_[i]->BM25ScoreUpperBound();
+    }
+}
+
+BlockMaxMaxScoreIterator::~BlockMaxMaxScoreIterator() {
+    if (SHOULD_LOG_TRACE()) {
+        LOG_TRACE(fmt::format("BlockMaxMaxScoreIterator candidate_cnt_ {}, block_skip_cnt_ {}, partial_prune_cnt_ {}, first_essential_ {}/{}",
+                              candidate_cnt_,
+                              block_skip_cnt_,
+                              partial_prune_cnt_,
+                              first_essential_,
+                              sorted_iterators_.size()));
+    }
+}
+
+void BlockMaxMaxScoreIterator::UpdateScoreThreshold(const float threshold) {
+    if (threshold <= threshold_)
+        return;
+    threshold_ = threshold;
+    const float base_threshold = threshold - BM25ScoreUpperBound();
+    for (auto *it : sorted_iterators_) {
+        it->UpdateScoreThreshold(base_threshold + it->BM25ScoreUpperBound());
+    }
+}
+
+bool BlockMaxMaxScoreIterator::Next(const RowID doc_id) {
+    assert(doc_id != INVALID_ROWID);
+    const SizeT num_iterators = sorted_iterators_.size();
+    if (!initialized_) {
+        initialized_ = true;
+        for (auto *it : sorted_iterators_) {
+            it->Next(doc_id);
+        }
+    } else if (doc_id_ != INVALID_ROWID && doc_id_ >= doc_id) {
+        return true;
+    } else {
+        // the non-essential lists are moved on demand only
+        for (SizeT i = first_essential_; i < num_iterators; ++i) {
+            sorted_iterators_[i]->Next(doc_id);
+        }
+    }
+    while (true) {
+        while (first_essential_ < num_iterators && prefix_upper_bounds_[first_essential_ + 1] <= threshold_) {
+            ++first_essential_;
+        }
+        if (first_essential_ == num_iterators) [[unlikely]] {
+            doc_id_ = INVALID_ROWID;
+            return false;
+        }
+        RowID d = INVALID_ROWID;
+        for (SizeT i = first_essential_; i < num_iterators; ++i) {
+            d = std::min(d, sorted_iterators_[i]->DocID());
+        }
+        if (d == INVALID_ROWID) {
+            doc_id_ = INVALID_ROWID;
+            return false;
+        }
+        ++candidate_cnt_;
+
+        // block max bound of the essential lists, valid until one of their current blocks ends or another list begins
+        float sum_score_bm = prefix_upper_bounds_[first_essential_];
+        RowID skip_to = INVALID_ROWID;
+        for (SizeT i = first_essential_; i < num_iterators; ++i) {
+            auto *it = sorted_iterators_[i];
+            if (const auto it_doc_id = it->DocID(); it_doc_id != d) {
+                skip_to = std::min(skip_to, it_doc_id);
+            } else {
+                sum_score_bm += it->BlockMaxBM25Score();
+                if (const auto block_last_doc_id = it->BlockLastDocID(); block_last_doc_id != INVALID_ROWID) {
+                    skip_to = std::min(skip_to, block_last_doc_id + 1);
+                }
+            }
+        }
+        if (sum_score_bm <= threshold_) {
+            ++block_skip_cnt_;
+            if (skip_to == INVALID_ROWID) {
+                doc_id_ = INVALID_ROWID;
+                return false;
+            }
+            for (SizeT i = first_essential_; i < num_iterators; ++i) {
+                if (sorted_iterators_[i]->DocID() == d) {
+                    sorted_iterators_[i]->Next(skip_to);
+                }
+            }
+            continue;
+        }
+
+        float sum_score = 0.0f;
+        for (SizeT i = first_essential_; i < num_iterators; ++i) {
+            if (sorted_iterators_[i]->DocID() == d) {
+                sum_score += sorted_iterators_[i]->BM25Score();
+            }
+        }
+        // probe the non-essential lists from the largest upper bound, stop once d can't exceed the threshold
+        bool pruned = false;
+        for (SizeT i = first_essential_; i-- > 0;) {
+            if (sum_score + prefix_upper_bounds_[i + 1] <= threshold_) {
+                pruned = true;
+                break;
+            }
+            auto *it = sorted_iterators_[i];
+            if (it->DocID() < d) {
+                if (!it->NextShallow(d)) {
+                    continue;
+                }
+                if (sum_score + prefix_upper_bounds_[i] + it->BlockMaxBM25Score() <= threshold_) {
+                    pruned = true;
+                    break;
+                }
+                it->Next(d);
+            }
+            if (it->DocID() == d) {
+                sum_score += it->BM25Score();
+            }
+        }
+        if (!pruned && sum_score > threshold_) {
+            doc_id_ = d;
+            score_cache_ = sum_score;
+            return true;
+        }
+        ++partial_prune_cnt_;
+        for (SizeT i = first_essential_; i < num_iterators; ++i) {
+            if (sorted_iterators_[i]->DocID() == d) {
+                sorted_iterators_[i]->Next(d + 1);
+            }
+        }
+    }
+}
+
+u32 BlockMaxMaxScoreIterator::MatchCount() const {
+    u32 count = 0;
+    if (const auto current_doc_id = DocID(); current_doc_id != INVALID_ROWID) {
+        for (const auto *it : sorted_iterators_) {
+            if (it->DocID() == current_doc_id) {
+                count += it->MatchCount();
+            }
+        }
+    }
+    return count;
+}
+
+} // namespace infinity
@@ -0,0 +1,62 @@
+// Copyright(C) 2023 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+module;
+
+export module blockmax_maxscore_iterator;
+import stl;
+import index_defines;
+import doc_iterator;
+import blockmax_leaf_iterator;
+import multi_doc_iterator;
+import internal_types;
+
+namespace infinity {
+
+// Block-max MaxScore, refers to https://dl.acm.org/doi/10.1145/3077136.3080780
+// The lists are split by their upper bounds into the essential and the non-essential ones. Only the essential lists
+// generate candidates, the non-essential ones are probed for the candidates which may still enter the top-k.
+export class BlockMaxMaxScoreIterator : public MultiDocIterator {
+public:
+    explicit BlockMaxMaxScoreIterator(Vector<UniquePtr<DocIterator>> &&iterators);
+
+    ~BlockMaxMaxScoreIterator() override;
+
+    DocIteratorType GetType() const override { return DocIteratorType::kBlockMaxMaxScoreIterator; }
+
+    String Name() const override { return "BlockMaxMaxScoreIterator"; }
+
+    void UpdateScoreThreshold(float threshold) override;
+
+    bool Next(RowID doc_id) override;
+
+    float BM25Score() { return doc_id_ == INVALID_ROWID ? 0.0f : score_cache_; }
+
+    float Score() override { return BM25Score(); }
+
+    u32 MatchCount() const override;
+
+private:
+    Vector<BlockMaxLeafIterator *> sorted_iterators_; // sort by BM25ScoreUpperBound(), in ascending order
+    Vector<float> prefix_upper_bounds_;               // prefix_upper_bounds_[i] is the sum of the upper bounds of [0, i)
+    SizeT first_essential_ = 0;                       // the lists before it can't exceed the threshold by themselves
+    bool initialized_ = false;
+    float score_cache_ = 0.0f;
+    // debug info
+    u32 candidate_cnt_ = 0;
+    u32 block_skip_cnt_ = 0;
+    u32 partial_prune_cnt_ = 0;
+};
+
+} // namespace infinity
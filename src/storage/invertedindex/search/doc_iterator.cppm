@@ -24,11 +24,12 @@ import internal_types;
 namespace infinity {
 
 export enum class EarlyTermAlgo {
-    kAuto,    // choose between kNaive, kBatch, kBMW
-    kNaive,   // naive or
-    kBatch,   // use batch_or if (sum_of_df > total_doc_num / 4) and term nodes under or node achieve a certain number
-    kBMW,     // use bmw if it is "or iterator" on the top level and has only term children
-    kCompare, // compare bmw, batch, naive
+    kAuto,     // choose between kNaive, kBatch, kBMW, kMaxScore
+    kNaive,    // naive or
+    kBatch,    // use batch_or if (sum_of_df > total_doc_num / 4) and term nodes under or node achieve a certain number
+    kBMW,      // use bmw if it is "or iterator" on the top level and has only term children
+    kMaxScore, // use block-max maxscore if it is "or iterator" on the top level and has only term children
+    kCompare,  // compare bmw, batch, naive
 };
 
 export enum class DocIteratorType : u8 {
@@ -40,6 +41,7 @@ export enum class DocIteratorType : u8 {
     kMinimumShouldMatchIterator,
     kBatchOrIterator,
     kBMWIterator,
+    kBlockMaxMaxScoreIterator,
     kFilterIterator,
     kScoreThresholdIterator,
     kKeywordIterator,
@@ -44,7 +44,7 @@ public:
             }
             doc_id = query_iterator_->DocID();
             // check filter
-            if (common_query_filter_ == nullptr || common_query_filter_->PassFilter(doc_id)) {
+            if (common_query_filter_ == nullptr || common_query_filter_->PassFilter(doc_id, filter_cursor_)) {
                 doc_id_ = doc_id;
                 return true;
             }
@@ -63,6 +63,7 @@ public:
 
 private:
     CommonQueryFilter *common_query_filter_{};
+    CommonQueryFilterCursor filter_cursor_{};
     UniquePtr<DocIterator> query_iterator_{};
 };
 
@@ -38,19 +38,24 @@ public:
 
     String Name() const override { return "MustFirstIterator"; }
 
-    bool Next(const RowID doc_id) override {
-        children_[0]->Next(doc_id);
-        const auto current_doc_id = children_[0]->DocID();
-        if (current_doc_id == INVALID_ROWID) [[unlikely]] {
+    bool Next(RowID doc_id) override {
+        while (true) {
+            children_[0]->Next(doc_id);
+            const auto current_doc_id = children_[0]->DocID();
+            if (current_doc_id == INVALID_ROWID) [[unlikely]] {
+                doc_id_ = current_doc_id;
+                return false;
+            }
+            // now current_doc_id < INVALID_ROWID
+            for (u32 i = 1; i < children_.size(); ++i) {
+                children_[i]->Next(current_doc_id);
+            }
             doc_id_ = current_doc_id;
-            return false;
-        }
-        // now current_doc_id < INVALID_ROWID
-        for (u32 i = 1; i < children_.size(); ++i) {
-            children_[i]->Next(current_doc_id);
+            if (threshold_ <= 0.0f || Score() > threshold_) {
+                return true;
+            }
+            doc_id = current_doc_id + 1;
         }
-        doc_id_ = current_doc_id;
-        return true;
     }
 
     float Score() override {
@@ -84,11 +84,25 @@ bool PhraseDocIterator::Next(const RowID doc_id) {
             }
         }
         if (target_doc_id == pos_iters_[0]->DocID()) {
+            if (threshold_ > 0.0f) {
+                // skip the blocks which can't exceed the threshold before matching the positions
+                UpdateBlockRangeDocID();
+                if (BlockMaxBM25Score() <= threshold_) {
+                    if (block_last_doc_id_ == INVALID_ROWID) {
+                        doc_id_ = INVALID_ROWID;
+                        return false;
+                    }
+                    target_doc_id = block_last_doc_id_ + 1;
+                    continue;
+                }
+            }
             bool found = GetPhraseMatchData();
-            if (found && (threshold_ <= 0.0f || BM25Score() > threshold_)) {
+            if (found) {
                 doc_id_ = target_doc_id;
-                UpdateBlockRangeDocID();
-                return true;
+                if (threshold_ <= 0.0f || BM25Score() > threshold_) {
+                    UpdateBlockRangeDocID();
+                    return true;
+                }
             }
             ++target_doc_id;
         }
@@ -21,6 +21,7 @@ import or_iterator;
 import term_doc_iterator;
 import phrase_doc_iterator;
 import blockmax_wand_iterator;
+import blockmax_maxscore_iterator;
 import minimum_should_match_iterator;
 import parse_fulltext_options;
 import keyword_iterator;
@@ -29,6 +30,8 @@ import batch_or_iterator;
 import blockmax_leaf_iterator;
 import rank_feature_doc_iterator;
 import rank_features_doc_iterator;
+import default_values;
+import fst;
 
 namespace infinity {
 
@@ -69,7 +72,10 @@ std::unique_ptr<QueryNode> QueryNode::GetOptimizedQueryTree(std::unique_ptr<Quer
     switch (root->GetType()) {
         case QueryNodeType::TERM:
         case QueryNodeType::PHRASE:
-        case QueryNodeType::KEYWORD: {
+        case QueryNodeType::KEYWORD:
+        case QueryNodeType::PREFIX_TERM:
+        case QueryNodeType::WILDCARD_TERM:
+        case QueryNodeType::FUZZY_TERM: {
             // no need to optimize
             optimized_root = std::move(root);
             break;
@@ -116,7 +122,10 @@ std::unique_ptr<QueryNode> MultiQueryNode::GetNewOptimizedQueryTree() {
         switch (child->GetType()) {
             case QueryNodeType::TERM:
             case QueryNodeType::PHRASE:
-            case QueryNodeType::KEYWORD: {
+            case QueryNodeType::KEYWORD:
+            case QueryNodeType::PREFIX_TERM:
+            case QueryNodeType::WILDCARD_TERM:
+            case QueryNodeType::FUZZY_TERM: {
                 // no need to optimize
                 break;
             }
@@ -169,6 +178,9 @@ std::unique_ptr<QueryNode> NotQueryNode::InnerGetNewOptimizedQueryTree() {
             case QueryNodeType::TERM:
             case QueryNodeType::PHRASE:
             case QueryNodeType::KEYWORD:
+            case QueryNodeType::PREFIX_TERM:
+            case QueryNodeType::WILDCARD_TERM:
+            case QueryNodeType::FUZZY_TERM:
             case QueryNodeType::AND:
             case QueryNodeType::AND_NOT: {
                 new_not_list.emplace_back(std::move(child));
@@ -222,6 +234,9 @@ std::unique_ptr<QueryNode> AndQueryNode::InnerGetNewOptimizedQueryTree() {
             case QueryNodeType::TERM:
             case QueryNodeType::PHRASE:
             case QueryNodeType::KEYWORD:
+            case QueryNodeType::PREFIX_TERM:
+            case QueryNodeType::WILDCARD_TERM:
+            case QueryNodeType::FUZZY_TERM:
             case QueryNodeType::OR: {
                 and_list.emplace_back(std::move(child));
                 break;
@@ -312,6 +327,9 @@ std::unique_ptr<QueryNode> OrQueryNode::InnerGetNewOptimizedQueryTree() {
             case QueryNodeType::TERM:
             case QueryNodeType::PHRASE:
             case QueryNodeType::KEYWORD:
+            case QueryNodeType::PREFIX_TERM:
+            case QueryNodeType::WILDCARD_TERM:
+            case QueryNodeType::FUZZY_TERM:
             case QueryNodeType::AND:
             case QueryNodeType::AND_NOT: {
                 or_list.emplace_back(std::move(child));
@@ -538,9 +556,9 @@ std::unique_ptr<DocIterator> OrQueryNode::CreateSearch(const CreateSearchParams
     bool all_are_term_or_phrase = true; // describe sub_doc_iters
     const QueryNode *only_child = nullptr;
     const auto next_params = params.RemoveMSM();
-    for (auto &child : children_) {
+    auto add_child_search = [&](const QueryNode *child) {
         if (auto iter = child->CreateSearch(next_params, false); iter) {
-            only_child = child.get();
+            only_child = child;
             if (const auto child_type = child->GetType(); child_type == QueryNodeType::KEYWORD) {
                 keyword_iters.emplace_back(std::move(iter));
             } else {
@@ -550,6 +568,23 @@ std::unique_ptr<DocIterator> OrQueryNode::CreateSearch(const CreateSearchParams
                 }
             }
         }
+    };
+    for (auto &child : children_) {
+        const auto *multi_term_child = dynamic_cast<const MultiTermQueryNode *>(child.get());
+        if (multi_term_child == nullptr || params.minimum_should_match > 1) {
+            add_child_search(child.get());
+            continue;
+        }
+        // search the expanded terms as the children of this node, so that BMW and MaxScore still apply
+        if (const QueryNode *expanded = multi_term_child->GetExpandedQuery(params); expanded == nullptr) {
+            continue;
+        } else if (expanded->GetType() == QueryNodeType::OR) {
+            for (const auto &term_node : static_cast<const OrQueryNode *>(expanded)->children_) {
+                add_child_search(term_node.get());
+            }
+        } else {
+            add_child_search(expanded);
+        }
     }
     if (sub_doc_iters.size() < 2) {
         // 0 or 1
@@ -593,7 +628,7 @@ std::unique_ptr<DocIterator> OrQueryNode::CreateSearch(const CreateSearchParams
             }
         }
     };
-    [[maybe_unused]] auto term_num_threshold = [](const u32 topn) -> u32 {
+    auto term_num_threshold = [](const u32 topn) -> u32 {
         if (topn < 5u) {
             return std::numeric_limits<u32>::max();
         }
@@ -624,8 +659,10 @@ std::unique_ptr<DocIterator> OrQueryNode::CreateSearch(const CreateSearchParams
         auto choose_algo = EarlyTermAlgo::kNaive;
         switch (params.early_term_algo) {
             case EarlyTermAlgo::kAuto: {
-                if (params.topn) {
-                    // always prefer BMW
+                if (params.topn && sub_doc_iters.size() > term_num_threshold(params.topn)) {
+                    // many lists: maxscore only generates candidates from the lists with large upper bounds
+                    choose_algo = EarlyTermAlgo::kMaxScore;
+                } else if (params.topn) {
                     choose_algo = EarlyTermAlgo::kBMW;
                 } else if (term_children_need_batch()) {
                     // topn == 0, case of filter
@@ -645,6 +682,7 @@ std::unique_ptr<DocIterator> OrQueryNode::CreateSearch(const CreateSearchParams
                 break;
             }
             case EarlyTermAlgo::kBMW:
+            case EarlyTermAlgo::kMaxScore:
             case EarlyTermAlgo::kBatch:
             case EarlyTermAlgo::kNaive: {
                 choose_algo = params.early_term_algo;
@@ -659,6 +697,9 @@ std::unique_ptr<DocIterator> OrQueryNode::CreateSearch(const CreateSearchParams
             case EarlyTermAlgo::kBMW: {
                 return GetIterResultT.template operator()<BlockMaxWandIterator>();
             }
+            case EarlyTermAlgo::kMaxScore: {
+                return GetIterResultT.template operator()<BlockMaxMaxScoreIterator>();
+            }
             case EarlyTermAlgo::kNaive: {
                 return GetIterResultT.template operator()<OrIterator>();
             }
@@ -747,6 +788,50 @@ std::unique_ptr<DocIterator> KeywordQueryNode::CreateSearch(const CreateSearchPa
     return std::make_unique<KeywordIterator>(std::move(sub_doc_iters), GetWeight());
 }
 
+const QueryNode *MultiTermQueryNode::GetExpandedQuery(const CreateSearchParams &params) const {
+    std::call_once(expand_flag_, [&] {
+        ColumnID column_id = params.table_info->GetColumnIdByName(column_);
+        ColumnIndexReader *column_index_reader = params.index_reader->GetColumnIndexReader(column_id, params.index_names_);
+        if (!column_index_reader) {
+            RecoverableError(Status::SyntaxError(fmt::format(R"(Invalid query statement: Column "{}" has no fulltext index)", column_)));
+        }
+        auto automaton = MakeAutomaton();
+        Vector<String> terms = column_index_reader->ExpandTerms(*automaton, MATCH_MAX_TERM_EXPANSIONS);
+        auto make_term_node = [&](String &term) {
+            auto term_node = MakeUnique<TermQueryNode>();
+            term_node->term_ = std::move(term);
+            term_node->column_ = column_;
+            term_node->MultiplyWeight(GetWeight());
+            return term_node;
+        };
+        if (terms.size() == 1) {
+            expanded_ = make_term_node(terms[0]);
+        } else if (terms.size() > 1) {
+            auto or_node = MakeUnique<OrQueryNode>();
+            for (auto &term : terms) {
+                or_node->Add(make_term_node(term));
+            }
+            expanded_ = std::move(or_node);
+        }
+    });
+    return expanded_.get();
+}
+
+std::unique_ptr<DocIterator> MultiTermQueryNode::CreateSearch(const CreateSearchParams params, const bool is_top_level) const {
+    const QueryNode *expanded = GetExpandedQuery(params);
+    if (!expanded) {
+        return nullptr;
+    }
+    // one leaf of the query, minimum_should_match does not apply to its expansions
+    return expanded->CreateSearch(params.RemoveMSM(), is_top_level);
+}
+
+std::unique_ptr<FstAutomaton> PrefixTermQueryNode::MakeAutomaton() const { return MakeUnique<PrefixAutomaton>(prefix_); }
+
+std::unique_ptr<FstAutomaton> WildcardTermQueryNode::MakeAutomaton() const { return MakeUnique<WildcardAutomaton>(pattern_); }
+
+std::unique_ptr<FstAutomaton> FuzzyTermQueryNode::MakeAutomaton() const { return MakeUnique<LevenshteinAutomaton>(term_, max_edits_); }
+
 std::unique_ptr<DocIterator> NotQueryNode::CreateSearch(CreateSearchParams, bool) const {
     UnrecoverableError("NOT query node should be optimized into AND_NOT query node");
     return nullptr;
@@ -776,6 +861,10 @@ std::string QueryNodeTypeToString(const QueryNodeType type) {
             return "PHRASE";
         case QueryNodeType::PREFIX_TERM:
             return "PREFIX_TERM";
+        case QueryNodeType::WILDCARD_TERM:
+            return "WILDCARD_TERM";
+        case QueryNodeType::FUZZY_TERM:
+            return "FUZZY_TERM";
         case QueryNodeType::SUFFIX_TERM:
             return "SUFFIX_TERM";
         case QueryNodeType::SUBSTRING_TERM:
@@ -835,6 +924,42 @@ void PhraseQueryNode::GetQueryColumnsTerms(std::vector<std::string> &columns, st
     }
 }
 
+void MultiTermQueryNode::GetQueryColumnsTerms(std::vector<std::string> &columns, std::vector<std::string> &) const {
+    // the terms are only known after the expansion
+    columns.push_back(column_);
+}
+
+void PrefixTermQueryNode::PrintTree(std::ostream &os, const std::string &prefix, const bool is_final) const {
+    os << prefix;
+    os << (is_final ? "└──" : "├──");
+    os << QueryNodeTypeToString(type_);
+    os << " (weight: " << weight_ << ")";
+    os << " (column: " << column_ << ")";
+    os << " (prefix: " << prefix_ << ")";
+    os << '\n';
+}
+
+void WildcardTermQueryNode::PrintTree(std::ostream &os, const std::string &prefix, const bool is_final) const {
+    os << prefix;
+    os << (is_final ? "└──" : "├──");
+    os << QueryNodeTypeToString(type_);
+    os << " (weight: " << weight_ << ")";
+    os << " (column: " << column_ << ")";
+    os << " (pattern: " << pattern_ << ")";
+    os << '\n';
+}
+
+void FuzzyTermQueryNode::PrintTree(std::ostream &os, const std::string &prefix, const bool is_final) const {
+    os << prefix;
+    os << (is_final ? "└──" : "├──");
+    os << QueryNodeTypeToString(type_);
+    os << " (weight: " << weight_ << ")";
+    os << " (column: " << column_ << ")";
+    os << " (term: " << term_ << ")";
+    os << " (max edits: " << max_edits_ << ")";
+    os << '\n';
+}
+
 void MultiQueryNode::PrintTree(std::ostream &os, const std::string &prefix, const bool is_final) const {
     os << prefix;
     os << (is_final ? "└──" : "├──");
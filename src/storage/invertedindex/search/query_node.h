@@ -16,6 +16,7 @@
 #define QUERY_NODE_H
 
 #include <memory>
+#include <mutex>
 #include <ostream>
 #include <string>
 #include <vector>
@@ -38,8 +39,11 @@ enum class QueryNodeType : char {
     AND_NOT,
     OR,
     KEYWORD,
-    // unimplemented:
+    // expanded to the terms of the column in search:
     PREFIX_TERM,
+    WILDCARD_TERM,
+    FUZZY_TERM,
+    // unimplemented:
     SUFFIX_TERM,
     SUBSTRING_TERM,
 };
@@ -55,6 +59,7 @@ enum class EarlyTermAlgo;
 enum class FulltextSimilarity;
 struct BM25Params;
 struct TableInfo;
+class FstAutomaton;
 
 struct CreateSearchParams {
     const TableInfo *table_info;
@@ -219,8 +224,68 @@ struct KeywordQueryNode final : public MultiQueryNode {
     std::unique_ptr<DocIterator> CreateSearch(CreateSearchParams params, bool is_top_level) const override;
 };
 
+// MultiTermQueryNode matches the terms of the column accepted by an automaton
+// it is expanded to at most MATCH_MAX_TERM_EXPANSIONS terms when the search is created, and searched as their "or"
+struct MultiTermQueryNode : public QueryNode {
+    std::string column_;
+
+    explicit MultiTermQueryNode(QueryNodeType type) : QueryNode(type) {}
+
+    uint32_t LeafCount() const override { return 1; }
+    void PushDownWeight(float factor) override { MultiplyWeight(factor); }
+    std::unique_ptr<DocIterator> CreateSearch(CreateSearchParams params, bool is_top_level) const override;
+    void GetQueryColumnsTerms(std::vector<std::string> &columns, std::vector<std::string> &terms) const override;
+
+    // the term node, or the "or" node of the term nodes, it is expanded to
+    // nullptr if no term matches
+    const QueryNode *GetExpandedQuery(const CreateSearchParams &params) const;
+
+protected:
+    virtual std::unique_ptr<FstAutomaton> MakeAutomaton() const = 0;
+
+private:
+    // expanded once, the iterators keep pointers to the terms
+    mutable std::once_flag expand_flag_;
+    mutable std::unique_ptr<QueryNode> expanded_;
+};
+
+struct PrefixTermQueryNode final : public MultiTermQueryNode {
+    std::string prefix_;
+
+    PrefixTermQueryNode() : MultiTermQueryNode(QueryNodeType::PREFIX_TERM) {}
+
+    void PrintTree(std::ostream &os, const std::string &prefix, bool is_final) const override;
+
+protected:
+    std::unique_ptr<FstAutomaton> MakeAutomaton() const override;
+};
+
+// '*' matches any sequence of characters, '?' matches one character, '\' escapes the next character
+struct WildcardTermQueryNode final : public MultiTermQueryNode {
+    std::string pattern_;
+
+    WildcardTermQueryNode() : MultiTermQueryNode(QueryNodeType::WILDCARD_TERM) {}
+
+    void PrintTree(std::ostream &os, const std::string &prefix, bool is_final) const override;
+
+protected:
+    std::unique_ptr<FstAutomaton> MakeAutomaton() const override;
+};
+
+// matches the terms within max_edits_ Levenshtein distance of term_
+struct FuzzyTermQueryNode final : public MultiTermQueryNode {
+    std::string term_;
+    uint32_t max_edits_;
+
+    FuzzyTermQueryNode() : MultiTermQueryNode(QueryNodeType::FUZZY_TERM) {}
+
+    void PrintTree(std::ostream &os, const std::string &prefix, bool is_final) const override;
+
+protected:
+    std::unique_ptr<FstAutomaton> MakeAutomaton() const override;
+};
+
 // unimplemented
-struct PrefixTermQueryNode;
 struct SuffixTermQueryNode;
 struct SubstringTermQueryNode;
 
@@ -270,6 +270,90 @@ SearchDriver::AnalyzeAndBuildQueryNode(const std::string &field, const std::stri
     }
 }
 
+std::unique_ptr<QueryNode> SearchDriver::BuildWildcardQueryNode(const std::string &field, const std::string &raw_pattern) const {
+    // unescape all but the wildcards, and the backslash escaping them
+    std::string pattern;
+    pattern.reserve(raw_pattern.size());
+    size_t wildcard_cnt = 0;
+    bool trailing_star = false;
+    for (size_t i = 0; i < raw_pattern.size(); ++i) {
+        const char c = raw_pattern[i];
+        trailing_star = false;
+        if (c == '\\' && i + 1 < raw_pattern.size()) {
+            const char next = raw_pattern[++i];
+            if (next == '*' || next == '?' || next == '\\') {
+                pattern.push_back('\\');
+            }
+            pattern.push_back(next);
+            continue;
+        }
+        if (c == '*' || c == '?') {
+            ++wildcard_cnt;
+            trailing_star = c == '*';
+        }
+        pattern.push_back(c);
+    }
+    // the terms are not analyzed, follow the lowercase filter of the analyzers
+    if (AnalyzerPool::AnalyzerNameToInt(GetAnalyzerName(field, field2analyzer_).c_str()) != keyword_analyzer_name_int) {
+        ToLower(pattern);
+    }
+    if (wildcard_cnt == 1 && trailing_star) {
+        auto result = std::make_unique<PrefixTermQueryNode>();
+        pattern.pop_back();
+        result->prefix_ = Unescape(pattern);
+        result->column_ = field;
+        return result;
+    }
+    auto result = std::make_unique<WildcardTermQueryNode>();
+    result->pattern_ = std::move(pattern);
+    result->column_ = field;
+    return result;
+}
+
+std::unique_ptr<QueryNode>
+SearchDriver::AnalyzeAndBuildFuzzyQueryNode(const std::string &field, const std::string &text, const unsigned long max_edits) const {
+    if (text.empty()) {
+        LOG_TRACE(std::format("{} : Empty query text: {}", __func__, text));
+        return nullptr;
+    }
+    const auto analyzer_name = GetAnalyzerName(field, field2analyzer_);
+    auto [analyzer, status] = AnalyzerPool::instance().GetAnalyzer(analyzer_name);
+    if (!status.ok()) {
+        RecoverableError(std::move(status));
+    }
+    TermList terms = GetTermListFromAnalyzer(analyzer_name, analyzer.get(), text);
+    if (terms.empty()) {
+        return nullptr;
+    }
+    auto build_fuzzy = [&](const std::string &term) {
+        auto result = std::make_unique<FuzzyTermQueryNode>();
+        result->term_ = term;
+        result->column_ = field;
+        // as lucene, more edits match too many terms to be useful
+        result->max_edits_ = std::min(max_edits, 2ul);
+        return result;
+    };
+    if (terms.size() == 1) {
+        return build_fuzzy(terms.front().text_);
+    }
+    auto result = std::make_unique<OrQueryNode>();
+    for (const auto &term : terms) {
+        result->Add(build_fuzzy(term.text_));
+    }
+    return result;
+}
+
+bool SearchDriver::HasWildcard(const std::string &raw_text) {
+    for (size_t i = 0; i < raw_text.size(); ++i) {
+        if (raw_text[i] == '\\') {
+            ++i;
+        } else if (raw_text[i] == '*' || raw_text[i] == '?') {
+            return true;
+        }
+    }
+    return false;
+}
+
 // Unescape reserved characters per https://www.elastic.co/guide/en/elasticsearch/reference/current/query-dsl-query-string-query.html
 // Shall keep sync with ESCAPEABLE in search_lexer.l
 // [\x20()^"'~*?:\\]
@@ -48,8 +48,17 @@ public:
     [[nodiscard]] std::unique_ptr<QueryNode>
     AnalyzeAndBuildQueryNode(const std::string &field, const std::string &text, bool from_quoted, unsigned long slop = 0) const;
 
+    // used in SearchParser for unquoted text with unescaped '*' or '?'. Assumes field is unescaped, raw_pattern is not.
+    [[nodiscard]] std::unique_ptr<QueryNode> BuildWildcardQueryNode(const std::string &field, const std::string &raw_pattern) const;
+
+    // used in SearchParser for unquoted text followed by "~N". Assumes field and text are both unescaped.
+    [[nodiscard]] std::unique_ptr<QueryNode> AnalyzeAndBuildFuzzyQueryNode(const std::string &field, const std::string &text, unsigned long max_edits) const;
+
     [[nodiscard]] static std::string Unescape(const std::string &text);
 
+    // whether the raw text has unescaped '*' or '?'
+    [[nodiscard]] static bool HasWildcard(const std::string &raw_text);
+
     /**
      * parsing options
      */
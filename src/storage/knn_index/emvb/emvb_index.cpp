@@ -26,6 +26,7 @@ import vector_distance;
 import emvb_product_quantization;
 import emvb_search;
 import kmeans_partition;
+import infinity_context;
 import index_base;
 import status;
 import logger;
@@ -77,7 +78,8 @@ void EMVBIndex::BuildEMVBIndex(const RowID base_rowid,
                                const u32 row_count,
                                const SegmentEntry *segment_entry,
                                const SharedPtr<ColumnDef> &column_def,
-                               BufferManager *buffer_mgr) {
+                               BufferManager *buffer_mgr,
+                               KMeansProgress *kmeans_progress) {
     const auto time_0 = std::chrono::high_resolution_clock::now();
     {
         const SegmentID expected_segment_id = base_rowid.segment_id_;
@@ -177,7 +179,7 @@ void EMVBIndex::BuildEMVBIndex(const RowID base_rowid,
             LOG_INFO(std::move(oss).str());
         }
         // call train
-        Train(centroid_count, training_data.get(), training_embedding_num, 20);
+        Train(centroid_count, training_data.get(), training_embedding_num, 20, kmeans_progress);
         const auto time_3 = std::chrono::high_resolution_clock::now();
         {
             std::ostringstream oss;
@@ -221,7 +223,11 @@ void EMVBIndex::BuildEMVBIndex(const RowID base_rowid,
 // 2. (32 ~ 256) * (1 << residual_pq_subspace_bits) for residual product quantizer
 u64 EMVBIndex::ExpectLeastTrainingDataNum() const { return std::max<u64>(32ul * n_centroids_, 32ul * (1ul << residual_pq_subspace_bits_)); }
 
-void EMVBIndex::Train(const u32 centroids_num, const f32 *embedding_data, const u64 embedding_num, const u32 iter_cnt) {
+void EMVBIndex::Train(const u32 centroids_num,
+                      const f32 *embedding_data,
+                      const u64 embedding_num,
+                      const u32 iter_cnt,
+                      KMeansProgress *kmeans_progress) {
     // set n_centroids_
     n_centroids_ = centroids_num;
     // check n_centroids_
@@ -242,8 +248,18 @@ void EMVBIndex::Train(const u32 centroids_num, const f32 *embedding_data, const
     // step 1. train centroids
     const auto time_0 = std::chrono::high_resolution_clock::now();
     {
-        const auto result_centroid_num =
-            GetKMeansCentroids(MetricType::kMetricL2, embedding_dimension_, embedding_num, embedding_data, centroids_data_, n_centroids_, iter_cnt);
+        const KMeansOption kmeans_option{.thread_pool_ = &InfinityContext::instance().GetVectorIndexBuildThreadPool(), .progress_ = kmeans_progress};
+        const auto result_centroid_num = GetKMeansCentroids(MetricType::kMetricL2,
+                                                            embedding_dimension_,
+                                                            embedding_num,
+                                                            embedding_data,
+                                                            centroids_data_,
+                                                            n_centroids_,
+                                                            iter_cnt,
+                                                            32,
+                                                            256,
+                                                            1.0f,
+                                                            kmeans_option);
         if (result_centroid_num != n_centroids_) {
             const auto error_msg =
                 fmt::format("EMVBIndex::Train: KMeans failed to get {} centroids, got {} instead.", n_centroids_, result_centroid_num);
@@ -18,6 +18,7 @@ export module emvb_index;
 import stl;
 import emvb_shared_vec;
 import roaring_bitmap;
+import kmeans_partition;
 
 namespace infinity {
 
@@ -59,9 +60,10 @@ public:
                         u32 row_count,
                         const SegmentEntry *segment_entry,
                         const SharedPtr<ColumnDef> &column_def,
-                        BufferManager *buffer_mgr);
+                        BufferManager *buffer_mgr,
+                        KMeansProgress *kmeans_progress = nullptr);
 
-    void Train(u32 centroids_num, const f32 *embedding_data, u64 embedding_num, u32 iter_cnt = 20);
+    void Train(u32 centroids_num, const f32 *embedding_data, u64 embedding_num, u32 iter_cnt = 20, KMeansProgress *kmeans_progress = nullptr);
 
     void AddOneDocEmbeddings(const f32 *embedding_data, u32 embedding_num);
 
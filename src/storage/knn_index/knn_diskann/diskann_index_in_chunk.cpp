@@ -0,0 +1,359 @@
+// Copyright(C) 2024 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+module;
+
+#include <chrono>
+
+module diskann_index_in_chunk;
+
+import stl;
+import internal_types;
+import default_values;
+import pq_flash_index;
+import diskann_index_data;
+import diskann_dist_func;
+import index_base;
+import index_diskann;
+import local_file_handle;
+import virtual_store;
+import segment_entry;
+import block_entry;
+import column_vector;
+import buffer_manager;
+import infinity_exception;
+import status;
+import logger;
+import third_party;
+
+namespace infinity {
+
+namespace {
+
+constexpr u64 DISKANN_CHUNK_MAGIC = 0x4b4e484341534944; // "DISACHNK"
+
+struct DiskAnnChunkHeader {
+    u64 magic_{};
+    u32 dimension_{};
+    u32 row_count_{};
+    u32 num_pq_chunks_{};
+    u32 reserved_{};
+    // offsets are relative to the beginning of the chunk
+    u64 pq_pivot_offset_{};
+    u64 pq_pivot_size_{};
+    u64 pq_data_offset_{};
+    u64 pq_data_size_{};
+    u64 index_offset_{};
+    u64 index_size_{};
+};
+
+static_assert(sizeof(DiskAnnChunkHeader) <= DISKANN_SECTOR_LEN);
+
+constexpr SizeT COPY_BUFFER_SIZE = 1024 * 1024;
+
+void AppendZeros(LocalFileHandle &file_handle, SizeT size) {
+    if (size == 0) {
+        return;
+    }
+    Vector<char> zeros(size, 0);
+    file_handle.Append(zeros.data(), size);
+}
+
+void CopyFileRange(const String &src_path, u64 offset, u64 size, LocalFileHandle &dst_handle) {
+    auto [src_handle, status] = VirtualStore::Open(src_path, FileAccessMode::kRead);
+    if (!status.ok()) {
+        UnrecoverableError(status.message());
+    }
+    src_handle->Seek(offset);
+    Vector<char> buffer(std::min<u64>(size, COPY_BUFFER_SIZE));
+    while (size > 0) {
+        SizeT read_size = std::min<u64>(size, buffer.size());
+        auto [read_n, read_status] = src_handle->Read(buffer.data(), read_size);
+        if (!read_status.ok() || read_n != read_size) {
+            UnrecoverableError(fmt::format("DiskAnnIndexInChunk: failed to read {} bytes at {} of {}", read_size, offset, src_path));
+        }
+        dst_handle.Append(buffer.data(), read_size);
+        offset += read_size;
+        size -= read_size;
+    }
+}
+
+} // namespace
+
+DiskAnnIndexInChunk::DiskAnnIndexInChunk(const IndexDiskAnn *index_diskann, u32 dimension, u32 start_segment_offset, String build_dir)
+    : index_diskann_(index_diskann), dimension_(dimension), start_segment_offset_(start_segment_offset), build_dir_(std::move(build_dir)) {
+    // same as the clamp in DiskAnnIndexData::BuildIndex
+    num_pq_chunks_ = std::max<u32>(index_diskann_->num_pq_chunks_, 1);
+    num_pq_chunks_ = std::min<u32>(num_pq_chunks_, dimension_);
+    num_pq_chunks_ = std::min<u32>(num_pq_chunks_, DISKANN_MAX_PQ_CHUNKS);
+}
+
+DiskAnnIndexInChunk::~DiskAnnIndexInChunk() {
+    pq_flash_index_.reset();
+    if (VirtualStore::Exists(build_dir_)) {
+        VirtualStore::RemoveDirectory(build_dir_);
+    }
+}
+
+SizeT DiskAnnIndexInChunk::EstimateMemoryCost(const IndexDiskAnn *index_diskann, u32 dimension, u32 row_count) {
+    const SizeT num_pq_chunks = std::min<SizeT>(std::max<SizeT>(index_diskann->num_pq_chunks_, 1), dimension);
+    const SizeT node_bytes = dimension * sizeof(f32) + (index_diskann->R_ + 1) * sizeof(SizeT);
+    const SizeT cached_nodes = std::min<SizeT>({DISKANN_NUM_NODES_TO_CACHE,
+                                                row_count / 10,
+                                                static_cast<SizeT>(DISKANN_SPACE_FOR_CACHED_NODES_IN_GB * 1024 * 1024 * 1024) / node_bytes});
+    const SizeT scratch_bytes = DISKANN_NUM_SEARCH_SCRATCH * DISKANN_MAX_N_SECTOR_READS * DISKANN_SECTOR_LEN;
+    return row_count * num_pq_chunks + cached_nodes * node_bytes + scratch_bytes;
+}
+
+void DiskAnnIndexInChunk::BuildDiskAnnIndex(RowID base_rowid,
+                                            u32 row_count,
+                                            const SegmentEntry *segment_entry,
+                                            ColumnID column_id,
+                                            BufferManager *buffer_mgr) {
+    if (const SegmentID segment_id = segment_entry->segment_id(); segment_id != base_rowid.segment_id_) {
+        UnrecoverableError(fmt::format("DiskAnnIndexInChunk::BuildDiskAnnIndex: segment_id mismatch: expect {}, got {}.", base_rowid.segment_id_, segment_id));
+    }
+    if (base_rowid.segment_offset_ != start_segment_offset_) {
+        UnrecoverableError(fmt::format("DiskAnnIndexInChunk::BuildDiskAnnIndex: start offset mismatch: expect {}, got {}.",
+                                       start_segment_offset_,
+                                       base_rowid.segment_offset_));
+    }
+    Vector<SharedPtr<BlockEntry>> block_entries;
+    {
+        const BlocksGuard blocks_guard = segment_entry->GetBlocksGuard();
+        block_entries = blocks_guard.block_entries_;
+    }
+
+    // the vectors are streamed to the data file, the build reads them back part by part
+    VirtualStore::MakeDirectory(build_dir_);
+    const String data_path = Path(build_dir_) / "data.bin";
+    {
+        auto [data_handle, status] = VirtualStore::Open(data_path, FileAccessMode::kWrite);
+        if (!status.ok()) {
+            UnrecoverableError(status.message());
+        }
+        SegmentOffset offset = start_segment_offset_;
+        const SegmentOffset end_offset = start_segment_offset_ + row_count;
+        while (offset < end_offset) {
+            const BlockID block_id = offset / DEFAULT_BLOCK_CAPACITY;
+            const BlockOffset block_offset = offset % DEFAULT_BLOCK_CAPACITY;
+            const SegmentOffset block_end = std::min<SegmentOffset>(end_offset, (block_id + 1) * DEFAULT_BLOCK_CAPACITY);
+            ColumnVector column_vector = block_entries[block_id]->GetConstColumnVector(buffer_mgr, column_id);
+            const auto *vectors = reinterpret_cast<const f32 *>(column_vector.data()) + SizeT(block_offset) * dimension_;
+            data_handle->Append(vectors, SizeT(block_end - offset) * dimension_ * sizeof(f32));
+            offset = block_end;
+        }
+        data_handle->Sync();
+    }
+    BuildFromDataFile(row_count);
+}
+
+void DiskAnnIndexInChunk::BuildDiskAnnIndex(const f32 *vectors, u32 row_count) {
+    VirtualStore::MakeDirectory(build_dir_);
+    const String data_path = Path(build_dir_) / "data.bin";
+    {
+        auto [data_handle, status] = VirtualStore::Open(data_path, FileAccessMode::kWrite);
+        if (!status.ok()) {
+            UnrecoverableError(status.message());
+        }
+        data_handle->Append(vectors, SizeT(row_count) * dimension_ * sizeof(f32));
+        data_handle->Sync();
+    }
+    BuildFromDataFile(row_count);
+}
+
+void DiskAnnIndexInChunk::BuildFromDataFile(u32 row_count) {
+    if (pq_flash_index_) {
+        UnrecoverableError("DiskAnnIndexInChunk::BuildDiskAnnIndex: index is already built.");
+    }
+    if (row_count < LeastRowCount()) {
+        UnrecoverableError(fmt::format("DiskAnnIndexInChunk::BuildDiskAnnIndex: row_count must be at least {}, got {} instead.", LeastRowCount(), row_count));
+    }
+    if (index_diskann_->num_parts_ > 1) {
+        LOG_WARN(fmt::format("DiskAnnIndexInChunk::BuildDiskAnnIndex: num_parts {} is not supported, build the graph in one part.", index_diskann_->num_parts_));
+    }
+    const auto time_0 = std::chrono::high_resolution_clock::now();
+    const Path build_dir(build_dir_);
+    {
+        Vector<SizeT> labels(row_count);
+        std::iota(labels.begin(), labels.end(), 0);
+        auto index_data = DiskAnnIndexData<f32, SizeT, MetricType::kMetricL2>::Make(dimension_,
+                                                                                     row_count,
+                                                                                     index_diskann_->R_,
+                                                                                     index_diskann_->L_,
+                                                                                     num_pq_chunks_,
+                                                                                     1 /*num_parts*/,
+                                                                                     DISKANN_NUM_CENTERS);
+        index_data->BuildIndex(dimension_,
+                               row_count,
+                               labels,
+                               build_dir / "data.bin",
+                               build_dir / "mem_index.bin",
+                               build_dir / "index.bin",
+                               build_dir / "pqCompressed_data.bin",
+                               build_dir,
+                               build_dir / "pq_pivot.bin");
+    }
+    // the full precision vectors are in the disk graph now
+    for (const char *file_name : {"data.bin", "train_data.bin", "train_ids.bin"}) {
+        VirtualStore::DeleteFile(build_dir / file_name);
+    }
+    row_count_ = row_count;
+    LoadFromBuildDir();
+    const auto time_1 = std::chrono::high_resolution_clock::now();
+    LOG_INFO(fmt::format("DiskAnnIndexInChunk::BuildDiskAnnIndex: {} rows from segment offset {}, time cost: {} ms",
+                         row_count_,
+                         start_segment_offset_,
+                         std::chrono::duration_cast<std::chrono::milliseconds>(time_1 - time_0).count()));
+}
+
+void DiskAnnIndexInChunk::LoadFromBuildDir() {
+    const Path build_dir(build_dir_);
+    for (auto [section, file_name] : {Pair<FileSection *, const char *>{&pq_pivot_section_, "pq_pivot.bin"},
+                                      Pair<FileSection *, const char *>{&pq_data_section_, "pqCompressed_data.bin"},
+                                      Pair<FileSection *, const char *>{&index_section_, "index.bin"}}) {
+        section->path_ = build_dir / file_name;
+        section->offset_ = 0;
+        section->size_ = VirtualStore::GetFileSize(section->path_);
+    }
+    pq_flash_index_ = PqFlashIndex<f32, SizeT>::Make(DiskAnnMetricType::L2, dimension_, row_count_, num_pq_chunks_);
+    pq_flash_index_->Load(build_dir_, DISKANN_NUM_SEARCH_SCRATCH);
+    WarmUpCache();
+}
+
+void DiskAnnIndexInChunk::WarmUpCache() {
+    const SizeT node_bytes = dimension_ * sizeof(f32) + (index_diskann_->R_ + 1) * sizeof(SizeT);
+    const SizeT num_nodes_to_cache = std::min<SizeT>({DISKANN_NUM_NODES_TO_CACHE,
+                                                      row_count_ / 10,
+                                                      static_cast<SizeT>(DISKANN_SPACE_FOR_CACHED_NODES_IN_GB * 1024 * 1024 * 1024) / node_bytes});
+    if (num_nodes_to_cache == 0) {
+        return;
+    }
+    // the nodes near the medoid are visited by almost every search
+    Vector<SizeT> node_list;
+    pq_flash_index_->CacheBfsLevels(num_nodes_to_cache, node_list);
+    pq_flash_index_->LoadCacheList(node_list);
+}
+
+void DiskAnnIndexInChunk::SaveIndexInner(LocalFileHandle &file_handle) const {
+    if (!pq_flash_index_) {
+        UnrecoverableError("DiskAnnIndexInChunk::SaveIndexInner: index is not built.");
+    }
+    if (index_section_.path_ == file_handle.Path()) {
+        UnrecoverableError(fmt::format("DiskAnnIndexInChunk::SaveIndexInner: can't save the index onto its source file {}.", index_section_.path_));
+    }
+    DiskAnnChunkHeader header;
+    header.magic_ = DISKANN_CHUNK_MAGIC;
+    header.dimension_ = dimension_;
+    header.row_count_ = row_count_;
+    header.num_pq_chunks_ = num_pq_chunks_;
+    header.pq_pivot_offset_ = DISKANN_SECTOR_LEN;
+    header.pq_pivot_size_ = pq_pivot_section_.size_;
+    header.pq_data_offset_ = header.pq_pivot_offset_ + header.pq_pivot_size_;
+    header.pq_data_size_ = pq_data_section_.size_;
+    // the disk graph is read by sectors
+    header.index_offset_ = RoundUp(header.pq_data_offset_ + header.pq_data_size_, DISKANN_SECTOR_LEN);
+    header.index_size_ = index_section_.size_;
+
+    file_handle.Append(&header, sizeof(header));
+    AppendZeros(file_handle, DISKANN_SECTOR_LEN - sizeof(header));
+    CopyFileRange(pq_pivot_section_.path_, pq_pivot_section_.offset_, pq_pivot_section_.size_, file_handle);
+    CopyFileRange(pq_data_section_.path_, pq_data_section_.offset_, pq_data_section_.size_, file_handle);
+    AppendZeros(file_handle, header.index_offset_ - header.pq_data_offset_ - header.pq_data_size_);
+    CopyFileRange(index_section_.path_, index_section_.offset_, index_section_.size_, file_handle);
+}
+
+void DiskAnnIndexInChunk::ReadIndexInner(LocalFileHandle &file_handle, u64 base_offset, bool copy_graph) {
+    if (pq_flash_index_) {
+        UnrecoverableError("DiskAnnIndexInChunk::ReadIndexInner: index is already loaded.");
+    }
+    DiskAnnChunkHeader header;
+    file_handle.Seek(base_offset);
+    file_handle.Read(&header, sizeof(header));
+    if (header.magic_ != DISKANN_CHUNK_MAGIC) {
+        UnrecoverableError(fmt::format("DiskAnnIndexInChunk::ReadIndexInner: invalid DiskAnn chunk file {}.", file_handle.Path()));
+    }
+    if (header.dimension_ != dimension_ || header.num_pq_chunks_ != num_pq_chunks_) {
+        UnrecoverableError(fmt::format("DiskAnnIndexInChunk::ReadIndexInner: dimension or pq chunks mismatch, expect ({}, {}), got ({}, {}).",
+                                       dimension_,
+                                       num_pq_chunks_,
+                                       header.dimension_,
+                                       header.num_pq_chunks_));
+    }
+    row_count_ = header.row_count_;
+    const String file_path = file_handle.Path();
+    if (copy_graph) {
+        VirtualStore::MakeDirectory(build_dir_);
+        const Path build_dir(build_dir_);
+        for (auto [offset, size, file_name] : {Tuple<u64, u64, const char *>{header.pq_pivot_offset_, header.pq_pivot_size_, "pq_pivot.bin"},
+                                               Tuple<u64, u64, const char *>{header.pq_data_offset_, header.pq_data_size_, "pqCompressed_data.bin"},
+                                               Tuple<u64, u64, const char *>{header.index_offset_, header.index_size_, "index.bin"}}) {
+            auto [dst_handle, status] = VirtualStore::Open(build_dir / file_name, FileAccessMode::kWrite);
+            if (!status.ok()) {
+                UnrecoverableError(status.message());
+            }
+            CopyFileRange(file_path, base_offset + offset, size, *dst_handle);
+        }
+        LoadFromBuildDir();
+        return;
+    }
+    pq_pivot_section_ = {file_path, base_offset + header.pq_pivot_offset_, header.pq_pivot_size_};
+    pq_data_section_ = {file_path, base_offset + header.pq_data_offset_, header.pq_data_size_};
+    index_section_ = {file_path, base_offset + header.index_offset_, header.index_size_};
+    pq_flash_index_ = PqFlashIndex<f32, SizeT>::Make(DiskAnnMetricType::L2, dimension_, row_count_, num_pq_chunks_);
+    pq_flash_index_->Load(file_path, pq_pivot_section_.offset_, pq_data_section_.offset_, index_section_.offset_, DISKANN_NUM_SEARCH_SCRATCH);
+    WarmUpCache();
+}
+
+DiskAnnQueryResultType DiskAnnIndexInChunk::Search(const f32 *query,
+                                                   u32 topk,
+                                                   const DiskAnnSearchOption &option,
+                                                   const std::function<bool(SegmentOffset)> &filter) const {
+    if (!pq_flash_index_) {
+        UnrecoverableError("DiskAnnIndexInChunk::Search: index is not loaded.");
+    }
+    topk = std::min(topk, row_count_);
+    if (topk == 0) {
+        return {0, nullptr, nullptr};
+    }
+    const u32 l_search = std::max(option.l_search_, topk);
+    auto ids = MakeUniqueForOverwrite<u64[]>(topk);
+    auto distances = MakeUniqueForOverwrite<f32[]>(topk);
+    std::function<bool(SizeT)> id_filter;
+    if (filter) {
+        id_filter = [&](SizeT id) { return filter(start_segment_offset_ + id); };
+    }
+    const u64 result_n = pq_flash_index_->CachedBeamSearch(query,
+                                                           topk,
+                                                           l_search,
+                                                           ids.get(),
+                                                           distances.get(),
+                                                           option.beam_width_,
+                                                           false /*use_filter*/,
+                                                           0,
+                                                           std::numeric_limits<u32>::max(),
+                                                           false /*use_reorder_data*/,
+                                                           nullptr,
+                                                           option.rerank_,
+                                                           id_filter);
+    auto offsets = MakeUniqueForOverwrite<SegmentOffset[]>(result_n);
+    for (u64 i = 0; i < result_n; ++i) {
+        offsets[i] = start_segment_offset_ + ids[i];
+    }
+    return {static_cast<u32>(result_n), std::move(distances), std::move(offsets)};
+}
+
+SizeT DiskAnnIndexInChunk::MemoryUsage() const { return pq_flash_index_ ? pq_flash_index_->MemoryUsage() : 0; }
+
+} // namespace infinity
@@ -0,0 +1,98 @@
+// Copyright(C) 2024 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+module;
+
+export module diskann_index_in_chunk;
+
+import stl;
+import internal_types;
+import default_values;
+import pq_flash_index;
+
+namespace infinity {
+
+class LocalFileHandle;
+class IndexDiskAnn;
+struct SegmentEntry;
+class BufferManager;
+
+export struct DiskAnnSearchOption {
+    u32 beam_width_ = DISKANN_BEAM_WIDTH;
+    u32 l_search_ = DISKANN_L_SEARCH; // raised to topk if smaller
+    bool rerank_ = true;              // rerank the candidates by full precision vectors read from the disk
+};
+
+// return id: offset in the segment
+export using DiskAnnQueryResultType = Tuple<u32, UniquePtr<f32[]>, UniquePtr<SegmentOffset[]>>;
+
+// DiskANN index of rows [start_segment_offset_, start_segment_offset_ + row_count_) of a segment.
+// Only the PQ codes and a BFS-warmed node cache stay in memory, the graph with the full precision vectors is read from the disk while searching.
+// The chunk file is self-contained: a header sector, the PQ pivots, the PQ codes and the sector aligned disk graph.
+export class DiskAnnIndexInChunk {
+public:
+    DiskAnnIndexInChunk(const IndexDiskAnn *index_diskann, u32 dimension, u32 start_segment_offset, String build_dir);
+
+    ~DiskAnnIndexInChunk();
+
+    // PQ training needs more rows than the PQ centers
+    static constexpr u32 LeastRowCount() { return DISKANN_NUM_CENTERS + 1; }
+
+    static SizeT EstimateMemoryCost(const IndexDiskAnn *index_diskann, u32 dimension, u32 row_count);
+
+    void BuildDiskAnnIndex(RowID base_rowid, u32 row_count, const SegmentEntry *segment_entry, ColumnID column_id, BufferManager *buffer_mgr);
+
+    // vectors of consecutive rows starting from start_segment_offset_
+    void BuildDiskAnnIndex(const f32 *vectors, u32 row_count);
+
+    void SaveIndexInner(LocalFileHandle &file_handle) const;
+
+    // The disk graph is searched in place at base_offset of the file. With copy_graph, it is copied into the build dir first,
+    // for the file could be an object shared with others which may be evicted.
+    void ReadIndexInner(LocalFileHandle &file_handle, u64 base_offset, bool copy_graph);
+
+    DiskAnnQueryResultType Search(const f32 *query, u32 topk, const DiskAnnSearchOption &option, const std::function<bool(SegmentOffset)> &filter) const;
+
+    u32 start_segment_offset() const { return start_segment_offset_; }
+
+    u32 row_count() const { return row_count_; }
+
+    SizeT MemoryUsage() const;
+
+private:
+    void BuildFromDataFile(u32 row_count);
+
+    void LoadFromBuildDir();
+
+    void WarmUpCache();
+
+    struct FileSection {
+        String path_{};
+        u64 offset_{};
+        u64 size_{};
+    };
+
+    const IndexDiskAnn *index_diskann_{};
+    const u32 dimension_{};
+    const u32 start_segment_offset_{};
+    const String build_dir_{};
+    u32 num_pq_chunks_{};
+    u32 row_count_{};
+    FileSection pq_pivot_section_{};
+    FileSection pq_data_section_{};
+    FileSection index_section_{};
+    UniquePtr<PqFlashIndex<f32, SizeT>> pq_flash_index_{};
+};
+
+} // namespace infinity
@@ -16,7 +16,10 @@ module;
 
 #include <boost/dynamic_bitset.hpp>
 #include <cassert>
+#include <cerrno>
 #include <cstdlib>
+#include <cstring>
+#include <unistd.h>
 
 import stl;
 import third_party;
@@ -65,17 +68,20 @@ export struct AlignedRead {
 };
 
 // reader of disk index, async = false for now
+// The disk index could be a section of a larger file, all read offsets are relative to base_offset_.
+// Reads are positional, so that concurrent searches could share one reader.
 export class AlignedFileReader {
     using This = AlignedFileReader;
 
 private:
     u64 file_sz_;
+    u64 base_offset_{};
     UniquePtr<LocalFileHandle> file_desc_;
 
 public:
     AlignedFileReader() : file_sz_(0), file_desc_(nullptr) {}
 
-    AlignedFileReader(This &&other) : file_sz_(other.file_sz_), file_desc_(std::move(other.file_desc_)) {}
+    AlignedFileReader(This &&other) : file_sz_(other.file_sz_), base_offset_(other.base_offset_), file_desc_(std::move(other.file_desc_)) {}
 
     ~AlignedFileReader() = default;
 
@@ -88,17 +94,36 @@ public:
         }
 
         for (SizeT reqs = 0; reqs < read_reqs.size(); reqs++) {
-            file_desc_->Seek(read_reqs[reqs].offset);
-            file_desc_->Read(read_reqs[reqs].buf, read_reqs[reqs].len);
+            char *buf = static_cast<char *>(read_reqs[reqs].buf);
+            u64 offset = base_offset_ + read_reqs[reqs].offset;
+            u64 remain = read_reqs[reqs].len;
+            while (remain > 0) {
+                ssize_t read_n = pread(file_desc_->FileDescriptor(), buf, remain, offset);
+                if (read_n < 0) {
+                    if (errno == EINTR) {
+                        continue;
+                    }
+                    UnrecoverableError(fmt::format("DiskAnn(): read {} failed: {}", file_desc_->Path(), strerror(errno)));
+                }
+                if (read_n == 0) {
+                    // the last sector of the file may be incomplete
+                    std::memset(buf, 0, remain);
+                    break;
+                }
+                buf += read_n;
+                offset += read_n;
+                remain -= read_n;
+            }
         }
     }
 
-    void Open(const std::string &file_path) {
+    void Open(const std::string &file_path, u64 base_offset = 0) {
         auto [data_file_handle, status] = VirtualStore::Open(file_path, FileAccessMode::kRead);
         if (!status.ok()) {
             UnrecoverableError(status.message());
         }
         file_desc_ = std::move(data_file_handle);
+        base_offset_ = base_offset;
     }
 
     void Close() { file_desc_.reset(); }
@@ -81,28 +81,29 @@ public:
         std::string pq_table_bin = index_prefix + "/pq_pivot.bin";
         std::string pq_compressed_vectors = index_prefix + "/pqCompressed_data.bin";
         std::string disk_index_file = index_prefix + "/index.bin";
-        this->disk_index_file_ = disk_index_file;
-
-        // 1. load pq compressed vector
-        LoadPqCompressedVec(pq_compressed_vectors);
-
-        // 2. load PQ table
-        pq_table_->LoadPqCentroidBin(pq_table_bin, n_chunks_);
-
-        // 3. load disk index meta data
-        LoadDiskIndexMetaData(disk_index_file);
-
-        // 4. open reader for the disk index file
-        reader_->Open(disk_index_file);
-        this->max_nthreads_ = num_threads;
-        this->SetupThreadData(num_threads);
-
-        // 5. load medoids node ids as enter point has finished in LoadDiskIndexMetaData()
-
-        // 6. load medoids data as centroids
-        this->UseMedoidsDataAsCentroids();
+        auto [pq_table_handle, pq_table_status] = VirtualStore::Open(pq_table_bin, FileAccessMode::kRead);
+        if (!pq_table_status.ok()) {
+            UnrecoverableError(pq_table_status.message());
+        }
+        auto [pq_data_handle, pq_data_status] = VirtualStore::Open(pq_compressed_vectors, FileAccessMode::kRead);
+        if (!pq_data_status.ok()) {
+            UnrecoverableError(pq_data_status.message());
+        }
+        auto [index_file_handle, index_file_status] = VirtualStore::Open(disk_index_file, FileAccessMode::kRead);
+        if (!index_file_status.ok()) {
+            UnrecoverableError(index_file_status.message());
+        }
+        LoadInner(*pq_table_handle, 0, *pq_data_handle, 0, *index_file_handle, disk_index_file, 0, num_threads);
+        return 0;
+    }
 
-        this->load_flag_ = true;
+    // Load the index of which the pq table, the pq compressed vectors and the disk index are sections of one file.
+    int Load(const std::string &file_path, u64 pq_table_offset, u64 pq_data_offset, u64 disk_index_offset, u32 num_threads = 1) {
+        auto [file_handle, status] = VirtualStore::Open(file_path, FileAccessMode::kRead);
+        if (!status.ok()) {
+            UnrecoverableError(status.message());
+        }
+        LoadInner(*file_handle, pq_table_offset, *file_handle, pq_data_offset, *file_handle, file_path, disk_index_offset, num_threads);
         return 0;
     }
 
@@ -257,17 +258,22 @@ public:
     }
 
     // Fourth step
-    void CachedBeamSearch(const VectorDataType *query1,
-                          const u64 k_search,
-                          const u64 l_search,
-                          u64 *indices,
-                          f32 *distances,
-                          const u64 beam_width,
-                          const bool use_filter = false,
-                          const LabelType &filter_labels = 0,
-                          const u32 io_limit = std::numeric_limits<u32>::max(),
-                          const bool use_reorder_data = false,
-                          QueryStats *stats = nullptr) {
+    // Return the number of results written, which could be less than k_search.
+    // rerank: sort the expanded nodes by their full precision distances, otherwise return the candidates by PQ distances.
+    // id_filter: only the ids accepted by it are returned, the rejected ones are still used for the graph traversal.
+    u64 CachedBeamSearch(const VectorDataType *query1,
+                         const u64 k_search,
+                         const u64 l_search,
+                         u64 *indices,
+                         f32 *distances,
+                         const u64 beam_width_hint,
+                         const bool use_filter = false,
+                         const LabelType &filter_labels = 0,
+                         const u32 io_limit = std::numeric_limits<u32>::max(),
+                         const bool use_reorder_data = false,
+                         QueryStats *stats = nullptr,
+                         const bool rerank = true,
+                         const std::function<bool(SizeT)> &id_filter = {}) {
         if (!this->load_flag_) {
             Status status = Status::NotSupport("DiskAnn(): index not loaded");
             RecoverableError(status);
@@ -317,6 +323,8 @@ public:
         char *sector_scratch = query_scratch->sector_scratch_;
         u64 &sector_scratch_idx = query_scratch->sector_idx_;
         u64 num_sector_per_node = nnodes_per_sector_ > 0 ? 1 : DivRoundUp(max_node_len_, DISKANN_SECTOR_LEN);
+        // the sectors of one iteration must fit in the sector scratch
+        const u64 beam_width = std::clamp<u64>(beam_width_hint, 1, std::max<u64>(1, DISKANN_MAX_N_SECTOR_READS / num_sector_per_node));
 
         // query <-> PQ chunk centers distances
         pq_table_->PreprocessQuery(query_rotated);
@@ -508,38 +516,86 @@ public:
 
         LOG_DEBUG(fmt::format("Beam search hops {}: {} nodes expanded, {} cmps,  {} ios", hops, full_retset.size(), cmps, num_ios));
         // copy the top k results to the output buffer
-        std::sort(full_retset.begin(), full_retset.end());
-        for (u64 i = 0; i < k_search; i++) {
-            indices[i] = full_retset[i].id;
-            auto key = indices[i];
+        Vector<Neighbor> &candidates = query_scratch->full_retset_;
+        if (!rerank) {
+            candidates.clear();
+            for (SizeT i = 0; i < retset.Size(); i++) {
+                candidates.push_back(retset[i]);
+            }
+        }
+        std::sort(candidates.begin(), candidates.end());
+        u64 result_n = 0;
+        for (SizeT i = 0; i < candidates.size() && result_n < k_search; i++) {
+            SizeT key = candidates[i].id;
             // filter
             if (dummy_pts_.find(key) != dummy_pts_.end()) {
-                indices[i] = this->dummy_to_real_map_[key];
+                key = this->dummy_to_real_map_[key];
             }
-
+            if (id_filter && !id_filter(key)) {
+                continue;
+            }
+            indices[result_n] = key;
             if (distances != nullptr) {
-                distances[i] = full_retset[i].distance;
+                distances[result_n] = candidates[i].distance;
                 if (metric_ == DiskAnnMetricType::IP) {
                     // flip the sign to convert min to max
-                    distances[i] = (-distances[i]);
+                    distances[result_n] = (-distances[result_n]);
                 }
             }
+            result_n++;
         }
+        return result_n;
+    }
 
-        // delete[] data;
+    // bytes of the pq compressed vectors and the node cache kept in memory
+    SizeT MemoryUsage() const {
+        SizeT usage = num_points_ * n_chunks_;
+        usage += nhood_cache_.size() * ((max_degree_ + 1) * sizeof(SizeT) + aligned_dim_ * sizeof(VectorDataType));
+        return usage;
     }
 
+    u64 num_points() const { return num_points_; }
+
 private:
+    void LoadInner(LocalFileHandle &pq_table_handle,
+                   u64 pq_table_offset,
+                   LocalFileHandle &pq_data_handle,
+                   u64 pq_data_offset,
+                   LocalFileHandle &index_file_handle,
+                   const std::string &disk_index_file,
+                   u64 disk_index_offset,
+                   u32 num_threads) {
+        this->disk_index_file_ = disk_index_file;
+
+        // 1. load pq compressed vector
+        LoadPqCompressedVec(pq_data_handle, pq_data_offset);
+
+        // 2. load PQ table
+        pq_table_->LoadPqCentroidBin(pq_table_handle, pq_table_offset, n_chunks_);
+
+        // 3. load disk index meta data
+        LoadDiskIndexMetaData(index_file_handle, disk_index_offset);
+
+        // 4. open reader for the disk index file
+        reader_->Open(disk_index_file, disk_index_offset);
+        this->max_nthreads_ = num_threads;
+        this->SetupThreadData(num_threads);
+
+        // 5. load medoids node ids as enter point has finished in LoadDiskIndexMetaData()
+
+        // 6. load medoids data as centroids
+        this->UseMedoidsDataAsCentroids();
+
+        this->load_flag_ = true;
+    }
+
     // read pq compressed vectors from disk to this->data_
-    void LoadPqCompressedVec(std::string pq_compressed_vectors_path) {
+    void LoadPqCompressedVec(LocalFileHandle &pq_data_handle, u64 offset) {
         this->data_ = MakeUnique<u8[]>(this->num_points_ * this->n_chunks_);
-        auto read_buf = MakeUnique<u32[]>(this->num_points_ * this->n_chunks_ * sizeof(u32));
-        auto [pq_data_handle, status] = VirtualStore::Open(pq_compressed_vectors_path, FileAccessMode::kRead);
-        if (!status.ok()) {
-            UnrecoverableError(status.message());
-        }
+        auto read_buf = MakeUnique<u32[]>(this->num_points_ * this->n_chunks_);
 
-        pq_data_handle->Read(read_buf.get(), this->num_points_ * this->n_chunks_ * sizeof(u32));
+        pq_data_handle.Seek(offset);
+        pq_data_handle.Read(read_buf.get(), this->num_points_ * this->n_chunks_ * sizeof(u32));
         for (u64 i = 0; i < this->num_points_ * this->n_chunks_; i++) {
             this->data_[i] = static_cast<u8>(read_buf[i]);
         }
@@ -640,41 +696,37 @@ private:
     // locate the offset of the neighbor data from the start sector buffer(i.e. skip the vector data)
     inline u32 *OffsetToNodeNhood(char *node_buf) { return (u32 *)(node_buf + disk_bytes_per_point_); }
 
-    void LoadDiskIndexMetaData(const std::string &disk_index_file) {
-        auto [index_file_handle, status] = VirtualStore::Open(disk_index_file, FileAccessMode::kRead);
-        if (!status.ok()) {
-            UnrecoverableError(status.message());
-        }
-
+    void LoadDiskIndexMetaData(LocalFileHandle &index_file_handle, u64 offset) {
+        index_file_handle.Seek(offset);
         u64 disk_nnodes, disk_ndims;
-        index_file_handle->Read(&disk_nnodes, sizeof(u64));
-        index_file_handle->Read(&disk_ndims, sizeof(u64));
+        index_file_handle.Read(&disk_nnodes, sizeof(u64));
+        index_file_handle.Read(&disk_ndims, sizeof(u64));
         disk_bytes_per_point_ = disk_ndims * sizeof(VectorDataType);
         if (disk_nnodes != num_points_ || disk_ndims != data_dim_) {
             UnrecoverableError("Index file does not match the PQ flash index");
         }
 
         u64 medoid_id_on_file; // medoid node id
-        index_file_handle->Read(&medoid_id_on_file, sizeof(u64));
+        index_file_handle.Read(&medoid_id_on_file, sizeof(u64));
         this->num_medoids_ = 1;
         this->medoids_ = MakeUnique<SizeT[]>(1);
         this->medoids_[0] = medoid_id_on_file;
         LOG_DEBUG(fmt::format("LoadDiskIndexMetaData(): Loaded medoid node id: {}", medoid_id_on_file));
 
-        index_file_handle->Read(&max_node_len_, sizeof(u64));
-        index_file_handle->Read(&nnodes_per_sector_, sizeof(u64));
-        index_file_handle->Read(&sector_num_, sizeof(u64));
+        index_file_handle.Read(&max_node_len_, sizeof(u64));
+        index_file_handle.Read(&nnodes_per_sector_, sizeof(u64));
+        index_file_handle.Read(&sector_num_, sizeof(u64));
         max_degree_ = (max_node_len_ - disk_bytes_per_point_) / sizeof(u64) - 1; // -1 for the neighbor count
 
-        index_file_handle->Read(&num_frozen_points_, sizeof(u64));
+        index_file_handle.Read(&num_frozen_points_, sizeof(u64));
         u64 file_frozen_id;
-        index_file_handle->Read(&file_frozen_id, sizeof(u64));
+        index_file_handle.Read(&file_frozen_id, sizeof(u64));
         if (num_frozen_points_ == 1) {
             frozen_location_ = file_frozen_id;
         }
-        index_file_handle->Read(&reorder_data_exists_, sizeof(u64));
+        index_file_handle.Read(&reorder_data_exists_, sizeof(u64));
 
-        index_file_handle->Read(&disk_index_size_, sizeof(u64));
+        index_file_handle.Read(&disk_index_size_, sizeof(u64));
     }
 
     void SetupThreadData(u64 nthreads, u64 visited_reserve = 4096, bool async = false) {
@@ -93,7 +93,8 @@ HnswIndexInMem::HnswIndexInMem(RowID begin_row_id,
     SizeT chunk_size = index_hnsw->block_size_;
     SizeT max_chunk_num = (DEFAULT_SEGMENT_CAPACITY - 1) / chunk_size + 1;
 
-    SizeT dim = embedding_info->Dimension();
+    // the bits of a bit embedding are stored packed, the index dimension is the byte count
+    SizeT dim = embedding_info->Type() == EmbeddingDataType::kElemBit ? embedding_info->Dimension() / 8 : embedding_info->Dimension();
     SizeT M = index_hnsw->M_;
     SizeT ef_construction = index_hnsw->ef_construction_;
     std::visit(
@@ -113,24 +114,30 @@ HnswIndexInMem::HnswIndexInMem(RowID begin_row_id,
 
 template <typename DataType, bool OwnMem>
 AbstractHnsw InitAbstractIndexT(const IndexHnsw *index_hnsw) {
+    // f16 and bf16 vectors are stored as they are, without LSG or LVQ
+    constexpr bool half_float = std::is_same_v<DataType, Float16T> || std::is_same_v<DataType, BFloat16T>;
     switch (index_hnsw->encode_type_) {
         case HnswEncodeType::kPlain: {
             if (index_hnsw->build_type_ == HnswBuildType::kLSG) {
-                switch (index_hnsw->metric_type_) {
-                    case MetricType::kMetricL2: {
-                        using HnswIndex = KnnHnsw<PlainL2VecStoreType<DataType, true>, SegmentOffset, OwnMem>;
-                        return static_cast<HnswIndex *>(nullptr);
-                    }
-                    case MetricType::kMetricInnerProduct: {
-                        using HnswIndex = KnnHnsw<PlainIPVecStoreType<DataType, true>, SegmentOffset, OwnMem>;
-                        return static_cast<HnswIndex *>(nullptr);
-                    }
-                    case MetricType::kMetricCosine: {
-                        using HnswIndex = KnnHnsw<PlainCosVecStoreType<DataType, true>, SegmentOffset, OwnMem>;
-                        return static_cast<HnswIndex *>(nullptr);
-                    }
-                    default: {
-                        return nullptr;
+                if constexpr (half_float) {
+                    return nullptr;
+                } else {
+                    switch (index_hnsw->metric_type_) {
+                        case MetricType::kMetricL2: {
+                            using HnswIndex = KnnHnsw<PlainL2VecStoreType<DataType, true>, SegmentOffset, OwnMem>;
+                            return static_cast<HnswIndex *>(nullptr);
+                        }
+                        case MetricType::kMetricInnerProduct: {
+                            using HnswIndex = KnnHnsw<PlainIPVecStoreType<DataType, true>, SegmentOffset, OwnMem>;
+                            return static_cast<HnswIndex *>(nullptr);
+                        }
+                        case MetricType::kMetricCosine: {
+                            using HnswIndex = KnnHnsw<PlainCosVecStoreType<DataType, true>, SegmentOffset, OwnMem>;
+                            return static_cast<HnswIndex *>(nullptr);
+                        }
+                        default: {
+                            return nullptr;
+                        }
                     }
                 }
             } else if (index_hnsw->build_type_ != HnswBuildType::kPlain) {
@@ -155,7 +162,7 @@ AbstractHnsw InitAbstractIndexT(const IndexHnsw *index_hnsw) {
             }
         }
         case HnswEncodeType::kLVQ: {
-            if constexpr (std::is_same_v<DataType, u8> || std::is_same_v<DataType, i8>) {
+            if constexpr (std::is_same_v<DataType, u8> || std::is_same_v<DataType, i8> || half_float) {
                 return nullptr;
             } else if (index_hnsw->build_type_ == HnswBuildType::kPlain) {
                 switch (index_hnsw->metric_type_) {
@@ -177,6 +184,54 @@ AbstractHnsw InitAbstractIndexT(const IndexHnsw *index_hnsw) {
                 }
             }
         }
+        case HnswEncodeType::kPQ: {
+            if constexpr (!std::is_same_v<DataType, float>) {
+                return nullptr;
+            } else if (index_hnsw->build_type_ == HnswBuildType::kPlain) {
+                switch (index_hnsw->metric_type_) {
+                    case MetricType::kMetricL2: {
+                        using HnswIndex = KnnHnsw<PQVecStoreType<DataType, QuantMetric::kL2>, SegmentOffset, OwnMem>;
+                        return static_cast<HnswIndex *>(nullptr);
+                    }
+                    case MetricType::kMetricInnerProduct: {
+                        using HnswIndex = KnnHnsw<PQVecStoreType<DataType, QuantMetric::kIP>, SegmentOffset, OwnMem>;
+                        return static_cast<HnswIndex *>(nullptr);
+                    }
+                    case MetricType::kMetricCosine: {
+                        using HnswIndex = KnnHnsw<PQVecStoreType<DataType, QuantMetric::kCos>, SegmentOffset, OwnMem>;
+                        return static_cast<HnswIndex *>(nullptr);
+                    }
+                    default: {
+                        return nullptr;
+                    }
+                }
+            }
+            return nullptr;
+        }
+        case HnswEncodeType::kRaBitQ: {
+            if constexpr (!std::is_same_v<DataType, float>) {
+                return nullptr;
+            } else if (index_hnsw->build_type_ == HnswBuildType::kPlain) {
+                switch (index_hnsw->metric_type_) {
+                    case MetricType::kMetricL2: {
+                        using HnswIndex = KnnHnsw<RaBitQVecStoreType<DataType, QuantMetric::kL2>, SegmentOffset, OwnMem>;
+                        return static_cast<HnswIndex *>(nullptr);
+                    }
+                    case MetricType::kMetricInnerProduct: {
+                        using HnswIndex = KnnHnsw<RaBitQVecStoreType<DataType, QuantMetric::kIP>, SegmentOffset, OwnMem>;
+                        return static_cast<HnswIndex *>(nullptr);
+                    }
+                    case MetricType::kMetricCosine: {
+                        using HnswIndex = KnnHnsw<RaBitQVecStoreType<DataType, QuantMetric::kCos>, SegmentOffset, OwnMem>;
+                        return static_cast<HnswIndex *>(nullptr);
+                    }
+                    default: {
+                        return nullptr;
+                    }
+                }
+            }
+            return nullptr;
+        }
         default: {
             return nullptr;
         }
@@ -198,6 +253,20 @@ AbstractHnsw InitAbstractIndexT(const IndexBase *index_base, const ColumnDef *co
         case EmbeddingDataType::kElemInt8: {
             return InitAbstractIndexT<i8, OwnMem>(index_hnsw);
         }
+        case EmbeddingDataType::kElemFloat16: {
+            return InitAbstractIndexT<Float16T, OwnMem>(index_hnsw);
+        }
+        case EmbeddingDataType::kElemBFloat16: {
+            return InitAbstractIndexT<BFloat16T, OwnMem>(index_hnsw);
+        }
+        case EmbeddingDataType::kElemBit: {
+            if (index_hnsw->metric_type_ != MetricType::kMetricHamming || index_hnsw->encode_type_ != HnswEncodeType::kPlain ||
+                index_hnsw->build_type_ != HnswBuildType::kPlain) {
+                return nullptr;
+            }
+            using HnswIndex = KnnHnsw<PlainHammingVecStoreType<u8>, SegmentOffset, OwnMem>;
+            return static_cast<HnswIndex *>(nullptr);
+        }
         default: {
             return nullptr;
         }
@@ -359,6 +428,43 @@ void HnswIndexInMem::SetLSGParam(float alpha, UniquePtr<float[]> avg) {
         hnsw_);
 }
 
+Optional<SizeT> HnswIndexInMem::MergeGraph(const AbstractHnsw &src, const Vector<Optional<SegmentOffset>> &label_map) {
+    Optional<SizeT> merged_n;
+    std::visit(
+        [&](auto &&index) {
+            using T = std::decay_t<decltype(index)>;
+            if constexpr (!std::is_same_v<T, std::nullptr_t>) {
+                using IndexT = std::decay_t<decltype(*index)>;
+                if constexpr (IndexT::kOwnMem) {
+                    std::visit(
+                        [&](auto &&src_index) {
+                            using SrcT = std::decay_t<decltype(src_index)>;
+                            if constexpr (!std::is_same_v<SrcT, std::nullptr_t>) {
+                                using SrcIndexT = std::decay_t<decltype(*src_index)>;
+                                if constexpr (std::is_same_v<typename IndexT::VecStore, typename SrcIndexT::VecStore>) {
+                                    if (src_index == nullptr) {
+                                        return;
+                                    }
+                                    SizeT mem1 = index->mem_usage();
+                                    merged_n = index->MergeGraph(*src_index, [&](SegmentOffset label) -> Optional<SegmentOffset> {
+                                        if (label >= label_map.size()) {
+                                            return None;
+                                        }
+                                        return label_map[label];
+                                    });
+                                    SizeT mem2 = index->mem_usage();
+                                    this->IncreaseMemoryUsageBase(mem2 - mem1);
+                                }
+                            }
+                        },
+                        src);
+                }
+            }
+        },
+        hnsw_);
+    return merged_n;
+}
+
 SharedPtr<ChunkIndexEntry> HnswIndexInMem::Dump(SegmentIndexEntry *segment_index_entry, BufferManager *buffer_mgr, SizeT *dump_size_ptr) {
     SizeT row_count = 0;
     SizeT index_size = 0;
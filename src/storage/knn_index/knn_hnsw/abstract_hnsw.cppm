@@ -71,6 +71,19 @@ export using AbstractHnsw = std::variant<KnnHnsw<PlainCosVecStoreType<float>, Se
                                          KnnHnsw<PlainCosVecStoreType<i8, true>, SegmentOffset> *,
                                          KnnHnsw<PlainIPVecStoreType<i8, true>, SegmentOffset> *,
                                          KnnHnsw<PlainL2VecStoreType<i8, true>, SegmentOffset> *,
+                                         KnnHnsw<PlainCosVecStoreType<Float16T>, SegmentOffset> *,
+                                         KnnHnsw<PlainIPVecStoreType<Float16T>, SegmentOffset> *,
+                                         KnnHnsw<PlainL2VecStoreType<Float16T>, SegmentOffset> *,
+                                         KnnHnsw<PlainCosVecStoreType<BFloat16T>, SegmentOffset> *,
+                                         KnnHnsw<PlainIPVecStoreType<BFloat16T>, SegmentOffset> *,
+                                         KnnHnsw<PlainL2VecStoreType<BFloat16T>, SegmentOffset> *,
+                                         KnnHnsw<PQVecStoreType<float, QuantMetric::kCos>, SegmentOffset> *,
+                                         KnnHnsw<PQVecStoreType<float, QuantMetric::kIP>, SegmentOffset> *,
+                                         KnnHnsw<PQVecStoreType<float, QuantMetric::kL2>, SegmentOffset> *,
+                                         KnnHnsw<RaBitQVecStoreType<float, QuantMetric::kCos>, SegmentOffset> *,
+                                         KnnHnsw<RaBitQVecStoreType<float, QuantMetric::kIP>, SegmentOffset> *,
+                                         KnnHnsw<RaBitQVecStoreType<float, QuantMetric::kL2>, SegmentOffset> *,
+                                         KnnHnsw<PlainHammingVecStoreType<u8>, SegmentOffset> *,
 
                                          KnnHnsw<PlainCosVecStoreType<float>, SegmentOffset, false> *,
                                          KnnHnsw<PlainIPVecStoreType<float>, SegmentOffset, false> *,
@@ -93,6 +106,19 @@ export using AbstractHnsw = std::variant<KnnHnsw<PlainCosVecStoreType<float>, Se
                                          KnnHnsw<PlainCosVecStoreType<i8, true>, SegmentOffset, false> *,
                                          KnnHnsw<PlainIPVecStoreType<i8, true>, SegmentOffset, false> *,
                                          KnnHnsw<PlainL2VecStoreType<i8, true>, SegmentOffset, false> *,
+                                         KnnHnsw<PlainCosVecStoreType<Float16T>, SegmentOffset, false> *,
+                                         KnnHnsw<PlainIPVecStoreType<Float16T>, SegmentOffset, false> *,
+                                         KnnHnsw<PlainL2VecStoreType<Float16T>, SegmentOffset, false> *,
+                                         KnnHnsw<PlainCosVecStoreType<BFloat16T>, SegmentOffset, false> *,
+                                         KnnHnsw<PlainIPVecStoreType<BFloat16T>, SegmentOffset, false> *,
+                                         KnnHnsw<PlainL2VecStoreType<BFloat16T>, SegmentOffset, false> *,
+                                         KnnHnsw<PQVecStoreType<float, QuantMetric::kCos>, SegmentOffset, false> *,
+                                         KnnHnsw<PQVecStoreType<float, QuantMetric::kIP>, SegmentOffset, false> *,
+                                         KnnHnsw<PQVecStoreType<float, QuantMetric::kL2>, SegmentOffset, false> *,
+                                         KnnHnsw<RaBitQVecStoreType<float, QuantMetric::kCos>, SegmentOffset, false> *,
+                                         KnnHnsw<RaBitQVecStoreType<float, QuantMetric::kIP>, SegmentOffset, false> *,
+                                         KnnHnsw<RaBitQVecStoreType<float, QuantMetric::kL2>, SegmentOffset, false> *,
+                                         KnnHnsw<PlainHammingVecStoreType<u8>, SegmentOffset, false> *,
                                          std::nullptr_t>;
 export struct HnswIndexInMem : public BaseMemIndex {
 public:
@@ -110,7 +136,7 @@ public:
 private:
     template <typename Iter, typename Index>
     static void InsertVecs(Index &index, Iter &&iter, const HnswInsertConfig &config, SizeT &mem_usage) {
-        auto &thread_pool = InfinityContext::instance().GetHnswBuildThreadPool();
+        auto &thread_pool = InfinityContext::instance().GetVectorIndexBuildThreadPool();
         if (thread_pool.size() == 0) {
             UnrecoverableError("Hnsw build thread pool is not initialized.");
         }
@@ -194,6 +220,10 @@ public:
         }
     }
 
+    // Copy the graph of `src` of the same type instead of building it, `label_map` gives the new label of each row, None if dropped.
+    // Return the number of the copied vectors, or None if the graph can not be copied.
+    Optional<SizeT> MergeGraph(const AbstractHnsw &src, const Vector<Optional<SegmentOffset>> &label_map);
+
     void SetLSGParam(float alpha, UniquePtr<float[]> avg);
 
     SharedPtr<ChunkIndexEntry> Dump(SegmentIndexEntry *segment_index_entry, BufferManager *buffer_mgr, SizeT *dump_size = nullptr);
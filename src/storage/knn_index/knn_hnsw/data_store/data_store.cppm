@@ -262,6 +262,19 @@ public:
     Pair<SizeT, SizeT> AddVec(Iterator &&query_iter) {
         SizeT mem_usage = 0;
         SizeT cur_vec_num = this->cur_vec_num();
+        if constexpr (VecStoreT::HasTrain) {
+            if (!this->vec_store_meta_.trained()) {
+                std::decay_t<Iterator> query_iter_copy = query_iter;
+                if (this->vec_store_meta_.Train(std::move(query_iter_copy))) {
+                    // the vectors added before are encoded by the previous fit
+                    for (SizeT i = 0; i < cur_vec_num; ++i) {
+                        auto [inner, idx] = GetInner(i);
+                        inner.vec_store_inner()->SetVec(idx, this->vec_store_meta_.train_vec(i), this->vec_store_meta_, mem_usage);
+                    }
+                }
+                this->vec_store_meta_.FinishTrain();
+            }
+        }
         SizeT start_idx = cur_vec_num;
         auto [chunk_num, last_chunk_size] = ChunkInfo(cur_vec_num);
         while (true) {
@@ -342,6 +355,16 @@ public:
         return inner.GetNeighbors(idx, layer_i, this->graph_store_meta_);
     }
 
+    void PrefetchNeighbors(VertexType vertex_i) const {
+        const auto &[inner, idx] = GetInner(vertex_i);
+        inner.PrefetchNeighbors(idx, this->graph_store_meta_);
+    }
+
+    i32 GetLayerN(VertexType vertex_i) const {
+        const auto &[inner, idx] = GetInner(vertex_i);
+        return inner.GetLayerN(idx, this->graph_store_meta_);
+    }
+
     Pair<i32, VertexType> TryUpdateEnterPoint(i32 layer, VertexType vertex_i) { return this->graph_store_meta_.TryUpdateEnterPoint(layer, vertex_i); }
 
     // other
@@ -474,6 +497,10 @@ public:
         return inner_.GetNeighbors(vertex_i, layer_i, this->graph_store_meta_);
     }
 
+    void PrefetchNeighbors(VertexType vertex_i) const { inner_.PrefetchNeighbors(vertex_i, this->graph_store_meta_); }
+
+    i32 GetLayerN(VertexType vertex_i) const { return inner_.GetLayerN(vertex_i, this->graph_store_meta_); }
+
     LabelType GetLabel(SizeT vec_i) const { return inner_.GetLabel(vec_i); }
 
     SizeT cur_vec_num() const { return cur_vec_num_; }
@@ -567,6 +594,10 @@ public:
         return graph_store_inner_.GetNeighbors(vertex_i, layer_i, meta);
     }
 
+    i32 GetLayerN(VertexType vertex_i, const GraphStoreMeta &meta) const { return graph_store_inner_.GetLayerN(vertex_i, meta); }
+
+    void PrefetchNeighbors(VertexType vertex_i, const GraphStoreMeta &meta) const { graph_store_inner_.PrefetchNeighbors(vertex_i, meta); }
+
     LabelType GetLabel(VertexType vec_i) const { return labels_[vec_i]; }
 
     VecStoreInner *vec_store_inner() { return &vec_store_inner_; }
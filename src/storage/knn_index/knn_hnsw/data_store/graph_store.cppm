@@ -16,6 +16,11 @@ module;
 
 #include <cassert>
 #include <ostream>
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <xmmintrin.h>
+#elif defined(__GNUC__) && defined(__aarch64__)
+#include <simde/x86/sse.h>
+#endif
 
 export module graph_store;
 
@@ -239,6 +244,13 @@ public:
         return {vx->neighbors_, vx->neighbor_n_};
     }
 
+    i32 GetLayerN(VertexType vertex_i, const GraphStoreMeta &meta) const { return GetLevel0(vertex_i, meta)->layer_n_; }
+
+    // the neighbor count and the first neighbors of layer 0
+    void PrefetchNeighbors(VertexType vertex_i, const GraphStoreMeta &meta) const {
+        _mm_prefetch(reinterpret_cast<const char *>(GetLevel0(vertex_i, meta)), _MM_HINT_T0);
+    }
+
 protected:
     const VertexL0 *GetLevel0(VertexType vertex_i, const GraphStoreMeta &meta) const {
         return reinterpret_cast<const VertexL0 *>(graph_.get() + vertex_i * meta.level0_size());
@@ -0,0 +1,378 @@
+// Copyright(C) 2024 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+module;
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <ostream>
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <xmmintrin.h>
+#elif defined(__GNUC__) && defined(__aarch64__)
+#include <simde/x86/sse.h>
+#endif
+
+export module pq_vec_store;
+
+import stl;
+import local_file_handle;
+import hnsw_common;
+import serialize;
+import data_store_util;
+import index_base;
+import kmeans_partition;
+import infinity_exception;
+
+namespace infinity {
+
+// A stored vector is referred by its codes, a query by its distance table to all the centroids.
+export struct PQVecRef {
+    const u8 *code_ = nullptr;
+    const f32 *table_ = nullptr;
+};
+
+export template <typename DataType, QuantMetric Metric, bool OwnMem>
+class PQVecStoreInner;
+
+// Product quantization. The vector is split into subspaces of subspace_dim_ elements, each encoded in one byte by
+// the nearest of the 256 centroids of the subspace. The vectors added are buffered and the codebooks are fit again on the
+// buffer whenever it doubles, the codebooks are fixed and the buffer is dropped when kMinTrainNum vectors have been seen.
+export template <typename DataType, QuantMetric Metric, bool OwnMem>
+class PQVecStoreMeta {
+public:
+    static_assert(std::is_same_v<DataType, f32>);
+
+    using This = PQVecStoreMeta<DataType, Metric, OwnMem>;
+    using Inner = PQVecStoreInner<DataType, Metric, OwnMem>;
+    struct PQQuery {
+        UniquePtr<f32[]> table_;
+        operator PQVecRef() const { return {nullptr, table_.get()}; }
+    };
+    using StoreType = PQVecRef;
+    using QueryType = PQQuery;
+    using DistanceType = f32;
+
+    constexpr static SizeT kCentroidNum = 256;
+    // the codebooks are fixed once they are fit on so many vectors
+    constexpr static SizeT kMinTrainNum = 16 * kCentroidNum;
+    // the codebooks are trained by at most so many vectors
+    constexpr static SizeT kMaxTrainNum = 16384;
+
+private:
+    PQVecStoreMeta(SizeT dim) : dim_(dim) {
+        subspace_dim_ = dim % 4 == 0 ? 4 : (dim % 2 == 0 ? 2 : 1);
+        subspace_num_ = dim / subspace_dim_;
+    }
+
+public:
+    PQVecStoreMeta() = default;
+    PQVecStoreMeta(This &&other)
+        : dim_(std::exchange(other.dim_, 0)), subspace_dim_(std::exchange(other.subspace_dim_, 0)),
+          subspace_num_(std::exchange(other.subspace_num_, 0)), centroid_num_(std::exchange(other.centroid_num_, 0)),
+          centroids_(std::move(other.centroids_)), fit_num_(std::exchange(other.fit_num_, 0)), train_buffer_(std::move(other.train_buffer_)) {}
+    PQVecStoreMeta &operator=(This &&other) {
+        if (this != &other) {
+            dim_ = std::exchange(other.dim_, 0);
+            subspace_dim_ = std::exchange(other.subspace_dim_, 0);
+            subspace_num_ = std::exchange(other.subspace_num_, 0);
+            centroid_num_ = std::exchange(other.centroid_num_, 0);
+            centroids_ = std::move(other.centroids_);
+            fit_num_ = std::exchange(other.fit_num_, 0);
+            train_buffer_ = std::move(other.train_buffer_);
+        }
+        return *this;
+    }
+
+    static This Make(SizeT dim) {
+        This meta(dim);
+        if constexpr (OwnMem) {
+            meta.centroids_ = MakeUnique<f32[]>(dim * kCentroidNum);
+        }
+        return meta;
+    }
+    static This Make(SizeT dim, bool) { return Make(dim); }
+
+    SizeT GetSizeInBytes() const { return sizeof(dim_) + sizeof(centroid_num_) + sizeof(f32) * dim_ * kCentroidNum; }
+
+    void Save(LocalFileHandle &file_handle) const {
+        file_handle.Append(&dim_, sizeof(dim_));
+        file_handle.Append(&centroid_num_, sizeof(centroid_num_));
+        file_handle.Append(centroids_.get(), sizeof(f32) * dim_ * kCentroidNum);
+    }
+
+    static This Load(LocalFileHandle &file_handle) {
+        SizeT dim;
+        file_handle.Read(&dim, sizeof(dim));
+        This meta = Make(dim);
+        file_handle.Read(&meta.centroid_num_, sizeof(meta.centroid_num_));
+        file_handle.Read(meta.centroids_.get(), sizeof(f32) * dim * kCentroidNum);
+        return meta;
+    }
+
+    static This LoadFromPtr(const char *&ptr) {
+        SizeT dim = ReadBufAdv<SizeT>(ptr);
+        This meta(dim);
+        meta.centroid_num_ = ReadBufAdv<SizeT>(ptr);
+        if constexpr (OwnMem) {
+            meta.centroids_ = MakeUniqueForOverwrite<f32[]>(dim * kCentroidNum);
+            std::memcpy(meta.centroids_.get(), ptr, sizeof(f32) * dim * kCentroidNum);
+        } else {
+            meta.centroids_ = reinterpret_cast<const f32 *>(ptr);
+        }
+        ptr += sizeof(f32) * dim * kCentroidNum;
+        return meta;
+    }
+
+    // a loaded index is trained, it accepts no more vectors
+    bool trained() const { return centroid_num_ > 0 && train_buffer_.empty(); }
+
+    // Buffer the vectors and fit the codebooks again if the buffer has doubled since the last fit. k-means of every
+    // subspace, the points are the centroids if they are not more than kCentroidNum.
+    // Return true if the codebooks change, then the vectors added before must be encoded again by train_vec().
+    template <typename Iterator>
+    bool Train(Iterator &&query_iter) {
+        SizeT train_num = train_buffer_.size() / dim_;
+        while (train_num < kMaxTrainNum) {
+            auto ret = query_iter.Next();
+            if (!ret) {
+                break;
+            }
+            const auto &[vec, _] = *ret;
+            train_buffer_.resize((train_num + 1) * dim_);
+            Prepare(vec, train_buffer_.data() + train_num * dim_);
+            ++train_num;
+        }
+        if (train_num == 0 || (train_num < kMinTrainNum && train_num < 2 * fit_num_)) {
+            return false;
+        }
+        Vector<f32> subspace_data(train_num * subspace_dim_);
+        Vector<f32> subspace_centroids;
+        for (SizeT m = 0; m < subspace_num_; ++m) {
+            for (SizeT i = 0; i < train_num; ++i) {
+                const f32 *sub = train_buffer_.data() + i * dim_ + m * subspace_dim_;
+                std::copy(sub, sub + subspace_dim_, subspace_data.data() + i * subspace_dim_);
+            }
+            f32 *centroids = centroids_.get() + m * kCentroidNum * subspace_dim_;
+            if (train_num <= kCentroidNum) {
+                std::copy(subspace_data.begin(), subspace_data.end(), centroids);
+                continue;
+            }
+            u32 n = GetKMeansCentroids(MetricType::kMetricL2, subspace_dim_, train_num, subspace_data.data(), subspace_centroids, kCentroidNum);
+            if (n != kCentroidNum) {
+                UnrecoverableError("Failed to train the PQ codebooks.");
+            }
+            std::copy(subspace_centroids.begin(), subspace_centroids.end(), centroids);
+        }
+        centroid_num_ = std::min(train_num, kCentroidNum);
+        fit_num_ = train_num;
+        return true;
+    }
+
+    const f32 *train_vec(SizeT idx) const { return train_buffer_.data() + idx * dim_; }
+
+    // drop the buffer once the codebooks are fit on enough vectors
+    void FinishTrain() {
+        if (fit_num_ >= kMinTrainNum) {
+            train_buffer_ = Vector<f32>();
+        }
+    }
+
+    void CompressTo(const DataType *src, u8 *code) const {
+        UniquePtr<f32[]> prepared;
+        if constexpr (Metric == QuantMetric::kCos) {
+            prepared = MakeUniqueForOverwrite<f32[]>(dim_);
+            Prepare(src, prepared.get());
+            src = prepared.get();
+        }
+        for (SizeT m = 0; m < subspace_num_; ++m) {
+            const f32 *sub = src + m * subspace_dim_;
+            const f32 *centroids = centroids_.get() + m * kCentroidNum * subspace_dim_;
+            f32 min_dist = std::numeric_limits<f32>::max();
+            SizeT min_k = 0;
+            for (SizeT k = 0; k < centroid_num_; ++k) {
+                f32 dist = SubL2(sub, centroids + k * subspace_dim_);
+                if (dist < min_dist) {
+                    min_dist = dist;
+                    min_k = k;
+                }
+            }
+            code[m] = min_k;
+        }
+    }
+
+    // table[m * 256 + k] is the distance of the m-th subspace of the query to the k-th centroid of the subspace
+    QueryType MakeQuery(const DataType *vec) const {
+        UniquePtr<f32[]> prepared = MakeUniqueForOverwrite<f32[]>(dim_);
+        Prepare(vec, prepared.get());
+        auto table = MakeUnique<f32[]>(subspace_num_ * kCentroidNum);
+        for (SizeT m = 0; m < subspace_num_; ++m) {
+            const f32 *sub = prepared.get() + m * subspace_dim_;
+            const f32 *centroids = centroids_.get() + m * kCentroidNum * subspace_dim_;
+            for (SizeT k = 0; k < centroid_num_; ++k) {
+                table[m * kCentroidNum + k] = SubDist(sub, centroids + k * subspace_dim_);
+            }
+        }
+        return QueryType{std::move(table)};
+    }
+
+    // distance between two encoded vectors, used while building the graph
+    f32 SymmetricDistance(const u8 *code1, const u8 *code2) const {
+        f32 dist = 0;
+        for (SizeT m = 0; m < subspace_num_; ++m) {
+            const f32 *centroids = centroids_.get() + m * kCentroidNum * subspace_dim_;
+            dist += SubDist(centroids + code1[m] * subspace_dim_, centroids + code2[m] * subspace_dim_);
+        }
+        return dist;
+    }
+
+    SizeT dim() const { return dim_; }
+    SizeT subspace_num() const { return subspace_num_; }
+    SizeT compress_data_size() const { return subspace_num_; }
+
+private:
+    void Prepare(const DataType *src, f32 *dest) const {
+        std::copy(src, src + dim_, dest);
+        if constexpr (Metric == QuantMetric::kCos) {
+            f32 norm = 0;
+            for (SizeT j = 0; j < dim_; ++j) {
+                norm += dest[j] * dest[j];
+            }
+            if (norm > 0) {
+                norm = 1 / std::sqrt(norm);
+                for (SizeT j = 0; j < dim_; ++j) {
+                    dest[j] *= norm;
+                }
+            }
+        }
+    }
+
+    f32 SubL2(const f32 *v1, const f32 *v2) const {
+        f32 dist = 0;
+        for (SizeT j = 0; j < subspace_dim_; ++j) {
+            f32 diff = v1[j] - v2[j];
+            dist += diff * diff;
+        }
+        return dist;
+    }
+
+    f32 SubDist(const f32 *v1, const f32 *v2) const {
+        if constexpr (Metric == QuantMetric::kL2) {
+            return SubL2(v1, v2);
+        } else {
+            f32 ip = 0;
+            for (SizeT j = 0; j < subspace_dim_; ++j) {
+                ip += v1[j] * v2[j];
+            }
+            return -ip;
+        }
+    }
+
+    SizeT dim_ = 0;
+    SizeT subspace_dim_ = 0;
+    SizeT subspace_num_ = 0;
+    SizeT centroid_num_ = 0;
+    ArrayPtr<f32, OwnMem> centroids_;
+    // the number of vectors of the last fit, and the prepared vectors added before the codebooks are fixed
+    SizeT fit_num_ = 0;
+    Vector<f32> train_buffer_;
+
+public:
+    void Dump(std::ostream &os) const {
+        os << "[CONST] dim: " << dim_ << ", subspace_dim: " << subspace_dim_ << ", centroid_num: " << centroid_num_ << std::endl;
+    }
+};
+
+export template <typename DataType, QuantMetric Metric, bool OwnMem>
+class PQVecStoreInner {
+public:
+    using This = PQVecStoreInner<DataType, Metric, OwnMem>;
+    using Meta = PQVecStoreMeta<DataType, Metric, OwnMem>;
+    using Base = This;
+
+private:
+    PQVecStoreInner(SizeT max_vec_num, const Meta &meta) { codes_ = MakeUnique<u8[]>(max_vec_num * meta.compress_data_size()); }
+    PQVecStoreInner(const u8 *codes) { codes_ = codes; }
+
+public:
+    PQVecStoreInner() = default;
+
+    static This Make(SizeT max_vec_num, const Meta &meta, SizeT &mem_usage) {
+        mem_usage += max_vec_num * meta.compress_data_size();
+        return This(max_vec_num, meta);
+    }
+
+    static This Load(LocalFileHandle &file_handle, SizeT cur_vec_num, SizeT max_vec_num, const Meta &meta, SizeT &mem_usage) {
+        assert(cur_vec_num <= max_vec_num);
+        This ret(max_vec_num, meta);
+        file_handle.Read(ret.codes_.get(), cur_vec_num * meta.compress_data_size());
+        mem_usage += max_vec_num * meta.compress_data_size();
+        return ret;
+    }
+
+    static This LoadFromPtr(const char *&ptr, SizeT cur_vec_num, SizeT max_vec_num, const Meta &meta, SizeT &mem_usage) {
+        This ret(max_vec_num, meta);
+        std::memcpy(ret.codes_.get(), ptr, cur_vec_num * meta.compress_data_size());
+        ptr += cur_vec_num * meta.compress_data_size();
+        mem_usage += max_vec_num * meta.compress_data_size();
+        return ret;
+    }
+
+    static This LoadFromPtr(const char *&ptr, SizeT cur_vec_num, const Meta &meta) {
+        This ret(reinterpret_cast<const u8 *>(ptr));
+        ptr += cur_vec_num * meta.compress_data_size();
+        return ret;
+    }
+
+    SizeT GetSizeInBytes(SizeT cur_vec_num, const Meta &meta) const { return cur_vec_num * meta.compress_data_size(); }
+
+    void Save(LocalFileHandle &file_handle, SizeT cur_vec_num, const Meta &meta) const {
+        file_handle.Append(codes_.get(), cur_vec_num * meta.compress_data_size());
+    }
+
+    static void
+    SaveToPtr(LocalFileHandle &file_handle, const Vector<const This *> &inners, const Meta &meta, SizeT ck_size, SizeT chunk_num, SizeT last_chunk_size) {
+        for (SizeT i = 0; i < chunk_num; ++i) {
+            SizeT chunk_size = (i < chunk_num - 1) ? ck_size : last_chunk_size;
+            file_handle.Append(inners[i]->codes_.get(), chunk_size * meta.compress_data_size());
+        }
+    }
+
+    PQVecRef GetVec(SizeT idx, const Meta &meta) const { return {codes_.get() + idx * meta.compress_data_size(), nullptr}; }
+
+    void SetVec(SizeT idx, const DataType *vec, const Meta &meta, SizeT &mem_usage) {
+        meta.CompressTo(vec, codes_.get() + idx * meta.compress_data_size());
+    }
+
+    void Prefetch(VertexType vec_i, const Meta &meta) const {
+        _mm_prefetch(reinterpret_cast<const char *>(codes_.get() + vec_i * meta.compress_data_size()), _MM_HINT_T0);
+    }
+
+private:
+    ArrayPtr<u8, OwnMem> codes_;
+
+public:
+    void Dump(std::ostream &os, SizeT offset, SizeT chunk_size, const Meta &meta) const {
+        for (int i = 0; i < (int)chunk_size; ++i) {
+            os << "vec " << i << "(" << offset + i << "): ";
+            const u8 *code = GetVec(i, meta).code_;
+            for (SizeT m = 0; m < meta.compress_data_size(); ++m) {
+                os << static_cast<int>(code[m]) << " ";
+            }
+            os << std::endl;
+        }
+    }
+};
+
+} // namespace infinity
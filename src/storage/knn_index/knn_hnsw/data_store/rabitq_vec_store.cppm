@@ -0,0 +1,456 @@
+// Copyright(C) 2024 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+module;
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <ostream>
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <xmmintrin.h>
+#elif defined(__GNUC__) && defined(__aarch64__)
+#include <simde/x86/sse.h>
+#endif
+
+export module rabitq_vec_store;
+
+import stl;
+import local_file_handle;
+import hnsw_common;
+import serialize;
+import data_store_util;
+
+namespace infinity {
+
+// o is a stored vector, c the centroid. The code is the signs of P(o - c), P a random orthogonal rotation.
+export struct RaBitQData {
+    f32 norm_;  // ||o - c||
+    f32 x0_;    // <code as a unit vector, P(o - c) / ||o - c||>
+    f32 c_ip_;  // <c, o - c>
+    u32 bit_n_; // set bits of the code
+    u64 code_[];
+};
+
+// The query u (q - c for l2, q for ip) is rotated and scalar quantized to 4 bits, stored as 4 bit planes.
+export struct RaBitQQueryData {
+    f32 lo_;
+    f32 delta_;
+    f32 sum_;     // sum of the quantized values
+    f32 u_norm2_; // ||u||^2
+    f32 c_ip_;    // <c, q>
+    Vector<u64> planes_;
+};
+
+// A stored vector is referred by its data, a query by its quantized planes.
+export struct RaBitQVecRef {
+    const RaBitQData *data_ = nullptr;
+    const RaBitQQueryData *query_ = nullptr;
+};
+
+export template <typename DataType, QuantMetric Metric, bool OwnMem>
+class RaBitQVecStoreInner;
+
+// 1-bit quantization of RaBitQ. Distances are unbiased estimates, the results are expected to be reranked by the raw vectors.
+export template <typename DataType, QuantMetric Metric, bool OwnMem>
+class RaBitQVecStoreMeta {
+public:
+    static_assert(std::is_same_v<DataType, f32>);
+
+    using This = RaBitQVecStoreMeta<DataType, Metric, OwnMem>;
+    using Inner = RaBitQVecStoreInner<DataType, Metric, OwnMem>;
+    struct RaBitQQuery {
+        UniquePtr<RaBitQQueryData> inner_;
+        operator RaBitQVecRef() const { return {nullptr, inner_.get()}; }
+    };
+    using StoreType = RaBitQVecRef;
+    using QueryType = RaBitQQuery;
+    using DistanceType = f32;
+
+    // the centroid is fixed once it is the mean of so many vectors
+    constexpr static SizeT kMinTrainNum = 1024;
+    // the centroid is the mean of at most so many vectors
+    constexpr static SizeT kMaxTrainNum = 16384;
+    // rounds of random signs and Hadamard transform, the rotation is regenerated by the fixed seed instead of stored
+    constexpr static SizeT kRotateRound = 3;
+    constexpr static u32 kRotateSeed = 0x5eed;
+    constexpr static u32 kQueryBits = 4;
+
+private:
+    RaBitQVecStoreMeta(SizeT dim) : dim_(dim) {
+        pad_dim_ = 64;
+        while (pad_dim_ < dim) {
+            pad_dim_ <<= 1;
+        }
+        word_n_ = pad_dim_ / 64;
+        signs_.resize(kRotateRound * pad_dim_);
+        std::mt19937 rng(kRotateSeed);
+        for (auto &sign : signs_) {
+            sign = (rng() & 1) ? 1.0f : -1.0f;
+        }
+    }
+
+public:
+    RaBitQVecStoreMeta() = default;
+    RaBitQVecStoreMeta(This &&other)
+        : dim_(std::exchange(other.dim_, 0)), pad_dim_(std::exchange(other.pad_dim_, 0)), word_n_(std::exchange(other.word_n_, 0)),
+          trained_(std::exchange(other.trained_, 0)), centroid_(std::move(other.centroid_)), centroid_norm2_(other.centroid_norm2_),
+          signs_(std::move(other.signs_)), train_buffer_(std::move(other.train_buffer_)) {}
+    RaBitQVecStoreMeta &operator=(This &&other) {
+        if (this != &other) {
+            dim_ = std::exchange(other.dim_, 0);
+            pad_dim_ = std::exchange(other.pad_dim_, 0);
+            word_n_ = std::exchange(other.word_n_, 0);
+            trained_ = std::exchange(other.trained_, 0);
+            centroid_ = std::move(other.centroid_);
+            centroid_norm2_ = other.centroid_norm2_;
+            signs_ = std::move(other.signs_);
+            train_buffer_ = std::move(other.train_buffer_);
+        }
+        return *this;
+    }
+
+    static This Make(SizeT dim) {
+        This meta(dim);
+        if constexpr (OwnMem) {
+            meta.centroid_ = MakeUnique<f32[]>(dim);
+        }
+        return meta;
+    }
+    static This Make(SizeT dim, bool) { return Make(dim); }
+
+    SizeT GetSizeInBytes() const { return sizeof(dim_) + sizeof(trained_) + sizeof(f32) * dim_; }
+
+    void Save(LocalFileHandle &file_handle) const {
+        file_handle.Append(&dim_, sizeof(dim_));
+        file_handle.Append(&trained_, sizeof(trained_));
+        file_handle.Append(centroid_.get(), sizeof(f32) * dim_);
+    }
+
+    static This Load(LocalFileHandle &file_handle) {
+        SizeT dim;
+        file_handle.Read(&dim, sizeof(dim));
+        This meta = Make(dim);
+        file_handle.Read(&meta.trained_, sizeof(meta.trained_));
+        file_handle.Read(meta.centroid_.get(), sizeof(f32) * dim);
+        meta.InitCentroidNorm();
+        return meta;
+    }
+
+    static This LoadFromPtr(const char *&ptr) {
+        SizeT dim = ReadBufAdv<SizeT>(ptr);
+        This meta(dim);
+        meta.trained_ = ReadBufAdv<SizeT>(ptr);
+        if constexpr (OwnMem) {
+            meta.centroid_ = MakeUniqueForOverwrite<f32[]>(dim);
+            std::memcpy(meta.centroid_.get(), ptr, sizeof(f32) * dim);
+        } else {
+            meta.centroid_ = reinterpret_cast<const f32 *>(ptr);
+        }
+        ptr += sizeof(f32) * dim;
+        meta.InitCentroidNorm();
+        return meta;
+    }
+
+    // a loaded index is trained, it accepts no more vectors
+    bool trained() const { return trained_ > 0 && train_buffer_.empty(); }
+
+    // Buffer the vectors and compute the centroid again if the buffer has doubled since the last time.
+    // Return true if the centroid changes, then the vectors added before must be encoded again by train_vec().
+    template <typename Iterator>
+    bool Train(Iterator &&query_iter) {
+        SizeT train_num = train_buffer_.size() / dim_;
+        while (train_num < kMaxTrainNum) {
+            auto ret = query_iter.Next();
+            if (!ret) {
+                break;
+            }
+            const auto &[src, _] = *ret;
+            train_buffer_.resize((train_num + 1) * dim_);
+            Prepare(src, train_buffer_.data() + train_num * dim_);
+            ++train_num;
+        }
+        if (train_num == 0 || (train_num < kMinTrainNum && train_num < 2 * trained_)) {
+            return false;
+        }
+        Vector<f64> sum(dim_);
+        for (SizeT i = 0; i < train_num; ++i) {
+            const f32 *vec = train_buffer_.data() + i * dim_;
+            for (SizeT j = 0; j < dim_; ++j) {
+                sum[j] += vec[j];
+            }
+        }
+        for (SizeT j = 0; j < dim_; ++j) {
+            centroid_[j] = sum[j] / train_num;
+        }
+        InitCentroidNorm();
+        trained_ = train_num;
+        return true;
+    }
+
+    const f32 *train_vec(SizeT idx) const { return train_buffer_.data() + idx * dim_; }
+
+    // drop the buffer once the centroid is computed by enough vectors
+    void FinishTrain() {
+        if (trained_ >= kMinTrainNum) {
+            train_buffer_ = Vector<f32>();
+        }
+    }
+
+    void CompressTo(const DataType *src, RaBitQData *dest) const {
+        Vector<f32> o(pad_dim_);
+        Prepare(src, o.data());
+        f32 norm2 = 0;
+        f32 c_ip = 0;
+        for (SizeT j = 0; j < dim_; ++j) {
+            o[j] -= centroid_[j];
+            norm2 += o[j] * o[j];
+            c_ip += centroid_[j] * o[j];
+        }
+        Rotate(o.data());
+        std::fill_n(dest->code_, word_n_, 0);
+        u32 bit_n = 0;
+        f32 abs_sum = 0;
+        for (SizeT i = 0; i < pad_dim_; ++i) {
+            if (o[i] > 0) {
+                dest->code_[i / 64] |= u64(1) << (i % 64);
+                ++bit_n;
+            }
+            abs_sum += std::abs(o[i]);
+        }
+        f32 norm = std::sqrt(norm2);
+        dest->norm_ = norm;
+        dest->x0_ = norm > 0 ? abs_sum / (norm * std::sqrt(f32(pad_dim_))) : 1;
+        dest->c_ip_ = c_ip;
+        dest->bit_n_ = bit_n;
+    }
+
+    QueryType MakeQuery(const DataType *vec) const {
+        auto query = MakeUnique<RaBitQQueryData>();
+        Vector<f32> u(pad_dim_);
+        Prepare(vec, u.data());
+        f32 c_ip = 0;
+        for (SizeT j = 0; j < dim_; ++j) {
+            c_ip += centroid_[j] * u[j];
+        }
+        if constexpr (Metric == QuantMetric::kL2) {
+            for (SizeT j = 0; j < dim_; ++j) {
+                u[j] -= centroid_[j];
+            }
+        }
+        f32 u_norm2 = 0;
+        for (SizeT j = 0; j < dim_; ++j) {
+            u_norm2 += u[j] * u[j];
+        }
+        Rotate(u.data());
+        auto [lo, hi] = std::minmax_element(u.begin(), u.end());
+        f32 delta = (*hi - *lo) / ((1 << kQueryBits) - 1);
+        query->lo_ = *lo;
+        query->delta_ = delta;
+        query->u_norm2_ = u_norm2;
+        query->c_ip_ = c_ip;
+        query->planes_.assign(kQueryBits * word_n_, 0);
+        u32 q_sum = 0;
+        for (SizeT i = 0; i < pad_dim_; ++i) {
+            u32 q = delta > 0 ? u32(std::lround((u[i] - query->lo_) / delta)) : 0;
+            q_sum += q;
+            for (u32 b = 0; b < kQueryBits; ++b) {
+                if ((q >> b) & 1) {
+                    query->planes_[b * word_n_ + i / 64] |= u64(1) << (i % 64);
+                }
+            }
+        }
+        query->sum_ = query->lo_ * pad_dim_ + delta * q_sum;
+        return QueryType{std::move(query)};
+    }
+
+    // plane_ip: sum of the quantized query values of the set bits of the code, in units of delta
+    f32 EstimateDistance(const RaBitQData *data, const RaBitQQueryData *query, u32 plane_ip) const {
+        f32 set_sum = query->lo_ * data->bit_n_ + query->delta_ * plane_ip;
+        f32 xu = (2 * set_sum - query->sum_) / std::sqrt(f32(pad_dim_));
+        f32 ou = xu / data->x0_;
+        if constexpr (Metric == QuantMetric::kL2) {
+            return data->norm_ * data->norm_ + query->u_norm2_ - 2 * data->norm_ * ou;
+        } else {
+            return -(query->c_ip_ + data->norm_ * ou);
+        }
+    }
+
+    // distance between two encoded vectors, used while building the graph. The angle of the two residuals is estimated by their hamming distance.
+    f32 SymmetricDistance(const RaBitQData *data1, const RaBitQData *data2) const {
+        u32 hamming = 0;
+        for (SizeT i = 0; i < word_n_; ++i) {
+            hamming += __builtin_popcountll(data1->code_[i] ^ data2->code_[i]);
+        }
+        f32 cos = std::cos(f32(M_PI) * hamming / pad_dim_);
+        f32 residual_ip = data1->norm_ * data2->norm_ * cos;
+        if constexpr (Metric == QuantMetric::kL2) {
+            return data1->norm_ * data1->norm_ + data2->norm_ * data2->norm_ - 2 * residual_ip;
+        } else {
+            return -(centroid_norm2_ + data1->c_ip_ + data2->c_ip_ + residual_ip);
+        }
+    }
+
+    SizeT dim() const { return dim_; }
+    SizeT word_n() const { return word_n_; }
+    SizeT compress_data_size() const { return sizeof(RaBitQData) + sizeof(u64) * word_n_; }
+
+private:
+    // copy the vector into dest, which is zero padded
+    void Prepare(const DataType *src, f32 *dest) const {
+        std::copy(src, src + dim_, dest);
+        if constexpr (Metric == QuantMetric::kCos) {
+            f32 norm = 0;
+            for (SizeT j = 0; j < dim_; ++j) {
+                norm += dest[j] * dest[j];
+            }
+            if (norm > 0) {
+                norm = 1 / std::sqrt(norm);
+                for (SizeT j = 0; j < dim_; ++j) {
+                    dest[j] *= norm;
+                }
+            }
+        }
+    }
+
+    void Rotate(f32 *v) const {
+        const f32 scale = 1 / std::sqrt(f32(pad_dim_));
+        for (SizeT r = 0; r < kRotateRound; ++r) {
+            const f32 *sign = signs_.data() + r * pad_dim_;
+            for (SizeT i = 0; i < pad_dim_; ++i) {
+                v[i] *= sign[i];
+            }
+            for (SizeT h = 1; h < pad_dim_; h <<= 1) {
+                for (SizeT i = 0; i < pad_dim_; i += h << 1) {
+                    for (SizeT j = i; j < i + h; ++j) {
+                        f32 a = v[j];
+                        f32 b = v[j + h];
+                        v[j] = a + b;
+                        v[j + h] = a - b;
+                    }
+                }
+            }
+            for (SizeT i = 0; i < pad_dim_; ++i) {
+                v[i] *= scale;
+            }
+        }
+    }
+
+    void InitCentroidNorm() {
+        centroid_norm2_ = 0;
+        for (SizeT j = 0; j < dim_; ++j) {
+            centroid_norm2_ += centroid_[j] * centroid_[j];
+        }
+    }
+
+    SizeT dim_ = 0;
+    SizeT pad_dim_ = 0;
+    SizeT word_n_ = 0;
+    SizeT trained_ = 0; // vectors the centroid is computed by
+    ArrayPtr<f32, OwnMem> centroid_;
+    f32 centroid_norm2_ = 0;
+    Vector<f32> signs_;
+    // the prepared vectors added before the centroid is fixed
+    Vector<f32> train_buffer_;
+
+public:
+    void Dump(std::ostream &os) const {
+        os << "[CONST] dim: " << dim_ << ", pad_dim: " << pad_dim_ << ", trained: " << trained_ << std::endl;
+        os << "centroid: ";
+        for (SizeT j = 0; j < dim_; ++j) {
+            os << centroid_[j] << " ";
+        }
+        os << std::endl;
+    }
+};
+
+export template <typename DataType, QuantMetric Metric, bool OwnMem>
+class RaBitQVecStoreInner {
+public:
+    using This = RaBitQVecStoreInner<DataType, Metric, OwnMem>;
+    using Meta = RaBitQVecStoreMeta<DataType, Metric, OwnMem>;
+    using Base = This;
+
+private:
+    RaBitQVecStoreInner(SizeT max_vec_num, const Meta &meta) { ptr_ = MakeUnique<char[]>(max_vec_num * meta.compress_data_size()); }
+    RaBitQVecStoreInner(const char *ptr) { ptr_ = ptr; }
+
+public:
+    RaBitQVecStoreInner() = default;
+
+    static This Make(SizeT max_vec_num, const Meta &meta, SizeT &mem_usage) {
+        mem_usage += max_vec_num * meta.compress_data_size();
+        return This(max_vec_num, meta);
+    }
+
+    static This Load(LocalFileHandle &file_handle, SizeT cur_vec_num, SizeT max_vec_num, const Meta &meta, SizeT &mem_usage) {
+        assert(cur_vec_num <= max_vec_num);
+        This ret(max_vec_num, meta);
+        file_handle.Read(ret.ptr_.get(), cur_vec_num * meta.compress_data_size());
+        mem_usage += max_vec_num * meta.compress_data_size();
+        return ret;
+    }
+
+    static This LoadFromPtr(const char *&ptr, SizeT cur_vec_num, SizeT max_vec_num, const Meta &meta, SizeT &mem_usage) {
+        This ret(max_vec_num, meta);
+        std::memcpy(ret.ptr_.get(), ptr, cur_vec_num * meta.compress_data_size());
+        ptr += cur_vec_num * meta.compress_data_size();
+        mem_usage += max_vec_num * meta.compress_data_size();
+        return ret;
+    }
+
+    static This LoadFromPtr(const char *&ptr, SizeT cur_vec_num, const Meta &meta) {
+        This ret(ptr);
+        ptr += cur_vec_num * meta.compress_data_size();
+        return ret;
+    }
+
+    SizeT GetSizeInBytes(SizeT cur_vec_num, const Meta &meta) const { return cur_vec_num * meta.compress_data_size(); }
+
+    void Save(LocalFileHandle &file_handle, SizeT cur_vec_num, const Meta &meta) const {
+        file_handle.Append(ptr_.get(), cur_vec_num * meta.compress_data_size());
+    }
+
+    static void
+    SaveToPtr(LocalFileHandle &file_handle, const Vector<const This *> &inners, const Meta &meta, SizeT ck_size, SizeT chunk_num, SizeT last_chunk_size) {
+        for (SizeT i = 0; i < chunk_num; ++i) {
+            SizeT chunk_size = (i < chunk_num - 1) ? ck_size : last_chunk_size;
+            file_handle.Append(inners[i]->ptr_.get(), chunk_size * meta.compress_data_size());
+        }
+    }
+
+    RaBitQVecRef GetVec(SizeT idx, const Meta &meta) const {
+        return {reinterpret_cast<const RaBitQData *>(ptr_.get() + idx * meta.compress_data_size()), nullptr};
+    }
+
+    void SetVec(SizeT idx, const DataType *vec, const Meta &meta, SizeT &mem_usage) {
+        meta.CompressTo(vec, reinterpret_cast<RaBitQData *>(ptr_.get() + idx * meta.compress_data_size()));
+    }
+
+    void Prefetch(VertexType vec_i, const Meta &meta) const { _mm_prefetch(reinterpret_cast<const char *>(GetVec(vec_i, meta).data_), _MM_HINT_T0); }
+
+private:
+    ArrayPtr<char, OwnMem> ptr_;
+
+public:
+    void Dump(std::ostream &os, SizeT offset, SizeT chunk_size, const Meta &meta) const {
+        for (int i = 0; i < (int)chunk_size; ++i) {
+            os << "vec " << i << "(" << offset + i << "): ";
+            const RaBitQData *data = GetVec(i, meta).data_;
+            os << "norm: " << data->norm_ << ", x0: " << data->x0_ << ", bit_n: " << data->bit_n_ << std::endl;
+        }
+    }
+};
+
+} // namespace infinity
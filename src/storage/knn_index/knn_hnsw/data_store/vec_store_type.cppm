@@ -20,12 +20,18 @@ import stl;
 import plain_vec_store;
 import sparse_vec_store;
 import lvq_vec_store;
+import pq_vec_store;
+import rabitq_vec_store;
 import dist_func_cos;
 import dist_func_l2;
 import dist_func_ip;
 import dist_func_sparse_ip;
 import sparse_util;
 import dist_func_lsg_wrapper;
+import dist_func_pq;
+import dist_func_rabitq;
+import dist_func_hamming;
+import hnsw_common;
 
 namespace infinity {
 
@@ -53,6 +59,7 @@ public:
     using Distance = std::conditional_t<LSG, PlainCosLSGDist<DataType>, PlainCosDist<DataType>>;
 
     static constexpr bool HasOptimize = false;
+    static constexpr bool HasTrain = false;
 
     template <typename CompressType>
     static constexpr LVQCosVecStoreType<DataType, CompressType> ToLVQ() {
@@ -75,6 +82,7 @@ public:
     using Distance = std::conditional_t<LSG, PlainL2LSGDist<DataType>, PlainL2Dist<DataType>>;
 
     static constexpr bool HasOptimize = false;
+    static constexpr bool HasTrain = false;
 
     template <typename CompressType>
     static constexpr LVQL2VecStoreType<DataType, CompressType> ToLVQ() {
@@ -97,6 +105,7 @@ public:
     using Distance = std::conditional_t<LSG, PlainIPLSGDist<DataType>, PlainIPDist<DataType>>;
 
     static constexpr bool HasOptimize = false;
+    static constexpr bool HasTrain = false;
 
     template <typename CompressType>
     static constexpr LVQIPVecStoreType<DataType, CompressType> ToLVQ() {
@@ -104,6 +113,30 @@ public:
     }
 };
 
+// Bit vectors packed into bytes, searched by hamming distance.
+export template <typename DataT>
+class PlainHammingVecStoreType {
+public:
+    using DataType = DataT;
+    using CompressType = void;
+    template <bool OwnMem>
+    using Meta = PlainVecStoreMeta<DataType>;
+    template <bool OwnMem>
+    using Inner = PlainVecStoreInner<DataType, OwnMem>;
+    using QueryVecType = const DataType *;
+    using StoreType = typename Meta<true>::StoreType;
+    using QueryType = typename Meta<true>::QueryType;
+    using Distance = PlainHammingDist<DataType>;
+
+    static constexpr bool HasOptimize = false;
+    static constexpr bool HasTrain = false;
+
+    template <typename CompressType>
+    static constexpr PlainHammingVecStoreType<DataType> ToLVQ() {
+        return {};
+    }
+};
+
 export template <typename DataT, typename IndexT>
 class SparseIPVecStoreType {
 public:
@@ -119,6 +152,7 @@ public:
     using Distance = SparseIPDist<DataT, IndexT>;
 
     static constexpr bool HasOptimize = false;
+    static constexpr bool HasTrain = false;
 
     template <typename CompressType>
     static constexpr SparseIPVecStoreType<DataType, IndexT> ToLVQ() {
@@ -142,6 +176,7 @@ public:
     using Distance = LVQCosDist<DataType, CompressType>;
 
     static constexpr bool HasOptimize = true;
+    static constexpr bool HasTrain = false;
 
     template <typename CompressType>
     static constexpr LVQCosVecStoreType<DataType, CompressType> ToLVQ() {
@@ -165,6 +200,7 @@ public:
     using Distance = LVQL2Dist<DataType, CompressType>;
 
     static constexpr bool HasOptimize = true;
+    static constexpr bool HasTrain = false;
 
     template <typename CompressType>
     static constexpr LVQL2VecStoreType<DataType, CompressType> ToLVQ() {
@@ -188,6 +224,7 @@ public:
     using Distance = LVQIPDist<DataType, CompressType>;
 
     static constexpr bool HasOptimize = true;
+    static constexpr bool HasTrain = false;
 
     template <typename CompressType>
     static constexpr LVQIPVecStoreType<DataType, CompressType> ToLVQ() {
@@ -195,4 +232,51 @@ public:
     }
 };
 
+// The codebooks of PQ and the centroid of RaBitQ are trained by the first vectors added.
+export template <typename DataT, QuantMetric Metric>
+class PQVecStoreType {
+public:
+    using DataType = DataT;
+    using CompressType = void;
+    template <bool OwnMem>
+    using Meta = PQVecStoreMeta<DataType, Metric, OwnMem>;
+    template <bool OwnMem>
+    using Inner = PQVecStoreInner<DataType, Metric, OwnMem>;
+    using QueryVecType = const DataType *;
+    using StoreType = typename Meta<true>::StoreType;
+    using QueryType = typename Meta<true>::QueryType;
+    using Distance = PQDist<DataType, Metric>;
+
+    static constexpr bool HasOptimize = false;
+    static constexpr bool HasTrain = true;
+
+    template <typename CompressType>
+    static constexpr PQVecStoreType<DataType, Metric> ToLVQ() {
+        return {};
+    }
+};
+
+export template <typename DataT, QuantMetric Metric>
+class RaBitQVecStoreType {
+public:
+    using DataType = DataT;
+    using CompressType = void;
+    template <bool OwnMem>
+    using Meta = RaBitQVecStoreMeta<DataType, Metric, OwnMem>;
+    template <bool OwnMem>
+    using Inner = RaBitQVecStoreInner<DataType, Metric, OwnMem>;
+    using QueryVecType = const DataType *;
+    using StoreType = typename Meta<true>::StoreType;
+    using QueryType = typename Meta<true>::QueryType;
+    using Distance = RaBitQDist<DataType, Metric>;
+
+    static constexpr bool HasOptimize = false;
+    static constexpr bool HasTrain = true;
+
+    template <typename CompressType>
+    static constexpr RaBitQVecStoreType<DataType, Metric> ToLVQ() {
+        return {};
+    }
+};
+
 } // namespace infinity
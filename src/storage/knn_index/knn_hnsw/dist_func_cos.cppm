@@ -23,6 +23,7 @@ import hnsw_common;
 import plain_vec_store;
 import lvq_vec_store;
 import simd_functions;
+import internal_types;
 
 export module dist_func_cos;
 
@@ -66,6 +67,10 @@ public:
             SIMDFunc = GetSIMD_FUNCTIONS().HNSW_U8Cos_ptr_;
         } else if constexpr (std::is_same<DataType, i8>()) {
             SIMDFunc = GetSIMD_FUNCTIONS().HNSW_I8Cos_ptr_;
+        } else if constexpr (std::is_same<DataType, Float16T>()) {
+            SIMDFunc = GetSIMD_FUNCTIONS().HNSW_F16Cos_ptr_;
+        } else if constexpr (std::is_same<DataType, BFloat16T>()) {
+            SIMDFunc = GetSIMD_FUNCTIONS().HNSW_BF16Cos_ptr_;
         }
     }
 
@@ -0,0 +1,64 @@
+// Copyright(C) 2024 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+module;
+
+export module dist_func_hamming;
+
+import stl;
+import hnsw_common;
+import plain_vec_store;
+import simd_functions;
+import simd_init;
+
+namespace infinity {
+
+// The bits are stored packed, the dimension of the store is the byte count of a vector.
+export template <typename DataType>
+class PlainHammingDist {
+public:
+    using VecStoreMeta = PlainVecStoreMeta<DataType>;
+    using StoreType = typename VecStoreMeta::StoreType;
+    using DistanceType = typename VecStoreMeta::DistanceType;
+
+private:
+    static_assert(std::is_same_v<DataType, u8>);
+
+    U8HammingDistanceFuncType SIMDFunc = nullptr;
+
+public:
+    PlainHammingDist() = default;
+    PlainHammingDist(PlainHammingDist &&other) : SIMDFunc(std::exchange(other.SIMDFunc, nullptr)) {}
+    PlainHammingDist &operator=(PlainHammingDist &&other) {
+        if (this != &other) {
+            SIMDFunc = std::exchange(other.SIMDFunc, nullptr);
+        }
+        return *this;
+    }
+    ~PlainHammingDist() = default;
+
+    PlainHammingDist(SizeT dim) : SIMDFunc(GetSIMD_FUNCTIONS().HammingDistance_func_ptr_) {}
+
+    template <typename DataStore>
+    DistanceType operator()(VertexType v1_i, VertexType v2_i, const DataStore &data_store) const {
+        return SIMDFunc(data_store.GetVec(v1_i), data_store.GetVec(v2_i), data_store.dim());
+    }
+
+    template <typename DataStore>
+    DistanceType operator()(const StoreType &v1, VertexType v2_i, const DataStore &data_store, VertexType v1_i = kInvalidVertex) const {
+        return SIMDFunc(v1, data_store.GetVec(v2_i), data_store.dim());
+    }
+};
+
+} // namespace infinity
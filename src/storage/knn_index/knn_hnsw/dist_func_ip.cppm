@@ -21,6 +21,7 @@ import hnsw_common;
 import plain_vec_store;
 import lvq_vec_store;
 import simd_functions;
+import internal_types;
 
 export module dist_func_ip;
 
@@ -38,7 +39,7 @@ public:
     using LVQDist = LVQIPDist<DataType, i8>;
 
 private:
-    using SIMDFuncType = std::conditional_t<std::is_same_v<DataType, float>, f32, i32> (*)(const DataType *, const DataType *, SizeT);
+    using SIMDFuncType = std::conditional_t<std::is_integral_v<DataType>, i32, f32> (*)(const DataType *, const DataType *, SizeT);
 
     SIMDFuncType SIMDFunc = nullptr;
 
@@ -79,6 +80,10 @@ public:
             } else {
                 SIMDFunc = GetSIMD_FUNCTIONS().HNSW_U8IP_ptr_;
             }
+        } else if constexpr (std::is_same<DataType, Float16T>()) {
+            SIMDFunc = GetSIMD_FUNCTIONS().HNSW_F16IP_ptr_;
+        } else if constexpr (std::is_same<DataType, BFloat16T>()) {
+            SIMDFunc = GetSIMD_FUNCTIONS().HNSW_BF16IP_ptr_;
         }
     }
 
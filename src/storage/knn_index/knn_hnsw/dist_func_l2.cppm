@@ -21,6 +21,7 @@ import hnsw_common;
 import plain_vec_store;
 import lvq_vec_store;
 import simd_functions;
+import internal_types;
 
 export module dist_func_l2;
 
@@ -41,7 +42,7 @@ public:
     using LVQDist = LVQL2Dist<DataType, i8>;
 
 private:
-    using SIMDFuncType = std::conditional_t<std::is_same_v<DataType, float>, f32, i32> (*)(const DataType *, const DataType *, SizeT);
+    using SIMDFuncType = std::conditional_t<std::is_integral_v<DataType>, i32, f32> (*)(const DataType *, const DataType *, SizeT);
 
     SIMDFuncType SIMDFunc = nullptr;
 
@@ -83,6 +84,10 @@ public:
             } else {
                 SIMDFunc = GetSIMD_FUNCTIONS().HNSW_U8L2_ptr_;
             }
+        } else if constexpr (std::is_same<DataType, Float16T>()) {
+            SIMDFunc = GetSIMD_FUNCTIONS().HNSW_F16L2_ptr_;
+        } else if constexpr (std::is_same<DataType, BFloat16T>()) {
+            SIMDFunc = GetSIMD_FUNCTIONS().HNSW_BF16L2_ptr_;
         }
     }
 
@@ -0,0 +1,71 @@
+// Copyright(C) 2024 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+module;
+
+export module dist_func_pq;
+
+import stl;
+import hnsw_common;
+import pq_vec_store;
+import simd_functions;
+import simd_init;
+
+namespace infinity {
+
+// Asymmetric distance of a query by its table lookups, symmetric distance of two stored vectors by their centroids.
+export template <typename DataType, QuantMetric Metric>
+class PQDist {
+public:
+    using VecStoreMeta = PQVecStoreMeta<DataType, Metric, true>;
+    using StoreType = typename VecStoreMeta::StoreType;
+    using DistanceType = typename VecStoreMeta::DistanceType;
+
+private:
+    PQADCFuncType ADCFunc = nullptr;
+
+public:
+    PQDist() = default;
+    PQDist(PQDist &&other) : ADCFunc(std::exchange(other.ADCFunc, nullptr)) {}
+    PQDist &operator=(PQDist &&other) {
+        if (this != &other) {
+            ADCFunc = std::exchange(other.ADCFunc, nullptr);
+        }
+        return *this;
+    }
+    ~PQDist() = default;
+
+    PQDist(SizeT dim) : ADCFunc(GetSIMD_FUNCTIONS().PQADC_func_ptr_) {}
+
+    template <typename DataStore>
+    DistanceType operator()(VertexType v1_i, VertexType v2_i, const DataStore &data_store) const {
+        return Inner(data_store.GetVec(v1_i), data_store.GetVec(v2_i), data_store.vec_store_meta());
+    }
+
+    template <typename DataStore>
+    DistanceType operator()(const StoreType &v1, VertexType v2_i, const DataStore &data_store, VertexType v1_i = kInvalidVertex) const {
+        return Inner(v1, data_store.GetVec(v2_i), data_store.vec_store_meta());
+    }
+
+private:
+    template <typename Meta>
+    DistanceType Inner(const StoreType &v1, const StoreType &v2, const Meta &meta) const {
+        if (v1.table_ != nullptr) {
+            return ADCFunc(v1.table_, v2.code_, meta.subspace_num());
+        }
+        return meta.SymmetricDistance(v1.code_, v2.code_);
+    }
+};
+
+} // namespace infinity
@@ -0,0 +1,72 @@
+// Copyright(C) 2024 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+module;
+
+export module dist_func_rabitq;
+
+import stl;
+import hnsw_common;
+import rabitq_vec_store;
+import simd_functions;
+import simd_init;
+
+namespace infinity {
+
+// Estimated distance of a query by the popcounts of its bit planes, symmetric distance of two stored vectors by their hamming distance.
+export template <typename DataType, QuantMetric Metric>
+class RaBitQDist {
+public:
+    using VecStoreMeta = RaBitQVecStoreMeta<DataType, Metric, true>;
+    using StoreType = typename VecStoreMeta::StoreType;
+    using DistanceType = typename VecStoreMeta::DistanceType;
+
+private:
+    BinaryPlaneIPFuncType PlaneIPFunc = nullptr;
+
+public:
+    RaBitQDist() = default;
+    RaBitQDist(RaBitQDist &&other) : PlaneIPFunc(std::exchange(other.PlaneIPFunc, nullptr)) {}
+    RaBitQDist &operator=(RaBitQDist &&other) {
+        if (this != &other) {
+            PlaneIPFunc = std::exchange(other.PlaneIPFunc, nullptr);
+        }
+        return *this;
+    }
+    ~RaBitQDist() = default;
+
+    RaBitQDist(SizeT dim) : PlaneIPFunc(GetSIMD_FUNCTIONS().BinaryPlaneIP_func_ptr_) {}
+
+    template <typename DataStore>
+    DistanceType operator()(VertexType v1_i, VertexType v2_i, const DataStore &data_store) const {
+        return Inner(data_store.GetVec(v1_i), data_store.GetVec(v2_i), data_store.vec_store_meta());
+    }
+
+    template <typename DataStore>
+    DistanceType operator()(const StoreType &v1, VertexType v2_i, const DataStore &data_store, VertexType v1_i = kInvalidVertex) const {
+        return Inner(v1, data_store.GetVec(v2_i), data_store.vec_store_meta());
+    }
+
+private:
+    template <typename Meta>
+    DistanceType Inner(const StoreType &v1, const StoreType &v2, const Meta &meta) const {
+        if (v1.query_ != nullptr) {
+            u32 plane_ip = PlaneIPFunc(v2.data_->code_, v1.query_->planes_.data(), meta.word_n());
+            return meta.EstimateDistance(v2.data_, v1.query_, plane_ip);
+        }
+        return meta.SymmetricDistance(v1.data_, v2.data_);
+    }
+};
+
+} // namespace infinity
@@ -14,6 +14,7 @@
 
 module;
 
+#include <algorithm>
 #include <ostream>
 #include <random>
 
@@ -30,6 +31,7 @@ import data_store;
 import third_party;
 import serialize;
 import dist_func_lsg_wrapper;
+import visited_list;
 
 // Fixme: some variable has implicit type conversion.
 // Fixme: some variable has confusing name.
@@ -43,12 +45,30 @@ namespace infinity {
 export struct KnnSearchOption {
     SizeT ef_ = 0;
     LogicalType column_logical_type_ = LogicalType::kEmbedding;
+    // the tombstones marked at or before it are skipped, the deletes they record are visible to the searching transaction
+    TxnTimeStamp begin_ts_ = 0;
+};
+
+// The vertices whose rows are deleted at `ts_`, one bit each.
+export struct HnswTombstones {
+    TxnTimeStamp ts_ = 0;
+    SizeT deleted_n_ = 0;
+    Vector<u64> bits_;
+
+    bool IsDeleted(VertexType vertex_i) const {
+        const SizeT word_i = vertex_i / 64;
+        return word_i < bits_.size() && ((bits_[word_i] >> (vertex_i % 64)) & 1);
+    }
 };
 
 export template <typename VecStoreType, typename LabelType, bool OwnMem>
 class KnnHnswBase {
+    template <typename, typename, bool>
+    friend class KnnHnswBase;
+
 public:
     using This = KnnHnswBase<VecStoreType, LabelType, OwnMem>;
+    using VecStore = VecStoreType;
     using DataType = typename VecStoreType::DataType;
     using QueryVecType = typename VecStoreType::QueryVecType;
     using StoreType = typename VecStoreType::StoreType;
@@ -66,6 +86,8 @@ public:
 
     constexpr static int prefetch_offset_ = 0;
     constexpr static int prefetch_step_ = 2;
+    // queries whose graph walks are interleaved in the batch search
+    constexpr static SizeT batch_group_size_ = 16;
 
     static Pair<SizeT, SizeT> GetMmax(SizeT M) { return {2 * M, M}; }
 
@@ -73,7 +95,7 @@ public:
     KnnHnswBase() : M_(0), ef_construction_(0), mult_(0) {}
     KnnHnswBase(This &&other)
         : M_(std::exchange(other.M_, 0)), ef_construction_(std::exchange(other.ef_construction_, 0)), mult_(std::exchange(other.mult_, 0.0)),
-          data_store_(std::move(other.data_store_)), distance_(std::move(other.distance_)) {}
+          data_store_(std::move(other.data_store_)), distance_(std::move(other.distance_)), tombstones_(std::move(other.tombstones_)) {}
     This &operator=(This &&other) {
         if (this != &other) {
             M_ = std::exchange(other.M_, 0);
@@ -81,6 +103,7 @@ public:
             mult_ = std::exchange(other.mult_, 0.0);
             data_store_ = std::move(other.data_store_);
             distance_ = std::move(other.distance_);
+            tombstones_ = std::move(other.tombstones_);
         }
         return *this;
     }
@@ -118,7 +141,13 @@ protected:
               LogicalType ColumnLogicalType = LogicalType::kEmbedding,
               typename MultiVectorInnerTopnIndexType = void>
     Tuple<SizeT, UniquePtr<DistanceType[]>, UniquePtr<SearchLayerReturnParam3T<ColumnLogicalType>[]>>
-    SearchLayer(VertexType enter_point, const StoreType &query, VertexType query_i, i32 layer_idx, SizeT result_n, const Filter &filter) const {
+    SearchLayer(VertexType enter_point,
+                const StoreType &query,
+                VertexType query_i,
+                i32 layer_idx,
+                SizeT result_n,
+                const Filter &filter,
+                const HnswTombstones *tombstones = nullptr) const {
         static_assert(ColumnLogicalType == LogicalType::kEmbedding || ColumnLogicalType == LogicalType::kMultiVector);
         auto d_ptr = MakeUniqueForOverwrite<DistanceType[]>(result_n);
         auto i_ptr = MakeUniqueForOverwrite<SearchLayerReturnParam3T<ColumnLogicalType>[]>(result_n);
@@ -127,7 +156,11 @@ protected:
                                                  MultiVectorResultHandler<DistanceType, LabelType, MultiVectorInnerTopnIndexType>>;
         ResultHandler result_handler(1, result_n, d_ptr.get(), i_ptr.get());
         result_handler.Begin();
+        // the tombstones are still walked through, they only stay out of the result
         auto add_result = [&](DistanceType add_dist, VertexType add_v) {
+            if (tombstones != nullptr && tombstones->IsDeleted(add_v)) {
+                return;
+            }
             if constexpr (ColumnLogicalType == LogicalType::kEmbedding) {
                 if constexpr (!std::is_same_v<Filter, NoneType>) {
                     if (filter(this->GetLabel(add_v))) {
@@ -293,18 +326,23 @@ protected:
     LabelType GetLabel(VertexType vertex_i) const { return data_store_.GetLabel(vertex_i); }
 
     template <bool WithLock, FilterConcept<LabelType> Filter, LogicalType ColumnLogicalType>
-    auto SearchLayerHelper(VertexType enter_point, const StoreType &query, i32 layer_idx, SizeT result_n, const Filter &filter) const {
+    auto SearchLayerHelper(VertexType enter_point,
+                           const StoreType &query,
+                           i32 layer_idx,
+                           SizeT result_n,
+                           const Filter &filter,
+                           const HnswTombstones *tombstones) const {
         if constexpr (ColumnLogicalType == LogicalType::kEmbedding) {
-            return SearchLayer<WithLock, Filter, ColumnLogicalType>(enter_point, query, kInvalidVertex, layer_idx, result_n, filter);
+            return SearchLayer<WithLock, Filter, ColumnLogicalType>(enter_point, query, kInvalidVertex, layer_idx, result_n, filter, tombstones);
         } else if constexpr (ColumnLogicalType == LogicalType::kMultiVector) {
             if (result_n <= std::numeric_limits<u8>::max()) {
-                return SearchLayer<WithLock, Filter, ColumnLogicalType, u8>(enter_point, query, kInvalidVertex, layer_idx, result_n, filter);
+                return SearchLayer<WithLock, Filter, ColumnLogicalType, u8>(enter_point, query, kInvalidVertex, layer_idx, result_n, filter, tombstones);
             }
             if (result_n <= std::numeric_limits<u16>::max()) {
-                return SearchLayer<WithLock, Filter, ColumnLogicalType, u16>(enter_point, query, kInvalidVertex, layer_idx, result_n, filter);
+                return SearchLayer<WithLock, Filter, ColumnLogicalType, u16>(enter_point, query, kInvalidVertex, layer_idx, result_n, filter, tombstones);
             }
             if (result_n <= std::numeric_limits<u32>::max()) {
-                return SearchLayer<WithLock, Filter, ColumnLogicalType, u32>(enter_point, query, kInvalidVertex, layer_idx, result_n, filter);
+                return SearchLayer<WithLock, Filter, ColumnLogicalType, u32>(enter_point, query, kInvalidVertex, layer_idx, result_n, filter, tombstones);
             }
             UnrecoverableError(fmt::format("Unsupported result_n : {}, which is larger than u32::max()", result_n));
             return Tuple<SizeT, UniquePtr<DistanceType[]>, UniquePtr<SearchLayerReturnParam3T<ColumnLogicalType>[]>>{};
@@ -328,7 +366,16 @@ protected:
         for (i32 cur_layer = max_layer; cur_layer > 0; --cur_layer) {
             ep = SearchLayerNearest<WithLock>(ep, query, kInvalidVertex, cur_layer);
         }
-        return SearchLayerHelper<WithLock, Filter, ColumnLogicalType>(ep, query, 0, ef, filter);
+        SharedPtr<const HnswTombstones> tombstones = GetTombstones(option.begin_ts_);
+        return SearchLayerHelper<WithLock, Filter, ColumnLogicalType>(ep, query, 0, ef, filter, tombstones.get());
+    }
+
+    SharedPtr<const HnswTombstones> GetTombstones(TxnTimeStamp begin_ts) const {
+        std::lock_guard lock(tombstones_mtx_);
+        if (tombstones_.get() == nullptr || tombstones_->ts_ > begin_ts) {
+            return nullptr;
+        }
+        return tombstones_;
     }
 
 public:
@@ -378,6 +425,100 @@ public:
         }
     }
 
+    // Copy the graph of `src` into this empty index. A vertex is kept if `label_map` gives it a new label, the kept vertices keep
+    // their order and layers. A neighbor list that lost some vertices is selected again from the remaining neighbors and the
+    // neighbors of the dropped ones. Return the number of the kept vertices, or None if the stored vectors can not be copied.
+    template <bool SrcOwnMem, typename LabelMap>
+    Optional<SizeT> MergeGraph(const KnnHnswBase<VecStoreType, LabelType, SrcOwnMem> &src, LabelMap &&label_map) {
+        if constexpr (!std::is_same_v<StoreType, QueryVecType>) {
+            return None;
+        } else {
+            if (data_store_.cur_vec_num() != 0) {
+                UnrecoverableError("Merge hnsw graph into a non-empty index.");
+            }
+            const auto &src_store = src.data_store_;
+            const SizeT src_n = src_store.cur_vec_num();
+            Vector<VertexType> vertex_map(src_n, kInvalidVertex);
+            Vector<Pair<VertexType, LabelType>> kept;
+            for (SizeT i = 0; i < src_n; ++i) {
+                if (Optional<LabelType> new_label = label_map(src_store.GetLabel(i)); new_label.has_value()) {
+                    vertex_map[i] = kept.size();
+                    kept.emplace_back(i, *new_label);
+                }
+            }
+            if (kept.empty()) {
+                return 0;
+            }
+
+            struct KeptIter {
+                using ValueType = QueryVecType;
+                const std::decay_t<decltype(src_store)> *store_;
+                const Vector<Pair<VertexType, LabelType>> *kept_;
+                SizeT idx_ = 0;
+
+                Optional<Pair<QueryVecType, LabelType>> Next() {
+                    if (idx_ == kept_->size()) {
+                        return None;
+                    }
+                    const auto &[old_i, label] = (*kept_)[idx_++];
+                    return std::make_pair(store_->GetVec(old_i), label);
+                }
+            };
+            data_store_.AddVec(KeptIter{&src_store, &kept});
+
+            for (SizeT new_i = 0; new_i < kept.size(); ++new_i) {
+                data_store_.AddVertex(new_i, src_store.GetLayerN(kept[new_i].first));
+            }
+            if (auto [max_layer, ep] = src_store.GetEnterPoint(); ep != kInvalidVertex && vertex_map[ep] != kInvalidVertex) {
+                data_store_.TryUpdateEnterPoint(max_layer, vertex_map[ep]);
+            }
+            for (SizeT new_i = 0; new_i < kept.size(); ++new_i) {
+                data_store_.TryUpdateEnterPoint(data_store_.GetLayerN(new_i), new_i);
+            }
+
+            Vector<VertexType> repair_candidates;
+            for (SizeT new_i = 0; new_i < kept.size(); ++new_i) {
+                const VertexType old_i = kept[new_i].first;
+                const i32 layer_n = src_store.GetLayerN(old_i);
+                for (i32 layer_i = 0; layer_i <= layer_n; ++layer_i) {
+                    const auto [src_neighbors_p, src_neighbor_n] = src_store.GetNeighbors(old_i, layer_i);
+                    auto [neighbors_p, neighbor_n_p] = data_store_.GetNeighborsMut(new_i, layer_i);
+                    VertexListSize neighbor_n = 0;
+                    repair_candidates.clear();
+                    for (VertexListSize j = 0; j < src_neighbor_n; ++j) {
+                        if (VertexType n_idx = vertex_map[src_neighbors_p[j]]; n_idx != kInvalidVertex) {
+                            neighbors_p[neighbor_n++] = n_idx;
+                            continue;
+                        }
+                        const auto [dropped_neighbors_p, dropped_neighbor_n] = src_store.GetNeighbors(src_neighbors_p[j], layer_i);
+                        for (VertexListSize k = 0; k < dropped_neighbor_n; ++k) {
+                            if (VertexType n_idx = vertex_map[dropped_neighbors_p[k]]; n_idx != kInvalidVertex && n_idx != VertexType(new_i)) {
+                                repair_candidates.push_back(n_idx);
+                            }
+                        }
+                    }
+                    *neighbor_n_p = neighbor_n;
+                    if (neighbor_n == src_neighbor_n) {
+                        continue;
+                    }
+                    repair_candidates.insert(repair_candidates.end(), neighbors_p, neighbors_p + neighbor_n);
+                    std::sort(repair_candidates.begin(), repair_candidates.end());
+                    repair_candidates.erase(std::unique(repair_candidates.begin(), repair_candidates.end()), repair_candidates.end());
+
+                    StoreType data = data_store_.GetVec(new_i);
+                    Vector<PDV> candidates;
+                    candidates.reserve(repair_candidates.size());
+                    for (VertexType n_idx : repair_candidates) {
+                        candidates.emplace_back(distance_(data, n_idx, data_store_, new_i), n_idx);
+                    }
+                    SizeT Mmax = layer_i == 0 ? data_store_.Mmax0() : data_store_.Mmax();
+                    SelectNeighborsHeuristic(std::move(candidates), Mmax, neighbors_p, neighbor_n_p);
+                }
+            }
+            return kept.size();
+        }
+    }
+
     template <FilterConcept<LabelType> Filter = NoneType, bool WithLock = true>
     Tuple<SizeT, UniquePtr<DistanceType[]>, UniquePtr<LabelType[]>>
     KnnSearch(const QueryVecType &q, SizeT k, const Filter &filter, const KnnSearchOption &option = {}) const {
@@ -406,6 +547,155 @@ public:
         return KnnSearch<NoneType, WithLock>(q, k, None, option);
     }
 
+    // Search `query_n` embedding queries, the result of each is the same as `KnnSearch`.
+    // The layer 0 walks of a group of queries advance in turn, one candidate at a time. Before a query expands its candidate,
+    // the candidate and the neighbors of the next query are prefetched, so the memory latency is hidden behind the distance computation.
+    // The visited lists come from the shared pool and the candidate heaps are reused by the groups.
+    template <FilterConcept<LabelType> Filter = NoneType, bool WithLock = true>
+    Vector<Tuple<SizeT, UniquePtr<DistanceType[]>, UniquePtr<LabelType[]>>>
+    KnnSearchBatch(const QueryVecType *queries, SizeT query_n, SizeT k, const Filter &filter, const KnnSearchOption &option = {}) const {
+        if (option.column_logical_type_ != LogicalType::kEmbedding) {
+            UnrecoverableError(fmt::format("Unsupported column logical type of batch search: {}", LogicalType2Str(option.column_logical_type_)));
+        }
+        Vector<Tuple<SizeT, UniquePtr<DistanceType[]>, UniquePtr<LabelType[]>>> results(query_n);
+        const SizeT ef = option.ef_ == 0 ? k : option.ef_;
+        auto [max_layer, enter_point] = data_store_.GetEnterPoint();
+        if (enter_point == -1 || query_n == 0) {
+            return results;
+        }
+
+        const SizeT group_size = std::min(query_n, batch_group_size_);
+        auto d_buf = MakeUniqueForOverwrite<DistanceType[]>(group_size * ef);
+        auto v_buf = MakeUniqueForOverwrite<VertexType[]>(group_size * ef);
+        HeapResultHandler<CompareMax<DistanceType, VertexType>> result_handler(group_size, ef, d_buf.get(), v_buf.get());
+        Vector<QueryType> group_queries;
+        group_queries.reserve(group_size);
+        Vector<Vector<PDV>> candidates(group_size);
+        Vector<UniquePtr<VisitedList>> visited_lists(group_size);
+        Vector<SizeT> active;
+        active.reserve(group_size);
+
+        SharedPtr<const HnswTombstones> tombstones = GetTombstones(option.begin_ts_);
+        auto add_result = [&](SizeT qi, DistanceType dist, VertexType v) {
+            if (tombstones.get() != nullptr && tombstones->IsDeleted(v)) {
+                return;
+            }
+            if constexpr (!std::is_same_v<Filter, NoneType>) {
+                if (!filter(this->GetLabel(v))) {
+                    return;
+                }
+            }
+            result_handler.AddResult(qi, dist, v);
+        };
+        auto prefetch_next = [&](SizeT qi) {
+            const auto &candidate = candidates[qi];
+            if (!candidate.empty()) {
+                VertexType c_idx = candidate.front().second;
+                data_store_.PrefetchNeighbors(c_idx);
+            }
+        };
+        // return false if the walk of the query ends
+        auto expand = [&](SizeT qi, SizeT cur_vec_num) {
+            auto &candidate = candidates[qi];
+            if (candidate.empty()) {
+                return false;
+            }
+            std::pop_heap(candidate.begin(), candidate.end(), CMP());
+            const auto [minus_c_dist, c_idx] = candidate.back();
+            candidate.pop_back();
+            if (result_handler.GetSize(qi) == ef && -minus_c_dist > result_handler.GetDistance0(qi)) {
+                return false;
+            }
+
+            std::shared_lock<std::shared_mutex> lock;
+            if constexpr (WithLock && OwnMem) {
+                lock = data_store_.SharedLock(c_idx);
+            }
+
+            const auto [neighbors_p, neighbor_size] = data_store_.GetNeighbors(c_idx, 0);
+            for (int i = neighbor_size - 1; i >= 0; --i) {
+                if (VertexType n_idx = neighbors_p[i]; n_idx < (VertexType)cur_vec_num) {
+                    data_store_.PrefetchVec(n_idx);
+                }
+            }
+            VisitedList &visited = *visited_lists[qi];
+            for (int i = neighbor_size - 1; i >= 0; --i) {
+                VertexType n_idx = neighbors_p[i];
+                if (n_idx >= (VertexType)cur_vec_num || !visited.Visit(n_idx)) {
+                    continue;
+                }
+                auto dist = distance_(group_queries[qi], n_idx, data_store_, kInvalidVertex);
+                if (result_handler.GetSize(qi) < ef || dist <= result_handler.GetDistance0(qi)) {
+                    candidate.emplace_back(-dist, n_idx);
+                    std::push_heap(candidate.begin(), candidate.end(), CMP());
+                    add_result(qi, dist, n_idx);
+                }
+            }
+            return true;
+        };
+
+        auto &visited_list_pool = VisitedListPool::instance();
+        for (SizeT group_begin = 0; group_begin < query_n; group_begin += group_size) {
+            const SizeT group_n = std::min(group_size, query_n - group_begin);
+            const SizeT cur_vec_num = data_store_.cur_vec_num();
+            result_handler.ReInitialize();
+            group_queries.clear();
+            active.clear();
+            for (SizeT qi = 0; qi < group_n; ++qi) {
+                group_queries.push_back(data_store_.MakeQuery(queries[group_begin + qi]));
+                VertexType ep = enter_point;
+                for (i32 cur_layer = max_layer; cur_layer > 0; --cur_layer) {
+                    ep = SearchLayerNearest<WithLock>(ep, group_queries[qi], kInvalidVertex, cur_layer);
+                }
+                if (!visited_lists[qi]) {
+                    visited_lists[qi] = visited_list_pool.Acquire(cur_vec_num);
+                } else {
+                    visited_lists[qi]->Reset(cur_vec_num);
+                }
+                visited_lists[qi]->Visit(ep);
+                auto dist = distance_(group_queries[qi], ep, data_store_, kInvalidVertex);
+                candidates[qi].clear();
+                candidates[qi].emplace_back(-dist, ep);
+                add_result(qi, dist, ep);
+                active.push_back(qi);
+            }
+            while (!active.empty()) {
+                for (SizeT i = 0; i < active.size();) {
+                    prefetch_next(active[(i + 1) % active.size()]);
+                    if (expand(active[i], cur_vec_num)) {
+                        ++i;
+                    } else {
+                        active[i] = active.back();
+                        active.pop_back();
+                    }
+                }
+            }
+            result_handler.EndWithoutSort();
+            for (SizeT qi = 0; qi < group_n; ++qi) {
+                const SizeT result_n = result_handler.GetSize(qi);
+                auto d_ptr = MakeUniqueForOverwrite<DistanceType[]>(result_n);
+                auto l_ptr = MakeUniqueForOverwrite<LabelType[]>(result_n);
+                for (SizeT i = 0; i < result_n; ++i) {
+                    d_ptr[i] = d_buf[qi * ef + i];
+                    l_ptr[i] = GetLabel(v_buf[qi * ef + i]);
+                }
+                results[group_begin + qi] = {result_n, std::move(d_ptr), std::move(l_ptr)};
+            }
+        }
+        for (auto &visited_list : visited_lists) {
+            if (visited_list) {
+                visited_list_pool.Release(std::move(visited_list));
+            }
+        }
+        return results;
+    }
+
+    template <bool WithLock = true>
+    Vector<Tuple<SizeT, UniquePtr<DistanceType[]>, UniquePtr<LabelType[]>>>
+    KnnSearchBatch(const QueryVecType *queries, SizeT query_n, SizeT k, const KnnSearchOption &option = {}) const {
+        return KnnSearchBatch<NoneType, WithLock>(queries, query_n, k, None, option);
+    }
+
     // function for test, add sort for convenience
     template <FilterConcept<LabelType> Filter = NoneType, bool WithLock = true>
     Vector<Pair<DistanceType, LabelType>>
@@ -426,6 +716,35 @@ public:
 
     SizeT GetVecNum() const { return data_store_.cur_vec_num(); }
 
+    // Mark the vertices whose labels are deleted at `ts`, the searches of the transactions begin after it skip them.
+    // The marks are replaced as a whole, so a search reads them without holding the lock. Return the number of the marked vertices.
+    template <typename IsDeleted>
+    SizeT MarkDeleted(TxnTimeStamp ts, IsDeleted &&is_deleted) const {
+        const SizeT vertex_n = data_store_.cur_vec_num();
+        auto tombstones = MakeShared<HnswTombstones>();
+        tombstones->ts_ = ts;
+        tombstones->bits_.resize((vertex_n + 63) / 64, 0);
+        for (SizeT vertex_i = 0; vertex_i < vertex_n; ++vertex_i) {
+            if (is_deleted(GetLabel(vertex_i))) {
+                tombstones->bits_[vertex_i / 64] |= u64(1) << (vertex_i % 64);
+                ++tombstones->deleted_n_;
+            }
+        }
+        const SizeT deleted_n = tombstones->deleted_n_;
+        std::lock_guard lock(tombstones_mtx_);
+        if (deleted_n == 0) {
+            tombstones_.reset();
+        } else {
+            tombstones_ = std::move(tombstones);
+        }
+        return deleted_n;
+    }
+
+    SizeT GetDeletedNum() const {
+        std::lock_guard lock(tombstones_mtx_);
+        return tombstones_.get() == nullptr ? 0 : tombstones_->deleted_n_;
+    }
+
     SizeT mem_usage() const { return data_store_.mem_usage(); }
 
     Distance &distance() { return distance_; }
@@ -440,6 +759,10 @@ protected:
     DataStore data_store_;
     Distance distance_;
 
+    // marked in the background optimization, not saved
+    mutable std::mutex tombstones_mtx_;
+    mutable SharedPtr<const HnswTombstones> tombstones_;
+
     // //---------------------------------------------- Following is the tmp debug function. ----------------------------------------------
 public:
     void Check() const { data_store_.Check(); }
@@ -38,6 +38,13 @@ export using LayerSize = i32;
 
 export constexpr VertexType kInvalidVertex = -1;
 
+// metric of the PQ and RaBitQ encodings, the vectors of cosine are normalized before encoded
+export enum class QuantMetric : i8 {
+    kL2,
+    kIP,
+    kCos,
+};
+
 export template <typename Iterator, typename RtnType, typename LabelType>
 concept DataIteratorConcept = requires(Iterator iter) {
     typename std::decay_t<Iterator>::ValueType;
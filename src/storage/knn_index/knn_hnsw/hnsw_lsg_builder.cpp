@@ -362,7 +362,7 @@ UniquePtr<float[]> HnswLSGBuilder::GetAvgBF(Iter iter, SizeT row_count) {
     if constexpr (SplitIter<Iter>) {
         Iter iter_copy = iter;
         auto iters = std::move(iter_copy).split();
-        auto &thread_pool = InfinityContext::instance().GetHnswBuildThreadPool();
+        auto &thread_pool = InfinityContext::instance().GetVectorIndexBuildThreadPool();
         Vector<std::future<void>> futs;
         for (auto &splited_iter : iters) {
             futs.emplace_back(thread_pool.push([&](int id) {
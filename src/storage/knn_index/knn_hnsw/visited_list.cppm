@@ -0,0 +1,99 @@
+// Copyright(C) 2024 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+module;
+
+export module visited_list;
+
+import stl;
+import hnsw_common;
+
+namespace infinity {
+
+// Visited marks of one graph walk. A vertex is visited if its tag equals the current one,
+// so a new walk only bumps the tag instead of clearing the whole list.
+export class VisitedList {
+public:
+    // one byte per vertex, the list is cleared once every 255 walks
+    using TagType = u8;
+
+    void Reset(SizeT vertex_n) {
+        if (vertex_n > capacity_) {
+            capacity_ = std::max(vertex_n, capacity_ * 2);
+            tags_ = MakeUnique<TagType[]>(capacity_);
+            cur_tag_ = 0;
+        }
+        if (++cur_tag_ == 0) {
+            std::fill_n(tags_.get(), capacity_, 0);
+            cur_tag_ = 1;
+        }
+    }
+
+    // Return false if the vertex is already visited.
+    bool Visit(VertexType vertex_i) {
+        if (tags_[vertex_i] == cur_tag_) {
+            return false;
+        }
+        tags_[vertex_i] = cur_tag_;
+        return true;
+    }
+
+    SizeT capacity() const { return capacity_; }
+
+private:
+    UniquePtr<TagType[]> tags_{};
+    SizeT capacity_ = 0;
+    TagType cur_tag_ = 0;
+};
+
+// Visited lists shared by the searches of all the HNSW indexes, so a search doesn't allocate one of the size of the index.
+export class VisitedListPool {
+public:
+    static VisitedListPool &instance() {
+        static VisitedListPool pool;
+        return pool;
+    }
+
+    UniquePtr<VisitedList> Acquire(SizeT vertex_n) {
+        UniquePtr<VisitedList> visited_list;
+        {
+            std::lock_guard lock(mutex_);
+            if (!free_lists_.empty()) {
+                visited_list = std::move(free_lists_.back());
+                free_lists_.pop_back();
+            }
+        }
+        if (!visited_list) {
+            visited_list = MakeUnique<VisitedList>();
+        }
+        visited_list->Reset(vertex_n);
+        return visited_list;
+    }
+
+    void Release(UniquePtr<VisitedList> visited_list) {
+        std::lock_guard lock(mutex_);
+        if (free_lists_.size() < kMaxFreeListN) {
+            free_lists_.push_back(std::move(visited_list));
+        }
+    }
+
+private:
+    // bound the memory kept by the pool, the lists beyond are freed
+    static constexpr SizeT kMaxFreeListN = 64;
+
+    std::mutex mutex_;
+    Vector<UniquePtr<VisitedList>> free_lists_;
+};
+
+} // namespace infinity
@@ -84,7 +84,8 @@ void IVFIndexInChunk::BuildIVFIndex(const RowID base_rowid,
                                     const u32 row_count,
                                     const SegmentEntry *segment_entry,
                                     const SharedPtr<ColumnDef> &column_def,
-                                    BufferManager *buffer_mgr) {
+                                    BufferManager *buffer_mgr,
+                                    KMeansProgress *kmeans_progress) {
     if (segment_entry->segment_id() != base_rowid.segment_id_) {
         UnrecoverableError(std::format("{}: segment_id mismatch: segment_entry_id: {}, row_id_segment_id: {}.",
                                        __func__,
@@ -92,14 +93,18 @@ void IVFIndexInChunk::BuildIVFIndex(const RowID base_rowid,
                                        base_rowid.segment_id_));
     }
     IVFDataAccessor data_accessor(segment_entry, buffer_mgr, column_def->id());
-    BuildIVFIndex(base_rowid, row_count, &data_accessor, column_def);
+    BuildIVFIndex(base_rowid, row_count, &data_accessor, column_def, kmeans_progress);
 }
 
-void IVFIndexInChunk::BuildIVFIndex(RowID base_rowid, u32 row_count, IVFDataAccessorBase *data_accessor, const SharedPtr<ColumnDef> &column_def) {
+void IVFIndexInChunk::BuildIVFIndex(RowID base_rowid,
+                                    u32 row_count,
+                                    IVFDataAccessorBase *data_accessor,
+                                    const SharedPtr<ColumnDef> &column_def,
+                                    KMeansProgress *kmeans_progress) {
     auto Call = [&]<LogicalType column_t> {
         static_assert(column_t == LogicalType::kEmbedding || column_t == LogicalType::kMultiVector);
         auto CallT = [&]<EmbeddingDataType embedding_t> {
-            return BuildIVFIndexT<column_t, embedding_t>(base_rowid, row_count, data_accessor, column_def);
+            return BuildIVFIndexT<column_t, embedding_t>(base_rowid, row_count, data_accessor, column_def, kmeans_progress);
         };
         switch (static_cast<const EmbeddingInfo *>(column_def->type()->type_info().get())->Type()) {
             case EmbeddingDataType::kElemUInt8: {
@@ -120,6 +125,13 @@ void IVFIndexInChunk::BuildIVFIndex(RowID base_rowid, u32 row_count, IVFDataAcce
             case EmbeddingDataType::kElemBFloat16: {
                 return CallT.template operator()<EmbeddingDataType::kElemBFloat16>();
             }
+            case EmbeddingDataType::kElemBit: {
+                if constexpr (column_t == LogicalType::kEmbedding) {
+                    return CallT.template operator()<EmbeddingDataType::kElemBit>();
+                }
+                UnrecoverableError(std::format("Invalid embedding data type {} for IVF index", column_def->type()->ToString()));
+                break;
+            }
             default: {
                 UnrecoverableError(std::format("Invalid embedding data type {} for IVF index", column_def->type()->ToString()));
             }
@@ -142,7 +154,8 @@ template <LogicalType column_t, EmbeddingDataType embedding_t>
 void IVFIndexInChunk::BuildIVFIndexT(const RowID base_rowid,
                                      const u32 row_count,
                                      IVFDataAccessorBase *data_accessor,
-                                     const SharedPtr<ColumnDef> &column_def) {
+                                     const SharedPtr<ColumnDef> &column_def,
+                                     KMeansProgress *kmeans_progress) {
     if (row_count <= 0) [[unlikely]] {
         UnrecoverableError("Empty input row count");
     }
@@ -175,7 +188,11 @@ void IVFIndexInChunk::BuildIVFIndexT(const RowID base_rowid,
         UnrecoverableError(std::format("{}: centroid_count exceeds u32 limit!", __func__));
     }
     const auto training_embedding_num = std::min<u32>(centroid_count * ivf_option().centroid_option_.min_points_per_centroid_, embedding_count);
-    const auto training_data = MakeUniqueForOverwrite<f32[]>(training_embedding_num * embedding_dimension());
+    // bit embeddings are trained on their packed bytes
+    constexpr bool is_binary = embedding_t == EmbeddingDataType::kElemBit;
+    using TrainingElementT = std::conditional_t<is_binary, u8, f32>;
+    const u32 training_elem_num = is_binary ? embedding_dimension() / 8 : embedding_dimension();
+    const auto training_data = MakeUniqueForOverwrite<TrainingElementT[]>(training_embedding_num * training_elem_num);
     if constexpr (column_t == LogicalType::kEmbedding) {
         Vector<SegmentOffset> all_pos(row_count);
         std::iota(all_pos.begin(), all_pos.end(), start_segment_offset);
@@ -189,8 +206,8 @@ void IVFIndexInChunk::BuildIVFIndexT(const RowID base_rowid,
         for (u64 i = 0; i < training_embedding_num; ++i) {
             const auto sample_offset = sample_result[i];
             const auto *raw_data = reinterpret_cast<const EmbeddingElementT *>(data_accessor->GetEmbedding(sample_offset));
-            if constexpr (std::is_same_v<EmbeddingElementT, f32>) {
-                std::copy_n(raw_data, embedding_dimension(), training_data.get() + i * embedding_dimension());
+            if constexpr (std::is_same_v<EmbeddingElementT, TrainingElementT>) {
+                std::copy_n(raw_data, training_elem_num, training_data.get() + i * training_elem_num);
             } else {
                 const auto *src_ptr = raw_data;
                 auto *target_ptr = training_data.get() + i * embedding_dimension();
@@ -237,7 +254,11 @@ void IVFIndexInChunk::BuildIVFIndexT(const RowID base_rowid,
         static_assert(false);
     }
     // build centroids
-    Train(training_embedding_num, training_data.get(), centroid_count);
+    if constexpr (is_binary) {
+        TrainBinary(training_embedding_num, training_data.get(), centroid_count);
+    } else {
+        Train(training_embedding_num, training_data.get(), centroid_count, kmeans_progress);
+    }
     // add data
     {
         [[maybe_unused]] BlockID block_id = start_segment_offset / DEFAULT_BLOCK_CAPACITY;
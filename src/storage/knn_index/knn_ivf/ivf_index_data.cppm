@@ -25,6 +25,7 @@ import internal_types;
 import logical_type;
 import local_file_handle;
 import infinity_exception;
+import kmeans_partition;
 
 namespace infinity {
 
@@ -53,12 +54,14 @@ public:
                        u32 row_count,
                        const SegmentEntry *segment_entry,
                        const SharedPtr<ColumnDef> &column_def,
-                       BufferManager *buffer_mgr);
+                       BufferManager *buffer_mgr,
+                       KMeansProgress *kmeans_progress = nullptr);
 
     void BuildIVFIndex(RowID base_rowid,
                        u32 row_count,
                        IVFDataAccessorBase *data_accessor,
-                       const SharedPtr<ColumnDef> &column_def);
+                       const SharedPtr<ColumnDef> &column_def,
+                       KMeansProgress *kmeans_progress = nullptr);
 
     void SaveIndexInner(LocalFileHandle &file_handle) const;
 
@@ -71,7 +74,8 @@ private:
     void BuildIVFIndexT(RowID base_rowid,
                         u32 row_count,
                         IVFDataAccessorBase *data_accessor,
-                        const SharedPtr<ColumnDef> &column_def);
+                        const SharedPtr<ColumnDef> &column_def,
+                        KMeansProgress *kmeans_progress);
 };
 
 } // namespace infinity
@@ -98,9 +98,14 @@ struct InMemStorage<LogicalType::kMultiVector, embedding_data_type> {
 template <LogicalType column_logical_type, EmbeddingDataType embedding_data_type>
 class IVFIndexInMemT final : public IVFIndexInMem {
     using ColumnEmbeddingElementT = EmbeddingDataTypeToCppTypeT<embedding_data_type>;
+    static constexpr bool IsBinary = embedding_data_type == EmbeddingDataType::kElemBit;
+    static_assert(!IsBinary || column_logical_type == LogicalType::kEmbedding);
     InMemStorage<column_logical_type, embedding_data_type> in_mem_storage_;
     u32 build_index_bar_embedding_num_ = 0;
 
+    // element count of one embedding, bit embeddings are packed into bytes
+    u32 embedding_elem_num() const { return IsBinary ? embedding_dimension() / 8 : embedding_dimension(); }
+
 public:
     SizeT MemoryUsed() const override {
         if (have_ivf_index_.test(std::memory_order_acquire)) {
@@ -147,7 +152,7 @@ public:
             if constexpr (column_logical_type == LogicalType::kEmbedding) {
                 const auto *column_embedding_ptr = reinterpret_cast<const ColumnEmbeddingElementT *>(column_vector.data());
                 ivf_index_storage_->AddEmbeddingBatch(block_offset + row_offset,
-                                                      column_embedding_ptr + row_offset * embedding_dimension(),
+                                                      column_embedding_ptr + row_offset * embedding_elem_num(),
                                                       row_count);
                 input_embedding_count_ += row_count;
             } else if constexpr (column_logical_type == LogicalType::kMultiVector) {
@@ -165,8 +170,8 @@ public:
             if constexpr (column_logical_type == LogicalType::kEmbedding) {
                 const auto *column_embedding_ptr = reinterpret_cast<const ColumnEmbeddingElementT *>(column_vector.data());
                 in_mem_storage_.raw_source_data_.insert(in_mem_storage_.raw_source_data_.end(),
-                                                        column_embedding_ptr + row_offset * embedding_dimension(),
-                                                        column_embedding_ptr + (row_offset + row_count) * embedding_dimension());
+                                                        column_embedding_ptr + row_offset * embedding_elem_num(),
+                                                        column_embedding_ptr + (row_offset + row_count) * embedding_elem_num());
                 const auto old_size = in_mem_storage_.source_offsets_.size();
                 in_mem_storage_.source_offsets_.resize(old_size + row_count);
                 std::iota(in_mem_storage_.source_offsets_.begin() + old_size, in_mem_storage_.source_offsets_.end(), block_offset + row_offset);
@@ -202,10 +207,13 @@ public:
         if (have_ivf_index_.test(std::memory_order_acquire)) {
             UnrecoverableError("Already have index");
         }
-        {
+        if constexpr (IsBinary) {
+            ivf_index_storage_->TrainBinary(input_embedding_count_, in_mem_storage_.raw_source_data_.data());
+        } else {
             // train by f32
             const auto [train_ptr, _] = GetF32Ptr(in_mem_storage_.raw_source_data_.data(), in_mem_storage_.raw_source_data_.size());
-            ivf_index_storage_->Train(input_embedding_count_, train_ptr);
+            KMeansProgress *kmeans_progress = segment_index_entry_ == nullptr ? nullptr : &segment_index_entry_->kmeans_progress();
+            ivf_index_storage_->Train(input_embedding_count_, train_ptr, 0, kmeans_progress);
         }
         // insert
         if constexpr (column_logical_type == LogicalType::kEmbedding) {
@@ -253,7 +261,8 @@ public:
         auto ReturnT = [&]<EmbeddingDataType query_element_type> {
             if constexpr ((query_element_type == EmbeddingDataType::kElemFloat && IsAnyOf<ColumnEmbeddingElementT, f64, f32, Float16T, BFloat16T>) ||
                           (query_element_type == embedding_data_type &&
-                           (query_element_type == EmbeddingDataType::kElemInt8 || query_element_type == EmbeddingDataType::kElemUInt8))) {
+                           (query_element_type == EmbeddingDataType::kElemInt8 || query_element_type == EmbeddingDataType::kElemUInt8 ||
+                            query_element_type == EmbeddingDataType::kElemBit))) {
                 return SearchIndexInMemT<query_element_type>(knn_distance,
                                                              static_cast<const EmbeddingDataTypeToCppTypeT<query_element_type> *>(query_ptr),
                                                              satisfy_filter_func,
@@ -272,6 +281,9 @@ public:
             case EmbeddingDataType::kElemInt8: {
                 return ReturnT.template operator()<EmbeddingDataType::kElemInt8>();
             }
+            case EmbeddingDataType::kElemBit: {
+                return ReturnT.template operator()<EmbeddingDataType::kElemBit>();
+            }
             default: {
                 UnrecoverableError("Invalid EmbeddingDataType");
             }
@@ -295,9 +307,9 @@ public:
                 if (!satisfy_filter_func(segment_offset)) {
                     continue;
                 }
-                auto v_ptr = in_mem_storage_.raw_source_data_.data() + i * embedding_dimension();
-                auto [calc_ptr, _] = GetSearchCalcPtr<QueryDataType>(v_ptr, embedding_dimension());
-                auto d = dist_func(calc_ptr, query_ptr, embedding_dimension());
+                auto v_ptr = in_mem_storage_.raw_source_data_.data() + i * embedding_elem_num();
+                auto [calc_ptr, _] = GetSearchCalcPtr<QueryDataType>(v_ptr, embedding_elem_num());
+                auto d = dist_func(calc_ptr, query_ptr, embedding_elem_num());
                 add_result_func(d, segment_offset);
             }
         } else if constexpr (column_logical_type == LogicalType::kMultiVector) {
@@ -351,7 +363,13 @@ SharedPtr<IVFIndexInMem> GetNewIVFIndexInMem(const DataType *column_data_type,
         case EmbeddingDataType::kElemDouble: {
             return GetResult.template operator()<EmbeddingDataType::kElemDouble>();
         }
-        case EmbeddingDataType::kElemBit:
+        case EmbeddingDataType::kElemBit: {
+            if constexpr (column_logical_type == LogicalType::kEmbedding) {
+                return GetResult.template operator()<EmbeddingDataType::kElemBit>();
+            }
+            UnrecoverableError("Unsupported embedding element type for IVF");
+            return {};
+        }
         case EmbeddingDataType::kElemInt16:
         case EmbeddingDataType::kElemInt32:
         case EmbeddingDataType::kElemInt64:
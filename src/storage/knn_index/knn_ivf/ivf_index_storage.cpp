@@ -39,6 +39,8 @@ import ivf_index_util_func;
 import knn_expr;
 import vector_distance;
 import mlas_matrix_multiply;
+import simd_functions;
+import infinity_context;
 
 namespace infinity {
 
@@ -49,16 +51,31 @@ IVF_Centroids_Storage::IVF_Centroids_Storage(const u32 embedding_dimension, cons
     assert(centroids_data_.size() == embedding_dimension_ * centroids_num_);
 }
 
+IVF_Centroids_Storage::IVF_Centroids_Storage(const u32 embedding_dimension, const u32 centroids_num, Vector<u8> &&binary_centroids_data)
+    : embedding_dimension_(embedding_dimension), centroids_num_(centroids_num), binary_centroids_data_(std::move(binary_centroids_data)) {
+    assert(binary_centroids_data_.size() == embedding_dimension_ / 8 * centroids_num_);
+}
+
 void IVF_Centroids_Storage::Save(LocalFileHandle &file_handle) const {
     file_handle.Append(&embedding_dimension_, sizeof(embedding_dimension_));
     file_handle.Append(&centroids_num_, sizeof(centroids_num_));
+    if (!binary_centroids_data_.empty()) {
+        file_handle.Append(binary_centroids_data_.data(), binary_centroids_data_.size());
+        return;
+    }
     const auto data_bytes = centroids_num_ * embedding_dimension_ * sizeof(f32);
     file_handle.Append(centroids_data_.data(), data_bytes);
 }
 
-void IVF_Centroids_Storage::Load(LocalFileHandle &file_handle) {
+void IVF_Centroids_Storage::Load(LocalFileHandle &file_handle, const bool binary) {
     file_handle.Read(&embedding_dimension_, sizeof(embedding_dimension_));
     file_handle.Read(&centroids_num_, sizeof(centroids_num_));
+    if (binary) {
+        const auto data_bytes = centroids_num_ * (embedding_dimension_ / 8);
+        binary_centroids_data_.resize(data_bytes);
+        file_handle.Read(binary_centroids_data_.data(), data_bytes);
+        return;
+    }
     const auto vec_size = centroids_num_ * embedding_dimension_;
     centroids_data_.resize(vec_size);
     file_handle.Read(centroids_data_.data(), vec_size * sizeof(f32));
@@ -107,7 +124,7 @@ void IVF_Index_Storage::Save(LocalFileHandle &file_handle) const {
 void IVF_Index_Storage::Load(LocalFileHandle &file_handle) {
     file_handle.Read(&row_count_, sizeof(row_count_));
     file_handle.Read(&embedding_count_, sizeof(embedding_count_));
-    ivf_centroids_storage_.Load(file_handle);
+    ivf_centroids_storage_.Load(file_handle, embedding_data_type_ == EmbeddingDataType::kElemBit);
     ivf_parts_storage_ =
         IVF_Parts_Storage::Make(embedding_dimension_, ivf_centroids_storage_.centroids_num(), embedding_data_type_, ivf_option_.storage_option_);
     ivf_parts_storage_->Load(file_handle);
@@ -131,8 +148,14 @@ IVF_Index_Storage::IVF_Index_Storage(const IndexIVFOption &ivf_option,
     : ivf_option_(ivf_option), column_logical_type_(column_logical_type), embedding_data_type_(embedding_data_type),
       embedding_dimension_(embedding_dimension) {}
 
-void IVF_Index_Storage::Train(const u32 training_embedding_num, const f32 *training_data, const u32 expect_centroid_num) {
+void IVF_Index_Storage::Train(const u32 training_embedding_num,
+                              const f32 *training_data,
+                              const u32 expect_centroid_num,
+                              KMeansProgress *kmeans_progress) {
     Vector<f32> output_centroids;
+    const KMeansOption kmeans_option{.thread_pool_ = &InfinityContext::instance().GetVectorIndexBuildThreadPool(),
+                                     .mini_batch_size_ = ivf_option_.centroid_option_.kmeans_mini_batch_,
+                                     .progress_ = kmeans_progress};
     const auto partition_num = GetKMeansCentroids(ivf_option_.metric_,
                                                   embedding_dimension_,
                                                   training_embedding_num,
@@ -142,7 +165,8 @@ void IVF_Index_Storage::Train(const u32 training_embedding_num, const f32 *train
                                                   0,
                                                   ivf_option_.centroid_option_.min_points_per_centroid_,
                                                   ivf_option_.centroid_option_.max_points_per_centroid_,
-                                                  ivf_option_.centroid_option_.centroids_num_ratio_);
+                                                  ivf_option_.centroid_option_.centroids_num_ratio_,
+                                                  kmeans_option);
     assert(expect_centroid_num == 0 || expect_centroid_num == partition_num);
     assert(output_centroids.size() == partition_num * embedding_dimension_);
     ivf_centroids_storage_ = IVF_Centroids_Storage(embedding_dimension_, partition_num, std::move(output_centroids));
@@ -153,10 +177,33 @@ void IVF_Index_Storage::Train(const u32 training_embedding_num, const f32 *train
     ivf_parts_storage_->Train(training_embedding_num, training_data, &ivf_centroids_storage_);
 }
 
+void IVF_Index_Storage::TrainBinary(const u32 training_embedding_num, const u8 *training_data, const u32 expect_centroid_num) {
+    if (embedding_data_type_ != EmbeddingDataType::kElemBit) [[unlikely]] {
+        UnrecoverableError("Binary training requires bit embedding");
+    }
+    Vector<u8> output_centroids;
+    const auto partition_num = GetBinaryKMeansCentroids(embedding_dimension_,
+                                                        training_embedding_num,
+                                                        training_data,
+                                                        output_centroids,
+                                                        expect_centroid_num,
+                                                        0,
+                                                        ivf_option_.centroid_option_.max_points_per_centroid_,
+                                                        ivf_option_.centroid_option_.centroids_num_ratio_);
+    assert(expect_centroid_num == 0 || expect_centroid_num == partition_num);
+    assert(output_centroids.size() == partition_num * (embedding_dimension_ / 8));
+    ivf_centroids_storage_ = IVF_Centroids_Storage(embedding_dimension_, partition_num, std::move(output_centroids));
+    ivf_parts_storage_ =
+        IVF_Parts_Storage::Make(embedding_dimension_, ivf_centroids_storage_.centroids_num(), embedding_data_type_, ivf_option_.storage_option_);
+}
+
 void IVF_Index_Storage::AddEmbedding(const SegmentOffset segment_offset, const void *embedding_ptr) {
     if (column_logical_type_ != LogicalType::kEmbedding) [[unlikely]] {
         UnrecoverableError("Column is not embedding type");
     }
+    if (embedding_data_type_ == EmbeddingDataType::kElemBit) {
+        return AddBinaryEmbeddingBatch([segment_offset](u32) { return segment_offset; }, static_cast<const u8 *>(embedding_ptr), 1);
+    }
     return ApplyEmbeddingDataTypeToFunc(
         embedding_data_type_,
         [segment_offset, embedding_ptr, this]<EmbeddingDataType embedding_data_type> {
@@ -170,6 +217,11 @@ void IVF_Index_Storage::AddEmbeddingBatch(const SegmentOffset start_segment_offs
     if (column_logical_type_ != LogicalType::kEmbedding) [[unlikely]] {
         UnrecoverableError("Column is not embedding type");
     }
+    if (embedding_data_type_ == EmbeddingDataType::kElemBit) {
+        return AddBinaryEmbeddingBatch([start_segment_offset](const u32 i) { return start_segment_offset + i; },
+                                       static_cast<const u8 *>(embedding_ptr),
+                                       embedding_num);
+    }
     return ApplyEmbeddingDataTypeToFunc(
         embedding_data_type_,
         [start_segment_offset, embedding_ptr, embedding_num, this]<EmbeddingDataType embedding_data_type> {
@@ -184,6 +236,11 @@ void IVF_Index_Storage::AddEmbeddingBatch(const SegmentOffset *segment_offset_pt
     if (column_logical_type_ != LogicalType::kEmbedding) [[unlikely]] {
         UnrecoverableError("Column is not embedding type");
     }
+    if (embedding_data_type_ == EmbeddingDataType::kElemBit) {
+        return AddBinaryEmbeddingBatch([segment_offset_ptr](const u32 i) { return segment_offset_ptr[i]; },
+                                       static_cast<const u8 *>(embedding_ptr),
+                                       embedding_num);
+    }
     return ApplyEmbeddingDataTypeToFunc(
         embedding_data_type_,
         [segment_offset_ptr, embedding_ptr, embedding_num, this]<EmbeddingDataType embedding_data_type> {
@@ -208,6 +265,30 @@ void IVF_Index_Storage::AddMultiVector(const SegmentOffset segment_offset, const
         [] {});
 }
 
+template <typename SegmentOffsetF>
+void IVF_Index_Storage::AddBinaryEmbeddingBatch(SegmentOffsetF get_segment_offset, const u8 *embedding_ptr, const u32 embedding_num) {
+    assert(ivf_centroids_storage_.embedding_dimension() == embedding_dimension_);
+    assert(ivf_centroids_storage_.centroids_num() == ivf_parts_storage_->centroids_num());
+    const u32 bytes = embedding_dimension_ / 8;
+    const u32 centroids_num = ivf_centroids_storage_.centroids_num();
+    const u8 *centroids_data = ivf_centroids_storage_.binary_data();
+    const auto hamming = GetSIMD_FUNCTIONS().HammingDistance_func_ptr_;
+    for (u32 i = 0; i < embedding_num; ++i) {
+        const u8 *embedding_i = embedding_ptr + i * bytes;
+        u32 part_id = 0;
+        f32 best_dist = std::numeric_limits<f32>::max();
+        for (u32 k = 0; k < centroids_num; ++k) {
+            if (const f32 dist = hamming(embedding_i, centroids_data + k * bytes, bytes); dist < best_dist) {
+                best_dist = dist;
+                part_id = k;
+            }
+        }
+        ivf_parts_storage_->AppendOneEmbeddingWithStat(part_id, embedding_i, get_segment_offset(i), &ivf_centroids_storage_);
+    }
+    embedding_count_ += embedding_num;
+    row_count_ += embedding_num;
+}
+
 template <EmbeddingDataType embedding_data_type>
 void IVF_Index_Storage::AddEmbeddingT(const SegmentOffset segment_offset, const EmbeddingDataTypeToCppTypeT<embedding_data_type> *embedding_ptr) {
     return AddEmbeddingBatchT<embedding_data_type>(segment_offset, embedding_ptr, 1);
@@ -294,6 +375,9 @@ void IVF_Index_Storage::SearchIndex(const KnnDistanceBase1 *knn_distance,
                                     u32 nprobe,
                                     const std::function<bool(SegmentOffset)> &satisfy_filter_func,
                                     const std::function<void(f32, SegmentOffset)> &add_result_func) const {
+    if (embedding_data_type_ == EmbeddingDataType::kElemBit) {
+        return SearchBinaryIndex(knn_distance, query_ptr, query_element_type, nprobe, satisfy_filter_func, add_result_func);
+    }
     const auto dimension = embedding_dimension();
     const auto [centroids_num, centroids_data] = ivf_centroids_storage_.GetCentroidDataForMetric(knn_distance);
     nprobe = std::min<u32>(nprobe, centroids_num);
@@ -342,4 +426,33 @@ void IVF_Index_Storage::SearchIndex(const KnnDistanceBase1 *knn_distance,
     ivf_parts_storage_->SearchIndex(nprobe_result, this, knn_distance, query_ptr, query_element_type, satisfy_filter_func, add_result_func);
 }
 
+void IVF_Index_Storage::SearchBinaryIndex(const KnnDistanceBase1 *knn_distance,
+                                          const void *query_ptr,
+                                          const EmbeddingDataType query_element_type,
+                                          u32 nprobe,
+                                          const std::function<bool(SegmentOffset)> &satisfy_filter_func,
+                                          const std::function<void(f32, SegmentOffset)> &add_result_func) const {
+    if (knn_distance->dist_type_ != KnnDistanceType::kHamming || query_element_type != EmbeddingDataType::kElemBit) {
+        RecoverableError(Status::NotSupport(fmt::format("IVF index on bit embedding only supports hamming search with bit query, got {} metric.",
+                                                        KnnExpr::KnnDistanceType2Str(knn_distance->dist_type_))));
+    }
+    const u32 bytes = embedding_dimension_ / 8;
+    const u32 centroids_num = ivf_centroids_storage_.centroids_num();
+    const u8 *centroids_data = ivf_centroids_storage_.binary_data();
+    const auto *query_u8_ptr = static_cast<const u8 *>(query_ptr);
+    nprobe = std::min<u32>(nprobe, centroids_num);
+    const auto hamming = GetSIMD_FUNCTIONS().HammingDistance_func_ptr_;
+    const auto centroid_dists = MakeUniqueForOverwrite<f32[]>(centroids_num);
+    for (u32 k = 0; k < centroids_num; ++k) {
+        centroid_dists[k] = hamming(query_u8_ptr, centroids_data + k * bytes, bytes);
+    }
+    Vector<u32> nprobe_result(centroids_num);
+    std::iota(nprobe_result.begin(), nprobe_result.end(), static_cast<u32>(0));
+    std::nth_element(nprobe_result.begin(), nprobe_result.begin() + nprobe, nprobe_result.end(), [&centroid_dists](const u32 a, const u32 b) {
+        return centroid_dists[a] < centroid_dists[b];
+    });
+    nprobe_result.resize(nprobe);
+    ivf_parts_storage_->SearchIndex(nprobe_result, this, knn_distance, query_ptr, query_element_type, satisfy_filter_func, add_result_func);
+}
+
 } // namespace infinity
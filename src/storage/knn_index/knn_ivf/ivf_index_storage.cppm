@@ -25,6 +25,7 @@ import logical_type;
 import data_type;
 import ivf_index_util_func;
 import infinity_exception;
+import kmeans_partition;
 
 namespace infinity {
 
@@ -33,23 +34,28 @@ class KnnDistanceBase1;
 
 export class IVF_Index_Storage;
 
-// always use float for centroids
+// always use float for centroids, except for bit embeddings whose centroids are packed bits
 class IVF_Centroids_Storage {
     u32 embedding_dimension_ = 0;
     u32 centroids_num_ = 0;
     Vector<f32> centroids_data_ = {};
+    Vector<u8> binary_centroids_data_ = {};
     mutable Vector<f32> normalized_centroids_data_cache_ = {};
 
 public:
     IVF_Centroids_Storage() = default;
     IVF_Centroids_Storage(u32 embedding_dimension, u32 centroids_num, Vector<f32> &&centroids_data);
+    IVF_Centroids_Storage(u32 embedding_dimension, u32 centroids_num, Vector<u8> &&binary_centroids_data);
     const f32 *data() const { return centroids_data_.data(); }
+    const u8 *binary_data() const { return binary_centroids_data_.data(); }
     u32 embedding_dimension() const { return embedding_dimension_; }
     u32 centroids_num() const { return centroids_num_; }
     void Save(LocalFileHandle &file_handle) const;
-    void Load(LocalFileHandle &file_handle);
+    void Load(LocalFileHandle &file_handle, bool binary = false);
     Pair<u32, const f32 *> GetCentroidDataForMetric(const KnnDistanceBase1 *knn_distance) const;
-    inline SizeT MemoryUsed() const { return sizeof(u32) * 2 + sizeof(f32) * (centroids_data_.size() + normalized_centroids_data_cache_.size()); }
+    inline SizeT MemoryUsed() const {
+        return sizeof(u32) * 2 + sizeof(f32) * (centroids_data_.size() + normalized_centroids_data_cache_.size()) + binary_centroids_data_.size();
+    }
 };
 
 class IVF_Parts_Storage {
@@ -117,7 +123,10 @@ public:
     [[nodiscard]] const IVF_Centroids_Storage &ivf_centroids_storage() const { return ivf_centroids_storage_; }
     [[nodiscard]] const IVF_Parts_Storage &ivf_parts_storage() const { return *ivf_parts_storage_; }
 
-    void Train(u32 training_embedding_num, const f32 *training_data, u32 expect_centroid_num = 0);
+    // kmeans_progress: reports the k-means iterations, may be nullptr
+    void Train(u32 training_embedding_num, const f32 *training_data, u32 expect_centroid_num = 0, KMeansProgress *kmeans_progress = nullptr);
+    // bit embeddings: training_data holds packed bits, embedding_dimension / 8 bytes per embedding
+    void TrainBinary(u32 training_embedding_num, const u8 *training_data, u32 expect_centroid_num = 0);
     void AddEmbedding(SegmentOffset segment_offset, const void *embedding_ptr);
     void AddEmbeddingBatch(SegmentOffset start_segment_offset, const void *embedding_ptr, u32 embedding_num);
     void AddEmbeddingBatch(const SegmentOffset *segment_offset_ptr, const void *embedding_ptr, u32 embedding_num);
@@ -136,6 +145,14 @@ public:
     SizeT MemoryUsed() const;
 
 private:
+    template <typename SegmentOffsetF>
+    void AddBinaryEmbeddingBatch(SegmentOffsetF get_segment_offset, const u8 *embedding_ptr, u32 embedding_num);
+    void SearchBinaryIndex(const KnnDistanceBase1 *knn_distance,
+                           const void *query_ptr,
+                           EmbeddingDataType query_element_type,
+                           u32 nprobe,
+                           const std::function<bool(SegmentOffset)> &satisfy_filter_func,
+                           const std::function<void(f32, SegmentOffset)> &add_result_func) const;
     template <EmbeddingDataType embedding_data_type>
     void AddEmbeddingT(SegmentOffset segment_offset, const EmbeddingDataTypeToCppTypeT<embedding_data_type> *embedding_ptr);
     template <EmbeddingDataType embedding_data_type>
@@ -14,8 +14,10 @@
 
 module;
 
+#include <algorithm>
 #include <cassert>
 #include <cmath>
+#include <exception>
 #include <vector>
 
 module ivf_index_storage;
@@ -40,6 +42,8 @@ import mlas_matrix_multiply;
 import vector_distance;
 import index_base;
 import knn_expr;
+import default_values;
+import infinity_context;
 
 namespace infinity {
 
@@ -118,6 +122,33 @@ public:
                              const std::function<bool(SegmentOffset)> &satisfy_filter_func,
                              const std::function<void(f32, SegmentOffset)> &add_result_func,
                              SearchIndexPartsReuseContext &context) const = 0;
+
+protected:
+    // Filter the embeddings IVF_SEARCH_BLOCK_SIZE at a time, block_dist_func computes the distances of the passed ones together.
+    template <typename BlockDistFunc>
+    void ScanBlocks(const std::function<bool(SegmentOffset)> &satisfy_filter_func,
+                    const std::function<void(f32, SegmentOffset)> &add_result_func,
+                    BlockDistFunc &&block_dist_func) const {
+        u32 block_ids[IVF_SEARCH_BLOCK_SIZE];
+        f32 block_dists[IVF_SEARCH_BLOCK_SIZE];
+        const auto total_embedding_num = embedding_num();
+        for (u32 block_start = 0; block_start < total_embedding_num; block_start += IVF_SEARCH_BLOCK_SIZE) {
+            const u32 block_end = std::min(block_start + IVF_SEARCH_BLOCK_SIZE, total_embedding_num);
+            u32 block_n = 0;
+            for (u32 i = block_start; i < block_end; ++i) {
+                if (satisfy_filter_func(embedding_segment_offset(i))) {
+                    block_ids[block_n++] = i;
+                }
+            }
+            if (block_n == 0) {
+                continue;
+            }
+            block_dist_func(block_ids, block_n, block_dists);
+            for (u32 b = 0; b < block_n; ++b) {
+                add_result_func(block_dists[b], embedding_segment_offset(block_ids[b]));
+            }
+        }
+    }
 };
 
 template <IndexIVFStorageOption::Type t>
@@ -153,6 +184,10 @@ public:
                 row_memory_cost_ += sizeof(BFloat16T) * embedding_dimension;
                 break;
             }
+            case EmbeddingDataType::kElemBit: {
+                row_memory_cost_ += embedding_dimension / 8;
+                break;
+            }
             default:
                 UnrecoverableError("Invalid IVF plain_data_type");
                 break;
@@ -510,6 +545,87 @@ public:
                      const EmbeddingDataType query_element_type,
                      const std::function<bool(SegmentOffset)> &satisfy_filter_func,
                      const std::function<void(f32, SegmentOffset)> &add_result_func) const override {
+        SizeT probe_row_n = 0;
+        for (const auto part_id : part_ids) {
+            probe_row_n += ivf_part_storages_[part_id]->embedding_num();
+        }
+        auto &thread_pool = InfinityContext::instance().GetSearchThreadPool();
+        const SizeT task_n =
+            std::min<SizeT>({static_cast<SizeT>(thread_pool.size()) + 1, part_ids.size(), probe_row_n / IVF_PARALLEL_PROBE_MIN_ROWS});
+        if (task_n <= 1) {
+            SearchIndexParts(part_ids, ivf_index_storage, knn_distance, query_ptr, query_element_type, satisfy_filter_func, add_result_func);
+            return;
+        }
+
+        // the largest lists first, each to the task probing the fewest rows
+        Vector<u32> sorted_part_ids = part_ids;
+        std::sort(sorted_part_ids.begin(), sorted_part_ids.end(), [this](const u32 a, const u32 b) {
+            return ivf_part_storages_[a]->embedding_num() > ivf_part_storages_[b]->embedding_num();
+        });
+        Vector<Vector<u32>> task_part_ids(task_n);
+        Vector<SizeT> task_row_n(task_n, 0);
+        for (const auto part_id : sorted_part_ids) {
+            const SizeT task_id = std::min_element(task_row_n.begin(), task_row_n.end()) - task_row_n.begin();
+            task_part_ids[task_id].push_back(part_id);
+            task_row_n[task_id] += ivf_part_storages_[part_id]->embedding_num();
+        }
+
+        // the result handler is not thread safe, the tasks hand over their results in batches
+        std::mutex result_mutex;
+        auto search_task = [&](const Vector<u32> &task_parts) {
+            Vector<Pair<f32, SegmentOffset>> results;
+            results.reserve(IVF_PARALLEL_PROBE_MIN_ROWS / IVF_SEARCH_BLOCK_SIZE);
+            auto flush = [&] {
+                std::lock_guard lock(result_mutex);
+                for (const auto &[d, segment_offset] : results) {
+                    add_result_func(d, segment_offset);
+                }
+                results.clear();
+            };
+            SearchIndexParts(task_parts,
+                             ivf_index_storage,
+                             knn_distance,
+                             query_ptr,
+                             query_element_type,
+                             satisfy_filter_func,
+                             [&](const f32 d, const SegmentOffset segment_offset) {
+                                 results.emplace_back(d, segment_offset);
+                                 if (results.size() == results.capacity()) {
+                                     flush();
+                                 }
+                             });
+            flush();
+        };
+        Vector<std::future<void>> futs;
+        futs.reserve(task_n - 1);
+        for (SizeT task_id = 1; task_id < task_n; ++task_id) {
+            futs.emplace_back(thread_pool.push([&search_task, &task_parts = task_part_ids[task_id]](int) { search_task(task_parts); }));
+        }
+        std::exception_ptr search_exception;
+        try {
+            search_task(task_part_ids[0]);
+        } catch (...) {
+            search_exception = std::current_exception();
+        }
+        for (auto &fut : futs) {
+            fut.wait();
+        }
+        if (search_exception) {
+            std::rethrow_exception(search_exception);
+        }
+        for (auto &fut : futs) {
+            fut.get();
+        }
+    }
+
+private:
+    void SearchIndexParts(const Vector<u32> &part_ids,
+                          const IVF_Index_Storage *ivf_index_storage,
+                          const KnnDistanceBase1 *knn_distance,
+                          const void *query_ptr,
+                          const EmbeddingDataType query_element_type,
+                          const std::function<bool(SegmentOffset)> &satisfy_filter_func,
+                          const std::function<void(f32, SegmentOffset)> &add_result_func) const {
         SearchIndexPartsReuseContext context;
         for (const auto part_id : part_ids) {
             ivf_part_storages_[part_id]
@@ -639,19 +755,94 @@ public:
         }
         auto dist_func = knn_distance_1->dist_func_;
         const auto total_embedding_num = embedding_num();
+        // f16 and bf16 embeddings are widened into one buffer reused by the part
+        Vector<QueryDataType> calc_buffer;
+        if constexpr (!std::is_same_v<StorageDataT, QueryDataType>) {
+            calc_buffer.resize(embedding_dimension());
+        }
         for (u32 i = 0; i < total_embedding_num; ++i) {
             const auto segment_offset = embedding_segment_offset(i);
             if (!satisfy_filter_func(segment_offset)) {
                 continue;
             }
             auto v_ptr = data_.data() + i * embedding_dimension();
-            auto [calc_ptr, _] = GetSearchCalcPtr<QueryDataType>(v_ptr, embedding_dimension());
+            const QueryDataType *calc_ptr = nullptr;
+            if constexpr (std::is_same_v<StorageDataT, QueryDataType>) {
+                calc_ptr = v_ptr;
+            } else {
+                CastToF32(v_ptr, calc_buffer.data(), embedding_dimension());
+                calc_ptr = calc_buffer.data();
+            }
             auto d = dist_func(calc_ptr, query_ptr, embedding_dimension());
             add_result_func(d, segment_offset);
         }
     }
 };
 
+// Binary storage: packed bits of a bit embedding, compared by hamming distance
+class IVF_Part_Storage_Binary final : public IVF_Part_Storage {
+    const u32 embedding_dimension_ = 0;
+    const u32 embedding_bytes_ = 0;
+    Vector<u8> data_{};
+
+public:
+    IVF_Part_Storage_Binary(const u32 part_id, const u32 embedding_dimension)
+        : IVF_Part_Storage(part_id), embedding_dimension_(embedding_dimension), embedding_bytes_(embedding_dimension / 8) {}
+
+    [[nodiscard]] u32 embedding_dimension() const { return embedding_dimension_; }
+    [[nodiscard]] u32 embedding_bytes() const { return embedding_bytes_; }
+
+    void Save(LocalFileHandle &file_handle) const override {
+        IVF_Part_Storage::Save(file_handle);
+        const u32 byte_cnt = embedding_num() * embedding_bytes();
+        assert(byte_cnt == data_.size());
+        file_handle.Append(data_.data(), byte_cnt);
+    }
+    void Load(LocalFileHandle &file_handle) override {
+        IVF_Part_Storage::Load(file_handle);
+        const u32 byte_cnt = embedding_num() * embedding_bytes();
+        data_.resize(byte_cnt);
+        file_handle.Read(data_.data(), byte_cnt);
+    }
+
+    void AppendOneEmbedding(const void *embedding_ptr,
+                            const SegmentOffset segment_offset,
+                            const IVF_Centroids_Storage *,
+                            const IVF_Parts_Storage *) override {
+        const auto *src_embedding_data = static_cast<const u8 *>(embedding_ptr);
+        data_.insert(data_.end(), src_embedding_data, src_embedding_data + embedding_bytes());
+        embedding_segment_offsets_.push_back(segment_offset);
+        ++embedding_num_;
+    }
+
+    void SearchIndex(const IVF_Index_Storage *,
+                     const KnnDistanceBase1 *knn_distance,
+                     const void *query_ptr,
+                     const EmbeddingDataType query_element_type,
+                     const std::function<bool(SegmentOffset)> &satisfy_filter_func,
+                     const std::function<void(f32, SegmentOffset)> &add_result_func,
+                     SearchIndexPartsReuseContext &) const override {
+        if (query_element_type != EmbeddingDataType::kElemBit) [[unlikely]] {
+            UnrecoverableError("Invalid Query EmbeddingDataType");
+        }
+        auto knn_distance_1 = dynamic_cast<const KnnDistance1<u8, f32> *>(knn_distance);
+        if (!knn_distance_1) [[unlikely]] {
+            UnrecoverableError("Invalid KnnDistance1");
+        }
+        auto dist_func = knn_distance_1->dist_func_;
+        const auto *query_u8_ptr = static_cast<const u8 *>(query_ptr);
+        const auto total_embedding_num = embedding_num();
+        for (u32 i = 0; i < total_embedding_num; ++i) {
+            const auto segment_offset = embedding_segment_offset(i);
+            if (!satisfy_filter_func(segment_offset)) {
+                continue;
+            }
+            auto d = dist_func(data_.data() + i * embedding_bytes(), query_u8_ptr, embedding_bytes());
+            add_result_func(d, segment_offset);
+        }
+    }
+};
+
 // SQ storage
 template <u32 sq_bits, EmbeddingDataType src_embedding_data_type>
 class IVF_Part_Storage_SQ final : public IVF_Part_Storage {
@@ -791,10 +982,27 @@ public:
         const auto b_ptr = ivf_parts_storage.data_b();
         const auto c_ptr = ivf_index_storage->ivf_centroids_storage().data() + part_id() * dimension;
         const auto [x_ptr, _] = GetF32Ptr(query_ptr, dimension);
-        const auto total_embedding_num = embedding_num();
         context.dim_ = dimension;
         context.x_ptr_ = x_ptr;
         context.a_ptr_ = a_ptr;
+        // the codes of a block are decoded to floats first, the dot products below run on the simd kernels
+        const auto block_n_values = MakeUniqueForOverwrite<f32[]>(IVF_SEARCH_BLOCK_SIZE * dimension);
+        const auto block_n_squares = MakeUniqueForOverwrite<f32[]>(IVF_SEARCH_BLOCK_SIZE * dimension);
+        auto decode_block = [&](const u32 *block_ids, const u32 block_n, const bool with_squares) {
+            for (u32 b = 0; b < block_n; ++b) {
+                const u8 *sq_data = sq_data_.data() + block_ids[b] * embedding_sq_bytes_;
+                f32 *n_values = block_n_values.get() + b * dimension;
+                for (u32 j = 0; j < dimension; ++j) {
+                    n_values[j] = sq_decode(sq_data, j);
+                }
+                if (with_squares) {
+                    f32 *n_squares = block_n_squares.get() + b * dimension;
+                    for (u32 j = 0; j < dimension; ++j) {
+                        n_squares[j] = n_values[j] * n_values[j];
+                    }
+                }
+            }
+        };
         switch (knn_distance->dist_type_) {
             case KnnDistanceType::kInnerProduct: {
                 // dot(x, v) = dot(x, c + b) + dot((x * a), n) + dot(v, e)
@@ -804,18 +1012,13 @@ public:
                 }
                 const auto dot_x_c_b = IPDistance<f32>(x_ptr, c_plus_b.get(), dimension);
                 const auto &x_mult_a = context.get_x_mult_a();
-                for (u32 i = 0; i < total_embedding_num; ++i) {
-                    const auto segment_offset = embedding_segment_offset(i);
-                    if (!satisfy_filter_func(segment_offset)) {
-                        continue;
+                ScanBlocks(satisfy_filter_func, add_result_func, [&](const u32 *block_ids, const u32 block_n, f32 *block_dists) {
+                    decode_block(block_ids, block_n, false);
+                    for (u32 b = 0; b < block_n; ++b) {
+                        block_dists[b] =
+                            dot_x_c_b + dot_v_e_[block_ids[b]] + IPDistance<f32>(x_mult_a.get(), block_n_values.get() + b * dimension, dimension);
                     }
-                    f32 d = dot_x_c_b + dot_v_e_[i];
-                    const u8 *sq_data = sq_data_.data() + i * embedding_sq_bytes_;
-                    for (u32 j = 0; j < dimension; ++j) {
-                        d += x_mult_a[j] * sq_decode(sq_data, j);
-                    }
-                    add_result_func(d, segment_offset);
-                }
+                });
                 break;
             }
             case KnnDistanceType::kCosine: {
@@ -833,22 +1036,17 @@ public:
                 }
                 const auto dot_x_c_b = IPDistance<f32>(x_ptr, c_plus_b.get(), dimension);
                 const auto c_plus_b_l2 = L2NormSquare<f32>(c_plus_b.get(), dimension);
-                for (u32 i = 0; i < total_embedding_num; ++i) {
-                    const auto segment_offset = embedding_segment_offset(i);
-                    if (!satisfy_filter_func(segment_offset)) {
-                        continue;
+                ScanBlocks(satisfy_filter_func, add_result_func, [&](const u32 *block_ids, const u32 block_n, f32 *block_dists) {
+                    decode_block(block_ids, block_n, true);
+                    for (u32 b = 0; b < block_n; ++b) {
+                        const f32 *n_values = block_n_values.get() + b * dimension;
+                        const f32 *n_squares = block_n_squares.get() + b * dimension;
+                        const f32 x_v_ip = dot_x_c_b + IPDistance<f32>(x_mult_a.get(), n_values, dimension);
+                        const f32 v_l2 = c_plus_b_l2 + IPDistance<f32>(a_square.get(), n_squares, dimension) +
+                                         IPDistance<f32>(c_plus_b_mult_a_2.get(), n_values, dimension);
+                        block_dists[b] = x_v_ip / std::sqrt(x_l2 * v_l2);
                     }
-                    f32 x_v_ip = dot_x_c_b;
-                    f32 v_l2 = c_plus_b_l2;
-                    const u8 *sq_data = sq_data_.data() + i * embedding_sq_bytes_;
-                    for (u32 j = 0; j < dimension; ++j) {
-                        const auto n = sq_decode(sq_data, j);
-                        x_v_ip += x_mult_a[j] * n;
-                        v_l2 += (a_square[j] * n + c_plus_b_mult_a_2[j]) * n;
-                    }
-                    const f32 d = x_v_ip / std::sqrt(x_l2 * v_l2);
-                    add_result_func(d, segment_offset);
-                }
+                });
                 break;
             }
             case KnnDistanceType::kL2: {
@@ -861,19 +1059,15 @@ public:
                     a_mult_b_plus_c_minus_x_2[i] = 2.0f * a_ptr[i] * b_plus_c_minus_x[i];
                 }
                 const auto b_plus_c_minus_x_l2 = L2NormSquare<f32>(b_plus_c_minus_x.get(), dimension);
-                for (u32 i = 0; i < total_embedding_num; ++i) {
-                    const auto segment_offset = embedding_segment_offset(i);
-                    if (!satisfy_filter_func(segment_offset)) {
-                        continue;
+                ScanBlocks(satisfy_filter_func, add_result_func, [&](const u32 *block_ids, const u32 block_n, f32 *block_dists) {
+                    decode_block(block_ids, block_n, true);
+                    for (u32 b = 0; b < block_n; ++b) {
+                        const f32 *n_values = block_n_values.get() + b * dimension;
+                        const f32 *n_squares = block_n_squares.get() + b * dimension;
+                        block_dists[b] = b_plus_c_minus_x_l2 + IPDistance<f32>(a_square.get(), n_squares, dimension) +
+                                         IPDistance<f32>(a_mult_b_plus_c_minus_x_2.get(), n_values, dimension);
                     }
-                    f32 d = b_plus_c_minus_x_l2;
-                    const u8 *sq_data = sq_data_.data() + i * embedding_sq_bytes_;
-                    for (u32 j = 0; j < dimension; ++j) {
-                        const auto n = sq_decode(sq_data, j);
-                        d += (a_square[j] * n + a_mult_b_plus_c_minus_x_2[j]) * n;
-                    }
-                    add_result_func(d, segment_offset);
-                }
+                });
                 break;
             }
             default: {
@@ -1139,9 +1333,19 @@ public:
         const auto dimension = ivf_index_storage->embedding_dimension();
         const auto [query_f32, _] = GetF32Ptr(query_ptr, dimension);
         const auto centroid_data = ivf_index_storage->ivf_centroids_storage().data() + part_id() * dimension;
-        const auto total_embedding_num = embedding_num();
         context.dim_ = dimension;
         context.x_ptr_ = query_f32;
+        // the codes of a block are transposed, codes of one subspace are adjacent and share the rows of the lookup tables
+        const auto row_codes = MakeUniqueForOverwrite<u32[]>(subspace_num);
+        const auto block_codes = MakeUniqueForOverwrite<u32[]>(subspace_num * IVF_SEARCH_BLOCK_SIZE);
+        auto extract_block_codes = [&](const u32 *block_ids, const u32 block_n) {
+            for (u32 b = 0; b < block_n; ++b) {
+                pq_code_storage_->ExtractCodes(block_ids[b], row_codes.get());
+                for (u32 j = 0; j < subspace_num; ++j) {
+                    block_codes[j * IVF_SEARCH_BLOCK_SIZE + b] = row_codes[j];
+                }
+            }
+        };
         switch (knn_distance->dist_type_) {
             case KnnDistanceType::kInnerProduct: {
                 const auto query_centroid_ip = IPDistance<f32>(query_f32, centroid_data, dimension);
@@ -1149,19 +1353,17 @@ public:
                 if (!ip_table) {
                     ip_table = ivf_parts_storage.GetIPTable(query_f32);
                 }
-                const auto encoded_codes = MakeUniqueForOverwrite<u32[]>(subspace_num_);
-                for (u32 i = 0; i < total_embedding_num; ++i) {
-                    const auto segment_offset = embedding_segment_offset(i);
-                    if (!satisfy_filter_func(segment_offset)) {
-                        continue;
-                    }
-                    pq_code_storage_->ExtractCodes(i, encoded_codes.get());
-                    f32 d = query_centroid_ip;
+                ScanBlocks(satisfy_filter_func, add_result_func, [&](const u32 *block_ids, const u32 block_n, f32 *block_dists) {
+                    extract_block_codes(block_ids, block_n);
+                    std::fill_n(block_dists, block_n, query_centroid_ip);
                     for (u32 j = 0; j < subspace_num; ++j) {
-                        d += ip_table[j * real_subspace_centroid_num + encoded_codes[j]];
+                        const f32 *ip_table_j = ip_table.get() + j * real_subspace_centroid_num;
+                        const u32 *codes_j = block_codes.get() + j * IVF_SEARCH_BLOCK_SIZE;
+                        for (u32 b = 0; b < block_n; ++b) {
+                            block_dists[b] += ip_table_j[codes_j[b]];
+                        }
                     }
-                    add_result_func(d, segment_offset);
-                }
+                });
                 break;
             }
             case KnnDistanceType::kCosine: {
@@ -1172,25 +1374,32 @@ public:
                 if (!query_ip_table) {
                     query_ip_table = ivf_parts_storage.GetIPTable(query_f32);
                 }
-                const auto centroid_ip_table = ivf_parts_storage.GetIPTable(centroid_data);
-                const auto encoded_codes = MakeUniqueForOverwrite<u32[]>(subspace_num_);
-                for (u32 i = 0; i < total_embedding_num; ++i) {
-                    const auto segment_offset = embedding_segment_offset(i);
-                    if (!satisfy_filter_func(segment_offset)) {
-                        continue;
+                // half of the l2 norm of the target grows by centroid_ip_table - subspace_centroid_norms_neg_half per subspace
+                const auto target_l2_table = ivf_parts_storage.GetIPTable(centroid_data);
+                for (u32 j = 0; j < subspace_num; ++j) {
+                    const f32 *norms_neg_half_j = ivf_parts_storage.subspace_centroid_norms_neg_half_at_subspace(j);
+                    for (u32 c = 0; c < real_subspace_centroid_num; ++c) {
+                        target_l2_table[j * real_subspace_centroid_num + c] -= norms_neg_half_j[c];
                     }
-                    pq_code_storage_->ExtractCodes(i, encoded_codes.get());
-                    f32 ip = query_centroid_ip;
-                    f32 target_l2 = centroid_l2 * 0.5f;
+                }
+                ScanBlocks(satisfy_filter_func, add_result_func, [&](const u32 *block_ids, const u32 block_n, f32 *block_dists) {
+                    extract_block_codes(block_ids, block_n);
+                    f32 target_l2[IVF_SEARCH_BLOCK_SIZE];
+                    std::fill_n(block_dists, block_n, query_centroid_ip);
+                    std::fill_n(target_l2, block_n, centroid_l2 * 0.5f);
                     for (u32 j = 0; j < subspace_num; ++j) {
-                        const auto idx = j * real_subspace_centroid_num + encoded_codes[j];
-                        ip += query_ip_table[idx];
-                        target_l2 += centroid_ip_table[idx] - ivf_parts_storage.subspace_centroid_norms_neg_half_at_subspace(j)[encoded_codes[j]];
+                        const f32 *query_ip_table_j = query_ip_table.get() + j * real_subspace_centroid_num;
+                        const f32 *target_l2_table_j = target_l2_table.get() + j * real_subspace_centroid_num;
+                        const u32 *codes_j = block_codes.get() + j * IVF_SEARCH_BLOCK_SIZE;
+                        for (u32 b = 0; b < block_n; ++b) {
+                            block_dists[b] += query_ip_table_j[codes_j[b]];
+                            target_l2[b] += target_l2_table_j[codes_j[b]];
+                        }
                     }
-                    target_l2 *= 2.0f;
-                    const auto d = ip / std::sqrt(query_l2 * target_l2);
-                    add_result_func(d, segment_offset);
-                }
+                    for (u32 b = 0; b < block_n; ++b) {
+                        block_dists[b] /= std::sqrt(query_l2 * target_l2[b] * 2.0f);
+                    }
+                });
                 break;
             }
             case KnnDistanceType::kL2: {
@@ -1199,22 +1408,28 @@ public:
                     residual_query[i] = query_f32[i] - centroid_data[i];
                 }
                 const auto residual_query_l2 = L2NormSquare<f32>(residual_query.get(), dimension);
-                const auto residual_ip_table = ivf_parts_storage.GetIPTable(residual_query.get());
-                const auto encoded_codes = MakeUniqueForOverwrite<u32[]>(subspace_num_);
-                for (u32 i = 0; i < total_embedding_num; ++i) {
-                    const auto segment_offset = embedding_segment_offset(i);
-                    if (!satisfy_filter_func(segment_offset)) {
-                        continue;
+                // half of the distance drops by residual_ip_table + subspace_centroid_norms_neg_half per subspace
+                const auto residual_table = ivf_parts_storage.GetIPTable(residual_query.get());
+                for (u32 j = 0; j < subspace_num; ++j) {
+                    const f32 *norms_neg_half_j = ivf_parts_storage.subspace_centroid_norms_neg_half_at_subspace(j);
+                    for (u32 c = 0; c < real_subspace_centroid_num; ++c) {
+                        residual_table[j * real_subspace_centroid_num + c] += norms_neg_half_j[c];
                     }
-                    pq_code_storage_->ExtractCodes(i, encoded_codes.get());
-                    f32 d = residual_query_l2 * 0.5f;
+                }
+                ScanBlocks(satisfy_filter_func, add_result_func, [&](const u32 *block_ids, const u32 block_n, f32 *block_dists) {
+                    extract_block_codes(block_ids, block_n);
+                    std::fill_n(block_dists, block_n, residual_query_l2 * 0.5f);
                     for (u32 j = 0; j < subspace_num; ++j) {
-                        d -= residual_ip_table[j * real_subspace_centroid_num + encoded_codes[j]] +
-                             ivf_parts_storage.subspace_centroid_norms_neg_half_at_subspace(j)[encoded_codes[j]];
+                        const f32 *residual_table_j = residual_table.get() + j * real_subspace_centroid_num;
+                        const u32 *codes_j = block_codes.get() + j * IVF_SEARCH_BLOCK_SIZE;
+                        for (u32 b = 0; b < block_n; ++b) {
+                            block_dists[b] -= residual_table_j[codes_j[b]];
+                        }
                     }
-                    d *= 2.0f;
-                    add_result_func(d, segment_offset);
-                }
+                    for (u32 b = 0; b < block_n; ++b) {
+                        block_dists[b] *= 2.0f;
+                    }
+                });
                 break;
             }
             default: {
@@ -1265,8 +1480,13 @@ UniquePtr<IVF_Part_Storage> IVF_Part_Storage::Make(const u32 part_id,
                 case EmbeddingDataType::kElemBFloat16: {
                     return GetPlainResult.template operator()<EmbeddingDataType::kElemBFloat16>();
                 }
+                case EmbeddingDataType::kElemBit: {
+                    if (embedding_data_type != EmbeddingDataType::kElemBit) {
+                        UnrecoverableError("Invalid IVF plain_data_type");
+                    }
+                    return MakeUnique<IVF_Part_Storage_Binary>(part_id, embedding_dimension);
+                }
                 case EmbeddingDataType::kElemDouble:
-                case EmbeddingDataType::kElemBit:
                 case EmbeddingDataType::kElemInt16:
                 case EmbeddingDataType::kElemInt32:
                 case EmbeddingDataType::kElemInt64:
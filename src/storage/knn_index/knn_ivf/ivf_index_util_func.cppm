@@ -19,9 +19,23 @@ export module ivf_index_util_func;
 import stl;
 import internal_types;
 import column_vector;
+import simd_functions;
 
 namespace infinity {
 
+export template <IsAnyOf<u8, i8, f64, Float16T, BFloat16T> ColumnEmbeddingElementT>
+void CastToF32(const ColumnEmbeddingElementT *src_data_ptr, f32 *dst_data_ptr, const u32 src_data_cnt) {
+    if constexpr (std::is_same_v<Float16T, ColumnEmbeddingElementT>) {
+        GetSIMD_FUNCTIONS().F16ToF32_func_ptr_(src_data_ptr, dst_data_ptr, src_data_cnt);
+    } else if constexpr (std::is_same_v<BFloat16T, ColumnEmbeddingElementT>) {
+        GetSIMD_FUNCTIONS().BF16ToF32_func_ptr_(src_data_ptr, dst_data_ptr, src_data_cnt);
+    } else {
+        for (u32 i = 0; i < src_data_cnt; ++i) {
+            dst_data_ptr[i] = static_cast<f32>(src_data_ptr[i]);
+        }
+    }
+}
+
 export template <IsAnyOf<u8, i8, f64, f32, Float16T, BFloat16T> ColumnEmbeddingElementT>
 Pair<const f32 *, UniquePtr<f32[]>> GetF32Ptr(const ColumnEmbeddingElementT *src_data_ptr, const u32 src_data_cnt) {
     Pair<const f32 *, UniquePtr<f32[]>> dst_data_ptr;
@@ -30,13 +44,7 @@ Pair<const f32 *, UniquePtr<f32[]>> GetF32Ptr(const ColumnEmbeddingElementT *src
     } else {
         dst_data_ptr.second = MakeUniqueForOverwrite<f32[]>(src_data_cnt);
         dst_data_ptr.first = dst_data_ptr.second.get();
-        for (u32 i = 0; i < src_data_cnt; ++i) {
-            if constexpr (std::is_same_v<f64, ColumnEmbeddingElementT>) {
-                dst_data_ptr.second[i] = static_cast<f32>(src_data_ptr[i]);
-            } else {
-                dst_data_ptr.second[i] = src_data_ptr[i];
-            }
-        }
+        CastToF32(src_data_ptr, dst_data_ptr.second.get(), src_data_cnt);
     }
     return dst_data_ptr;
 }
@@ -85,6 +93,12 @@ struct EmbeddingDataTypeToCppType<EmbeddingDataType::kElemBFloat16> {
     using type = BFloat16T;
 };
 
+// bits are packed into bytes, embedding_dimension / 8 elements per embedding
+template <>
+struct EmbeddingDataTypeToCppType<EmbeddingDataType::kElemBit> {
+    using type = u8;
+};
+
 export template <EmbeddingDataType t>
 using EmbeddingDataTypeToCppTypeT = typename EmbeddingDataTypeToCppType<t>::type;
 
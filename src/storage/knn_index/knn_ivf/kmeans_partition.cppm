@@ -14,7 +14,10 @@
 
 module;
 
+#include <algorithm>
 #include <cstring>
+#include <exception>
+#include <future>
 #include <random>
 export module kmeans_partition;
 
@@ -24,6 +27,7 @@ import index_base;
 import vector_distance;
 import logger;
 import simd_functions;
+import defer_op;
 
 namespace infinity {
 
@@ -61,6 +65,60 @@ inline void NormalizeCentroids(const u32 dimension, const u32 partition_num, Cen
     }
 }
 
+// Progress of a running k-means training, read by SHOW INDEX. iteration_max_ is 0 when no training runs.
+export struct KMeansProgress {
+    atomic_u32 iteration_{0};
+    atomic_u32 iteration_max_{0};
+    atomic_u32 training_num_{0};
+};
+
+export struct KMeansOption {
+    // the assignment and the update of every iteration are split among its threads and the calling thread
+    ThreadPool *thread_pool_ = nullptr;
+    // assign a random batch of so many training vectors per iteration instead of all of them, 0 for full batches
+    u32 mini_batch_size_ = 0;
+    KMeansProgress *progress_ = nullptr;
+};
+
+constexpr u32 kmeans_min_rows_per_task = 4096;
+
+// Split [0, n) into ranges of at least min_range_size and run func(begin, end) on them, one on the calling thread.
+template <typename Func>
+void KMeansParallelFor(ThreadPool *thread_pool, const u32 n, const u32 min_range_size, Func &&func) {
+    u32 task_n = std::max<u32>(1, n / std::max<u32>(1, min_range_size));
+    task_n = std::min<u32>(task_n, thread_pool == nullptr ? 1 : thread_pool->size() + 1);
+    if (task_n <= 1) {
+        func(0, n);
+        return;
+    }
+    const u32 range_size = (n + task_n - 1) / task_n;
+    Vector<std::future<void>> futs;
+    futs.reserve(task_n - 1);
+    for (u32 begin = range_size; begin < n; begin += range_size) {
+        const u32 end = std::min(n, begin + range_size);
+        futs.emplace_back(thread_pool->push([&func, begin, end](int) { func(begin, end); }));
+    }
+    std::exception_ptr exception;
+    try {
+        func(0, std::min(n, range_size));
+    } catch (...) {
+        exception = std::current_exception();
+    }
+    // the tasks reference func, wait for all of them before rethrowing
+    for (auto &fut : futs) {
+        try {
+            fut.get();
+        } catch (...) {
+            if (!exception) {
+                exception = std::current_exception();
+            }
+        }
+    }
+    if (exception) {
+        std::rethrow_exception(exception);
+    }
+}
+
 // CentroidsType: the type to calculate centroids
 // partition_num: the number of partitions, default to sqrt(vector_count)
 // iteration_max: the max iteration count, default to 10
@@ -75,7 +133,8 @@ export template <typename ElemType, typename CentroidsOutputType>
                                      u32 iteration_max = 0,
                                      u32 min_points_per_centroid = 32,
                                      u32 max_points_per_centroid = 256,
-                                     float centroids_num_ratio = 1.0f) {
+                                     float centroids_num_ratio = 1.0f,
+                                     const KMeansOption &kmeans_option = {}) {
     using CentroidsType = f32;
     switch (metric) {
         case MetricType::kMetricL2:
@@ -83,6 +142,7 @@ export template <typename ElemType, typename CentroidsOutputType>
         case MetricType::kMetricInnerProduct: {
             break;
         }
+        case MetricType::kMetricHamming:
         case MetricType::kInvalid: {
             UnrecoverableError("Metric type not implemented");
         }
@@ -193,30 +253,88 @@ export template <typename ElemType, typename CentroidsOutputType>
         }
     }
 
+    const bool mini_batch = kmeans_option.mini_batch_size_ > 0 && kmeans_option.mini_batch_size_ < training_data_num;
+    if (mini_batch) {
+        // every training vector is visited once on average
+        iteration_max = std::max(iteration_max, (training_data_num + kmeans_option.mini_batch_size_ - 1) / kmeans_option.mini_batch_size_);
+    }
+    KMeansProgress *progress = kmeans_option.progress_;
+    if (progress != nullptr) {
+        progress->training_num_.store(training_data_num);
+        progress->iteration_.store(0);
+        progress->iteration_max_.store(iteration_max);
+    }
+    DeferFn reset_progress([progress] {
+        if (progress != nullptr) {
+            progress->iteration_max_.store(0);
+        }
+    });
+    ThreadPool *thread_pool = kmeans_option.thread_pool_;
+    auto search_top_1_with_dis = GetSIMD_FUNCTIONS().SearchTop1WithDisF32U32_func_ptr_;
+    // the sgemm based search of the nearest centroids, the vectors are split among the threads
+    auto assign = [&](const CentroidsType *data, const u32 data_num, u32 *partition_ids, f32 *distances) {
+        KMeansParallelFor(thread_pool, data_num, kmeans_min_rows_per_task, [&](const u32 begin, const u32 end) {
+            search_top_1_with_dis(dimension,
+                                  end - begin,
+                                  data + static_cast<SizeT>(begin) * dimension,
+                                  partition_num,
+                                  centroids,
+                                  partition_ids + begin,
+                                  distances + begin);
+        });
+    };
+
+    if (mini_batch) {
+        // mini-batch k-means: a centroid moves towards each of its batch vectors by 1 / (the vectors it has got so far)
+        const u32 batch_size = kmeans_option.mini_batch_size_;
+        auto batch_data = MakeUniqueForOverwrite<CentroidsType[]>(static_cast<SizeT>(batch_size) * dimension);
+        Vector<u32> batch_partition_id(batch_size);
+        Vector<f32> batch_distance(batch_size);
+        Vector<u32> partition_seen_count(partition_num, 0);
+        std::mt19937 gen(std::random_device{}());
+        std::uniform_int_distribution<u32> dis(0, training_data_num - 1);
+        for (u32 iter = 1; iter <= iteration_max; ++iter) {
+            for (u32 i = 0; i < batch_size; ++i) {
+                memcpy(batch_data.get() + static_cast<SizeT>(i) * dimension,
+                       training_data + static_cast<SizeT>(dis(gen)) * dimension,
+                       dimension * sizeof(CentroidsType));
+            }
+            assign(batch_data.get(), batch_size, batch_partition_id.data(), batch_distance.data());
+            for (u32 i = 0; i < batch_size; ++i) {
+                const u32 partition_id = batch_partition_id[i];
+                const f32 eta = 1.0f / static_cast<f32>(++partition_seen_count[partition_id]);
+                CentroidsType *centroid = centroids + static_cast<SizeT>(partition_id) * dimension;
+                const CentroidsType *vector_i = batch_data.get() + static_cast<SizeT>(i) * dimension;
+                for (u32 j = 0; j < dimension; ++j) {
+                    centroid[j] += eta * (vector_i[j] - centroid[j]);
+                }
+            }
+            if ((iter < iteration_max) && (metric == MetricType::kMetricInnerProduct || metric == MetricType::kMetricCosine)) {
+                NormalizeCentroids(dimension, partition_num, centroids);
+            }
+            if (progress != nullptr) {
+                progress->iteration_.store(iter);
+            }
+        }
+    }
+
     // Record some information
     f32 previous_total_distance = std::numeric_limits<f32>::max();
     // Assign each vector to a partition
-    Vector<u32> training_data_partition_id(training_data_num);
+    Vector<u32> training_data_partition_id(mini_batch ? 0 : training_data_num);
     // Distance
-    Vector<f32> partition_element_distance(training_data_num);
+    Vector<f32> partition_element_distance(mini_batch ? 0 : training_data_num);
     // Record the number of vectors in each partition
     Vector<u32> partition_element_count(partition_num);
 
     // Iteration
-    for (u32 iter = 1; iter <= iteration_max; ++iter) {
+    for (u32 iter = 1; iter <= iteration_max && !mini_batch; ++iter) {
         // info
         f32 this_iter_distance = 0;
         // First : assign each training vector to a partition
         {
             // search top 1
-            auto search_top_1_with_dis = GetSIMD_FUNCTIONS().SearchTop1WithDisF32U32_func_ptr_;
-            search_top_1_with_dis(dimension,
-                                  training_data_num,
-                                  training_data,
-                                  partition_num,
-                                  centroids,
-                                  training_data_partition_id.data(),
-                                  partition_element_distance.data());
+            assign(training_data, training_data_num, training_data_partition_id.data(), partition_element_distance.data());
             // Clear partition_element_count
             memset(partition_element_count.data(), 0, sizeof(u32) * partition_num);
             // calculate partition_element_count
@@ -228,16 +346,25 @@ export template <typename ElemType, typename CentroidsOutputType>
         }
         // Second : update centroids
         {
-            // Clear old centroids data
-            memset(centroids, 0, sizeof(CentroidsType) * partition_num * dimension);
-            // Sum
-            for (u32 i = 0; i < training_data_num; ++i) {
-                auto vector_pos_i = training_data + i * dimension;
-                auto centroid_pos_i = centroids + training_data_partition_id[i] * dimension;
-                for (u32 j = 0; j < dimension; ++j) {
-                    centroid_pos_i[j] += vector_pos_i[j];
+            // Each thread sums the vectors of a range of partitions
+            KMeansParallelFor(thread_pool, partition_num, 1, [&](const u32 partition_begin, const u32 partition_end) {
+                // Clear old centroids data
+                memset(centroids + static_cast<SizeT>(partition_begin) * dimension,
+                       0,
+                       sizeof(CentroidsType) * (partition_end - partition_begin) * dimension);
+                // Sum
+                for (u32 i = 0; i < training_data_num; ++i) {
+                    const u32 partition_id = training_data_partition_id[i];
+                    if (partition_id < partition_begin || partition_id >= partition_end) {
+                        continue;
+                    }
+                    auto vector_pos_i = training_data + static_cast<SizeT>(i) * dimension;
+                    auto centroid_pos_i = centroids + static_cast<SizeT>(partition_id) * dimension;
+                    for (u32 j = 0; j < dimension; ++j) {
+                        centroid_pos_i[j] += vector_pos_i[j];
+                    }
                 }
-            }
+            });
             // For L2 metric, divide the count. If there is no vector in a partition, the centroid of this partition will not be updated.
             // For IP metric, normalize centroids.
             if ((iter < iteration_max) && (metric == MetricType::kMetricInnerProduct || metric == MetricType::kMetricCosine)) {
@@ -287,6 +414,10 @@ export template <typename ElemType, typename CentroidsOutputType>
             }
         }
 
+        if (progress != nullptr) {
+            progress->iteration_.store(iter);
+        }
+
         // TODO:stop condition?
         if (metric == MetricType::kMetricL2 && this_iter_distance >= previous_total_distance)
             break;
@@ -304,4 +435,111 @@ export template <typename ElemType, typename CentroidsOutputType>
     return partition_num;
 }
 
+// k-majority on bit vectors packed into bytes: the vectors are assigned by hamming distance,
+// every bit of a centroid is the majority vote of the bits of its partition, the centroids stay packed.
+export [[nodiscard]] u32 GetBinaryKMeansCentroids(const u32 dimension,
+                                                  const u32 vector_count,
+                                                  const u8 *vectors_ptr,
+                                                  Vector<u8> &centroids_output_vector,
+                                                  u32 partition_num = 0,
+                                                  u32 iteration_max = 0,
+                                                  u32 max_points_per_centroid = 256,
+                                                  float centroids_num_ratio = 1.0f) {
+    if (dimension <= 0 || dimension % 8 != 0 || vector_count <= 0) {
+        UnrecoverableError("Dimension must be positive multiple of 8, and vector_count must be positive");
+    }
+    if (vectors_ptr == nullptr) {
+        UnrecoverableError("vectors_ptr cannot be nullptr");
+    }
+    if (partition_num > vector_count) {
+        UnrecoverableError("partition_num cannot be greater than vector_count");
+    }
+    if (partition_num <= 0) {
+        partition_num = std::clamp<u32>(static_cast<u32>(sqrt(vector_count) * centroids_num_ratio), 1, vector_count);
+    }
+    if (iteration_max <= 0) {
+        iteration_max = default_iteration_max;
+    }
+    const u32 bytes = dimension / 8;
+
+    u32 training_data_num = vector_count;
+    const u8 *training_data = vectors_ptr;
+    UniquePtr<u8[]> random_training_data;
+    Vector<u32> random_ids = RandomPermutatePartially(vector_count, 0);
+    if (u32 max_num = max_points_per_centroid * partition_num; vector_count > max_num) {
+        training_data_num = max_num;
+        random_training_data = MakeUniqueForOverwrite<u8[]>(bytes * training_data_num);
+        for (u32 i = 0; i < training_data_num; ++i) {
+            memcpy(random_training_data.get() + i * bytes, vectors_ptr + random_ids[i] * bytes, bytes);
+        }
+        training_data = random_training_data.get();
+        std::iota(random_ids.begin(), random_ids.begin() + training_data_num, static_cast<u32>(0));
+    }
+
+    centroids_output_vector.resize(bytes * partition_num);
+    u8 *centroids = centroids_output_vector.data();
+    for (u32 i = 0; i < partition_num; ++i) {
+        memcpy(centroids + i * bytes, training_data + random_ids[i] * bytes, bytes);
+    }
+
+    const auto hamming = GetSIMD_FUNCTIONS().HammingDistance_func_ptr_;
+    Vector<u32> training_data_partition_id(training_data_num, std::numeric_limits<u32>::max());
+    Vector<f32> partition_element_distance(training_data_num);
+    Vector<u32> partition_element_count(partition_num);
+    Vector<u32> bit_count(partition_num * dimension);
+    for (u32 iter = 1; iter <= iteration_max; ++iter) {
+        // First : assign each training vector to the nearest centroid
+        u32 changed_num = 0;
+        for (u32 i = 0; i < training_data_num; ++i) {
+            const u8 *vector_i = training_data + i * bytes;
+            u32 best_id = 0;
+            f32 best_dist = std::numeric_limits<f32>::max();
+            for (u32 k = 0; k < partition_num; ++k) {
+                if (const f32 dist = hamming(vector_i, centroids + k * bytes, bytes); dist < best_dist) {
+                    best_dist = dist;
+                    best_id = k;
+                }
+            }
+            changed_num += training_data_partition_id[i] != best_id;
+            training_data_partition_id[i] = best_id;
+            partition_element_distance[i] = best_dist;
+        }
+        if (changed_num == 0) {
+            break;
+        }
+        // Second : vote the bits of the centroids
+        std::fill(partition_element_count.begin(), partition_element_count.end(), 0);
+        std::fill(bit_count.begin(), bit_count.end(), 0);
+        for (u32 i = 0; i < training_data_num; ++i) {
+            const u32 partition_id = training_data_partition_id[i];
+            ++partition_element_count[partition_id];
+            const u8 *vector_i = training_data + i * bytes;
+            u32 *bit_count_i = bit_count.data() + partition_id * dimension;
+            for (u32 j = 0; j < dimension; ++j) {
+                bit_count_i[j] += (vector_i[j / 8] >> (j % 8)) & 1;
+            }
+        }
+        for (u32 k = 0; k < partition_num; ++k) {
+            if (const u32 cnt = partition_element_count[k]; cnt > 0) {
+                u8 *centroid = centroids + k * bytes;
+                memset(centroid, 0, bytes);
+                const u32 *bit_count_k = bit_count.data() + k * dimension;
+                for (u32 j = 0; j < dimension; ++j) {
+                    centroid[j / 8] |= static_cast<u8>(2 * bit_count_k[j] > cnt) << (j % 8);
+                }
+            }
+        }
+        // Third : a vacant partition takes the vector farthest from its centroid
+        for (u32 k = 0; k < partition_num; ++k) {
+            if (partition_element_count[k] == 0) {
+                const auto farthest = std::max_element(partition_element_distance.begin(), partition_element_distance.end());
+                const u32 i = farthest - partition_element_distance.begin();
+                memcpy(centroids + k * bytes, training_data + i * bytes, bytes);
+                *farthest = 0;
+            }
+        }
+    }
+    return partition_num;
+}
+
 } // namespace infinity
@@ -64,6 +64,7 @@ import local_file_handle;
 import admin_statement;
 import global_resource_usage;
 import snapshot_info;
+import catalog_checkpoint;
 
 namespace infinity {
 
@@ -1116,25 +1117,13 @@ UniquePtr<Catalog> Catalog::LoadFullCheckpoint(const String &file_name) {
         VirtualStore::AddCacheMissCount();
     }
 
-    auto [catalog_file_handle, status] = VirtualStore::Open(catalog_path, FileAccessMode::kRead);
-    if (!status.ok()) {
-        UnrecoverableError(status.message());
-    }
-
-    i64 file_size = catalog_file_handle->FileSize();
-    String json_str(file_size, 0);
-    auto [n_bytes, status_read] = catalog_file_handle->Read(json_str.data(), file_size);
-    if (!status.ok()) {
-        RecoverableError(status_read);
-    }
-    if ((SizeT)file_size != n_bytes) {
-        Status status = Status::FileCorrupted(catalog_path);
-        RecoverableError(status);
-    }
-
-    nlohmann::json catalog_json = nlohmann::json::parse(json_str);
-
+    CatalogCheckpointReader reader(catalog_path);
     BufferManager *buffer_mgr = InfinityContext::instance().storage()->buffer_manager();
+    if (reader.IsBinary()) {
+        return Deserialize(reader, buffer_mgr);
+    }
+    // Full checkpoint of the json format, written before the binary format
+    nlohmann::json catalog_json = reader.ReadJson();
     return Deserialize(catalog_json, buffer_mgr);
 }
 
@@ -1158,6 +1147,56 @@ UniquePtr<Catalog> Catalog::Deserialize(const nlohmann::json &catalog_json, Buff
     return catalog;
 }
 
+UniquePtr<Catalog> Catalog::Deserialize(const CatalogCheckpointReader &reader, BufferManager *buffer_mgr) {
+    auto catalog = MakeUnique<Catalog>();
+    catalog->next_txn_id_ = reader.next_txn_id();
+    catalog->full_ckp_commit_ts_ = reader.full_ckp_commit_ts();
+
+    // A database section is followed by its tables, so only one database is held in json at a time.
+    const auto &sections = reader.sections();
+    nlohmann::json db_meta_json;
+    u32 db_section_idx = 0;
+    auto add_db_meta = [&] {
+        if (!db_meta_json.is_null()) {
+            UniquePtr<DBMeta> db_meta = DBMeta::Deserialize(db_meta_json, buffer_mgr);
+            catalog->db_meta_map_.AddNewMetaNoLock(*db_meta->db_name(), std::move(db_meta));
+            db_meta_json = nlohmann::json();
+        }
+    };
+    for (u32 section_idx = 0; section_idx < sections.size(); ++section_idx) {
+        const CatalogSection &section = sections[section_idx];
+        switch (section.kind_) {
+            case CatalogSectionKind::kDatabase: {
+                add_db_meta();
+                db_meta_json = reader.ReadSection(section);
+                db_section_idx = section_idx;
+                break;
+            }
+            case CatalogSectionKind::kTable: {
+                if (db_meta_json.is_null() || section.parent_ != db_section_idx || section.entry_idx_ >= db_meta_json["db_entries"].size()) {
+                    String error_message = fmt::format("Table section {} is not after its database section {}", section_idx, section.parent_);
+                    UnrecoverableError(error_message);
+                }
+                db_meta_json["db_entries"][section.entry_idx_]["tables"].emplace_back(reader.ReadSection(section));
+                break;
+            }
+            case CatalogSectionKind::kObjectAddrMap: {
+                PersistenceManager *pm = InfinityContext::instance().persistence_manager();
+                if (pm != nullptr) {
+                    pm->Deserialize(reader.ReadSection(section));
+                }
+                break;
+            }
+            default: {
+                String error_message = fmt::format("Unknown catalog section kind: {}", static_cast<u8>(section.kind_));
+                UnrecoverableError(error_message);
+            }
+        }
+    }
+    add_db_meta();
+    return catalog;
+}
+
 void Catalog::SaveFullCatalog(TxnTimeStamp max_commit_ts, String &full_catalog_path, String &full_catalog_name) {
     full_catalog_path = *catalog_dir_;
     full_catalog_name = CatalogFile::FullCheckpointFilename(max_commit_ts);
@@ -1165,23 +1204,70 @@ void Catalog::SaveFullCatalog(TxnTimeStamp max_commit_ts, String &full_catalog_p
     String catalog_tmp_path =
         Path(InfinityContext::instance().config()->DataDir()) / *catalog_dir_ / CatalogFile::TempFullCheckpointFilename(max_commit_ts);
 
-    // Serialize catalog to string
     full_ckp_commit_ts_ = max_commit_ts;
-    nlohmann::json catalog_json = Serialize(max_commit_ts);
-    String catalog_str = catalog_json.dump();
+    // Pick the changes before serializing, the tables changed meanwhile are serialized again by the next full checkpoint.
+    Optional<HashSet<String>> dirty_encodes = global_catalog_delta_entry_->PickCheckpointDirty();
+    bool saved = false;
+    DeferFn defer_fn([&] {
+        if (!saved) {
+            // The picked changes are lost, so none of the cached sections can be trusted.
+            ckp_table_sections_.clear();
+        }
+    });
+    auto is_dirty = [&](const String &encode) { return !dirty_encodes.has_value() || dirty_encodes->contains(encode); };
 
-    // Save catalog to tmp file.
-    // FIXME: Temp implementation, will be replaced by async task.
-    auto [catalog_file_handle, status] = VirtualStore::Open(catalog_tmp_path, FileAccessMode::kWrite);
-    if (!status.ok()) {
-        UnrecoverableError(fmt::format("{}: {}", catalog_tmp_path, status.message()));
+    // Write the catalog section by section, the section of a table not changed since the last full checkpoint is reused.
+    CatalogCheckpointWriter writer(catalog_tmp_path, next_txn_id_, max_commit_ts);
+    HashMap<TableMeta *, CheckpointTableSection> table_sections;
+    SizeT reused_table_count = 0;
+    {
+        auto [_, db_meta_ptrs, meta_lock] = db_meta_map_.GetAllMetaGuard();
+        for (DBMeta *db_meta : db_meta_ptrs) {
+            nlohmann::json db_meta_json;
+            db_meta_json["db_name"] = *db_meta->db_name();
+            Vector<BaseEntry *> db_entries = db_meta->db_entry_list_.GetCandidateEntry(max_commit_ts, EntryType::kDatabase);
+            for (BaseEntry *entry : db_entries) {
+                db_meta_json["db_entries"].emplace_back(static_cast<DBEntry *>(entry)->Serialize(max_commit_ts, false));
+            }
+            u32 db_section_idx = writer.AddSection(CatalogSectionKind::kDatabase, 0, 0, nlohmann::json::to_msgpack(db_meta_json));
+
+            for (u32 entry_idx = 0; entry_idx < db_entries.size(); ++entry_idx) {
+                auto *db_entry = static_cast<DBEntry *>(db_entries[entry_idx]);
+                bool db_dirty = is_dirty(db_entry->encode());
+                auto [table_names, table_metas, table_meta_lock] = db_entry->GetAllTableMetas();
+                for (TableMeta *table_meta : table_metas) {
+                    String encode = TableEntry::EncodeIndex(table_meta->table_name(), table_meta);
+                    SharedPtr<Vector<u8>> payload;
+                    auto iter = ckp_table_sections_.find(table_meta);
+                    if (!db_dirty && !is_dirty(encode) && iter != ckp_table_sections_.end() && iter->second.encode_ == encode) {
+                        payload = iter->second.payload_;
+                        ++reused_table_count;
+                    } else {
+                        payload = MakeShared<Vector<u8>>(nlohmann::json::to_msgpack(table_meta->Serialize(max_commit_ts)));
+                    }
+                    writer.AddSection(CatalogSectionKind::kTable, db_section_idx, entry_idx, *payload);
+                    table_sections.emplace(table_meta, CheckpointTableSection{std::move(encode), std::move(payload)});
+                }
+            }
+        }
     }
 
-    status = catalog_file_handle->Append(catalog_str.data(), catalog_str.size());
-    if (!status.ok()) {
-        RecoverableError(status);
+    PersistenceManager *pm = InfinityContext::instance().persistence_manager();
+    if (pm != nullptr) {
+        PersistResultHandler handler(pm);
+        // Finalize current object to ensure PersistenceManager be in a consistent state
+        PersistWriteResult result = pm->CurrentObjFinalize(true);
+        handler.HandleWriteResult(result);
+
+        writer.AddSection(CatalogSectionKind::kObjectAddrMap, 0, 0, nlohmann::json::to_msgpack(pm->Serialize()));
     }
-    catalog_file_handle->Sync();
+    writer.Finish();
+    ckp_table_sections_ = std::move(table_sections);
+    saved = true;
+    LOG_INFO(fmt::format("Full checkpoint {} bytes, {} tables, {} of them reused",
+                         writer.FileSize(),
+                         ckp_table_sections_.size(),
+                         reused_table_count));
 
     // Rename temp file to regular catalog file
     VirtualStore::Rename(catalog_tmp_path, full_path);
@@ -1194,6 +1280,10 @@ void Catalog::SaveFullCatalog(TxnTimeStamp max_commit_ts, String &full_catalog_p
     LOG_DEBUG(fmt::format("Saved catalog to: {}", full_path));
 }
 
+void Catalog::MarkCheckpointDirty(std::string_view encode) { global_catalog_delta_entry_->MarkCheckpointDirty(encode); }
+
+void Catalog::MarkCheckpointAllDirty() { global_catalog_delta_entry_->MarkCheckpointAllDirty(); }
+
 // called by bg_task
 bool Catalog::SaveDeltaCatalog(TxnTimeStamp last_ckp_ts, TxnTimeStamp &max_commit_ts, String &delta_catalog_path, String &delta_catalog_name) {
     // Pick the delta entry to flush and set the max commit ts.
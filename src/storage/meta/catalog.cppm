@@ -85,6 +85,8 @@ public:
 
 class GlobalCatalogDeltaEntry;
 class CatalogDeltaEntry;
+class CatalogCheckpointReader;
+struct TableMeta;
 export struct Catalog {
 public:
     Catalog();
@@ -258,11 +260,18 @@ public:
     static UniquePtr<Catalog> LoadFullCheckpoint(const String &file_name);
     void AttachDeltaCheckpoint(const String &file_name);
 
+    // Mark the database or table of the entry encode as changed, its section of the full checkpoint is serialized again.
+    void MarkCheckpointDirty(std::string_view encode);
+
+    void MarkCheckpointAllDirty();
+
     static UniquePtr<CatalogDeltaEntry> LoadFromFileDelta(const String &catalog_path);
 
 private:
     static UniquePtr<Catalog> Deserialize(const nlohmann::json &catalog_json, BufferManager *buffer_mgr);
 
+    static UniquePtr<Catalog> Deserialize(const CatalogCheckpointReader &reader, BufferManager *buffer_mgr);
+
     void LoadFromEntryDelta(UniquePtr<CatalogDeltaEntry> delta_entry, BufferManager *buffer_mgr);
 
 public:
@@ -323,6 +332,13 @@ public:
 
 private:
     UniquePtr<GlobalCatalogDeltaEntry> global_catalog_delta_entry_{MakeUnique<GlobalCatalogDeltaEntry>()};
+
+    // The table sections written by the last full checkpoint, reused by the next one if the table is not changed meanwhile.
+    struct CheckpointTableSection {
+        String encode_{};
+        SharedPtr<Vector<u8>> payload_{};
+    };
+    HashMap<TableMeta *, CheckpointTableSection> ckp_table_sections_{};
 };
 
 } // namespace infinity
@@ -0,0 +1,163 @@
+// Copyright(C) 2023 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+module;
+
+#include <cstring>
+#include <filesystem>
+
+module catalog_checkpoint;
+
+import stl;
+import third_party;
+import local_file_handle;
+import virtual_store;
+import serialize;
+import crc;
+import status;
+import infinity_exception;
+import logger;
+
+namespace infinity {
+
+namespace {
+
+constexpr SizeT HEADER_SIZE = sizeof(CATALOG_CHECKPOINT_MAGIC) + sizeof(u32) + sizeof(TransactionID) + sizeof(TxnTimeStamp);
+constexpr SizeT SECTION_INDEX_SIZE = sizeof(u8) + sizeof(u32) * 2 + sizeof(u64) * 2 + sizeof(u32);
+constexpr SizeT FOOTER_SIZE = sizeof(u64) + sizeof(u32) + sizeof(CATALOG_CHECKPOINT_MAGIC);
+
+bool HasMagic(const char *ptr) { return std::memcmp(ptr, CATALOG_CHECKPOINT_MAGIC, sizeof(CATALOG_CHECKPOINT_MAGIC)) == 0; }
+
+} // namespace
+
+CatalogCheckpointWriter::CatalogCheckpointWriter(const String &path, TransactionID next_txn_id, TxnTimeStamp full_ckp_commit_ts) : path_(path) {
+    auto [file_handle, status] = VirtualStore::Open(path_, FileAccessMode::kWrite);
+    if (!status.ok()) {
+        UnrecoverableError(fmt::format("{}: {}", path_, status.message()));
+    }
+    file_handle_ = std::move(file_handle);
+
+    char header[HEADER_SIZE];
+    char *ptr = header;
+    std::memcpy(ptr, CATALOG_CHECKPOINT_MAGIC, sizeof(CATALOG_CHECKPOINT_MAGIC));
+    ptr += sizeof(CATALOG_CHECKPOINT_MAGIC);
+    WriteBufAdv(ptr, CATALOG_CHECKPOINT_VERSION);
+    WriteBufAdv(ptr, next_txn_id);
+    WriteBufAdv(ptr, full_ckp_commit_ts);
+    Write(header, HEADER_SIZE);
+}
+
+u32 CatalogCheckpointWriter::AddSection(CatalogSectionKind kind, u32 parent, u32 entry_idx, const Vector<u8> &payload) {
+    CatalogSection section{.kind_ = kind,
+                           .parent_ = parent,
+                           .entry_idx_ = entry_idx,
+                           .offset_ = offset_,
+                           .size_ = payload.size(),
+                           .checksum_ = CRC32IEEE::makeCRC(payload.data(), payload.size())};
+    Write(payload.data(), payload.size());
+    sections_.push_back(section);
+    return sections_.size() - 1;
+}
+
+void CatalogCheckpointWriter::Finish() {
+    u64 index_offset = offset_;
+    Vector<char> buffer(SECTION_INDEX_SIZE * sections_.size() + FOOTER_SIZE);
+    char *ptr = buffer.data();
+    for (const auto &section : sections_) {
+        WriteBufAdv(ptr, static_cast<u8>(section.kind_));
+        WriteBufAdv(ptr, section.parent_);
+        WriteBufAdv(ptr, section.entry_idx_);
+        WriteBufAdv(ptr, section.offset_);
+        WriteBufAdv(ptr, section.size_);
+        WriteBufAdv(ptr, section.checksum_);
+    }
+    WriteBufAdv(ptr, index_offset);
+    WriteBufAdv(ptr, static_cast<u32>(sections_.size()));
+    std::memcpy(ptr, CATALOG_CHECKPOINT_MAGIC, sizeof(CATALOG_CHECKPOINT_MAGIC));
+    Write(buffer.data(), buffer.size());
+
+    Status status = file_handle_->Sync();
+    if (!status.ok()) {
+        UnrecoverableError(fmt::format("{}: {}", path_, status.message()));
+    }
+    file_handle_.reset();
+}
+
+void CatalogCheckpointWriter::Write(const void *data, SizeT size) {
+    if (size == 0) {
+        return;
+    }
+    Status status = file_handle_->Append(data, size);
+    if (!status.ok()) {
+        RecoverableError(status);
+    }
+    offset_ += size;
+}
+
+CatalogCheckpointReader::CatalogCheckpointReader(const String &path) : path_(std::filesystem::absolute(path).string()) {
+    if (VirtualStore::MmapFile(path_, data_, size_) < 0) {
+        UnrecoverableError(Status::MmapFileError(path_).message());
+    }
+    is_binary_ = size_ >= HEADER_SIZE + FOOTER_SIZE && HasMagic(reinterpret_cast<const char *>(data_));
+    if (is_binary_) {
+        ParseIndex();
+    }
+}
+
+CatalogCheckpointReader::~CatalogCheckpointReader() { VirtualStore::MunmapFile(path_); }
+
+void CatalogCheckpointReader::ParseIndex() {
+    const char *ptr = reinterpret_cast<const char *>(data_) + sizeof(CATALOG_CHECKPOINT_MAGIC);
+    auto version = ReadBufAdv<u32>(ptr);
+    if (version != CATALOG_CHECKPOINT_VERSION) {
+        UnrecoverableError(fmt::format("Unsupported catalog checkpoint version {} of {}", version, path_));
+    }
+    next_txn_id_ = ReadBufAdv<TransactionID>(ptr);
+    full_ckp_commit_ts_ = ReadBufAdv<TxnTimeStamp>(ptr);
+
+    ptr = reinterpret_cast<const char *>(data_) + size_ - FOOTER_SIZE;
+    auto index_offset = ReadBufAdv<u64>(ptr);
+    auto section_count = ReadBufAdv<u32>(ptr);
+    if (!HasMagic(ptr) || index_offset < HEADER_SIZE || index_offset + SECTION_INDEX_SIZE * section_count + FOOTER_SIZE != size_) {
+        RecoverableError(Status::FileCorrupted(path_));
+    }
+
+    ptr = reinterpret_cast<const char *>(data_) + index_offset;
+    sections_.reserve(section_count);
+    for (u32 i = 0; i < section_count; ++i) {
+        CatalogSection section;
+        section.kind_ = static_cast<CatalogSectionKind>(ReadBufAdv<u8>(ptr));
+        section.parent_ = ReadBufAdv<u32>(ptr);
+        section.entry_idx_ = ReadBufAdv<u32>(ptr);
+        section.offset_ = ReadBufAdv<u64>(ptr);
+        section.size_ = ReadBufAdv<u64>(ptr);
+        section.checksum_ = ReadBufAdv<u32>(ptr);
+        if (section.offset_ < HEADER_SIZE || section.offset_ + section.size_ > index_offset) {
+            RecoverableError(Status::FileCorrupted(path_));
+        }
+        sections_.push_back(section);
+    }
+}
+
+nlohmann::json CatalogCheckpointReader::ReadJson() const { return nlohmann::json::parse(data_, data_ + size_); }
+
+nlohmann::json CatalogCheckpointReader::ReadSection(const CatalogSection &section) const {
+    const u8 *payload = data_ + section.offset_;
+    if (CRC32IEEE::makeCRC(payload, section.size_) != section.checksum_) {
+        RecoverableError(Status::DataCorrupted(path_));
+    }
+    return nlohmann::json::from_msgpack(payload, payload + section.size_);
+}
+
+} // namespace infinity
@@ -0,0 +1,108 @@
+// Copyright(C) 2023 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+module;
+
+export module catalog_checkpoint;
+
+import stl;
+import third_party;
+import local_file_handle;
+
+namespace infinity {
+
+// Binary full checkpoint of the catalog, written section by section while the catalog is serialized.
+//   header:  magic | version u32 | next_txn_id u64 | full_ckp_commit_ts u64
+//   body:    the payloads of the sections back to back, each one a msgpack document
+//   index:   kind u8 | parent u32 | entry_idx u32 | offset u64 | size u64 | checksum u32 of each section
+//   footer:  index offset u64 | section count u32 | magic
+// A database section is followed by the sections of its tables, a table section refers to the database section by `parent_`
+// and to the db entry by `entry_idx_`.
+export constexpr char CATALOG_CHECKPOINT_MAGIC[8] = {'I', 'N', 'F', 'C', 'A', 'T', 'L', 'G'};
+export constexpr u32 CATALOG_CHECKPOINT_VERSION = 1;
+
+export enum class CatalogSectionKind : u8 {
+    kDatabase,
+    kTable,
+    kObjectAddrMap,
+};
+
+export struct CatalogSection {
+    CatalogSectionKind kind_{};
+    u32 parent_{};
+    u32 entry_idx_{};
+    u64 offset_{};
+    u64 size_{};
+    u32 checksum_{};
+};
+
+export class CatalogCheckpointWriter {
+public:
+    CatalogCheckpointWriter(const String &path, TransactionID next_txn_id, TxnTimeStamp full_ckp_commit_ts);
+
+    // Append the payload to the file, return the index of the section.
+    u32 AddSection(CatalogSectionKind kind, u32 parent, u32 entry_idx, const Vector<u8> &payload);
+
+    // Write the index and the footer, then sync the file.
+    void Finish();
+
+    [[nodiscard]] SizeT FileSize() const { return offset_; }
+
+private:
+    void Write(const void *data, SizeT size);
+
+    String path_{};
+    UniquePtr<LocalFileHandle> file_handle_{};
+    u64 offset_{};
+    Vector<CatalogSection> sections_{};
+};
+
+// Read a full checkpoint from the mmapped file. A file without the magic is a full checkpoint of the json format.
+export class CatalogCheckpointReader {
+public:
+    explicit CatalogCheckpointReader(const String &path);
+
+    ~CatalogCheckpointReader();
+
+    CatalogCheckpointReader(const CatalogCheckpointReader &) = delete;
+
+    CatalogCheckpointReader &operator=(const CatalogCheckpointReader &) = delete;
+
+    [[nodiscard]] bool IsBinary() const { return is_binary_; }
+
+    // The whole json document of the old format.
+    [[nodiscard]] nlohmann::json ReadJson() const;
+
+    // Verify the checksum and decode the payload of the section.
+    [[nodiscard]] nlohmann::json ReadSection(const CatalogSection &section) const;
+
+    [[nodiscard]] const Vector<CatalogSection> &sections() const { return sections_; }
+
+    [[nodiscard]] TransactionID next_txn_id() const { return next_txn_id_; }
+
+    [[nodiscard]] TxnTimeStamp full_ckp_commit_ts() const { return full_ckp_commit_ts_; }
+
+private:
+    void ParseIndex();
+
+    String path_{};
+    u8 *data_{};
+    SizeT size_{};
+    bool is_binary_{};
+    TransactionID next_txn_id_{};
+    TxnTimeStamp full_ckp_commit_ts_{};
+    Vector<CatalogSection> sections_{};
+};
+
+} // namespace infinity
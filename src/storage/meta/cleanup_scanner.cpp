@@ -90,6 +90,7 @@ void CleanupScanner::AddEntry(SharedPtr<BaseEntry> entry, bool dropped) {
         default: {
         }
     }
+    catalog_->MarkCheckpointDirty(entry->encode());
     entries_.emplace_back(std::move(entry), dropped);
 }
 
@@ -42,6 +42,7 @@ import secondary_index_file_worker;
 import ivf_index_file_worker;
 import emvb_index_file_worker;
 import bmp_index_file_worker;
+import diskann_index_file_worker;
 import column_def;
 import internal_types;
 import infinity_context;
@@ -224,6 +225,35 @@ SharedPtr<ChunkIndexEntry> ChunkIndexEntry::NewEMVBIndexChunkIndexEntry(ChunkID
     return chunk_index_entry;
 }
 
+SharedPtr<ChunkIndexEntry> ChunkIndexEntry::NewDiskAnnIndexChunkIndexEntry(ChunkID chunk_id,
+                                                                           SegmentIndexEntry *segment_index_entry,
+                                                                           const String &base_name,
+                                                                           RowID base_rowid,
+                                                                           u32 row_count,
+                                                                           BufferManager *buffer_mgr) {
+    auto chunk_index_entry = MakeShared<ChunkIndexEntry>(chunk_id, segment_index_entry, base_name, base_rowid, row_count);
+    const auto &index_dir = segment_index_entry->index_dir();
+    assert(index_dir.get() != nullptr);
+    if (buffer_mgr != nullptr) {
+        const SegmentID segment_id = segment_index_entry->segment_id();
+        auto diskann_index_file_name = MakeShared<String>(IndexFileName(segment_id, chunk_id));
+        const auto &index_base = segment_index_entry->table_index_entry()->table_index_def();
+        const auto &column_def = segment_index_entry->table_index_entry()->column_def();
+        auto file_worker = MakeUnique<DiskAnnIndexFileWorker>(MakeShared<String>(InfinityContext::instance().config()->DataDir()),
+                                                              MakeShared<String>(InfinityContext::instance().config()->TempDir()),
+                                                              index_dir,
+                                                              std::move(diskann_index_file_name),
+                                                              index_base,
+                                                              column_def,
+                                                              base_rowid.segment_offset_,
+                                                              row_count,
+                                                              buffer_mgr->persistence_manager());
+        chunk_index_entry->buffer_obj_ = buffer_mgr->AllocateBufferObject(std::move(file_worker));
+        chunk_index_entry->buffer_obj_->AddObjRc();
+    }
+    return chunk_index_entry;
+}
+
 SharedPtr<ChunkIndexEntry> ChunkIndexEntry::NewBMPIndexChunkIndexEntry(ChunkID chunk_id,
                                                                        SegmentIndexEntry *segment_index_entry,
                                                                        const String &base_name,
@@ -334,6 +364,21 @@ SharedPtr<ChunkIndexEntry> ChunkIndexEntry::NewReplayChunkIndexEntry(ChunkID chu
             chunk_index_entry->buffer_obj_ = buffer_mgr->GetBufferObject(std::move(file_worker));
             break;
         }
+        case IndexType::kDiskAnn: {
+            const SegmentID segment_id = segment_index_entry->segment_id();
+            auto diskann_index_file_name = MakeShared<String>(IndexFileName(segment_id, chunk_id));
+            auto file_worker = MakeUnique<DiskAnnIndexFileWorker>(MakeShared<String>(InfinityContext::instance().config()->DataDir()),
+                                                                  MakeShared<String>(InfinityContext::instance().config()->TempDir()),
+                                                                  index_dir,
+                                                                  std::move(diskann_index_file_name),
+                                                                  index_base,
+                                                                  column_def,
+                                                                  base_rowid.segment_offset_,
+                                                                  row_count,
+                                                                  buffer_mgr->persistence_manager());
+            chunk_index_entry->buffer_obj_ = buffer_mgr->GetBufferObject(std::move(file_worker));
+            break;
+        }
         case IndexType::kBMP: {
             const SegmentID segment_id = segment_index_entry->segment_id();
             auto index_file_name = MakeShared<String>(IndexFileName(segment_id, chunk_id));
@@ -93,6 +93,13 @@ public:
                                                                   u32 row_count,
                                                                   BufferManager *buffer_mgr);
 
+    static SharedPtr<ChunkIndexEntry> NewDiskAnnIndexChunkIndexEntry(ChunkID chunk_id,
+                                                                     SegmentIndexEntry *segment_index_entry,
+                                                                     const String &base_name,
+                                                                     RowID base_rowid,
+                                                                     u32 row_count,
+                                                                     BufferManager *buffer_mgr);
+
     static SharedPtr<ChunkIndexEntry> NewBMPIndexChunkIndexEntry(ChunkID chunk_id,
                                                                  SegmentIndexEntry *segment_index_entry,
                                                                  const String &base_name,
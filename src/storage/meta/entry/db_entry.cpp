@@ -286,7 +286,7 @@ SharedPtr<String> DBEntry::ToString() {
     return res;
 }
 
-nlohmann::json DBEntry::Serialize(TxnTimeStamp max_commit_ts) {
+nlohmann::json DBEntry::Serialize(TxnTimeStamp max_commit_ts, bool with_tables) {
     nlohmann::json json_res;
 
     json_res["db_name"] = *this->db_name_;
@@ -305,7 +305,7 @@ nlohmann::json DBEntry::Serialize(TxnTimeStamp max_commit_ts) {
     }
     json_res["entry_type"] = this->entry_type_;
 
-    {
+    if (with_tables) {
         auto [_, table_meta_ptrs, meta_lock] = table_meta_map_.GetAllMetaGuard();
         for (TableMeta *table_meta : table_meta_ptrs) {
             json_res["tables"].emplace_back(table_meta->Serialize(max_commit_ts));
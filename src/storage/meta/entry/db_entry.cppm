@@ -74,7 +74,8 @@ public:
 public:
     SharedPtr<String> ToString();
 
-    nlohmann::json Serialize(TxnTimeStamp max_commit_ts);
+    // The tables are left out if `with_tables` is false, the full checkpoint writes them as separate sections.
+    nlohmann::json Serialize(TxnTimeStamp max_commit_ts, bool with_tables = true);
 
     static UniquePtr<DBEntry> Deserialize(const nlohmann::json &db_entry_json, DBMeta *db_meta, BufferManager *buffer_mgr);
 
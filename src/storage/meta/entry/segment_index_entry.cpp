@@ -69,6 +69,9 @@ import infinity_context;
 import defer_op;
 import memory_indexer;
 import hnsw_lsg_builder;
+import diskann_index_in_chunk;
+import compact_state_data;
+import roaring_bitmap;
 
 namespace infinity {
 
@@ -111,6 +114,7 @@ SegmentIndexEntry::SegmentIndexEntry(const SegmentIndexEntry &other)
     memory_secondary_index_ = other.memory_secondary_index_;
     memory_emvb_index_ = other.memory_emvb_index_;
     memory_bmp_index_ = other.memory_bmp_index_;
+    diskann_append_end_ = other.diskann_append_end_;
     ft_column_len_sum_ = other.ft_column_len_sum_;
     ft_column_len_cnt_ = other.ft_column_len_cnt_;
 }
@@ -283,9 +287,8 @@ void SegmentIndexEntry::MemIndexInsert(SharedPtr<BlockEntry> block_entry,
             break;
         }
         case IndexType::kDiskAnn: {
-            UniquePtr<String> err_msg =
-                MakeUnique<String>(fmt::format("{} realtime index is not supported yet", IndexInfo::IndexTypeToString(index_base->index_type_)));
-            LOG_WARN(*err_msg);
+            // the rows are read from the segment when the chunk is built at dump
+            diskann_append_end_ = std::max<u32>(diskann_append_end_, block_offset + row_offset + row_count);
             break;
         }
         default: {
@@ -396,6 +399,20 @@ SharedPtr<ChunkIndexEntry> SegmentIndexEntry::MemIndexDump(bool spill, SizeT *du
             memory_bmp_index_.reset();
             break;
         }
+        case IndexType::kDiskAnn: {
+            const u32 covered_row_count = DiskAnnCoveredRowCount();
+            if (diskann_append_end_ < covered_row_count + DiskAnnIndexInChunk::LeastRowCount()) {
+                // too few rows to train the PQ, leave them to the brute force search
+                return nullptr;
+            }
+            auto *table_entry = table_index_entry_->table_index_meta()->GetTableEntry();
+            SharedPtr<SegmentEntry> segment_entry = table_entry->GetSegmentByID(segment_id_, MAX_TIMESTAMP);
+            chunk_index_entry = BuildDiskAnnIndexChunk(segment_entry.get(), covered_row_count, diskann_append_end_ - covered_row_count, buffer_manager_);
+            chunk_index_entry->SaveIndexFile();
+            std::unique_lock lck(rw_locker_);
+            chunk_index_entries_.push_back(chunk_index_entry);
+            break;
+        }
         default: {
             UnrecoverableError("Not implemented.");
             break;
@@ -448,12 +465,131 @@ u32 SegmentIndexEntry::MemIndexRowCount() {
         case IndexType::kBMP: {
             return memory_bmp_index_.get() ? memory_bmp_index_->GetRowCount() : 0;
         }
+        case IndexType::kDiskAnn: {
+            const u32 covered_row_count = DiskAnnCoveredRowCount();
+            return diskann_append_end_ > covered_row_count ? diskann_append_end_ - covered_row_count : 0;
+        }
         default: {
             return 0;
         }
     }
 }
 
+bool SegmentIndexEntry::MergeCompactedHnsw(HnswIndexInMem *memory_hnsw_index,
+                                           const SegmentEntry *segment_entry,
+                                           const CompactStateData &compact_state_data,
+                                           Txn *txn) {
+    SharedPtr<ColumnDef> column_def = table_index_entry_->column_def();
+    if (column_def->type()->type() != LogicalType::kEmbedding) {
+        return false;
+    }
+    const Vector<SegmentEntry *> *old_segments = nullptr;
+    for (const auto &segment_data : compact_state_data.segment_data_list_) {
+        if (segment_data.new_segment_->segment_id() == segment_entry->segment_id()) {
+            old_segments = &segment_data.old_segments_;
+            break;
+        }
+    }
+    if (old_segments == nullptr) {
+        return false;
+    }
+
+    // the reused graph is the only chunk of its segment, which covers all rows
+    const SegmentEntry *src_segment = nullptr;
+    SharedPtr<ChunkIndexEntry> src_chunk;
+    {
+        auto guard = table_index_entry_->GetSegmentIndexesGuard();
+        for (const SegmentEntry *old_segment : *old_segments) {
+            auto iter = guard.index_by_segment_.find(old_segment->segment_id());
+            if (iter == guard.index_by_segment_.end()) {
+                continue;
+            }
+            auto [chunk_index_entries, memory_index] = iter->second->GetHnswIndexSnapshot();
+            SharedPtr<ChunkIndexEntry> chunk;
+            SizeT visible_chunk_n = 0;
+            for (auto &chunk_index_entry : chunk_index_entries) {
+                if (chunk_index_entry->CheckVisible(txn)) {
+                    chunk = chunk_index_entry;
+                    ++visible_chunk_n;
+                }
+            }
+            if (visible_chunk_n != 1 || chunk->base_rowid_.segment_offset_ != 0 || chunk->row_count_ != old_segment->row_count()) {
+                continue;
+            }
+            if (src_chunk.get() == nullptr || chunk->row_count_ > src_chunk->row_count_) {
+                src_segment = old_segment;
+                src_chunk = std::move(chunk);
+            }
+        }
+    }
+    if (src_chunk.get() == nullptr) {
+        return false;
+    }
+
+    // the rows visible at the compaction scan are copied in order, so the kept rows of the source are a range of the new segment
+    Vector<Optional<SegmentOffset>> label_map(src_segment->row_count());
+    SegmentOffset new_begin = std::numeric_limits<SegmentOffset>::max();
+    SegmentOffset new_end = 0;
+    auto src_block_iter = BlockEntryIter(src_segment);
+    for (const auto *block_entry = src_block_iter.Next(); block_entry != nullptr; block_entry = src_block_iter.Next()) {
+        BlockOffset read_offset = 0;
+        while (true) {
+            auto [row_begin, row_end] = block_entry->GetVisibleRange(compact_state_data.scan_ts_, read_offset);
+            if (row_begin == row_end) {
+                break;
+            }
+            for (BlockOffset row = row_begin; row < row_end; ++row) {
+                RowID new_row_id = compact_state_data.remapper_.GetNewRowID(src_segment->segment_id(), block_entry->block_id(), row);
+                label_map[block_entry->segment_offset() + row] = new_row_id.segment_offset_;
+                new_begin = std::min(new_begin, new_row_id.segment_offset_);
+                new_end = std::max(new_end, new_row_id.segment_offset_ + 1);
+            }
+            read_offset = row_end;
+        }
+    }
+    if (new_begin >= new_end) {
+        return false;
+    }
+
+    BufferHandle src_handle = src_chunk->GetIndex();
+    const auto *src_hnsw = reinterpret_cast<const AbstractHnsw *>(src_handle.GetData());
+    Optional<SizeT> merged_n = memory_hnsw_index->MergeGraph(*src_hnsw, label_map);
+    if (!merged_n.has_value()) {
+        return false;
+    }
+    if (*merged_n != new_end - new_begin) {
+        UnrecoverableError(fmt::format("Merged {} rows of the hnsw graph of segment {}, expect {}", *merged_n, src_segment->segment_id(), new_end - new_begin));
+    }
+
+    auto *buffer_mgr = txn->buffer_mgr();
+    auto *table_entry = table_index_entry_->table_index_meta()->GetTableEntry();
+    SizeT column_idx = table_entry->GetColumnIdxByID(column_def->id());
+    HnswInsertConfig insert_config;
+    insert_config.optimize_ = true;
+    SizeT inserted_n = 0;
+    auto block_iter = BlockEntryIter(segment_entry);
+    for (const auto *block_entry = block_iter.Next(); block_entry != nullptr; block_entry = block_iter.Next()) {
+        const SegmentOffset block_begin = block_entry->segment_offset();
+        const SegmentOffset block_end = block_begin + block_entry->row_count();
+        BlockColumnEntry *block_column_entry = block_entry->GetColumnBlockEntry(column_idx);
+        auto insert_range = [&](SegmentOffset begin, SegmentOffset end) {
+            if (begin < end) {
+                memory_hnsw_index->InsertVecs(block_begin, block_column_entry, buffer_mgr, begin - block_begin, end - begin, insert_config);
+                inserted_n += end - begin;
+            }
+        };
+        insert_range(block_begin, std::min(block_end, new_begin));
+        insert_range(std::max(block_begin, new_end), block_end);
+    }
+    LOG_INFO(fmt::format("Compacted segment {} reuses the hnsw graph of segment {}: {} rows merged, {} deleted rows dropped, {} rows inserted",
+                         segment_entry->segment_id(),
+                         src_segment->segment_id(),
+                         *merged_n,
+                         src_segment->row_count() - *merged_n,
+                         inserted_n));
+    return true;
+}
+
 void SegmentIndexEntry::PopulateEntirely(const SegmentEntry *segment_entry, Txn *txn, const PopulateEntireConfig &config) {
     TxnTimeStamp begin_ts = txn->BeginTS();
     auto *buffer_mgr = txn->buffer_mgr();
@@ -506,9 +642,12 @@ void SegmentIndexEntry::PopulateEntirely(const SegmentEntry *segment_entry, Txn
                 memory_hnsw_index = builder.Make(segment_entry, column_def->id(), begin_ts, config.check_ts_, buffer_mgr, true);
             } else {
                 memory_hnsw_index = HnswIndexInMem::Make(base_row_id, index_base, column_def.get(), this);
-                HnswInsertConfig insert_config;
-                insert_config.optimize_ = true;
-                memory_hnsw_index->InsertVecs(segment_entry, buffer_mgr, column_def->id(), begin_ts, config.check_ts_, insert_config);
+                if (config.compact_state_data_ == nullptr ||
+                    !MergeCompactedHnsw(memory_hnsw_index.get(), segment_entry, *config.compact_state_data_, txn)) {
+                    HnswInsertConfig insert_config;
+                    insert_config.optimize_ = true;
+                    memory_hnsw_index->InsertVecs(segment_entry, buffer_mgr, column_def->id(), begin_ts, config.check_ts_, insert_config);
+                }
             }
 
             dumped_memindex_entry = memory_hnsw_index->Dump(this, buffer_manager_);
@@ -538,7 +677,7 @@ void SegmentIndexEntry::PopulateEntirely(const SegmentEntry *segment_entry, Txn
             this->AddChunkIndexEntry(ivf_chunk_index_entry);
             BufferHandle handle = ivf_chunk_index_entry->GetIndex();
             auto data_ptr = static_cast<IVFIndexInChunk *>(handle.GetDataMut());
-            data_ptr->BuildIVFIndex(base_row_id, row_count, segment_entry, column_def, buffer_mgr);
+            data_ptr->BuildIVFIndex(base_row_id, row_count, segment_entry, column_def, buffer_mgr, &kmeans_progress_);
             ivf_chunk_index_entry->SaveIndexFile();
             dumped_memindex_entry = std::move(ivf_chunk_index_entry);
             break;
@@ -549,7 +688,7 @@ void SegmentIndexEntry::PopulateEntirely(const SegmentEntry *segment_entry, Txn
             this->AddChunkIndexEntry(emvb_chunk_index_entry);
             BufferHandle handle = emvb_chunk_index_entry->GetIndex();
             auto data_ptr = static_cast<EMVBIndex *>(handle.GetDataMut());
-            data_ptr->BuildEMVBIndex(base_row_id, row_count, segment_entry, column_def, buffer_mgr);
+            data_ptr->BuildEMVBIndex(base_row_id, row_count, segment_entry, column_def, buffer_mgr, &kmeans_progress_);
 
             emvb_chunk_index_entry->SaveIndexFile();
             dumped_memindex_entry = std::move(emvb_chunk_index_entry);
@@ -562,10 +701,15 @@ void SegmentIndexEntry::PopulateEntirely(const SegmentEntry *segment_entry, Txn
             dumped_memindex_entry = MemIndexDump();
             break;
         }
-        case IndexType::kDiskAnn: { // TODO
-            UniquePtr<String> err_msg =
-                MakeUnique<String>(fmt::format("{} PopulateEntirely is not supported yet", IndexInfo::IndexTypeToString(index_base->index_type_)));
-            LOG_WARN(*err_msg);
+        case IndexType::kDiskAnn: {
+            const u32 row_count = segment_entry->row_count();
+            if (row_count >= DiskAnnIndexInChunk::LeastRowCount()) {
+                dumped_memindex_entry = BuildDiskAnnIndexChunk(segment_entry, 0, row_count, buffer_mgr);
+                dumped_memindex_entry->SaveIndexFile();
+                std::unique_lock lck(rw_locker_);
+                chunk_index_entries_.push_back(dumped_memindex_entry);
+            }
+            diskann_append_end_ = row_count;
             break;
         }
         default: {
@@ -584,9 +728,13 @@ void SegmentIndexEntry::PopulateEntirely(const SegmentEntry *segment_entry, Txn
     }
 }
 
-Status SegmentIndexEntry::CreateIndexPrepare(const SegmentEntry *segment_entry, Txn *txn, bool prepare, bool check_ts) {
+Status SegmentIndexEntry::CreateIndexPrepare(const SegmentEntry *segment_entry,
+                                             Txn *txn,
+                                             bool prepare,
+                                             bool check_ts,
+                                             const CompactStateData *compact_state_data) {
     const IndexBase *index_base = table_index_entry_->index_base();
-    PopulateEntireConfig populate_entire_config{.prepare_ = prepare, .check_ts_ = check_ts};
+    PopulateEntireConfig populate_entire_config{.prepare_ = prepare, .check_ts_ = check_ts, .compact_state_data_ = compact_state_data};
     switch (index_base->index_type_) {
         case IndexType::kIVF:
         case IndexType::kHnsw:
@@ -794,7 +942,7 @@ void SegmentIndexEntry::OptIndex(SharedPtr<IndexBase> new_index_base,
                             if constexpr (IndexT::kOwnMem) {
                                 using HnswIndexDataType = typename std::remove_pointer_t<T>::DataType;
                                 if (params->compress_to_lvq) {
-                                    if constexpr (IsAnyOf<HnswIndexDataType, i8, u8>) {
+                                    if constexpr (IsAnyOf<HnswIndexDataType, i8, u8, Float16T, BFloat16T>) {
                                         UnrecoverableError("Invalid index type.");
                                     } else {
                                         auto *p = std::move(*index).CompressToLVQ().release();
@@ -909,6 +1057,25 @@ void SegmentIndexEntry::ReplaceChunkIndexEntries(TxnTableStore *txn_table_store,
     txn_index_store->optimize_data_.emplace_back(this, merged_chunk_index_entry.get(), std::move(old_chunks));
 }
 
+namespace {
+
+// Mark the vertices of the rows deleted at `ts` in `abstract_hnsw`, return the numbers of the marked and all vertices.
+Pair<SizeT, SizeT> MarkHnswDeleted(const AbstractHnsw &abstract_hnsw, TxnTimeStamp ts, const Bitmask &visible) {
+    return std::visit(
+        [&](auto &&index) -> Pair<SizeT, SizeT> {
+            using T = std::decay_t<decltype(index)>;
+            if constexpr (std::is_same_v<T, std::nullptr_t>) {
+                return {0, 0};
+            } else {
+                SizeT deleted_n = index->MarkDeleted(ts, [&](SegmentOffset label) { return label < visible.count() && !visible.IsTrue(label); });
+                return {deleted_n, index->GetVecNum()};
+            }
+        },
+        abstract_hnsw);
+}
+
+} // namespace
+
 ChunkIndexEntry *SegmentIndexEntry::RebuildChunkIndexEntries(TxnTableStore *txn_table_store, SegmentEntry *segment_entry) {
     const auto &index_name = *table_index_entry_->GetIndexName();
     Txn *txn = txn_table_store->GetTxn();
@@ -942,8 +1109,20 @@ ChunkIndexEntry *SegmentIndexEntry::RebuildChunkIndexEntries(TxnTableStore *txn_
                 old_ids.push_back(chunk_index_entry->chunk_id_);
             }
         }
-        if (old_chunks.size() <= 1) { // TODO
+    }
+    // a single hnsw chunk is rebuilt or repaired when enough of its vertices are deleted, the fewer deleted ones are only marked
+    bool repair_hnsw = false;
+    Optional<Bitmask> visible;
+    if (old_chunks.size() <= 1) { // TODO
+        bool rebuild_hnsw = false;
+        if (index_base->index_type_ == IndexType::kHnsw && segment_entry->first_delete_ts() < begin_ts) {
+            visible.emplace(segment_entry->row_count());
+            segment_entry->CheckRowsVisible(*visible, begin_ts);
+            std::tie(rebuild_hnsw, repair_hnsw) = MarkHnswDeletes(old_chunks.empty() ? nullptr : old_chunks[0], *visible, begin_ts);
+        }
+        if (!rebuild_hnsw && !repair_hnsw) {
             opt_success = true;
+            ResetOptimizing();
             return nullptr;
         }
     }
@@ -954,7 +1133,21 @@ ChunkIndexEntry *SegmentIndexEntry::RebuildChunkIndexEntries(TxnTableStore *txn_
         case IndexType::kHnsw: {
             const auto *index_hnsw = static_cast<const IndexHnsw *>(index_base);
             UniquePtr<HnswIndexInMem> memory_hnsw_index;
-            if (index_hnsw->build_type_ == HnswBuildType::kLSG) {
+            if (repair_hnsw) {
+                // copy the graph without the deleted vertices, the neighbors of them are reconnected
+                memory_hnsw_index = HnswIndexInMem::Make(base_rowid, index_base, column_def.get(), this);
+                Vector<Optional<SegmentOffset>> label_map(row_count);
+                for (SegmentOffset offset = 0; offset < row_count; ++offset) {
+                    if (offset >= visible->count() || visible->IsTrue(offset)) {
+                        label_map[offset] = offset;
+                    }
+                }
+                BufferHandle old_handle = old_chunks[0]->GetIndex();
+                const auto *old_hnsw = reinterpret_cast<const AbstractHnsw *>(old_handle.GetData());
+                if (!memory_hnsw_index->MergeGraph(*old_hnsw, label_map).has_value()) {
+                    UnrecoverableError(fmt::format("Index {} segment {} can not repair the hnsw graph.", index_name, segment_id_));
+                }
+            } else if (index_hnsw->build_type_ == HnswBuildType::kLSG) {
                 HnswLSGBuilder builder(index_hnsw, column_def);
                 memory_hnsw_index = builder.Make(segment_entry, column_def->id(), begin_ts, true /*check_ts*/, buffer_mgr, true);
             } else {
@@ -986,6 +1179,8 @@ ChunkIndexEntry *SegmentIndexEntry::RebuildChunkIndexEntries(TxnTableStore *txn_
                     abstract_hnsw);
             }
             merged_chunk_index_entry = memory_hnsw_index->Dump(this, buffer_mgr);
+            // the deleted rows are dropped, the chunk still covers them
+            merged_chunk_index_entry->SetRowCount(row_count);
             break;
         }
         case IndexType::kBMP: {
@@ -1029,7 +1224,7 @@ ChunkIndexEntry *SegmentIndexEntry::RebuildChunkIndexEntries(TxnTableStore *txn_
             merged_chunk_index_entry = CreateEMVBIndexChunkIndexEntry(base_rowid, row_count, buffer_mgr);
             BufferHandle handle = merged_chunk_index_entry->GetIndex();
             auto data_ptr = static_cast<EMVBIndex *>(handle.GetDataMut());
-            data_ptr->BuildEMVBIndex(base_rowid, row_count, segment_entry, column_def, buffer_mgr);
+            data_ptr->BuildEMVBIndex(base_rowid, row_count, segment_entry, column_def, buffer_mgr, &kmeans_progress_);
             break;
         }
         case IndexType::kIVF: {
@@ -1037,7 +1232,12 @@ ChunkIndexEntry *SegmentIndexEntry::RebuildChunkIndexEntries(TxnTableStore *txn_
             merged_chunk_index_entry = CreateIVFIndexChunkIndexEntry(base_rowid, row_count, buffer_mgr);
             BufferHandle handle = merged_chunk_index_entry->GetIndex();
             auto data_ptr = static_cast<IVFIndexInChunk *>(handle.GetDataMut());
-            data_ptr->BuildIVFIndex(base_rowid, row_count, segment_entry, column_def, buffer_mgr);
+            data_ptr->BuildIVFIndex(base_rowid, row_count, segment_entry, column_def, buffer_mgr, &kmeans_progress_);
+            break;
+        }
+        case IndexType::kDiskAnn: {
+            // the graphs of the chunks are not mergeable, rebuild one over the rows they cover
+            merged_chunk_index_entry = BuildDiskAnnIndexChunk(segment_entry, 0, row_count, buffer_mgr);
             break;
         }
         default: {
@@ -1054,6 +1254,38 @@ ChunkIndexEntry *SegmentIndexEntry::RebuildChunkIndexEntries(TxnTableStore *txn_
     return merged_chunk_index_entry.get();
 }
 
+Pair<bool, bool> SegmentIndexEntry::MarkHnswDeletes(ChunkIndexEntry *chunk_index_entry, const Bitmask &visible, TxnTimeStamp begin_ts) {
+    SharedPtr<HnswIndexInMem> memory_hnsw_index;
+    {
+        std::shared_lock lock(rw_locker_);
+        memory_hnsw_index = memory_hnsw_index_;
+    }
+    if (memory_hnsw_index.get() != nullptr) {
+        MarkHnswDeleted(memory_hnsw_index->get(), begin_ts, visible);
+    }
+    if (chunk_index_entry == nullptr || chunk_index_entry->base_rowid_.segment_offset_ != 0) {
+        return {false, false};
+    }
+    BufferHandle index_handle = chunk_index_entry->GetIndex();
+    const auto *abstract_hnsw = reinterpret_cast<const AbstractHnsw *>(index_handle.GetData());
+    auto [deleted_n, vertex_n] = MarkHnswDeleted(*abstract_hnsw, begin_ts, visible);
+    if (deleted_n == 0) {
+        return {false, false};
+    }
+
+    // the graphs of the lsg builds and of the quantized vectors are not copied, they are only rebuilt
+    const auto *index_hnsw = static_cast<const IndexHnsw *>(table_index_entry_->index_base());
+    const bool repairable = index_hnsw->build_type_ != HnswBuildType::kLSG && index_hnsw->encode_type_ == HnswEncodeType::kPlain;
+    const SizeT rebuild_percent = InfinityContext::instance().config()->HnswRebuildDeletePercent();
+    if (deleted_n == vertex_n || (rebuild_percent > 0 && deleted_n * 100 >= vertex_n * rebuild_percent)) {
+        return {true, false};
+    }
+    if (repairable && deleted_n * 100 >= vertex_n * HNSW_REPAIR_DELETE_PERCENT) {
+        return {false, true};
+    }
+    return {false, false};
+}
+
 BaseMemIndex *SegmentIndexEntry::GetMemIndex() const {
     if (memory_hnsw_index_.get() != nullptr) {
         return static_cast<BaseMemIndex *>(memory_hnsw_index_.get());
@@ -1105,6 +1337,33 @@ SegmentIndexEntry::CreateBMPIndexChunkIndexEntry(RowID base_rowid, u32 row_count
     return ChunkIndexEntry::NewBMPIndexChunkIndexEntry(chunk_id, this, "", base_rowid, row_count, buffer_mgr, index_size);
 }
 
+SharedPtr<ChunkIndexEntry> SegmentIndexEntry::CreateDiskAnnIndexChunkIndexEntry(RowID base_rowid, u32 row_count, BufferManager *buffer_mgr) {
+    ChunkID chunk_id = this->GetNextChunkID();
+    return ChunkIndexEntry::NewDiskAnnIndexChunkIndexEntry(chunk_id, this, "", base_rowid, row_count, buffer_mgr);
+}
+
+SharedPtr<ChunkIndexEntry>
+SegmentIndexEntry::BuildDiskAnnIndexChunk(const SegmentEntry *segment_entry, SegmentOffset start_offset, u32 row_count, BufferManager *buffer_mgr) {
+    RowID base_rowid(segment_id_, start_offset);
+    SharedPtr<ChunkIndexEntry> chunk_index_entry = CreateDiskAnnIndexChunkIndexEntry(base_rowid, row_count, buffer_mgr);
+    BufferHandle handle = chunk_index_entry->GetIndex();
+    auto data_ptr = static_cast<DiskAnnIndexInChunk *>(handle.GetDataMut());
+    data_ptr->BuildDiskAnnIndex(base_rowid, row_count, segment_entry, table_index_entry_->column_def()->id(), buffer_mgr);
+    return chunk_index_entry;
+}
+
+u32 SegmentIndexEntry::DiskAnnCoveredRowCount() const {
+    u32 covered_row_count = 0;
+    std::shared_lock lock(rw_locker_);
+    for (const auto &chunk_index_entry : chunk_index_entries_) {
+        if (chunk_index_entry->deprecate_ts_ != UNCOMMIT_TS) {
+            continue;
+        }
+        covered_row_count = std::max<u32>(covered_row_count, chunk_index_entry->base_rowid_.segment_offset_ + chunk_index_entry->row_count_);
+    }
+    return covered_row_count;
+}
+
 void SegmentIndexEntry::AddChunkIndexEntry(SharedPtr<ChunkIndexEntry> chunk_index_entry) {
     std::shared_lock lock(rw_locker_);
     chunk_index_entries_.push_back(chunk_index_entry);
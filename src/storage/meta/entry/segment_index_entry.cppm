@@ -35,6 +35,7 @@ import statement_common;
 import txn;
 import snapshot_info;
 import meta_info;
+import kmeans_partition;
 
 namespace infinity {
 
@@ -53,10 +54,13 @@ class BMPIndexInMem;
 class BaseMemIndex;
 class MemoryIndexer;
 class TxnStore;
+class CompactStateData;
 
 export struct PopulateEntireConfig {
     bool prepare_;
     bool check_ts_;
+    // not null if the segment is made by a compaction, the hnsw graph of a compacted segment can be reused
+    const CompactStateData *compact_state_data_ = nullptr;
 };
 
 export struct SegmentIndexEntry final : public BaseEntry {
@@ -108,6 +112,9 @@ public:
 
     TableIndexEntry *table_index_entry() const { return table_index_entry_; }
 
+    // k-means training of the IVF and EMVB index of this segment
+    KMeansProgress &kmeans_progress() { return kmeans_progress_; }
+
 public:
     // Getter
     inline SegmentID segment_id() const { return segment_id_; }
@@ -139,7 +146,11 @@ public:
 
     u32 MemIndexRowCount();
 
-    Status CreateIndexPrepare(const SegmentEntry *segment_entry, Txn *txn, bool prepare, bool check_ts);
+    Status CreateIndexPrepare(const SegmentEntry *segment_entry,
+                              Txn *txn,
+                              bool prepare,
+                              bool check_ts,
+                              const CompactStateData *compact_state_data = nullptr);
 
     Status CreateIndexDo(atomic_u64 &create_index_idx);
 
@@ -185,6 +196,11 @@ public:
         return {chunk_index_entries_, memory_emvb_index_};
     }
 
+    Vector<SharedPtr<ChunkIndexEntry>> GetDiskAnnIndexSnapshot() {
+        std::shared_lock lock(rw_locker_);
+        return chunk_index_entries_;
+    }
+
     Pair<u64, u32> GetFulltextColumnLenInfo();
 
     void UpdateFulltextColumnLenInfo(u64 column_len_sum, u32 column_len_cnt) {
@@ -204,6 +220,8 @@ public:
 
     SharedPtr<ChunkIndexEntry> CreateBMPIndexChunkIndexEntry(RowID base_rowid, u32 row_count, BufferManager *buffer_mgr, SizeT index_size);
 
+    SharedPtr<ChunkIndexEntry> CreateDiskAnnIndexChunkIndexEntry(RowID base_rowid, u32 row_count, BufferManager *buffer_mgr);
+
     void AddChunkIndexEntry(SharedPtr<ChunkIndexEntry> chunk_index_entry);
 
     SharedPtr<ChunkIndexEntry> AddFtChunkIndexEntry(const String &base_name, RowID base_rowid, u32 row_count);
@@ -248,6 +266,20 @@ public:
 private:
     explicit SegmentIndexEntry(TableIndexEntry *table_index_entry, SegmentID segment_id);
 
+    // Build a DiskAnn chunk of rows [start_offset, start_offset + row_count) of the segment.
+    SharedPtr<ChunkIndexEntry> BuildDiskAnnIndexChunk(const SegmentEntry *segment_entry, SegmentOffset start_offset, u32 row_count, BufferManager *buffer_mgr);
+
+    // Copy the hnsw graph of the largest compacted segment into `memory_hnsw_index` without its deleted rows, then insert the rows
+    // of the other compacted segments. Return false without touching the index if no graph can be reused.
+    bool MergeCompactedHnsw(HnswIndexInMem *memory_hnsw_index, const SegmentEntry *segment_entry, const CompactStateData &compact_state_data, Txn *txn);
+
+    // Mark the rows not `visible` at `begin_ts` in the hnsw graphs of the memory index and of the only chunk.
+    // Return whether the chunk is to be rebuilt or repaired for its deleted vertices.
+    Pair<bool, bool> MarkHnswDeletes(ChunkIndexEntry *chunk_index_entry, const Bitmask &visible, TxnTimeStamp begin_ts);
+
+    // Rows [0, return value) of the segment are covered by the DiskAnn chunks.
+    u32 DiskAnnCoveredRowCount() const;
+
     SegmentIndexEntry(const SegmentIndexEntry &other);
 
 public:
@@ -277,6 +309,9 @@ private:
     SharedPtr<SecondaryIndexInMem> memory_secondary_index_{};
     SharedPtr<EMVBIndexInMem> memory_emvb_index_{};
     SharedPtr<BMPIndexInMem> memory_bmp_index_{};
+    // DiskAnn has no memory index, appended rows are indexed by chunks at dump and brute-forced by search before that.
+    u32 diskann_append_end_{};
+    KMeansProgress kmeans_progress_{};
 
     u64 ft_column_len_sum_{}; // increase only
     u32 ft_column_len_cnt_{}; // increase only
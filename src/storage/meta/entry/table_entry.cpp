@@ -515,7 +515,8 @@ void TableEntry::Import(SharedPtr<SegmentEntry> segment_entry, Txn *txn) {
             case IndexType::kEMVB:
             case IndexType::kIVF:
             case IndexType::kHnsw:
-            case IndexType::kBMP: {
+            case IndexType::kBMP:
+            case IndexType::kDiskAnn: {
                 // support realtime index
                 break;
             }
@@ -810,7 +811,8 @@ void TableEntry::MemIndexInsert(Txn *txn, Vector<AppendRange> &append_ranges) {
             case IndexType::kEMVB:
             case IndexType::kIVF:
             case IndexType::kSecondary:
-            case IndexType::kBMP: {
+            case IndexType::kBMP:
+            case IndexType::kDiskAnn: {
                 for (auto &[seg_id, ranges] : seg_append_ranges) {
                     LOG_TRACE(
                         fmt::format("Table {}.{} index {} segment {} MemIndexInsert.", *GetDBName(), *table_name_, *index_base->index_name_, seg_id));
@@ -1114,7 +1116,8 @@ void TableEntry::OptimizeIndex(Txn *txn) {
             case IndexType::kIVF:
             case IndexType::kEMVB:
             case IndexType::kSecondary:
-            case IndexType::kBMP: {
+            case IndexType::kBMP:
+            case IndexType::kDiskAnn: {
                 TxnTimeStamp begin_ts = txn->BeginTS();
                 Map<SegmentID, SharedPtr<SegmentIndexEntry>> index_by_segment = table_index_entry->GetIndexBySegmentSnapshot(this, txn);
                 for (auto &[segment_id, segment_index_entry] : index_by_segment) {
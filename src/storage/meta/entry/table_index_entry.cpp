@@ -39,6 +39,7 @@ import block_entry;
 import segment_entry;
 import table_entry;
 import infinity_context;
+import kmeans_partition;
 
 namespace infinity {
 
@@ -352,7 +353,8 @@ SharedPtr<SegmentIndexEntry> TableIndexEntry::PopulateEntirely(SegmentEntry *seg
         case IndexType::kEMVB:
         case IndexType::kFullText:
         case IndexType::kSecondary:
-        case IndexType::kBMP: {
+        case IndexType::kBMP:
+        case IndexType::kDiskAnn: {
             break;
         }
         default: {
@@ -377,8 +379,12 @@ SharedPtr<SegmentIndexEntry> TableIndexEntry::PopulateEntirely(SegmentEntry *seg
     return segment_index_entry;
 }
 
-Tuple<Vector<SegmentIndexEntry *>, Status>
-TableIndexEntry::CreateIndexPrepare(BaseTableRef *table_ref, Txn *txn, bool prepare, bool is_replay, bool check_ts) {
+Tuple<Vector<SegmentIndexEntry *>, Status> TableIndexEntry::CreateIndexPrepare(BaseTableRef *table_ref,
+                                                                                Txn *txn,
+                                                                                bool prepare,
+                                                                                bool is_replay,
+                                                                                bool check_ts,
+                                                                                const CompactStateData *compact_state_data) {
     TableEntry *table_entry = table_index_meta()->GetTableEntry();
     TxnStore *txn_store = txn->txn_store();
     TxnTableStore *txn_table_store = txn_store->GetTxnTableStore(table_entry);
@@ -394,7 +400,7 @@ TableIndexEntry::CreateIndexPrepare(BaseTableRef *table_ref, Txn *txn, bool prep
         auto *segment_entry = segment_info.segment_entry_;
         SharedPtr<SegmentIndexEntry> segment_index_entry = SegmentIndexEntry::NewIndexEntry(this, segment_id, txn);
         if (!is_replay) {
-            segment_index_entry->CreateIndexPrepare(segment_entry, txn, prepare, check_ts);
+            segment_index_entry->CreateIndexPrepare(segment_entry, txn, prepare, check_ts, compact_state_data);
         }
         std::unique_lock w_lock(rw_locker_);
         index_by_segment_.emplace(segment_id, segment_index_entry);
@@ -608,6 +614,23 @@ SharedPtr<TableIndexInfo> TableIndexEntry::GetTableIndexInfo(Txn *txn_ptr) {
     table_index_info->index_other_params_ = MakeShared<String>(index_base_->BuildOtherParamsString());
     table_index_info->index_column_names_ = MakeShared<String>(column_def_->name_);
     table_index_info->index_column_ids_ = MakeShared<String>(std::to_string(column_def_->id_));
+    // several segments may train at once, list each of them
+    Vector<String> training_segments;
+    for (const auto &[segment_id, segment_index_entry] : index_by_segment_) {
+        const KMeansProgress &kmeans_progress = segment_index_entry->kmeans_progress();
+        if (const u32 iteration_max = kmeans_progress.iteration_max_.load(); iteration_max > 0) {
+            training_segments.push_back(fmt::format("segment {}: k-means iteration {}/{}, {} vectors",
+                                                    segment_id,
+                                                    kmeans_progress.iteration_.load(),
+                                                    iteration_max,
+                                                    kmeans_progress.training_num_.load()));
+        }
+    }
+    if (training_segments.empty()) {
+        table_index_info->training_progress_ = MakeShared<String>("idle");
+    } else {
+        table_index_info->training_progress_ = MakeShared<String>(fmt::format("{}", fmt::join(training_segments, "; ")));
+    }
     return table_index_info;
 }
 
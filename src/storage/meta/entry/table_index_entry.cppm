@@ -46,6 +46,7 @@ struct SegmentEntry;
 class BaseTableRef;
 class AddTableIndexEntryOp;
 class BaseMemIndex;
+class CompactStateData;
 
 export struct SegmentIndexesGuard {
     const Map<SegmentID, SharedPtr<SegmentIndexEntry>> &index_by_segment_;
@@ -131,8 +132,12 @@ public:
     // Populate index entirely for the segment
     SharedPtr<SegmentIndexEntry> PopulateEntirely(SegmentEntry *segment_entry, Txn *txn, const PopulateEntireConfig &config);
 
-    Tuple<Vector<SegmentIndexEntry *>, Status>
-    CreateIndexPrepare(BaseTableRef *table_ref, Txn *txn, bool prepare, bool is_replay, bool check_ts = true);
+    Tuple<Vector<SegmentIndexEntry *>, Status> CreateIndexPrepare(BaseTableRef *table_ref,
+                                                                  Txn *txn,
+                                                                  bool prepare,
+                                                                  bool is_replay,
+                                                                  bool check_ts = true,
+                                                                  const CompactStateData *compact_state_data = nullptr);
 
     Status CreateIndexDo(BaseTableRef *table_ref, HashMap<SegmentID, atomic_u64> &create_index_idxes, Txn *txn);
 
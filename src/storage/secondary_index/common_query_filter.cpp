@@ -136,7 +136,6 @@ CommonQueryFilter::CommonQueryFilter(SharedPtr<BaseExpression> original_filter,
 }
 
 void CommonQueryFilter::BuildFilter(u32 task_id) {
-    auto *buffer_mgr = txn_ptr_->buffer_mgr();
     TxnTimeStamp begin_ts = txn_ptr_->BeginTS();
     const auto &segment_index = base_table_ref_->block_index_->segment_block_index_;
     const SegmentID segment_id = tasks_[task_id];
@@ -158,40 +157,8 @@ void CommonQueryFilter::BuildFilter(u32 task_id) {
                                        result_elem.count()));
     }
     if (leftover_filter_) {
-        SizeT segment_row_count_read = 0;
-        auto filter_state = ExpressionState::CreateState(leftover_filter_);
-        auto db_for_filter_p = MakeUnique<DataBlock>();
-        auto db_for_filter = db_for_filter_p.get();
-        Vector<SharedPtr<DataType>> read_column_types = *(base_table_ref_->column_types_);
-        Vector<SizeT> column_ids = base_table_ref_->column_ids_;
-        if (read_column_types.empty() || read_column_types.back()->type() != LogicalType::kRowID) {
-            read_column_types.push_back(MakeShared<DataType>(LogicalType::kRowID));
-            column_ids.push_back(COLUMN_IDENTIFIER_ROW_ID);
-        }
-        // collect the base_table_ref columns used in filter
-        Vector<bool> column_should_load(column_ids.size(), false);
-        CollectUsedColumnRef(leftover_filter_.get(), column_should_load);
-        db_for_filter->Init(read_column_types);
-        auto bool_column = ColumnVector::Make(MakeShared<infinity::DataType>(LogicalType::kBoolean));
-        // filter and build bitmask, if filter_expression_ != nullptr
-        ExpressionEvaluator expr_evaluator;
-        auto block_entry_iter = BlockEntryIter(segment_entry);
-        for (auto *block_entry = block_entry_iter.Next(); block_entry != nullptr and segment_row_count_read < segment_row_count;
-             block_entry = block_entry_iter.Next()) {
-            const auto block_row_count = block_entry->row_count();
-            const auto row_count = std::min<SizeT>(segment_row_count - segment_row_count_read, block_row_count);
-            db_for_filter->Reset(row_count);
-            ReadDataBlock(db_for_filter, buffer_mgr, row_count, block_entry, column_ids, column_should_load);
-            bool_column->Initialize(ColumnVectorType::kCompactBit, row_count);
-            expr_evaluator.Init(db_for_filter);
-            expr_evaluator.Execute(leftover_filter_, filter_state, bool_column);
-            const VectorBuffer *bool_column_buffer = bool_column->buffer_.get();
-            SharedPtr<Bitmask> &null_mask = bool_column->nulls_ptr_;
-            MergeFalseIntoBitmask(bool_column_buffer, null_mask, row_count, result_elem, segment_row_count_read);
-            segment_row_count_read += row_count;
-            bool_column->Reset();
-        }
-        if (segment_row_count_read < segment_row_count) {
+        if (const SizeT segment_row_count_read = ApplyLeftoverFilter(segment_entry, segment_row_count, result_elem);
+            segment_row_count_read < segment_row_count) {
             UnrecoverableError(fmt::format("Segment_row_count mismatch: In segment {}: segment_row_count_read: {}, segment_row_count: {}",
                                            segment_id,
                                            segment_row_count_read,
@@ -208,6 +175,83 @@ void CommonQueryFilter::BuildFilter(u32 task_id) {
     }
 }
 
+SizeT CommonQueryFilter::ApplyLeftoverFilter(const SegmentEntry *segment_entry, SizeT row_limit, Bitmask &result_elem) const {
+    auto *buffer_mgr = txn_ptr_->buffer_mgr();
+    SizeT segment_row_count_read = 0;
+    auto filter_state = ExpressionState::CreateState(leftover_filter_);
+    auto db_for_filter_p = MakeUnique<DataBlock>();
+    auto db_for_filter = db_for_filter_p.get();
+    Vector<SharedPtr<DataType>> read_column_types = *(base_table_ref_->column_types_);
+    Vector<SizeT> column_ids = base_table_ref_->column_ids_;
+    if (read_column_types.empty() || read_column_types.back()->type() != LogicalType::kRowID) {
+        read_column_types.push_back(MakeShared<DataType>(LogicalType::kRowID));
+        column_ids.push_back(COLUMN_IDENTIFIER_ROW_ID);
+    }
+    // collect the base_table_ref columns used in filter
+    Vector<bool> column_should_load(column_ids.size(), false);
+    CollectUsedColumnRef(leftover_filter_.get(), column_should_load);
+    db_for_filter->Init(read_column_types);
+    auto bool_column = ColumnVector::Make(MakeShared<infinity::DataType>(LogicalType::kBoolean));
+    // filter and build bitmask, if filter_expression_ != nullptr
+    ExpressionEvaluator expr_evaluator;
+    auto block_entry_iter = BlockEntryIter(segment_entry);
+    for (auto *block_entry = block_entry_iter.Next(); block_entry != nullptr and segment_row_count_read < row_limit;
+         block_entry = block_entry_iter.Next()) {
+        const auto block_row_count = block_entry->row_count();
+        const auto row_count = std::min<SizeT>(row_limit - segment_row_count_read, block_row_count);
+        db_for_filter->Reset(row_count);
+        ReadDataBlock(db_for_filter, buffer_mgr, row_count, block_entry, column_ids, column_should_load);
+        bool_column->Initialize(ColumnVectorType::kCompactBit, row_count);
+        expr_evaluator.Init(db_for_filter);
+        expr_evaluator.Execute(leftover_filter_, filter_state, bool_column);
+        const VectorBuffer *bool_column_buffer = bool_column->buffer_.get();
+        SharedPtr<Bitmask> &null_mask = bool_column->nulls_ptr_;
+        MergeFalseIntoBitmask(bool_column_buffer, null_mask, row_count, result_elem, segment_row_count_read);
+        segment_row_count_read += row_count;
+        bool_column->Reset();
+    }
+    return segment_row_count_read;
+}
+
+SizeT CommonQueryFilter::EstimateMatchCount(SegmentID segment_id, SizeT sample_row_count) const {
+    const auto &segment_index = base_table_ref_->block_index_->segment_block_index_;
+    const auto iter = segment_index.find(segment_id);
+    if (iter == segment_index.end()) {
+        return 0;
+    }
+    const SegmentEntry *segment_entry = iter->second.segment_entry_;
+    const SizeT segment_row_count = iter->second.segment_offset_;
+    if (always_true_ || !finish_build_fast_rough_filter_ || !finish_build_index_filter_) {
+        return segment_row_count;
+    }
+    TxnTimeStamp begin_ts = txn_ptr_->BeginTS();
+    if (!fast_rough_filter_evaluator_->Evaluate(begin_ts, *segment_entry->GetFastRoughFilter())) {
+        return 0;
+    }
+    Bitmask result_elem = index_filter_evaluator_->Evaluate(segment_id, segment_row_count, txn_ptr_);
+    segment_entry->CheckRowsVisible(result_elem, begin_ts);
+    const SizeT candidate_n = result_elem.CountTrue();
+    if (!leftover_filter_ || candidate_n == 0) {
+        return candidate_n;
+    }
+    // Scale the candidates by the selectivity of the leftover filter on the first rows, which is exact if they are all the rows.
+    auto count_sample = [&] {
+        SizeT n = 0;
+        for (SizeT row_id = 0; row_id < sample_row_count; ++row_id) {
+            n += result_elem.IsTrue(row_id);
+        }
+        return n;
+    };
+    sample_row_count = std::min(sample_row_count, segment_row_count);
+    const SizeT sample_candidate_n = count_sample();
+    if (sample_candidate_n == 0) {
+        return candidate_n;
+    }
+    ApplyLeftoverFilter(segment_entry, sample_row_count, result_elem);
+    const SizeT sample_match_n = count_sample();
+    return (candidate_n * sample_match_n + sample_candidate_n / 2) / sample_candidate_n;
+}
+
 void CommonQueryFilter::TryApplyFastRoughFilterOptimizer() {
     if (finish_build_fast_rough_filter_) {
         return;
@@ -228,7 +272,7 @@ void CommonQueryFilter::TryApplyIndexFilterOptimizer(QueryContext *query_context
     index_filter_evaluator_ = std::move(index_scan_solve_result.index_filter_evaluator_);
 }
 
-bool CommonQueryFilter::PassFilter(RowID doc_id) {
+bool CommonQueryFilter::PassFilter(RowID doc_id, CommonQueryFilterCursor &cursor) const {
     if (always_true_) [[unlikely]]
         return true;
     bool finish_build = finish_build_.test();
@@ -236,16 +280,16 @@ bool CommonQueryFilter::PassFilter(RowID doc_id) {
     if (!finish_build) {
         UnrecoverableError("CommonQueryFilter error: not finished.");
     }
-    if (doc_id.segment_id_ != current_segment_id_) [[unlikely]] {
+    if (doc_id.segment_id_ != cursor.segment_id_) [[unlikely]] {
         const auto it = filter_result_.find(doc_id.segment_id_);
         if (it == filter_result_.end()) [[unlikely]] {
-            current_segment_id_ = INVALID_SEGMENT_ID;
+            cursor.segment_id_ = INVALID_SEGMENT_ID;
             return false;
         }
-        current_segment_id_ = doc_id.segment_id_;
-        doc_id_bitmask_ = &(it->second);
+        cursor.segment_id_ = doc_id.segment_id_;
+        cursor.bitmask_ = &(it->second);
     }
-    return doc_id_bitmask_->IsTrue(doc_id.segment_offset_);
+    return cursor.bitmask_->IsTrue(doc_id.segment_offset_);
 }
 
 RowID CommonQueryFilter::EqualOrLarger(RowID doc_id) {
@@ -28,6 +28,13 @@ class QueryContext;
 class BufferManager;
 class Txn;
 struct TableIndexEntry;
+struct SegmentEntry;
+
+// The segment last visited by PassFilter. Each iterator keeps its own, so that the iterators can run in parallel.
+export struct CommonQueryFilterCursor {
+    SegmentID segment_id_ = INVALID_SEGMENT_ID;
+    const Bitmask *bitmask_ = nullptr;
+};
 
 export struct CommonQueryFilter {
     Txn* txn_ptr_;
@@ -98,15 +105,22 @@ public:
     // result will not be populated if always_true_ be true
     bool AlwaysTrue() const { return always_true_; }
 
-    // Check if given doc pass filter. Requires doc_id be in ascending order.
-    bool PassFilter(RowID doc_id);
+    // Check if given doc pass filter. Requires doc_id be in ascending order for the same cursor.
+    bool PassFilter(RowID doc_id, CommonQueryFilterCursor &cursor) const;
+
+    // Estimate the visible rows of the segment passing the filter without building the filter, for explain.
+    // The leftover filter is only evaluated on the first `sample_row_count` rows of the segment.
+    SizeT EstimateMatchCount(SegmentID segment_id, SizeT sample_row_count) const;
 
 private:
     RowID EqualOrLarger(RowID doc_id);
 
     void BuildFilter(u32 task_id);
 
-    // for PassFilter
+    // Clear the rows of [0, row_limit) of the segment failing the leftover filter in `result_elem`, return the rows read.
+    SizeT ApplyLeftoverFilter(const SegmentEntry *segment_entry, SizeT row_limit, Bitmask &result_elem) const;
+
+    // for EqualOrLarger
     SegmentID current_segment_id_ = INVALID_SEGMENT_ID;
     const Bitmask *doc_id_bitmask_ = nullptr;
     UniquePtr<RoaringForwardIterator> current_roaring_iterator_;
@@ -461,9 +461,12 @@ Tuple<Vector<SharedPtr<TableIndexInfo>>, Status> Txn::GetTableIndexesInfo(const
     return table_entry->GetTableIndexesInfo(this);
 }
 
-Pair<Vector<SegmentIndexEntry *>, Status>
-Txn::CreateIndexPrepare(TableIndexEntry *table_index_entry, BaseTableRef *table_ref, bool prepare, bool check_ts) {
-    auto [segment_index_entries, status] = table_index_entry->CreateIndexPrepare(table_ref, this, prepare, false, check_ts);
+Pair<Vector<SegmentIndexEntry *>, Status> Txn::CreateIndexPrepare(TableIndexEntry *table_index_entry,
+                                                                   BaseTableRef *table_ref,
+                                                                   bool prepare,
+                                                                   bool check_ts,
+                                                                   const CompactStateData *compact_state_data) {
+    auto [segment_index_entries, status] = table_index_entry->CreateIndexPrepare(table_ref, this, prepare, false, check_ts, compact_state_data);
     if (!status.ok()) {
         return {segment_index_entries, status};
     }
@@ -911,6 +914,10 @@ void Txn::Rollback() {
 SharedPtr<AddDeltaEntryTask> Txn::MakeAddDeltaEntryTask() {
     if (!txn_delta_ops_entry_->operations().empty()) {
         LOG_TRACE(txn_delta_ops_entry_->ToStringSimple());
+        // Before max_committed_ts_ covers the txn, so a full checkpoint of that ts never reuses a stale section.
+        for (const auto &op : txn_delta_ops_entry_->operations()) {
+            catalog_->MarkCheckpointDirty(*op->encode_);
+        }
         return MakeShared<AddDeltaEntryTask>(std::move(txn_delta_ops_entry_));
     }
     return nullptr;
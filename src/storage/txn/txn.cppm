@@ -66,6 +66,7 @@ enum class CompactStatementType;
 struct SegmentIndexEntry;
 struct AddDeltaEntryTask;
 struct IndexReader;
+class CompactStateData;
 
 export class Txn : public EnableSharedFromThis<Txn> {
 public:
@@ -187,8 +188,11 @@ public:
 
     Tuple<Vector<SharedPtr<TableIndexInfo>>, Status> GetTableIndexesInfo(const String &db_name, const String &table_name);
 
-    Pair<Vector<SegmentIndexEntry *>, Status>
-    CreateIndexPrepare(TableIndexEntry *table_index_entry, BaseTableRef *table_ref, bool prepare, bool check_ts = true);
+    Pair<Vector<SegmentIndexEntry *>, Status> CreateIndexPrepare(TableIndexEntry *table_index_entry,
+                                                                 BaseTableRef *table_ref,
+                                                                 bool prepare,
+                                                                 bool check_ts = true,
+                                                                 const CompactStateData *compact_state_data = nullptr);
 
     Status CreateIndexDo(BaseTableRef *table_ref, const String &index_name, HashMap<SegmentID, atomic_u64> &create_index_idxes);
 
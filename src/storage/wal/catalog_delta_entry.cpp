@@ -437,7 +437,8 @@ AddChunkIndexEntryOp::AddChunkIndexEntryOp(ChunkIndexEntry *chunk_index_entry, T
         case IndexType::kHnsw:
         case IndexType::kEMVB:
         case IndexType::kSecondary:
-        case IndexType::kBMP: {
+        case IndexType::kBMP:
+        case IndexType::kDiskAnn: {
             Path rela_dir = *(segment_index_entry->index_dir());
             String file_name = ChunkIndexEntry::IndexFileName(segment_index_entry->segment_id(), chunk_index_entry->chunk_id_);
             String rela_path = rela_dir / file_name;
@@ -1254,6 +1255,36 @@ void GlobalCatalogDeltaEntry::SetFullCheckpointTs(TxnTimeStamp last_full_ckp_ts)
     RemoveDeltaOp(last_full_ckp_ts);
 }
 
+void GlobalCatalogDeltaEntry::MarkCheckpointDirty(std::string_view encode) {
+    std::lock_guard<std::mutex> lock(catalog_delta_locker_);
+    MarkCheckpointDirtyInner(encode);
+}
+
+void GlobalCatalogDeltaEntry::MarkCheckpointAllDirty() {
+    std::lock_guard<std::mutex> lock(catalog_delta_locker_);
+    ckp_all_dirty_ = true;
+}
+
+Optional<HashSet<String>> GlobalCatalogDeltaEntry::PickCheckpointDirty() {
+    std::lock_guard<std::mutex> lock(catalog_delta_locker_);
+    HashSet<String> dirty_encodes = std::move(ckp_dirty_encodes_);
+    ckp_dirty_encodes_.clear();
+    if (ckp_all_dirty_) {
+        ckp_all_dirty_ = false;
+        return None;
+    }
+    return dirty_encodes;
+}
+
+void GlobalCatalogDeltaEntry::MarkCheckpointDirtyInner(std::string_view encode) {
+    // Keep "#db#table" of the encode, the encodes of segments, blocks and indexes all start with it.
+    SizeT table_end = encode.find('#', 1);
+    if (table_end != std::string_view::npos) {
+        table_end = encode.find('#', table_end + 1);
+    }
+    ckp_dirty_encodes_.emplace(encode.substr(0, table_end));
+}
+
 // background process AddDeltaOp call this.
 void GlobalCatalogDeltaEntry::AddDeltaEntryInner(CatalogDeltaEntry *delta_entry) {
     TxnTimeStamp max_commit_ts = delta_entry->commit_ts();
@@ -414,9 +414,21 @@ public:
 
     void SetFullCheckpointTs(TxnTimeStamp last_full_ckp_ts);
 
+    // Record the database ("#db") or table ("#db#table") of the entry encode as changed since the last full checkpoint,
+    // so that the full checkpoint serializes its section again.
+    void MarkCheckpointDirty(std::string_view encode);
+
+    // For the changes not made by committed txns, e.g. the replay of a follower.
+    void MarkCheckpointAllDirty();
+
+    // Pick and clear the databases and tables changed since the last call, None if all of them should be serialized again.
+    Optional<HashSet<String>> PickCheckpointDirty();
+
 private:
     void AddDeltaEntryInner(CatalogDeltaEntry *delta_entry);
 
+    void MarkCheckpointDirtyInner(std::string_view encode);
+
     void PruneOpWithSamePrefix(const String &prefix);
 
     void RemoveDeltaOp(TxnTimeStamp max_commit_ts);
@@ -431,6 +443,8 @@ private:
     TxnTimeStamp max_commit_ts_ = 0;
     // update by add delta entry, read by bg_process::checkpoint
     TxnTimeStamp last_full_ckp_ts_{0};
+    HashSet<String> ckp_dirty_encodes_{};
+    bool ckp_all_dirty_{false};
 
     mutable std::mutex catalog_delta_locker_{};
 };
@@ -221,7 +221,8 @@ WalChunkIndexInfo::WalChunkIndexInfo(ChunkIndexEntry *chunk_index_entry)
         case IndexType::kEMVB:
         case IndexType::kIVF:
         case IndexType::kSecondary:
-        case IndexType::kBMP: {
+        case IndexType::kBMP:
+        case IndexType::kDiskAnn: {
             String file_name = ChunkIndexEntry::IndexFileName(segment_index_entry->segment_id(), chunk_index_entry->chunk_id_);
             String file_path = Path(*(segment_index_entry->index_dir())) / file_name;
             paths_.push_back(file_path);
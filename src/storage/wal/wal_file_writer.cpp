@@ -0,0 +1,164 @@
+// Copyright(C) 2023 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+module;
+
+#include <cerrno>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+module wal_file_writer;
+
+import stl;
+import third_party;
+import infinity_exception;
+import default_values;
+import options;
+
+namespace infinity {
+
+WalFileWriter::WalFileWriter() { Reallocate(DEFAULT_WAL_WRITE_BUFFER_SIZE); }
+
+WalFileWriter::~WalFileWriter() {
+    if (IsOpen()) {
+        Close();
+    }
+    std::free(buffer_);
+}
+
+void WalFileWriter::Open(const String &path) {
+    if (IsOpen()) {
+        String error_message = fmt::format("WAL file: {} is already open", path_);
+        UnrecoverableError(error_message);
+    }
+    fd_ = open(path.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0666);
+    if (fd_ == -1) {
+        String error_message = fmt::format("Failed to open wal file: {}, error: {}", path, strerror(errno));
+        UnrecoverableError(error_message);
+    }
+    struct stat s{};
+    if (fstat(fd_, &s) == -1) {
+        String error_message = fmt::format("Failed to stat wal file: {}, error: {}", path, strerror(errno));
+        UnrecoverableError(error_message);
+    }
+    path_ = path;
+    file_size_ = s.st_size;
+    synced_size_ = file_size_;
+    buffer_size_ = 0;
+    last_sync_time_ = std::chrono::steady_clock::now();
+}
+
+void WalFileWriter::Close() {
+    Sync();
+    if (close(fd_) == -1) {
+        String error_message = fmt::format("Close wal file: {}, error: {}", path_, strerror(errno));
+        UnrecoverableError(error_message);
+    }
+    fd_ = -1;
+    path_.clear();
+}
+
+char *WalFileWriter::Reserve(SizeT size) {
+    if (buffer_size_ + size > buffer_capacity_) {
+        Write();
+        if (size > buffer_capacity_) {
+            Reallocate(size);
+        }
+    }
+    return buffer_ + buffer_size_;
+}
+
+void WalFileWriter::Commit(SizeT size) { buffer_size_ += size; }
+
+void WalFileWriter::Append(const char *data, SizeT size) {
+    std::memcpy(Reserve(size), data, size);
+    Commit(size);
+}
+
+void WalFileWriter::Write() {
+    SizeT written = 0;
+    while (written < buffer_size_) {
+        ssize_t write_count = write(fd_, buffer_ + written, buffer_size_ - written);
+        if (write_count == -1) {
+            if (errno == EINTR) {
+                continue;
+            }
+            String error_message = fmt::format("Can't write wal file: {}, error: {}", path_, strerror(errno));
+            UnrecoverableError(error_message);
+        }
+        written += write_count;
+    }
+    file_size_ += buffer_size_;
+    buffer_size_ = 0;
+}
+
+void WalFileWriter::Sync() {
+    Write();
+    if (synced_size_ == file_size_) {
+        return;
+    }
+#if defined(__APPLE__)
+    i32 ret = fsync(fd_);
+#else
+    // fdatasync also persists the grown file size, which is needed to read the appended entries back.
+    i32 ret = fdatasync(fd_);
+#endif
+    if (ret == -1) {
+        String error_message = fmt::format("Can't sync wal file: {}, error: {}", path_, strerror(errno));
+        UnrecoverableError(error_message);
+    }
+    synced_size_ = file_size_;
+    last_sync_time_ = std::chrono::steady_clock::now();
+}
+
+bool WalFileWriter::Flush(FlushOptionType flush_option, std::chrono::steady_clock::time_point now) {
+    switch (flush_option) {
+        case FlushOptionType::kFlushAtOnce: {
+            // Group commit: one sync for the whole batch
+            Sync();
+            return true;
+        }
+        case FlushOptionType::kOnlyWrite: {
+            Write();
+            return false;
+        }
+        case FlushOptionType::kFlushPerSecond: {
+            Write();
+            if (now - last_sync_time_ < std::chrono::milliseconds(WAL_SYNC_INTERVAL_MS)) {
+                return false;
+            }
+            Sync();
+            return true;
+        }
+    }
+    return false;
+}
+
+void WalFileWriter::Reallocate(SizeT capacity) {
+    // Only called with an empty buffer
+    capacity = (capacity + WAL_WRITE_BUFFER_ALIGNMENT - 1) / WAL_WRITE_BUFFER_ALIGNMENT * WAL_WRITE_BUFFER_ALIGNMENT;
+    std::free(buffer_);
+    buffer_ = static_cast<char *>(std::aligned_alloc(WAL_WRITE_BUFFER_ALIGNMENT, capacity));
+    if (buffer_ == nullptr) {
+        String error_message = fmt::format("Failed to allocate wal write buffer of {} bytes", capacity);
+        UnrecoverableError(error_message);
+    }
+    buffer_capacity_ = capacity;
+}
+
+} // namespace infinity
@@ -0,0 +1,86 @@
+// Copyright(C) 2023 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+module;
+
+export module wal_file_writer;
+
+import stl;
+import options;
+
+namespace infinity {
+
+// Append-only writer of the current WAL file. The entries of a flush batch are serialized into one reusable aligned
+// buffer and written with a single write(). The file size is tracked in memory instead of being stat-ed for each batch.
+export class WalFileWriter {
+public:
+    WalFileWriter();
+
+    ~WalFileWriter();
+
+    WalFileWriter(const WalFileWriter &) = delete;
+
+    WalFileWriter &operator=(const WalFileWriter &) = delete;
+
+    void Open(const String &path);
+
+    // Write the buffered data, sync and close the file.
+    void Close();
+
+    [[nodiscard]] inline bool IsOpen() const { return fd_ != -1; }
+
+    // Return a buffer of `size` bytes to serialize an entry into, it's valid until Commit().
+    char *Reserve(SizeT size);
+
+    // Append the first `size` bytes of the last reserved buffer.
+    void Commit(SizeT size);
+
+    void Append(const char *data, SizeT size);
+
+    // Write the buffered data to the OS page cache.
+    void Write();
+
+    // Write the buffered data and make the file durable.
+    void Sync();
+
+    // Write the buffered data of a flush batch. kFlushAtOnce syncs it, kOnlyWrite leaves it to the OS, and
+    // kFlushPerSecond syncs it once WAL_SYNC_INTERVAL_MS has passed since the last sync. Return whether the file was synced.
+    bool Flush(FlushOptionType flush_option, std::chrono::steady_clock::time_point now);
+
+    // Time of the last sync, or of Open()
+    [[nodiscard]] inline std::chrono::steady_clock::time_point LastSyncTime() const { return last_sync_time_; }
+
+    // Bytes written since the last Sync()
+    [[nodiscard]] inline i64 UnsyncedSize() const { return file_size_ + buffer_size_ - synced_size_; }
+
+    // Size of the file, including the buffered data
+    [[nodiscard]] inline i64 FileSize() const { return file_size_ + buffer_size_; }
+
+private:
+    void Reallocate(SizeT capacity);
+
+private:
+    i32 fd_{-1};
+    String path_{};
+
+    char *buffer_{};
+    SizeT buffer_capacity_{};
+    SizeT buffer_size_{};
+
+    i64 file_size_{};
+    i64 synced_size_{};
+    std::chrono::steady_clock::time_point last_sync_time_{};
+};
+
+} // namespace infinity
@@ -14,8 +14,11 @@
 
 module;
 
+#include <chrono>
+#include <exception>
 #include <filesystem>
 #include <fstream>
+#include <mutex>
 #include <thread>
 
 import stl;
@@ -28,6 +31,7 @@ import third_party;
 import catalog;
 import table_entry_type;
 import infinity_context;
+import config;
 import txn_store;
 import data_access_state;
 import status;
@@ -61,6 +65,7 @@ import cleanup_scanner;
 import global_resource_usage;
 import txn_state;
 import meta_info;
+import profiler;
 
 module wal_manager;
 
@@ -112,11 +117,7 @@ void WalManager::Start() {
         VirtualStore::MakeDirectory(wal_dir_);
     }
     // TODO: recovery from wal checkpoint
-    ofs_ = std::ofstream(wal_path_, std::ios::app | std::ios::binary);
-    if (!ofs_.is_open()) {
-        String error_message = fmt::format("Failed to open wal file: {}", wal_path_);
-        UnrecoverableError(error_message);
-    }
+    wal_writer_.Open(wal_path_);
     LOG_INFO(fmt::format("Open wal file: {}", wal_path_));
 
     wal_size_ = 0;
@@ -147,7 +148,7 @@ void WalManager::Stop() {
     LOG_TRACE("WalManager::Stop flush thread join");
     flush_thread_.join();
 
-    ofs_.close();
+    wal_writer_.Close();
     LOG_INFO("WAL manager is stopped.");
 }
 
@@ -293,8 +294,21 @@ void WalManager::Flush() {
 
     Deque<Txn *> txn_batch{};
     ClusterManager *cluster_manager = nullptr;
+    const auto sync_interval = std::chrono::milliseconds(WAL_SYNC_INTERVAL_MS);
     while (running_.load()) {
-        wait_flush_.DequeueBulk(txn_batch);
+        if (flush_option_ == FlushOptionType::kFlushPerSecond && wal_writer_.UnsyncedSize() > 0) {
+            // Sync the WAL written by the previous batches in time, even if no transaction comes.
+            auto elapsed = std::chrono::steady_clock::now() - wal_writer_.LastSyncTime();
+            if (elapsed >= sync_interval) {
+                wal_writer_.Sync();
+                continue;
+            }
+            if (!wait_flush_.DequeueBulkFor(txn_batch, std::chrono::ceil<std::chrono::milliseconds>(sync_interval - elapsed))) {
+                continue;
+            }
+        } else {
+            wait_flush_.DequeueBulk(txn_batch);
+        }
         if (txn_batch.empty()) {
             LOG_WARN("WalManager::Dequeue empty batch logs");
             continue;
@@ -326,11 +340,12 @@ void WalManager::Flush() {
                 LOG_TRACE(fmt::format("WAL CMD: {}", cmd->ToString()));
             }
 
+            // Serialize the entry into the write buffer of the WAL file directly.
             i32 exp_size = entry->GetSizeInBytes();
-            SharedPtr<String> buf = MakeShared<String>(exp_size, 0);
-            char *ptr = buf->data();
+            char *buf = wal_writer_.Reserve(exp_size);
+            char *ptr = buf;
             entry->WriteAdv(ptr);
-            i32 act_size = ptr - buf->data();
+            i32 act_size = ptr - buf;
             if (exp_size != act_size) {
                 String error_message = fmt::format("WalManager::Flush WalEntry estimated size {} differ with the actual one {}, entry {}",
                                                    exp_size,
@@ -338,14 +353,14 @@ void WalManager::Flush() {
                                                    entry->ToString());
                 UnrecoverableError(error_message);
             }
-            ofs_.write(buf->data(), ptr - buf->data());
 
             if (InfinityContext::instance().GetServerRole() == NodeRole::kLeader) {
                 if (cluster_manager == nullptr) {
                     cluster_manager = InfinityContext::instance().cluster_manager();
                 }
-                cluster_manager->PrepareLogs(buf);
+                cluster_manager->PrepareLogs(MakeShared<String>(buf, act_size));
             }
+            wal_writer_.Commit(act_size);
 
             LOG_TRACE(fmt::format("WalManager::Flush done writing wal for txn_id {}, commit_ts {}", entry->txn_id_, entry->commit_ts_));
 
@@ -356,20 +371,7 @@ void WalManager::Flush() {
             break;
         }
 
-        switch (flush_option_) {
-            case FlushOptionType::kFlushAtOnce: {
-                ofs_.flush();
-                break;
-            }
-            case FlushOptionType::kOnlyWrite: {
-                ofs_.flush(); // FIXME: not flush, only write
-                break;
-            }
-            case FlushOptionType::kFlushPerSecond: {
-                ofs_.flush(); // FIXME: not flush, flush per second
-                break;
-            }
-        }
+        wal_writer_.Flush(flush_option_, std::chrono::steady_clock::now());
 
         if (InfinityContext::instance().GetServerRole() == NodeRole::kLeader) {
             cluster_manager->SyncLogs();
@@ -383,17 +385,9 @@ void WalManager::Flush() {
         txn_batch.clear();
 
         // Check if the wal file is too large, swap to a new one.
-        try {
-            auto file_size = VirtualStore::GetFileSize(wal_path_);
-            if (file_size > cfg_wal_size_threshold_) {
-                LOG_INFO(fmt::format("WAL size: {} is larger than threshold: {}", file_size, cfg_wal_size_threshold_));
-                this->SwapWalFile(max_commit_ts_, true);
-            }
-        } catch (RecoverableException &e) {
-            LOG_ERROR(e.what());
-        } catch (UnrecoverableException &e) {
-            LOG_CRITICAL(e.what());
-            throw e;
+        if (i64 file_size = wal_writer_.FileSize(); file_size > i64(cfg_wal_size_threshold_)) {
+            LOG_INFO(fmt::format("WAL size: {} is larger than threshold: {}", file_size, cfg_wal_size_threshold_));
+            this->SwapWalFile(max_commit_ts_, true);
         }
 
         // Check if total wal is too large, do delta checkpoint
@@ -455,9 +449,9 @@ void WalManager::FlushLogByReplication(const Vector<String> &synced_logs, bool o
     }
 
     for (const String &synced_log : synced_logs) {
-        ofs_.write(synced_log.c_str(), synced_log.size());
+        wal_writer_.Append(synced_log.c_str(), synced_log.size());
     }
-    ofs_.flush();
+    wal_writer_.Flush(flush_option_, std::chrono::steady_clock::now());
 }
 
 bool WalManager::TrySubmitCheckpointTask(SharedPtr<CheckpointTaskBase> ckp_task) {
@@ -631,8 +625,8 @@ void WalManager::SwapWalFile(const TxnTimeStamp max_commit_ts, bool error_if_dup
         return;
     }
 
-    if (ofs_.is_open()) {
-        ofs_.close();
+    if (wal_writer_.IsOpen()) {
+        wal_writer_.Close();
     }
 
     String new_file_path = fmt::format("{}/{}", wal_dir_, WalFile::WalFilename(max_commit_ts));
@@ -657,11 +651,7 @@ void WalManager::SwapWalFile(const TxnTimeStamp max_commit_ts, bool error_if_dup
     }
 
     // Create a new wal file with the original name.
-    ofs_ = std::ofstream(wal_path_, std::ios::app | std::ios::binary);
-    if (!ofs_.is_open()) {
-        String error_message = fmt::format("Failed to open wal file: {}", wal_path_);
-        UnrecoverableError(error_message);
-    }
+    wal_writer_.Open(wal_path_);
 
     last_swap_wal_ts_ = max_commit_ts;
     LOG_INFO(fmt::format("Open new wal file {}", wal_path_));
@@ -734,6 +724,8 @@ i64 WalManager::ReplayWalFile(StorageMode targe_storage_mode) {
 
     LOG_INFO("Start Wal Replay");
     // log the wal files.
+    BaseProfiler scan_profiler("WalScan");
+    scan_profiler.Begin();
 
     TxnTimeStamp max_checkpoint_ts = 0; // the max commit ts that has been checkpointed
     Vector<SharedPtr<WalEntry>> replay_entries;
@@ -785,6 +777,8 @@ i64 WalManager::ReplayWalFile(StorageMode targe_storage_mode) {
         }
     }
 
+    scan_profiler.End();
+
     if (last_commit_ts == 0) {
         switch (targe_storage_mode) {
             case StorageMode::kWritable: {
@@ -809,28 +803,37 @@ i64 WalManager::ReplayWalFile(StorageMode targe_storage_mode) {
         UnrecoverableError(error_message);
     }
     auto &[full_catalog_fileinfo, delta_catalog_fileinfo_array] = catalog_fileinfo.value();
+    BaseProfiler catalog_profiler("CatalogLoad");
+    catalog_profiler.Begin();
     storage_->AttachCatalog(full_catalog_fileinfo, delta_catalog_fileinfo_array);
+    catalog_profiler.End();
 
     // phase 3: replay the entries
     LOG_INFO(fmt::format("Replay phase 3: replay {} entries", replay_entries.size()));
     std::reverse(replay_entries.begin(), replay_entries.end());
     TransactionID last_txn_id = 0;
 
-    for (SizeT replay_count = 0; replay_count < replay_entries.size(); ++replay_count) {
-        if (replay_entries[replay_count]->commit_ts_ < max_checkpoint_ts) {
+    for (const auto &replay_entry : replay_entries) {
+        if (replay_entry->commit_ts_ < max_checkpoint_ts) {
             String error_message = fmt::format("Wal Replay: Commit ts should be greater than max commit ts, commit_ts: {}, max_commit: {}",
-                                               replay_entries[replay_count]->commit_ts_,
+                                               replay_entry->commit_ts_,
                                                max_checkpoint_ts);
             UnrecoverableError(error_message);
         }
-        last_commit_ts = replay_entries[replay_count]->commit_ts_;
-        last_txn_id = replay_entries[replay_count]->txn_id_;
-
-        LOG_DEBUG(replay_entries[replay_count]->ToString());
-        ReplayWalOptions options{.on_startup_ = false, .is_replay_ = true, .sync_from_leader_ = false};
-        ReplayWalEntry(*replay_entries[replay_count], options);
+        last_commit_ts = replay_entry->commit_ts_;
+        last_txn_id = replay_entry->txn_id_;
     }
 
+    BaseProfiler replay_profiler("WalReplay");
+    replay_profiler.Begin();
+    ReplayWalEntries(replay_entries);
+    replay_profiler.End();
+    LOG_INFO(fmt::format("Startup time, scan wal: {}, load catalog: {}, replay {} wal entries: {}",
+                         scan_profiler.ElapsedToString(1000),
+                         catalog_profiler.ElapsedToString(1000),
+                         replay_entries.size(),
+                         replay_profiler.ElapsedToString(1000)));
+
     LOG_INFO(fmt::format("Latest txn commit_ts: {}, latest txn id: {}", last_commit_ts, last_txn_id));
     storage_->catalog()->next_txn_id_ = last_txn_id;
     UpdateCommitState(last_commit_ts, 0);
@@ -841,6 +844,114 @@ i64 WalManager::ReplayWalFile(StorageMode targe_storage_mode) {
     return system_start_ts;
 }
 
+namespace {
+
+// The table if all commands of the entry are appends, deletes or imports of one table, otherwise the entry is a barrier of parallel replay.
+Optional<Pair<String, String>> ParallelReplayTable(const WalEntry &entry) {
+    Optional<Pair<String, String>> table;
+    for (const auto &cmd : entry.cmds_) {
+        Pair<String, String> cmd_table;
+        switch (cmd->GetType()) {
+            case WalCommandType::APPEND: {
+                const auto *append_cmd = static_cast<const WalCmdAppend *>(cmd.get());
+                cmd_table = {append_cmd->db_name_, append_cmd->table_name_};
+                break;
+            }
+            case WalCommandType::DELETE: {
+                const auto *delete_cmd = static_cast<const WalCmdDelete *>(cmd.get());
+                cmd_table = {delete_cmd->db_name_, delete_cmd->table_name_};
+                break;
+            }
+            case WalCommandType::IMPORT: {
+                const auto *import_cmd = static_cast<const WalCmdImport *>(cmd.get());
+                cmd_table = {import_cmd->db_name_, import_cmd->table_name_};
+                break;
+            }
+            default: {
+                return None;
+            }
+        }
+        if (table.has_value() && *table != cmd_table) {
+            return None;
+        }
+        table = std::move(cmd_table);
+    }
+    return table;
+}
+
+} // namespace
+
+void WalManager::ReplayWalEntries(const Vector<SharedPtr<WalEntry>> &replay_entries) {
+    ReplayWalOptions options{.on_startup_ = false, .is_replay_ = true, .sync_from_leader_ = false};
+    // Entries of each table since the last barrier, in commit ts order
+    Vector<Vector<const WalEntry *>> table_entries;
+    Map<Pair<String, String>, SizeT> table_ids;
+    SizeT barrier_count = 0;
+    for (const auto &replay_entry : replay_entries) {
+        LOG_DEBUG(replay_entry->ToString());
+        Optional<Pair<String, String>> table = ParallelReplayTable(*replay_entry);
+        if (!table.has_value()) {
+            ReplayTableEntries(table_entries);
+            table_entries.clear();
+            table_ids.clear();
+            ReplayWalEntry(*replay_entry, options);
+            ++barrier_count;
+            continue;
+        }
+        auto [iter, inserted] = table_ids.emplace(std::move(*table), table_entries.size());
+        if (inserted) {
+            table_entries.emplace_back();
+        }
+        table_entries[iter->second].push_back(replay_entry.get());
+    }
+    ReplayTableEntries(table_entries);
+    LOG_INFO(fmt::format("Replayed {} wal entries, {} of them are barriers", replay_entries.size(), barrier_count));
+}
+
+void WalManager::ReplayTableEntries(const Vector<Vector<const WalEntry *>> &table_entries) {
+    ReplayWalOptions options{.on_startup_ = false, .is_replay_ = true, .sync_from_leader_ = false};
+    auto replay_table = [&](SizeT table_id) {
+        for (const WalEntry *entry : table_entries[table_id]) {
+            ReplayWalEntry(*entry, options);
+        }
+    };
+    SizeT thread_count = std::min({table_entries.size(),
+                                   SizeT(Thread::hardware_concurrency()),
+                                   SizeT(InfinityContext::instance().config()->WALReplayThreadNum())});
+    if (thread_count <= 1) {
+        for (SizeT table_id = 0; table_id < table_entries.size(); ++table_id) {
+            replay_table(table_id);
+        }
+        return;
+    }
+
+    atomic_u64 next_table_id{0};
+    std::mutex error_mutex;
+    std::exception_ptr error;
+    Vector<Thread> threads;
+    threads.reserve(thread_count);
+    for (SizeT i = 0; i < thread_count; ++i) {
+        threads.emplace_back([&] {
+            try {
+                for (SizeT table_id = next_table_id.fetch_add(1); table_id < table_entries.size(); table_id = next_table_id.fetch_add(1)) {
+                    replay_table(table_id);
+                }
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(error_mutex);
+                if (error == nullptr) {
+                    error = std::current_exception();
+                }
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    if (error != nullptr) {
+        std::rethrow_exception(error);
+    }
+}
+
 Optional<Pair<FullCatalogFileInfo, Vector<DeltaCatalogFileInfo>>> WalManager::GetCatalogFiles() const {
     Vector<String> wal_list{};
     {
@@ -986,6 +1097,10 @@ Vector<SharedPtr<WalEntry>> WalManager::CollectWalEntries() const {
 
 void WalManager::ReplayWalEntry(const WalEntry &entry, ReplayWalOptions options) {
     auto [on_startup, is_replay, sync_from_leader] = options;
+    if (sync_from_leader && storage_->catalog() != nullptr) {
+        // Changes without committed txns, the next full checkpoint serializes all tables again.
+        storage_->catalog()->MarkCheckpointAllDirty();
+    }
     for (const auto &cmd : entry.cmds_) {
         LOG_TRACE(fmt::format("Replay wal cmd: {}, commit ts: {}", WalCmd::WalCommandTypeToString(cmd->GetType()).c_str(), entry.commit_ts_));
         switch (cmd->GetType()) {
@@ -23,6 +23,7 @@ import options;
 import catalog_delta_entry;
 import blocking_queue;
 import log_file;
+import wal_file_writer;
 
 namespace infinity {
 
@@ -113,6 +114,19 @@ public:
     void UpdateCommitState(TxnTimeStamp commit_ts, i64 wal_size);
 
 private:
+    // Replay the entries after the checkpoint in commit ts order. Appends, deletes and imports of different tables
+    // are replayed by parallel threads, any other command waits for all of them.
+    void ReplayWalEntries(const Vector<SharedPtr<WalEntry>> &replay_entries);
+
+    // Replay the entries of each table on up to wal_replay_thread_num threads, one thread per table at a time.
+    // The threads share no catalog state they write:
+    // - the db and table are looked up under the read locks of the meta maps, which only the barriers change;
+    // - the replay txn and its table store are local to the entry;
+    // - Catalog::Append, Catalog::Delete, Catalog::CommitWrite, ReplaySegment and AddSegmentReplayWalImport
+    //   only write the entry's own table, its segments and blocks, which no other thread touches until the lanes join;
+    // - the buffer manager and the persistence manager are locked internally, as for concurrent commits.
+    void ReplayTableEntries(const Vector<Vector<const WalEntry *>> &table_entries);
+
     // Checkpoint Helper
     void FullCheckpointInner(Txn *txn);
     void DeltaCheckpointInner(Txn *txn);
@@ -174,7 +188,7 @@ private:
     BlockingQueue<Txn *> wait_flush_{"WalManager"};
 
     // Only Flush thread access following members
-    std::ofstream ofs_{};
+    WalFileWriter wal_writer_{};
     FlushOptionType flush_option_{FlushOptionType::kOnlyWrite};
 
     // Flush and Checkpoint threads access following members
@@ -0,0 +1,199 @@
+// Copyright(C) 2024 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "gtest/gtest.h"
+#include <random>
+import base_test;
+
+import stl;
+import work_stealing_queue;
+import blocking_queue;
+
+using namespace infinity;
+class WorkStealingQueueTest : public BaseTest {};
+
+namespace {
+
+struct StressTask {
+    u32 task_id_{};
+    // The task is put back until it has run so many times, as an unfinished fragment task is.
+    u32 required_run_n_{};
+    Atomic<u32> run_n_{0};
+    atomic_bool running_{false};
+};
+
+// The queues of one worker, the same as the ones of the TaskScheduler workers.
+struct StressWorker {
+    BlockingQueue<StressTask *> inbox_{"WorkStealingQueueTest"};
+    WorkStealingQueue<StressTask *> run_queue_{64};
+};
+
+} // namespace
+
+TEST_F(WorkStealingQueueTest, push_pop) {
+    WorkStealingQueue<u64 *> queue(5);
+    EXPECT_EQ(queue.Capacity(), 8u);
+    EXPECT_EQ(queue.Pop(), nullptr);
+
+    Vector<u64> values(10);
+    for (SizeT i = 0; i < 8; ++i) {
+        EXPECT_TRUE(queue.Push(&values[i]));
+    }
+    EXPECT_FALSE(queue.Push(&values[8]));
+    EXPECT_EQ(queue.Size(), 8u);
+
+    // FIFO, and the slots are reused after wrapping around
+    for (SizeT round = 0; round < 3; ++round) {
+        for (SizeT i = 0; i < 8; ++i) {
+            EXPECT_EQ(queue.Pop(), &values[(round * 8 + i) % 10]);
+            EXPECT_TRUE(queue.Push(&values[(round * 8 + i + 8) % 10]));
+        }
+    }
+    for (SizeT i = 0; i < 8; ++i) {
+        EXPECT_EQ(queue.Pop(), &values[(24 + i) % 10]);
+    }
+    EXPECT_EQ(queue.Pop(), nullptr);
+    EXPECT_EQ(queue.Size(), 0u);
+}
+
+// The owner pushes while the thieves pop, each item is taken exactly once.
+TEST_F(WorkStealingQueueTest, steal) {
+    constexpr SizeT item_n = 200000;
+    constexpr SizeT thief_n = 4;
+    WorkStealingQueue<u64 *> queue(256);
+    Vector<u64> items(item_n);
+    Vector<Atomic<u32>> taken_counts(item_n);
+    Atomic<SizeT> taken_n{0};
+
+    auto take = [&](u64 *item) {
+        ++taken_counts[item - items.data()];
+        ++taken_n;
+    };
+    Vector<Thread> thieves;
+    for (SizeT i = 0; i < thief_n; ++i) {
+        thieves.emplace_back([&] {
+            while (taken_n < item_n) {
+                if (u64 *item = queue.Pop(); item != nullptr) {
+                    take(item);
+                }
+            }
+        });
+    }
+    for (SizeT i = 0; i < item_n;) {
+        if (queue.Push(&items[i])) {
+            ++i;
+        } else if (u64 *item = queue.Pop(); item != nullptr) {
+            // the owner also runs its tasks when the queue is full
+            take(item);
+        }
+    }
+    for (auto &thief : thieves) {
+        thief.join();
+    }
+    EXPECT_EQ(taken_n.load(), item_n);
+    for (SizeT i = 0; i < item_n; ++i) {
+        EXPECT_EQ(taken_counts[i].load(), 1u);
+    }
+}
+
+// Several producers place tasks in the worker inboxes, the workers move them to their run queues, run them, put the
+// unfinished ones back and steal from each other as the TaskScheduler workers do. Every task runs as many times as it
+// requires, never on two workers at once, and none is lost.
+TEST_F(WorkStealingQueueTest, multi_producer_stealer_stress) {
+    constexpr SizeT worker_n = 8;
+    constexpr SizeT producer_n = 4;
+    constexpr SizeT task_n = 40000;
+    Vector<UniquePtr<StressTask>> tasks;
+    SizeT total_run_n = 0;
+    for (SizeT i = 0; i < task_n; ++i) {
+        auto task = MakeUnique<StressTask>();
+        task->task_id_ = i;
+        task->required_run_n_ = 1 + i % 3;
+        total_run_n += task->required_run_n_;
+        tasks.emplace_back(std::move(task));
+    }
+    Vector<UniquePtr<StressWorker>> workers;
+    for (SizeT i = 0; i < worker_n; ++i) {
+        workers.emplace_back(MakeUnique<StressWorker>());
+    }
+    Atomic<SizeT> run_n{0};
+    atomic_bool overlap{false};
+
+    auto take_task = [&](SizeT worker_id) -> StressTask * {
+        auto &worker = *workers[worker_id];
+        while (worker.run_queue_.Size() < worker.run_queue_.Capacity()) {
+            StressTask *task = nullptr;
+            if (!worker.inbox_.TryDequeue(task)) {
+                break;
+            }
+            worker.run_queue_.Push(task);
+        }
+        StressTask *task = worker.run_queue_.Pop();
+        if (task == nullptr) {
+            worker.inbox_.TryDequeue(task);
+        }
+        for (SizeT i = 1; task == nullptr && i < worker_n; ++i) {
+            auto &victim = *workers[(worker_id + i) % worker_n];
+            task = victim.run_queue_.Pop();
+            if (task == nullptr) {
+                victim.inbox_.TryDequeue(task);
+            }
+        }
+        return task;
+    };
+
+    Vector<Thread> threads;
+    for (SizeT worker_id = 0; worker_id < worker_n; ++worker_id) {
+        threads.emplace_back([&, worker_id] {
+            auto &worker = *workers[worker_id];
+            while (run_n < total_run_n) {
+                StressTask *task = take_task(worker_id);
+                if (task == nullptr) {
+                    std::this_thread::yield();
+                    continue;
+                }
+                if (task->running_.exchange(true)) {
+                    overlap = true;
+                }
+                u32 task_run_n = ++task->run_n_;
+                task->running_ = false;
+                ++run_n;
+                if (task_run_n < task->required_run_n_ && !worker.run_queue_.Push(task)) {
+                    worker.inbox_.Enqueue(task);
+                }
+            }
+        });
+    }
+    for (SizeT producer_id = 0; producer_id < producer_n; ++producer_id) {
+        threads.emplace_back([&, producer_id] {
+            std::mt19937 rng(producer_id);
+            for (SizeT i = producer_id; i < task_n; i += producer_n) {
+                workers[rng() % worker_n]->inbox_.Enqueue(tasks[i].get());
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_FALSE(overlap.load());
+    EXPECT_EQ(run_n.load(), total_run_n);
+    for (const auto &task : tasks) {
+        EXPECT_EQ(task->run_n_.load(), task->required_run_n_) << "task " << task->task_id_;
+    }
+    for (const auto &worker : workers) {
+        EXPECT_TRUE(worker->inbox_.Empty());
+        EXPECT_EQ(worker->run_queue_.Size(), 0u);
+    }
+}
@@ -0,0 +1,118 @@
+// Copyright(C) 2024 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "gtest/gtest.h"
+import base_test;
+
+import stl;
+import external_sort;
+import data_block;
+import column_vector;
+import data_type;
+import logical_type;
+import value;
+import select_statement;
+import internal_types;
+
+using namespace infinity;
+class ExternalSortTest : public BaseTest {};
+
+namespace {
+
+SharedPtr<ColumnVector> MakeColumn(LogicalType logical_type) {
+    auto column = ColumnVector::Make(MakeShared<DataType>(logical_type));
+    column->Initialize();
+    return column;
+}
+
+} // namespace
+
+TEST_F(ExternalSortTest, integer_and_double_key) {
+    using namespace infinity;
+    Vector<i32> ints{3, -1, 3, 0, -7};
+    Vector<f64> doubles{1.5, 2.0, -0.5, -0.0, 0.0};
+    Vector<SharedPtr<ColumnVector>> columns{MakeColumn(LogicalType::kInteger), MakeColumn(LogicalType::kDouble)};
+    for (SizeT i = 0; i < ints.size(); ++i) {
+        columns[0]->AppendValue(Value::MakeInt(ints[i]));
+        columns[1]->AppendValue(Value::MakeDouble(doubles[i]));
+    }
+    // The integer of row 4 is NULL, which is smaller than any value.
+    columns[0]->nulls_ptr_->SetFalse(4);
+
+    SortKeys keys;
+    SortKeyEncoder::EncodeColumns(columns, {OrderType::kAsc, OrderType::kDesc}, ints.size(), keys);
+    EXPECT_EQ(keys.size(), ints.size());
+    EXPECT_LT(keys.Get(4), keys.Get(1));
+    EXPECT_LT(keys.Get(1), keys.Get(3));
+    EXPECT_LT(keys.Get(3), keys.Get(0));
+    // Same integer, the double is in descending order.
+    EXPECT_LT(keys.Get(0), keys.Get(2));
+
+    // -0.0 and 0.0 are encoded the same.
+    SortKeys double_keys;
+    SortKeyEncoder::EncodeColumns({columns[1]}, {OrderType::kAsc}, ints.size(), double_keys);
+    EXPECT_EQ(double_keys.Get(3), double_keys.Get(4));
+    EXPECT_LT(double_keys.Get(2), double_keys.Get(3));
+}
+
+TEST_F(ExternalSortTest, varchar_key) {
+    using namespace infinity;
+    Vector<String> names{"ab", "a", String("a\0b", 3), "a much longer name to be stored out of line", ""};
+    Vector<SharedPtr<ColumnVector>> columns{MakeColumn(LogicalType::kVarchar)};
+    for (const auto &name : names) {
+        columns[0]->AppendValue(Value::MakeVarchar(name));
+    }
+    SortKeys keys;
+    SortKeyEncoder::EncodeColumns(columns, {OrderType::kAsc}, names.size(), keys);
+
+    Vector<SizeT> order{0, 1, 2, 3, 4};
+    std::sort(order.begin(), order.end(), [&](SizeT left, SizeT right) { return keys.Get(left) < keys.Get(right); });
+    Vector<SizeT> expected{4, 1, 2, 3, 0};
+    EXPECT_EQ(order, expected);
+}
+
+TEST_F(ExternalSortTest, sort_blocks) {
+    using namespace infinity;
+    Vector<SharedPtr<DataType>> column_types{MakeShared<DataType>(LogicalType::kBigInt), MakeShared<DataType>(LogicalType::kVarchar)};
+    SizeT block_count = 3;
+    SizeT row_count = 5000;
+    Vector<UniquePtr<DataBlock>> input_blocks;
+    Vector<SortKeys> keys(block_count);
+    for (SizeT block_id = 0; block_id < block_count; ++block_id) {
+        auto data_block = MakeUnique<DataBlock>();
+        data_block->Init(column_types);
+        for (SizeT i = 0; i < row_count; ++i) {
+            i64 value = (i * block_count + block_id) * 7919 % (block_count * row_count);
+            data_block->column_vectors[0]->AppendValue(Value::MakeBigInt(value));
+            data_block->column_vectors[1]->AppendValue(Value::MakeVarchar("name_" + std::to_string(value)));
+        }
+        data_block->Finalize();
+        SortKeyEncoder::EncodeColumns({data_block->column_vectors[0]}, {OrderType::kDesc}, row_count, keys[block_id]);
+        input_blocks.push_back(std::move(data_block));
+    }
+
+    Vector<UniquePtr<DataBlock>> output_blocks;
+    SortBlocks(input_blocks, keys, output_blocks);
+    SizeT output_row_count = 0;
+    i64 expected = block_count * row_count - 1;
+    for (const auto &output_block : output_blocks) {
+        EXPECT_LE(output_block->row_count(), output_block->capacity());
+        for (SizeT i = 0; i < output_block->row_count(); ++i, --expected) {
+            EXPECT_EQ(output_block->GetValue(0, i), Value::MakeBigInt(expected));
+            EXPECT_EQ(output_block->GetValue(1, i), Value::MakeVarchar("name_" + std::to_string(expected)));
+        }
+        output_row_count += output_block->row_count();
+    }
+    EXPECT_EQ(output_row_count, block_count * row_count);
+}
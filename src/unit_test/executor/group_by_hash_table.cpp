@@ -0,0 +1,138 @@
+// Copyright(C) 2024 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "gtest/gtest.h"
+import base_test;
+
+import stl;
+import hash_table;
+import column_vector;
+import data_type;
+import logical_type;
+import value;
+import internal_types;
+import embedding_info;
+import infinity_exception;
+
+using namespace infinity;
+class GroupByHashTableTest : public BaseTest {};
+
+namespace {
+
+SharedPtr<ColumnVector> MakeColumn(LogicalType logical_type) {
+    auto column = ColumnVector::Make(MakeShared<DataType>(logical_type));
+    column->Initialize();
+    return column;
+}
+
+} // namespace
+
+TEST_F(GroupByHashTableTest, fixed_key) {
+    using namespace infinity;
+    GroupByHashTable hash_table;
+    hash_table.Init({MakeShared<DataType>(LogicalType::kBigInt), MakeShared<DataType>(LogicalType::kInteger)}, sizeof(i64));
+
+    // 4 distinct keys of (i % 2, i % 4), the NULL of the second column makes one more group.
+    SizeT row_count = 1000;
+    Vector<SharedPtr<ColumnVector>> columns{MakeColumn(LogicalType::kBigInt), MakeColumn(LogicalType::kInteger)};
+    for (SizeT i = 0; i < row_count; ++i) {
+        columns[0]->AppendValue(Value::MakeBigInt(i % 2));
+        columns[1]->AppendValue(Value::MakeInt(i % 4));
+    }
+    columns[1]->nulls_ptr_->SetFalse(0);
+    columns[1]->nulls_ptr_->SetFalse(4);
+
+    Vector<u32> group_ids;
+    hash_table.FindOrCreateGroups(columns, row_count, group_ids);
+    EXPECT_EQ(hash_table.group_count(), 5u);
+    for (SizeT i = 0; i < row_count; ++i) {
+        ++*reinterpret_cast<i64 *>(hash_table.GetPayload(group_ids[i]));
+    }
+    EXPECT_EQ(group_ids[0], group_ids[4]);
+    EXPECT_NE(group_ids[0], group_ids[8]);
+    EXPECT_EQ(group_ids[8], group_ids[12]);
+
+    // Payloads are kept across the calls.
+    hash_table.FindOrCreateGroups(columns, row_count, group_ids);
+    EXPECT_EQ(hash_table.group_count(), 5u);
+    i64 total = 0;
+    for (u32 group_id = 0; group_id < hash_table.group_count(); ++group_id) {
+        total += *reinterpret_cast<i64 *>(hash_table.GetPayload(group_id));
+    }
+    EXPECT_EQ(total, i64(row_count));
+    EXPECT_EQ(*reinterpret_cast<i64 *>(hash_table.GetPayload(group_ids[0])), 2);
+
+    Vector<SharedPtr<ColumnVector>> keys{MakeColumn(LogicalType::kBigInt), MakeColumn(LogicalType::kInteger)};
+    hash_table.AppendKeys(keys, 0, hash_table.group_count());
+    EXPECT_EQ(keys[0]->Size(), 5u);
+    EXPECT_FALSE(keys[1]->nulls_ptr_->IsTrue(group_ids[0]));
+    EXPECT_EQ(keys[0]->GetValue(group_ids[1]), Value::MakeBigInt(1));
+    EXPECT_EQ(keys[1]->GetValue(group_ids[1]), Value::MakeInt(1));
+}
+
+TEST_F(GroupByHashTableTest, many_groups) {
+    using namespace infinity;
+    GroupByHashTable hash_table;
+    hash_table.Init({MakeShared<DataType>(LogicalType::kBigInt)}, 0);
+
+    SizeT row_count = 8192;
+    SizeT block_count = 4;
+    for (SizeT block_id = 0; block_id < block_count; ++block_id) {
+        Vector<SharedPtr<ColumnVector>> columns{ColumnVector::Make(MakeShared<DataType>(LogicalType::kBigInt))};
+        columns[0]->Initialize(ColumnVectorType::kFlat, row_count);
+        for (SizeT i = 0; i < row_count; ++i) {
+            columns[0]->AppendValue(Value::MakeBigInt(block_id * row_count / 2 + i));
+        }
+        Vector<u32> group_ids;
+        hash_table.FindOrCreateGroups(columns, row_count, group_ids);
+        for (SizeT i = 0; i < row_count; ++i) {
+            EXPECT_EQ(group_ids[i], block_id * row_count / 2 + i);
+        }
+    }
+    EXPECT_EQ(hash_table.group_count(), (block_count + 1) * row_count / 2);
+}
+
+TEST_F(GroupByHashTableTest, varchar_key) {
+    using namespace infinity;
+    GroupByHashTable hash_table;
+    hash_table.Init({MakeShared<DataType>(LogicalType::kVarchar), MakeShared<DataType>(LogicalType::kBoolean)}, sizeof(i64));
+
+    Vector<String> names{"a", "short", "a much longer name to be stored out of line", "short"};
+    Vector<SharedPtr<ColumnVector>> columns{MakeColumn(LogicalType::kVarchar), MakeColumn(LogicalType::kBoolean)};
+    for (const auto &name : names) {
+        columns[0]->AppendValue(Value::MakeVarchar(name));
+        columns[1]->AppendValue(Value::MakeBool(true));
+    }
+    Vector<u32> group_ids;
+    hash_table.FindOrCreateGroups(columns, names.size(), group_ids);
+    EXPECT_EQ(hash_table.group_count(), 3u);
+    EXPECT_EQ(group_ids[1], group_ids[3]);
+
+    Vector<SharedPtr<ColumnVector>> keys{MakeColumn(LogicalType::kVarchar), MakeColumn(LogicalType::kBoolean)};
+    hash_table.AppendKeys(keys, 0, hash_table.group_count());
+    for (u32 group_id = 0; group_id < hash_table.group_count(); ++group_id) {
+        EXPECT_EQ(keys[0]->GetValue(group_id), Value::MakeVarchar(names[group_id]));
+        EXPECT_EQ(keys[1]->GetValue(group_id), Value::MakeBool(true));
+    }
+}
+
+// A column after the varchar one is still checked, an embedding key is rejected instead of overflowing the key buffer.
+TEST_F(GroupByHashTableTest, unsupported_key_after_varchar) {
+    using namespace infinity;
+    GroupByHashTable hash_table;
+    auto embedding_info = MakeShared<EmbeddingInfo>(EmbeddingDataType::kElemFloat, 128);
+    EXPECT_THROW(hash_table.Init({MakeShared<DataType>(LogicalType::kVarchar), MakeShared<DataType>(LogicalType::kEmbedding, embedding_info)},
+                                 sizeof(i64)),
+                 RecoverableException);
+}
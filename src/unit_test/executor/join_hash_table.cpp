@@ -0,0 +1,181 @@
+// Copyright(C) 2024 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "gtest/gtest.h"
+import base_test;
+
+import stl;
+import join_hash_table;
+import data_block;
+import column_vector;
+import data_type;
+import logical_type;
+import value;
+import internal_types;
+
+using namespace infinity;
+class JoinHashTableTest : public BaseTest {};
+
+namespace {
+
+// Block layout: key (bigint), name (varchar), hash (bigint)
+UniquePtr<DataBlock> MakeBlock(const Vector<i64> &keys, SizeT null_key_every) {
+    Vector<SharedPtr<DataType>> column_types{MakeShared<DataType>(LogicalType::kBigInt),
+                                             MakeShared<DataType>(LogicalType::kVarchar),
+                                             MakeShared<DataType>(LogicalType::kBigInt)};
+    auto data_block = MakeUnique<DataBlock>();
+    data_block->Init(column_types);
+    for (SizeT row_id = 0; row_id < keys.size(); ++row_id) {
+        data_block->column_vectors[0]->AppendValue(Value::MakeBigInt(keys[row_id]));
+        data_block->column_vectors[1]->AppendValue(Value::MakeVarchar("name_" + std::to_string(keys[row_id])));
+        data_block->column_vectors[2]->AppendValue(Value::MakeBigInt(0));
+        if (null_key_every != 0 && row_id % null_key_every == 0) {
+            data_block->column_vectors[0]->nulls_ptr_->SetFalse(row_id);
+        }
+    }
+    data_block->Finalize();
+    JoinHashTable::HashKeys(*data_block, {0}, reinterpret_cast<u64 *>(data_block->column_vectors[2]->data()));
+    return data_block;
+}
+
+SizeT CountMatches(const JoinHashTable &hash_table, const DataBlock &probe_block, const Vector<SizeT> &key_ids, SizeT row_id) {
+    if (!JoinHashTable::KeysNotNull(probe_block, key_ids, row_id)) {
+        return 0;
+    }
+    u64 hash = reinterpret_cast<const u64 *>(probe_block.column_vectors[2]->data())[row_id];
+    SizeT match_count = 0;
+    for (u32 entry_id = hash_table.FirstEntry(hash); entry_id != JoinHashTable::kInvalidEntry; entry_id = hash_table.NextEntry(entry_id)) {
+        if (hash_table.GetEntry(entry_id).hash_ == hash && hash_table.Match(entry_id, probe_block, key_ids, row_id)) {
+            ++match_count;
+        }
+    }
+    return match_count;
+}
+
+} // namespace
+
+TEST_F(JoinHashTableTest, build_and_probe) {
+    using namespace infinity;
+    JoinHashTable hash_table({0}, 2);
+
+    // Each key in [0, 1000) appears twice on the build side, spread over two blocks.
+    SizeT key_count = 1000;
+    Vector<i64> keys;
+    for (SizeT i = 0; i < key_count; ++i) {
+        keys.push_back(i);
+    }
+    hash_table.Append(MakeBlock(keys, 0));
+    hash_table.Append(MakeBlock(keys, 0));
+    hash_table.Build();
+    EXPECT_TRUE(hash_table.built());
+    EXPECT_EQ(hash_table.row_count(), key_count * 2);
+
+    Vector<i64> probe_keys;
+    for (SizeT i = 0; i < key_count * 2; ++i) {
+        probe_keys.push_back(i);
+    }
+    UniquePtr<DataBlock> probe_block = MakeBlock(probe_keys, 0);
+    for (SizeT row_id = 0; row_id < probe_keys.size(); ++row_id) {
+        EXPECT_EQ(CountMatches(hash_table, *probe_block, {0}, row_id), row_id < key_count ? 2u : 0u);
+    }
+}
+
+TEST_F(JoinHashTableTest, null_keys) {
+    using namespace infinity;
+    JoinHashTable hash_table({0}, 2);
+
+    Vector<i64> keys{0, 1, 2, 3, 4, 5, 6, 7};
+    // Keys of row 0, 3, 6 are NULL and never chained.
+    hash_table.Append(MakeBlock(keys, 3));
+    hash_table.Build();
+    EXPECT_EQ(hash_table.row_count(), 5u);
+    EXPECT_EQ(hash_table.entry_count(), 8u);
+    for (u32 entry_id = hash_table.row_count(); entry_id < hash_table.entry_count(); ++entry_id) {
+        EXPECT_EQ(hash_table.GetEntry(entry_id).block_offset_ % 3, 0u);
+        EXPECT_EQ(hash_table.NextEntry(entry_id), JoinHashTable::kInvalidEntry);
+    }
+
+    UniquePtr<DataBlock> probe_block = MakeBlock(keys, 0);
+    for (SizeT row_id = 0; row_id < keys.size(); ++row_id) {
+        EXPECT_EQ(CountMatches(hash_table, *probe_block, {0}, row_id), row_id % 3 == 0 ? 0u : 1u);
+    }
+
+    // NULL probe keys match nothing.
+    UniquePtr<DataBlock> null_probe_block = MakeBlock(keys, 1);
+    for (SizeT row_id = 0; row_id < keys.size(); ++row_id) {
+        EXPECT_EQ(CountMatches(hash_table, *null_probe_block, {0}, row_id), 0u);
+    }
+}
+
+TEST_F(JoinHashTableTest, varchar_key) {
+    using namespace infinity;
+    JoinHashTable hash_table({1}, 2);
+
+    Vector<i64> keys{1, 2, 3, 4};
+    UniquePtr<DataBlock> build_block = MakeBlock(keys, 0);
+    JoinHashTable::HashKeys(*build_block, {1}, reinterpret_cast<u64 *>(build_block->column_vectors[2]->data()));
+    hash_table.Append(std::move(build_block));
+    hash_table.Build();
+
+    Vector<i64> probe_keys{3, 4, 5, 6};
+    UniquePtr<DataBlock> probe_block = MakeBlock(probe_keys, 0);
+    JoinHashTable::HashKeys(*probe_block, {1}, reinterpret_cast<u64 *>(probe_block->column_vectors[2]->data()));
+    EXPECT_EQ(CountMatches(hash_table, *probe_block, {1}, 0), 1u);
+    EXPECT_EQ(CountMatches(hash_table, *probe_block, {1}, 1), 1u);
+    EXPECT_EQ(CountMatches(hash_table, *probe_block, {1}, 2), 0u);
+    EXPECT_EQ(CountMatches(hash_table, *probe_block, {1}, 3), 0u);
+}
+
+TEST_F(JoinHashTableTest, parallel_build) {
+    using namespace infinity;
+    JoinHashTable serial_hash_table({0}, 2);
+    JoinHashTable parallel_hash_table({0}, 2);
+
+    // Enough rows for several build tasks, every 7th key is NULL.
+    SizeT block_count = 40;
+    SizeT block_rows = 5000;
+    for (SizeT block_id = 0; block_id < block_count; ++block_id) {
+        Vector<i64> keys;
+        for (SizeT i = 0; i < block_rows; ++i) {
+            keys.push_back(block_id * block_rows + i);
+        }
+        serial_hash_table.Append(MakeBlock(keys, 7));
+        parallel_hash_table.Append(MakeBlock(keys, 7));
+    }
+    serial_hash_table.Build();
+    ThreadPool thread_pool(3);
+    parallel_hash_table.Build(&thread_pool);
+
+    // Both tables have the same entries and chains.
+    ASSERT_EQ(parallel_hash_table.row_count(), serial_hash_table.row_count());
+    ASSERT_EQ(parallel_hash_table.entry_count(), serial_hash_table.entry_count());
+    for (u32 entry_id = 0; entry_id < serial_hash_table.entry_count(); ++entry_id) {
+        const JoinHashEntry &serial_entry = serial_hash_table.GetEntry(entry_id);
+        const JoinHashEntry &parallel_entry = parallel_hash_table.GetEntry(entry_id);
+        EXPECT_EQ(parallel_entry.hash_, serial_entry.hash_);
+        EXPECT_EQ(parallel_entry.block_id_, serial_entry.block_id_);
+        EXPECT_EQ(parallel_entry.block_offset_, serial_entry.block_offset_);
+        EXPECT_EQ(parallel_hash_table.NextEntry(entry_id), serial_hash_table.NextEntry(entry_id));
+    }
+
+    Vector<i64> probe_keys;
+    for (SizeT i = 0; i < block_rows; ++i) {
+        probe_keys.push_back(i * block_count);
+    }
+    UniquePtr<DataBlock> probe_block = MakeBlock(probe_keys, 0);
+    for (SizeT row_id = 0; row_id < probe_keys.size(); ++row_id) {
+        SizeT key_row = probe_keys[row_id] % block_rows;
+        EXPECT_EQ(CountMatches(parallel_hash_table, *probe_block, {0}, row_id), key_row % 7 == 0 ? 0u : 1u);
+    }
+}
@@ -301,3 +301,48 @@ TEST_P(AvgFunctionTest, avg_func) {
         EXPECT_THROW(aggregate_function_set->GetMostMatchFunction(col_expr_ptr), RecoverableException);
     }
 }
+
+TEST_P(AvgFunctionTest, avg_combine) {
+    using namespace infinity;
+
+    UniquePtr<Catalog> catalog_ptr = MakeUnique<Catalog>();
+
+    RegisterAvgFunction(catalog_ptr);
+
+    SharedPtr<FunctionSet> function_set = Catalog::GetFunctionSetByName(catalog_ptr.get(), "avg");
+    SharedPtr<AggregateFunctionSet> aggregate_function_set = std::static_pointer_cast<AggregateFunctionSet>(function_set);
+
+    SharedPtr<DataType> data_type = MakeShared<DataType>(LogicalType::kInteger);
+    SharedPtr<ColumnExpression> col_expr_ptr = MakeShared<ColumnExpression>(*data_type, "t1", 1, "c1", 0, 0);
+    AggregateFunction func = aggregate_function_set->GetMostMatchFunction(col_expr_ptr);
+
+    // Two partial states of different row counts, as produced by two tasks of the parallel aggregate.
+    Vector<SharedPtr<DataType>> column_types{data_type};
+    DataBlock first_block;
+    first_block.Init(column_types);
+    DataBlock second_block;
+    second_block.Init(column_types);
+    double sum = 0;
+    SizeT row_count = 1000;
+    for (SizeT i = 0; i < row_count; ++i) {
+        DataBlock &data_block = i < 100 ? first_block : second_block;
+        data_block.AppendValue(0, Value::MakeInt(static_cast<IntegerT>(i)));
+        sum += i;
+    }
+    first_block.Finalize();
+    second_block.Finalize();
+
+    auto first_state = func.InitState();
+    func.init_func_(first_state.get());
+    func.update_func_(first_state.get(), first_block.column_vectors[0]);
+    auto second_state = func.InitState();
+    func.init_func_(second_state.get());
+    func.update_func_(second_state.get(), second_block.column_vectors[0]);
+
+    auto merged_state = func.InitState();
+    func.init_func_(merged_state.get());
+    func.combine_func_(merged_state.get(), first_state.get());
+    func.combine_func_(merged_state.get(), second_state.get());
+    DoubleT result = *(DoubleT *)func.finalize_func_(merged_state.get());
+    EXPECT_FLOAT_EQ(result, sum / row_count);
+}
@@ -23,6 +23,7 @@ import status;
 import compilation_config;
 import virtual_store;
 import default_values;
+import options;
 
 using namespace infinity;
 class ConfigTest : public BaseTest {};
@@ -260,4 +261,47 @@ TEST_F(ConfigTest, TestValidValues) {
     EXPECT_EQ(config.ResourcePath(), "/var/infinity/resource");
     // persistence
     EXPECT_EQ(config.PersistenceDir(), "/var/infinity/persistence");
-}
\ No newline at end of file
+}
+
+// Each wal_flush value maps to its own flush option, the missing one to flush_at_once.
+TEST_F(ConfigTest, TestWalFlushOption) {
+    using namespace infinity;
+    const Vector<Pair<String, FlushOptionType>> config_flush_options{
+        {"/config/test_conf_valid_value.toml", FlushOptionType::kOnlyWrite},
+        {"/config/test_conf_wal_flush_at_once.toml", FlushOptionType::kFlushAtOnce},
+        {"/config/test_conf_wal_flush_per_second.toml", FlushOptionType::kFlushPerSecond},
+        {"/config/infinity_conf.toml", FlushOptionType::kFlushAtOnce},
+    };
+    for (const auto &[config_file, flush_option] : config_flush_options) {
+        SharedPtr<String> path = MakeShared<String>(String(test_data_path()) + config_file);
+        Config config;
+        auto status = config.Init(path, nullptr);
+        ASSERT_TRUE(status.ok()) << config_file;
+        EXPECT_EQ(config.FlushMethodAtCommit(), flush_option) << config_file;
+    }
+}
+
+TEST_F(ConfigTest, TestTaskSchedulerOptions) {
+    using namespace infinity;
+    SharedPtr<String> path = MakeShared<String>(String(test_data_path()) + "/config/test_conf_valid_value.toml");
+    Config config;
+    auto status = config.Init(path, nullptr);
+    ASSERT_TRUE(status.ok());
+    EXPECT_EQ(config.InteractiveTaskWeight(), DEFAULT_INTERACTIVE_TASK_WEIGHT);
+    EXPECT_EQ(config.BatchTaskWeight(), DEFAULT_BATCH_TASK_WEIGHT);
+    EXPECT_EQ(config.BackgroundTaskWeight(), DEFAULT_BACKGROUND_TASK_WEIGHT);
+    EXPECT_EQ(config.InteractiveTaskWorkerPercent(), DEFAULT_INTERACTIVE_TASK_WORKER_PERCENT);
+    EXPECT_EQ(config.BatchTaskWorkerPercent(), DEFAULT_BATCH_TASK_WORKER_PERCENT);
+    EXPECT_EQ(config.BackgroundTaskWorkerPercent(), DEFAULT_BACKGROUND_TASK_WORKER_PERCENT);
+
+    path = MakeShared<String>(String(test_data_path()) + "/config/test_conf_task_scheduler.toml");
+    Config config_task_scheduler;
+    status = config_task_scheduler.Init(path, nullptr);
+    ASSERT_TRUE(status.ok());
+    EXPECT_EQ(config_task_scheduler.InteractiveTaskWeight(), 8);
+    EXPECT_EQ(config_task_scheduler.BatchTaskWeight(), 2);
+    EXPECT_EQ(config_task_scheduler.BackgroundTaskWeight(), 2);
+    EXPECT_EQ(config_task_scheduler.InteractiveTaskWorkerPercent(), 90);
+    EXPECT_EQ(config_task_scheduler.BatchTaskWorkerPercent(), 50);
+    EXPECT_EQ(config_task_scheduler.BackgroundTaskWorkerPercent(), 25);
+}
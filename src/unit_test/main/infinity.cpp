@@ -32,6 +32,10 @@ import column_expr;
 import insert_row_expr;
 import column_def;
 import data_type;
+import infinity_context;
+import config;
+import task_scheduler;
+import task_priority;
 
 using namespace infinity;
 class InfinityTest : public BaseTest {};
@@ -362,6 +366,69 @@ TEST_F(InfinityTest, test2) {
         EXPECT_EQ(result.IsOk(), false);
     }
 
+    {
+        QueryResult result = infinity->ShowVariable("interactive_task_metrics", SetScope::kGlobal);
+        EXPECT_EQ(result.IsOk(), true);
+    }
+
+    {
+        // The workers each priority class could occupy come from the config.
+        Config *config = InfinityContext::instance().config();
+        TaskScheduler *task_scheduler = InfinityContext::instance().task_scheduler();
+        const u64 worker_count = std::min(u64(Thread::hardware_concurrency()), u64(config->CPULimit()));
+        const Array<Pair<TaskPriority, i64>, 3> worker_percents{{{TaskPriority::kInteractive, config->InteractiveTaskWorkerPercent()},
+                                                                 {TaskPriority::kBatch, config->BatchTaskWorkerPercent()},
+                                                                 {TaskPriority::kBackground, config->BackgroundTaskWorkerPercent()}}};
+        for (const auto &[priority, worker_percent] : worker_percents) {
+            EXPECT_EQ(task_scheduler->GetTaskQueueMetrics(priority).worker_limit_, std::max(u64(1), worker_count * worker_percent / 100));
+        }
+    }
+
+    {
+        // The queries of a session run in the class of its priority, which the task metrics in SHOW reflect.
+        QueryResult result = infinity->Query("CREATE TABLE t1 (c1 BIGINT);");
+        EXPECT_EQ(result.IsOk(), true);
+        result = infinity->Query("INSERT INTO t1 VALUES (1), (2), (3);");
+        EXPECT_EQ(result.IsOk(), true);
+
+        auto show_metrics = [&](const String &var_name) {
+            QueryResult show_result = infinity->ShowVariable(var_name, SetScope::kGlobal);
+            EXPECT_EQ(show_result.IsOk(), true);
+            return show_result.result_table_->GetDataBlockById(0)->GetValue(0, 0).GetVarchar();
+        };
+        auto executed_task_count = [](const String &metrics) -> u64 {
+            const String executed_prefix = "executed: ";
+            SizeT pos = metrics.find(executed_prefix);
+            EXPECT_NE(pos, String::npos);
+            return std::stoull(metrics.substr(pos + executed_prefix.size()));
+        };
+
+        // shown while the session still has the default priority, so the SHOW itself runs as interactive
+        String batch_metrics = show_metrics("batch_task_metrics");
+
+        result = infinity->SetVariableOrConfig("query_priority", String("batch"), SetScope::kSession);
+        EXPECT_EQ(result.IsOk(), true);
+        result = infinity->ShowVariable("query_priority", SetScope::kSession);
+        EXPECT_EQ(result.IsOk(), true);
+        EXPECT_EQ(result.result_table_->GetDataBlockById(0)->GetValue(0, 0).GetVarchar(), "batch");
+
+        TaskScheduler *task_scheduler = InfinityContext::instance().task_scheduler();
+        u64 interactive_executed_count = task_scheduler->GetTaskQueueMetrics(TaskPriority::kInteractive).executed_task_count_;
+        result = infinity->Query("SELECT c1 FROM t1;");
+        EXPECT_EQ(result.IsOk(), true);
+        // a SELECT is interactive by default, but runs as batch in this session
+        EXPECT_EQ(task_scheduler->GetTaskQueueMetrics(TaskPriority::kInteractive).executed_task_count_, interactive_executed_count);
+
+        result = infinity->SetVariableOrConfig("query_priority", String("interactive"), SetScope::kSession);
+        EXPECT_EQ(result.IsOk(), true);
+        String new_batch_metrics = show_metrics("batch_task_metrics");
+        EXPECT_NE(new_batch_metrics, batch_metrics);
+        EXPECT_GT(executed_task_count(new_batch_metrics), executed_task_count(batch_metrics));
+
+        result = infinity->SetVariableOrConfig("query_priority", String("urgent"), SetScope::kSession);
+        EXPECT_EQ(result.IsOk(), false);
+    }
+
     infinity->LocalDisconnect();
 
     Infinity::LocalUnInit();
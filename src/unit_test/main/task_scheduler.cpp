@@ -0,0 +1,104 @@
+// Copyright(C) 2024 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "gtest/gtest.h"
+import base_test;
+
+import stl;
+import infinity;
+import query_result;
+import data_block;
+import data_table;
+import value;
+import third_party;
+import infinity_context;
+import task_scheduler;
+import task_priority;
+import command_statement;
+
+using namespace infinity;
+class TaskSchedulerTest : public BaseTest {};
+
+// Concurrent sessions of all priority classes run multi-task queries. A lost task would hang its query, a task run
+// twice or stolen while running would change the count, and the queues must be empty at the end.
+TEST_F(TaskSchedulerTest, concurrent_queries) {
+    constexpr SizeT row_n = 60000;
+    constexpr SizeT insert_row_n = 1000;
+    constexpr SizeT client_n = 6;
+    constexpr SizeT query_n = 30;
+    String path = GetHomeDir();
+    RemoveDbDirs();
+    Infinity::LocalInit(path);
+
+    {
+        SharedPtr<Infinity> infinity = Infinity::LocalConnect();
+        QueryResult result = infinity->Query("CREATE TABLE t1 (c1 BIGINT);");
+        EXPECT_TRUE(result.IsOk());
+        // several blocks, so that each scan has several tasks
+        for (SizeT row_begin = 0; row_begin < row_n; row_begin += insert_row_n) {
+            String insert_sql = "INSERT INTO t1 VALUES ";
+            for (SizeT row = row_begin; row < row_begin + insert_row_n; ++row) {
+                insert_sql += fmt::format("{}({})", row == row_begin ? "" : ", ", row);
+            }
+            result = infinity->Query(insert_sql + ";");
+            EXPECT_TRUE(result.IsOk());
+        }
+        infinity->LocalDisconnect();
+    }
+
+    TaskScheduler *task_scheduler = InfinityContext::instance().task_scheduler();
+    const Array<TaskPriority, 3> priorities{TaskPriority::kInteractive, TaskPriority::kBatch, TaskPriority::kBackground};
+    Array<u64, 3> executed_task_counts{};
+    for (SizeT i = 0; i < priorities.size(); ++i) {
+        executed_task_counts[i] = task_scheduler->GetTaskQueueMetrics(priorities[i]).executed_task_count_;
+    }
+
+    Atomic<SizeT> wrong_result_n{0};
+    Vector<Thread> clients;
+    for (SizeT client_id = 0; client_id < client_n; ++client_id) {
+        clients.emplace_back([&, client_id] {
+            SharedPtr<Infinity> infinity = Infinity::LocalConnect();
+            String priority = TaskPriority2String(priorities[client_id % priorities.size()]);
+            if (!infinity->SetVariableOrConfig("query_priority", priority, SetScope::kSession).IsOk()) {
+                ++wrong_result_n;
+            }
+            for (SizeT i = 0; i < query_n; ++i) {
+                SizeT bound = (client_id * query_n + i) * 97 % row_n;
+                QueryResult result = infinity->Query(fmt::format("SELECT COUNT(*) FROM t1 WHERE c1 >= {};", bound));
+                if (!result.IsOk()) {
+                    ++wrong_result_n;
+                    continue;
+                }
+                Value value = result.result_table_->GetDataBlockById(0)->GetValue(0, 0);
+                if (value.value_.big_int != i64(row_n - bound)) {
+                    ++wrong_result_n;
+                }
+            }
+            infinity->LocalDisconnect();
+        });
+    }
+    for (auto &client : clients) {
+        client.join();
+    }
+    EXPECT_EQ(wrong_result_n.load(), 0u);
+
+    for (SizeT i = 0; i < priorities.size(); ++i) {
+        TaskQueueMetrics metrics = task_scheduler->GetTaskQueueMetrics(priorities[i]);
+        EXPECT_EQ(metrics.pending_task_count_, 0u);
+        EXPECT_EQ(metrics.running_task_count_, 0u);
+        EXPECT_GE(metrics.executed_task_count_, executed_task_counts[i] + client_n / priorities.size() * query_n);
+    }
+
+    Infinity::LocalUnInit();
+}
@@ -309,3 +309,47 @@ _exists_:"author" AND page_count:xxx AND name:star^1.3
         // std::cerr << fmt::format("RecoverableException: {}\n", e.what());
     }
 }
+
+TEST_F(SearchDriverTest, multi_term_test) {
+    using namespace infinity;
+    Map<String, String> column2analyzer;
+    String default_field("body");
+    SearchDriver driver(column2analyzer, default_field);
+
+    auto prefix_query = driver.ParseSingle("Quic*");
+    ASSERT_TRUE(prefix_query);
+    ASSERT_EQ(prefix_query->GetType(), QueryNodeType::PREFIX_TERM);
+    EXPECT_EQ(static_cast<PrefixTermQueryNode *>(prefix_query.get())->prefix_, "quic");
+    EXPECT_EQ(static_cast<PrefixTermQueryNode *>(prefix_query.get())->column_, "body");
+
+    auto wildcard_query = driver.ParseSingle(R"(name:qu?c*k\*)");
+    ASSERT_TRUE(wildcard_query);
+    ASSERT_EQ(wildcard_query->GetType(), QueryNodeType::WILDCARD_TERM);
+    EXPECT_EQ(static_cast<WildcardTermQueryNode *>(wildcard_query.get())->pattern_, R"(qu?c*k\*)");
+    EXPECT_EQ(static_cast<WildcardTermQueryNode *>(wildcard_query.get())->column_, "name");
+
+    // escaped or quoted wildcards are analyzed as text
+    for (const char *query : {R"(book\*)", R"("book*")"}) {
+        auto term_query = driver.ParseSingle(query);
+        ASSERT_TRUE(term_query);
+        EXPECT_EQ(term_query->GetType(), QueryNodeType::TERM);
+    }
+
+    auto fuzzy_query = driver.ParseSingle("quikc~1");
+    ASSERT_TRUE(fuzzy_query);
+    ASSERT_EQ(fuzzy_query->GetType(), QueryNodeType::FUZZY_TERM);
+    EXPECT_EQ(static_cast<FuzzyTermQueryNode *>(fuzzy_query.get())->max_edits_, 1u);
+    auto capped_fuzzy_query = driver.ParseSingle("quikc~5");
+    ASSERT_TRUE(capped_fuzzy_query);
+    ASSERT_EQ(capped_fuzzy_query->GetType(), QueryNodeType::FUZZY_TERM);
+    EXPECT_EQ(static_cast<FuzzyTermQueryNode *>(capped_fuzzy_query.get())->max_edits_, 2u);
+
+    // quoted text with slop is still a sloppy phrase
+    auto phrase_query = driver.ParseSingle(R"("quick fox"~2)");
+    ASSERT_TRUE(phrase_query);
+    EXPECT_EQ(phrase_query->GetType(), QueryNodeType::PHRASE);
+
+    auto or_query = driver.ParseSingle("foo* bar");
+    ASSERT_TRUE(or_query);
+    EXPECT_EQ(or_query->GetType(), QueryNodeType::OR);
+}
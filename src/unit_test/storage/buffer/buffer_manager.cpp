@@ -543,3 +543,93 @@ TEST_F(BufferManagerParallelTest, parallel_test2) {
         ResetDir();
     }
 }
+
+TEST_F(BufferManagerTest, concurrent_pin_test) {
+    const SizeT file_size = 64;
+    const SizeT file_num = 16;
+    const SizeT thread_num = 8;
+    const SizeT loop_num = 20000;
+    // Room for half of the objects, so that the pins race with evictions.
+    BufferManager buffer_mgr(file_size * file_num / 2, data_dir_, temp_dir_, nullptr);
+    Vector<BufferObj *> buffer_objs;
+    for (SizeT i = 0; i < file_num; ++i) {
+        auto file_name = MakeShared<String>(fmt::format("file_{}", i));
+        auto file_worker = MakeUnique<DataFileWorker>(data_dir_, temp_dir_, MakeShared<String>(""), file_name, file_size, buffer_mgr.persistence_manager());
+        auto *buffer_obj = buffer_mgr.AllocateBufferObject(std::move(file_worker));
+        {
+            auto buffer_handle = buffer_obj->Load();
+            auto *data = reinterpret_cast<char *>(buffer_handle.GetDataMut());
+            std::fill(data, data + file_size, 'a' + i);
+        }
+        buffer_obj->Save();
+        buffer_objs.push_back(buffer_obj);
+    }
+
+    Vector<std::future<bool>> futures;
+    for (SizeT thread_id = 0; thread_id < thread_num; ++thread_id) {
+        futures.push_back(std::async(std::launch::async, [&, thread_id] {
+            for (SizeT j = 0; j < loop_num; ++j) {
+                SizeT i = (thread_id + j * 7) % file_num;
+                auto buffer_handle = buffer_objs[i]->Load();
+                auto copied_handle = buffer_handle;
+                const auto *data = static_cast<const char *>(copied_handle.GetData());
+                if (data[0] != char('a' + i) || data[file_size - 1] != char('a' + i)) {
+                    return false;
+                }
+            }
+            return true;
+        }));
+    }
+    for (auto &f : futures) {
+        EXPECT_TRUE(f.get());
+    }
+    for (auto *buffer_obj : buffer_objs) {
+        EXPECT_EQ(buffer_obj->rc(), 0u);
+        buffer_obj->CheckState();
+    }
+    EXPECT_LE(buffer_mgr.memory_usage(), file_size * file_num / 2);
+    EXPECT_EQ(buffer_mgr.BufferedObjectCount(), file_num);
+}
+
+TEST_F(BufferManagerTest, clock_hit_test) {
+    const SizeT file_size = 64;
+    // One clock with room for three objects.
+    BufferManager buffer_mgr(file_size * 3, data_dir_, temp_dir_, nullptr, 1);
+    Vector<BufferObj *> buffer_objs;
+    auto load_and_unload = [&](SizeT i) {
+        if (i == buffer_objs.size()) {
+            auto file_name = MakeShared<String>(fmt::format("file_{}", i));
+            auto file_worker =
+                MakeUnique<DataFileWorker>(data_dir_, temp_dir_, MakeShared<String>(""), file_name, file_size, buffer_mgr.persistence_manager());
+            buffer_objs.push_back(buffer_mgr.AllocateBufferObject(std::move(file_worker)));
+        }
+        auto buffer_handle = buffer_objs[i]->Load();
+        auto *data = reinterpret_cast<char *>(buffer_handle.GetDataMut());
+        std::fill(data, data + file_size, 'a' + i);
+    };
+
+    for (SizeT i = 0; i < 3; ++i) {
+        load_and_unload(i);
+    }
+    // The sweep clears the reference bits of 0, 1, 2 and evicts 0.
+    load_and_unload(3);
+    EXPECT_EQ(buffer_objs[0]->status(), BufferStatus::kFreed);
+
+    // The hit sets the reference bit of 1 in its slot, so the next sweep passes 1 and evicts the cold 2.
+    load_and_unload(1);
+    load_and_unload(4);
+    EXPECT_EQ(buffer_objs[1]->status(), BufferStatus::kUnloaded);
+    EXPECT_EQ(buffer_objs[2]->status(), BufferStatus::kFreed);
+
+    {
+        // A loaded object keeps its slot and is skipped by the sweep.
+        auto buffer_handle = buffer_objs[1]->Load();
+        EXPECT_EQ(buffer_mgr.WaitingGCObjectCount()[0], 2u);
+        load_and_unload(5);
+        EXPECT_EQ(buffer_objs[1]->status(), BufferStatus::kLoaded);
+        EXPECT_EQ(buffer_objs[3]->status(), BufferStatus::kFreed);
+    }
+    EXPECT_EQ(buffer_objs[1]->status(), BufferStatus::kUnloaded);
+    EXPECT_EQ(buffer_mgr.WaitingGCObjectCount()[0], 3u);
+    EXPECT_LE(buffer_mgr.memory_usage(), file_size * 3);
+}
@@ -0,0 +1,51 @@
+#include "gtest/gtest.h"
+import base_test;
+
+import stl;
+
+import posting_field;
+import index_defines;
+import byte_slice_writer;
+import byte_slice_reader;
+import simd_common_tools;
+
+using namespace infinity;
+
+class PostingCodecTest : public BaseTest {};
+
+// blocks of each codec decode back to the encoded d-gaps
+TEST_F(PostingCodecTest, test_encode_decode) {
+    std::mt19937 rng(0);
+    std::geometric_distribution<u32> gap_dist(0.05);
+    for (const auto codec : {PostingCodec::kSIMDBitPacking, PostingCodec::kSIMDNewPFor, PostingCodec::kStreamVByte}) {
+        const Int32Encoder *encoder = GetDocIDEncoder(codec);
+        ByteSliceWriter writer;
+        Vector<Vector<u32>> blocks;
+        // full blocks and the partial last one
+        for (const u32 block_len : {MAX_DOC_PER_RECORD, MAX_DOC_PER_RECORD, 37u}) {
+            Vector<u32> block(block_len);
+            std::generate(block.begin(), block.end(), [&] { return gap_dist(rng) + 1; });
+            encoder->Encode(writer, block.data(), block_len);
+            blocks.push_back(std::move(block));
+        }
+        ByteSliceReader reader(writer.GetByteSliceList());
+        for (const auto &block : blocks) {
+            u32 buffer[MAX_DOC_PER_RECORD];
+            ASSERT_EQ(encoder->Decode(buffer, MAX_DOC_PER_RECORD, reader), block.size());
+            for (SizeT i = 0; i < block.size(); ++i) {
+                EXPECT_EQ(buffer[i], block[i]);
+            }
+        }
+    }
+}
+
+TEST_F(PostingCodecTest, test_prefix_sum) {
+    for (const SizeT n : {0, 3, 4, 37, 128}) {
+        Vector<u32> data(n);
+        std::iota(data.begin(), data.end(), 1u);
+        Vector<u32> expected(n);
+        std::partial_sum(data.begin(), data.end(), expected.begin());
+        PrefixSumU32(data.data(), n);
+        EXPECT_EQ(data, expected);
+    }
+}
@@ -155,3 +155,45 @@ TEST_F(FstTest, Iterate) {
     }
     EXPECT_EQ(i, b2_num);
 }
+
+// the keys streamed by the automata are the keys they match, in order
+TEST_F(FstTest, SearchAutomaton) {
+    Vector<String> keys = {"apple", "applet", "apply", "banana", "band", "bandana", "can", "cane", "中国", "中文", "文字"};
+    std::sort(keys.begin(), keys.end());
+    Vector<u8> buffer;
+    BufferWriter wtr(buffer);
+    FstBuilder builder(wtr);
+    for (SizeT i = 0; i < keys.size(); ++i) {
+        builder.Insert((u8 *)keys[i].c_str(), keys[i].length(), i);
+    }
+    builder.Finish();
+    Fst f(buffer.data(), buffer.size());
+
+    auto search = [&](FstAutomaton &aut) {
+        FstAutomatonStream s(f, aut);
+        Vector<String> result;
+        Vector<u8> key;
+        u64 val;
+        while (s.Next(key, val)) {
+            result.emplace_back((char *)key.data(), key.size());
+            EXPECT_EQ(keys[val], result.back());
+        }
+        return result;
+    };
+    PrefixAutomaton prefix("appl");
+    EXPECT_EQ(search(prefix), (Vector<String>{"apple", "applet", "apply"}));
+    PrefixAutomaton empty_prefix("");
+    EXPECT_EQ(search(empty_prefix), keys);
+    WildcardAutomaton wildcard1("ban*a");
+    EXPECT_EQ(search(wildcard1), (Vector<String>{"banana", "bandana"}));
+    WildcardAutomaton wildcard2("?an*");
+    EXPECT_EQ(search(wildcard2), (Vector<String>{"banana", "band", "bandana", "can", "cane"}));
+    WildcardAutomaton wildcard3("中?");
+    EXPECT_EQ(search(wildcard3), (Vector<String>{"中国", "中文"}));
+    LevenshteinAutomaton fuzzy1("aple", 1);
+    EXPECT_EQ(search(fuzzy1), (Vector<String>{"apple"}));
+    LevenshteinAutomaton fuzzy2("band", 2);
+    EXPECT_EQ(search(fuzzy2), (Vector<String>{"band", "can", "cane"}));
+    LevenshteinAutomaton fuzzy3("中字", 1);
+    EXPECT_EQ(search(fuzzy3), (Vector<String>{"中国", "中文", "文字"}));
+}
@@ -291,3 +291,45 @@ TEST_P(MemoryIndexerTest, SeekPosition) {
         ASSERT_EQ(act_pos, INVALID_POSITION);
     }
 }
+
+// posting generated by term ranges in parallel, and merged from the spilled term ranges in parallel
+TEST_P(MemoryIndexerTest, ParallelBuild) {
+    constexpr SizeT doc_num = 2000;
+    auto column = ColumnVector::Make(MakeShared<DataType>(LogicalType::kVarchar));
+    column->Initialize();
+    for (SizeT i = 0; i < doc_num; ++i) {
+        column->AppendValue(column_->GetValue(i % 5));
+    }
+
+    for (const bool offline : {false, true}) {
+        auto fake_segment_index_entry_1 = SegmentIndexEntry::CreateFakeEntry(GetFullDataDir());
+        MemoryIndexer indexer1(GetFullDataDir(), "chunk1", RowID(0U, 0U), flag_, "standard", fake_segment_index_entry_1.get());
+        if (offline) {
+            for (SizeT i = 0; i < doc_num; i += 200) {
+                indexer1.Insert(column, i, 200, true);
+            }
+        } else {
+            indexer1.Insert(column, 0, doc_num);
+        }
+        indexer1.Dump(offline);
+        fake_segment_index_entry_1->AddFtChunkIndexEntry("chunk1", RowID(0U, 0U).ToUint64(), doc_num);
+
+        Map<SegmentID, SharedPtr<SegmentIndexEntry>> index_by_segment = {{1, fake_segment_index_entry_1}};
+        ColumnIndexReader reader;
+        reader.Open(flag_, GetFullDataDir(), std::move(index_by_segment), nullptr);
+        for (const ExpectedPosting &expected : expected_postings_) {
+            UniquePtr<PostingIterator> post_iter(reader.Lookup(expected.term));
+            ASSERT_TRUE(post_iter != nullptr);
+            RowID doc_id = post_iter->SeekDoc(RowID(0U, 0U));
+            SizeT df = 0;
+            while (doc_id != INVALID_ROWID) {
+                const SizeT j = std::find(expected.doc_ids.begin(), expected.doc_ids.end(), RowID(0U, doc_id.segment_offset_ % 5)) - expected.doc_ids.begin();
+                ASSERT_LT(j, expected.doc_ids.size());
+                ASSERT_EQ(post_iter->GetCurrentTF(), expected.tfs[j]);
+                ++df;
+                doc_id = post_iter->SeekDoc(doc_id + 1);
+            }
+            ASSERT_EQ(df, doc_num / 5 * expected.doc_ids.size());
+        }
+    }
+}
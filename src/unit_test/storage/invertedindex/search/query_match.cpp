@@ -155,6 +155,68 @@ TEST_P(QueryMatchTest, phrase) {
     }
 }
 
+// The readers over the parts of the segments see only their own docs, with the scores of the whole column.
+TEST_P(QueryMatchTest, split_by_segment) {
+    CreateDBAndTable(db_name_, table_name_);
+    CreateIndex(db_name_, table_name_, index_name_, "standard");
+    InsertData(db_name_, table_name_);
+    InsertData(db_name_, table_name_);
+
+    TxnManager *txn_mgr = InfinityContext::instance().storage()->txn_manager();
+    auto *txn = txn_mgr->BeginTxn(MakeUnique<String>("query match"), TransactionType::kRead);
+    auto [table_entry, status_table] = txn->GetTableByName(db_name_, table_name_);
+    EXPECT_TRUE(status_table.ok());
+    auto fake_table_ref = BaseTableRef::FakeTableRef(txn, db_name_, table_name_);
+    SharedPtr<IndexReader> index_reader = table_entry->GetFullTextIndexReader(txn);
+
+    Map<SegmentID, u32> segment_part;
+    for (const auto &[segment_id, _] : fake_table_ref->block_index_->segment_block_index_) {
+        segment_part.emplace(segment_id, segment_part.size());
+    }
+    ASSERT_EQ(segment_part.size(), 2u);
+    auto part_readers = index_reader->SplitBySegment(segment_part, 2);
+
+    Vector<String> index_hints;
+    auto search = [&](const SharedPtr<IndexReader> &reader, FullTextQueryContext &context) {
+        QueryBuilder query_builder(fake_table_ref->table_info_);
+        query_builder.Init(reader);
+        SearchDriver driver(query_builder.GetColumn2Analyzer(index_hints), "text");
+        context.early_term_algo_ = EarlyTermAlgo::kNaive;
+        context.query_tree_ = driver.ParseSingleWithFields("text", "anarchism");
+        return query_builder.CreateSearch(context);
+    };
+    auto make_context = [&] {
+        return MakeUnique<FullTextQueryContext>(FulltextSimilarity::kBM25, BM25Params{}, MinimumShouldMatchOption{}, RankFeaturesOption{}, 10, index_hints);
+    };
+
+    Map<u64, float> whole_scores;
+    auto whole_context = make_context();
+    auto whole_iter = search(index_reader, *whole_context);
+    ASSERT_NE(whole_iter, nullptr);
+    EXPECT_EQ(dynamic_cast<TermDocIterator *>(whole_iter.get())->GetDocFreq(), 4u);
+    while (whole_iter->Next()) {
+        whole_scores[whole_iter->DocID().ToUint64()] = whole_iter->Score();
+    }
+    EXPECT_EQ(whole_scores.size(), 4u);
+
+    SizeT part_doc_n = 0;
+    for (u32 i = 0; i < part_readers.size(); ++i) {
+        auto part_context = make_context();
+        auto part_iter = search(part_readers[i], *part_context);
+        ASSERT_NE(part_iter, nullptr);
+        EXPECT_EQ(dynamic_cast<TermDocIterator *>(part_iter.get())->GetDocFreq(), 4u);
+        while (part_iter->Next()) {
+            const RowID doc_id = part_iter->DocID();
+            EXPECT_EQ(segment_part[doc_id.segment_id_], i);
+            ASSERT_TRUE(whole_scores.contains(doc_id.ToUint64()));
+            EXPECT_FLOAT_EQ(part_iter->Score(), whole_scores[doc_id.ToUint64()]);
+            ++part_doc_n;
+        }
+    }
+    EXPECT_EQ(part_doc_n, whole_scores.size());
+    txn_mgr->CommitTxn(txn);
+}
+
 void QueryMatchTest::CreateDBAndTable(const String &db_name, const String &table_name) {
     Vector<SharedPtr<ColumnDef>> column_defs;
     {
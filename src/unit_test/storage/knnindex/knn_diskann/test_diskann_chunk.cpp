@@ -0,0 +1,106 @@
+// Copyright(C) 2024 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+import stl;
+import base_test;
+import infinity_exception;
+import internal_types;
+import virtual_store;
+import local_file_handle;
+import index_base;
+import index_diskann;
+import diskann_index_in_chunk;
+
+using namespace infinity;
+
+class DiskAnnChunkTest : public BaseTest {
+public:
+    const String tmp_dir_ = GetFullTmpDir();
+    const u32 dim_ = 32;
+    const u32 row_count_ = 2000;
+    const u32 start_segment_offset_ = 100;
+    IndexDiskAnn index_diskann_{MakeShared<String>("idx"), nullptr, "idx", {"col"}, MetricType::kMetricL2, DiskAnnEncodeType::kPlain, 32, 64, 4, 1};
+
+    UniquePtr<f32[]> MakeData() const {
+        auto data = MakeUniqueForOverwrite<f32[]>(dim_ * row_count_);
+        std::mt19937 rng(0);
+        std::uniform_real_distribution<f32> dist;
+        std::generate_n(data.get(), dim_ * row_count_, [&] { return dist(rng); });
+        return data;
+    }
+
+    // Every vector searches itself out first.
+    void CheckSelfSearch(const DiskAnnIndexInChunk &index, const f32 *data, const DiskAnnSearchOption &option) const {
+        auto all_pass = [](SegmentOffset) { return true; };
+        for (u32 i = 0; i < row_count_; i += 97) {
+            auto [result_n, d_ptr, offset_ptr] = index.Search(data + i * dim_, 10, option, all_pass);
+            ASSERT_EQ(result_n, 10u);
+            EXPECT_EQ(offset_ptr[0], start_segment_offset_ + i);
+            for (u32 j = 1; j < result_n; ++j) {
+                EXPECT_LE(d_ptr[j - 1], d_ptr[j]);
+            }
+        }
+    }
+};
+
+TEST_F(DiskAnnChunkTest, build_save_and_load) {
+    auto data = MakeData();
+    const String file_path = tmp_dir_ + "/diskann_chunk.idx";
+    // the chunk is written after some other data, as in an object of the persistence manager
+    const u64 base_offset = 1000;
+    {
+        DiskAnnIndexInChunk index(&index_diskann_, dim_, start_segment_offset_, tmp_dir_ + "/build0");
+        index.BuildDiskAnnIndex(data.get(), row_count_);
+        EXPECT_EQ(index.row_count(), row_count_);
+        EXPECT_GT(index.MemoryUsage(), 0u);
+        CheckSelfSearch(index, data.get(), DiskAnnSearchOption{});
+
+        auto [file_handle, status] = VirtualStore::Open(file_path, FileAccessMode::kWrite);
+        ASSERT_TRUE(status.ok());
+        String prefix(base_offset, 'x');
+        file_handle->Append(prefix.data(), prefix.size());
+        index.SaveIndexInner(*file_handle);
+    }
+    for (bool copy_graph : {false, true}) {
+        auto [file_handle, status] = VirtualStore::Open(file_path, FileAccessMode::kRead);
+        ASSERT_TRUE(status.ok());
+        DiskAnnIndexInChunk index(&index_diskann_, dim_, start_segment_offset_, tmp_dir_ + "/build1");
+        index.ReadIndexInner(*file_handle, base_offset, copy_graph);
+        EXPECT_EQ(index.row_count(), row_count_);
+        CheckSelfSearch(index, data.get(), DiskAnnSearchOption{.beam_width_ = 2, .l_search_ = 50, .rerank_ = true});
+    }
+    VirtualStore::DeleteFile(file_path);
+}
+
+TEST_F(DiskAnnChunkTest, search_with_filter) {
+    auto data = MakeData();
+    DiskAnnIndexInChunk index(&index_diskann_, dim_, start_segment_offset_, tmp_dir_ + "/build2");
+    index.BuildDiskAnnIndex(data.get(), row_count_);
+
+    auto even_only = [](SegmentOffset segment_offset) { return segment_offset % 2 == 0; };
+    for (bool rerank : {true, false}) {
+        DiskAnnSearchOption option{.rerank_ = rerank};
+        for (u32 i = 1; i < row_count_; i += 101) {
+            auto [result_n, d_ptr, offset_ptr] = index.Search(data.get() + i * dim_, 10, option, even_only);
+            EXPECT_GT(result_n, 0u);
+            EXPECT_LE(result_n, 10u);
+            for (u32 j = 0; j < result_n; ++j) {
+                EXPECT_EQ(offset_ptr[j] % 2, 0u);
+                EXPECT_NE(offset_ptr[j], start_segment_offset_ + i);
+            }
+        }
+    }
+}
@@ -0,0 +1,115 @@
+// Copyright(C) 2024 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "gtest/gtest.h"
+import base_test;
+
+import stl;
+import hnsw_alg;
+import hnsw_common;
+import vec_store_type;
+import visited_list;
+
+using namespace infinity;
+
+class HnswBatchTest : public BaseTest {
+public:
+    using LabelT = u64;
+
+    // The batch search returns the same results as searching the queries one by one.
+    template <typename Hnsw>
+    void TestBatchSearch() {
+        const SizeT dim = 16;
+        const SizeT element_size = 1000;
+        const SizeT query_n = 37; // not a multiple of the group size
+
+        std::mt19937 rng(0);
+        std::uniform_real_distribution<float> distrib_real;
+        auto data = MakeUnique<float[]>(dim * element_size);
+        std::generate_n(data.get(), dim * element_size, [&] { return distrib_real(rng); });
+        auto query_data = MakeUnique<float[]>(dim * query_n);
+        std::generate_n(query_data.get(), dim * query_n, [&] { return distrib_real(rng); });
+        Vector<const float *> queries(query_n);
+        for (SizeT i = 0; i < query_n; ++i) {
+            queries[i] = query_data.get() + i * dim;
+        }
+
+        auto hnsw_index = Hnsw::Make(128, 10, dim, 8, 100);
+        hnsw_index->InsertVecs(DenseVectorIter<float, LabelT>(data.get(), dim, element_size));
+
+        auto sorted = [](SizeT result_n, const float *d_ptr, const LabelT *l_ptr) {
+            Vector<Pair<float, LabelT>> result(result_n);
+            for (SizeT i = 0; i < result_n; ++i) {
+                result[i] = {d_ptr[i], l_ptr[i]};
+            }
+            std::sort(result.begin(), result.end());
+            return result;
+        };
+        for (SizeT ef : {10, 50}) {
+            KnnSearchOption search_option{.ef_ = ef};
+            auto batch_results = hnsw_index->KnnSearchBatch(queries.data(), query_n, 10, search_option);
+            ASSERT_EQ(batch_results.size(), query_n);
+            for (SizeT i = 0; i < query_n; ++i) {
+                auto [result_n, d_ptr, l_ptr] = hnsw_index->KnnSearch(queries[i], 10, search_option);
+                const auto &[batch_result_n, batch_d_ptr, batch_l_ptr] = batch_results[i];
+                ASSERT_EQ(batch_result_n, result_n);
+                EXPECT_EQ(sorted(batch_result_n, batch_d_ptr.get(), batch_l_ptr.get()), sorted(result_n, d_ptr.get(), l_ptr.get()));
+            }
+        }
+    }
+};
+
+TEST_F(HnswBatchTest, test_plain) {
+    using Hnsw = KnnHnsw<PlainL2VecStoreType<float>, LabelT>;
+    TestBatchSearch<Hnsw>();
+}
+
+TEST_F(HnswBatchTest, test_lvq) {
+    using Hnsw = KnnHnsw<LVQL2VecStoreType<float, int8_t>, LabelT>;
+    TestBatchSearch<Hnsw>();
+}
+
+TEST_F(HnswBatchTest, test_empty) {
+    using Hnsw = KnnHnsw<PlainL2VecStoreType<float>, LabelT>;
+    auto hnsw_index = Hnsw::Make(128, 10, 16, 8, 100);
+    Vector<float> query(16, 0.5);
+    const float *queries[] = {query.data(), query.data()};
+    auto batch_results = hnsw_index->KnnSearchBatch(queries, 2, 10);
+    ASSERT_EQ(batch_results.size(), 2u);
+    for (const auto &[result_n, d_ptr, l_ptr] : batch_results) {
+        EXPECT_EQ(result_n, 0u);
+    }
+}
+
+TEST_F(HnswBatchTest, test_visited_list) {
+    VisitedList visited_list;
+    // walk more times than the tags, the stale marks are cleared on the wrap
+    for (SizeT walk_i = 0; walk_i < 600; ++walk_i) {
+        visited_list.Reset(100);
+        EXPECT_TRUE(visited_list.Visit(walk_i % 100));
+        EXPECT_FALSE(visited_list.Visit(walk_i % 100));
+        EXPECT_TRUE(visited_list.Visit((walk_i + 1) % 100));
+    }
+    visited_list.Reset(1000);
+    EXPECT_GE(visited_list.capacity(), 1000u);
+    EXPECT_TRUE(visited_list.Visit(999));
+
+    auto &pool = VisitedListPool::instance();
+    auto list = pool.Acquire(10);
+    EXPECT_TRUE(list->Visit(5));
+    pool.Release(std::move(list));
+    list = pool.Acquire(10);
+    EXPECT_TRUE(list->Visit(5));
+    pool.Release(std::move(list));
+}
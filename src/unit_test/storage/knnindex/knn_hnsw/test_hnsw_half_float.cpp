@@ -0,0 +1,105 @@
+// Copyright(C) 2024 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "gtest/gtest.h"
+import base_test;
+
+import stl;
+import internal_types;
+import simd_functions;
+import half_float_simd_funcs;
+import hnsw_alg;
+import hnsw_common;
+import vec_store_type;
+
+using namespace infinity;
+
+class HnswHalfFloatTest : public BaseTest {
+public:
+    using LabelT = u64;
+
+    template <typename T>
+    static Vector<T> RandomVec(SizeT n, std::mt19937 &rng) {
+        std::uniform_real_distribution<float> distrib(-1.0, 1.0);
+        Vector<T> vec(n);
+        for (auto &v : vec) {
+            v = T(distrib(rng));
+        }
+        return vec;
+    }
+
+    // the dispatched kernels agree with the scalar ones, dimensions with a tail included
+    template <typename T, typename Func, typename BFFunc>
+    static void CheckKernel(Func func, BFFunc bf_func) {
+        std::mt19937 rng(0);
+        for (SizeT dim : {1, 7, 16, 33, 128, 1000}) {
+            auto v1 = RandomVec<T>(dim, rng);
+            auto v2 = RandomVec<T>(dim, rng);
+            f32 expect = bf_func(v1.data(), v2.data(), dim);
+            EXPECT_NEAR(func(v1.data(), v2.data(), dim), expect, 1e-3 * std::max(1.0f, std::abs(expect)));
+        }
+    }
+
+    template <typename Hnsw, typename T>
+    static void CheckSelfSearch() {
+        const SizeT dim = 32;
+        const SizeT element_size = 1000;
+        std::mt19937 rng(0);
+        auto data = RandomVec<T>(dim * element_size, rng);
+
+        auto hnsw_index = Hnsw::Make(128, 10, dim, 16, 200);
+        hnsw_index->InsertVecs(DenseVectorIter<T, LabelT>(data.data(), dim, element_size));
+
+        KnnSearchOption search_option{.ef_ = 50};
+        SizeT correct = 0;
+        for (SizeT i = 0; i < element_size; ++i) {
+            auto result = hnsw_index->KnnSearchSorted(data.data() + i * dim, 1, search_option);
+            correct += result[0].second == i;
+        }
+        EXPECT_GE(f32(correct) / element_size, 0.95);
+    }
+};
+
+TEST_F(HnswHalfFloatTest, test_kernels) {
+    const auto &simd_functions = GetSIMD_FUNCTIONS();
+    CheckKernel<Float16T>(simd_functions.HNSW_F16L2_ptr_, F16L2BF);
+    CheckKernel<Float16T>(simd_functions.HNSW_F16IP_ptr_, F16IPBF);
+    CheckKernel<Float16T>(simd_functions.HNSW_F16Cos_ptr_, F16CosBF);
+    CheckKernel<BFloat16T>(simd_functions.HNSW_BF16L2_ptr_, BF16L2BF);
+    CheckKernel<BFloat16T>(simd_functions.HNSW_BF16IP_ptr_, BF16IPBF);
+    CheckKernel<BFloat16T>(simd_functions.HNSW_BF16Cos_ptr_, BF16CosBF);
+}
+
+TEST_F(HnswHalfFloatTest, test_to_f32) {
+    std::mt19937 rng(0);
+    const SizeT n = 1000;
+    auto f16_vec = RandomVec<Float16T>(n, rng);
+    auto bf16_vec = RandomVec<BFloat16T>(n, rng);
+    Vector<f32> out(n);
+    GetSIMD_FUNCTIONS().F16ToF32_func_ptr_(f16_vec.data(), out.data(), n);
+    for (SizeT i = 0; i < n; ++i) {
+        EXPECT_EQ(out[i], f32(f16_vec[i]));
+    }
+    GetSIMD_FUNCTIONS().BF16ToF32_func_ptr_(bf16_vec.data(), out.data(), n);
+    for (SizeT i = 0; i < n; ++i) {
+        EXPECT_EQ(out[i], f32(bf16_vec[i]));
+    }
+}
+
+TEST_F(HnswHalfFloatTest, test_hnsw) {
+    CheckSelfSearch<KnnHnsw<PlainL2VecStoreType<Float16T>, LabelT>, Float16T>();
+    CheckSelfSearch<KnnHnsw<PlainCosVecStoreType<Float16T>, LabelT>, Float16T>();
+    CheckSelfSearch<KnnHnsw<PlainL2VecStoreType<BFloat16T>, LabelT>, BFloat16T>();
+    CheckSelfSearch<KnnHnsw<PlainCosVecStoreType<BFloat16T>, LabelT>, BFloat16T>();
+}
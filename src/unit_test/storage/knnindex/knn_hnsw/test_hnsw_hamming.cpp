@@ -0,0 +1,73 @@
+// Copyright(C) 2024 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "gtest/gtest.h"
+import base_test;
+
+import stl;
+import internal_types;
+import simd_functions;
+import distance_simd_functions;
+import hnsw_alg;
+import hnsw_common;
+import vec_store_type;
+
+using namespace infinity;
+
+class HnswHammingTest : public BaseTest {
+public:
+    using LabelT = u64;
+
+    static Vector<u8> RandomBytes(SizeT n, std::mt19937 &rng) {
+        std::uniform_int_distribution<u32> distrib(0, 255);
+        Vector<u8> vec(n);
+        for (auto &v : vec) {
+            v = distrib(rng);
+        }
+        return vec;
+    }
+};
+
+// the dispatched popcount kernel agrees with the scalar one, byte counts with a tail included
+TEST_F(HnswHammingTest, test_kernel) {
+    const auto hamming = GetSIMD_FUNCTIONS().HammingDistance_func_ptr_;
+    std::mt19937 rng(0);
+    for (SizeT bytes : {1, 7, 8, 31, 64, 65, 128, 1000}) {
+        auto v1 = RandomBytes(bytes, rng);
+        auto v2 = RandomBytes(bytes, rng);
+        EXPECT_EQ(hamming(v1.data(), v2.data(), bytes), HammingDistance_common(v1.data(), v2.data(), bytes));
+        EXPECT_EQ(hamming(v1.data(), v1.data(), bytes), 0.0f);
+    }
+}
+
+// the store dimension of a bit embedding is its byte count
+TEST_F(HnswHammingTest, test_self_search) {
+    using Hnsw = KnnHnsw<PlainHammingVecStoreType<u8>, LabelT>;
+    const SizeT bytes = 32;
+    const SizeT element_size = 1000;
+    std::mt19937 rng(0);
+    auto data = RandomBytes(bytes * element_size, rng);
+
+    auto hnsw_index = Hnsw::Make(128, 10, bytes, 16, 200);
+    hnsw_index->InsertVecs(DenseVectorIter<u8, LabelT>(data.data(), bytes, element_size));
+    hnsw_index->Check();
+
+    KnnSearchOption search_option{.ef_ = 50};
+    SizeT correct = 0;
+    for (SizeT i = 0; i < element_size; ++i) {
+        auto result = hnsw_index->KnnSearchSorted(data.data() + i * bytes, 1, search_option);
+        correct += result[0].second == i;
+    }
+    EXPECT_GE(f32(correct) / element_size, 0.95);
+}
@@ -0,0 +1,106 @@
+// Copyright(C) 2024 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "gtest/gtest.h"
+import base_test;
+
+import stl;
+import hnsw_alg;
+import hnsw_common;
+import vec_store_type;
+
+using namespace infinity;
+
+class HnswMergeTest : public BaseTest {
+public:
+    using LabelT = u64;
+    using Hnsw = KnnHnsw<PlainL2VecStoreType<f32>, LabelT>;
+
+    const SizeT dim_ = 16;
+    const SizeT M_ = 16;
+    const SizeT ef_construction_ = 200;
+    const SizeT chunk_size_ = 1024;
+    const SizeT max_chunk_n_ = 8;
+    const SizeT src_n_ = 4000;
+    const SizeT append_n_ = 1000;
+
+    UniquePtr<f32[]> MakeData(SizeT n) const {
+        auto data = MakeUniqueForOverwrite<f32[]>(dim_ * n);
+        std::mt19937 rng(0);
+        std::uniform_real_distribution<f32> dist(-1.0, 1.0);
+        std::generate_n(data.get(), dim_ * n, [&] { return dist(rng); });
+        return data;
+    }
+
+    // each vector searches itself out, the labels are the row indexes of `data`
+    f32 SelfSearchRecall(const Hnsw &hnsw_index, const f32 *data, SizeT n) const {
+        KnnSearchOption search_option{.ef_ = 100};
+        SizeT correct = 0;
+        for (SizeT i = 0; i < n; ++i) {
+            auto result = hnsw_index.KnnSearchSorted(data + i * dim_, 1, search_option);
+            correct += !result.empty() && result[0].second == i;
+        }
+        return f32(correct) / n;
+    }
+};
+
+// Every `delete_step` row of the source graph is deleted, the other rows are compacted to the front and followed by the appended rows.
+TEST_F(HnswMergeTest, test_merge_with_deletes) {
+    for (SizeT delete_step : {2, 5, 100}) {
+        auto src_data = MakeData(src_n_ + append_n_);
+        auto src_index = Hnsw::Make(chunk_size_, max_chunk_n_, dim_, M_, ef_construction_);
+        src_index->InsertVecs(DenseVectorIter<f32, LabelT>(src_data.get(), dim_, src_n_));
+
+        Vector<f32> compact_data;
+        Vector<Optional<LabelT>> label_map(src_n_);
+        for (SizeT i = 0; i < src_n_; ++i) {
+            if (i % delete_step == 0) {
+                continue;
+            }
+            label_map[i] = compact_data.size() / dim_;
+            compact_data.insert(compact_data.end(), src_data.get() + i * dim_, src_data.get() + (i + 1) * dim_);
+        }
+        const SizeT kept_n = compact_data.size() / dim_;
+        compact_data.insert(compact_data.end(), src_data.get() + src_n_ * dim_, src_data.get() + (src_n_ + append_n_) * dim_);
+        const SizeT total_n = kept_n + append_n_;
+
+        auto merged_index = Hnsw::Make(chunk_size_, max_chunk_n_, dim_, M_, ef_construction_);
+        auto merged_n = merged_index->MergeGraph(*src_index, [&](LabelT label) { return label_map[label]; });
+        ASSERT_TRUE(merged_n.has_value());
+        EXPECT_EQ(*merged_n, kept_n);
+        merged_index->InsertVecs(DenseVectorIter<f32, LabelT>(compact_data.data() + kept_n * dim_, dim_, append_n_, kept_n));
+        merged_index->Check();
+        EXPECT_EQ(merged_index->GetVecNum(), total_n);
+
+        auto rebuilt_index = Hnsw::Make(chunk_size_, max_chunk_n_, dim_, M_, ef_construction_);
+        rebuilt_index->InsertVecs(DenseVectorIter<f32, LabelT>(compact_data.data(), dim_, total_n));
+
+        f32 merged_recall = SelfSearchRecall(*merged_index, compact_data.data(), total_n);
+        f32 rebuilt_recall = SelfSearchRecall(*rebuilt_index, compact_data.data(), total_n);
+        EXPECT_GE(merged_recall, 0.95);
+        EXPECT_GE(merged_recall, rebuilt_recall - 0.02);
+    }
+}
+
+TEST_F(HnswMergeTest, test_merge_all_deleted) {
+    auto src_data = MakeData(src_n_);
+    auto src_index = Hnsw::Make(chunk_size_, max_chunk_n_, dim_, M_, ef_construction_);
+    src_index->InsertVecs(DenseVectorIter<f32, LabelT>(src_data.get(), dim_, src_n_));
+
+    auto merged_index = Hnsw::Make(chunk_size_, max_chunk_n_, dim_, M_, ef_construction_);
+    auto merged_n = merged_index->MergeGraph(*src_index, [](LabelT) -> Optional<LabelT> { return None; });
+    ASSERT_TRUE(merged_n.has_value());
+    EXPECT_EQ(*merged_n, 0u);
+    EXPECT_EQ(merged_index->GetVecNum(), 0u);
+}
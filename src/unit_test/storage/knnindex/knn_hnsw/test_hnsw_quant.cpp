@@ -0,0 +1,175 @@
+// Copyright(C) 2024 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "gtest/gtest.h"
+import base_test;
+
+import stl;
+import hnsw_alg;
+
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wunused-variable"
+import data_store;
+#pragma clang diagnostic pop
+
+import vec_store_type;
+import hnsw_common;
+import infinity_exception;
+import virtual_store;
+import local_file_handle;
+
+using namespace infinity;
+
+class HnswQuantTest : public BaseTest {
+public:
+    using LabelT = u64;
+
+    const String save_dir_ = GetFullTmpDir();
+    const SizeT dim_ = 32;
+    const SizeT M_ = 16;
+    const SizeT ef_construction_ = 200;
+    const SizeT chunk_size_ = 1024;
+    const SizeT max_chunk_n_ = 4;
+    const SizeT element_size_ = 2048;
+
+    UniquePtr<f32[]> MakeData(SizeT element_n) const {
+        auto data = MakeUniqueForOverwrite<f32[]>(dim_ * element_n);
+        std::mt19937 rng(0);
+        std::uniform_real_distribution<f32> dist(-1.0, 1.0);
+        std::generate_n(data.get(), dim_ * element_n, [&] { return dist(rng); });
+        return data;
+    }
+
+    template <QuantMetric Metric>
+    f32 ExactDistance(const f32 *v1, const f32 *v2) const {
+        f32 l2 = 0, ip = 0, norm1 = 0, norm2 = 0;
+        for (SizeT i = 0; i < dim_; ++i) {
+            l2 += (v1[i] - v2[i]) * (v1[i] - v2[i]);
+            ip += v1[i] * v2[i];
+            norm1 += v1[i] * v1[i];
+            norm2 += v2[i] * v2[i];
+        }
+        if constexpr (Metric == QuantMetric::kL2) {
+            return l2;
+        } else {
+            return -ip / std::sqrt(norm1 * norm2);
+        }
+    }
+
+    // The candidates of the estimated distances are reranked by the raw vectors, then every vector searches itself out first.
+    template <QuantMetric Metric, typename Hnsw>
+    void CheckSelfSearch(const Hnsw &hnsw_index, const f32 *data, SizeT element_n) const {
+        KnnSearchOption search_option{.ef_ = 100};
+        SizeT correct = 0;
+        for (SizeT i = 0; i < element_n; ++i) {
+            const f32 *query = data + i * dim_;
+            auto [result_n, d_ptr, l_ptr] = hnsw_index->KnnSearch(query, 10, search_option);
+            ASSERT_GT(result_n, 0u);
+            LabelT best = l_ptr[0];
+            f32 best_dist = std::numeric_limits<f32>::max();
+            for (SizeT j = 0; j < result_n; ++j) {
+                f32 dist = ExactDistance<Metric>(query, data + l_ptr[j] * dim_);
+                if (dist < best_dist) {
+                    best_dist = dist;
+                    best = l_ptr[j];
+                }
+            }
+            correct += best == LabelT(i);
+        }
+        EXPECT_GE(f32(correct) / element_n, 0.95);
+    }
+
+    template <typename VecStoreType, QuantMetric Metric>
+    void TestBuildSaveLoad() {
+        using Hnsw = KnnHnsw<VecStoreType, LabelT>;
+        using LoadHnsw = KnnHnsw<VecStoreType, LabelT, false>;
+
+        auto data = MakeData(element_size_);
+        const String filepath = save_dir_ + "/test_hnsw_quant.bin";
+        const String ptr_filepath = save_dir_ + "/test_hnsw_quant_ptr.bin";
+        {
+            auto hnsw_index = Hnsw::Make(chunk_size_, max_chunk_n_, dim_, M_, ef_construction_);
+            auto iter = DenseVectorIter<f32, LabelT>(data.get(), dim_, element_size_);
+            hnsw_index->InsertVecs(std::move(iter));
+            hnsw_index->Check();
+            CheckSelfSearch<Metric>(hnsw_index, data.get(), element_size_);
+
+            auto [file_handle, status] = VirtualStore::Open(filepath, FileAccessMode::kWrite);
+            ASSERT_TRUE(status.ok());
+            hnsw_index->Save(*file_handle);
+
+            auto [ptr_file_handle, ptr_status] = VirtualStore::Open(ptr_filepath, FileAccessMode::kWrite);
+            ASSERT_TRUE(ptr_status.ok());
+            hnsw_index->SaveToPtr(*ptr_file_handle);
+        }
+        {
+            auto [file_handle, status] = VirtualStore::Open(filepath, FileAccessMode::kRead);
+            ASSERT_TRUE(status.ok());
+            auto hnsw_index = Hnsw::Load(*file_handle);
+            hnsw_index->Check();
+            CheckSelfSearch<Metric>(hnsw_index, data.get(), element_size_);
+        }
+        {
+            SizeT file_size = VirtualStore::GetFileSize(ptr_filepath);
+            unsigned char *data_ptr = nullptr;
+            ASSERT_GE(VirtualStore::MmapFile(ptr_filepath, data_ptr, file_size), 0);
+            const char *ptr = reinterpret_cast<const char *>(data_ptr);
+            auto hnsw_index = LoadHnsw::LoadFromPtr(ptr, file_size);
+            CheckSelfSearch<Metric>(hnsw_index, data.get(), element_size_);
+            VirtualStore::MunmapFile(ptr_filepath);
+        }
+        VirtualStore::DeleteFile(filepath);
+        VirtualStore::DeleteFile(ptr_filepath);
+    }
+
+    // The first insert has one row, the codebooks fit on it must not be kept for the batch after it.
+    template <typename VecStoreType, QuantMetric Metric>
+    void TestTrainAfterSmallInsert() {
+        using Hnsw = KnnHnsw<VecStoreType, LabelT>;
+
+        const SizeT element_n = 6000;
+        auto data = MakeData(element_n);
+        auto hnsw_index = Hnsw::Make(chunk_size_, 8, dim_, M_, ef_construction_);
+        hnsw_index->InsertVecs(DenseVectorIter<f32, LabelT>(data.get(), dim_, 1));
+        hnsw_index->InsertVecs(DenseVectorIter<f32, LabelT>(data.get() + dim_, dim_, element_n - 1, 1));
+        hnsw_index->Check();
+        CheckSelfSearch<Metric>(hnsw_index, data.get(), element_n);
+    }
+};
+
+TEST_F(HnswQuantTest, pq) {
+    TestBuildSaveLoad<PQVecStoreType<f32, QuantMetric::kL2>, QuantMetric::kL2>();
+    TestBuildSaveLoad<PQVecStoreType<f32, QuantMetric::kCos>, QuantMetric::kCos>();
+    TestTrainAfterSmallInsert<PQVecStoreType<f32, QuantMetric::kL2>, QuantMetric::kL2>();
+}
+
+TEST_F(HnswQuantTest, rabitq) {
+    TestBuildSaveLoad<RaBitQVecStoreType<f32, QuantMetric::kL2>, QuantMetric::kL2>();
+    TestBuildSaveLoad<RaBitQVecStoreType<f32, QuantMetric::kCos>, QuantMetric::kCos>();
+    TestTrainAfterSmallInsert<RaBitQVecStoreType<f32, QuantMetric::kL2>, QuantMetric::kL2>();
+}
+
+TEST_F(HnswQuantTest, memory) {
+    auto data = MakeData(element_size_);
+    auto build = [&]<typename VecStoreType>(VecStoreType) {
+        auto hnsw_index = KnnHnsw<VecStoreType, LabelT>::Make(chunk_size_, max_chunk_n_, dim_, M_, ef_construction_);
+        hnsw_index->InsertVecs(DenseVectorIter<f32, LabelT>(data.get(), dim_, element_size_));
+        return hnsw_index->mem_usage();
+    };
+    SizeT plain_mem = build(PlainL2VecStoreType<f32>());
+    SizeT pq_mem = build(PQVecStoreType<f32, QuantMetric::kL2>());
+    SizeT rabitq_mem = build(RaBitQVecStoreType<f32, QuantMetric::kL2>());
+    EXPECT_LT(pq_mem, plain_mem);
+    EXPECT_LT(rabitq_mem, plain_mem);
+}
@@ -0,0 +1,114 @@
+// Copyright(C) 2024 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "gtest/gtest.h"
+import base_test;
+
+import stl;
+import hnsw_alg;
+import hnsw_common;
+import vec_store_type;
+
+using namespace infinity;
+
+class HnswTombstoneTest : public BaseTest {
+public:
+    using LabelT = u64;
+    using Hnsw = KnnHnsw<PlainL2VecStoreType<f32>, LabelT>;
+
+    const SizeT dim_ = 16;
+    const SizeT M_ = 16;
+    const SizeT ef_construction_ = 200;
+    const SizeT element_size_ = 3000;
+    const SizeT delete_step_ = 3;
+    const TxnTimeStamp delete_ts_ = 10;
+
+    void SetUp() override {
+        BaseTest::SetUp();
+        data_ = MakeUniqueForOverwrite<f32[]>(dim_ * element_size_);
+        std::mt19937 rng(0);
+        std::uniform_real_distribution<f32> dist(-1.0, 1.0);
+        std::generate_n(data_.get(), dim_ * element_size_, [&] { return dist(rng); });
+        hnsw_index_ = Hnsw::Make(1024, 8, dim_, M_, ef_construction_);
+        hnsw_index_->InsertVecs(DenseVectorIter<f32, LabelT>(data_.get(), dim_, element_size_));
+    }
+
+    bool IsDeleted(LabelT label) const { return label % delete_step_ == 0; }
+
+    UniquePtr<f32[]> data_;
+    UniquePtr<Hnsw> hnsw_index_;
+};
+
+// the searches began after the deletes skip the tombstones, the older ones still see them
+TEST_F(HnswTombstoneTest, test_search_skip_deleted) {
+    SizeT deleted_n = hnsw_index_->MarkDeleted(delete_ts_, [&](LabelT label) { return IsDeleted(label); });
+    EXPECT_EQ(deleted_n, (element_size_ - 1) / delete_step_ + 1);
+    EXPECT_EQ(hnsw_index_->GetDeletedNum(), deleted_n);
+
+    KnnSearchOption search_option{.ef_ = 100, .begin_ts_ = delete_ts_};
+    SizeT correct = 0;
+    for (SizeT i = 0; i < element_size_; ++i) {
+        auto result = hnsw_index_->KnnSearchSorted(data_.get() + i * dim_, 10, search_option);
+        for (const auto &[dist, label] : result) {
+            EXPECT_FALSE(IsDeleted(label));
+        }
+        if (!IsDeleted(i)) {
+            correct += !result.empty() && result[0].second == i;
+        }
+    }
+    EXPECT_GE(f32(correct) / (element_size_ - deleted_n), 0.95);
+
+    auto batch_results = hnsw_index_->KnnSearchBatch(data_.get(), element_size_, 10, search_option);
+    for (const auto &[result_n, d_ptr, l_ptr] : batch_results) {
+        for (SizeT i = 0; i < result_n; ++i) {
+            EXPECT_FALSE(IsDeleted(l_ptr[i]));
+        }
+    }
+
+    KnnSearchOption old_search_option{.ef_ = 100, .begin_ts_ = delete_ts_ - 1};
+    auto result = hnsw_index_->KnnSearchSorted(data_.get(), 1, old_search_option);
+    ASSERT_FALSE(result.empty());
+    EXPECT_EQ(result[0].second, 0u);
+
+    EXPECT_EQ(hnsw_index_->MarkDeleted(delete_ts_ + 1, [](LabelT) { return false; }), 0u);
+    EXPECT_EQ(hnsw_index_->GetDeletedNum(), 0u);
+}
+
+// the repaired graph drops the deleted vertices and reconnects their neighbors
+TEST_F(HnswTombstoneTest, test_repair) {
+    hnsw_index_->MarkDeleted(delete_ts_, [&](LabelT label) { return IsDeleted(label); });
+
+    auto repaired_index = Hnsw::Make(1024, 8, dim_, M_, ef_construction_);
+    auto repaired_n = repaired_index->MergeGraph(*hnsw_index_, [&](LabelT label) -> Optional<LabelT> {
+        if (IsDeleted(label)) {
+            return None;
+        }
+        return label;
+    });
+    ASSERT_TRUE(repaired_n.has_value());
+    repaired_index->Check();
+    EXPECT_EQ(repaired_index->GetVecNum(), *repaired_n);
+    EXPECT_EQ(repaired_index->GetDeletedNum(), 0u);
+
+    KnnSearchOption search_option{.ef_ = 100};
+    SizeT correct = 0;
+    for (SizeT i = 0; i < element_size_; ++i) {
+        if (IsDeleted(i)) {
+            continue;
+        }
+        auto result = repaired_index->KnnSearchSorted(data_.get() + i * dim_, 1, search_option);
+        correct += !result.empty() && result[0].second == i;
+    }
+    EXPECT_GE(f32(correct) / *repaired_n, 0.95);
+}
@@ -0,0 +1,109 @@
+// Copyright(C) 2024 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "gtest/gtest.h"
+import base_test;
+
+import stl;
+import index_ivf;
+import index_base;
+import internal_types;
+import logical_type;
+import knn_expr;
+import knn_scan_data;
+import ivf_index_storage;
+
+using namespace infinity;
+
+class IVFSearchTest : public BaseTest {
+public:
+    const u32 dim_ = 16;
+    const u32 element_size_ = 40000;
+
+    Vector<f32> MakeData() const {
+        Vector<f32> data(dim_ * element_size_);
+        std::mt19937 rng(0);
+        std::uniform_real_distribution<f32> dist(-1.0, 1.0);
+        std::generate(data.begin(), data.end(), [&] { return dist(rng); });
+        return data;
+    }
+
+    static f32 ExactL2(const f32 *v1, const f32 *v2, const u32 dim) {
+        f32 d = 0.0f;
+        for (u32 i = 0; i < dim; ++i) {
+            d += (v1[i] - v2[i]) * (v1[i] - v2[i]);
+        }
+        return d;
+    }
+
+    // probe all lists, large enough for the lists to be split among the search tasks
+    Vector<f32> SearchAll(const IndexIVFStorageOption &storage_option, const Vector<f32> &data, const f32 *query) const {
+        IndexIVFOption ivf_option;
+        ivf_option.metric_ = MetricType::kMetricL2;
+        ivf_option.storage_option_ = storage_option;
+        IVF_Index_Storage ivf_storage(ivf_option, LogicalType::kEmbedding, EmbeddingDataType::kElemFloat, dim_);
+        ivf_storage.Train(element_size_, data.data());
+        ivf_storage.AddEmbeddingBatch(0, data.data(), element_size_);
+
+        auto knn_distance = KnnDistanceBase1::Make(EmbeddingDataType::kElemFloat, KnnDistanceType::kL2);
+        Vector<f32> dists(element_size_, -1.0f);
+        SizeT result_n = 0;
+        ivf_storage.SearchIndex(
+            knn_distance.get(),
+            query,
+            EmbeddingDataType::kElemFloat,
+            std::numeric_limits<u32>::max(),
+            [](SegmentOffset) { return true; },
+            [&](const f32 d, const SegmentOffset segment_offset) {
+                EXPECT_EQ(dists[segment_offset], -1.0f);
+                dists[segment_offset] = d;
+                ++result_n;
+            });
+        EXPECT_EQ(result_n, element_size_);
+        return dists;
+    }
+};
+
+// every row is scanned once by the parallel probes, the blocked distances agree with the exact ones
+TEST_F(IVFSearchTest, test_parallel_probe) {
+    const auto data = MakeData();
+    const f32 *query = data.data();
+
+    IndexIVFStorageOption plain_option;
+    plain_option.type_ = IndexIVFStorageOption::Type::kPlain;
+    plain_option.plain_storage_data_type_ = EmbeddingDataType::kElemFloat;
+    const auto plain_dists = SearchAll(plain_option, data, query);
+    for (u32 i = 0; i < element_size_; ++i) {
+        EXPECT_NEAR(plain_dists[i], ExactL2(query, data.data() + i * dim_, dim_), 1e-4);
+    }
+
+    IndexIVFStorageOption sq_option;
+    sq_option.type_ = IndexIVFStorageOption::Type::kScalarQuantization;
+    sq_option.scalar_quantization_bits_ = 8;
+    const auto sq_dists = SearchAll(sq_option, data, query);
+    for (u32 i = 0; i < element_size_; ++i) {
+        EXPECT_NEAR(sq_dists[i], ExactL2(query, data.data() + i * dim_, dim_), 0.1);
+    }
+
+    IndexIVFStorageOption pq_option;
+    pq_option.type_ = IndexIVFStorageOption::Type::kProductQuantization;
+    pq_option.product_quantization_subspace_num_ = 4;
+    pq_option.product_quantization_subspace_bits_ = 8;
+    const auto pq_dists = SearchAll(pq_option, data, query);
+    SizeT pq_near_n = 0;
+    for (u32 i = 0; i < element_size_; ++i) {
+        pq_near_n += std::abs(pq_dists[i] - ExactL2(query, data.data() + i * dim_, dim_)) < 1.0f;
+    }
+    EXPECT_GE(f32(pq_near_n) / element_size_, 0.9);
+}
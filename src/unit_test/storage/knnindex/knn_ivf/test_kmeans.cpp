@@ -0,0 +1,106 @@
+// Copyright(C) 2024 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "gtest/gtest.h"
+import base_test;
+
+import stl;
+import index_base;
+import kmeans_partition;
+
+using namespace infinity;
+
+class KMeansTest : public BaseTest {
+public:
+    const u32 dim_ = 16;
+    const u32 cluster_num_ = 8;
+    const u32 element_size_ = 40000;
+
+    // points around cluster_num_ well separated centers
+    Vector<f32> MakeData() const {
+        std::mt19937 rng(0);
+        std::uniform_real_distribution<f32> center_dist(-10.0, 10.0);
+        std::normal_distribution<f32> noise_dist(0.0, 0.1);
+        Vector<f32> centers(cluster_num_ * dim_);
+        std::generate(centers.begin(), centers.end(), [&] { return center_dist(rng); });
+        Vector<f32> data(element_size_ * dim_);
+        for (u32 i = 0; i < element_size_; ++i) {
+            const f32 *center = centers.data() + (i % cluster_num_) * dim_;
+            for (u32 j = 0; j < dim_; ++j) {
+                data[i * dim_ + j] = center[j] + noise_dist(rng);
+            }
+        }
+        return data;
+    }
+
+    // sum of the squared distances to the nearest centroids
+    f32 QuantizationError(const Vector<f32> &data, const Vector<f32> &centroids) const {
+        const u32 centroid_num = centroids.size() / dim_;
+        f32 error = 0.0f;
+        for (u32 i = 0; i < element_size_; ++i) {
+            f32 min_d = std::numeric_limits<f32>::max();
+            for (u32 c = 0; c < centroid_num; ++c) {
+                f32 d = 0.0f;
+                for (u32 j = 0; j < dim_; ++j) {
+                    const f32 diff = data[i * dim_ + j] - centroids[c * dim_ + j];
+                    d += diff * diff;
+                }
+                min_d = std::min(min_d, d);
+            }
+            error += min_d;
+        }
+        return error;
+    }
+};
+
+// the parallel full batch and mini-batch trainings both find the clusters and report their iterations
+TEST_F(KMeansTest, test_parallel_and_mini_batch) {
+    const auto data = MakeData();
+    Vector<f32> mean(dim_, 0.0f);
+    for (u32 i = 0; i < element_size_; ++i) {
+        for (u32 j = 0; j < dim_; ++j) {
+            mean[j] += data[i * dim_ + j] / element_size_;
+        }
+    }
+    const f32 mean_error = QuantizationError(data, mean);
+
+    ThreadPool thread_pool(4);
+    for (const u32 mini_batch_size : {0u, 1024u}) {
+        KMeansProgress progress;
+        const KMeansOption kmeans_option{.thread_pool_ = &thread_pool, .mini_batch_size_ = mini_batch_size, .progress_ = &progress};
+        Vector<f32> centroids;
+        // large enough max_points_per_centroid for the assignment to be split among the threads
+        const u32 centroid_num = GetKMeansCentroids(MetricType::kMetricL2,
+                                                    dim_,
+                                                    element_size_,
+                                                    data.data(),
+                                                    centroids,
+                                                    cluster_num_,
+                                                    0,
+                                                    32,
+                                                    element_size_,
+                                                    1.0f,
+                                                    kmeans_option);
+        EXPECT_EQ(centroid_num, cluster_num_);
+        ASSERT_EQ(centroids.size(), cluster_num_ * dim_);
+        for (const f32 v : centroids) {
+            EXPECT_TRUE(std::isfinite(v));
+        }
+        EXPECT_LT(QuantizationError(data, centroids), 0.5f * mean_error);
+
+        EXPECT_GT(progress.iteration_.load(), 0u);
+        EXPECT_EQ(progress.iteration_max_.load(), 0u);
+        EXPECT_EQ(progress.training_num_.load(), element_size_);
+    }
+}
@@ -0,0 +1,93 @@
+// Copyright(C) 2023 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <filesystem>
+#include <fstream>
+
+#include "gtest/gtest.h"
+import base_test;
+
+import stl;
+import third_party;
+import catalog_checkpoint;
+import infinity_exception;
+
+using namespace infinity;
+
+class CatalogCheckpointTest : public BaseTest {
+protected:
+    void SetUp() override {
+        BaseTest::SetUp();
+        CleanupTmpDir();
+        std::filesystem::create_directories(GetFullTmpDir());
+    }
+
+    String FilePath(const String &name) { return fmt::format("{}/{}", GetFullTmpDir(), name); }
+};
+
+TEST_F(CatalogCheckpointTest, sections) {
+    String path = FilePath("FULL.10.json");
+    nlohmann::json db_json = {{"db_name", "default_db"}, {"db_entries", {{{"db_name", "default_db"}}}}};
+    nlohmann::json table_json = {{"table_name", "t1"}, {"table_entries", nlohmann::json::array()}};
+    {
+        CatalogCheckpointWriter writer(path, 7, 10);
+        u32 db_idx = writer.AddSection(CatalogSectionKind::kDatabase, 0, 0, nlohmann::json::to_msgpack(db_json));
+        writer.AddSection(CatalogSectionKind::kTable, db_idx, 0, nlohmann::json::to_msgpack(table_json));
+        writer.AddSection(CatalogSectionKind::kObjectAddrMap, 0, 0, nlohmann::json::to_msgpack(nlohmann::json::object()));
+        writer.Finish();
+    }
+
+    CatalogCheckpointReader reader(path);
+    ASSERT_TRUE(reader.IsBinary());
+    EXPECT_EQ(reader.next_txn_id(), 7u);
+    EXPECT_EQ(reader.full_ckp_commit_ts(), 10u);
+    const auto &sections = reader.sections();
+    ASSERT_EQ(sections.size(), 3u);
+    EXPECT_EQ(sections[0].kind_, CatalogSectionKind::kDatabase);
+    EXPECT_EQ(reader.ReadSection(sections[0]), db_json);
+    EXPECT_EQ(sections[1].kind_, CatalogSectionKind::kTable);
+    EXPECT_EQ(sections[1].parent_, 0u);
+    EXPECT_EQ(reader.ReadSection(sections[1]), table_json);
+    EXPECT_EQ(sections[2].kind_, CatalogSectionKind::kObjectAddrMap);
+}
+
+TEST_F(CatalogCheckpointTest, json_format) {
+    String path = FilePath("FULL.20.json");
+    nlohmann::json catalog_json = {{"next_txn_id", 3}, {"full_ckp_commit_ts", 20}};
+    {
+        std::ofstream ofs(path);
+        ofs << catalog_json.dump();
+    }
+    CatalogCheckpointReader reader(path);
+    EXPECT_FALSE(reader.IsBinary());
+    EXPECT_EQ(reader.ReadJson(), catalog_json);
+}
+
+TEST_F(CatalogCheckpointTest, corrupted_section) {
+    String path = FilePath("FULL.30.json");
+    {
+        CatalogCheckpointWriter writer(path, 1, 30);
+        writer.AddSection(CatalogSectionKind::kDatabase, 0, 0, nlohmann::json::to_msgpack(nlohmann::json{{"db_name", "db1"}}));
+        writer.Finish();
+    }
+    {
+        // Flip a byte of the payload, which starts right after the header.
+        std::fstream fs(path, std::ios::in | std::ios::out | std::ios::binary);
+        fs.seekp(sizeof(CATALOG_CHECKPOINT_MAGIC) + sizeof(u32) + sizeof(u64) * 2 + 1);
+        fs.put('\xff');
+    }
+    CatalogCheckpointReader reader(path);
+    ASSERT_EQ(reader.sections().size(), 1u);
+    EXPECT_THROW(reader.ReadSection(reader.sections()[0]), RecoverableException);
+}
@@ -0,0 +1,169 @@
+// Copyright(C) 2024 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "gtest/gtest.h"
+#include <filesystem>
+#include <fstream>
+import base_test;
+
+import stl;
+import wal_file_writer;
+import default_values;
+import options;
+
+using namespace infinity;
+class WalFileWriterTest : public BaseTest {
+protected:
+    void SetUp() override {
+        std::filesystem::create_directories(GetFullTmpDir());
+        path_ = String(GetFullTmpDir()) + "/wal.log";
+        std::filesystem::remove(path_);
+    }
+
+    // Append an entry of `size` bytes to the writer and to the expected content.
+    void AppendEntry(WalFileWriter &writer, SizeT size) {
+        String entry(size, '\0');
+        for (SizeT i = 0; i < size; ++i) {
+            entry[i] = char('a' + (expected_.size() + i) % 26);
+        }
+        writer.Append(entry.data(), entry.size());
+        expected_ += entry;
+    }
+
+    static String ReadFile(const String &path) {
+        std::ifstream file(path, std::ios::binary);
+        return String(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+
+    static i64 DiskSize(const String &path) { return std::filesystem::file_size(path); }
+
+    String path_;
+    String expected_;
+};
+
+// Entries fill the buffer many times over, each full buffer is written out and reused from its start.
+TEST_F(WalFileWriterTest, buffer_wraparound) {
+    WalFileWriter writer;
+    writer.Open(path_);
+    SizeT entry_n = 0;
+    while (expected_.size() < 5 * DEFAULT_WAL_WRITE_BUFFER_SIZE) {
+        AppendEntry(writer, 1 + entry_n * 37 % 5000);
+        ++entry_n;
+        EXPECT_EQ(writer.FileSize(), i64(expected_.size()));
+        // only the data that doesn't fit in the buffer is written
+        EXPECT_LE(i64(expected_.size()) - DiskSize(path_), i64(DEFAULT_WAL_WRITE_BUFFER_SIZE));
+    }
+    EXPECT_GT(DiskSize(path_), 0);
+    EXPECT_LT(DiskSize(path_), writer.FileSize());
+
+    writer.Write();
+    EXPECT_EQ(DiskSize(path_), writer.FileSize());
+    EXPECT_EQ(ReadFile(path_), expected_);
+    writer.Close();
+}
+
+// An entry larger than the buffer grows the buffer, which stays aligned, and the entries around it keep their order.
+TEST_F(WalFileWriterTest, large_entry) {
+    WalFileWriter writer;
+    writer.Open(path_);
+    AppendEntry(writer, 100);
+
+    const SizeT large_size = 3 * DEFAULT_WAL_WRITE_BUFFER_SIZE + 5;
+    char *buf = writer.Reserve(large_size + 1000);
+    // the buffered entry is written to make room, so the large entry starts at the aligned buffer start
+    EXPECT_EQ(DiskSize(path_), 100);
+    EXPECT_EQ(reinterpret_cast<SizeT>(buf) % WAL_WRITE_BUFFER_ALIGNMENT, 0u);
+    for (SizeT i = 0; i < large_size; ++i) {
+        buf[i] = char('a' + (expected_.size() + i) % 26);
+        expected_ += buf[i];
+    }
+    // only the serialized part of the reserved buffer is committed
+    writer.Commit(large_size);
+    EXPECT_EQ(writer.FileSize(), i64(expected_.size()));
+
+    for (SizeT i = 0; i < 100; ++i) {
+        AppendEntry(writer, 4000);
+    }
+    AppendEntry(writer, large_size);
+    writer.Sync();
+    EXPECT_EQ(writer.FileSize(), i64(expected_.size()));
+    EXPECT_EQ(ReadFile(path_), expected_);
+    writer.Close();
+}
+
+// The file size tracked in memory matches the one on disk after the file is rotated and reopened.
+TEST_F(WalFileWriterTest, rotate_file_size) {
+    WalFileWriter writer;
+    writer.Open(path_);
+    AppendEntry(writer, 3000);
+    writer.Close();
+    EXPECT_FALSE(writer.IsOpen());
+    EXPECT_EQ(DiskSize(path_), 3000);
+
+    // rotate as WalManager::SwapWalFile does
+    String rotated_path = path_ + ".1";
+    std::filesystem::rename(path_, rotated_path);
+    writer.Open(path_);
+    EXPECT_EQ(writer.FileSize(), 0);
+    EXPECT_EQ(writer.UnsyncedSize(), 0);
+    expected_.clear();
+    AppendEntry(writer, 5000);
+    writer.Write();
+    EXPECT_EQ(writer.FileSize(), DiskSize(path_));
+    writer.Close();
+
+    // reopen the current file, as after a restart
+    writer.Open(path_);
+    EXPECT_EQ(writer.FileSize(), 5000);
+    AppendEntry(writer, 7000);
+    writer.Write();
+    EXPECT_EQ(writer.FileSize(), DiskSize(path_));
+    EXPECT_EQ(ReadFile(path_), expected_);
+    writer.Close();
+    EXPECT_EQ(DiskSize(rotated_path), 3000);
+    std::filesystem::remove(rotated_path);
+}
+
+TEST_F(WalFileWriterTest, flush_option) {
+    WalFileWriter writer;
+    writer.Open(path_);
+
+    // flush_at_once syncs every batch
+    AppendEntry(writer, 1000);
+    EXPECT_TRUE(writer.Flush(FlushOptionType::kFlushAtOnce, std::chrono::steady_clock::now()));
+    EXPECT_EQ(writer.UnsyncedSize(), 0);
+    EXPECT_EQ(DiskSize(path_), writer.FileSize());
+
+    // only_write writes the batch to the OS without syncing, however long ago the last sync was
+    AppendEntry(writer, 1000);
+    auto later = writer.LastSyncTime() + std::chrono::milliseconds(10 * WAL_SYNC_INTERVAL_MS);
+    EXPECT_FALSE(writer.Flush(FlushOptionType::kOnlyWrite, later));
+    EXPECT_EQ(writer.UnsyncedSize(), 1000);
+    EXPECT_EQ(DiskSize(path_), writer.FileSize());
+
+    // flush_per_second writes each batch, and syncs once the interval has passed since the last sync
+    AppendEntry(writer, 1000);
+    auto last_sync_time = writer.LastSyncTime();
+    EXPECT_FALSE(writer.Flush(FlushOptionType::kFlushPerSecond, last_sync_time + std::chrono::milliseconds(WAL_SYNC_INTERVAL_MS - 1)));
+    EXPECT_EQ(writer.UnsyncedSize(), 2000);
+    EXPECT_EQ(DiskSize(path_), writer.FileSize());
+    EXPECT_EQ(writer.LastSyncTime(), last_sync_time);
+
+    AppendEntry(writer, 1000);
+    EXPECT_TRUE(writer.Flush(FlushOptionType::kFlushPerSecond, last_sync_time + std::chrono::milliseconds(WAL_SYNC_INTERVAL_MS)));
+    EXPECT_EQ(writer.UnsyncedSize(), 0);
+    EXPECT_GT(writer.LastSyncTime(), last_sync_time);
+    EXPECT_EQ(ReadFile(path_), expected_);
+    writer.Close();
+}
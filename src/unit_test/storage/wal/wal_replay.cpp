@@ -14,6 +14,7 @@
 
 #include "type/complex/embedding_type.h"
 #include "gtest/gtest.h"
+#include <filesystem>
 import base_test;
 
 import stl;
@@ -71,6 +72,13 @@ protected:
                    : std::make_shared<std::string>(std::string(test_data_path()) + "/config/test_close_ckp_vfs_off.toml");
     }
 
+    // The same config, with the wal replayed by one thread
+    static std::shared_ptr<std::string> serial_replay_config_path() {
+        return GetParam() == BaseTestParamStr::NULL_CONFIG_PATH
+                   ? std::make_shared<std::string>(std::string(test_data_path()) + "/config/test_close_ckp_serial_replay.toml")
+                   : std::make_shared<std::string>(std::string(test_data_path()) + "/config/test_close_ckp_serial_replay_vfs_off.toml");
+    }
+
     void SetUp() override {
         CleanupDbDirs();
         tree_cmd = "tree ";
@@ -85,6 +93,47 @@ protected:
     String tree_cmd;
 };
 
+namespace {
+
+// Row count of each table, and the row count and the visible row count of each of its segments
+using ReplayState = Map<String, Pair<SizeT, Vector<Tuple<SegmentID, SizeT, SizeT>>>>;
+
+ReplayState CollectReplayState(TxnManager *txn_mgr, const Vector<String> &table_names) {
+    ReplayState state;
+    auto *txn = txn_mgr->BeginTxn(MakeUnique<String>("collect replay state"), TransactionType::kNormal);
+    for (const auto &table_name : table_names) {
+        auto [table_entry, status] = txn->GetTableByName("default_db", table_name);
+        if (!status.ok()) {
+            continue;
+        }
+        auto &[row_count, segments] = state[table_name];
+        row_count = table_entry->row_count();
+        for (const auto &[segment_id, segment_entry] : table_entry->segment_map()) {
+            segments.emplace_back(segment_id, segment_entry->row_count(), segment_entry->actual_row_count());
+        }
+    }
+    txn_mgr->CommitTxn(txn);
+    return state;
+}
+
+SharedPtr<DataBlock> MakeReplayBlock(SizeT row_begin, SizeT row_count) {
+    auto input_block = MakeShared<DataBlock>();
+    Vector<SharedPtr<DataType>> column_types;
+    column_types.emplace_back(MakeShared<DataType>(LogicalType::kTinyInt));
+    column_types.emplace_back(MakeShared<DataType>(LogicalType::kBigInt));
+    column_types.emplace_back(MakeShared<DataType>(LogicalType::kDouble));
+    input_block->Init(column_types, row_count);
+    for (SizeT i = row_begin; i < row_begin + row_count; ++i) {
+        input_block->AppendValue(0, Value::MakeTinyInt(static_cast<i8>(i % 128)));
+        input_block->AppendValue(1, Value::MakeBigInt(static_cast<i64>(i)));
+        input_block->AppendValue(2, Value::MakeDouble(static_cast<f64>(i)));
+    }
+    input_block->Finalize();
+    return input_block;
+}
+
+} // namespace
+
 INSTANTIATE_TEST_SUITE_P(TestWithDifferentParams,
                          WalReplayTest,
                          ::testing::Values(BaseTestParamStr::NULL_CONFIG_PATH, BaseTestParamStr::VFS_OFF_CONFIG_PATH));
@@ -1014,3 +1063,141 @@ TEST_P(WalReplayTest, wal_replay_create_index_hnsw) {
 #endif
     }
 }
+
+// Appends and deletes of several tables, interleaved with multi-table appends, create and drop table as barriers.
+// Replaying the wal by one thread and by several threads gives the same tables as before the restart.
+TEST_P(WalReplayTest, wal_replay_parallel) {
+    const Vector<String> table_names{"tbl0", "tbl1", "tbl2", "tbl3"};
+    constexpr SizeT round_n = 4;
+    constexpr SizeT append_row_n = 3000;
+    Vector<SharedPtr<ColumnDef>> columns;
+    {
+        i64 column_id = 0;
+        columns.emplace_back(
+            MakeShared<ColumnDef>(column_id++, MakeShared<DataType>(LogicalType::kTinyInt), "tiny_int_col", std::set<ConstraintType>()));
+        columns.emplace_back(
+            MakeShared<ColumnDef>(column_id++, MakeShared<DataType>(LogicalType::kBigInt), "big_int_col", std::set<ConstraintType>()));
+        columns.emplace_back(
+            MakeShared<ColumnDef>(column_id++, MakeShared<DataType>(LogicalType::kDouble), "double_col", std::set<ConstraintType>()));
+    }
+
+    ReplayState expected_state;
+    {
+#ifdef INFINITY_DEBUG
+        infinity::GlobalResourceUsage::Init();
+#endif
+        std::shared_ptr<std::string> config_path = WalReplayTest::config_path();
+        infinity::InfinityContext::instance().InitPhase1(config_path);
+        infinity::InfinityContext::instance().InitPhase2();
+
+        Storage *storage = infinity::InfinityContext::instance().storage();
+        TxnManager *txn_mgr = storage->txn_manager();
+
+        auto create_table = [&](const String &table_name) {
+            auto table_def =
+                MakeUnique<TableDef>(MakeShared<String>("default_db"), MakeShared<String>(table_name), MakeShared<String>(), columns);
+            auto *txn = txn_mgr->BeginTxn(MakeUnique<String>("create table"), TransactionType::kNormal);
+            Status status = txn->CreateTable("default_db", std::move(table_def), ConflictType::kError);
+            EXPECT_TRUE(status.ok());
+            txn_mgr->CommitTxn(txn);
+        };
+        // the rows appended to each table since it was created
+        Map<String, SizeT> table_row_n;
+        for (const auto &table_name : {"tbl0", "tbl1", "tbl2"}) {
+            create_table(table_name);
+            table_row_n[table_name] = 0;
+        }
+
+        for (SizeT round = 0; round < round_n; ++round) {
+            for (auto &[table_name, row_n] : table_row_n) {
+                auto *txn = txn_mgr->BeginTxn(MakeUnique<String>("insert table"), TransactionType::kNormal);
+                Status status = txn->Append("default_db", table_name, MakeReplayBlock(row_n, append_row_n));
+                EXPECT_TRUE(status.ok());
+                txn_mgr->CommitTxn(txn);
+                row_n += append_row_n;
+            }
+            {
+                // one entry appending to two tables is replayed alone
+                auto *txn = txn_mgr->BeginTxn(MakeUnique<String>("insert tables"), TransactionType::kNormal);
+                for (const auto &table_name : {"tbl0", "tbl2"}) {
+                    Status status = txn->Append("default_db", table_name, MakeReplayBlock(table_row_n[table_name], round + 1));
+                    EXPECT_TRUE(status.ok());
+                    table_row_n[table_name] += round + 1;
+                }
+                txn_mgr->CommitTxn(txn);
+            }
+            for (auto &[table_name, row_n] : table_row_n) {
+                Vector<RowID> row_ids;
+                for (SizeT row_id = round; row_id < row_n; row_id += 7 * (round + 1)) {
+                    row_ids.emplace_back(0, row_id);
+                }
+                auto *txn = txn_mgr->BeginTxn(MakeUnique<String>("delete"), TransactionType::kNormal);
+                Status status = txn->Delete("default_db", table_name, row_ids);
+                EXPECT_TRUE(status.ok());
+                txn_mgr->CommitTxn(txn);
+            }
+            if (round == 1) {
+                create_table("tbl3");
+                table_row_n["tbl3"] = 0;
+            }
+            if (round == 2) {
+                // the lane of the recreated table starts after the barrier
+                auto *txn = txn_mgr->BeginTxn(MakeUnique<String>("drop table"), TransactionType::kNormal);
+                Status status = txn->DropTableCollectionByName("default_db", "tbl1", ConflictType::kError);
+                EXPECT_TRUE(status.ok());
+                txn_mgr->CommitTxn(txn);
+                create_table("tbl1");
+                table_row_n["tbl1"] = 0;
+            }
+        }
+        expected_state = CollectReplayState(txn_mgr, table_names);
+        EXPECT_EQ(expected_state.size(), table_names.size());
+
+        infinity::InfinityContext::instance().UnInit();
+#ifdef INFINITY_DEBUG
+        EXPECT_EQ(infinity::GlobalResourceUsage::GetObjectCount(), 0);
+        EXPECT_EQ(infinity::GlobalResourceUsage::GetRawMemoryCount(), 0);
+        infinity::GlobalResourceUsage::UnInit();
+#endif
+    }
+
+    // The restart checkpoints the replayed catalog, keep the files to replay the same wal again.
+    const Vector<String> db_dirs{GetFullDataDir(), GetFullWalDir(), GetFullPersistDir()};
+    const String backup_dir = String(GetHomeDir()) + "/wal_replay_parallel_backup";
+    std::filesystem::remove_all(backup_dir);
+    std::filesystem::create_directories(backup_dir);
+    for (SizeT i = 0; i < db_dirs.size(); ++i) {
+        if (std::filesystem::exists(db_dirs[i])) {
+            std::filesystem::copy(db_dirs[i], backup_dir + "/" + std::to_string(i), std::filesystem::copy_options::recursive);
+        }
+    }
+
+    for (bool serial_replay : {true, false}) {
+        if (!serial_replay) {
+            for (SizeT i = 0; i < db_dirs.size(); ++i) {
+                std::filesystem::remove_all(db_dirs[i]);
+                if (std::filesystem::exists(backup_dir + "/" + std::to_string(i))) {
+                    std::filesystem::copy(backup_dir + "/" + std::to_string(i), db_dirs[i], std::filesystem::copy_options::recursive);
+                }
+            }
+        }
+#ifdef INFINITY_DEBUG
+        infinity::GlobalResourceUsage::Init();
+#endif
+        std::shared_ptr<std::string> config_path =
+            serial_replay ? WalReplayTest::serial_replay_config_path() : WalReplayTest::config_path();
+        infinity::InfinityContext::instance().InitPhase1(config_path);
+        infinity::InfinityContext::instance().InitPhase2();
+
+        TxnManager *txn_mgr = infinity::InfinityContext::instance().storage()->txn_manager();
+        EXPECT_EQ(CollectReplayState(txn_mgr, table_names), expected_state);
+
+        infinity::InfinityContext::instance().UnInit();
+#ifdef INFINITY_DEBUG
+        EXPECT_EQ(infinity::GlobalResourceUsage::GetObjectCount(), 0);
+        EXPECT_EQ(infinity::GlobalResourceUsage::GetRawMemoryCount(), 0);
+        infinity::GlobalResourceUsage::UnInit();
+#endif
+    }
+    std::filesystem::remove_all(backup_dir);
+}
@@ -0,0 +1,157 @@
+import argparse
+import os
+import csv
+import random
+from collections import defaultdict
+
+
+# The aggregates do not skip nulls yet, so the data has none: a NULL here would bake that bug into the expected results.
+def agg_row(values):
+    return "{} {} {} {} {} {:.6f}".format(
+        len(values),
+        len(values),
+        sum(values),
+        min(values),
+        max(values),
+        sum(values) / len(values),
+    )
+
+
+def generate(generate_if_exists: bool, copy_dir: str):
+    data_dir = "./test/data/csv"
+    slt_dir = "./test/sql/dql/aggregate"
+
+    table_name = "test_parallel_agg"
+    file_n = 3
+    data_paths = [data_dir + "/test_parallel_agg{}.csv".format(i) for i in range(file_n)]
+    copy_paths = [copy_dir + "/test_parallel_agg{}.csv".format(i) for i in range(file_n)]
+    slt_path = slt_dir + "/test_parallel_agg.slt"
+
+    os.makedirs(data_dir, exist_ok=True)
+    os.makedirs(slt_dir, exist_ok=True)
+    if (
+        all(os.path.exists(p) for p in data_paths)
+        and os.path.exists(slt_path)
+        and not generate_if_exists
+    ):
+        print(
+            "File {} and {} already existed exists. Skip Generating.".format(
+                slt_path, data_paths[0]
+            )
+        )
+        return
+
+    # every copied file is a segment of two blocks, so the scan has several tasks
+    row_n = 9000
+    group_n = 100
+    # the largest group of the copied files
+    last_group = group_n - 1
+    rng = random.Random(0)
+    groups = defaultdict(list)
+    for d_path in data_paths:
+        with open(d_path, "w") as data_file:
+            writer = csv.writer(data_file)
+            for i in range(row_n):
+                c1 = rng.randint(0, group_n - 1)
+                c2 = rng.randint(1, 100)
+                groups[c1].append(c2)
+                writer.writerow([c1, c2])
+
+    # the groups from 100 on are only in the unsealed segment
+    insert_rows = [(100, 5), (100, 9), (101, 7), (102, 1), (0, 50), (last_group, 100)]
+    for c1, c2 in insert_rows:
+        groups[c1].append(c2)
+
+    agg_list = "COUNT(*), COUNT(c2), SUM(c2), MIN(c2), MAX(c2), AVG(c2)"
+
+    with open(slt_path, "w") as slt_file:
+        slt_file.write("statement ok\n")
+        slt_file.write("DROP TABLE IF EXISTS {};\n".format(table_name))
+        slt_file.write("\n")
+
+        slt_file.write("statement ok\n")
+        slt_file.write("CREATE TABLE {} (c1 int, c2 int);\n".format(table_name))
+        slt_file.write("\n")
+
+        for c_path in copy_paths:
+            slt_file.write("statement ok\n")
+            slt_file.write(
+                "COPY {} FROM '{}' WITH ( DELIMITER ',', FORMAT CSV );\n".format(
+                    table_name, c_path
+                )
+            )
+            slt_file.write("\n")
+
+        slt_file.write("statement ok\n")
+        slt_file.write(
+            "INSERT INTO {} VALUES {};\n".format(
+                table_name, ", ".join("({}, {})".format(c1, c2) for c1, c2 in insert_rows)
+            )
+        )
+        slt_file.write("\n")
+
+        all_values = [v for values in groups.values() for v in values]
+        slt_file.write("query IIIIIR\n")
+        slt_file.write("SELECT {} FROM {};\n".format(agg_list, table_name))
+        slt_file.write("----\n")
+        slt_file.write(agg_row(all_values) + "\n")
+        slt_file.write("\n")
+
+        slt_file.write("query IIIIIIR rowsort\n")
+        slt_file.write("SELECT c1, {} FROM {} GROUP BY c1;\n".format(agg_list, table_name))
+        slt_file.write("----\n")
+        select_res = sorted(
+            "{} {}\n".format(c1, agg_row(values)) for c1, values in groups.items()
+        )
+        for res in select_res:
+            slt_file.write(res)
+        slt_file.write("\n")
+
+        # most partitions of the parallel aggregate get no group
+        slt_file.write("query IIIIIIR rowsort\n")
+        slt_file.write(
+            "SELECT c1, {} FROM {} WHERE c1 >= {} GROUP BY c1;\n".format(
+                agg_list, table_name, last_group
+            )
+        )
+        slt_file.write("----\n")
+        select_res = sorted(
+            "{} {}\n".format(c1, agg_row(values))
+            for c1, values in groups.items()
+            if c1 >= last_group
+        )
+        for res in select_res:
+            slt_file.write(res)
+        slt_file.write("\n")
+
+        # no group at all
+        slt_file.write("query IIIIIIR rowsort\n")
+        slt_file.write(
+            "SELECT c1, {} FROM {} WHERE c1 < 0 GROUP BY c1;\n".format(agg_list, table_name)
+        )
+        slt_file.write("----\n")
+        slt_file.write("\n")
+
+        slt_file.write("statement ok\n")
+        slt_file.write("DROP TABLE IF EXISTS {};\n".format(table_name))
+        slt_file.write("\n")
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser(description="Generate parallel aggregate data for test")
+    parser.add_argument(
+        "-g",
+        "--generate",
+        type=bool,
+        default=False,
+        dest="generate_if_exists",
+    )
+    parser.add_argument(
+        "-c",
+        "--copy",
+        type=str,
+        default="/var/infinity/test_data",
+        dest="copy_dir",
+    )
+    args = parser.parse_args()
+    generate(args.generate_if_exists, args.copy_dir)